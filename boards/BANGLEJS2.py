@@ -89,6 +89,7 @@ info = {
      'SOURCES += libs/banglejs/banglejs2_storage_default.c',
      'DEFINES += -DESPR_STORAGE_INITIAL_CONTENTS=1', # use banglejs2_storage_default
      'DEFINES += -DESPR_USE_STORAGE_CACHE=32', # Add a 32 entry cache to speed up finding files
+     'DEFINES += -DESPR_STORAGE_INDEX=256', # Add a 256 slot (1.5kB) hash index of up to 192 files so finding files that aren't cached doesn't scan Storage
      'JSMODULESOURCES += libs/js/banglejs/locale.min.js',
      'JSMODULESOURCES += libs/js/banglejs/Layout.min.js',
 
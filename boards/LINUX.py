@@ -36,6 +36,7 @@ info = {
      'DEFINES+=-DESPR_UNICODE_SUPPORT=1',
      'DEFINES+=-DUSE_FONT_6X8 -DGRAPHICS_PALETTED_IMAGES -DGRAPHICS_ANTIALIAS -DESPR_PBF_FONTS',
      'DEFINES+=-DSPIFLASH_BASE=0 -DSPIFLASH_LENGTH=FLASH_SAVED_CODE_LENGTH', # For Testing Flash Strings
+     'DEFINES+=-DESPR_STORAGE_INDEX=1024', # RAM hash index of Storage files (6 bytes/slot, up to 768 files)
      'LINUX=1',
    ]
  }
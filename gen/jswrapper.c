@@ -0,0 +1,2349 @@
+// Automatically generated wrapper file 
+// Generated by scripts/build_jswrapper.py
+
+#include "jswrapper.h"
+#include "jsnative.h"
+#include "jsparse.h"
+#include "libs/graphics/jswrap_graphics.h"
+#include "src/jswrap_pin.h"
+#include "src/jswrap_array.h"
+#include "src/jswrap_arraybuffer.h"
+#include "src/jswrap_dataview.h"
+#include "src/jswrap_date.h"
+#include "src/jswrap_error.h"
+#include "src/jswrap_functions.h"
+#include "src/jswrap_generator.h"
+#include "src/jswrap_json.h"
+#include "src/jswrap_number.h"
+#include "src/jswrap_object.h"
+#include "src/jswrap_regexp.h"
+#include "src/jswrap_timer.h"
+#include "src/jswrap_string.h"
+#include "src/jswrap_modules.h"
+#include "src/jswrap_math.h"
+#include "src/jswrap_espruino.h"
+#include "src/jswrap_flash.h"
+#include "src/jswrap_interactive.h"
+#include "src/jswrap_io.h"
+#include "src/jswrap_pipe.h"
+#include "src/jswrap_process.h"
+#include "src/jswrap_onewire.h"
+#include "src/jswrap_promise.h"
+#include "src/jswrap_serial.h"
+#include "src/jswrap_storage.h"
+#include "src/jswrap_spi_i2c.h"
+#include "src/jswrap_stream.h"
+#include "src/jswrap_waveform.h"
+#include "libs/compression/jswrap_heatshrink.h"
+#include "libs/filesystem/jswrap_fs.h"
+#include "libs/filesystem/jswrap_file.h"
+#include "libs/network/jswrap_net.h"
+#include "libs/network/http/jswrap_http.h"
+#include "libs/network/js/jswrap_jsnetwork.h"
+#include "libs/network/telnet/jswrap_telnet.h"
+#include "libs/crypto/jswrap_crypto.h"
+#include "libs/tensorflow/jswrap_tensorflow.h"
+
+
+// -----------------------------------------------------------------------------------------
+// ----------------------------------------------------------------- AUTO-GENERATED WRAPPERS
+// -----------------------------------------------------------------------------------------
+
+static JsVar* gen_jswrap_Array_pop(JsVar *parent) {
+  return jsvSkipNameAndUnLock(jsvArrayPop(parent));
+}
+
+static bool gen_jswrap_Array_isArray(JsVar* var) {
+  return jsvIsArray(var);
+}
+
+static JsVarInt gen_jswrap_ArrayBuffer_byteLength(JsVar *parent) {
+  return (JsVarInt)(parent->varData.arraybuffer.length);
+}
+
+static JsVar* gen_jswrap_Uint8Array_Uint8Array(JsVar* arr, JsVarInt byteOffset, JsVarInt length) {
+  return jswrap_typedarray_constructor(ARRAYBUFFERVIEW_UINT8, arr, byteOffset, length);
+}
+
+static JsVar* gen_jswrap_Uint8ClampedArray_Uint8ClampedArray(JsVar* arr, JsVarInt byteOffset, JsVarInt length) {
+  return jswrap_typedarray_constructor(ARRAYBUFFERVIEW_UINT8|ARRAYBUFFERVIEW_CLAMPED, arr, byteOffset, length);
+}
+
+static JsVar* gen_jswrap_Int8Array_Int8Array(JsVar* arr, JsVarInt byteOffset, JsVarInt length) {
+  return jswrap_typedarray_constructor(ARRAYBUFFERVIEW_INT8, arr, byteOffset, length);
+}
+
+static JsVar* gen_jswrap_Uint16Array_Uint16Array(JsVar* arr, JsVarInt byteOffset, JsVarInt length) {
+  return jswrap_typedarray_constructor(ARRAYBUFFERVIEW_UINT16, arr, byteOffset, length);
+}
+
+static JsVar* gen_jswrap_Int16Array_Int16Array(JsVar* arr, JsVarInt byteOffset, JsVarInt length) {
+  return jswrap_typedarray_constructor(ARRAYBUFFERVIEW_INT16, arr, byteOffset, length);
+}
+
+static JsVar* gen_jswrap_Uint24Array_Uint24Array(JsVar* arr, JsVarInt byteOffset, JsVarInt length) {
+  return jswrap_typedarray_constructor(ARRAYBUFFERVIEW_UINT24, arr, byteOffset, length);
+}
+
+static JsVar* gen_jswrap_Uint32Array_Uint32Array(JsVar* arr, JsVarInt byteOffset, JsVarInt length) {
+  return jswrap_typedarray_constructor(ARRAYBUFFERVIEW_UINT32, arr, byteOffset, length);
+}
+
+static JsVar* gen_jswrap_Int32Array_Int32Array(JsVar* arr, JsVarInt byteOffset, JsVarInt length) {
+  return jswrap_typedarray_constructor(ARRAYBUFFERVIEW_INT32, arr, byteOffset, length);
+}
+
+static JsVar* gen_jswrap_Float32Array_Float32Array(JsVar* arr, JsVarInt byteOffset, JsVarInt length) {
+  return jswrap_typedarray_constructor(ARRAYBUFFERVIEW_FLOAT32, arr, byteOffset, length);
+}
+
+static JsVar* gen_jswrap_Float64Array_Float64Array(JsVar* arr, JsVarInt byteOffset, JsVarInt length) {
+  return jswrap_typedarray_constructor(ARRAYBUFFERVIEW_FLOAT64, arr, byteOffset, length);
+}
+
+static JsVar* gen_jswrap_ArrayBufferView_buffer(JsVar *parent) {
+  return jsvLock(jsvGetFirstChild(parent));
+}
+
+static JsVarInt gen_jswrap_ArrayBufferView_byteLength(JsVar *parent) {
+  return (JsVarInt)(parent->varData.arraybuffer.length * JSV_ARRAYBUFFER_GET_SIZE(parent->varData.arraybuffer.type));
+}
+
+static JsVarInt gen_jswrap_ArrayBufferView_byteOffset(JsVar *parent) {
+  return parent->varData.arraybuffer.byteOffset;
+}
+
+static JsVar* gen_jswrap_DataView_getFloat32(JsVar *parent, JsVarInt byteOffset, bool littleEndian) {
+  return jswrap_dataview_get(parent, ARRAYBUFFERVIEW_FLOAT32, byteOffset, littleEndian);
+}
+
+static JsVar* gen_jswrap_DataView_getFloat64(JsVar *parent, JsVarInt byteOffset, bool littleEndian) {
+  return jswrap_dataview_get(parent, ARRAYBUFFERVIEW_FLOAT64, byteOffset, littleEndian);
+}
+
+static JsVar* gen_jswrap_DataView_getInt8(JsVar *parent, JsVarInt byteOffset, bool littleEndian) {
+  return jswrap_dataview_get(parent, ARRAYBUFFERVIEW_INT8, byteOffset, littleEndian);
+}
+
+static JsVar* gen_jswrap_DataView_getInt16(JsVar *parent, JsVarInt byteOffset, bool littleEndian) {
+  return jswrap_dataview_get(parent, ARRAYBUFFERVIEW_INT16, byteOffset, littleEndian);
+}
+
+static JsVar* gen_jswrap_DataView_getInt32(JsVar *parent, JsVarInt byteOffset, bool littleEndian) {
+  return jswrap_dataview_get(parent, ARRAYBUFFERVIEW_INT32, byteOffset, littleEndian);
+}
+
+static JsVar* gen_jswrap_DataView_getUint8(JsVar *parent, JsVarInt byteOffset, bool littleEndian) {
+  return jswrap_dataview_get(parent, ARRAYBUFFERVIEW_UINT8, byteOffset, littleEndian);
+}
+
+static JsVar* gen_jswrap_DataView_getUint16(JsVar *parent, JsVarInt byteOffset, bool littleEndian) {
+  return jswrap_dataview_get(parent, ARRAYBUFFERVIEW_UINT16, byteOffset, littleEndian);
+}
+
+static JsVar* gen_jswrap_DataView_getUint32(JsVar *parent, JsVarInt byteOffset, bool littleEndian) {
+  return jswrap_dataview_get(parent, ARRAYBUFFERVIEW_UINT32, byteOffset, littleEndian);
+}
+
+static void gen_jswrap_DataView_setFloat32(JsVar *parent, JsVarInt byteOffset, JsVar* value, bool littleEndian) {
+  jswrap_dataview_set(parent, ARRAYBUFFERVIEW_FLOAT32, byteOffset, value, littleEndian);
+}
+
+static void gen_jswrap_DataView_setFloat64(JsVar *parent, JsVarInt byteOffset, JsVar* value, bool littleEndian) {
+  jswrap_dataview_set(parent, ARRAYBUFFERVIEW_FLOAT64, byteOffset, value, littleEndian);
+}
+
+static void gen_jswrap_DataView_setInt8(JsVar *parent, JsVarInt byteOffset, JsVar* value, bool littleEndian) {
+  jswrap_dataview_set(parent, ARRAYBUFFERVIEW_INT8, byteOffset, value, littleEndian);
+}
+
+static void gen_jswrap_DataView_setInt16(JsVar *parent, JsVarInt byteOffset, JsVar* value, bool littleEndian) {
+  jswrap_dataview_set(parent, ARRAYBUFFERVIEW_INT16, byteOffset, value, littleEndian);
+}
+
+static void gen_jswrap_DataView_setInt32(JsVar *parent, JsVarInt byteOffset, JsVar* value, bool littleEndian) {
+  jswrap_dataview_set(parent, ARRAYBUFFERVIEW_INT32, byteOffset, value, littleEndian);
+}
+
+static void gen_jswrap_DataView_setUint8(JsVar *parent, JsVarInt byteOffset, JsVar* value, bool littleEndian) {
+  jswrap_dataview_set(parent, ARRAYBUFFERVIEW_UINT8, byteOffset, value, littleEndian);
+}
+
+static void gen_jswrap_DataView_setUint16(JsVar *parent, JsVarInt byteOffset, JsVar* value, bool littleEndian) {
+  jswrap_dataview_set(parent, ARRAYBUFFERVIEW_UINT16, byteOffset, value, littleEndian);
+}
+
+static void gen_jswrap_DataView_setUint32(JsVar *parent, JsVarInt byteOffset, JsVar* value, bool littleEndian) {
+  jswrap_dataview_set(parent, ARRAYBUFFERVIEW_UINT32, byteOffset, value, littleEndian);
+}
+
+static JsVarFloat gen_jswrap_NaN() {
+  return NAN;
+}
+
+static JsVarFloat gen_jswrap_Infinity() {
+  return INFINITY;
+}
+
+static JsVarFloat gen_jswrap_Number_NaN() {
+  return NAN;
+}
+
+static JsVarFloat gen_jswrap_Number_MAX_VALUE() {
+  return DBL_MAX;
+}
+
+static JsVarFloat gen_jswrap_Number_MIN_VALUE() {
+  return DBL_MIN;
+}
+
+static JsVarFloat gen_jswrap_Number_NEGATIVE_INFINITY() {
+  return -INFINITY;
+}
+
+static JsVarFloat gen_jswrap_Number_POSITIVE_INFINITY() {
+  return INFINITY;
+}
+
+static int gen_jswrap_HIGH() {
+  return 1;
+}
+
+static int gen_jswrap_LOW() {
+  return 0;
+}
+
+static JsVar* gen_jswrap_Object_keys(JsVar* object) {
+  return jswrap_object_keys_or_property_names(object, JSWOKPF_NONE);
+}
+
+static JsVar* gen_jswrap_Object_getOwnPropertyNames(JsVar* object) {
+  return jswrap_object_keys_or_property_names(object, JSWOKPF_INCLUDE_NON_ENUMERABLE);
+}
+
+static JsVar* gen_jswrap_Object_values(JsVar* object) {
+  return jswrap_object_values_or_entries(object, false);;
+}
+
+static JsVar* gen_jswrap_Object_entries(JsVar* object) {
+  return jswrap_object_values_or_entries(object, true);;
+}
+
+static int gen_jswrap_String_indexOf(JsVar *parent, JsVar* substring, JsVar* fromIndex) {
+  return jswrap_string_indexOf(parent, substring, fromIndex, false);
+}
+
+static int gen_jswrap_String_lastIndexOf(JsVar *parent, JsVar* substring, JsVar* fromIndex) {
+  return jswrap_string_indexOf(parent, substring, fromIndex, true);
+}
+
+static JsVar* gen_jswrap_String_toLowerCase(JsVar *parent) {
+  return jswrap_string_toUpperLowerCase(parent, false);
+}
+
+static JsVar* gen_jswrap_String_toUpperCase(JsVar *parent) {
+  return jswrap_string_toUpperLowerCase(parent, true);
+}
+
+static JsVar* gen_jswrap_String_removeAccents(JsVar *parent) {
+  return jswrap_string_removeAccents(parent);
+}
+
+static bool gen_jswrap_String_includes(JsVar *parent, JsVar* substring, JsVar* fromIndex) {
+  return jswrap_string_indexOf(parent, substring, fromIndex, false)>=0;
+}
+
+static JsVar* gen_jswrap_String_padStart(JsVar *parent, JsVarInt targetLength, JsVar* padString) {
+  return jswrap_string_padX(parent, targetLength, padString, true);
+}
+
+static JsVar* gen_jswrap_String_padEnd(JsVar *parent, JsVarInt targetLength, JsVar* padString) {
+  return jswrap_string_padX(parent, targetLength, padString, false);
+}
+
+static JsVarFloat gen_jswrap_Math_E() {
+  return 2.718281828459045;
+}
+
+static JsVarFloat gen_jswrap_Math_PI() {
+  return PI;
+}
+
+static JsVarFloat gen_jswrap_Math_LN2() {
+  return 0.6931471805599453;
+}
+
+static JsVarFloat gen_jswrap_Math_LN10() {
+  return 2.302585092994046;
+}
+
+static JsVarFloat gen_jswrap_Math_LOG2E() {
+  return 1.4426950408889634;
+}
+
+static JsVarFloat gen_jswrap_Math_LOG10E() {
+  return 0.4342944819032518;
+}
+
+static JsVarFloat gen_jswrap_Math_SQRT2() {
+  return 1.4142135623730951;
+}
+
+static JsVarFloat gen_jswrap_Math_SQRT1_2() {
+  return 0.7071067811865476;
+}
+
+static JsVarFloat gen_jswrap_Math_acos(JsVarFloat x) {
+  return (PI/2) - jswrap_math_asin(x);
+}
+
+static JsVarFloat gen_jswrap_Math_random() {
+  return (JsVarFloat)rand() / (JsVarFloat)((unsigned)RAND_MAX+1);
+}
+
+static JsVarInt gen_jswrap_Math_randInt(JsVarInt range) {
+  return (range>0) ? (rand() % range) : (rand()^(rand()<<1));
+}
+
+static JsVarFloat gen_jswrap_Math_tan(JsVarFloat theta) {
+  return jswrap_math_sin(theta) / jswrap_math_sin(theta+(PI/2));
+}
+
+static JsVarFloat gen_jswrap_Math_min(JsVar* args) {
+  return jswrap_math_minmax(args, false);
+}
+
+static JsVarFloat gen_jswrap_Math_max(JsVar* args) {
+  return jswrap_math_minmax(args, true);
+}
+
+static JsVar* gen_jswrap_E_internal() {
+  return jsvLockAgain(execInfo.hiddenRoot);
+}
+
+static JsVarFloat gen_jswrap_E_getAnalogVRef() {
+  return jshReadVRef();
+}
+
+static void gen_jswrap_dump() {
+  jsiDumpState(vcbprintf_callback_jsiConsolePrintString, 0);
+}
+
+static JsVarFloat gen_jswrap_getTime() {
+  return (JsVarFloat)jshGetSystemTime() / (JsVarFloat)jshGetTimeFromMilliseconds(1000);
+}
+
+static JsVar* gen_jswrap_peek8(JsVarInt addr, JsVarInt count) {
+  return jswrap_io_peek(addr,count,1);
+}
+
+static void gen_jswrap_poke8(JsVarInt addr, JsVar* value) {
+  jswrap_io_poke(addr,value,1);
+}
+
+static JsVar* gen_jswrap_peek16(JsVarInt addr, JsVarInt count) {
+  return jswrap_io_peek(addr,count,2);
+}
+
+static void gen_jswrap_poke16(JsVarInt addr, JsVar* value) {
+  jswrap_io_poke(addr,value,2);
+}
+
+static JsVar* gen_jswrap_peek32(JsVarInt addr, JsVarInt count) {
+  return jswrap_io_peek(addr,count,4);
+}
+
+static void gen_jswrap_poke32(JsVarInt addr, JsVar* value) {
+  jswrap_io_poke(addr,value,4);
+}
+
+static JsVar* gen_jswrap_process_version() {
+  return jsvNewFromString(JS_VERSION);
+}
+
+static JsVar* gen_jswrap_Serial_find(Pin pin) {
+  return jshGetDeviceObjectFor(JSH_USART1, JSH_USARTMAX, pin);
+}
+
+static JsVar* gen_jswrap_USB() {
+  return jspNewObject("USB", "Serial") /* needs JSWAT_EXECUTE_IMMEDIATELY */;
+}
+
+static JsVar* gen_jswrap_Serial1() {
+  return jspNewObject("Serial1", "Serial") /* needs JSWAT_EXECUTE_IMMEDIATELY */;
+}
+
+static JsVar* gen_jswrap_Serial2() {
+  return jspNewObject("Serial2", "Serial") /* needs JSWAT_EXECUTE_IMMEDIATELY */;
+}
+
+static JsVar* gen_jswrap_Serial3() {
+  return jspNewObject("Serial3", "Serial") /* needs JSWAT_EXECUTE_IMMEDIATELY */;
+}
+
+static JsVar* gen_jswrap_Serial4() {
+  return jspNewObject("Serial4", "Serial") /* needs JSWAT_EXECUTE_IMMEDIATELY */;
+}
+
+static JsVar* gen_jswrap_Serial5() {
+  return jspNewObject("Serial5", "Serial") /* needs JSWAT_EXECUTE_IMMEDIATELY */;
+}
+
+static JsVar* gen_jswrap_Serial6() {
+  return jspNewObject("Serial6", "Serial") /* needs JSWAT_EXECUTE_IMMEDIATELY */;
+}
+
+static JsVar* gen_jswrap_LoopbackA() {
+  return jspNewObject("LoopbackA", "Serial") /* needs JSWAT_EXECUTE_IMMEDIATELY */;
+}
+
+static JsVar* gen_jswrap_LoopbackB() {
+  return jspNewObject("LoopbackB", "Serial") /* needs JSWAT_EXECUTE_IMMEDIATELY */;
+}
+
+static JsVar* gen_jswrap_Telnet() {
+  return jspNewObject("Telnet", "Serial") /* needs JSWAT_EXECUTE_IMMEDIATELY */;
+}
+
+static JsVar* gen_jswrap_SPI1() {
+  return jspNewObject("SPI1", "SPI") /* needs JSWAT_EXECUTE_IMMEDIATELY */;
+}
+
+static JsVar* gen_jswrap_SPI2() {
+  return jspNewObject("SPI2", "SPI") /* needs JSWAT_EXECUTE_IMMEDIATELY */;
+}
+
+static JsVar* gen_jswrap_SPI3() {
+  return jspNewObject("SPI3", "SPI") /* needs JSWAT_EXECUTE_IMMEDIATELY */;
+}
+
+static JsVar* gen_jswrap_SPI_find(Pin pin) {
+  return jshGetDeviceObjectFor(JSH_SPI1, JSH_SPIMAX, pin);
+}
+
+static JsVar* gen_jswrap_I2C_find(Pin pin) {
+  return jshGetDeviceObjectFor(JSH_I2C1, JSH_I2CMAX, pin);
+}
+
+static JsVar* gen_jswrap_I2C1() {
+  return jspNewObject("I2C1", "I2C") /* needs JSWAT_EXECUTE_IMMEDIATELY */;
+}
+
+static JsVar* gen_jswrap_I2C2() {
+  return jspNewObject("I2C2", "I2C") /* needs JSWAT_EXECUTE_IMMEDIATELY */;
+}
+
+static JsVar* gen_jswrap_I2C3() {
+  return jspNewObject("I2C3", "I2C") /* needs JSWAT_EXECUTE_IMMEDIATELY */;
+}
+
+static bool gen_jswrap_fs_writeFile(JsVar* path, JsVar* data) {
+  return  jswrap_fs_writeOrAppendFile(path, data, false);
+}
+
+static bool gen_jswrap_fs_writeFileSync(JsVar* path, JsVar* data) {
+  return  jswrap_fs_writeOrAppendFile(path, data, false);
+}
+
+static bool gen_jswrap_fs_appendFile(JsVar* path, JsVar* data) {
+  return  jswrap_fs_writeOrAppendFile(path, data, true);
+}
+
+static bool gen_jswrap_fs_appendFileSync(JsVar* path, JsVar* data) {
+  return jswrap_fs_writeOrAppendFile(path, data, true);
+}
+
+static void gen_jswrap_File_close(JsVar *parent) {
+  jswrap_file_close(parent);
+}
+
+static void gen_jswrap_File_skip(JsVar *parent, int nBytes) {
+  jswrap_file_skip_or_seek(parent,nBytes,true);
+}
+
+static void gen_jswrap_File_seek(JsVar *parent, int nBytes) {
+  jswrap_file_skip_or_seek(parent,nBytes,false);
+}
+
+static JsVarInt gen_jswrap_Graphics_getWidth(JsVar *parent) {
+  return jswrap_graphics_getWidthOrHeight(parent, false);
+}
+
+static JsVarInt gen_jswrap_Graphics_getHeight(JsVar *parent) {
+  return jswrap_graphics_getWidthOrHeight(parent, true);
+}
+
+static JsVar* gen_jswrap_Graphics_setColor(JsVar *parent, JsVar* r, JsVar* g, JsVar* b) {
+  return jswrap_graphics_setColorX(parent, r,g,b, true);
+}
+
+static JsVar* gen_jswrap_Graphics_setBgColor(JsVar *parent, JsVar* r, JsVar* g, JsVar* b) {
+  return jswrap_graphics_setColorX(parent, r,g,b, false);
+}
+
+static JsVarInt gen_jswrap_Graphics_getColor(JsVar *parent) {
+  return jswrap_graphics_getColorX(parent, true);
+}
+
+static JsVarInt gen_jswrap_Graphics_getBgColor(JsVar *parent) {
+  return jswrap_graphics_getColorX(parent, false);
+}
+
+static JsVar* gen_jswrap_Graphics_setFontBitmap(JsVar *parent) {
+  return jswrap_graphics_setFontSizeX(parent, 1+JSGRAPHICS_FONTSIZE_4X6, false);
+}
+
+static JsVar* gen_jswrap_Graphics_setFontVector(JsVar *parent, int size) {
+  return jswrap_graphics_setFontSizeX(parent, size, true);
+}
+
+static JsVar* gen_jswrap_Graphics_drawPoly(JsVar *parent, JsVar* poly, bool closed) {
+  return jswrap_graphics_drawPoly_X(parent, poly, closed, false);
+}
+
+static JsVar* gen_jswrap_Graphics_drawPolyAA(JsVar *parent, JsVar* poly, bool closed) {
+  return jswrap_graphics_drawPoly_X(parent, poly, closed, true);
+}
+
+static JsVar* gen_jswrap_Graphics_fillPoly(JsVar *parent, JsVar* poly) {
+  return jswrap_graphics_fillPoly_X(parent, poly, false);;
+}
+
+static JsVar* gen_jswrap_Graphics_fillPolyAA(JsVar *parent, JsVar* poly) {
+  return jswrap_graphics_fillPoly_X(parent, poly, true);;
+}
+
+static JsVar* gen_jswrap_net_connect(JsVar* options, JsVar* callback) {
+  return jswrap_net_connect(options, callback, ST_NORMAL);
+}
+
+static JsVar* gen_jswrap_dgram_createSocket(JsVar* type, JsVar* callback) {
+  return jswrap_dgram_createSocket(type, callback);
+}
+
+static JsVar* gen_jswrap_tls_connect(JsVar* options, JsVar* callback) {
+  return jswrap_net_connect(options, callback, ST_NORMAL | ST_TLS);
+}
+
+static JsVar* gen_jswrap_Server_listen(JsVar *parent, int port) {
+  return jswrap_net_server_listen(parent, port, ST_NORMAL);
+}
+
+static JsVar* gen_jswrap_http_request(JsVar* options, JsVar* callback) {
+  return jswrap_net_connect(options, callback, ST_HTTP);
+}
+
+static JsVar* gen_jswrap_httpSrv_listen(JsVar *parent, int port) {
+  return jswrap_net_server_listen(parent, port, ST_HTTP);
+}
+
+static JsVar* gen_jswrap_crypto_AES() {
+  return jspNewBuiltin("AES");;
+}
+
+static JsVar* gen_jswrap_crypto_SHA1(JsVar* message) {
+  return jswrap_crypto_SHAx(message, 1);
+}
+
+static JsVar* gen_jswrap_crypto_SHA224(JsVar* message) {
+  return jswrap_crypto_SHAx(message, 224);
+}
+
+static JsVar* gen_jswrap_crypto_SHA256(JsVar* message) {
+  return jswrap_crypto_SHAx(message, 256);
+}
+
+static JsVar* gen_jswrap_crypto_SHA384(JsVar* message) {
+  return jswrap_crypto_SHAx(message, 384);
+}
+
+static JsVar* gen_jswrap_crypto_SHA512(JsVar* message) {
+  return jswrap_crypto_SHAx(message, 512);
+}
+
+static JsVar* gen_jswrap_ArrayBufferView_ArrayBufferView() {
+  return NULL;
+}
+
+static JsVar* gen_jswrap_console_console() {
+  return NULL;
+}
+
+static JsVar* gen_jswrap_Generator_Generator() {
+  return NULL;
+}
+
+static JsVar* gen_jswrap_JSON_JSON() {
+  return NULL;
+}
+
+static JsVar* gen_jswrap_JSONParser_JSONParser() {
+  return NULL;
+}
+
+static JsVar* gen_jswrap_timer_timer() {
+  return NULL;
+}
+
+static JsVar* gen_jswrap_Modules_Modules() {
+  return NULL;
+}
+
+static JsVar* gen_jswrap_Math_Math() {
+  return NULL;
+}
+
+static JsVar* gen_jswrap_E_E() {
+  return NULL;
+}
+
+static JsVar* gen_jswrap_Flash_Flash() {
+  return NULL;
+}
+
+static JsVar* gen_jswrap_fs_fs() {
+  return NULL;
+}
+
+static JsVar* gen_jswrap_process_process() {
+  return NULL;
+}
+
+static JsVar* gen_jswrap_Storage_Storage() {
+  return NULL;
+}
+
+static JsVar* gen_jswrap_StorageFile_StorageFile() {
+  return NULL;
+}
+
+static JsVar* gen_jswrap_heatshrink_heatshrink() {
+  return NULL;
+}
+
+static JsVar* gen_jswrap_File_File() {
+  return NULL;
+}
+
+static JsVar* gen_jswrap_Graphics_Graphics() {
+  return NULL;
+}
+
+static JsVar* gen_jswrap_url_url() {
+  return NULL;
+}
+
+static JsVar* gen_jswrap_net_net() {
+  return NULL;
+}
+
+static JsVar* gen_jswrap_Server_Server() {
+  return NULL;
+}
+
+static JsVar* gen_jswrap_Socket_Socket() {
+  return NULL;
+}
+
+static JsVar* gen_jswrap_dgram_dgram() {
+  return NULL;
+}
+
+static JsVar* gen_jswrap_dgramSocket_dgramSocket() {
+  return NULL;
+}
+
+static JsVar* gen_jswrap_tls_tls() {
+  return NULL;
+}
+
+static JsVar* gen_jswrap_http_http() {
+  return NULL;
+}
+
+static JsVar* gen_jswrap_httpSrv_httpSrv() {
+  return NULL;
+}
+
+static JsVar* gen_jswrap_httpSRq_httpSRq() {
+  return NULL;
+}
+
+static JsVar* gen_jswrap_httpSRs_httpSRs() {
+  return NULL;
+}
+
+static JsVar* gen_jswrap_httpCRq_httpCRq() {
+  return NULL;
+}
+
+static JsVar* gen_jswrap_httpCRs_httpCRs() {
+  return NULL;
+}
+
+static JsVar* gen_jswrap_NetworkJS_NetworkJS() {
+  return NULL;
+}
+
+static JsVar* gen_jswrap_TelnetServer_TelnetServer() {
+  return NULL;
+}
+
+static JsVar* gen_jswrap_crypto_crypto() {
+  return NULL;
+}
+
+static JsVar* gen_jswrap_AES_AES() {
+  return NULL;
+}
+
+static JsVar* gen_jswrap_tensorflow_tensorflow() {
+  return NULL;
+}
+
+static JsVar* gen_jswrap_TFMicroInterpreter_TFMicroInterpreter() {
+  return NULL;
+}
+
+// -----------------------------------------------------------------------------------------
+// -----------------------------------------------------------------------------------------
+// -----------------------------------------------------------------------------------------
+
+
+#ifndef ESPR_NO_SYMBOL_HASH
+/// Hash a symbol name (FNV-1a) - this must match symbolHash in build_jswrapper.py
+static uint32_t jswHashString(const char *s) {
+  uint32_t h = 2166136261U;
+  while (*s) h = (h ^ (unsigned char)*(s++)) * 16777619U;
+  return h;
+}
+
+/** Use a perfect hash table created by build_jswrapper.py to find the index of the only
+ * string that name could be, or -1 if it can't be any of them. The caller must still check
+ * that the string matches. This must match symbolHashSlot in build_jswrapper.py */
+static int jswHashFind(const unsigned char *hashTable, const char *name) {
+  unsigned int bucketCount = READ_FLASH_UINT8(&hashTable[0]);
+  unsigned int slotCount = READ_FLASH_UINT8(&hashTable[1]) | (READ_FLASH_UINT8(&hashTable[2])<<8);
+  uint32_t h = jswHashString(name);
+  uint32_t x = h ^ (READ_FLASH_UINT8(&hashTable[3 + h%bucketCount]) * 0x9E3779B1U);
+  x ^= x >> 16;
+  x *= 0x85EBCA6BU;
+  x ^= x >> 13;
+  unsigned int idx = READ_FLASH_UINT8(&hashTable[3 + bucketCount + x%slotCount]);
+  return (idx==255) ? -1 : (int)idx;
+}
+#endif
+
+/// Return the value of the given symbol - either a native function, or the result of calling it if it's a property
+static JsVar *jswGetSymbolValue(const JswSymPtr *sym, JsVar *parent) {
+  unsigned short functionSpec = READ_FLASH_UINT16(&sym->functionSpec);
+  if ((functionSpec & JSWAT_EXECUTE_IMMEDIATELY_MASK) == JSWAT_EXECUTE_IMMEDIATELY)
+    return jsnCallFunction(JSWSYMPTR_FUNCTION_PTR(sym), functionSpec, parent, 0, 0);
+  return jsvNewNativeFunction(JSWSYMPTR_FUNCTION_PTR(sym), functionSpec);
+}
+
+// Search coded to allow for JswSyms to be in flash on the esp8266 where they require
+// word accesses. Uses the perfect hash if we have one, or a binary search if not
+JsVar *jswBinarySearch(const JswSymList *symbolsPtr, JsVar *parent, const char *name) {
+#ifndef ESPR_NO_SYMBOL_HASH
+  int idx = jswHashFind(symbolsPtr->symbolHash, name);
+  if (idx<0) return 0;
+  const JswSymPtr *sym = &symbolsPtr->symbols[idx];
+  if (FLASH_STRCMP(name, &symbolsPtr->symbolChars[JSWSYMPTR_OFFSET(sym)])) return 0;
+  return jswGetSymbolValue(sym, parent);
+#else
+  uint8_t symbolCount = READ_FLASH_UINT8(&symbolsPtr->symbolCount);
+  int searchMin = 0;
+  int searchMax = symbolCount - 1;
+  while (searchMin <= searchMax) {
+    int idx = (searchMin+searchMax) >> 1;
+    const JswSymPtr *sym = &symbolsPtr->symbols[idx];
+    int cmp = FLASH_STRCMP(name, &symbolsPtr->symbolChars[JSWSYMPTR_OFFSET(sym)]);
+    if (cmp==0) {
+      return jswGetSymbolValue(sym, parent);
+    } else {
+      if (cmp<0) {
+        // searchMin is the same
+        searchMax = idx-1;
+      } else {
+        searchMin = idx+1;
+        // searchMax is the same
+      }
+    }
+  }
+  return 0;
+#endif
+}
+
+
+// -----------------------------------------------------------------------------------------
+// -----------------------------------------------------------------------------------------
+// -----------------------------------------------------------------------------------------
+
+
+#ifdef ESP8266
+#define FLASH_SECT __attribute__((section(".irom.literal2"))) __attribute__((aligned(4)))
+#else
+#define FLASH_SECT
+#endif
+
+static const JswSymPtr jswSymbols_Pin[] FLASH_SECT = {
+  
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_Pin[] FLASH_SECT = {1,1,0,0,255};
+#endif
+static const unsigned char jswSymbolIndex_Pin = 0;
+static const JswSymPtr jswSymbols_Pin_proto[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_JSVARFLOAT | JSWAT_THIS_ARG, (void*)jswrap_pin_analog),
+  JSWSYMPTR_ENTRY(7, JSWAT_JSVAR | JSWAT_THIS_ARG, (void*)jswrap_pin_getInfo),
+  JSWSYMPTR_ENTRY(15, JSWAT_JSVAR | JSWAT_THIS_ARG, (void*)jswrap_pin_getMode),
+  JSWSYMPTR_ENTRY(23, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_pin_mode),
+  JSWSYMPTR_ENTRY(28, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_BOOL << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)jswrap_pin_pulse),
+  JSWSYMPTR_ENTRY(34, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVARFLOAT << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)jswrap_pin_pwm),
+  JSWSYMPTR_ENTRY(38, JSWAT_BOOL | JSWAT_THIS_ARG, (void*)jswrap_pin_read),
+  JSWSYMPTR_ENTRY(43, JSWAT_VOID | JSWAT_THIS_ARG, (void*)jswrap_pin_reset),
+  JSWSYMPTR_ENTRY(49, JSWAT_VOID | JSWAT_THIS_ARG, (void*)jswrap_pin_set),
+  JSWSYMPTR_ENTRY(53, JSWAT_BOOL | JSWAT_THIS_ARG, (void*)jswrap_pin_toggle),
+  JSWSYMPTR_ENTRY(60, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_BOOL << (JSWAT_BITS*1)), (void*)jswrap_pin_write)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_Pin_proto[] FLASH_SECT = {3,13,0,15,25,1,255,6,7,9,10,8,2,5,3,255,0,4,1};
+#endif
+static const unsigned char jswSymbolIndex_Pin_proto = 1;
+static const JswSymPtr jswSymbols_global[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_JSVAR, (void*)gen_jswrap_AES_AES),
+  JSWSYMPTR_ENTRY(4, JSWAT_JSVAR | (JSWAT_ARGUMENT_ARRAY << (JSWAT_BITS*1)), (void*)jswrap_array_constructor),
+  JSWSYMPTR_ENTRY(10, JSWAT_JSVAR | (JSWAT_INT32 << (JSWAT_BITS*1)), (void*)jswrap_arraybuffer_constructor),
+  JSWSYMPTR_ENTRY(22, JSWAT_JSVAR, (void*)gen_jswrap_ArrayBufferView_ArrayBufferView),
+  JSWSYMPTR_ENTRY(38, JSWAT_BOOL | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_boolean_constructor),
+  JSWSYMPTR_ENTRY(46, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)) | (JSWAT_INT32 << (JSWAT_BITS*3)), (void*)jswrap_dataview_constructor),
+  JSWSYMPTR_ENTRY(55, JSWAT_JSVAR | (JSWAT_ARGUMENT_ARRAY << (JSWAT_BITS*1)), (void*)jswrap_date_constructor),
+  JSWSYMPTR_ENTRY(60, JSWAT_JSVAR, (void*)gen_jswrap_E_E),
+  JSWSYMPTR_ENTRY(62, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_error_constructor),
+  JSWSYMPTR_ENTRY(68, JSWAT_JSVAR, (void*)gen_jswrap_File_File),
+  JSWSYMPTR_ENTRY(73, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)) | (JSWAT_INT32 << (JSWAT_BITS*3)), (void*)gen_jswrap_Float32Array_Float32Array),
+  JSWSYMPTR_ENTRY(86, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)) | (JSWAT_INT32 << (JSWAT_BITS*3)), (void*)gen_jswrap_Float64Array_Float64Array),
+  JSWSYMPTR_ENTRY(99, JSWAT_JSVAR | (JSWAT_ARGUMENT_ARRAY << (JSWAT_BITS*1)), (void*)jswrap_function_constructor),
+  JSWSYMPTR_ENTRY(108, JSWAT_JSVAR, (void*)gen_jswrap_Generator_Generator),
+  JSWSYMPTR_ENTRY(118, JSWAT_JSVAR, (void*)gen_jswrap_Graphics_Graphics),
+  JSWSYMPTR_ENTRY(127, JSWAT_INT32 | JSWAT_EXECUTE_IMMEDIATELY, (void*)gen_jswrap_HIGH),
+  JSWSYMPTR_ENTRY(132, JSWAT_JSVAR, (void*)jswrap_i2c_constructor),
+  JSWSYMPTR_ENTRY(136, JSWAT_JSVAR | JSWAT_EXECUTE_IMMEDIATELY, (void*)gen_jswrap_I2C1),
+  JSWSYMPTR_ENTRY(141, JSWAT_JSVAR | JSWAT_EXECUTE_IMMEDIATELY, (void*)gen_jswrap_I2C2),
+  JSWSYMPTR_ENTRY(146, JSWAT_JSVAR | JSWAT_EXECUTE_IMMEDIATELY, (void*)gen_jswrap_I2C3),
+  JSWSYMPTR_ENTRY(151, JSWAT_JSVARFLOAT | JSWAT_EXECUTE_IMMEDIATELY, (void*)gen_jswrap_Infinity),
+  JSWSYMPTR_ENTRY(160, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)) | (JSWAT_INT32 << (JSWAT_BITS*3)), (void*)gen_jswrap_Int16Array_Int16Array),
+  JSWSYMPTR_ENTRY(171, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)) | (JSWAT_INT32 << (JSWAT_BITS*3)), (void*)gen_jswrap_Int32Array_Int32Array),
+  JSWSYMPTR_ENTRY(182, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)) | (JSWAT_INT32 << (JSWAT_BITS*3)), (void*)gen_jswrap_Int8Array_Int8Array),
+  JSWSYMPTR_ENTRY(192, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_internalerror_constructor),
+  JSWSYMPTR_ENTRY(206, JSWAT_JSVAR, (void*)gen_jswrap_JSON_JSON),
+  JSWSYMPTR_ENTRY(211, JSWAT_JSVAR, (void*)gen_jswrap_JSONParser_JSONParser),
+  JSWSYMPTR_ENTRY(222, JSWAT_INT32 | JSWAT_EXECUTE_IMMEDIATELY, (void*)gen_jswrap_LOW),
+  JSWSYMPTR_ENTRY(226, JSWAT_JSVAR | JSWAT_EXECUTE_IMMEDIATELY, (void*)gen_jswrap_LoopbackA),
+  JSWSYMPTR_ENTRY(236, JSWAT_JSVAR | JSWAT_EXECUTE_IMMEDIATELY, (void*)gen_jswrap_LoopbackB),
+  JSWSYMPTR_ENTRY(246, JSWAT_JSVAR, (void*)gen_jswrap_Math_Math),
+  JSWSYMPTR_ENTRY(251, JSWAT_JSVAR, (void*)gen_jswrap_Modules_Modules),
+  JSWSYMPTR_ENTRY(259, JSWAT_JSVARFLOAT | JSWAT_EXECUTE_IMMEDIATELY, (void*)gen_jswrap_NaN),
+  JSWSYMPTR_ENTRY(263, JSWAT_JSVAR | (JSWAT_ARGUMENT_ARRAY << (JSWAT_BITS*1)), (void*)jswrap_number_constructor),
+  JSWSYMPTR_ENTRY(270, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_object_constructor),
+  JSWSYMPTR_ENTRY(277, JSWAT_JSVAR | (JSWAT_PIN << (JSWAT_BITS*1)), (void*)jswrap_onewire_constructor),
+  JSWSYMPTR_ENTRY(285, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_pin_constructor),
+  JSWSYMPTR_ENTRY(289, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_promise_constructor),
+  JSWSYMPTR_ENTRY(297, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_referenceerror_constructor),
+  JSWSYMPTR_ENTRY(312, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)jswrap_regexp_constructor),
+  JSWSYMPTR_ENTRY(319, JSWAT_JSVAR, (void*)jswrap_spi_constructor),
+  JSWSYMPTR_ENTRY(323, JSWAT_JSVAR | JSWAT_EXECUTE_IMMEDIATELY, (void*)gen_jswrap_SPI1),
+  JSWSYMPTR_ENTRY(328, JSWAT_JSVAR | JSWAT_EXECUTE_IMMEDIATELY, (void*)gen_jswrap_SPI2),
+  JSWSYMPTR_ENTRY(333, JSWAT_JSVAR | JSWAT_EXECUTE_IMMEDIATELY, (void*)gen_jswrap_SPI3),
+  JSWSYMPTR_ENTRY(338, JSWAT_JSVAR, (void*)jswrap_serial_constructor),
+  JSWSYMPTR_ENTRY(345, JSWAT_JSVAR | JSWAT_EXECUTE_IMMEDIATELY, (void*)gen_jswrap_Serial1),
+  JSWSYMPTR_ENTRY(353, JSWAT_JSVAR | JSWAT_EXECUTE_IMMEDIATELY, (void*)gen_jswrap_Serial2),
+  JSWSYMPTR_ENTRY(361, JSWAT_JSVAR | JSWAT_EXECUTE_IMMEDIATELY, (void*)gen_jswrap_Serial3),
+  JSWSYMPTR_ENTRY(369, JSWAT_JSVAR | JSWAT_EXECUTE_IMMEDIATELY, (void*)gen_jswrap_Serial4),
+  JSWSYMPTR_ENTRY(377, JSWAT_JSVAR | JSWAT_EXECUTE_IMMEDIATELY, (void*)gen_jswrap_Serial5),
+  JSWSYMPTR_ENTRY(385, JSWAT_JSVAR | JSWAT_EXECUTE_IMMEDIATELY, (void*)gen_jswrap_Serial6),
+  JSWSYMPTR_ENTRY(393, JSWAT_JSVAR, (void*)gen_jswrap_Server_Server),
+  JSWSYMPTR_ENTRY(400, JSWAT_JSVAR, (void*)gen_jswrap_Socket_Socket),
+  JSWSYMPTR_ENTRY(407, JSWAT_JSVAR, (void*)gen_jswrap_StorageFile_StorageFile),
+  JSWSYMPTR_ENTRY(419, JSWAT_JSVAR | (JSWAT_ARGUMENT_ARRAY << (JSWAT_BITS*1)), (void*)jswrap_string_constructor),
+  JSWSYMPTR_ENTRY(426, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_syntaxerror_constructor),
+  JSWSYMPTR_ENTRY(438, JSWAT_JSVAR, (void*)gen_jswrap_TFMicroInterpreter_TFMicroInterpreter),
+  JSWSYMPTR_ENTRY(457, JSWAT_JSVAR | JSWAT_EXECUTE_IMMEDIATELY, (void*)gen_jswrap_Telnet),
+  JSWSYMPTR_ENTRY(464, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_typeerror_constructor),
+  JSWSYMPTR_ENTRY(474, JSWAT_JSVAR | JSWAT_EXECUTE_IMMEDIATELY, (void*)gen_jswrap_USB),
+  JSWSYMPTR_ENTRY(478, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)) | (JSWAT_INT32 << (JSWAT_BITS*3)), (void*)gen_jswrap_Uint16Array_Uint16Array),
+  JSWSYMPTR_ENTRY(490, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)) | (JSWAT_INT32 << (JSWAT_BITS*3)), (void*)gen_jswrap_Uint24Array_Uint24Array),
+  JSWSYMPTR_ENTRY(502, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)) | (JSWAT_INT32 << (JSWAT_BITS*3)), (void*)gen_jswrap_Uint32Array_Uint32Array),
+  JSWSYMPTR_ENTRY(514, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)) | (JSWAT_INT32 << (JSWAT_BITS*3)), (void*)gen_jswrap_Uint8Array_Uint8Array),
+  JSWSYMPTR_ENTRY(525, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)) | (JSWAT_INT32 << (JSWAT_BITS*3)), (void*)gen_jswrap_Uint8ClampedArray_Uint8ClampedArray),
+  JSWSYMPTR_ENTRY(543, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)jswrap_waveform_constructor),
+  JSWSYMPTR_ENTRY(552, JSWAT_JSVARFLOAT | (JSWAT_PIN << (JSWAT_BITS*1)), (void*)jshPinAnalog),
+  JSWSYMPTR_ENTRY(563, JSWAT_VOID | (JSWAT_PIN << (JSWAT_BITS*1)) | (JSWAT_JSVARFLOAT << (JSWAT_BITS*2)) | (JSWAT_JSVAR << (JSWAT_BITS*3)), (void*)jswrap_io_analogWrite),
+  JSWSYMPTR_ENTRY(575, JSWAT_JSVAR | JSWAT_EXECUTE_IMMEDIATELY, (void*)jswrap_arguments),
+  JSWSYMPTR_ENTRY(585, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_atob),
+  JSWSYMPTR_ENTRY(590, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_btoa),
+  JSWSYMPTR_ENTRY(595, JSWAT_VOID | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVARFLOAT << (JSWAT_BITS*2)), (void*)jswrap_interface_changeInterval),
+  JSWSYMPTR_ENTRY(610, JSWAT_VOID | (JSWAT_ARGUMENT_ARRAY << (JSWAT_BITS*1)), (void*)jswrap_interface_clearInterval),
+  JSWSYMPTR_ENTRY(624, JSWAT_VOID | (JSWAT_ARGUMENT_ARRAY << (JSWAT_BITS*1)), (void*)jswrap_interface_clearTimeout),
+  JSWSYMPTR_ENTRY(637, JSWAT_VOID | (JSWAT_ARGUMENT_ARRAY << (JSWAT_BITS*1)), (void*)jswrap_interface_clearWatch),
+  JSWSYMPTR_ENTRY(648, JSWAT_JSVAR, (void*)gen_jswrap_console_console),
+  JSWSYMPTR_ENTRY(656, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_decodeURIComponent),
+  JSWSYMPTR_ENTRY(675, JSWAT_JSVAR, (void*)gen_jswrap_dgramSocket_dgramSocket),
+  JSWSYMPTR_ENTRY(687, JSWAT_VOID | (JSWAT_PIN << (JSWAT_BITS*1)) | (JSWAT_BOOL << (JSWAT_BITS*2)) | (JSWAT_JSVAR << (JSWAT_BITS*3)), (void*)jswrap_io_digitalPulse),
+  JSWSYMPTR_ENTRY(700, JSWAT_INT32 | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_io_digitalRead),
+  JSWSYMPTR_ENTRY(712, JSWAT_VOID | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)jswrap_io_digitalWrite),
+  JSWSYMPTR_ENTRY(725, JSWAT_VOID, (void*)gen_jswrap_dump),
+  JSWSYMPTR_ENTRY(730, JSWAT_VOID | (JSWAT_BOOL << (JSWAT_BITS*1)), (void*)jswrap_interface_echo),
+  JSWSYMPTR_ENTRY(735, JSWAT_VOID | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_interface_edit),
+  JSWSYMPTR_ENTRY(740, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_encodeURIComponent),
+  JSWSYMPTR_ENTRY(759, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_eval),
+  JSWSYMPTR_ENTRY(764, JSWAT_JSVAR | (JSWAT_PIN << (JSWAT_BITS*1)), (void*)jswrap_io_getPinMode),
+  JSWSYMPTR_ENTRY(775, JSWAT_JSVAR, (void*)jswrap_interface_getSerial),
+  JSWSYMPTR_ENTRY(785, JSWAT_JSVARFLOAT, (void*)gen_jswrap_getTime),
+  JSWSYMPTR_ENTRY(793, JSWAT_JSVAR | JSWAT_EXECUTE_IMMEDIATELY, (void*)jswrap_global),
+  JSWSYMPTR_ENTRY(800, JSWAT_JSVAR | JSWAT_EXECUTE_IMMEDIATELY, (void*)jswrap_global),
+  JSWSYMPTR_ENTRY(811, JSWAT_JSVAR, (void*)gen_jswrap_httpCRq_httpCRq),
+  JSWSYMPTR_ENTRY(819, JSWAT_JSVAR, (void*)gen_jswrap_httpCRs_httpCRs),
+  JSWSYMPTR_ENTRY(827, JSWAT_JSVAR, (void*)gen_jswrap_httpSRq_httpSRq),
+  JSWSYMPTR_ENTRY(835, JSWAT_JSVAR, (void*)gen_jswrap_httpSRs_httpSRs),
+  JSWSYMPTR_ENTRY(843, JSWAT_JSVAR, (void*)gen_jswrap_httpSrv_httpSrv),
+  JSWSYMPTR_ENTRY(851, JSWAT_BOOL | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_isFinite),
+  JSWSYMPTR_ENTRY(860, JSWAT_BOOL | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_isNaN),
+  JSWSYMPTR_ENTRY(866, JSWAT_VOID | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_interface_load),
+  JSWSYMPTR_ENTRY(871, JSWAT_JSVARFLOAT | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_parseFloat),
+  JSWSYMPTR_ENTRY(882, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)jswrap_parseInt),
+  JSWSYMPTR_ENTRY(891, JSWAT_JSVAR | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)), (void*)gen_jswrap_peek16),
+  JSWSYMPTR_ENTRY(898, JSWAT_JSVAR | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)), (void*)gen_jswrap_peek32),
+  JSWSYMPTR_ENTRY(905, JSWAT_JSVAR | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)), (void*)gen_jswrap_peek8),
+  JSWSYMPTR_ENTRY(911, JSWAT_VOID | (JSWAT_PIN << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)) | (JSWAT_BOOL << (JSWAT_BITS*3)), (void*)jswrap_io_pinMode),
+  JSWSYMPTR_ENTRY(919, JSWAT_VOID | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)gen_jswrap_poke16),
+  JSWSYMPTR_ENTRY(926, JSWAT_VOID | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)gen_jswrap_poke32),
+  JSWSYMPTR_ENTRY(933, JSWAT_VOID | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)gen_jswrap_poke8),
+  JSWSYMPTR_ENTRY(939, JSWAT_VOID | (JSWAT_ARGUMENT_ARRAY << (JSWAT_BITS*1)), (void*)jswrap_print),
+  JSWSYMPTR_ENTRY(945, JSWAT_JSVAR, (void*)gen_jswrap_process_process),
+  JSWSYMPTR_ENTRY(953, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_require),
+  JSWSYMPTR_ENTRY(961, JSWAT_VOID | (JSWAT_BOOL << (JSWAT_BITS*1)), (void*)jswrap_interface_reset),
+  JSWSYMPTR_ENTRY(967, JSWAT_VOID, (void*)jswrap_interface_save),
+  JSWSYMPTR_ENTRY(972, JSWAT_VOID | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_interface_setBusyIndicator),
+  JSWSYMPTR_ENTRY(989, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVARFLOAT << (JSWAT_BITS*2)) | (JSWAT_ARGUMENT_ARRAY << (JSWAT_BITS*3)), (void*)jswrap_interface_setInterval),
+  JSWSYMPTR_ENTRY(1001, JSWAT_VOID | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_interface_setSleepIndicator),
+  JSWSYMPTR_ENTRY(1019, JSWAT_VOID | (JSWAT_JSVARFLOAT << (JSWAT_BITS*1)), (void*)jswrap_interactive_setTime),
+  JSWSYMPTR_ENTRY(1027, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVARFLOAT << (JSWAT_BITS*2)) | (JSWAT_ARGUMENT_ARRAY << (JSWAT_BITS*3)), (void*)jswrap_interface_setTimeout),
+  JSWSYMPTR_ENTRY(1038, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_PIN << (JSWAT_BITS*2)) | (JSWAT_JSVAR << (JSWAT_BITS*3)), (void*)jswrap_interface_setWatch),
+  JSWSYMPTR_ENTRY(1047, JSWAT_VOID | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)) | (JSWAT_JSVAR << (JSWAT_BITS*3)), (void*)jswrap_io_shiftOut),
+  JSWSYMPTR_ENTRY(1056, JSWAT_VOID | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_trace),
+  JSWSYMPTR_ENTRY(1062, JSWAT_JSVAR, (void*)gen_jswrap_url_url)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_global[] FLASH_SECT = {31,152,0,8,7,30,4,0,7,98,0,7,0,0,7,2,10,0,47,1,1,13,6,1,7,0,23,7,31,66,0,29,17,8,98,72,95,42,112,75,7,49,80,31,119,48,14,105,62,255,22,29,64,43,79,1,255,110,20,99,44,54,88,58,50,82,0,35,78,255,5,57,107,100,255,104,33,255,81,83,106,111,255,39,113,41,60,255,255,255,120,89,38,4,255,93,255,255,73,6,32,85,117,116,101,55,11,24,97,255,90,51,255,86,16,108,8,102,30,65,3,255,255,17,13,46,255,10,255,27,26,47,36,84,40,255,67,114,255,255,21,91,76,121,23,255,77,28,9,96,255,255,18,2,12,74,103,63,115,68,94,87,255,61,255,255,56,45,70,255,255,109,37,19,92,66,59,71,118,15,53,69,25,255,34,52};
+#endif
+static const unsigned char jswSymbolIndex_global = 2;
+static const JswSymPtr jswSymbols_Array_proto[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_ARGUMENT_ARRAY << (JSWAT_BITS*1)), (void*)jswrap_array_concat),
+  JSWSYMPTR_ENTRY(7, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)jswrap_array_every),
+  JSWSYMPTR_ENTRY(13, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)) | (JSWAT_JSVAR << (JSWAT_BITS*3)), (void*)jswrap_array_fill),
+  JSWSYMPTR_ENTRY(18, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)jswrap_array_filter),
+  JSWSYMPTR_ENTRY(25, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_array_find),
+  JSWSYMPTR_ENTRY(30, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_array_findIndex),
+  JSWSYMPTR_ENTRY(40, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)jswrap_array_forEach),
+  JSWSYMPTR_ENTRY(48, JSWAT_BOOL | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)), (void*)jswrap_array_includes),
+  JSWSYMPTR_ENTRY(57, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)), (void*)jswrap_array_indexOf),
+  JSWSYMPTR_ENTRY(65, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_array_join),
+  JSWSYMPTR_ENTRY(70, JSWAT_JSVAR | JSWAT_THIS_ARG | JSWAT_EXECUTE_IMMEDIATELY, (void*)jswrap_object_length),
+  JSWSYMPTR_ENTRY(77, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)jswrap_array_map),
+  JSWSYMPTR_ENTRY(81, JSWAT_JSVAR | JSWAT_THIS_ARG, (void*)gen_jswrap_Array_pop),
+  JSWSYMPTR_ENTRY(85, JSWAT_INT32 | JSWAT_THIS_ARG | (JSWAT_ARGUMENT_ARRAY << (JSWAT_BITS*1)), (void*)jswrap_array_push),
+  JSWSYMPTR_ENTRY(90, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)jswrap_array_reduce),
+  JSWSYMPTR_ENTRY(97, JSWAT_JSVAR | JSWAT_THIS_ARG, (void*)jswrap_array_reverse),
+  JSWSYMPTR_ENTRY(105, JSWAT_JSVAR | JSWAT_THIS_ARG, (void*)jswrap_array_shift),
+  JSWSYMPTR_ENTRY(111, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)jswrap_array_slice),
+  JSWSYMPTR_ENTRY(117, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)jswrap_array_some),
+  JSWSYMPTR_ENTRY(122, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_array_sort),
+  JSWSYMPTR_ENTRY(127, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)) | (JSWAT_ARGUMENT_ARRAY << (JSWAT_BITS*3)), (void*)jswrap_array_splice),
+  JSWSYMPTR_ENTRY(134, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_object_toString),
+  JSWSYMPTR_ENTRY(143, JSWAT_INT32 | JSWAT_THIS_ARG | (JSWAT_ARGUMENT_ARRAY << (JSWAT_BITS*1)), (void*)jswrap_array_unshift)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_Array_proto[] FLASH_SECT = {6,28,0,0,5,16,2,27,49,7,17,9,3,19,22,21,255,0,14,15,12,10,11,255,13,16,8,255,4,18,6,2,1,255,5,20,255};
+#endif
+static const unsigned char jswSymbolIndex_Array_proto = 3;
+static const JswSymPtr jswSymbols_Array[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_BOOL | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)gen_jswrap_Array_isArray)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_Array[] FLASH_SECT = {1,1,0,0,0};
+#endif
+static const unsigned char jswSymbolIndex_Array = 4;
+static const JswSymPtr jswSymbols_ArrayBuffer_proto[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_INT32 | JSWAT_THIS_ARG | JSWAT_EXECUTE_IMMEDIATELY, (void*)gen_jswrap_ArrayBuffer_byteLength)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_ArrayBuffer_proto[] FLASH_SECT = {1,1,0,0,0};
+#endif
+static const unsigned char jswSymbolIndex_ArrayBuffer_proto = 5;
+static const JswSymPtr jswSymbols_ArrayBufferView_proto[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_JSVAR | JSWAT_THIS_ARG | JSWAT_EXECUTE_IMMEDIATELY, (void*)gen_jswrap_ArrayBufferView_buffer),
+  JSWSYMPTR_ENTRY(7, JSWAT_INT32 | JSWAT_THIS_ARG | JSWAT_EXECUTE_IMMEDIATELY, (void*)gen_jswrap_ArrayBufferView_byteLength),
+  JSWSYMPTR_ENTRY(18, JSWAT_INT32 | JSWAT_THIS_ARG | JSWAT_EXECUTE_IMMEDIATELY, (void*)gen_jswrap_ArrayBufferView_byteOffset),
+  JSWSYMPTR_ENTRY(29, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)jswrap_array_every),
+  JSWSYMPTR_ENTRY(35, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)) | (JSWAT_JSVAR << (JSWAT_BITS*3)), (void*)jswrap_array_fill),
+  JSWSYMPTR_ENTRY(40, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)jswrap_array_filter),
+  JSWSYMPTR_ENTRY(47, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_array_find),
+  JSWSYMPTR_ENTRY(52, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_array_findIndex),
+  JSWSYMPTR_ENTRY(62, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)jswrap_array_forEach),
+  JSWSYMPTR_ENTRY(70, JSWAT_BOOL | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)), (void*)jswrap_array_includes),
+  JSWSYMPTR_ENTRY(79, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)), (void*)jswrap_arraybufferview_indexOf),
+  JSWSYMPTR_ENTRY(87, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_array_join),
+  JSWSYMPTR_ENTRY(92, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)jswrap_arraybufferview_map),
+  JSWSYMPTR_ENTRY(96, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)jswrap_array_reduce),
+  JSWSYMPTR_ENTRY(103, JSWAT_JSVAR | JSWAT_THIS_ARG, (void*)jswrap_array_reverse),
+  JSWSYMPTR_ENTRY(111, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)), (void*)jswrap_arraybufferview_set),
+  JSWSYMPTR_ENTRY(115, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)jswrap_array_slice),
+  JSWSYMPTR_ENTRY(121, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)jswrap_array_some),
+  JSWSYMPTR_ENTRY(126, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_arraybufferview_sort),
+  JSWSYMPTR_ENTRY(131, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)jswrap_arraybufferview_subarray)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_ArrayBufferView_proto[] FLASH_SECT = {5,25,0,12,5,15,3,23,5,2,255,19,11,17,13,16,14,0,6,12,255,255,9,1,255,3,15,4,7,10,8,18,255};
+#endif
+static const unsigned char jswSymbolIndex_ArrayBufferView_proto = 6;
+static const JswSymPtr jswSymbols_DataView_proto[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_BOOL << (JSWAT_BITS*2)), (void*)gen_jswrap_DataView_getFloat32),
+  JSWSYMPTR_ENTRY(11, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_BOOL << (JSWAT_BITS*2)), (void*)gen_jswrap_DataView_getFloat64),
+  JSWSYMPTR_ENTRY(22, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_BOOL << (JSWAT_BITS*2)), (void*)gen_jswrap_DataView_getInt16),
+  JSWSYMPTR_ENTRY(31, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_BOOL << (JSWAT_BITS*2)), (void*)gen_jswrap_DataView_getInt32),
+  JSWSYMPTR_ENTRY(40, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_BOOL << (JSWAT_BITS*2)), (void*)gen_jswrap_DataView_getInt8),
+  JSWSYMPTR_ENTRY(48, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_BOOL << (JSWAT_BITS*2)), (void*)gen_jswrap_DataView_getUint16),
+  JSWSYMPTR_ENTRY(58, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_BOOL << (JSWAT_BITS*2)), (void*)gen_jswrap_DataView_getUint32),
+  JSWSYMPTR_ENTRY(68, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_BOOL << (JSWAT_BITS*2)), (void*)gen_jswrap_DataView_getUint8),
+  JSWSYMPTR_ENTRY(77, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)) | (JSWAT_BOOL << (JSWAT_BITS*3)), (void*)gen_jswrap_DataView_setFloat32),
+  JSWSYMPTR_ENTRY(88, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)) | (JSWAT_BOOL << (JSWAT_BITS*3)), (void*)gen_jswrap_DataView_setFloat64),
+  JSWSYMPTR_ENTRY(99, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)) | (JSWAT_BOOL << (JSWAT_BITS*3)), (void*)gen_jswrap_DataView_setInt16),
+  JSWSYMPTR_ENTRY(108, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)) | (JSWAT_BOOL << (JSWAT_BITS*3)), (void*)gen_jswrap_DataView_setInt32),
+  JSWSYMPTR_ENTRY(117, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)) | (JSWAT_BOOL << (JSWAT_BITS*3)), (void*)gen_jswrap_DataView_setInt8),
+  JSWSYMPTR_ENTRY(125, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)) | (JSWAT_BOOL << (JSWAT_BITS*3)), (void*)gen_jswrap_DataView_setUint16),
+  JSWSYMPTR_ENTRY(135, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)) | (JSWAT_BOOL << (JSWAT_BITS*3)), (void*)gen_jswrap_DataView_setUint32),
+  JSWSYMPTR_ENTRY(145, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)) | (JSWAT_BOOL << (JSWAT_BITS*3)), (void*)gen_jswrap_DataView_setUint8)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_DataView_proto[] FLASH_SECT = {4,20,0,5,0,41,21,8,255,7,5,1,3,11,255,6,0,12,2,10,255,13,255,9,15,4,14};
+#endif
+static const unsigned char jswSymbolIndex_DataView_proto = 7;
+static const JswSymPtr jswSymbols_Date[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_JSVARFLOAT, (void*)jswrap_date_now),
+  JSWSYMPTR_ENTRY(4, JSWAT_JSVARFLOAT | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_date_parse)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_Date[] FLASH_SECT = {1,2,0,0,1,0};
+#endif
+static const unsigned char jswSymbolIndex_Date = 8;
+static const JswSymPtr jswSymbols_Date_proto[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_INT32 | JSWAT_THIS_ARG, (void*)jswrap_date_getDate),
+  JSWSYMPTR_ENTRY(8, JSWAT_INT32 | JSWAT_THIS_ARG, (void*)jswrap_date_getDay),
+  JSWSYMPTR_ENTRY(15, JSWAT_INT32 | JSWAT_THIS_ARG, (void*)jswrap_date_getFullYear),
+  JSWSYMPTR_ENTRY(27, JSWAT_INT32 | JSWAT_THIS_ARG, (void*)jswrap_date_getHours),
+  JSWSYMPTR_ENTRY(36, JSWAT_INT32 | JSWAT_THIS_ARG, (void*)jswrap_date_getIsDST),
+  JSWSYMPTR_ENTRY(45, JSWAT_INT32 | JSWAT_THIS_ARG, (void*)jswrap_date_getMilliseconds),
+  JSWSYMPTR_ENTRY(61, JSWAT_INT32 | JSWAT_THIS_ARG, (void*)jswrap_date_getMinutes),
+  JSWSYMPTR_ENTRY(72, JSWAT_INT32 | JSWAT_THIS_ARG, (void*)jswrap_date_getMonth),
+  JSWSYMPTR_ENTRY(81, JSWAT_INT32 | JSWAT_THIS_ARG, (void*)jswrap_date_getSeconds),
+  JSWSYMPTR_ENTRY(92, JSWAT_JSVARFLOAT | JSWAT_THIS_ARG, (void*)jswrap_date_getTime),
+  JSWSYMPTR_ENTRY(100, JSWAT_INT32 | JSWAT_THIS_ARG, (void*)jswrap_date_getTimezoneOffset),
+  JSWSYMPTR_ENTRY(118, JSWAT_INT32 | JSWAT_THIS_ARG, (void*)jswrap_date_getUTCDate),
+  JSWSYMPTR_ENTRY(129, JSWAT_INT32 | JSWAT_THIS_ARG, (void*)jswrap_date_getUTCDay),
+  JSWSYMPTR_ENTRY(139, JSWAT_INT32 | JSWAT_THIS_ARG, (void*)jswrap_date_getUTCFullYear),
+  JSWSYMPTR_ENTRY(154, JSWAT_INT32 | JSWAT_THIS_ARG, (void*)jswrap_date_getUTCHours),
+  JSWSYMPTR_ENTRY(166, JSWAT_INT32 | JSWAT_THIS_ARG, (void*)jswrap_date_getUTCMilliseconds),
+  JSWSYMPTR_ENTRY(185, JSWAT_INT32 | JSWAT_THIS_ARG, (void*)jswrap_date_getUTCMinutes),
+  JSWSYMPTR_ENTRY(199, JSWAT_INT32 | JSWAT_THIS_ARG, (void*)jswrap_date_getUTCMonth),
+  JSWSYMPTR_ENTRY(211, JSWAT_INT32 | JSWAT_THIS_ARG, (void*)jswrap_date_getUTCSeconds),
+  JSWSYMPTR_ENTRY(225, JSWAT_JSVARFLOAT | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)), (void*)jswrap_date_setDate),
+  JSWSYMPTR_ENTRY(233, JSWAT_JSVARFLOAT | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)) | (JSWAT_JSVAR << (JSWAT_BITS*3)), (void*)jswrap_date_setFullYear),
+  JSWSYMPTR_ENTRY(245, JSWAT_JSVARFLOAT | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)) | (JSWAT_JSVAR << (JSWAT_BITS*3)) | (JSWAT_JSVAR << (JSWAT_BITS*4)), (void*)jswrap_date_setHours),
+  JSWSYMPTR_ENTRY(254, JSWAT_JSVARFLOAT | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)), (void*)jswrap_date_setMilliseconds),
+  JSWSYMPTR_ENTRY(270, JSWAT_JSVARFLOAT | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)) | (JSWAT_JSVAR << (JSWAT_BITS*3)), (void*)jswrap_date_setMinutes),
+  JSWSYMPTR_ENTRY(281, JSWAT_JSVARFLOAT | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)jswrap_date_setMonth),
+  JSWSYMPTR_ENTRY(290, JSWAT_JSVARFLOAT | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)jswrap_date_setSeconds),
+  JSWSYMPTR_ENTRY(301, JSWAT_JSVARFLOAT | JSWAT_THIS_ARG | (JSWAT_JSVARFLOAT << (JSWAT_BITS*1)), (void*)jswrap_date_setTime),
+  JSWSYMPTR_ENTRY(309, JSWAT_JSVAR | JSWAT_THIS_ARG, (void*)jswrap_date_toISOString),
+  JSWSYMPTR_ENTRY(321, JSWAT_JSVAR | JSWAT_THIS_ARG, (void*)jswrap_date_toISOString),
+  JSWSYMPTR_ENTRY(328, JSWAT_JSVAR | JSWAT_THIS_ARG, (void*)jswrap_date_toLocalISOString),
+  JSWSYMPTR_ENTRY(345, JSWAT_JSVAR | JSWAT_THIS_ARG, (void*)jswrap_date_toString),
+  JSWSYMPTR_ENTRY(354, JSWAT_JSVAR | JSWAT_THIS_ARG, (void*)jswrap_date_toUTCString),
+  JSWSYMPTR_ENTRY(366, JSWAT_JSVARFLOAT | JSWAT_THIS_ARG, (void*)jswrap_date_getTime)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_Date_proto[] FLASH_SECT = {9,41,0,1,8,0,5,4,6,9,4,1,28,22,5,255,255,3,15,255,14,13,16,0,7,12,255,1,20,6,21,17,2,26,31,255,27,255,24,11,8,255,30,18,255,32,9,4,29,10,23,19,25};
+#endif
+static const unsigned char jswSymbolIndex_Date_proto = 9;
+static const JswSymPtr jswSymbols_Error_proto[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_JSVAR | JSWAT_THIS_ARG, (void*)jswrap_error_toString)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_Error_proto[] FLASH_SECT = {1,1,0,0,0};
+#endif
+static const unsigned char jswSymbolIndex_Error_proto = 10;
+static const JswSymPtr jswSymbols_SyntaxError_proto[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_JSVAR | JSWAT_THIS_ARG, (void*)jswrap_error_toString)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_SyntaxError_proto[] FLASH_SECT = {1,1,0,0,0};
+#endif
+static const unsigned char jswSymbolIndex_SyntaxError_proto = 11;
+static const JswSymPtr jswSymbols_TypeError_proto[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_JSVAR | JSWAT_THIS_ARG, (void*)jswrap_error_toString)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_TypeError_proto[] FLASH_SECT = {1,1,0,0,0};
+#endif
+static const unsigned char jswSymbolIndex_TypeError_proto = 12;
+static const JswSymPtr jswSymbols_InternalError_proto[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_JSVAR | JSWAT_THIS_ARG, (void*)jswrap_error_toString)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_InternalError_proto[] FLASH_SECT = {1,1,0,0,0};
+#endif
+static const unsigned char jswSymbolIndex_InternalError_proto = 13;
+static const JswSymPtr jswSymbols_ReferenceError_proto[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_JSVAR | JSWAT_THIS_ARG, (void*)jswrap_error_toString)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_ReferenceError_proto[] FLASH_SECT = {1,1,0,0,0};
+#endif
+static const unsigned char jswSymbolIndex_ReferenceError_proto = 14;
+static const JswSymPtr jswSymbols_console[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_VOID | (JSWAT_ARGUMENT_ARRAY << (JSWAT_BITS*1)), (void*)jswrap_print),
+  JSWSYMPTR_ENTRY(6, JSWAT_VOID | (JSWAT_ARGUMENT_ARRAY << (JSWAT_BITS*1)), (void*)jswrap_print),
+  JSWSYMPTR_ENTRY(12, JSWAT_VOID | (JSWAT_ARGUMENT_ARRAY << (JSWAT_BITS*1)), (void*)jswrap_print),
+  JSWSYMPTR_ENTRY(17, JSWAT_VOID | (JSWAT_ARGUMENT_ARRAY << (JSWAT_BITS*1)), (void*)jswrap_print),
+  JSWSYMPTR_ENTRY(21, JSWAT_VOID | (JSWAT_ARGUMENT_ARRAY << (JSWAT_BITS*1)), (void*)jswrap_console_trace),
+  JSWSYMPTR_ENTRY(27, JSWAT_VOID | (JSWAT_ARGUMENT_ARRAY << (JSWAT_BITS*1)), (void*)jswrap_print)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_console[] FLASH_SECT = {2,7,0,6,0,1,3,0,2,255,4,5};
+#endif
+static const unsigned char jswSymbolIndex_console = 15;
+static const JswSymPtr jswSymbols_Generator_proto[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_generator_next),
+  JSWSYMPTR_ENTRY(5, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_generator_return),
+  JSWSYMPTR_ENTRY(12, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_generator_throw)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_Generator_proto[] FLASH_SECT = {1,3,0,2,0,2,1};
+#endif
+static const unsigned char jswSymbolIndex_Generator_proto = 16;
+static const JswSymPtr jswSymbols_JSON[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_json_parse),
+  JSWSYMPTR_ENTRY(6, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_json_parser),
+  JSWSYMPTR_ENTRY(13, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)) | (JSWAT_JSVAR << (JSWAT_BITS*3)), (void*)jswrap_json_stringify),
+  JSWSYMPTR_ENTRY(23, JSWAT_BOOL | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)) | (JSWAT_JSVAR << (JSWAT_BITS*3)), (void*)jswrap_json_write)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_JSON[] FLASH_SECT = {1,5,0,11,255,3,2,1,0};
+#endif
+static const unsigned char jswSymbolIndex_JSON = 17;
+static const JswSymPtr jswSymbols_JSONParser_proto[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_VOID | JSWAT_THIS_ARG, (void*)jswrap_jsonparser_end),
+  JSWSYMPTR_ENTRY(4, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_jsonparser_write)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_JSONParser_proto[] FLASH_SECT = {1,2,0,0,1,0};
+#endif
+static const unsigned char jswSymbolIndex_JSONParser_proto = 18;
+static const JswSymPtr jswSymbols_Number[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_JSVARFLOAT | JSWAT_EXECUTE_IMMEDIATELY, (void*)gen_jswrap_Number_MAX_VALUE),
+  JSWSYMPTR_ENTRY(10, JSWAT_JSVARFLOAT | JSWAT_EXECUTE_IMMEDIATELY, (void*)gen_jswrap_Number_MIN_VALUE),
+  JSWSYMPTR_ENTRY(20, JSWAT_JSVARFLOAT | JSWAT_EXECUTE_IMMEDIATELY, (void*)gen_jswrap_Number_NEGATIVE_INFINITY),
+  JSWSYMPTR_ENTRY(38, JSWAT_JSVARFLOAT | JSWAT_EXECUTE_IMMEDIATELY, (void*)gen_jswrap_Number_NaN),
+  JSWSYMPTR_ENTRY(42, JSWAT_JSVARFLOAT | JSWAT_EXECUTE_IMMEDIATELY, (void*)gen_jswrap_Number_POSITIVE_INFINITY)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_Number[] FLASH_SECT = {2,6,0,4,4,0,3,2,1,4,255};
+#endif
+static const unsigned char jswSymbolIndex_Number = 19;
+static const JswSymPtr jswSymbols_Number_proto[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)), (void*)jswrap_number_toFixed)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_Number_proto[] FLASH_SECT = {1,1,0,0,0};
+#endif
+static const unsigned char jswSymbolIndex_Number_proto = 20;
+static const JswSymPtr jswSymbols_Object_proto[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)jswrap_object_on),
+  JSWSYMPTR_ENTRY(12, JSWAT_JSVAR | JSWAT_THIS_ARG, (void*)jswrap_object_clone),
+  JSWSYMPTR_ENTRY(18, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_ARGUMENT_ARRAY << (JSWAT_BITS*2)), (void*)jswrap_object_emit),
+  JSWSYMPTR_ENTRY(23, JSWAT_BOOL | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_object_hasOwnProperty),
+  JSWSYMPTR_ENTRY(38, JSWAT_JSVAR | JSWAT_THIS_ARG | JSWAT_EXECUTE_IMMEDIATELY, (void*)jswrap_object_length),
+  JSWSYMPTR_ENTRY(45, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)jswrap_object_on),
+  JSWSYMPTR_ENTRY(48, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)jswrap_object_prependListener),
+  JSWSYMPTR_ENTRY(64, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_object_removeAllListeners),
+  JSWSYMPTR_ENTRY(83, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)jswrap_object_removeListener),
+  JSWSYMPTR_ENTRY(98, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_object_toString),
+  JSWSYMPTR_ENTRY(107, JSWAT_JSVAR | JSWAT_THIS_ARG, (void*)jswrap_object_valueOf)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_Object_proto[] FLASH_SECT = {3,13,0,34,3,5,2,4,6,9,8,255,0,7,255,3,5,1,10};
+#endif
+static const unsigned char jswSymbolIndex_Object_proto = 21;
+static const JswSymPtr jswSymbols_Object[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_JSVAR | (JSWAT_ARGUMENT_ARRAY << (JSWAT_BITS*1)), (void*)jswrap_object_assign),
+  JSWSYMPTR_ENTRY(7, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)jswrap_object_create),
+  JSWSYMPTR_ENTRY(14, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)jswrap_object_defineProperties),
+  JSWSYMPTR_ENTRY(31, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)) | (JSWAT_JSVAR << (JSWAT_BITS*3)), (void*)jswrap_object_defineProperty),
+  JSWSYMPTR_ENTRY(46, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)gen_jswrap_Object_entries),
+  JSWSYMPTR_ENTRY(54, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_object_fromEntries),
+  JSWSYMPTR_ENTRY(66, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)jswrap_object_getOwnPropertyDescriptor),
+  JSWSYMPTR_ENTRY(91, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_object_getOwnPropertyDescriptors),
+  JSWSYMPTR_ENTRY(117, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)gen_jswrap_Object_getOwnPropertyNames),
+  JSWSYMPTR_ENTRY(137, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_object_getPrototypeOf),
+  JSWSYMPTR_ENTRY(152, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)gen_jswrap_Object_keys),
+  JSWSYMPTR_ENTRY(157, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)jswrap_object_setPrototypeOf),
+  JSWSYMPTR_ENTRY(172, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)gen_jswrap_Object_values)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_Object[] FLASH_SECT = {4,16,0,13,1,4,0,255,255,7,4,10,2,8,5,11,0,6,1,9,12,255,3};
+#endif
+static const unsigned char jswSymbolIndex_Object = 22;
+static const JswSymPtr jswSymbols_Function_proto[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)jswrap_function_apply_or_call),
+  JSWSYMPTR_ENTRY(6, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_ARGUMENT_ARRAY << (JSWAT_BITS*2)), (void*)jswrap_function_bind),
+  JSWSYMPTR_ENTRY(11, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_ARGUMENT_ARRAY << (JSWAT_BITS*2)), (void*)jswrap_function_apply_or_call),
+  JSWSYMPTR_ENTRY(16, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_function_replaceWith)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_Function_proto[] FLASH_SECT = {1,5,0,1,3,1,0,2,255};
+#endif
+static const unsigned char jswSymbolIndex_Function_proto = 23;
+static const JswSymPtr jswSymbols_RegExp_proto[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_regexp_exec),
+  JSWSYMPTR_ENTRY(5, JSWAT_BOOL | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_regexp_test)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_RegExp_proto[] FLASH_SECT = {1,2,0,0,1,0};
+#endif
+static const unsigned char jswSymbolIndex_RegExp_proto = 24;
+static const JswSymPtr jswSymbols_timer[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_INT32 | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_timer_add),
+  JSWSYMPTR_ENTRY(4, JSWAT_JSVAR | (JSWAT_INT32 << (JSWAT_BITS*1)), (void*)jswrap_timer_get),
+  JSWSYMPTR_ENTRY(8, JSWAT_JSVAR, (void*)jswrap_timer_list),
+  JSWSYMPTR_ENTRY(13, JSWAT_BOOL | (JSWAT_INT32 << (JSWAT_BITS*1)), (void*)jswrap_timer_remove)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_timer[] FLASH_SECT = {1,5,0,0,3,0,2,255,1};
+#endif
+static const unsigned char jswSymbolIndex_timer = 25;
+static const JswSymPtr jswSymbols_String_proto[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)), (void*)jswrap_string_charAt),
+  JSWSYMPTR_ENTRY(7, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)), (void*)jswrap_string_charCodeAt),
+  JSWSYMPTR_ENTRY(18, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_ARGUMENT_ARRAY << (JSWAT_BITS*1)), (void*)jswrap_string_concat),
+  JSWSYMPTR_ENTRY(25, JSWAT_BOOL | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)jswrap_string_endsWith),
+  JSWSYMPTR_ENTRY(34, JSWAT_BOOL | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)gen_jswrap_String_includes),
+  JSWSYMPTR_ENTRY(43, JSWAT_INT32 | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)gen_jswrap_String_indexOf),
+  JSWSYMPTR_ENTRY(51, JSWAT_INT32 | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)gen_jswrap_String_lastIndexOf),
+  JSWSYMPTR_ENTRY(63, JSWAT_JSVAR | JSWAT_THIS_ARG | JSWAT_EXECUTE_IMMEDIATELY, (void*)jswrap_object_length),
+  JSWSYMPTR_ENTRY(70, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_string_match),
+  JSWSYMPTR_ENTRY(76, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)gen_jswrap_String_padEnd),
+  JSWSYMPTR_ENTRY(83, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)gen_jswrap_String_padStart),
+  JSWSYMPTR_ENTRY(92, JSWAT_JSVAR | JSWAT_THIS_ARG, (void*)gen_jswrap_String_removeAccents),
+  JSWSYMPTR_ENTRY(106, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)), (void*)jswrap_string_repeat),
+  JSWSYMPTR_ENTRY(113, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)jswrap_string_replace),
+  JSWSYMPTR_ENTRY(121, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)jswrap_string_replaceAll),
+  JSWSYMPTR_ENTRY(132, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)jswrap_string_slice),
+  JSWSYMPTR_ENTRY(138, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_string_split),
+  JSWSYMPTR_ENTRY(144, JSWAT_BOOL | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)), (void*)jswrap_string_startsWith),
+  JSWSYMPTR_ENTRY(155, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)jswrap_string_substr),
+  JSWSYMPTR_ENTRY(162, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)jswrap_string_substring),
+  JSWSYMPTR_ENTRY(172, JSWAT_JSVAR | JSWAT_THIS_ARG, (void*)gen_jswrap_String_toLowerCase),
+  JSWSYMPTR_ENTRY(184, JSWAT_JSVAR | JSWAT_THIS_ARG, (void*)gen_jswrap_String_toUpperCase),
+  JSWSYMPTR_ENTRY(196, JSWAT_JSVAR | JSWAT_THIS_ARG, (void*)jswrap_string_trim)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_String_proto[] FLASH_SECT = {6,28,0,10,4,0,16,49,14,13,255,255,20,255,2,19,255,7,16,5,14,1,15,3,8,6,17,21,11,255,22,9,10,0,12,18,4};
+#endif
+static const unsigned char jswSymbolIndex_String_proto = 26;
+static const JswSymPtr jswSymbols_String[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_JSVAR | (JSWAT_ARGUMENT_ARRAY << (JSWAT_BITS*1)), (void*)jswrap_string_fromCharCode)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_String[] FLASH_SECT = {1,1,0,0,0};
+#endif
+static const unsigned char jswSymbolIndex_String = 27;
+static const JswSymPtr jswSymbols_Modules[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_VOID | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)jswrap_modules_addCached),
+  JSWSYMPTR_ENTRY(10, JSWAT_JSVAR, (void*)jswrap_modules_getCached),
+  JSWSYMPTR_ENTRY(20, JSWAT_VOID, (void*)jswrap_modules_removeAllCached),
+  JSWSYMPTR_ENTRY(36, JSWAT_VOID | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_modules_removeCached)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_Modules[] FLASH_SECT = {1,5,0,12,0,1,2,3,255};
+#endif
+static const unsigned char jswSymbolIndex_Modules = 28;
+static const JswSymPtr jswSymbols_Math[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_JSVARFLOAT | JSWAT_EXECUTE_IMMEDIATELY, (void*)gen_jswrap_Math_E),
+  JSWSYMPTR_ENTRY(2, JSWAT_JSVARFLOAT | JSWAT_EXECUTE_IMMEDIATELY, (void*)gen_jswrap_Math_LN10),
+  JSWSYMPTR_ENTRY(7, JSWAT_JSVARFLOAT | JSWAT_EXECUTE_IMMEDIATELY, (void*)gen_jswrap_Math_LN2),
+  JSWSYMPTR_ENTRY(11, JSWAT_JSVARFLOAT | JSWAT_EXECUTE_IMMEDIATELY, (void*)gen_jswrap_Math_LOG10E),
+  JSWSYMPTR_ENTRY(18, JSWAT_JSVARFLOAT | JSWAT_EXECUTE_IMMEDIATELY, (void*)gen_jswrap_Math_LOG2E),
+  JSWSYMPTR_ENTRY(24, JSWAT_JSVARFLOAT | JSWAT_EXECUTE_IMMEDIATELY, (void*)gen_jswrap_Math_PI),
+  JSWSYMPTR_ENTRY(27, JSWAT_JSVARFLOAT | JSWAT_EXECUTE_IMMEDIATELY, (void*)gen_jswrap_Math_SQRT1_2),
+  JSWSYMPTR_ENTRY(35, JSWAT_JSVARFLOAT | JSWAT_EXECUTE_IMMEDIATELY, (void*)gen_jswrap_Math_SQRT2),
+  JSWSYMPTR_ENTRY(41, JSWAT_JSVARFLOAT | (JSWAT_JSVARFLOAT << (JSWAT_BITS*1)), (void*)fabs),
+  JSWSYMPTR_ENTRY(45, JSWAT_JSVARFLOAT | (JSWAT_JSVARFLOAT << (JSWAT_BITS*1)), (void*)gen_jswrap_Math_acos),
+  JSWSYMPTR_ENTRY(50, JSWAT_JSVARFLOAT | (JSWAT_JSVARFLOAT << (JSWAT_BITS*1)), (void*)jswrap_math_asin),
+  JSWSYMPTR_ENTRY(55, JSWAT_JSVARFLOAT | (JSWAT_JSVARFLOAT << (JSWAT_BITS*1)), (void*)jswrap_math_atan),
+  JSWSYMPTR_ENTRY(60, JSWAT_JSVARFLOAT | (JSWAT_JSVARFLOAT << (JSWAT_BITS*1)) | (JSWAT_JSVARFLOAT << (JSWAT_BITS*2)), (void*)jswrap_math_atan2),
+  JSWSYMPTR_ENTRY(66, JSWAT_JSVARFLOAT | (JSWAT_JSVARFLOAT << (JSWAT_BITS*1)), (void*)ceil),
+  JSWSYMPTR_ENTRY(71, JSWAT_JSVARFLOAT | (JSWAT_JSVARFLOAT << (JSWAT_BITS*1)) | (JSWAT_JSVARFLOAT << (JSWAT_BITS*2)) | (JSWAT_JSVARFLOAT << (JSWAT_BITS*3)), (void*)jswrap_math_clip),
+  JSWSYMPTR_ENTRY(76, JSWAT_JSVARFLOAT | (JSWAT_JSVARFLOAT << (JSWAT_BITS*1)), (void*)jswrap_math_cos),
+  JSWSYMPTR_ENTRY(80, JSWAT_JSVARFLOAT | (JSWAT_JSVARFLOAT << (JSWAT_BITS*1)), (void*)exp),
+  JSWSYMPTR_ENTRY(84, JSWAT_JSVARFLOAT | (JSWAT_JSVARFLOAT << (JSWAT_BITS*1)), (void*)floor),
+  JSWSYMPTR_ENTRY(90, JSWAT_JSVARFLOAT | (JSWAT_JSVARFLOAT << (JSWAT_BITS*1)), (void*)log),
+  JSWSYMPTR_ENTRY(94, JSWAT_JSVARFLOAT | (JSWAT_ARGUMENT_ARRAY << (JSWAT_BITS*1)), (void*)gen_jswrap_Math_max),
+  JSWSYMPTR_ENTRY(98, JSWAT_JSVARFLOAT | (JSWAT_ARGUMENT_ARRAY << (JSWAT_BITS*1)), (void*)gen_jswrap_Math_min),
+  JSWSYMPTR_ENTRY(102, JSWAT_JSVARFLOAT | (JSWAT_JSVARFLOAT << (JSWAT_BITS*1)) | (JSWAT_JSVARFLOAT << (JSWAT_BITS*2)), (void*)jswrap_math_pow),
+  JSWSYMPTR_ENTRY(106, JSWAT_INT32 | (JSWAT_INT32 << (JSWAT_BITS*1)), (void*)gen_jswrap_Math_randInt),
+  JSWSYMPTR_ENTRY(114, JSWAT_JSVARFLOAT, (void*)gen_jswrap_Math_random),
+  JSWSYMPTR_ENTRY(121, JSWAT_JSVAR | (JSWAT_JSVARFLOAT << (JSWAT_BITS*1)), (void*)jswrap_math_round),
+  JSWSYMPTR_ENTRY(127, JSWAT_INT32 | (JSWAT_JSVARFLOAT << (JSWAT_BITS*1)), (void*)jswrap_math_sign),
+  JSWSYMPTR_ENTRY(132, JSWAT_JSVARFLOAT | (JSWAT_JSVARFLOAT << (JSWAT_BITS*1)), (void*)jswrap_math_sin),
+  JSWSYMPTR_ENTRY(136, JSWAT_JSVARFLOAT | (JSWAT_JSVARFLOAT << (JSWAT_BITS*1)), (void*)jswrap_math_sqrt),
+  JSWSYMPTR_ENTRY(141, JSWAT_JSVARFLOAT | (JSWAT_JSVARFLOAT << (JSWAT_BITS*1)), (void*)gen_jswrap_Math_tan),
+  JSWSYMPTR_ENTRY(145, JSWAT_JSVARFLOAT | (JSWAT_JSVARFLOAT << (JSWAT_BITS*1)) | (JSWAT_JSVARFLOAT << (JSWAT_BITS*2)), (void*)wrapAround)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_Math[] FLASH_SECT = {8,37,0,0,2,38,3,29,0,3,0,8,4,21,14,25,255,24,255,6,7,16,5,13,3,15,9,29,23,255,18,26,17,255,10,12,255,255,27,11,22,0,1,2,255,28,19,20};
+#endif
+static const unsigned char jswSymbolIndex_Math = 29;
+static const JswSymPtr jswSymbols_E[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_espruino_CRC32),
+  JSWSYMPTR_ENTRY(6, JSWAT_VOID | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)) | (JSWAT_BOOL << (JSWAT_BITS*3)), (void*)jswrap_espruino_FFT),
+  JSWSYMPTR_ENTRY(10, JSWAT_JSVAR | (JSWAT_JSVARFLOAT << (JSWAT_BITS*1)) | (JSWAT_JSVARFLOAT << (JSWAT_BITS*2)) | (JSWAT_JSVARFLOAT << (JSWAT_BITS*3)) | (JSWAT_INT32 << (JSWAT_BITS*4)), (void*)jswrap_espruino_HSBtoRGB),
+  JSWSYMPTR_ENTRY(19, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_espruino_asUTF8),
+  JSWSYMPTR_ENTRY(26, JSWAT_VOID | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_ARGUMENT_ARRAY << (JSWAT_BITS*2)), (void*)jswrap_espruino_asm),
+  JSWSYMPTR_ENTRY(30, JSWAT_JSVARFLOAT | (JSWAT_JSVARFLOAT << (JSWAT_BITS*1)) | (JSWAT_JSVARFLOAT << (JSWAT_BITS*2)) | (JSWAT_JSVARFLOAT << (JSWAT_BITS*3)), (void*)jswrap_espruino_clip),
+  JSWSYMPTR_ENTRY(35, JSWAT_VOID | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_espruino_compiledC),
+  JSWSYMPTR_ENTRY(45, JSWAT_VOID | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_PIN << (JSWAT_BITS*2)), (void*)jswrap_E_connectSDCard),
+  JSWSYMPTR_ENTRY(59, JSWAT_JSVARFLOAT | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)) | (JSWAT_INT32 << (JSWAT_BITS*3)), (void*)jswrap_espruino_convolve),
+  JSWSYMPTR_ENTRY(68, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)) | (JSWAT_JSVAR << (JSWAT_BITS*3)), (void*)jswrap_espruino_decodeUTF8),
+  JSWSYMPTR_ENTRY(79, JSWAT_VOID, (void*)jsvDefragment),
+  JSWSYMPTR_ENTRY(86, JSWAT_VOID, (void*)jswrap_e_dumpFragmentation),
+  JSWSYMPTR_ENTRY(104, JSWAT_VOID, (void*)jswrap_espruino_dumpFreeList),
+  JSWSYMPTR_ENTRY(117, JSWAT_VOID, (void*)jswrap_espruino_dumpLockedVars),
+  JSWSYMPTR_ENTRY(132, JSWAT_JSVAR, (void*)jswrap_e_dumpStr),
+  JSWSYMPTR_ENTRY(140, JSWAT_VOID, (void*)jswrap_e_dumpVariables),
+  JSWSYMPTR_ENTRY(154, JSWAT_VOID | (JSWAT_JSVARFLOAT << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)jswrap_espruino_enableWatchdog),
+  JSWSYMPTR_ENTRY(169, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_espruino_fromUTF8),
+  JSWSYMPTR_ENTRY(178, JSWAT_INT32 | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_BOOL << (JSWAT_BITS*2)), (void*)jswrap_espruino_getAddressOf),
+  JSWSYMPTR_ENTRY(191, JSWAT_JSVARFLOAT, (void*)gen_jswrap_E_getAnalogVRef),
+  JSWSYMPTR_ENTRY(205, JSWAT_JSVAR, (void*)jswrap_espruino_getClock),
+  JSWSYMPTR_ENTRY(214, JSWAT_JSVAR, (void*)jswrap_espruino_getConsole),
+  JSWSYMPTR_ENTRY(225, JSWAT_JSVAR, (void*)jswrap_espruino_getErrorFlags),
+  JSWSYMPTR_ENTRY(239, JSWAT_JSVAR, (void*)jsfGetFlags),
+  JSWSYMPTR_ENTRY(248, JSWAT_JSVAR, (void*)jswrap_espruino_getPowerUsage),
+  JSWSYMPTR_ENTRY(262, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)), (void*)jswrap_espruino_getSizeOf),
+  JSWSYMPTR_ENTRY(272, JSWAT_JSVARFLOAT | (JSWAT_BOOL << (JSWAT_BITS*1)), (void*)jswrap_espruino_getTemperature),
+  JSWSYMPTR_ENTRY(287, JSWAT_INT32, (void*)jshGetRandomNumber),
+  JSWSYMPTR_ENTRY(294, JSWAT_JSVAR | JSWAT_EXECUTE_IMMEDIATELY, (void*)gen_jswrap_E_internal),
+  JSWSYMPTR_ENTRY(303, JSWAT_BOOL | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_espruino_isUTF8),
+  JSWSYMPTR_ENTRY(310, JSWAT_VOID, (void*)jswrap_espruino_kickWatchdog),
+  JSWSYMPTR_ENTRY(323, JSWAT_VOID, (void*)jswrap_espruino_lockConsole),
+  JSWSYMPTR_ENTRY(335, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)) | (JSWAT_BOOL << (JSWAT_BITS*3)), (void*)jswrap_espruino_lookupNoCase),
+  JSWSYMPTR_ENTRY(348, JSWAT_VOID | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)) | (JSWAT_JSVAR << (JSWAT_BITS*3)) | (JSWAT_INT32 << (JSWAT_BITS*4)), (void*)jswrap_espruino_mapInPlace),
+  JSWSYMPTR_ENTRY(359, JSWAT_JSVAR | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)), (void*)jswrap_espruino_memoryArea),
+  JSWSYMPTR_ENTRY(370, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)jswrap_espruino_memoryMap),
+  JSWSYMPTR_ENTRY(380, JSWAT_JSVAR | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)) | (JSWAT_JSVAR << (JSWAT_BITS*3)), (void*)jswrap_espruino_nativeCall),
+  JSWSYMPTR_ENTRY(391, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)jswrap_E_openFile),
+  JSWSYMPTR_ENTRY(400, JSWAT_VOID | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)) | (JSWAT_JSVAR << (JSWAT_BITS*3)), (void*)jswrap_pipe),
+  JSWSYMPTR_ENTRY(405, JSWAT_VOID, (void*)jswrap_espruino_reboot),
+  JSWSYMPTR_ENTRY(412, JSWAT_INT32 | (JSWAT_INT32 << (JSWAT_BITS*1)), (void*)jswrap_espruino_reverseByte),
+  JSWSYMPTR_ENTRY(424, JSWAT_VOID | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_BOOL << (JSWAT_BITS*2)), (void*)jswrap_espruino_setBootCode),
+  JSWSYMPTR_ENTRY(436, JSWAT_INT32 | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_espruino_setClock),
+  JSWSYMPTR_ENTRY(445, JSWAT_VOID | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)jswrap_espruino_setConsole),
+  JSWSYMPTR_ENTRY(456, JSWAT_VOID | (JSWAT_ARGUMENT_ARRAY << (JSWAT_BITS*1)), (void*)jswrap_espruino_setDST),
+  JSWSYMPTR_ENTRY(463, JSWAT_VOID | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jsfSetFlags),
+  JSWSYMPTR_ENTRY(472, JSWAT_VOID | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_espruino_setPassword),
+  JSWSYMPTR_ENTRY(484, JSWAT_VOID | (JSWAT_JSVARFLOAT << (JSWAT_BITS*1)), (void*)jswrap_espruino_setTimeZone),
+  JSWSYMPTR_ENTRY(496, JSWAT_VOID | (JSWAT_INT32 << (JSWAT_BITS*1)), (void*)srand),
+  JSWSYMPTR_ENTRY(502, JSWAT_VOID, (void*)jswrap_espruino_stopEventPropagation),
+  JSWSYMPTR_ENTRY(523, JSWAT_JSVARFLOAT | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_espruino_sum),
+  JSWSYMPTR_ENTRY(527, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_espruino_toArrayBuffer),
+  JSWSYMPTR_ENTRY(541, JSWAT_JSVAR | (JSWAT_ARGUMENT_ARRAY << (JSWAT_BITS*1)), (void*)jswrap_espruino_toFlatString),
+  JSWSYMPTR_ENTRY(554, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_espruino_toJS),
+  JSWSYMPTR_ENTRY(559, JSWAT_JSVAR | (JSWAT_ARGUMENT_ARRAY << (JSWAT_BITS*1)), (void*)jswrap_espruino_toString),
+  JSWSYMPTR_ENTRY(568, JSWAT_JSVAR | (JSWAT_ARGUMENT_ARRAY << (JSWAT_BITS*1)), (void*)jswrap_espruino_toUint8Array),
+  JSWSYMPTR_ENTRY(581, JSWAT_VOID, (void*)jswrap_E_unmountSD),
+  JSWSYMPTR_ENTRY(591, JSWAT_JSVARFLOAT | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVARFLOAT << (JSWAT_BITS*2)), (void*)jswrap_espruino_variance)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_E[] FLASH_SECT = {15,72,0,1,12,4,3,0,1,0,1,5,1,1,1,16,1,52,52,15,30,18,255,255,14,44,57,39,23,32,255,9,31,255,46,11,25,0,255,255,41,37,255,2,8,1,255,54,19,50,36,6,255,42,16,255,43,29,55,38,34,4,12,49,255,28,26,53,40,10,255,48,47,3,13,255,17,22,56,24,20,45,27,5,255,35,7,21,51,33};
+#endif
+static const unsigned char jswSymbolIndex_E = 30;
+static const JswSymPtr jswSymbols_Flash[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_VOID | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_flash_erasePage),
+  JSWSYMPTR_ENTRY(10, JSWAT_JSVAR, (void*)jswrap_flash_getFree),
+  JSWSYMPTR_ENTRY(18, JSWAT_JSVAR | (JSWAT_INT32 << (JSWAT_BITS*1)), (void*)jswrap_flash_getPage),
+  JSWSYMPTR_ENTRY(26, JSWAT_JSVAR | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)), (void*)jswrap_flash_read),
+  JSWSYMPTR_ENTRY(31, JSWAT_VOID | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)), (void*)jswrap_flash_write)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_Flash[] FLASH_SECT = {2,6,0,3,0,2,4,255,1,3,0};
+#endif
+static const unsigned char jswSymbolIndex_Flash = 31;
+static const JswSymPtr jswSymbols_fs[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_BOOL | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)gen_jswrap_fs_appendFile),
+  JSWSYMPTR_ENTRY(11, JSWAT_BOOL | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)gen_jswrap_fs_appendFileSync),
+  JSWSYMPTR_ENTRY(26, JSWAT_BOOL | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_fs_mkdir),
+  JSWSYMPTR_ENTRY(32, JSWAT_BOOL | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_fs_mkdir),
+  JSWSYMPTR_ENTRY(42, JSWAT_VOID | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)) | (JSWAT_JSVAR << (JSWAT_BITS*3)), (void*)jswrap_pipe),
+  JSWSYMPTR_ENTRY(47, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_fs_readFile),
+  JSWSYMPTR_ENTRY(56, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_fs_readFile),
+  JSWSYMPTR_ENTRY(69, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_fs_readdir),
+  JSWSYMPTR_ENTRY(77, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_fs_readdir),
+  JSWSYMPTR_ENTRY(89, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_fs_stat),
+  JSWSYMPTR_ENTRY(98, JSWAT_BOOL | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_fs_unlink),
+  JSWSYMPTR_ENTRY(105, JSWAT_BOOL | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_fs_unlink),
+  JSWSYMPTR_ENTRY(116, JSWAT_BOOL | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)gen_jswrap_fs_writeFile),
+  JSWSYMPTR_ENTRY(126, JSWAT_BOOL | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)gen_jswrap_fs_writeFileSync)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_fs[] FLASH_SECT = {4,17,0,0,4,20,0,13,255,0,8,2,255,10,1,5,12,11,4,3,9,6,255,7};
+#endif
+static const unsigned char jswSymbolIndex_fs = 32;
+static const JswSymPtr jswSymbols_process[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_JSVAR | JSWAT_EXECUTE_IMMEDIATELY, (void*)jswrap_process_env),
+  JSWSYMPTR_ENTRY(4, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_process_memory),
+  JSWSYMPTR_ENTRY(11, JSWAT_JSVAR | JSWAT_EXECUTE_IMMEDIATELY, (void*)gen_jswrap_process_version)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_process[] FLASH_SECT = {1,3,0,0,2,0,1};
+#endif
+static const unsigned char jswSymbolIndex_process = 33;
+static const JswSymPtr jswSymbols_OneWire_proto[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_onewire_read),
+  JSWSYMPTR_ENTRY(5, JSWAT_BOOL | JSWAT_THIS_ARG, (void*)jswrap_onewire_reset),
+  JSWSYMPTR_ENTRY(11, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)), (void*)jswrap_onewire_search),
+  JSWSYMPTR_ENTRY(18, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_onewire_select),
+  JSWSYMPTR_ENTRY(25, JSWAT_VOID | JSWAT_THIS_ARG, (void*)jswrap_onewire_skip),
+  JSWSYMPTR_ENTRY(30, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_BOOL << (JSWAT_BITS*2)), (void*)jswrap_onewire_write)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_OneWire_proto[] FLASH_SECT = {2,7,0,2,27,3,255,0,5,1,2,4};
+#endif
+static const unsigned char jswSymbolIndex_OneWire_proto = 34;
+static const JswSymPtr jswSymbols_Promise[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_promise_all),
+  JSWSYMPTR_ENTRY(4, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_promise_reject),
+  JSWSYMPTR_ENTRY(11, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_promise_resolve)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_Promise[] FLASH_SECT = {1,3,0,1,0,1,2};
+#endif
+static const unsigned char jswSymbolIndex_Promise = 35;
+static const JswSymPtr jswSymbols_Promise_proto[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_promise_catch),
+  JSWSYMPTR_ENTRY(6, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)jswrap_promise_then)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_Promise_proto[] FLASH_SECT = {1,2,0,1,1,0};
+#endif
+static const unsigned char jswSymbolIndex_Promise_proto = 36;
+static const JswSymPtr jswSymbols_Serial[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_JSVAR | (JSWAT_PIN << (JSWAT_BITS*1)), (void*)gen_jswrap_Serial_find)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_Serial[] FLASH_SECT = {1,1,0,0,0};
+#endif
+static const unsigned char jswSymbolIndex_Serial = 37;
+static const JswSymPtr jswSymbols_Serial_proto[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_INT32 | JSWAT_THIS_ARG, (void*)jswrap_stream_available),
+  JSWSYMPTR_ENTRY(10, JSWAT_VOID | JSWAT_THIS_ARG, (void*)jswrap_serial_flush),
+  JSWSYMPTR_ENTRY(16, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_ARGUMENT_ARRAY << (JSWAT_BITS*1)), (void*)jswrap_serial_inject),
+  JSWSYMPTR_ENTRY(23, JSWAT_BOOL | JSWAT_THIS_ARG, (void*)jswrap_serial_isConnected),
+  JSWSYMPTR_ENTRY(35, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)jswrap_pipe),
+  JSWSYMPTR_ENTRY(40, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_serial_print),
+  JSWSYMPTR_ENTRY(46, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_serial_println),
+  JSWSYMPTR_ENTRY(54, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)), (void*)jswrap_stream_read),
+  JSWSYMPTR_ENTRY(59, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_BOOL << (JSWAT_BITS*1)), (void*)jswrap_serial_setConsole),
+  JSWSYMPTR_ENTRY(70, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)jswrap_serial_setup),
+  JSWSYMPTR_ENTRY(76, JSWAT_VOID | JSWAT_THIS_ARG, (void*)jswrap_serial_unsetup),
+  JSWSYMPTR_ENTRY(84, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_ARGUMENT_ARRAY << (JSWAT_BITS*1)), (void*)jswrap_serial_write)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_Serial_proto[] FLASH_SECT = {3,15,0,0,26,4,3,7,6,4,10,8,255,255,1,9,255,0,2,5,11};
+#endif
+static const unsigned char jswSymbolIndex_Serial_proto = 38;
+static const JswSymPtr jswSymbols_Storage[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_VOID | (JSWAT_BOOL << (JSWAT_BITS*1)), (void*)jswrap_storage_compact),
+  JSWSYMPTR_ENTRY(8, JSWAT_VOID | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_storage_erase),
+  JSWSYMPTR_ENTRY(14, JSWAT_VOID, (void*)jswrap_storage_eraseAll),
+  JSWSYMPTR_ENTRY(23, JSWAT_INT32 | (JSWAT_BOOL << (JSWAT_BITS*1)), (void*)jswrap_storage_getFree),
+  JSWSYMPTR_ENTRY(31, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_storage_getStats),
+  JSWSYMPTR_ENTRY(40, JSWAT_INT32 | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_storage_hash),
+  JSWSYMPTR_ENTRY(45, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)jswrap_storage_list),
+  JSWSYMPTR_ENTRY(50, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)) | (JSWAT_JSVAR << (JSWAT_BITS*3)), (void*)jswrap_storage_open),
+  JSWSYMPTR_ENTRY(55, JSWAT_VOID, (void*)jswrap_storage_optimise),
+  JSWSYMPTR_ENTRY(64, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)) | (JSWAT_INT32 << (JSWAT_BITS*3)), (void*)jswrap_storage_read),
+  JSWSYMPTR_ENTRY(69, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_storage_readArrayBuffer),
+  JSWSYMPTR_ENTRY(85, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_BOOL << (JSWAT_BITS*2)), (void*)jswrap_storage_readJSON),
+  JSWSYMPTR_ENTRY(94, JSWAT_BOOL | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)) | (JSWAT_JSVAR << (JSWAT_BITS*3)) | (JSWAT_INT32 << (JSWAT_BITS*4)), (void*)jswrap_storage_write),
+  JSWSYMPTR_ENTRY(100, JSWAT_BOOL | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)jswrap_storage_writeJSON)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_Storage[] FLASH_SECT = {4,17,0,9,0,7,9,4,0,255,13,6,8,7,255,12,10,11,3,255,9,2,5,1};
+#endif
+static const unsigned char jswSymbolIndex_Storage = 39;
+static const JswSymPtr jswSymbols_StorageFile_proto[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_VOID | JSWAT_THIS_ARG, (void*)jswrap_storagefile_erase),
+  JSWSYMPTR_ENTRY(6, JSWAT_VOID | JSWAT_THIS_ARG, (void*)jswrap_storagefile_flush),
+  JSWSYMPTR_ENTRY(12, JSWAT_INT32 | JSWAT_THIS_ARG, (void*)jswrap_storagefile_getLength),
+  JSWSYMPTR_ENTRY(22, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)jswrap_pipe),
+  JSWSYMPTR_ENTRY(27, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)), (void*)jswrap_storagefile_read),
+  JSWSYMPTR_ENTRY(32, JSWAT_JSVAR | JSWAT_THIS_ARG, (void*)jswrap_storagefile_readLine),
+  JSWSYMPTR_ENTRY(41, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)), (void*)jswrap_storagefile_seek),
+  JSWSYMPTR_ENTRY(46, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)), (void*)jswrap_storagefile_seekLine),
+  JSWSYMPTR_ENTRY(55, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_storagefile_write)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_StorageFile_proto[] FLASH_SECT = {3,11,0,8,0,7,3,5,6,255,4,255,8,7,2,0,1};
+#endif
+static const unsigned char jswSymbolIndex_StorageFile_proto = 40;
+static const JswSymPtr jswSymbols_SPI[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_JSVAR | (JSWAT_PIN << (JSWAT_BITS*1)), (void*)gen_jswrap_SPI_find)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_SPI[] FLASH_SECT = {1,1,0,0,0};
+#endif
+static const unsigned char jswSymbolIndex_SPI = 41;
+static const JswSymPtr jswSymbols_SPI_proto[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_PIN << (JSWAT_BITS*2)), (void*)jswrap_spi_send),
+  JSWSYMPTR_ENTRY(5, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)) | (JSWAT_INT32 << (JSWAT_BITS*3)) | (JSWAT_PIN << (JSWAT_BITS*4)), (void*)jswrap_spi_send4bit),
+  JSWSYMPTR_ENTRY(14, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)) | (JSWAT_INT32 << (JSWAT_BITS*3)) | (JSWAT_PIN << (JSWAT_BITS*4)), (void*)jswrap_spi_send8bit),
+  JSWSYMPTR_ENTRY(23, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_spi_setup),
+  JSWSYMPTR_ENTRY(29, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_ARGUMENT_ARRAY << (JSWAT_BITS*1)), (void*)jswrap_spi_write)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_SPI_proto[] FLASH_SECT = {2,6,0,1,0,3,0,4,2,1,255};
+#endif
+static const unsigned char jswSymbolIndex_SPI_proto = 42;
+static const JswSymPtr jswSymbols_I2C[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_JSVAR | (JSWAT_PIN << (JSWAT_BITS*1)), (void*)gen_jswrap_I2C_find)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_I2C[] FLASH_SECT = {1,1,0,0,0};
+#endif
+static const unsigned char jswSymbolIndex_I2C = 43;
+static const JswSymPtr jswSymbols_I2C_proto[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)), (void*)jswrap_i2c_readFrom),
+  JSWSYMPTR_ENTRY(9, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)) | (JSWAT_INT32 << (JSWAT_BITS*3)), (void*)jswrap_i2c_readReg),
+  JSWSYMPTR_ENTRY(17, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_i2c_setup),
+  JSWSYMPTR_ENTRY(23, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_ARGUMENT_ARRAY << (JSWAT_BITS*2)), (void*)jswrap_i2c_writeTo)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_I2C_proto[] FLASH_SECT = {1,5,0,0,3,1,0,255,2};
+#endif
+static const unsigned char jswSymbolIndex_I2C_proto = 44;
+static const JswSymPtr jswSymbols_Waveform_proto[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_PIN << (JSWAT_BITS*1)) | (JSWAT_JSVARFLOAT << (JSWAT_BITS*2)) | (JSWAT_JSVAR << (JSWAT_BITS*3)), (void*)jswrap_waveform_startInput),
+  JSWSYMPTR_ENTRY(11, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_PIN << (JSWAT_BITS*1)) | (JSWAT_JSVARFLOAT << (JSWAT_BITS*2)) | (JSWAT_JSVAR << (JSWAT_BITS*3)), (void*)jswrap_waveform_startOutput),
+  JSWSYMPTR_ENTRY(23, JSWAT_VOID | JSWAT_THIS_ARG, (void*)jswrap_waveform_stop)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_Waveform_proto[] FLASH_SECT = {1,3,0,20,2,0,1};
+#endif
+static const unsigned char jswSymbolIndex_Waveform_proto = 45;
+static const JswSymPtr jswSymbols_heatshrink[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_heatshrink_compress),
+  JSWSYMPTR_ENTRY(9, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_heatshrink_decompress)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_heatshrink[] FLASH_SECT = {1,2,0,0,1,0};
+#endif
+static const unsigned char jswSymbolIndex_heatshrink = 46;
+static const JswSymPtr jswSymbols_File_proto[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_VOID | JSWAT_THIS_ARG, (void*)gen_jswrap_File_close),
+  JSWSYMPTR_ENTRY(6, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)jswrap_pipe),
+  JSWSYMPTR_ENTRY(11, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)), (void*)jswrap_file_read),
+  JSWSYMPTR_ENTRY(16, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)), (void*)gen_jswrap_File_seek),
+  JSWSYMPTR_ENTRY(21, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)), (void*)gen_jswrap_File_skip),
+  JSWSYMPTR_ENTRY(26, JSWAT_INT32 | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_file_write)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_File_proto[] FLASH_SECT = {2,7,0,1,1,5,4,255,2,3,0,1};
+#endif
+static const unsigned char jswSymbolIndex_File_proto = 47;
+static const JswSymPtr jswSymbols_Graphics_proto[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_JSVAR | JSWAT_THIS_ARG, (void*)jswrap_graphics_asBMP),
+  JSWSYMPTR_ENTRY(6, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_graphics_asImage),
+  JSWSYMPTR_ENTRY(14, JSWAT_JSVAR | JSWAT_THIS_ARG, (void*)jswrap_graphics_asURL),
+  JSWSYMPTR_ENTRY(20, JSWAT_INT32 | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)) | (JSWAT_JSVAR << (JSWAT_BITS*3)), (void*)jswrap_graphics_blendColor),
+  JSWSYMPTR_ENTRY(31, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_graphics_blit),
+  JSWSYMPTR_ENTRY(36, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_BOOL << (JSWAT_BITS*1)), (void*)jswrap_graphics_clear),
+  JSWSYMPTR_ENTRY(42, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)) | (JSWAT_INT32 << (JSWAT_BITS*3)) | (JSWAT_INT32 << (JSWAT_BITS*4)), (void*)jswrap_graphics_clearRect),
+  JSWSYMPTR_ENTRY(52, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)) | (JSWAT_INT32 << (JSWAT_BITS*3)), (void*)jswrap_graphics_drawCircle),
+  JSWSYMPTR_ENTRY(63, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)) | (JSWAT_INT32 << (JSWAT_BITS*3)), (void*)jswrap_graphics_drawCircleAA),
+  JSWSYMPTR_ENTRY(76, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)) | (JSWAT_INT32 << (JSWAT_BITS*3)) | (JSWAT_INT32 << (JSWAT_BITS*4)), (void*)jswrap_graphics_drawEllipse),
+  JSWSYMPTR_ENTRY(88, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)) | (JSWAT_INT32 << (JSWAT_BITS*3)) | (JSWAT_JSVAR << (JSWAT_BITS*4)), (void*)jswrap_graphics_drawImage),
+  JSWSYMPTR_ENTRY(98, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)jswrap_graphics_drawImages),
+  JSWSYMPTR_ENTRY(109, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)) | (JSWAT_INT32 << (JSWAT_BITS*3)) | (JSWAT_INT32 << (JSWAT_BITS*4)), (void*)jswrap_graphics_drawLine),
+  JSWSYMPTR_ENTRY(118, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVARFLOAT << (JSWAT_BITS*1)) | (JSWAT_JSVARFLOAT << (JSWAT_BITS*2)) | (JSWAT_JSVARFLOAT << (JSWAT_BITS*3)) | (JSWAT_JSVARFLOAT << (JSWAT_BITS*4)), (void*)jswrap_graphics_drawLineAA),
+  JSWSYMPTR_ENTRY(129, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_BOOL << (JSWAT_BITS*2)), (void*)gen_jswrap_Graphics_drawPoly),
+  JSWSYMPTR_ENTRY(138, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_BOOL << (JSWAT_BITS*2)), (void*)gen_jswrap_Graphics_drawPolyAA),
+  JSWSYMPTR_ENTRY(149, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)) | (JSWAT_INT32 << (JSWAT_BITS*3)) | (JSWAT_INT32 << (JSWAT_BITS*4)), (void*)jswrap_graphics_drawRect),
+  JSWSYMPTR_ENTRY(158, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)) | (JSWAT_INT32 << (JSWAT_BITS*3)) | (JSWAT_BOOL << (JSWAT_BITS*4)), (void*)jswrap_graphics_drawString),
+  JSWSYMPTR_ENTRY(169, JSWAT_VOID | JSWAT_THIS_ARG, (void*)jswrap_graphics_dump),
+  JSWSYMPTR_ENTRY(174, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)) | (JSWAT_INT32 << (JSWAT_BITS*3)), (void*)jswrap_graphics_fillCircle),
+  JSWSYMPTR_ENTRY(185, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)) | (JSWAT_INT32 << (JSWAT_BITS*3)) | (JSWAT_INT32 << (JSWAT_BITS*4)), (void*)jswrap_graphics_fillEllipse),
+  JSWSYMPTR_ENTRY(197, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)gen_jswrap_Graphics_fillPoly),
+  JSWSYMPTR_ENTRY(206, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)gen_jswrap_Graphics_fillPolyAA),
+  JSWSYMPTR_ENTRY(217, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)) | (JSWAT_INT32 << (JSWAT_BITS*3)) | (JSWAT_INT32 << (JSWAT_BITS*4)), (void*)jswrap_graphics_fillRect),
+  JSWSYMPTR_ENTRY(226, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)jswrap_graphics_filter),
+  JSWSYMPTR_ENTRY(233, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)) | (JSWAT_JSVAR << (JSWAT_BITS*3)), (void*)jswrap_graphics_floodFill),
+  JSWSYMPTR_ENTRY(243, JSWAT_INT32 | JSWAT_THIS_ARG, (void*)jswrap_graphics_getBPP),
+  JSWSYMPTR_ENTRY(250, JSWAT_INT32 | JSWAT_THIS_ARG, (void*)gen_jswrap_Graphics_getBgColor),
+  JSWSYMPTR_ENTRY(261, JSWAT_INT32 | JSWAT_THIS_ARG, (void*)gen_jswrap_Graphics_getColor),
+  JSWSYMPTR_ENTRY(270, JSWAT_JSVAR | JSWAT_THIS_ARG, (void*)jswrap_graphics_getFont),
+  JSWSYMPTR_ENTRY(278, JSWAT_INT32 | JSWAT_THIS_ARG, (void*)jswrap_graphics_getFontHeight),
+  JSWSYMPTR_ENTRY(292, JSWAT_JSVAR | JSWAT_THIS_ARG, (void*)jswrap_graphics_getFonts),
+  JSWSYMPTR_ENTRY(301, JSWAT_INT32 | JSWAT_THIS_ARG, (void*)gen_jswrap_Graphics_getHeight),
+  JSWSYMPTR_ENTRY(311, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_BOOL << (JSWAT_BITS*1)), (void*)jswrap_graphics_getModified),
+  JSWSYMPTR_ENTRY(323, JSWAT_INT32 | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)), (void*)jswrap_graphics_getPixel),
+  JSWSYMPTR_ENTRY(332, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)jswrap_graphics_getVectorFontPolys),
+  JSWSYMPTR_ENTRY(351, JSWAT_INT32 | JSWAT_THIS_ARG, (void*)gen_jswrap_Graphics_getWidth),
+  JSWSYMPTR_ENTRY(360, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_graphics_imageMetrics),
+  JSWSYMPTR_ENTRY(373, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)), (void*)jswrap_graphics_lineTo),
+  JSWSYMPTR_ENTRY(380, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)), (void*)jswrap_graphics_moveTo),
+  JSWSYMPTR_ENTRY(387, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)jswrap_graphics_quadraticBezier),
+  JSWSYMPTR_ENTRY(403, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_graphics_reset),
+  JSWSYMPTR_ENTRY(409, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)), (void*)jswrap_graphics_scroll),
+  JSWSYMPTR_ENTRY(416, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)) | (JSWAT_JSVAR << (JSWAT_BITS*3)), (void*)gen_jswrap_Graphics_setBgColor),
+  JSWSYMPTR_ENTRY(427, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)) | (JSWAT_INT32 << (JSWAT_BITS*3)) | (JSWAT_INT32 << (JSWAT_BITS*4)), (void*)jswrap_graphics_setClipRect),
+  JSWSYMPTR_ENTRY(439, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)) | (JSWAT_JSVAR << (JSWAT_BITS*3)), (void*)gen_jswrap_Graphics_setColor),
+  JSWSYMPTR_ENTRY(448, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)), (void*)jswrap_graphics_setFont),
+  JSWSYMPTR_ENTRY(456, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)) | (JSWAT_INT32 << (JSWAT_BITS*3)), (void*)jswrap_graphics_setFontAlign),
+  JSWSYMPTR_ENTRY(469, JSWAT_JSVAR | JSWAT_THIS_ARG, (void*)gen_jswrap_Graphics_setFontBitmap),
+  JSWSYMPTR_ENTRY(483, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)) | (JSWAT_JSVAR << (JSWAT_BITS*3)) | (JSWAT_INT32 << (JSWAT_BITS*4)), (void*)jswrap_graphics_setFontCustom),
+  JSWSYMPTR_ENTRY(497, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)), (void*)jswrap_graphics_setFontPBF),
+  JSWSYMPTR_ENTRY(508, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)), (void*)gen_jswrap_Graphics_setFontVector),
+  JSWSYMPTR_ENTRY(522, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)), (void*)jswrap_graphics_setOffset),
+  JSWSYMPTR_ENTRY(532, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)) | (JSWAT_JSVAR << (JSWAT_BITS*3)), (void*)jswrap_graphics_setPixel),
+  JSWSYMPTR_ENTRY(541, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_BOOL << (JSWAT_BITS*2)), (void*)jswrap_graphics_setRotation),
+  JSWSYMPTR_ENTRY(553, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_graphics_setTheme),
+  JSWSYMPTR_ENTRY(562, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_graphics_stringMetrics),
+  JSWSYMPTR_ENTRY(576, JSWAT_INT32 | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_graphics_stringWidth),
+  JSWSYMPTR_ENTRY(588, JSWAT_JSVAR | JSWAT_THIS_ARG | JSWAT_EXECUTE_IMMEDIATELY, (void*)jswrap_graphics_theme),
+  JSWSYMPTR_ENTRY(594, JSWAT_INT32 | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)) | (JSWAT_JSVAR << (JSWAT_BITS*3)), (void*)jswrap_graphics_toColor),
+  JSWSYMPTR_ENTRY(602, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)jswrap_graphics_transformVertices),
+  JSWSYMPTR_ENTRY(620, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)), (void*)jswrap_graphics_wrapString)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_Graphics_proto[] FLASH_SECT = {16,77,0,1,19,1,14,8,3,0,0,7,57,11,12,14,15,3,41,34,14,32,11,24,23,16,255,42,15,5,255,58,255,0,41,48,43,8,1,60,31,26,255,59,36,17,255,27,255,61,56,255,255,45,19,255,9,40,6,29,51,47,39,46,49,37,22,2,25,50,255,13,10,21,52,44,53,3,57,255,7,30,20,255,255,55,255,33,54,28,4,18,38,35,255,12};
+#endif
+static const unsigned char jswSymbolIndex_Graphics_proto = 48;
+static const JswSymPtr jswSymbols_Graphics[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_JSVAR | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)) | (JSWAT_INT32 << (JSWAT_BITS*3)) | (JSWAT_JSVAR << (JSWAT_BITS*4)), (void*)jswrap_graphics_createArrayBuffer),
+  JSWSYMPTR_ENTRY(18, JSWAT_JSVAR | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_INT32 << (JSWAT_BITS*2)) | (JSWAT_INT32 << (JSWAT_BITS*3)) | (JSWAT_JSVAR << (JSWAT_BITS*4)), (void*)jswrap_graphics_createCallback),
+  JSWSYMPTR_ENTRY(33, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_graphics_createImage),
+  JSWSYMPTR_ENTRY(45, JSWAT_JSVAR, (void*)jswrap_graphics_getInstance)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_Graphics[] FLASH_SECT = {1,5,0,10,0,1,2,3,255};
+#endif
+static const unsigned char jswSymbolIndex_Graphics = 49;
+static const JswSymPtr jswSymbols_url[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_BOOL << (JSWAT_BITS*2)), (void*)jswrap_url_parse)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_url[] FLASH_SECT = {1,1,0,0,0};
+#endif
+static const unsigned char jswSymbolIndex_url = 50;
+static const JswSymPtr jswSymbols_Socket[] FLASH_SECT = {
+  
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_Socket[] FLASH_SECT = {1,1,0,0,255};
+#endif
+static const unsigned char jswSymbolIndex_Socket = 51;
+static const JswSymPtr jswSymbols_Socket_proto[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_INT32 | JSWAT_THIS_ARG, (void*)jswrap_stream_available),
+  JSWSYMPTR_ENTRY(10, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_net_socket_end),
+  JSWSYMPTR_ENTRY(14, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)jswrap_pipe),
+  JSWSYMPTR_ENTRY(19, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)), (void*)jswrap_stream_read),
+  JSWSYMPTR_ENTRY(24, JSWAT_BOOL | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_net_socket_write)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_Socket_proto[] FLASH_SECT = {2,6,0,0,2,4,2,3,255,0,1};
+#endif
+static const unsigned char jswSymbolIndex_Socket_proto = 52;
+static const JswSymPtr jswSymbols_net[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)gen_jswrap_net_connect),
+  JSWSYMPTR_ENTRY(8, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_net_createServer)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_net[] FLASH_SECT = {1,2,0,0,0,1};
+#endif
+static const unsigned char jswSymbolIndex_net = 53;
+static const JswSymPtr jswSymbols_dgram[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)gen_jswrap_dgram_createSocket)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_dgram[] FLASH_SECT = {1,1,0,0,0};
+#endif
+static const unsigned char jswSymbolIndex_dgram = 54;
+static const JswSymPtr jswSymbols_dgramSocket_proto[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)jswrap_dgram_addMembership),
+  JSWSYMPTR_ENTRY(14, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)jswrap_dgramSocket_bind),
+  JSWSYMPTR_ENTRY(19, JSWAT_VOID | JSWAT_THIS_ARG, (void*)jswrap_dgram_close),
+  JSWSYMPTR_ENTRY(25, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)) | (JSWAT_JSVAR << (JSWAT_BITS*3)) | (JSWAT_ARGUMENT_ARRAY << (JSWAT_BITS*4)), (void*)jswrap_dgram_socket_send)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_dgramSocket_proto[] FLASH_SECT = {1,5,0,1,2,1,255,3,0};
+#endif
+static const unsigned char jswSymbolIndex_dgramSocket_proto = 55;
+static const JswSymPtr jswSymbols_dgramSocket[] FLASH_SECT = {
+  
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_dgramSocket[] FLASH_SECT = {1,1,0,0,255};
+#endif
+static const unsigned char jswSymbolIndex_dgramSocket = 56;
+static const JswSymPtr jswSymbols_tls[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)gen_jswrap_tls_connect)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_tls[] FLASH_SECT = {1,1,0,0,0};
+#endif
+static const unsigned char jswSymbolIndex_tls = 57;
+static const JswSymPtr jswSymbols_Server_proto[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_VOID | JSWAT_THIS_ARG, (void*)jswrap_net_server_close),
+  JSWSYMPTR_ENTRY(6, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)), (void*)gen_jswrap_Server_listen)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_Server_proto[] FLASH_SECT = {1,2,0,1,1,0};
+#endif
+static const unsigned char jswSymbolIndex_Server_proto = 58;
+static const JswSymPtr jswSymbols_httpSRq[] FLASH_SECT = {
+  
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_httpSRq[] FLASH_SECT = {1,1,0,0,255};
+#endif
+static const unsigned char jswSymbolIndex_httpSRq = 59;
+static const JswSymPtr jswSymbols_httpSRq_proto[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_INT32 | JSWAT_THIS_ARG, (void*)jswrap_stream_available),
+  JSWSYMPTR_ENTRY(10, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)jswrap_pipe),
+  JSWSYMPTR_ENTRY(15, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)), (void*)jswrap_stream_read)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_httpSRq_proto[] FLASH_SECT = {1,3,0,8,1,0,2};
+#endif
+static const unsigned char jswSymbolIndex_httpSRq_proto = 60;
+static const JswSymPtr jswSymbols_httpSRs[] FLASH_SECT = {
+  
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_httpSRs[] FLASH_SECT = {1,1,0,0,255};
+#endif
+static const unsigned char jswSymbolIndex_httpSRs = 61;
+static const JswSymPtr jswSymbols_httpCRq[] FLASH_SECT = {
+  
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_httpCRq[] FLASH_SECT = {1,1,0,0,255};
+#endif
+static const unsigned char jswSymbolIndex_httpCRq = 62;
+static const JswSymPtr jswSymbols_httpCRs[] FLASH_SECT = {
+  
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_httpCRs[] FLASH_SECT = {1,1,0,0,255};
+#endif
+static const unsigned char jswSymbolIndex_httpCRs = 63;
+static const JswSymPtr jswSymbols_httpCRs_proto[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_INT32 | JSWAT_THIS_ARG, (void*)jswrap_stream_available),
+  JSWSYMPTR_ENTRY(10, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)jswrap_pipe),
+  JSWSYMPTR_ENTRY(15, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)), (void*)jswrap_stream_read)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_httpCRs_proto[] FLASH_SECT = {1,3,0,8,1,0,2};
+#endif
+static const unsigned char jswSymbolIndex_httpCRs_proto = 64;
+static const JswSymPtr jswSymbols_http[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_http_createServer),
+  JSWSYMPTR_ENTRY(13, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)jswrap_http_get),
+  JSWSYMPTR_ENTRY(17, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)gen_jswrap_http_request)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_http[] FLASH_SECT = {1,3,0,15,2,0,1};
+#endif
+static const unsigned char jswSymbolIndex_http = 65;
+static const JswSymPtr jswSymbols_httpSrv_proto[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_VOID | JSWAT_THIS_ARG, (void*)jswrap_net_server_close),
+  JSWSYMPTR_ENTRY(6, JSWAT_JSVAR | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)), (void*)gen_jswrap_httpSrv_listen)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_httpSrv_proto[] FLASH_SECT = {1,2,0,1,1,0};
+#endif
+static const unsigned char jswSymbolIndex_httpSrv_proto = 66;
+static const JswSymPtr jswSymbols_httpSRs_proto[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_httpSRs_end),
+  JSWSYMPTR_ENTRY(4, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)jswrap_httpSRs_setHeader),
+  JSWSYMPTR_ENTRY(14, JSWAT_BOOL | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_httpSRs_write),
+  JSWSYMPTR_ENTRY(20, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)jswrap_httpSRs_writeHead)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_httpSRs_proto[] FLASH_SECT = {1,5,0,3,1,0,3,2,255};
+#endif
+static const unsigned char jswSymbolIndex_httpSRs_proto = 67;
+static const JswSymPtr jswSymbols_httpCRq_proto[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_VOID | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_net_socket_end),
+  JSWSYMPTR_ENTRY(4, JSWAT_BOOL | JSWAT_THIS_ARG | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_net_socket_write)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_httpCRq_proto[] FLASH_SECT = {1,2,0,0,1,0};
+#endif
+static const unsigned char jswSymbolIndex_httpCRq_proto = 68;
+static const JswSymPtr jswSymbols_NetworkJS[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_networkjs_create)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_NetworkJS[] FLASH_SECT = {1,1,0,0,0};
+#endif
+static const unsigned char jswSymbolIndex_NetworkJS = 69;
+static const JswSymPtr jswSymbols_TelnetServer[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_VOID | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)jswrap_telnet_setOptions)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_TelnetServer[] FLASH_SECT = {1,1,0,0,0};
+#endif
+static const unsigned char jswSymbolIndex_TelnetServer = 70;
+static const JswSymPtr jswSymbols_crypto[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_JSVAR | JSWAT_EXECUTE_IMMEDIATELY, (void*)gen_jswrap_crypto_AES),
+  JSWSYMPTR_ENTRY(4, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)) | (JSWAT_JSVAR << (JSWAT_BITS*3)), (void*)jswrap_crypto_PBKDF2),
+  JSWSYMPTR_ENTRY(11, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)gen_jswrap_crypto_SHA1),
+  JSWSYMPTR_ENTRY(16, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)gen_jswrap_crypto_SHA224),
+  JSWSYMPTR_ENTRY(23, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)gen_jswrap_crypto_SHA256),
+  JSWSYMPTR_ENTRY(30, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)gen_jswrap_crypto_SHA384),
+  JSWSYMPTR_ENTRY(37, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)), (void*)gen_jswrap_crypto_SHA512)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_crypto[] FLASH_SECT = {2,8,0,11,1,6,255,0,4,5,1,3,2};
+#endif
+static const unsigned char jswSymbolIndex_crypto = 71;
+static const JswSymPtr jswSymbols_AES[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)) | (JSWAT_JSVAR << (JSWAT_BITS*3)) | (JSWAT_JSVAR << (JSWAT_BITS*4)), (void*)jswrap_crypto_AES_ccmDecrypt),
+  JSWSYMPTR_ENTRY(11, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)) | (JSWAT_JSVAR << (JSWAT_BITS*3)) | (JSWAT_JSVAR << (JSWAT_BITS*4)), (void*)jswrap_crypto_AES_ccmEncrypt),
+  JSWSYMPTR_ENTRY(22, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)) | (JSWAT_JSVAR << (JSWAT_BITS*3)), (void*)jswrap_crypto_AES_decrypt),
+  JSWSYMPTR_ENTRY(30, JSWAT_JSVAR | (JSWAT_JSVAR << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)) | (JSWAT_JSVAR << (JSWAT_BITS*3)), (void*)jswrap_crypto_AES_encrypt)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_AES[] FLASH_SECT = {1,5,0,13,2,3,1,255,0};
+#endif
+static const unsigned char jswSymbolIndex_AES = 72;
+static const JswSymPtr jswSymbols_tensorflow[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_JSVAR | (JSWAT_INT32 << (JSWAT_BITS*1)) | (JSWAT_JSVAR << (JSWAT_BITS*2)), (void*)jswrap_tensorflow_create)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_tensorflow[] FLASH_SECT = {1,1,0,0,0};
+#endif
+static const unsigned char jswSymbolIndex_tensorflow = 73;
+static const JswSymPtr jswSymbols_TFMicroInterpreter_proto[] FLASH_SECT = {
+  JSWSYMPTR_ENTRY(0, JSWAT_JSVAR | JSWAT_THIS_ARG, (void*)jswrap_tfmicrointerpreter_getInput),
+  JSWSYMPTR_ENTRY(9, JSWAT_JSVAR | JSWAT_THIS_ARG, (void*)jswrap_tfmicrointerpreter_getOutput),
+  JSWSYMPTR_ENTRY(19, JSWAT_VOID | JSWAT_THIS_ARG, (void*)jswrap_tfmicrointerpreter_invoke)
+};
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned char jswSymbolHash_TFMicroInterpreter_proto[] FLASH_SECT = {1,3,0,5,0,1,2};
+#endif
+static const unsigned char jswSymbolIndex_TFMicroInterpreter_proto = 74;
+
+
+FLASH_STR(jswSymbols_Pin_str, "");
+FLASH_STR(jswSymbols_Pin_proto_str, "analog\0getInfo\0getMode\0mode\0pulse\0pwm\0read\0reset\0set\0toggle\0write\0");
+FLASH_STR(jswSymbols_global_str, "AES\0Array\0ArrayBuffer\0ArrayBufferView\0Boolean\0DataView\0Date\0E\0Error\0File\0Float32Array\0Float64Array\0Function\0Generator\0Graphics\0HIGH\0I2C\0I2C1\0I2C2\0I2C3\0Infinity\0Int16Array\0Int32Array\0Int8Array\0InternalError\0JSON\0JSONParser\0LOW\0LoopbackA\0LoopbackB\0Math\0Modules\0NaN\0Number\0Object\0OneWire\0Pin\0Promise\0ReferenceError\0RegExp\0SPI\0SPI1\0SPI2\0SPI3\0Serial\0Serial1\0Serial2\0Serial3\0Serial4\0Serial5\0Serial6\0Server\0Socket\0StorageFile\0String\0SyntaxError\0TFMicroInterpreter\0Telnet\0TypeError\0USB\0Uint16Array\0Uint24Array\0Uint32Array\0Uint8Array\0Uint8ClampedArray\0Waveform\0analogRead\0analogWrite\0arguments\0atob\0btoa\0changeInterval\0clearInterval\0clearTimeout\0clearWatch\0console\0decodeURIComponent\0dgramSocket\0digitalPulse\0digitalRead\0digitalWrite\0dump\0echo\0edit\0encodeURIComponent\0eval\0getPinMode\0getSerial\0getTime\0global\0globalThis\0httpCRq\0httpCRs\0httpSRq\0httpSRs\0httpSrv\0isFinite\0isNaN\0load\0parseFloat\0parseInt\0peek16\0peek32\0peek8\0pinMode\0poke16\0poke32\0poke8\0print\0process\0require\0reset\0save\0setBusyIndicator\0setInterval\0setSleepIndicator\0setTime\0setTimeout\0setWatch\0shiftOut\0trace\0url\0");
+FLASH_STR(jswSymbols_Array_proto_str, "concat\0every\0fill\0filter\0find\0findIndex\0forEach\0includes\0indexOf\0join\0length\0map\0pop\0push\0reduce\0reverse\0shift\0slice\0some\0sort\0splice\0toString\0unshift\0");
+FLASH_STR(jswSymbols_Array_str, "isArray\0");
+FLASH_STR(jswSymbols_ArrayBuffer_proto_str, "byteLength\0");
+FLASH_STR(jswSymbols_ArrayBufferView_proto_str, "buffer\0byteLength\0byteOffset\0every\0fill\0filter\0find\0findIndex\0forEach\0includes\0indexOf\0join\0map\0reduce\0reverse\0set\0slice\0some\0sort\0subarray\0");
+FLASH_STR(jswSymbols_DataView_proto_str, "getFloat32\0getFloat64\0getInt16\0getInt32\0getInt8\0getUint16\0getUint32\0getUint8\0setFloat32\0setFloat64\0setInt16\0setInt32\0setInt8\0setUint16\0setUint32\0setUint8\0");
+FLASH_STR(jswSymbols_Date_str, "now\0parse\0");
+FLASH_STR(jswSymbols_Date_proto_str, "getDate\0getDay\0getFullYear\0getHours\0getIsDST\0getMilliseconds\0getMinutes\0getMonth\0getSeconds\0getTime\0getTimezoneOffset\0getUTCDate\0getUTCDay\0getUTCFullYear\0getUTCHours\0getUTCMilliseconds\0getUTCMinutes\0getUTCMonth\0getUTCSeconds\0setDate\0setFullYear\0setHours\0setMilliseconds\0setMinutes\0setMonth\0setSeconds\0setTime\0toISOString\0toJSON\0toLocalISOString\0toString\0toUTCString\0valueOf\0");
+FLASH_STR(jswSymbols_Error_proto_str, "toString\0");
+FLASH_STR(jswSymbols_SyntaxError_proto_str, "toString\0");
+FLASH_STR(jswSymbols_TypeError_proto_str, "toString\0");
+FLASH_STR(jswSymbols_InternalError_proto_str, "toString\0");
+FLASH_STR(jswSymbols_ReferenceError_proto_str, "toString\0");
+FLASH_STR(jswSymbols_console_str, "debug\0error\0info\0log\0trace\0warn\0");
+FLASH_STR(jswSymbols_Generator_proto_str, "next\0return\0throw\0");
+FLASH_STR(jswSymbols_JSON_str, "parse\0parser\0stringify\0write\0");
+FLASH_STR(jswSymbols_JSONParser_proto_str, "end\0write\0");
+FLASH_STR(jswSymbols_Number_str, "MAX_VALUE\0MIN_VALUE\0NEGATIVE_INFINITY\0NaN\0POSITIVE_INFINITY\0");
+FLASH_STR(jswSymbols_Number_proto_str, "toFixed\0");
+FLASH_STR(jswSymbols_Object_proto_str, "addListener\0clone\0emit\0hasOwnProperty\0length\0on\0prependListener\0removeAllListeners\0removeListener\0toString\0valueOf\0");
+FLASH_STR(jswSymbols_Object_str, "assign\0create\0defineProperties\0defineProperty\0entries\0fromEntries\0getOwnPropertyDescriptor\0getOwnPropertyDescriptors\0getOwnPropertyNames\0getPrototypeOf\0keys\0setPrototypeOf\0values\0");
+FLASH_STR(jswSymbols_Function_proto_str, "apply\0bind\0call\0replaceWith\0");
+FLASH_STR(jswSymbols_RegExp_proto_str, "exec\0test\0");
+FLASH_STR(jswSymbols_timer_str, "add\0get\0list\0remove\0");
+FLASH_STR(jswSymbols_String_proto_str, "charAt\0charCodeAt\0concat\0endsWith\0includes\0indexOf\0lastIndexOf\0length\0match\0padEnd\0padStart\0removeAccents\0repeat\0replace\0replaceAll\0slice\0split\0startsWith\0substr\0substring\0toLowerCase\0toUpperCase\0trim\0");
+FLASH_STR(jswSymbols_String_str, "fromCharCode\0");
+FLASH_STR(jswSymbols_Modules_str, "addCached\0getCached\0removeAllCached\0removeCached\0");
+FLASH_STR(jswSymbols_Math_str, "E\0LN10\0LN2\0LOG10E\0LOG2E\0PI\0SQRT1_2\0SQRT2\0abs\0acos\0asin\0atan\0atan2\0ceil\0clip\0cos\0exp\0floor\0log\0max\0min\0pow\0randInt\0random\0round\0sign\0sin\0sqrt\0tan\0wrap\0");
+FLASH_STR(jswSymbols_E_str, "CRC32\0FFT\0HSBtoRGB\0asUTF8\0asm\0clip\0compiledC\0connectSDCard\0convolve\0decodeUTF8\0defrag\0dumpFragmentation\0dumpFreeList\0dumpLockedVars\0dumpStr\0dumpVariables\0enableWatchdog\0fromUTF8\0getAddressOf\0getAnalogVRef\0getClock\0getConsole\0getErrorFlags\0getFlags\0getPowerUsage\0getSizeOf\0getTemperature\0hwRand\0internal\0isUTF8\0kickWatchdog\0lockConsole\0lookupNoCase\0mapInPlace\0memoryArea\0memoryMap\0nativeCall\0openFile\0pipe\0reboot\0reverseByte\0setBootCode\0setClock\0setConsole\0setDST\0setFlags\0setPassword\0setTimeZone\0srand\0stopEventPropagation\0sum\0toArrayBuffer\0toFlatString\0toJS\0toString\0toUint8Array\0unmountSD\0variance\0");
+FLASH_STR(jswSymbols_Flash_str, "erasePage\0getFree\0getPage\0read\0write\0");
+FLASH_STR(jswSymbols_fs_str, "appendFile\0appendFileSync\0mkdir\0mkdirSync\0pipe\0readFile\0readFileSync\0readdir\0readdirSync\0statSync\0unlink\0unlinkSync\0writeFile\0writeFileSync\0");
+FLASH_STR(jswSymbols_process_str, "env\0memory\0version\0");
+FLASH_STR(jswSymbols_OneWire_proto_str, "read\0reset\0search\0select\0skip\0write\0");
+FLASH_STR(jswSymbols_Promise_str, "all\0reject\0resolve\0");
+FLASH_STR(jswSymbols_Promise_proto_str, "catch\0then\0");
+FLASH_STR(jswSymbols_Serial_str, "find\0");
+FLASH_STR(jswSymbols_Serial_proto_str, "available\0flush\0inject\0isConnected\0pipe\0print\0println\0read\0setConsole\0setup\0unsetup\0write\0");
+FLASH_STR(jswSymbols_Storage_str, "compact\0erase\0eraseAll\0getFree\0getStats\0hash\0list\0open\0optimise\0read\0readArrayBuffer\0readJSON\0write\0writeJSON\0");
+FLASH_STR(jswSymbols_StorageFile_proto_str, "erase\0flush\0getLength\0pipe\0read\0readLine\0seek\0seekLine\0write\0");
+FLASH_STR(jswSymbols_SPI_str, "find\0");
+FLASH_STR(jswSymbols_SPI_proto_str, "send\0send4bit\0send8bit\0setup\0write\0");
+FLASH_STR(jswSymbols_I2C_str, "find\0");
+FLASH_STR(jswSymbols_I2C_proto_str, "readFrom\0readReg\0setup\0writeTo\0");
+FLASH_STR(jswSymbols_Waveform_proto_str, "startInput\0startOutput\0stop\0");
+FLASH_STR(jswSymbols_heatshrink_str, "compress\0decompress\0");
+FLASH_STR(jswSymbols_File_proto_str, "close\0pipe\0read\0seek\0skip\0write\0");
+FLASH_STR(jswSymbols_Graphics_proto_str, "asBMP\0asImage\0asURL\0blendColor\0blit\0clear\0clearRect\0drawCircle\0drawCircleAA\0drawEllipse\0drawImage\0drawImages\0drawLine\0drawLineAA\0drawPoly\0drawPolyAA\0drawRect\0drawString\0dump\0fillCircle\0fillEllipse\0fillPoly\0fillPolyAA\0fillRect\0filter\0floodFill\0getBPP\0getBgColor\0getColor\0getFont\0getFontHeight\0getFonts\0getHeight\0getModified\0getPixel\0getVectorFontPolys\0getWidth\0imageMetrics\0lineTo\0moveTo\0quadraticBezier\0reset\0scroll\0setBgColor\0setClipRect\0setColor\0setFont\0setFontAlign\0setFontBitmap\0setFontCustom\0setFontPBF\0setFontVector\0setOffset\0setPixel\0setRotation\0setTheme\0stringMetrics\0stringWidth\0theme\0toColor\0transformVertices\0wrapString\0");
+FLASH_STR(jswSymbols_Graphics_str, "createArrayBuffer\0createCallback\0createImage\0getInstance\0");
+FLASH_STR(jswSymbols_url_str, "parse\0");
+FLASH_STR(jswSymbols_Socket_str, "");
+FLASH_STR(jswSymbols_Socket_proto_str, "available\0end\0pipe\0read\0write\0");
+FLASH_STR(jswSymbols_net_str, "connect\0createServer\0");
+FLASH_STR(jswSymbols_dgram_str, "createSocket\0");
+FLASH_STR(jswSymbols_dgramSocket_proto_str, "addMembership\0bind\0close\0send\0");
+FLASH_STR(jswSymbols_dgramSocket_str, "");
+FLASH_STR(jswSymbols_tls_str, "connect\0");
+FLASH_STR(jswSymbols_Server_proto_str, "close\0listen\0");
+FLASH_STR(jswSymbols_httpSRq_str, "");
+FLASH_STR(jswSymbols_httpSRq_proto_str, "available\0pipe\0read\0");
+FLASH_STR(jswSymbols_httpSRs_str, "");
+FLASH_STR(jswSymbols_httpCRq_str, "");
+FLASH_STR(jswSymbols_httpCRs_str, "");
+FLASH_STR(jswSymbols_httpCRs_proto_str, "available\0pipe\0read\0");
+FLASH_STR(jswSymbols_http_str, "createServer\0get\0request\0");
+FLASH_STR(jswSymbols_httpSrv_proto_str, "close\0listen\0");
+FLASH_STR(jswSymbols_httpSRs_proto_str, "end\0setHeader\0write\0writeHead\0");
+FLASH_STR(jswSymbols_httpCRq_proto_str, "end\0write\0");
+FLASH_STR(jswSymbols_NetworkJS_str, "create\0");
+FLASH_STR(jswSymbols_TelnetServer_str, "setOptions\0");
+FLASH_STR(jswSymbols_crypto_str, "AES\0PBKDF2\0SHA1\0SHA224\0SHA256\0SHA384\0SHA512\0");
+FLASH_STR(jswSymbols_AES_str, "ccmDecrypt\0ccmEncrypt\0decrypt\0encrypt\0");
+FLASH_STR(jswSymbols_tensorflow_str, "create\0");
+FLASH_STR(jswSymbols_TFMicroInterpreter_proto_str, "getInput\0getOutput\0invoke\0");
+
+const JswSymList jswSymbolTables[] FLASH_SECT = {
+  {jswSymbols_Pin, jswSymbols_Pin_str, JSWSYMLIST_HASH(jswSymbolHash_Pin) 0},
+  {jswSymbols_Pin_proto, jswSymbols_Pin_proto_str, JSWSYMLIST_HASH(jswSymbolHash_Pin_proto) 11},
+  {jswSymbols_global, jswSymbols_global_str, JSWSYMLIST_HASH(jswSymbolHash_global) 122},
+  {jswSymbols_Array_proto, jswSymbols_Array_proto_str, JSWSYMLIST_HASH(jswSymbolHash_Array_proto) 23},
+  {jswSymbols_Array, jswSymbols_Array_str, JSWSYMLIST_HASH(jswSymbolHash_Array) 1},
+  {jswSymbols_ArrayBuffer_proto, jswSymbols_ArrayBuffer_proto_str, JSWSYMLIST_HASH(jswSymbolHash_ArrayBuffer_proto) 1},
+  {jswSymbols_ArrayBufferView_proto, jswSymbols_ArrayBufferView_proto_str, JSWSYMLIST_HASH(jswSymbolHash_ArrayBufferView_proto) 20},
+  {jswSymbols_DataView_proto, jswSymbols_DataView_proto_str, JSWSYMLIST_HASH(jswSymbolHash_DataView_proto) 16},
+  {jswSymbols_Date, jswSymbols_Date_str, JSWSYMLIST_HASH(jswSymbolHash_Date) 2},
+  {jswSymbols_Date_proto, jswSymbols_Date_proto_str, JSWSYMLIST_HASH(jswSymbolHash_Date_proto) 33},
+  {jswSymbols_Error_proto, jswSymbols_Error_proto_str, JSWSYMLIST_HASH(jswSymbolHash_Error_proto) 1},
+  {jswSymbols_SyntaxError_proto, jswSymbols_SyntaxError_proto_str, JSWSYMLIST_HASH(jswSymbolHash_SyntaxError_proto) 1},
+  {jswSymbols_TypeError_proto, jswSymbols_TypeError_proto_str, JSWSYMLIST_HASH(jswSymbolHash_TypeError_proto) 1},
+  {jswSymbols_InternalError_proto, jswSymbols_InternalError_proto_str, JSWSYMLIST_HASH(jswSymbolHash_InternalError_proto) 1},
+  {jswSymbols_ReferenceError_proto, jswSymbols_ReferenceError_proto_str, JSWSYMLIST_HASH(jswSymbolHash_ReferenceError_proto) 1},
+  {jswSymbols_console, jswSymbols_console_str, JSWSYMLIST_HASH(jswSymbolHash_console) 6},
+  {jswSymbols_Generator_proto, jswSymbols_Generator_proto_str, JSWSYMLIST_HASH(jswSymbolHash_Generator_proto) 3},
+  {jswSymbols_JSON, jswSymbols_JSON_str, JSWSYMLIST_HASH(jswSymbolHash_JSON) 4},
+  {jswSymbols_JSONParser_proto, jswSymbols_JSONParser_proto_str, JSWSYMLIST_HASH(jswSymbolHash_JSONParser_proto) 2},
+  {jswSymbols_Number, jswSymbols_Number_str, JSWSYMLIST_HASH(jswSymbolHash_Number) 5},
+  {jswSymbols_Number_proto, jswSymbols_Number_proto_str, JSWSYMLIST_HASH(jswSymbolHash_Number_proto) 1},
+  {jswSymbols_Object_proto, jswSymbols_Object_proto_str, JSWSYMLIST_HASH(jswSymbolHash_Object_proto) 11},
+  {jswSymbols_Object, jswSymbols_Object_str, JSWSYMLIST_HASH(jswSymbolHash_Object) 13},
+  {jswSymbols_Function_proto, jswSymbols_Function_proto_str, JSWSYMLIST_HASH(jswSymbolHash_Function_proto) 4},
+  {jswSymbols_RegExp_proto, jswSymbols_RegExp_proto_str, JSWSYMLIST_HASH(jswSymbolHash_RegExp_proto) 2},
+  {jswSymbols_timer, jswSymbols_timer_str, JSWSYMLIST_HASH(jswSymbolHash_timer) 4},
+  {jswSymbols_String_proto, jswSymbols_String_proto_str, JSWSYMLIST_HASH(jswSymbolHash_String_proto) 23},
+  {jswSymbols_String, jswSymbols_String_str, JSWSYMLIST_HASH(jswSymbolHash_String) 1},
+  {jswSymbols_Modules, jswSymbols_Modules_str, JSWSYMLIST_HASH(jswSymbolHash_Modules) 4},
+  {jswSymbols_Math, jswSymbols_Math_str, JSWSYMLIST_HASH(jswSymbolHash_Math) 30},
+  {jswSymbols_E, jswSymbols_E_str, JSWSYMLIST_HASH(jswSymbolHash_E) 58},
+  {jswSymbols_Flash, jswSymbols_Flash_str, JSWSYMLIST_HASH(jswSymbolHash_Flash) 5},
+  {jswSymbols_fs, jswSymbols_fs_str, JSWSYMLIST_HASH(jswSymbolHash_fs) 14},
+  {jswSymbols_process, jswSymbols_process_str, JSWSYMLIST_HASH(jswSymbolHash_process) 3},
+  {jswSymbols_OneWire_proto, jswSymbols_OneWire_proto_str, JSWSYMLIST_HASH(jswSymbolHash_OneWire_proto) 6},
+  {jswSymbols_Promise, jswSymbols_Promise_str, JSWSYMLIST_HASH(jswSymbolHash_Promise) 3},
+  {jswSymbols_Promise_proto, jswSymbols_Promise_proto_str, JSWSYMLIST_HASH(jswSymbolHash_Promise_proto) 2},
+  {jswSymbols_Serial, jswSymbols_Serial_str, JSWSYMLIST_HASH(jswSymbolHash_Serial) 1},
+  {jswSymbols_Serial_proto, jswSymbols_Serial_proto_str, JSWSYMLIST_HASH(jswSymbolHash_Serial_proto) 12},
+  {jswSymbols_Storage, jswSymbols_Storage_str, JSWSYMLIST_HASH(jswSymbolHash_Storage) 14},
+  {jswSymbols_StorageFile_proto, jswSymbols_StorageFile_proto_str, JSWSYMLIST_HASH(jswSymbolHash_StorageFile_proto) 9},
+  {jswSymbols_SPI, jswSymbols_SPI_str, JSWSYMLIST_HASH(jswSymbolHash_SPI) 1},
+  {jswSymbols_SPI_proto, jswSymbols_SPI_proto_str, JSWSYMLIST_HASH(jswSymbolHash_SPI_proto) 5},
+  {jswSymbols_I2C, jswSymbols_I2C_str, JSWSYMLIST_HASH(jswSymbolHash_I2C) 1},
+  {jswSymbols_I2C_proto, jswSymbols_I2C_proto_str, JSWSYMLIST_HASH(jswSymbolHash_I2C_proto) 4},
+  {jswSymbols_Waveform_proto, jswSymbols_Waveform_proto_str, JSWSYMLIST_HASH(jswSymbolHash_Waveform_proto) 3},
+  {jswSymbols_heatshrink, jswSymbols_heatshrink_str, JSWSYMLIST_HASH(jswSymbolHash_heatshrink) 2},
+  {jswSymbols_File_proto, jswSymbols_File_proto_str, JSWSYMLIST_HASH(jswSymbolHash_File_proto) 6},
+  {jswSymbols_Graphics_proto, jswSymbols_Graphics_proto_str, JSWSYMLIST_HASH(jswSymbolHash_Graphics_proto) 62},
+  {jswSymbols_Graphics, jswSymbols_Graphics_str, JSWSYMLIST_HASH(jswSymbolHash_Graphics) 4},
+  {jswSymbols_url, jswSymbols_url_str, JSWSYMLIST_HASH(jswSymbolHash_url) 1},
+  {jswSymbols_Socket, jswSymbols_Socket_str, JSWSYMLIST_HASH(jswSymbolHash_Socket) 0},
+  {jswSymbols_Socket_proto, jswSymbols_Socket_proto_str, JSWSYMLIST_HASH(jswSymbolHash_Socket_proto) 5},
+  {jswSymbols_net, jswSymbols_net_str, JSWSYMLIST_HASH(jswSymbolHash_net) 2},
+  {jswSymbols_dgram, jswSymbols_dgram_str, JSWSYMLIST_HASH(jswSymbolHash_dgram) 1},
+  {jswSymbols_dgramSocket_proto, jswSymbols_dgramSocket_proto_str, JSWSYMLIST_HASH(jswSymbolHash_dgramSocket_proto) 4},
+  {jswSymbols_dgramSocket, jswSymbols_dgramSocket_str, JSWSYMLIST_HASH(jswSymbolHash_dgramSocket) 0},
+  {jswSymbols_tls, jswSymbols_tls_str, JSWSYMLIST_HASH(jswSymbolHash_tls) 1},
+  {jswSymbols_Server_proto, jswSymbols_Server_proto_str, JSWSYMLIST_HASH(jswSymbolHash_Server_proto) 2},
+  {jswSymbols_httpSRq, jswSymbols_httpSRq_str, JSWSYMLIST_HASH(jswSymbolHash_httpSRq) 0},
+  {jswSymbols_httpSRq_proto, jswSymbols_httpSRq_proto_str, JSWSYMLIST_HASH(jswSymbolHash_httpSRq_proto) 3},
+  {jswSymbols_httpSRs, jswSymbols_httpSRs_str, JSWSYMLIST_HASH(jswSymbolHash_httpSRs) 0},
+  {jswSymbols_httpCRq, jswSymbols_httpCRq_str, JSWSYMLIST_HASH(jswSymbolHash_httpCRq) 0},
+  {jswSymbols_httpCRs, jswSymbols_httpCRs_str, JSWSYMLIST_HASH(jswSymbolHash_httpCRs) 0},
+  {jswSymbols_httpCRs_proto, jswSymbols_httpCRs_proto_str, JSWSYMLIST_HASH(jswSymbolHash_httpCRs_proto) 3},
+  {jswSymbols_http, jswSymbols_http_str, JSWSYMLIST_HASH(jswSymbolHash_http) 3},
+  {jswSymbols_httpSrv_proto, jswSymbols_httpSrv_proto_str, JSWSYMLIST_HASH(jswSymbolHash_httpSrv_proto) 2},
+  {jswSymbols_httpSRs_proto, jswSymbols_httpSRs_proto_str, JSWSYMLIST_HASH(jswSymbolHash_httpSRs_proto) 4},
+  {jswSymbols_httpCRq_proto, jswSymbols_httpCRq_proto_str, JSWSYMLIST_HASH(jswSymbolHash_httpCRq_proto) 2},
+  {jswSymbols_NetworkJS, jswSymbols_NetworkJS_str, JSWSYMLIST_HASH(jswSymbolHash_NetworkJS) 1},
+  {jswSymbols_TelnetServer, jswSymbols_TelnetServer_str, JSWSYMLIST_HASH(jswSymbolHash_TelnetServer) 1},
+  {jswSymbols_crypto, jswSymbols_crypto_str, JSWSYMLIST_HASH(jswSymbolHash_crypto) 7},
+  {jswSymbols_AES, jswSymbols_AES_str, JSWSYMLIST_HASH(jswSymbolHash_AES) 4},
+  {jswSymbols_tensorflow, jswSymbols_tensorflow_str, JSWSYMLIST_HASH(jswSymbolHash_tensorflow) 1},
+  {jswSymbols_TFMicroInterpreter_proto, jswSymbols_TFMicroInterpreter_proto_str, JSWSYMLIST_HASH(jswSymbolHash_TFMicroInterpreter_proto) 3},
+};
+
+
+const JswSymList *jswGetSymbolListForConstructorProto(JsVar *constructor) {
+  void *constructorPtr = constructor->varData.native.ptr;
+  if (constructorPtr==(void*)jswrap_dataview_constructor) return &jswSymbolTables[jswSymbolIndex_DataView_proto];
+  if (constructorPtr==(void*)jswrap_date_constructor) return &jswSymbolTables[jswSymbolIndex_Date_proto];
+  if (constructorPtr==(void*)jswrap_error_constructor) return &jswSymbolTables[jswSymbolIndex_Error_proto];
+  if (constructorPtr==(void*)jswrap_syntaxerror_constructor) return &jswSymbolTables[jswSymbolIndex_SyntaxError_proto];
+  if (constructorPtr==(void*)jswrap_typeerror_constructor) return &jswSymbolTables[jswSymbolIndex_TypeError_proto];
+  if (constructorPtr==(void*)jswrap_internalerror_constructor) return &jswSymbolTables[jswSymbolIndex_InternalError_proto];
+  if (constructorPtr==(void*)jswrap_referenceerror_constructor) return &jswSymbolTables[jswSymbolIndex_ReferenceError_proto];
+  if (constructorPtr==(void*)gen_jswrap_Generator_Generator) return &jswSymbolTables[jswSymbolIndex_Generator_proto];
+  if (constructorPtr==(void*)gen_jswrap_JSONParser_JSONParser) return &jswSymbolTables[jswSymbolIndex_JSONParser_proto];
+  if (constructorPtr==(void*)jswrap_regexp_constructor) return &jswSymbolTables[jswSymbolIndex_RegExp_proto];
+  if (constructorPtr==(void*)jswrap_onewire_constructor) return &jswSymbolTables[jswSymbolIndex_OneWire_proto];
+  if (constructorPtr==(void*)jswrap_promise_constructor) return &jswSymbolTables[jswSymbolIndex_Promise_proto];
+  if (constructorPtr==(void*)jswrap_serial_constructor) return &jswSymbolTables[jswSymbolIndex_Serial_proto];
+  if (constructorPtr==(void*)gen_jswrap_StorageFile_StorageFile) return &jswSymbolTables[jswSymbolIndex_StorageFile_proto];
+  if (constructorPtr==(void*)jswrap_spi_constructor) return &jswSymbolTables[jswSymbolIndex_SPI_proto];
+  if (constructorPtr==(void*)jswrap_i2c_constructor) return &jswSymbolTables[jswSymbolIndex_I2C_proto];
+  if (constructorPtr==(void*)jswrap_waveform_constructor) return &jswSymbolTables[jswSymbolIndex_Waveform_proto];
+  if (constructorPtr==(void*)gen_jswrap_File_File) return &jswSymbolTables[jswSymbolIndex_File_proto];
+  if (constructorPtr==(void*)gen_jswrap_Graphics_Graphics) return &jswSymbolTables[jswSymbolIndex_Graphics_proto];
+  if (constructorPtr==(void*)gen_jswrap_Socket_Socket) return &jswSymbolTables[jswSymbolIndex_Socket_proto];
+  if (constructorPtr==(void*)gen_jswrap_dgramSocket_dgramSocket) return &jswSymbolTables[jswSymbolIndex_dgramSocket_proto];
+  if (constructorPtr==(void*)gen_jswrap_Server_Server) return &jswSymbolTables[jswSymbolIndex_Server_proto];
+  if (constructorPtr==(void*)gen_jswrap_httpSRq_httpSRq) return &jswSymbolTables[jswSymbolIndex_httpSRq_proto];
+  if (constructorPtr==(void*)gen_jswrap_httpCRs_httpCRs) return &jswSymbolTables[jswSymbolIndex_httpCRs_proto];
+  if (constructorPtr==(void*)gen_jswrap_httpSrv_httpSrv) return &jswSymbolTables[jswSymbolIndex_httpSrv_proto];
+  if (constructorPtr==(void*)gen_jswrap_httpSRs_httpSRs) return &jswSymbolTables[jswSymbolIndex_httpSRs_proto];
+  if (constructorPtr==(void*)gen_jswrap_httpCRq_httpCRq) return &jswSymbolTables[jswSymbolIndex_httpCRq_proto];
+  if (constructorPtr==(void*)gen_jswrap_TFMicroInterpreter_TFMicroInterpreter) return &jswSymbolTables[jswSymbolIndex_TFMicroInterpreter_proto];
+  return 0;
+}
+
+
+JsVar *jswFindBuiltInFunction(JsVar *parent, const char *name) {
+  JsVar *v;
+  if (parent && !jsvIsRoot(parent)) {
+    // ------------------------------------------ INSTANCE + STATIC METHODS
+    if (jsvIsNativeFunction(parent)) {
+      const JswSymList *l = jswGetSymbolListForObject(parent);
+      if (l) {
+        v = jswBinarySearch(l, parent, name);
+        if (v) return v;
+      }
+    }
+    if (jsvIsPin(parent)) {
+      v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_Pin_proto], parent, name);
+      if (v) return v;
+    }
+    if (jsvIsArray(parent)) {
+      v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_Array_proto], parent, name);
+      if (v) return v;
+    }
+    if (jsvIsArrayBuffer(parent) && parent->varData.arraybuffer.type==ARRAYBUFFERVIEW_ARRAYBUFFER) {
+      v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_ArrayBuffer_proto], parent, name);
+      if (v) return v;
+    }
+    if (jsvIsArrayBuffer(parent) && parent->varData.arraybuffer.type!=ARRAYBUFFERVIEW_ARRAYBUFFER) {
+      v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_ArrayBufferView_proto], parent, name);
+      if (v) return v;
+    }
+    if (jsvIsNumeric(parent)) {
+      v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_Number_proto], parent, name);
+      if (v) return v;
+    }
+    if (jsvIsFunction(parent)) {
+      v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_Function_proto], parent, name);
+      if (v) return v;
+    }
+    if (jsvIsString(parent)) {
+      v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_String_proto], parent, name);
+      if (v) return v;
+    }
+    // ------------------------------------------ INSTANCE METHODS WE MUST CHECK CONSTRUCTOR FOR
+    JsVar *proto = jsvIsObject(parent)?jsvSkipNameAndUnLock(jsvFindChildFromString(parent, JSPARSE_INHERITS_VAR)):0;
+    JsVar *constructor = jsvIsObject(proto)?jsvSkipNameAndUnLock(jsvFindChildFromString(proto, JSPARSE_CONSTRUCTOR_VAR)):0;
+    jsvUnLock(proto);
+    if (constructor && jsvIsNativeFunction(constructor)) {
+      const JswSymList *l = jswGetSymbolListForConstructorProto(constructor);
+      jsvUnLock(constructor);
+      if (l) {
+        v = jswBinarySearch(l, parent, name);
+        if (v) return v;
+      }
+    } else {
+      jsvUnLock(constructor);
+    }
+    // ------------------------------------------ METHODS ON OBJECT
+    v = jswBinarySearch(&jswSymbolTables[jswSymbolIndex_Object_proto], parent, name);
+    if (v) return v;
+  } else { /* if (!parent) */
+    // ------------------------------------------ FUNCTIONS
+    #ifndef ESPR_EMBED
+    // Handle pin names - eg D5 (this is hardcoded in build_jsfunctions.py). LED/etc are in jswSymbols_global
+    Pin pin = jshGetPinFromString(name);
+    if (pin != PIN_UNDEFINED) 
+      return jsvNewFromPin(pin);
+    #endif
+    return jswBinarySearch(&jswSymbolTables[jswSymbolIndex_global], parent, name);
+  }
+  return 0;
+}
+
+
+const JswSymList *jswGetSymbolListForObject(JsVar *parent) {
+  if (jsvIsNativeFunction(parent)) {
+    if ((void*)parent->varData.native.ptr==(void*)jswrap_pin_constructor) return &jswSymbolTables[jswSymbolIndex_Pin];
+    if ((void*)parent->varData.native.ptr==(void*)jswrap_array_constructor) return &jswSymbolTables[jswSymbolIndex_Array];
+    if ((void*)parent->varData.native.ptr==(void*)jswrap_date_constructor) return &jswSymbolTables[jswSymbolIndex_Date];
+    if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_console_console) return &jswSymbolTables[jswSymbolIndex_console];
+    if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_JSON_JSON) return &jswSymbolTables[jswSymbolIndex_JSON];
+    if ((void*)parent->varData.native.ptr==(void*)jswrap_number_constructor) return &jswSymbolTables[jswSymbolIndex_Number];
+    if ((void*)parent->varData.native.ptr==(void*)jswrap_object_constructor) return &jswSymbolTables[jswSymbolIndex_Object];
+    if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_timer_timer) return &jswSymbolTables[jswSymbolIndex_timer];
+    if ((void*)parent->varData.native.ptr==(void*)jswrap_string_constructor) return &jswSymbolTables[jswSymbolIndex_String];
+    if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_Modules_Modules) return &jswSymbolTables[jswSymbolIndex_Modules];
+    if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_Math_Math) return &jswSymbolTables[jswSymbolIndex_Math];
+    if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_E_E) return &jswSymbolTables[jswSymbolIndex_E];
+    if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_Flash_Flash) return &jswSymbolTables[jswSymbolIndex_Flash];
+    if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_fs_fs) return &jswSymbolTables[jswSymbolIndex_fs];
+    if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_process_process) return &jswSymbolTables[jswSymbolIndex_process];
+    if ((void*)parent->varData.native.ptr==(void*)jswrap_promise_constructor) return &jswSymbolTables[jswSymbolIndex_Promise];
+    if ((void*)parent->varData.native.ptr==(void*)jswrap_serial_constructor) return &jswSymbolTables[jswSymbolIndex_Serial];
+    if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_Storage_Storage) return &jswSymbolTables[jswSymbolIndex_Storage];
+    if ((void*)parent->varData.native.ptr==(void*)jswrap_spi_constructor) return &jswSymbolTables[jswSymbolIndex_SPI];
+    if ((void*)parent->varData.native.ptr==(void*)jswrap_i2c_constructor) return &jswSymbolTables[jswSymbolIndex_I2C];
+    if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_heatshrink_heatshrink) return &jswSymbolTables[jswSymbolIndex_heatshrink];
+    if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_Graphics_Graphics) return &jswSymbolTables[jswSymbolIndex_Graphics];
+    if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_url_url) return &jswSymbolTables[jswSymbolIndex_url];
+    if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_Socket_Socket) return &jswSymbolTables[jswSymbolIndex_Socket];
+    if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_net_net) return &jswSymbolTables[jswSymbolIndex_net];
+    if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_dgram_dgram) return &jswSymbolTables[jswSymbolIndex_dgram];
+    if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_dgramSocket_dgramSocket) return &jswSymbolTables[jswSymbolIndex_dgramSocket];
+    if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_tls_tls) return &jswSymbolTables[jswSymbolIndex_tls];
+    if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_httpSRq_httpSRq) return &jswSymbolTables[jswSymbolIndex_httpSRq];
+    if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_httpSRs_httpSRs) return &jswSymbolTables[jswSymbolIndex_httpSRs];
+    if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_httpCRq_httpCRq) return &jswSymbolTables[jswSymbolIndex_httpCRq];
+    if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_httpCRs_httpCRs) return &jswSymbolTables[jswSymbolIndex_httpCRs];
+    if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_http_http) return &jswSymbolTables[jswSymbolIndex_http];
+    if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_NetworkJS_NetworkJS) return &jswSymbolTables[jswSymbolIndex_NetworkJS];
+    if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_TelnetServer_TelnetServer) return &jswSymbolTables[jswSymbolIndex_TelnetServer];
+    if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_crypto_crypto) return &jswSymbolTables[jswSymbolIndex_crypto];
+    if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_AES_AES) return &jswSymbolTables[jswSymbolIndex_AES];
+    if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_tensorflow_tensorflow) return &jswSymbolTables[jswSymbolIndex_tensorflow];
+  }
+  if (parent==execInfo.root) return &jswSymbolTables[jswSymbolIndex_global];
+  return 0;
+}
+
+
+const JswSymList *jswGetSymbolListForObjectProto(JsVar *parent) {
+  if (jsvIsNativeFunction(parent)) {
+    if ((void*)parent->varData.native.ptr==(void*)jswrap_pin_constructor) return &jswSymbolTables[jswSymbolIndex_Pin_proto];
+    if ((void*)parent->varData.native.ptr==(void*)jswrap_array_constructor) return &jswSymbolTables[jswSymbolIndex_Array_proto];
+    if ((void*)parent->varData.native.ptr==(void*)jswrap_arraybuffer_constructor) return &jswSymbolTables[jswSymbolIndex_ArrayBuffer_proto];
+    if ((void*)parent->varData.native.ptr==(void*)gen_jswrap_ArrayBufferView_ArrayBufferView) return &jswSymbolTables[jswSymbolIndex_ArrayBufferView_proto];
+    if ((void*)parent->varData.native.ptr==(void*)jswrap_number_constructor) return &jswSymbolTables[jswSymbolIndex_Number_proto];
+    if ((void*)parent->varData.native.ptr==(void*)jswrap_function_constructor) return &jswSymbolTables[jswSymbolIndex_Function_proto];
+    if ((void*)parent->varData.native.ptr==(void*)jswrap_string_constructor) return &jswSymbolTables[jswSymbolIndex_String_proto];
+  }
+  JsVar *constructor = jsvIsObject(parent)?jsvSkipNameAndUnLock(jsvFindChildFromString(parent, JSPARSE_CONSTRUCTOR_VAR)):0;
+  if (constructor && jsvIsNativeFunction(constructor)) {
+    const JswSymList *l = jswGetSymbolListForConstructorProto(constructor);
+    jsvUnLock(constructor);
+    if (l) return l;
+  }
+  if (jsvIsPin(parent)) return &jswSymbolTables[jswSymbolIndex_Pin_proto];
+  if (jsvIsArray(parent)) return &jswSymbolTables[jswSymbolIndex_Array_proto];
+  if (jsvIsArrayBuffer(parent) && parent->varData.arraybuffer.type==ARRAYBUFFERVIEW_ARRAYBUFFER) return &jswSymbolTables[jswSymbolIndex_ArrayBuffer_proto];
+  if (jsvIsArrayBuffer(parent) && parent->varData.arraybuffer.type!=ARRAYBUFFERVIEW_ARRAYBUFFER) return &jswSymbolTables[jswSymbolIndex_ArrayBufferView_proto];
+  if (jsvIsNumeric(parent)) return &jswSymbolTables[jswSymbolIndex_Number_proto];
+  if (jsvIsFunction(parent)) return &jswSymbolTables[jswSymbolIndex_Function_proto];
+  if (jsvIsString(parent)) return &jswSymbolTables[jswSymbolIndex_String_proto];
+  return &jswSymbolTables[jswSymbolIndex_Object_proto];
+}
+
+
+static const char jswBuiltInObjectNames[] = "Pin\0Array\0ArrayBuffer\0ArrayBufferView\0Uint8Array\0Uint8ClampedArray\0Int8Array\0Uint16Array\0Int16Array\0Uint24Array\0Uint32Array\0Int32Array\0Float32Array\0Float64Array\0DataView\0Date\0Error\0SyntaxError\0TypeError\0InternalError\0ReferenceError\0Function\0console\0Generator\0JSON\0JSONParser\0Number\0Object\0Boolean\0RegExp\0String\0Modules\0Math\0E\0process\0OneWire\0Promise\0Serial\0StorageFile\0SPI\0I2C\0Waveform\0File\0Graphics\0url\0Server\0Socket\0dgramSocket\0httpSrv\0httpSRq\0httpSRs\0httpCRq\0httpCRs\0AES\0TFMicroInterpreter\0";
+#ifndef ESPR_NO_SYMBOL_HASH
+static const unsigned short jswBuiltInObjectOffsets[] FLASH_SECT = {0,4,10,22,38,49,67,77,89,100,112,124,135,148,161,170,175,181,193,203,217,232,241,249,259,264,275,282,289,297,304,311,319,324,326,334,342,350,357,369,373,377,386,391,400,404,411,418,430,438,446,454,462,470,474};
+static const unsigned char jswBuiltInObjectHash[] FLASH_SECT = {14,68,0,0,96,5,1,0,83,3,1,41,7,95,34,18,12,43,34,6,255,24,5,11,18,255,10,255,47,2,35,31,12,54,46,255,22,25,40,7,26,255,21,16,38,41,9,30,42,255,0,33,255,53,255,3,255,28,17,39,32,8,255,15,255,50,29,23,49,1,37,20,4,48,255,27,13,52,44,19,51,45,36,255,14};
+#endif
+
+bool jswIsBuiltInObject(const char *name) {
+#ifndef ESPR_NO_SYMBOL_HASH
+  int idx = jswHashFind(jswBuiltInObjectHash, name);
+  return idx>=0 && strcmp(&jswBuiltInObjectNames[READ_FLASH_UINT16(&jswBuiltInObjectOffsets[idx])], name)==0;
+#else
+  const char *s = jswBuiltInObjectNames;
+  while (*s) {
+    if (strcmp(s, name)==0) return true;
+    s+=strlen(s)+1;
+  }
+  return false;
+#endif
+}
+
+
+#ifndef ESPR_NO_SYMBOL_HASH
+static const char *const jswBuiltInLibraryNames[] FLASH_SECT = {"timer","Flash","Storage","heatshrink","fs","net","dgram","tls","http","NetworkJS","TelnetServer","crypto","tensorflow"};
+static void *const jswBuiltInLibraries[] FLASH_SECT = {(void*)gen_jswrap_timer_timer,(void*)gen_jswrap_Flash_Flash,(void*)gen_jswrap_Storage_Storage,(void*)gen_jswrap_heatshrink_heatshrink,(void*)gen_jswrap_fs_fs,(void*)gen_jswrap_net_net,(void*)gen_jswrap_dgram_dgram,(void*)gen_jswrap_tls_tls,(void*)gen_jswrap_http_http,(void*)gen_jswrap_NetworkJS_NetworkJS,(void*)gen_jswrap_TelnetServer_TelnetServer,(void*)gen_jswrap_crypto_crypto,(void*)gen_jswrap_tensorflow_tensorflow};
+static const unsigned char jswBuiltInLibraryHash[] FLASH_SECT = {4,16,0,7,10,10,0,11,255,9,12,255,4,10,255,0,2,8,5,3,7,6,1};
+#endif
+
+void *jswGetBuiltInLibrary(const char *name) {
+#ifndef ESPR_NO_SYMBOL_HASH
+  int idx = jswHashFind(jswBuiltInLibraryHash, name);
+  if (idx>=0 && strcmp(jswBuiltInLibraryNames[idx], name)==0) return jswBuiltInLibraries[idx];
+#else
+  if (strcmp(name, "timer")==0) return (void*)gen_jswrap_timer_timer;
+  if (strcmp(name, "Flash")==0) return (void*)gen_jswrap_Flash_Flash;
+  if (strcmp(name, "Storage")==0) return (void*)gen_jswrap_Storage_Storage;
+  if (strcmp(name, "heatshrink")==0) return (void*)gen_jswrap_heatshrink_heatshrink;
+  if (strcmp(name, "fs")==0) return (void*)gen_jswrap_fs_fs;
+  if (strcmp(name, "net")==0) return (void*)gen_jswrap_net_net;
+  if (strcmp(name, "dgram")==0) return (void*)gen_jswrap_dgram_dgram;
+  if (strcmp(name, "tls")==0) return (void*)gen_jswrap_tls_tls;
+  if (strcmp(name, "http")==0) return (void*)gen_jswrap_http_http;
+  if (strcmp(name, "NetworkJS")==0) return (void*)gen_jswrap_NetworkJS_NetworkJS;
+  if (strcmp(name, "TelnetServer")==0) return (void*)gen_jswrap_TelnetServer_TelnetServer;
+  if (strcmp(name, "crypto")==0) return (void*)gen_jswrap_crypto_crypto;
+  if (strcmp(name, "tensorflow")==0) return (void*)gen_jswrap_tensorflow_tensorflow;
+#endif
+  return 0;
+}
+
+
+/** Given a variable, return the basic object name of it */
+const char *jswGetBasicObjectName(JsVar *var) {
+  if (jsvIsArrayBuffer(var)) {
+    if (var->varData.arraybuffer.type==ARRAYBUFFERVIEW_ARRAYBUFFER) return "ArrayBuffer";
+    if (var->varData.arraybuffer.type==ARRAYBUFFERVIEW_UINT8) return "Uint8Array";
+    if (var->varData.arraybuffer.type==(ARRAYBUFFERVIEW_UINT8|ARRAYBUFFERVIEW_CLAMPED)) return "Uint8ClampedArray";
+    if (var->varData.arraybuffer.type==ARRAYBUFFERVIEW_INT8) return "Int8Array";
+    if (var->varData.arraybuffer.type==ARRAYBUFFERVIEW_UINT16) return "Uint16Array";
+    if (var->varData.arraybuffer.type==ARRAYBUFFERVIEW_INT16) return "Int16Array";
+    if (var->varData.arraybuffer.type==ARRAYBUFFERVIEW_UINT24) return "Uint24Array";
+    if (var->varData.arraybuffer.type==ARRAYBUFFERVIEW_UINT32) return "Uint32Array";
+    if (var->varData.arraybuffer.type==ARRAYBUFFERVIEW_INT32) return "Int32Array";
+    if (var->varData.arraybuffer.type==ARRAYBUFFERVIEW_FLOAT32) return "Float32Array";
+    if (var->varData.arraybuffer.type==ARRAYBUFFERVIEW_FLOAT64) return "Float64Array";
+  }
+  if (jsvIsPin(var)) return "Pin";
+  if (jsvIsArray(var)) return "Array";
+  if (jsvIsNumeric(var)) return "Number";
+  if (jsvIsObject(var)) return "Object";
+  if (jsvIsFunction(var)) return "Function";
+  if (jsvIsString(var)) return "String";
+  return 0;
+}
+
+
+/** Given the name of a Basic Object, eg, Uint8Array, String, etc. Return the prototype object's name - or 0. */
+const char *jswGetBasicObjectPrototypeName(const char *objectName) {
+  if (!strcmp(objectName, "Uint8Array")) return "ArrayBufferView";
+  if (!strcmp(objectName, "Uint8ClampedArray")) return "ArrayBufferView";
+  if (!strcmp(objectName, "Int8Array")) return "ArrayBufferView";
+  if (!strcmp(objectName, "Uint16Array")) return "ArrayBufferView";
+  if (!strcmp(objectName, "Int16Array")) return "ArrayBufferView";
+  if (!strcmp(objectName, "Uint24Array")) return "ArrayBufferView";
+  if (!strcmp(objectName, "Uint32Array")) return "ArrayBufferView";
+  if (!strcmp(objectName, "Int32Array")) return "ArrayBufferView";
+  if (!strcmp(objectName, "Float32Array")) return "ArrayBufferView";
+  if (!strcmp(objectName, "Float64Array")) return "ArrayBufferView";
+  return strcmp(objectName,"Object") ? "Object" : 0;
+}
+
+
+/** Tasks to run on Idle. Returns true if either one of the tasks returned true (eg. they're doing something and want to avoid sleeping) */
+bool jswIdle() {
+  bool wasBusy = false;
+  wasBusy |= jswrap_pipe_idle();
+  wasBusy |= jswrap_serial_idle();
+  wasBusy |= jswrap_graphics_idle();
+  wasBusy |= jswrap_net_idle();
+  wasBusy |= jswrap_telnet_idle();
+  return wasBusy;
+}
+
+
+/** Tasks to run on Hardware Initialisation (called once at boot time, after jshInit, before jsvInit/etc) */
+void jswHWInit() {
+}
+
+
+/** Tasks to run on Initialisation (eg boot/load/reset/after save/etc) */
+void jswInit() {
+  jswrap_graphics_init();
+  jswrap_net_init();
+  jswrap_telnet_init();
+}
+
+
+/** Tasks to run on Deinitialisation (eg before save/reset/etc) */
+void jswKill() {
+  jswrap_pipe_kill();
+  jswrap_waveform_kill();
+  jswrap_file_kill();
+  jswrap_net_kill();
+  jswrap_telnet_kill();
+}
+
+
+/** When called with an Object, fields are added for each device that is used with estimated power usage in uA (type:'powerusage' in JSON) */
+void jswGetPowerUsage(JsVar *devices) {
+}
+
+
+/** Tasks to run when a character is received on a certain event channel. True if handled and shouldn't go to IRQ (type:'EV_SERIAL1/etc' in JSON) */
+bool jswOnCharEvent(IOEventFlags channel, char charData) {
+  NOT_USED(channel);
+  NOT_USED(charData);
+  return false;
+}
+/** When we receive EV_CUSTOM, this is called so any library (eg Waveform) can hook onto it (type:'EV_CUSTOM' in JSON) */
+void jswOnCustomEvent(IOEventFlags eventFlags, uint8_t *data, int dataLen) {
+  jswrap_waveform_eventHandler(eventFlags, data, dataLen);
+}
+
+
+
+
+/** If we have a built-in module with the given name, return the module's contents - or 0 */
+const char *jswGetBuiltInJSLibrary(const char *name) {
+  NOT_USED(name);
+  return 0;
+}
+
+
+const char *jswGetBuiltInLibraryNames() {
+  return "timer,Flash,Storage,heatshrink,fs,net,dgram,tls,http,NetworkJS,TelnetServer,crypto,tensorflow";
+}
+
+
@@ -40,6 +40,12 @@ page for more information on how to use it.
   "class" : "httpSrv"
 }
 The HTTP server created by `require('http').createServer`
+
+By default the connection is closed after each response. To let clients make
+more requests on the same connection, set `server.keepAliveTimeout` to the
+number of milliseconds an idle connection is kept open for (eg. 5000). The
+connection is then kept open if the client asks for it and the response has a
+`Content-Length` or is chunked.
 */
 // there is a 'connect' event on httpSrv, but it's used by createServer and isn't node-compliant
 
@@ -89,6 +95,15 @@ The headers to sent to the server with this HTTP request.
 }
 The HTTP method used with this request. Often `"GET"`.
 *//*Documentation only*/
+/*JSON{
+    "type" : "property",
+    "class" : "httpSRq",
+    "name" : "httpVersion",
+    "generate" : false,
+    "return" : ["JsVar", "A string" ]
+}
+The HTTP version used by the client - usually `"1.1"`
+*//*Documentation only*/
 /*JSON{
     "type" : "property",
     "class" : "httpSRq",
@@ -359,7 +374,9 @@ var options = {
     path: '/',           // path sent to server
     method: 'GET',       // HTTP command sent to server (must be uppercase 'GET', 'POST', etc)
     protocol: 'http:',   // optional protocol - https: or http:
-    headers: { key : value, key : value } // (optional) HTTP headers
+    headers: { key : value, key : value }, // (optional) HTTP headers
+    keepAlive: true,     // (optional) keep the connection open for more requests to the same host
+    keepAliveTimeout: 5000 // (optional) milliseconds to keep an idle connection open for
   };
 var req = require("http").request(options, function(res) {
   res.on('data', function(data) {
@@ -376,6 +393,13 @@ req.end(); // called to finish the HTTP request and get the response
 You can easily pre-populate `options` from a URL using `var options =
 url.parse("http://www.example.com/foo.html")`
 
+If `keepAlive` is set and the server agrees, once the response has been
+received the connection is kept for `keepAliveTimeout` milliseconds, and any
+request made in that time to the same `host` and `port` uses it rather than
+opening a new connection. If the server closed that connection just as it was
+reused (so nothing was received), the request is sent again once on a new
+connection.
+
 There's an example of using [`http.request` for HTTP POST
 here](/Internet#http-post)
 
@@ -482,6 +506,9 @@ The default contents are:
   "Connection": "close"
  }
 ```
+
+If `server.keepAliveTimeout` is set and the client allows the connection to be
+kept open, `Connection` is `"keep-alive"` instead (see `httpSrv`).
 *//*Documentation only*/
 
 /*JSON{
@@ -49,6 +49,140 @@
 #define DBG(format, ...) do { } while(0)
 #endif
 
+#ifdef NET_LINUX_EPOLL
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <stdlib.h>
+#include "jshardware.h"
+#include "socketserver.h"
+
+/* All our sockets are non-blocking and added to an edge-triggered epoll set.
+ * When epoll says a socket is readable/writable we set a flag in netReadyFlags,
+ * and only clear it when a call returns EAGAIN - so recv/send/accept on a socket
+ * with nothing to do don't need a system call at all. */
+#define NET_READABLE  1
+#define NET_WRITABLE  2
+#define NET_WATCHED   4 ///< in the epoll set
+#define NET_UNWATCHED 8 ///< couldn't be added to the epoll set, so always try to read/write it
+#define NET_MAX_EVENTS 32 ///< Most events to handle for each epoll_wait
+
+static int netEpollFd = -1;
+static int netWakeFd = -1; ///< eventfd in the epoll set, used by net_linux_wake
+static uint8_t *netReadyFlags = 0; ///< flags for each socket, indexed by file descriptor
+static int netReadyFlagsSize = 0;
+static int netWatchedCount = 0; ///< how many sockets have NET_WATCHED or NET_UNWATCHED set
+static int netUnwatchedCount = 0;
+
+static uint8_t *net_linux_getFlags(int sckt) {
+  if (sckt<0) return 0;
+  if (sckt>=netReadyFlagsSize) {
+    int newSize = netReadyFlagsSize ? netReadyFlagsSize : 64;
+    while (newSize<=sckt) newSize *= 2;
+    uint8_t *newFlags = realloc(netReadyFlags, (size_t)newSize);
+    if (!newFlags) return 0;
+    memset(&newFlags[netReadyFlagsSize], 0, (size_t)(newSize-netReadyFlagsSize));
+    netReadyFlags = newFlags;
+    netReadyFlagsSize = newSize;
+  }
+  return &netReadyFlags[sckt];
+}
+
+/// Make the socket non-blocking and add it to the epoll set
+static void net_linux_watch(int sckt) {
+  uint8_t *flags = net_linux_getFlags(sckt);
+  if (!flags) return; // out of memory - we'll fall back to select()
+  fcntl(sckt, F_SETFL, fcntl(sckt, F_GETFL, 0) | O_NONBLOCK);
+  if (netEpollFd<0) {
+    netEpollFd = epoll_create1(EPOLL_CLOEXEC);
+    netWakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (netEpollFd>=0 && netWakeFd>=0) {
+      struct epoll_event ev;
+      ev.events = EPOLLIN;
+      ev.data.fd = netWakeFd;
+      epoll_ctl(netEpollFd, EPOLL_CTL_ADD, netWakeFd, &ev);
+    }
+  }
+  struct epoll_event ev;
+  ev.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+  ev.data.fd = sckt;
+  if (netEpollFd>=0 && epoll_ctl(netEpollFd, EPOLL_CTL_ADD, sckt, &ev)==0) {
+    *flags = NET_WATCHED; // epoll reports the current state after EPOLL_CTL_ADD
+  } else {
+    *flags = NET_UNWATCHED | NET_READABLE | NET_WRITABLE;
+    netUnwatchedCount++;
+  }
+  netWatchedCount++;
+}
+
+/// Remove the socket from the epoll set
+static void net_linux_unwatch(int sckt) {
+  uint8_t *flags = (sckt>=0 && sckt<netReadyFlagsSize) ? &netReadyFlags[sckt] : 0;
+  if (!flags || !(*flags & (NET_WATCHED|NET_UNWATCHED))) return;
+  if (*flags & NET_WATCHED)
+    epoll_ctl(netEpollFd, EPOLL_CTL_DEL, sckt, NULL);
+  else
+    netUnwatchedCount--;
+  netWatchedCount--;
+  *flags = 0;
+}
+
+/// Is the socket (possibly) ready? If we don't know about it, use select() like we used to
+static bool net_linux_isReady(int sckt, uint8_t readyFlag) {
+  if (sckt>=0 && sckt<netReadyFlagsSize && (netReadyFlags[sckt] & (NET_WATCHED|NET_UNWATCHED)))
+    return (netReadyFlags[sckt] & readyFlag)!=0;
+  fd_set s;
+  FD_ZERO(&s);
+  FD_SET(sckt,&s);
+  struct timeval timeout;
+  timeout.tv_sec = 0;
+  timeout.tv_usec = 0;
+  int n = (readyFlag==NET_READABLE) ? select(sckt+1,&s,NULL,NULL,&timeout) : select(sckt+1,NULL,&s,NULL,&timeout);
+  return n!=0; // if there's an error, we want the caller to find it
+}
+
+/// Called when a read/write returned EAGAIN - epoll will tell us when it is ready again
+static void net_linux_notReady(int sckt, uint8_t readyFlag) {
+  if (sckt>=0 && sckt<netReadyFlagsSize && (netReadyFlags[sckt] & NET_WATCHED))
+    netReadyFlags[sckt] &= (uint8_t)~readyFlag;
+}
+
+bool net_linux_wait(int timeoutMs) {
+  if (netEpollFd<0 || !netWatchedCount) return false;
+  if (netUnwatchedCount && timeoutMs>50) timeoutMs = 50; // we have to poll those sockets
+  JsSysTime timeout = socketGetNextTimeout(); // wake up to close idle keep-alive connections
+  if (timeout) {
+    JsSysTime now = jshGetSystemTime();
+    int ms = (timeout > now) ? (int)jshGetMillisecondsFromTime(timeout-now)+1 : 0;
+    if (ms < timeoutMs) timeoutMs = ms;
+  }
+  struct epoll_event events[NET_MAX_EVENTS];
+  int n = epoll_wait(netEpollFd, events, NET_MAX_EVENTS, timeoutMs);
+  for (int i=0;i<n;i++) {
+    int fd = events[i].data.fd;
+    if (fd==netWakeFd) {
+      uint64_t v;
+      if (read(netWakeFd, &v, sizeof(v))) {} // just clear it
+    } else if (fd>=0 && fd<netReadyFlagsSize) {
+      // on errors/hangup we set both so that recv/send find out what happened
+      uint32_t e = events[i].events;
+      if (e & (EPOLLIN|EPOLLRDHUP|EPOLLHUP|EPOLLERR)) netReadyFlags[fd] |= NET_READABLE;
+      if (e & (EPOLLOUT|EPOLLHUP|EPOLLERR)) netReadyFlags[fd] |= NET_WRITABLE;
+    }
+  }
+  return true;
+}
+
+bool net_linux_hasSockets() {
+  return netWatchedCount>0;
+}
+
+void net_linux_wake() {
+  if (netWakeFd<0) return;
+  uint64_t v = 1;
+  if (write(netWakeFd, &v, sizeof(v))) {} // errors mean it's already signalled
+}
+#endif // NET_LINUX_EPOLL
+
 
 /// Get an IP address from a name. Sets out_ip_addr to 0 on failure
 void net_linux_gethostbyname(JsNetwork *net, char * hostName, uint32_t* out_ip_addr) {
@@ -61,6 +195,9 @@ void net_linux_gethostbyname(JsNetwork *net, char * hostName, uint32_t* out_ip_a
 /// Called on idle. Do any checks required for this device
 void net_linux_idle(JsNetwork *net) {
   NOT_USED(net);
+#ifdef NET_LINUX_EPOLL
+  net_linux_wait(0); // find out which sockets are now ready
+#endif
 }
 
 /// Call just before returning to idle loop. This checks for errors and tries to recover. Returns true if no errors.
@@ -199,12 +336,18 @@ int net_linux_createsocket(JsNetwork *net, SocketType socketType, uint32_t host,
     jsWarn("setsockopt(SO_NOSIGPIPE) failed\n");
 #endif
 
+#ifdef NET_LINUX_EPOLL
+  net_linux_watch(sckt); // after connect, so connecting still blocks like it used to
+#endif
   return sckt;
 }
 
 /// destroys the given socket
 void net_linux_closesocket(JsNetwork *net, int sckt) {
   NOT_USED(net);
+#ifdef NET_LINUX_EPOLL
+  net_linux_unwatch(sckt);
+#endif
   closesocket(sckt);
 }
 
@@ -212,6 +355,16 @@ void net_linux_closesocket(JsNetwork *net, int sckt) {
 int net_linux_accept(JsNetwork *net, int sckt) {
   NOT_USED(net);
   // TODO: look for unreffed servers?
+#ifdef NET_LINUX_EPOLL
+  if (!net_linux_isReady(sckt, NET_READABLE)) return -1;
+  // we have a client waiting to connect... try to connect and see what happens
+  int theClient = accept(sckt,0,0);
+  if (theClient<0) {
+    if (errno==EAGAIN || errno==EWOULDBLOCK) net_linux_notReady(sckt, NET_READABLE);
+  } else
+    net_linux_watch(theClient);
+  return theClient;
+#else
   fd_set s;
   FD_ZERO(&s);
   FD_SET(sckt,&s);
@@ -226,6 +379,7 @@ int net_linux_accept(JsNetwork *net, int sckt) {
     return theClient;
   }
   return -1;
+#endif
 }
 
 /// Receive data if possible. returns nBytes on success, 0 on no data, or -1 on failure
@@ -234,6 +388,9 @@ int net_linux_recv(JsNetwork *net, SocketType socketType, int sckt, void *buf, s
   struct sockaddr_in fromAddr;
   int fromAddrLen = sizeof(fromAddr);
   int num = 0;
+#ifdef NET_LINUX_EPOLL
+  int n = net_linux_isReady(sckt, NET_READABLE) ? 1 : 0;
+#else
   fd_set s;
   FD_ZERO(&s);
   FD_SET(sckt,&s);
@@ -242,6 +399,7 @@ int net_linux_recv(JsNetwork *net, SocketType socketType, int sckt, void *buf, s
   timeout.tv_sec = 0;
   timeout.tv_usec = 0;
   int n = select(sckt+1,&s,NULL,NULL,&timeout);
+#endif
   if (n==SOCKET_ERROR) {
     // we probably disconnected
     return -1;
@@ -250,6 +408,12 @@ int net_linux_recv(JsNetwork *net, SocketType socketType, int sckt, void *buf, s
     if (socketType & ST_UDP) {
       JsNetUDPPacketHeader *header = (JsNetUDPPacketHeader*)buf;
       num = (int)recvfrom(sckt,buf+sizeof(JsNetUDPPacketHeader),len-sizeof(JsNetUDPPacketHeader),0,(struct sockaddr *)&fromAddr,(socklen_t*)&fromAddrLen);
+#ifdef NET_LINUX_EPOLL
+      if (num<0 && (errno==EAGAIN || errno==EWOULDBLOCK)) {
+        net_linux_notReady(sckt, NET_READABLE);
+        return 0;
+      }
+#endif
       *(in_addr_t*)&header->host = fromAddr.sin_addr.s_addr;
       header->port = ntohs(fromAddr.sin_port);
       header->length = (uint16_t)num;
@@ -259,6 +423,12 @@ int net_linux_recv(JsNetwork *net, SocketType socketType, int sckt, void *buf, s
       num += sizeof(JsNetUDPPacketHeader);
     } else {
       num = (int)recvfrom(sckt,buf,len,0,(struct sockaddr *)&fromAddr,(socklen_t*)&fromAddrLen);
+#ifdef NET_LINUX_EPOLL
+      if (num<0 && (errno==EAGAIN || errno==EWOULDBLOCK)) {
+        net_linux_notReady(sckt, NET_READABLE);
+        return 0;
+      }
+#endif
       if (num==0) return -1; // select says data, but recv says 0 means connection is closed
     }
   }
@@ -269,6 +439,10 @@ int net_linux_recv(JsNetwork *net, SocketType socketType, int sckt, void *buf, s
 /// Send data if possible. returns nBytes on success, 0 on no data, or -1 on failure
 int net_linux_send(JsNetwork *net, SocketType socketType, int sckt, const void *buf, size_t len) {
   NOT_USED(net);
+#ifdef NET_LINUX_EPOLL
+  int n;
+  if (net_linux_isReady(sckt, NET_WRITABLE)) {
+#else
   fd_set writefds;
   FD_ZERO(&writefds);
   FD_SET(sckt, &writefds);
@@ -280,6 +454,7 @@ int net_linux_send(JsNetwork *net, SocketType socketType, int sckt, const void *
      // we probably disconnected so just get rid of this
     return -1;
   } else if (FD_ISSET(sckt, &writefds)) {
+#endif
     int flags = 0;
 #if !defined(SO_NOSIGPIPE) && defined(MSG_NOSIGNAL)
     flags |= MSG_NOSIGNAL;
@@ -293,10 +468,16 @@ int net_linux_send(JsNetwork *net, SocketType socketType, int sckt, const void *
 
       DBG("Send %d %x:%d", len - sizeof(JsNetUDPPacketHeader), header->host, header->port);
       n = (int)sendto(sckt, buf + sizeof(JsNetUDPPacketHeader), header->length, flags, (struct sockaddr *)&sin, sizeof(sockaddr_in));
-      n += sizeof(JsNetUDPPacketHeader);
+      if (n>=0) n += sizeof(JsNetUDPPacketHeader);
     } else {
       n = (int)send(sckt, buf, len, flags);
     }
+#ifdef NET_LINUX_EPOLL
+    if (n<0 && (errno==EAGAIN || errno==EWOULDBLOCK)) {
+      net_linux_notReady(sckt, NET_WRITABLE);
+      return 0; // buffer is full - epoll will tell us when we can send
+    }
+#endif
     return n;
   } else
     return 0; // just not ready
@@ -312,4 +493,7 @@ void netSetCallbacks_linux(JsNetwork *net) {
   net->recv = net_linux_recv;
   net->send = net_linux_send;
   net->chunkSize = 536;
+#ifdef NET_LINUX_EPOLL
+  net->socketsWakeSleep = true; // jshSleep waits on our epoll set
+#endif
 }
@@ -14,3 +14,14 @@
 #include "network.h"
 
 void netSetCallbacks_linux(JsNetwork *net);
+
+#if defined(__linux__)
+#define NET_LINUX_EPOLL // Use epoll to find out which sockets are ready, rather than calling select() for each socket
+
+/// Wait up to timeoutMs for a socket to become ready (or net_linux_wake to be called). Returns false without waiting if there are no open sockets
+bool net_linux_wait(int timeoutMs);
+/// Make net_linux_wait return early - this can be called from another thread
+void net_linux_wake();
+/// Are there any open sockets?
+bool net_linux_hasSockets();
+#endif
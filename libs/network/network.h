@@ -84,6 +84,9 @@ typedef struct JsNetwork {
   int (*recv)(struct JsNetwork *net, SocketType socketType, int sckt, void *buf, size_t len);
   /// Send data if possible. returns nBytes on success, 0 on no data, or -1 on failure
   int (*send)(struct JsNetwork *net, SocketType socketType, int sckt, const void *buf, size_t len);
+
+  /// If true, jshSleep wakes up as soon as a socket is ready, so having sockets open doesn't have to stop us sleeping
+  bool socketsWakeSleep;
 } PACKED_FLAGS JsNetwork;
 
 /// Header applied to all UDP packets when they are received
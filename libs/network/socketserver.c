@@ -18,8 +18,6 @@
 #include "jshardware.h"
 #include "jswrap_net.h"
 #include "jswrap_stream.h"
-#include "jswrap_string.h"
-#include "jswrap_functions.h"
 
 #define HTTP_NAME_SOCKETTYPE "type" // normal socket or HTTP
 #define HTTP_NAME_PORT "port"
@@ -27,8 +25,11 @@
 #define HTTP_NAME_HAD_HEADERS "hdrs"
 #define HTTP_NAME_ENDED "endd"
 #define HTTP_NAME_RECEIVE_DATA "dRcv"
-#define HTTP_NAME_RECEIVE_COUNT "cRcv"
+#define HTTP_NAME_RECEIVE_COUNT "cRcv" // bytes of body left to receive, or 1/0 for chunked, or -1 to receive until the connection closes
+#define HTTP_NAME_CHUNK_LEFT "cChk"   // bytes left of the current chunk (including the CRLF after it)
+#define HTTP_NAME_HEADER_SCAN "hScn"  // how far we've searched for the end of the headers (idx<<2 | newlines found)
 #define HTTP_NAME_SEND_DATA "dSnd"
+#define HTTP_NAME_SEND_OFFSET "dSnO" // how many bytes of dSnd have already been sent
 #define HTTP_NAME_RESPONSE_VAR "res"
 #define HTTP_NAME_OPTIONS_VAR "opt"
 #define HTTP_NAME_SERVER_VAR "svr"
@@ -37,6 +38,9 @@
 #define HTTP_NAME_CLOSENOW "clsNow"  // boolean: gotta close
 #define HTTP_NAME_CONNECTED "conn"     // boolean: we are connected
 #define HTTP_NAME_CLOSE "cls"        // close after sending
+#define HTTP_NAME_KEEP_ALIVE "kAlv"  // boolean: the connection can be kept open after this response
+#define HTTP_NAME_TIMEOUT "tOut"     // system time at which an idle keep-alive connection is closed
+#define HTTP_NAME_RETRY_DATA "dRty"  // a client request on a pooled socket: what we've sent, in case we have to send it again on a new socket
 #define HTTP_NAME_ON_CONNECT JS_EVENT_PREFIX"connect"
 #define HTTP_NAME_ON_CLOSE JS_EVENT_PREFIX"close"
 #define HTTP_NAME_ON_END JS_EVENT_PREFIX"end"
@@ -48,6 +52,12 @@
 #define HTTP_ARRAY_HTTP_CLIENT_CONNECTIONS "HttpCC"
 #define HTTP_ARRAY_HTTP_SERVERS "HttpS"
 #define HTTP_ARRAY_HTTP_SERVER_CONNECTIONS "HttpSC"
+#define HTTP_ARRAY_HTTP_CLIENT_POOL "HttpCP" // idle keep-alive client sockets, waiting to be reused
+
+#define HTTP_KEEP_ALIVE_TIMEOUT 5000 // default milliseconds before an idle keep-alive client socket is closed
+
+#define SOCKET_CHUNKS_PER_IDLE 8 // most chunks to send or receive for each socket each time around the idle loop
+#define SOCKET_MAX_RECEIVE_DATA(net) ((size_t)(net)->chunkSize*SOCKET_CHUNKS_PER_IDLE) // stop reading a socket if this much received data hasn't been used
 
 #ifdef ESP8266
 // esp8266 debugging, need to remove this eventually
@@ -64,6 +74,9 @@ static char DBG_LIB[] = "socketserver"; // library name
 #define DBG(format, ...) do { } while(0)
 #endif
 
+/// The earliest time at which an idle keep-alive connection will time out (or 0)
+static JsSysTime socketNextTimeout = 0;
+
 // -----------------------------
 
 static ALWAYS_INLINE bool compareTransferEncodingAndUnlock(JsVar *encoding, char *value) {
@@ -93,12 +106,13 @@ static void httpAppendHeaders(JsVar *string, JsVar *headerObject) {
 // httpParseHeaders(&receiveData, reqVar, true) // server
 // httpParseHeaders(&receiveData, resVar, false) // client
 bool httpParseHeaders(JsVar **receiveData, JsVar *objectForData, bool isServer) {
-  // find /r/n/r/n
-  int newlineIdx = 0;
-  int strIdx = 0;
+  // find /r/n/r/n - carrying on from where we got to last time, as receiveData only gets appended to
+  JsVarInt scanState = jsvGetIntegerAndUnLock(jsvObjectGetChildIfExists(objectForData, HTTP_NAME_HEADER_SCAN));
+  int newlineIdx = (int)(scanState&3);
+  int strIdx = (int)(scanState>>2);
   int headerEnd = -1;
   JsvStringIterator it;
-  jsvStringIteratorNew(&it, *receiveData, 0);
+  jsvStringIteratorNew(&it, *receiveData, (size_t)strIdx);
   while (jsvStringIteratorHasChar(&it)) {
     char ch = jsvStringIteratorGetCharAndNext(&it);
     if (ch == '\r') {
@@ -115,7 +129,11 @@ bool httpParseHeaders(JsVar **receiveData, JsVar *objectForData, bool isServer)
   }
   jsvStringIteratorFree(&it);
   // skip if we have no header
-  if (headerEnd<0) return false;
+  if (headerEnd<0) {
+    jsvObjectSetIntChild(objectForData, HTTP_NAME_HEADER_SCAN, ((JsVarInt)strIdx<<2) | newlineIdx);
+    return false;
+  }
+  jsvObjectRemoveChild(objectForData, HTTP_NAME_HEADER_SCAN);
   // Now parse the header
   JsVar *vHeaders = jsvNewObject();
   if (!vHeaders) return true;
@@ -130,7 +148,7 @@ bool httpParseHeaders(JsVar **receiveData, JsVar *objectForData, bool isServer)
   int valueStart = 0;
   //jsiConsolePrintStringVar(receiveData);
   jsvStringIteratorNew(&it, *receiveData, 0);
-    while (jsvStringIteratorHasChar(&it)) {
+    while (strIdx < headerEnd && jsvStringIteratorHasChar(&it)) { // don't go past the headers into a body or the next request
       char ch = jsvStringIteratorGetCharAndNext(&it);
       if (ch==' ' || ch=='\r') {
         if (firstSpace<0) firstSpace = strIdx;
@@ -169,7 +187,16 @@ bool httpParseHeaders(JsVar **receiveData, JsVar *objectForData, bool isServer)
     jsvObjectSetBoolChild(objectForData, HTTP_NAME_CHUNKED, true);
     contentToReceive = 1;
   } else {
-    contentToReceive = jsvGetIntegerAndUnLock(jsvObjectGetChildI(vHeaders,"Content-Length"));
+    JsVar *contentLength = jsvObjectGetChildI(vHeaders,"Content-Length");
+    if (contentLength) {
+      contentToReceive = jsvGetIntegerAndUnLock(contentLength);
+    } else if (!isServer || jsvIsStringIEqualAndUnLock(jsvObjectGetChildI(vHeaders, "Connection"), "close")) {
+      // No length, so the body is everything until the connection closes
+      contentToReceive = -1;
+    } else {
+      // A request with no length has no body - anything after it is the next request
+      contentToReceive = 0;
+    }
   }
   jsvObjectSetIntChild(objectForData, HTTP_NAME_RECEIVE_COUNT, contentToReceive);
   jsvUnLock(vHeaders);
@@ -177,6 +204,8 @@ bool httpParseHeaders(JsVar **receiveData, JsVar *objectForData, bool isServer)
   if (isServer) {
     jsvObjectSetChildAndUnLock(objectForData, "method", jsvNewFromStringVar(*receiveData, 0, (size_t)firstSpace));
     jsvObjectSetChildAndUnLock(objectForData, "url", jsvNewFromStringVar(*receiveData, (size_t)(firstSpace+1), (size_t)(secondSpace-(firstSpace+1))));
+    if (firstEOL > secondSpace+6) // skip 'HTTP/'
+      jsvObjectSetChildAndUnLock(objectForData, "httpVersion", jsvNewFromStringVar(*receiveData, (size_t)(secondSpace+6), (size_t)(firstEOL-(secondSpace+6))));
   } else {
     jsvObjectSetChildAndUnLock(objectForData, "httpVersion", jsvNewFromStringVar(*receiveData, 5, (size_t)firstSpace-5));
     jsvObjectSetChildAndUnLock(objectForData, "statusCode", jsvNewFromStringVar(*receiveData, (size_t)(firstSpace+1), (size_t)(secondSpace-(firstSpace+1))));
@@ -204,6 +233,43 @@ size_t httpStringGet(JsVar *v, char *str, size_t len) {
   return len-l;
 }
 
+// Does this request/response allow the connection to be kept open afterwards?
+static bool httpAllowsKeepAlive(JsVar *objectForData) {
+  JsVar *headers = jsvObjectGetChildIfExists(objectForData, HTTP_NAME_HEADERS);
+  JsVar *connection = jsvObjectGetChildI(headers, "Connection");
+  jsvUnLock(headers);
+  if (connection)
+    return !jsvIsStringIEqualAndUnLock(connection, "close");
+  // HTTP/1.1 connections are persistent unless they say otherwise
+  return jsvIsStringIEqualAndUnLock(jsvObjectGetChildIfExists(objectForData, "httpVersion"), "1.1");
+}
+
+// Get the keep-alive timeout in milliseconds from a server or request options, or defaultMs if not set (0 = don't keep alive)
+static JsVarInt httpGetKeepAliveTimeout(JsVar *obj, JsVarInt defaultMs) {
+  JsVar *timeout = jsvObjectGetChildIfExists(obj, "keepAliveTimeout");
+  JsVarInt ms = timeout ? jsvGetIntegerAndUnLock(timeout) : defaultMs;
+  return ms>0 ? ms : 0;
+}
+
+static void socketSetIdleTimeout(JsVar *obj, JsVarInt ms) {
+  jsvObjectSetChildAndUnLock(obj, HTTP_NAME_TIMEOUT, jsvNewFromLongInteger(jshGetSystemTime() + jshGetTimeFromMilliseconds((JsVarFloat)ms)));
+}
+
+// Has this idle connection timed out? If not, make sure we wake up in time to check again
+static bool socketIdleTimedOut(JsVar *obj) {
+  JsVar *timeout = jsvObjectGetChildIfExists(obj, HTTP_NAME_TIMEOUT);
+  if (!timeout) return false;
+  JsSysTime time = (JsSysTime)jsvGetLongIntegerAndUnLock(timeout);
+  if (jshGetSystemTime() >= time) return true;
+  if (!socketNextTimeout || time < socketNextTimeout)
+    socketNextTimeout = time;
+  return false;
+}
+
+JsSysTime socketGetNextTimeout() {
+  return socketNextTimeout;
+}
+
 // -----------------------------
 
 static JsVar *socketGetArray(const char *name, bool create) {
@@ -257,130 +323,233 @@ NO_INLINE static void _socketCloseAllConnections(JsNetwork *net) {
   // shut down connections
   _socketCloseAllConnectionsFor(net, HTTP_ARRAY_HTTP_SERVER_CONNECTIONS);
   _socketCloseAllConnectionsFor(net, HTTP_ARRAY_HTTP_CLIENT_CONNECTIONS);
+  _socketCloseAllConnectionsFor(net, HTTP_ARRAY_HTTP_CLIENT_POOL);
   _socketCloseAllConnectionsFor(net, HTTP_ARRAY_HTTP_SERVERS);
 }
 
-// returns 0 on success and a (negative) error number on failure
+// returns the number of bytes sent, or a (negative) error number on failure
 int socketSendData(JsNetwork *net, JsVar *connection, int sckt, JsVar **sendData) {
   SocketType socketType = socketGetType(connection);
+  bool isUDP = (socketType&ST_TYPE_MASK)==ST_UDP;
 
   assert(!jsvIsEmptyString(*sendData));
 
-  size_t sndBufLen;
-  if ((socketType&ST_TYPE_MASK)==ST_UDP) {
-      sndBufLen = (size_t)jsvGetStringLength(*sendData);
-      if (sndBufLen+1024 > jsuGetFreeStack()) {
-          jsExceptionHere(JSET_ERROR, "Not enough stack memory for data");
-          return -1;
-      }
+  size_t offset = (size_t)jsvGetIntegerAndUnLock(jsvObjectGetChildIfExists(connection, HTTP_NAME_SEND_OFFSET));
+  size_t sendDataLen = jsvGetStringLength(*sendData);
+  size_t chunkSize = isUDP ? sendDataLen-offset : (size_t)net->chunkSize;
+  // flat/native strings can be sent straight from memory, otherwise copy a chunk at a time
+  size_t dataLen;
+  char *data = jsvGetDataPointer(*sendData, &dataLen);
+  char *buf = 0;
+  if (!data) {
+    if (isUDP && chunkSize+1024 > jsuGetFreeStack()) {
+      jsExceptionHere(JSET_ERROR, "Not enough stack memory for data");
+      return -1;
+    }
+    buf = alloca(chunkSize); // allocate on stack
+  }
+
+  int sent = 0;
+  int chunks = isUDP ? 1 : SOCKET_CHUNKS_PER_IDLE;
+  while (chunks-- && offset < sendDataLen) {
+    size_t len = sendDataLen - offset;
+    if (len > chunkSize) len = chunkSize;
+    if (data) buf = &data[offset];
+    else jsvGetStringChars(*sendData, offset, buf, len);
+    int num = netSend(net, socketType, sckt, buf, len);
+    DBG("socketSendData %x:%d (%d -> %d)\n", *(uint32_t*)buf, *(unsigned short*)(buf+sizeof(uint32_t)), len, num);
+    if (num < 0) {
+      if (!sent) return num; // an error occurred
+      break; // we'll get the error next time
+    }
+    offset += (size_t)num;
+    sent += num;
+    if ((size_t)num < len) break; // we can't send any more right now
+  }
+
+  if (offset < sendDataLen) {
+    // we didn't send all of it... skip what we did send next time rather than copying the rest
+    if (sent) jsvObjectSetIntChild(connection, HTTP_NAME_SEND_OFFSET, (JsVarInt)offset);
   } else {
-      sndBufLen = (size_t)net->chunkSize;
+    // we sent all of it! Issue a drain event, unless we want to close, then we shouldn't
+    // callback for more data
+    bool wantClose = jsvGetBoolAndUnLock(jsvObjectGetChildIfExists(connection,HTTP_NAME_CLOSE));
+    if (!wantClose) {
+      jsiQueueObjectCallbacks(connection, HTTP_NAME_ON_DRAIN, &connection, 1);
+    }
+    jsvObjectRemoveChild(connection, HTTP_NAME_SEND_OFFSET);
+    jsvUnLock(*sendData);
+    *sendData = jsvNewFromEmptyString();
   }
-  char *buf = alloca(sndBufLen); // allocate on stack
-
-  size_t bufLen = httpStringGet(*sendData, buf, sndBufLen);
-  int num = netSend(net, socketType, sckt, buf, bufLen);
-  DBG("socketSendData %x:%d (%d -> %d)\n", *(uint32_t*)buf, *(unsigned short*)(buf+sizeof(uint32_t)), bufLen, num);
-  if (num < 0) return num; // an error occurred
-  // Now cut what we managed to send off the beginning of sendData
-  if (num > 0) {
-    JsVar *newSendData = 0;
-    if (num < (int)jsvGetStringLength(*sendData)) {
-      // we didn't send all of it... cut out what we did send
-      newSendData = jsvNewFromStringVar(*sendData, (size_t)num, JSVAPPENDSTRINGVAR_MAXLENGTH);
-    } else {
-      // we sent all of it! Issue a drain event, unless we want to close, then we shouldn't
-      // callback for more data
-      bool wantClose = jsvGetBoolAndUnLock(jsvObjectGetChildIfExists(connection,HTTP_NAME_CLOSE));
-      if (!wantClose) {
-        jsiQueueObjectCallbacks(connection, HTTP_NAME_ON_DRAIN, &connection, 1);
+  return sent;
+}
+
+/* Get sendData ready to have more data appended. If we were sending straight
+ * out of a flat/native string, copy what's left to send into a normal string.
+ * Returns the (locked) sendData to append to */
+static JsVar *socketGetSendDataForAppend(JsVar *connection, JsVar *sendData) {
+  if (!sendData || jsvHasStringExt(sendData)) return sendData;
+  size_t offset = (size_t)jsvGetIntegerAndUnLock(jsvObjectGetChildIfExists(connection, HTTP_NAME_SEND_OFFSET));
+  JsVar *newSendData = jsvNewWritableStringFromStringVar(sendData, offset, JSVAPPENDSTRINGVAR_MAXLENGTH);
+  jsvUnLock(sendData);
+  jsvObjectSetChild(connection, HTTP_NAME_SEND_DATA, newSendData);
+  jsvObjectRemoveChild(connection, HTTP_NAME_SEND_OFFSET);
+  return newSendData;
+}
+
+/* Receive data from a socket and add it to receiveData (which is created if needed).
+ * The first chunk goes into buf (chunkSize bytes on the stack) so idle sockets don't
+ * allocate anything, but if that fills up we receive the rest straight into a flat
+ * string to save copying it a few bytes at a time into a normal string.
+ * Returns the number of bytes received, or a (negative) error number */
+static int socketRecv(JsNetwork *net, SocketType socketType, int sckt, char *buf, JsVar **receiveData) {
+  size_t chunkSize = (size_t)net->chunkSize;
+  int num = netRecv(net, socketType, sckt, buf, chunkSize);
+  if (num <= 0) return num;
+  size_t len = (size_t)num;
+  JsVar *data = 0;
+  if (len==chunkSize && (socketType&ST_TYPE_MASK)!=ST_UDP) {
+    // there's probably more waiting
+    size_t flatLen = chunkSize*SOCKET_CHUNKS_PER_IDLE;
+    if (jsvMoreFreeVariablesThan((unsigned int)(2*flatLen/sizeof(JsVar))))
+      data = jsvNewFlatStringOfLength((unsigned int)flatLen);
+    if (data) {
+      char *ptr = jsvGetFlatStringPointer(data);
+      memcpy(ptr, buf, len);
+      while (len < flatLen) {
+        num = netRecv(net, socketType, sckt, &ptr[len], flatLen-len);
+        if (num <= 0) break; // any error will be reported next time around
+        len += (size_t)num;
       }
-      newSendData = jsvNewFromEmptyString();
+      jsvShrinkFlatString(data, len);
     }
-    jsvUnLock(*sendData);
-    *sendData = newSendData;
   }
+  if (data && (!*receiveData || jsvIsEmptyString(*receiveData))) {
+    jsvUnLock(*receiveData);
+    *receiveData = data;
+    return (int)len;
+  }
+  if (*receiveData && !jsvHasStringExt(*receiveData)) {
+    // we can't append to flat strings, so copy into a normal string first
+    JsVar *newReceiveData = jsvNewWritableStringFromStringVar(*receiveData, 0, JSVAPPENDSTRINGVAR_MAXLENGTH);
+    jsvUnLock(*receiveData);
+    *receiveData = newReceiveData;
+  }
+  if (!*receiveData) *receiveData = jsvNewFromEmptyString();
+  if (*receiveData) { // could be out of memory
+    if (data) jsvAppendStringVarComplete(*receiveData, data);
+    else jsvAppendStringBuf(*receiveData, buf, len);
+  }
+  jsvUnLock(data);
+  return (int)len;
+}
+
+/* If there's received data that hasn't been used yet (eg. the buffer is full because the
+ * stream isn't being read) don't receive any more, so the sender has to wait */
+static bool socketReceivePaused(JsNetwork *net, JsVar *receiveData) {
+  return receiveData && jsvGetStringLength(receiveData) >= SOCKET_MAX_RECEIVE_DATA(net);
+}
 
-  return 0;
+/* Parse the '<hex length>\r\n' line of an HTTP chunk starting at idx. Returns the index
+ * of the first byte of chunk data, or -1 if we haven't received the whole line yet */
+static int httpParseChunkHeader(JsVar *receiveData, size_t idx, int *chunkLen) {
+  bool inLength = true;
+  *chunkLen = 0;
+  JsvStringIterator it;
+  jsvStringIteratorNew(&it, receiveData, idx);
+  while (jsvStringIteratorHasChar(&it)) {
+    char ch = jsvStringIteratorGetCharAndNext(&it);
+    idx++;
+    if (ch=='\n') {
+      jsvStringIteratorFree(&it);
+      return (int)idx;
+    }
+    // stop at anything that's not hex, eg. chunk extensions
+    if (inLength && isHexadecimal(ch))
+      *chunkLen = (*chunkLen << 4) | chtod(ch);
+    else
+      inLength = false;
+  }
+  jsvStringIteratorFree(&it);
+  return -1;
 }
 
+/* Push received data to reader's 'data' event (or its buffer). For HTTP this works out
+ * which part of receiveData is body data (keeping track of chunks between calls) so it
+ * can be handed over as it arrives. Anything after the end of the body is left in
+ * receiveData (eg. the next request), as is any data that couldn't be pushed because
+ * the buffer was full. */
 void socketPushReceiveData(JsVar *reader, JsVar **receiveData, bool isHttp, bool force) {
   if (!*receiveData || jsvIsEmptyString(*receiveData)) {
     // no data available (after headers)
     return;
   }
 
-  JsVar *nextChunk = 0;
-  JsVar *partialChunk = 0;
+  if (!isHttp) {
+    // execute 'data' callback or save data
+    if (jswrap_stream_pushData(reader, *receiveData, force)) {
+      // clear received data
+      jsvUnLock(*receiveData);
+      *receiveData = 0;
+    }
+    return;
+  }
 
+  size_t len = jsvGetStringLength(*receiveData);
+  size_t idx = 0; // how much of receiveData we've finished with
   // Keep track of how much we received (so we can close once we have it)
-  if (isHttp) {
-    size_t len = (size_t)jsvGetStringLength(*receiveData);
-    if (jsvGetBoolAndUnLock(jsvObjectGetChildIfExists(reader, HTTP_NAME_CHUNKED))) {
-      // check for incomplete chunk, at least "0\r\n\r\n"
-      if (len < 5) return; // incomplete, wait for more data
-
-      JsVar *crlf = jsvNewFromString("\r\n");
-      JsVar *zero = jsvNewFromInteger(0);
-      size_t startIdx = (size_t)jswrap_string_indexOf(*receiveData, crlf, zero, false);
-      jsvUnLock2(crlf, zero);
-
-      JsVar *sixteen = jsvNewFromInteger(16);
-      int chunkLen = jsvGetIntegerAndUnLock(jswrap_parseInt(*receiveData, sixteen));
-      jsvUnLock(sixteen);
-      DBG("D:%d\n", chunkLen);
-
-      // for 'chunked' set the counter to 1 to read on or 0 if at last chunk
-      jsvObjectSetIntChild(reader, HTTP_NAME_RECEIVE_COUNT, chunkLen ? 1 : 0);
-      if (!chunkLen) { // no 'data' callback
-        // clear received data
-        jsvUnLock(*receiveData);
-        *receiveData = 0;
-        return;
-      }
-
-      startIdx += 2; // skip the CRLF
-      size_t nextIdx = startIdx + (size_t)chunkLen + 2; // CRLF at the end
-      if (nextIdx < len) { // there is another chunk in the buffer
-        DBG("D:nextIdx %d %d\n", nextIdx, len);
-        nextChunk = jsvNewFromEmptyString();
-        if (!nextChunk) return; // out of memory
-        jsvAppendStringVar(nextChunk, *receiveData, nextIdx, len-nextIdx);
-      } else if (nextIdx > len) { // chunk not complete
-        DBG("D:partialIdx %d %d %d\n", len - startIdx, nextIdx - len - 2, len);
-        if (nextIdx - len < 3) return; // just CRLF missing, wait
-        // use the data available, write remaining length, wait
-        partialChunk = jsvNewFromEmptyString();
-        if (!partialChunk) return; // out of memory
-        jsvAppendPrintf(partialChunk, "%x\r\n", nextIdx - len - 2);
+  JsVarInt contentToReceive = jsvGetIntegerAndUnLock(jsvObjectGetChildIfExists(reader, HTTP_NAME_RECEIVE_COUNT));
+  bool isChunked = jsvGetBoolAndUnLock(jsvObjectGetChildIfExists(reader, HTTP_NAME_CHUNKED));
+  size_t chunkLeft = isChunked ? (size_t)jsvGetIntegerAndUnLock(jsvObjectGetChildIfExists(reader, HTTP_NAME_CHUNK_LEFT)) : 0;
+  while (idx < len && contentToReceive) {
+    size_t used; // how much of receiveData after idx we're going to finish with
+    size_t dataLen; // how much of that is body data
+    if (isChunked) {
+      if (!chunkLeft) {
+        int chunkLen;
+        int dataIdx = httpParseChunkHeader(*receiveData, idx, &chunkLen);
+        if (dataIdx < 0) break; // incomplete, wait for more data
+        DBG("D:%d\n", chunkLen);
+        idx = (size_t)dataIdx;
+        if (!chunkLen) { // last chunk - ignore any trailers
+          contentToReceive = 0;
+          idx = len;
+          break;
+        }
+        chunkLeft = (size_t)chunkLen + 2; // CRLF at the end
+        continue;
       }
-
-      // FIXME: This often gets called, requesting more data from *receiveData than is available (often nothing is available)
-      JsVar *chunkData = jsvNewFromStringVar(*receiveData, startIdx, (size_t)chunkLen);
-      if (!chunkData) return; // out of memory
-      jsvUnLock(*receiveData);
-      *receiveData = chunkData;
+      used = len - idx;
+      if (used > chunkLeft) used = chunkLeft;
+      dataLen = chunkLeft>2 ? chunkLeft-2 : 0;
+      if (dataLen > used) dataLen = used;
     } else {
-      jsvObjectSetChildAndUnLock(reader, HTTP_NAME_RECEIVE_COUNT,
-        jsvNewFromInteger(
-          jsvGetIntegerAndUnLock(jsvObjectGetChild(reader, HTTP_NAME_RECEIVE_COUNT, JSV_INTEGER)) - (JsVarInt)len)
-        );
+      used = len - idx;
+      if (contentToReceive>0 && used > (size_t)contentToReceive) used = (size_t)contentToReceive;
+      dataLen = used;
+    }
+    if (dataLen) {
+      // execute 'data' callback or save data
+      JsVar *data = (idx==0 && dataLen==len) ? jsvLockAgain(*receiveData) : jsvNewFromStringVar(*receiveData, idx, dataLen);
+      bool pushed = data && jswrap_stream_pushData(reader, data, force);
+      jsvUnLock(data);
+      if (!pushed) break; // try again later
     }
+    idx += used;
+    if (isChunked) chunkLeft -= used;
+    else if (contentToReceive>0) contentToReceive -= (JsVarInt)used;
   }
 
-  // execute 'data' callback or save data
-  if (!jsvIsEmptyString(*receiveData) && !jswrap_stream_pushData(reader, *receiveData, force)) {
-    jsvUnLock2(nextChunk, partialChunk);
-    return;
+  if (!idx) return; // nothing used
+  jsvObjectSetIntChild(reader, HTTP_NAME_RECEIVE_COUNT, contentToReceive);
+  if (isChunked) {
+    if (contentToReceive) jsvObjectSetIntChild(reader, HTTP_NAME_CHUNK_LEFT, (JsVarInt)chunkLeft);
+    else jsvObjectRemoveChild(reader, HTTP_NAME_CHUNK_LEFT);
   }
-
-  // clear received data
+  // remove what we've finished with
+  JsVar *newReceiveData = idx<len ? jsvNewFromStringVar(*receiveData, idx, JSVAPPENDSTRINGVAR_MAXLENGTH) : 0;
   jsvUnLock(*receiveData);
-  *receiveData = nextChunk ? nextChunk : partialChunk;
-
-  if (nextChunk) { // process following chunks if any
-    socketPushReceiveData(reader, receiveData, isHttp, force);
-  }
+  *receiveData = newReceiveData;
 }
 
 void socketReceivedUDP(JsVar *connection, JsVar **receiveData) {
@@ -428,6 +597,15 @@ void socketReceived(JsVar *connection, JsVar *socket, SocketType socketType, JsV
       // on connect only when just parsed the HTTP headers
       if (isServer) {
         JsVar *server = jsvObjectGetChildIfExists(connection,HTTP_NAME_SERVER_VAR);
+        // no longer idle
+        jsvObjectRemoveChild(connection, HTTP_NAME_TIMEOUT);
+        // if the client is happy to, keep the connection open after the response (can be overwritten with setHeader or writeHead)
+        if (httpGetKeepAliveTimeout(server, 0) && httpAllowsKeepAlive(connection)) {
+          JsVar *name = jsvNewFromString("Connection");
+          JsVar *value = jsvNewFromString("keep-alive");
+          serverResponseSetHeader(socket, name, value);
+          jsvUnLock2(name, value);
+        }
         JsVar *args[2] = { connection, socket };
         jsiQueueObjectCallbacks(server, HTTP_NAME_ON_CONNECT, args, isHttp ? 2 : 1);
         jsvUnLock(server);
@@ -486,6 +664,66 @@ static bool fireErrorEvent(int error, JsVar *obj1, JsVar *obj2) {
 
 // -----------------------------
 
+// Create the request and response objects for an HTTP server connection, and return the request
+static JsVar *httpServerRequestNew(JsVar *server, int sckt) {
+  JsVar *req = jspNewObject(0, "httpSRq");
+  JsVar *res = jspNewObject(0, "httpSRs");
+  if (!res || !req) { // out of memory?
+    jsvUnLock2(req, res);
+    return 0;
+  }
+  socketSetType(req, ST_HTTP);
+  jsvObjectSetChild(req, HTTP_NAME_RESPONSE_VAR, res);
+  jsvObjectSetChild(req, HTTP_NAME_SERVER_VAR, server);
+  jsvObjectSetIntChild(req, HTTP_NAME_SOCKET, sckt+1);
+  jsvObjectSetIntChild(res, HTTP_NAME_SOCKET, sckt+1);
+  // Auto-add connection close header (in HTTP/1.0 this seemed implicit, now it must be explicit)
+  // This can always be overwritten with setHeader or writeHead
+  JsVar *name = jsvNewFromString("Connection");
+  JsVar *value = jsvNewFromString("close");
+  serverResponseSetHeader(res, name, value);
+  jsvUnLock3(name, value, res);
+  return req;
+}
+
+/* The response has been sent and the whole request received, so rather than closing
+ * the connection, close the request/response objects and put new ones in their place
+ * (in the connections array at 'it') ready for the next request. Anything after the
+ * request that was already received (eg. a pipelined request) goes to the new request.
+ * Returns false if the connection should be closed instead. */
+static bool httpServerConnectionReuse(JsvObjectIterator *it, JsVar *connection, JsVar *socket) {
+  JsVar *server = jsvObjectGetChildIfExists(connection,HTTP_NAME_SERVER_VAR);
+  int sckt = (int)jsvGetIntegerAndUnLock(jsvObjectGetChildIfExists(connection,HTTP_NAME_SOCKET))-1; // so -1 if undefined
+  JsVarInt timeout = httpGetKeepAliveTimeout(server, 0);
+  JsVar *req = 0;
+  // don't keep the connection if the server has since been closed
+  if (timeout && sckt>=0 && jsvGetIntegerAndUnLock(jsvObjectGetChildIfExists(server,HTTP_NAME_SOCKET)))
+    req = httpServerRequestNew(server, sckt);
+  jsvUnLock(server);
+  if (!req) return false;
+  jsvObjectIteratorSetValue(it, req);
+  socketSetIdleTimeout(req, timeout);
+  // the old request and response are finished with
+  jsvObjectRemoveChild(connection, HTTP_NAME_SOCKET);
+  jsvObjectRemoveChild(socket, HTTP_NAME_SOCKET);
+  JsVar *params[1] = { jsvNewFromBool(false) };
+  jsiQueueObjectCallbacks(connection, HTTP_NAME_ON_CLOSE, params, 1);
+  jsiQueueObjectCallbacks(socket, HTTP_NAME_ON_CLOSE, params, 1);
+  jsvUnLock(params[0]);
+  // handle anything we already have for the next request
+  JsVar *receiveData = jsvObjectGetChildIfExists(connection,HTTP_NAME_RECEIVE_DATA);
+  if (receiveData) {
+    jsvObjectRemoveChild(connection,HTTP_NAME_RECEIVE_DATA);
+    JsVar *res = jsvObjectGetChildIfExists(req,HTTP_NAME_RESPONSE_VAR);
+    socketReceived(req, res, ST_HTTP, &receiveData, true);
+    jsvObjectSetChild(req,HTTP_NAME_RECEIVE_DATA,receiveData);
+    jsvUnLock2(receiveData, res);
+  }
+  jsvUnLock(req);
+  return true;
+}
+
+// returns true if we had sockets (or if net->socketsWakeSleep, only if something happened)
 bool socketServerConnectionsIdle(JsNetwork *net) {
   char *buf = alloca((size_t)net->chunkSize); // allocate on stack
 
@@ -493,6 +731,7 @@ bool socketServerConnectionsIdle(JsNetwork *net) {
   if (!arr) return false;
 
   bool hadSockets = false;
+  bool hadActivity = false; // did we send, receive or close anything?
   JsvObjectIterator it;
   jsvObjectIteratorNew(&it, arr);
   while (jsvObjectIteratorHasValue(&it)) {
@@ -509,28 +748,34 @@ bool socketServerConnectionsIdle(JsNetwork *net) {
     int error = 0;
 
     if (!closeConnectionNow) {
-      int num = netRecv(net, socketType, sckt, buf, (size_t)net->chunkSize);
+      JsVar *receiveData = jsvObjectGetChildIfExists(connection,HTTP_NAME_RECEIVE_DATA);
+      bool hadHeaders = receiveData && jsvGetBoolAndUnLock(jsvObjectGetChildIfExists(connection,HTTP_NAME_HAD_HEADERS));
+      if (hadHeaders) {
+        // push any data that didn't fit in the buffer last time
+        socketPushReceiveData(connection, &receiveData, isHttp, false);
+        jsvObjectSetChild(connection,HTTP_NAME_RECEIVE_DATA,receiveData);
+      }
+      int num = 0;
+      if (!hadHeaders || !socketReceivePaused(net, receiveData))
+        num = socketRecv(net, socketType, sckt, buf, &receiveData);
+      if (num) hadActivity = true;
       if (num<0) {
         // we probably disconnected so just get rid of this
         closeConnectionNow = true;
         error = num;
       } else {
-        if (num>0) {
-          JsVar *receiveData = jsvObjectGetChildIfExists(connection,HTTP_NAME_RECEIVE_DATA);
-          if (!receiveData) receiveData = jsvNewFromEmptyString();
-          if (receiveData) {
-            jsvAppendStringBuf(receiveData, buf, (size_t)num);
-            socketReceived(connection, socket, socketType, &receiveData, true);
-            jsvObjectSetChild(connection,HTTP_NAME_RECEIVE_DATA,receiveData);
-            jsvUnLock(receiveData);
-          }
+        if (num>0 && receiveData) {
+          socketReceived(connection, socket, socketType, &receiveData, true);
+          jsvObjectSetChild(connection,HTTP_NAME_RECEIVE_DATA,receiveData);
         }
       }
+      jsvUnLock(receiveData);
 
       // send data if possible
       JsVar *sendData = jsvObjectGetChildIfExists(socket,HTTP_NAME_SEND_DATA);
       if (sendData && !jsvIsEmptyString(sendData)) {
         int sent = socketSendData(net, socket, sckt, &sendData);
+        if (sent) hadActivity = true;
         // FIXME? checking for errors is a bit iffy. With the esp8266 network that returns
         // varied error codes we'd want to skip SOCKET_ERR_CLOSED and let the recv side deal
         // with normal closing so we don't miss the tail of what's received, but other drivers
@@ -549,12 +794,19 @@ bool socketServerConnectionsIdle(JsNetwork *net) {
           bool hadHeaders = jsvGetBoolAndUnLock(jsvObjectGetChildIfExists(connection,HTTP_NAME_HAD_HEADERS));
           JsVarInt contentToReceive = jsvGetIntegerAndUnLock(jsvObjectGetChildIfExists(connection, HTTP_NAME_RECEIVE_COUNT));
           if (contentToReceive > 0 || !hadHeaders) {
-            reallyCloseNow = false;
+            // we're still waiting for the request - unless it's never going to come
+            reallyCloseNow = !hadHeaders && (num<0 || socketIdleTimedOut(connection));
           } else if (!jsvGetBoolAndUnLock(jsvObjectGetChildIfExists(connection,HTTP_NAME_ENDED))) {
             jsvObjectSetBoolChild(connection, HTTP_NAME_ENDED, true);
             jsiQueueObjectCallbacks(connection, HTTP_NAME_ON_END, NULL, 0);
             DBG("ONEND %d (%d)\n", contentToReceive, reallyCloseNow);
           }
+          if (reallyCloseNow && hadHeaders && !contentToReceive && num==0 &&
+              jsvGetBoolAndUnLock(jsvObjectGetChildIfExists(socket,HTTP_NAME_KEEP_ALIVE)) &&
+              httpServerConnectionReuse(&it, connection, socket)) {
+            hadActivity = true;
+            reallyCloseNow = false;
+          }
         }
         closeConnectionNow = reallyCloseNow;
       } else if (num > 0)
@@ -563,6 +815,7 @@ bool socketServerConnectionsIdle(JsNetwork *net) {
     }
     if (closeConnectionNow) {
       DBG("CLOSE NOW\n");
+      hadActivity = true;
 
       // send out any data that we were POSTed
       bool hadHeaders = jsvGetBoolAndUnLock(jsvObjectGetChildIfExists(connection,HTTP_NAME_HAD_HEADERS));
@@ -597,10 +850,121 @@ bool socketServerConnectionsIdle(JsNetwork *net) {
   jsvObjectIteratorFree(&it);
   jsvUnLock(arr);
 
-  return hadSockets;
+  return net->socketsWakeSleep ? hadActivity : hadSockets;
+}
+
+// Should this HTTP client request's socket be kept for another request once the response is received?
+static bool httpClientKeepAlive(JsVar *connection, JsVar *socket) {
+  JsVar *options = jsvObjectGetChildIfExists(connection, HTTP_NAME_OPTIONS_VAR);
+  bool keepAlive = jsvObjectGetBoolChild(options, "keepAlive") &&
+                   httpGetKeepAliveTimeout(options, HTTP_KEEP_ALIVE_TIMEOUT) &&
+                   httpAllowsKeepAlive(socket);
+  jsvUnLock(options);
+  return keepAlive;
+}
+
+/* Put an HTTP client request's socket in the pool of idle sockets so another
+ * request to the same host and port can use it. Returns false if it couldn't be. */
+static bool socketPoolAdd(JsVar *connection, int sckt) {
+  JsVar *arr = socketGetArray(HTTP_ARRAY_HTTP_CLIENT_POOL, true);
+  JsVar *options = jsvObjectGetChildIfExists(connection, HTTP_NAME_OPTIONS_VAR);
+  JsVar *idle = jsvNewObject();
+  bool ok = arr && options && idle;
+  if (ok) {
+    socketSetType(idle, socketGetType(connection));
+    jsvObjectSetIntChild(idle, HTTP_NAME_SOCKET, sckt+1);
+    jsvObjectSetChildAndUnLock(idle, "host", jsvObjectGetChildIfExists(options, "host"));
+    jsvObjectSetIntChild(idle, HTTP_NAME_PORT, jsvObjectGetIntegerChild(options, "port"));
+    socketSetIdleTimeout(idle, httpGetKeepAliveTimeout(options, HTTP_KEEP_ALIVE_TIMEOUT));
+    jsvArrayPush(arr, idle);
+    // the request no longer owns the socket
+    jsvObjectRemoveChild(connection, HTTP_NAME_SOCKET);
+    jsvObjectSetBoolChild(connection, HTTP_NAME_CONNECTED, false);
+    jsvObjectSetBoolChild(connection, HTTP_NAME_CLOSE, true);
+  }
+  jsvUnLock3(arr, options, idle);
+  return ok;
+}
+
+// Take an idle socket for the host/port in 'options' out of the pool, or return -1
+static int socketPoolTake(SocketType socketType, JsVar *options) {
+  JsVar *arr = socketGetArray(HTTP_ARRAY_HTTP_CLIENT_POOL, false);
+  if (!arr) return -1;
+  JsVar *host = jsvObjectGetChildIfExists(options, "host");
+  JsVarInt port = jsvObjectGetIntegerChild(options, "port");
+  int sckt = -1;
+  JsvObjectIterator it;
+  jsvObjectIteratorNew(&it, arr);
+  while (sckt<0 && jsvObjectIteratorHasValue(&it)) {
+    JsVar *idle = jsvObjectIteratorGetValue(&it);
+    JsVar *idleHost = jsvObjectGetChildIfExists(idle, "host");
+    if (socketGetType(idle)==socketType &&
+        jsvObjectGetIntegerChild(idle, HTTP_NAME_PORT)==port &&
+        (host ? jsvIsBasic(host) && jsvIsBasicVarEqual(idleHost, host) : !idleHost)) {
+      sckt = (int)jsvGetIntegerAndUnLock(jsvObjectGetChildIfExists(idle,HTTP_NAME_SOCKET))-1;
+      jsvObjectIteratorRemoveAndGotoNext(&it, arr);
+    } else
+      jsvObjectIteratorNext(&it);
+    jsvUnLock2(idle, idleHost);
+  }
+  jsvObjectIteratorFree(&it);
+  jsvUnLock2(host, arr);
+  return sckt;
 }
 
+static void clientRequestConnectSocket(JsNetwork *net, JsVar *httpClientReqVar, bool usePool);
+
+/* If this HTTP client request went out on a socket from the pool and nothing has been received yet,
+ * the server may have closed the socket just as we reused it. If so close it, and send the request
+ * again on a new socket. We only do this once. Returns true if we did */
+static bool httpClientRetry(JsNetwork *net, JsVar *connection, int sckt) {
+  JsVar *retryData = jsvObjectGetChildIfExists(connection, HTTP_NAME_RETRY_DATA);
+  if (!retryData) return false;
+  DBG("retry on new socket\n");
+  jsvObjectRemoveChild(connection, HTTP_NAME_RETRY_DATA);
+  netCloseSocket(net, socketGetType(connection), sckt);
+  jsvObjectRemoveChild(connection, HTTP_NAME_SOCKET);
+  // send everything again, followed by whatever we hadn't sent yet
+  JsVar *sendData = jsvObjectGetChildIfExists(connection, HTTP_NAME_SEND_DATA);
+  if (sendData) {
+    size_t offset = (size_t)jsvGetIntegerAndUnLock(jsvObjectGetChildIfExists(connection, HTTP_NAME_SEND_OFFSET));
+    jsvAppendStringVar(retryData, sendData, offset, JSVAPPENDSTRINGVAR_MAXLENGTH);
+  }
+  jsvObjectRemoveChild(connection, HTTP_NAME_SEND_OFFSET);
+  jsvObjectSetChild(connection, HTTP_NAME_SEND_DATA, retryData);
+  jsvUnLock2(sendData, retryData);
+  clientRequestConnectSocket(net, connection, false/*new socket*/);
+  return jsvGetIntegerAndUnLock(jsvObjectGetChildIfExists(connection, HTTP_NAME_SOCKET))>0;
+}
 
+// Close any pooled sockets that have timed out or been closed by the server. Returns true if we had sockets (or if net->socketsWakeSleep, only if something happened)
+static bool socketPoolIdle(JsNetwork *net) {
+  JsVar *arr = socketGetArray(HTTP_ARRAY_HTTP_CLIENT_POOL, false);
+  if (!arr) return false;
+  bool hadSockets = false;
+  bool hadActivity = false;
+  JsvObjectIterator it;
+  jsvObjectIteratorNew(&it, arr);
+  while (jsvObjectIteratorHasValue(&it)) {
+    hadSockets = true;
+    JsVar *idle = jsvObjectIteratorGetValue(&it);
+    int sckt = (int)jsvGetIntegerAndUnLock(jsvObjectGetChildIfExists(idle,HTTP_NAME_SOCKET))-1; // so -1 if undefined
+    char ch;
+    // we shouldn't get any data, so if we do (or the socket closed) just close it
+    if (socketIdleTimedOut(idle) || netRecv(net, socketGetType(idle), sckt, &ch, 1)!=0) {
+      hadActivity = true;
+      _socketConnectionKill(net, idle);
+      jsvObjectIteratorRemoveAndGotoNext(&it, arr);
+    } else
+      jsvObjectIteratorNext(&it);
+    jsvUnLock(idle);
+  }
+  jsvObjectIteratorFree(&it);
+  jsvUnLock(arr);
+  return net->socketsWakeSleep ? hadActivity : hadSockets;
+}
+
+// returns true if we had sockets (or if net->socketsWakeSleep, only if something happened)
 bool socketClientConnectionsIdle(JsNetwork *net) {
   char *buf = alloca((size_t)net->chunkSize); // allocate on stack
 
@@ -608,6 +972,7 @@ bool socketClientConnectionsIdle(JsNetwork *net) {
   if (!arr) return false;
 
   bool hadSockets = false;
+  bool hadActivity = false; // did we send, receive, connect or close anything?
   JsvObjectIterator it;
   jsvObjectIteratorNew(&it, arr);
   while (jsvObjectIteratorHasValue(&it)) {
@@ -622,6 +987,7 @@ bool socketClientConnectionsIdle(JsNetwork *net) {
     JsVar *receiveData = 0;
 
     bool hadHeaders = false;
+    bool keepSocket = false; // the response is complete and we can reuse the socket
     int error = 0; // error code received from netXxxx functions
     bool closeConnectionNow = jsvGetBoolAndUnLock(jsvObjectGetChildIfExists(connection, HTTP_NAME_CLOSENOW));
     bool alreadyConnected = jsvGetBoolAndUnLock(jsvObjectGetChildIfExists(connection, HTTP_NAME_CONNECTED));
@@ -645,7 +1011,15 @@ bool socketClientConnectionsIdle(JsNetwork *net) {
           // don't try to send if we're already in error state
           int num = 0;
           if (error == 0) {
+              // on a pooled socket, keep a copy of what we send in case we have to send it again (see httpClientRetry)
+              JsVar *retryData = jsvObjectGetChildIfExists(connection, HTTP_NAME_RETRY_DATA);
+              JsVar *sentData = retryData ? jsvLockAgain(sendData) : 0;
+              size_t sentFrom = retryData ? (size_t)jsvGetIntegerAndUnLock(jsvObjectGetChildIfExists(connection, HTTP_NAME_SEND_OFFSET)) : 0;
               num = socketSendData(net, connection, sckt, &sendData);
+              if (num > 0 && retryData)
+                jsvAppendStringVar(retryData, sentData, sentFrom, (size_t)num);
+              jsvUnLock2(retryData, sentData);
+              if (num) hadActivity = true;
           }
           if (num > 0 && !alreadyConnected && !isHttp) { // whoa, we sent something, must be connected!
             jsiQueueObjectCallbacks(connection, HTTP_NAME_ON_CONNECT, &connection, 1);
@@ -670,13 +1044,17 @@ bool socketClientConnectionsIdle(JsNetwork *net) {
               jsiQueueObjectCallbacks(socket, HTTP_NAME_ON_END, NULL, 0);
               DBG("onEnd %d (%d) %d\n", contentToReceive, closeConnectionNow, hadHeaders);
             }
+            keepSocket = closeConnectionNow && !contentToReceive && httpClientKeepAlive(connection, socket);
           }
         }
         // Now read data if possible (and we have space for it)
-        int num = netRecv(net, socketType, sckt, buf, (size_t)net->chunkSize);
+        int num = 0;
+        if (!keepSocket && (!hadHeaders || !socketReceivePaused(net, receiveData)))
+          num = socketRecv(net, socketType, sckt, buf, &receiveData);
         if (!alreadyConnected && num == SOCKET_ERR_NO_CONN) {
           ; // ignore... it's just telling us we're not connected yet
         } else if (num < 0) {
+          hadActivity = true;
           closeConnectionNow = true;
           // only error out when the response was not completely received
           if (num == SOCKET_ERR_CLOSED) {
@@ -695,16 +1073,16 @@ bool socketClientConnectionsIdle(JsNetwork *net) {
             jsiQueueObjectCallbacks(connection, HTTP_NAME_ON_CONNECT, &connection, 1);
             jsvObjectSetBoolChild(connection, HTTP_NAME_CONNECTED, true);
             alreadyConnected = true;
+            hadActivity = true;
             // if we do not have any data to send, issue a drain event
             if (!sendData || jsvIsEmptyString(sendData))
               jsiQueueObjectCallbacks(connection, HTTP_NAME_ON_DRAIN, &connection, 1);
           }
           // got data add it to our receive buffer
           if (num > 0) {
-            if (!receiveData)
-              receiveData = jsvNewFromEmptyString();
+            hadActivity = true;
+            jsvObjectRemoveChild(connection, HTTP_NAME_RETRY_DATA); // the socket works, so we won't need to retry
             if (receiveData) { // could be out of memory
-              jsvAppendStringBuf(receiveData, buf, (size_t)num);
               socketReceived(connection, socket, socketType, &receiveData, false);
               jsvObjectSetChild(connection, HTTP_NAME_RECEIVE_DATA, receiveData);
             }
@@ -712,10 +1090,15 @@ bool socketClientConnectionsIdle(JsNetwork *net) {
         }
         jsvUnLock(sendData);
       }
+      if (closeConnectionNow && error < 0 && httpClientRetry(net, connection, sckt)) {
+        closeConnectionNow = false;
+        hadActivity = true;
+      }
     }
 
     if (closeConnectionNow) {
       DBG("close now\n");
+      hadActivity = true;
 
       socketPushReceiveData(socket, &receiveData, isHttp, true);
       if (!receiveData || jsvIsEmptyString(receiveData)) {
@@ -725,7 +1108,8 @@ bool socketClientConnectionsIdle(JsNetwork *net) {
           error = SOCKET_ERR_UNSENT_DATA;
         jsvUnLock(sendData);
 
-        _socketConnectionKill(net, connection);
+        if (!keepSocket || !socketPoolAdd(connection, sckt))
+          _socketConnectionKill(net, connection);
         JsVar *connectionName = jsvObjectIteratorGetKey(&it);
         jsvObjectIteratorNext(&it);
         jsvRemoveChildAndUnLock(arr, connectionName);
@@ -756,7 +1140,7 @@ bool socketClientConnectionsIdle(JsNetwork *net) {
   }
   jsvUnLock(arr);
 
-  return hadSockets;
+  return net->socketsWakeSleep ? hadActivity : hadSockets;
 }
 
 // return true if we should *not* sleep
@@ -767,6 +1151,7 @@ bool socketIdle(JsNetwork *net) {
     return false;
   }
   bool hadSockets = false;
+  bool hadActivity = false; // did we accept a new connection?
   JsVar *arr = socketGetArray(HTTP_ARRAY_HTTP_SERVERS,false);
   if (arr) {
     JsvObjectIterator it;
@@ -784,28 +1169,17 @@ bool socketIdle(JsNetwork *net) {
           theClient = netAccept(net, sckt);
       }
       if (theClient >= 0) { // We have a new connection
+        hadActivity = true;
         if ((socketType&ST_TYPE_MASK) == ST_HTTP) {
-          JsVar *req = jspNewObject(0, "httpSRq");
-          JsVar *res = jspNewObject(0, "httpSRs");
-          if (res && req) { // out of memory?
-            socketSetType(req, ST_HTTP);
+          JsVar *req = httpServerRequestNew(server, theClient);
+          if (req) { // out of memory?
             JsVar *arr = socketGetArray(HTTP_ARRAY_HTTP_SERVER_CONNECTIONS, true);
             if (arr) {
               jsvArrayPush(arr, req);
               jsvUnLock(arr);
             }
-            jsvObjectSetChild(req, HTTP_NAME_RESPONSE_VAR, res);
-            jsvObjectSetChild(req, HTTP_NAME_SERVER_VAR, server);
-            jsvObjectSetIntChild(req, HTTP_NAME_SOCKET, theClient+1);
-            jsvObjectSetIntChild(res, HTTP_NAME_SOCKET, theClient+1);
-            // Auto-add connection close header (in HTTP/1.0 this seemed implicit, now it must be explicit)
-            // This can always be overwritten with setHeader or writeHead
-            JsVar *name = jsvNewFromString("Connection");
-            JsVar *value = jsvNewFromString("close");
-            serverResponseSetHeader(res, name, value);
-            jsvUnLock2(name, value);
+            jsvUnLock(req);
           }
-          jsvUnLock2(req, res);
         } else {
           // Normal sockets
           JsVar *sock = jspNewObject(0, "Socket");
@@ -830,8 +1204,11 @@ bool socketIdle(JsNetwork *net) {
     jsvUnLock(arr);
   }
 
+  if (net->socketsWakeSleep) hadSockets = hadActivity; // we'll be woken up when a socket is ready
+  socketNextTimeout = 0; // worked out again as we go through the connections
   if (socketServerConnectionsIdle(net)) hadSockets = true;
   if (socketClientConnectionsIdle(net)) hadSockets = true;
+  if (socketPoolIdle(net)) hadSockets = true;
   netCheckError(net);
   return hadSockets;
 }
@@ -900,6 +1277,23 @@ void serverClose(JsNetwork *net, JsVar *server) {
       jsWarn("Server not found!");
     jsvUnLock(arr);
   }
+  // close any kept-alive connections that are waiting for a new request
+  arr = socketGetArray(HTTP_ARRAY_HTTP_SERVER_CONNECTIONS,false);
+  if (arr) {
+    JsvObjectIterator it;
+    jsvObjectIteratorNew(&it, arr);
+    while (jsvObjectIteratorHasValue(&it)) {
+      JsVar *connection = jsvObjectIteratorGetValue(&it);
+      JsVar *connectionServer = jsvObjectGetChildIfExists(connection,HTTP_NAME_SERVER_VAR);
+      JsVar *timeout = jsvObjectGetChildIfExists(connection,HTTP_NAME_TIMEOUT);
+      if (connectionServer==server && timeout)
+        jsvObjectSetBoolChild(connection, HTTP_NAME_CLOSENOW, true);
+      jsvUnLock3(connection, connectionServer, timeout);
+      jsvObjectIteratorNext(&it);
+    }
+    jsvObjectIteratorFree(&it);
+    jsvUnLock(arr);
+  }
 }
 
 
@@ -949,7 +1343,8 @@ void clientRequestWrite(JsNetwork *net, JsVar *httpClientReqVar, JsVar *data, Js
       // We're an HTTP client - make a header
       JsVar *method = jsvObjectGetChildIfExists(options, "method");
       JsVar *path = jsvObjectGetChildIfExists(options, "path");
-      sendData = jsvVarPrintf("%v %v HTTP/1.1\r\nUser-Agent: Espruino "JS_VERSION"\r\nConnection: close\r\n", method, path);
+      bool keepAlive = jsvObjectGetBoolChild(options, "keepAlive");
+      sendData = jsvVarPrintf("%v %v HTTP/1.1\r\nUser-Agent: Espruino "JS_VERSION"\r\nConnection: %s\r\n", method, path, keepAlive ? "keep-alive" : "close");
       jsvUnLock2(method, path);
       JsVar *headers = jsvObjectGetChildIfExists(options, HTTP_NAME_HEADERS);
       bool hasHostHeader = false;
@@ -987,21 +1382,28 @@ void clientRequestWrite(JsNetwork *net, JsVar *httpClientReqVar, JsVar *data, Js
     // append the data to what we want to send
     JsVar *s = jsvAsString(data);
     if (s) {
-      if (jsvGetBoolAndUnLock(jsvObjectGetChildIfExists(httpClientReqVar, HTTP_NAME_CHUNKED))) {
-        // If we asked to send 'chunked' data, we need to wrap it up,
-        // prefixed with the length
-        jsvAppendPrintf(sendData, "%x\r\n%v\r\n", jsvGetStringLength(s), s);
-      } else {
-        if ((socketType&ST_TYPE_MASK) == ST_UDP) {
-          char hostName[128];
-          jsvGetString(host, hostName, sizeof(hostName));
-          JsNetUDPPacketHeader header;
-          networkGetHostByName(net, hostName, (uint32_t*)&header.host);
-          header.port = portNumber;
-          header.length = (uint16_t)jsvGetStringLength(s);
-          jsvAppendStringBuf(sendData, (const char*)&header, sizeof(header));
+      bool isChunked = jsvGetBoolAndUnLock(jsvObjectGetChildIfExists(httpClientReqVar, HTTP_NAME_CHUNKED));
+      if (!isChunked && (socketType&ST_TYPE_MASK) != ST_UDP &&
+          jsvIsEmptyString(sendData) && !jsvHasStringExt(s)) {
+        // nothing waiting to send and this is a flat/native string - just send straight from it
+        jsvObjectSetChild(httpClientReqVar, HTTP_NAME_SEND_DATA, s);
+      } else if ((sendData = socketGetSendDataForAppend(httpClientReqVar, sendData))) {
+        if (isChunked) {
+          // If we asked to send 'chunked' data, we need to wrap it up,
+          // prefixed with the length
+          jsvAppendPrintf(sendData, "%x\r\n%v\r\n", jsvGetStringLength(s), s);
+        } else {
+          if ((socketType&ST_TYPE_MASK) == ST_UDP) {
+            char hostName[128];
+            jsvGetString(host, hostName, sizeof(hostName));
+            JsNetUDPPacketHeader header;
+            networkGetHostByName(net, hostName, (uint32_t*)&header.host);
+            header.port = portNumber;
+            header.length = (uint16_t)jsvGetStringLength(s);
+            jsvAppendStringBuf(sendData, (const char*)&header, sizeof(header));
+          }
+          jsvAppendStringVarComplete(sendData,s);
         }
-        jsvAppendStringVarComplete(sendData,s);
       }
       jsvUnLock(s);
     }
@@ -1015,6 +1417,11 @@ void clientRequestWrite(JsNetwork *net, JsVar *httpClientReqVar, JsVar *data, Js
 
 // Connect this connection/socket
 void clientRequestConnect(JsNetwork *net, JsVar *httpClientReqVar) {
+  clientRequestConnectSocket(net, httpClientReqVar, true);
+}
+
+// Connect this connection/socket - if usePool, an idle kept-alive socket to the same place can be used
+static void clientRequestConnectSocket(JsNetwork *net, JsVar *httpClientReqVar, bool usePool) {
   DBG("clientRequestConnect\n");
   // Have we already connected? If so, don't go further
   if (jsvGetIntegerAndUnLock(jsvObjectGetChildIfExists(httpClientReqVar, HTTP_NAME_SOCKET))>0)
@@ -1023,6 +1430,16 @@ void clientRequestConnect(JsNetwork *net, JsVar *httpClientReqVar) {
   SocketType socketType = socketGetType(httpClientReqVar);
 
   JsVar *options = jsvObjectGetChildIfExists(httpClientReqVar, HTTP_NAME_OPTIONS_VAR);
+  if (usePool && (socketType&ST_TYPE_MASK) == ST_HTTP) {
+    // If we have a kept-alive connection to the same place, use that
+    int sckt = socketPoolTake(socketType, options);
+    if (sckt>=0) {
+      jsvObjectSetIntChild(httpClientReqVar, HTTP_NAME_SOCKET, sckt+1);
+      jsvObjectSetChildAndUnLock(httpClientReqVar, HTTP_NAME_RETRY_DATA, jsvNewFromEmptyString());
+      jsvUnLock(options);
+      return;
+    }
+  }
   unsigned short port = (unsigned short)jsvObjectGetIntegerChild(options, "port");
 
   uint32_t host_addr = 0;
@@ -1128,11 +1545,25 @@ void serverResponseWriteHead(JsVar *httpServerResponseVar, int statusCode, JsVar
 
   sendData = jsvVarPrintf("HTTP/1.1 %d OK\r\nServer: Espruino "JS_VERSION"\r\n", statusCode);
   if (headers) {
-    httpAppendHeaders(sendData, headers);
     // if Transfer-Encoding:chunked was set, subsequent writes need to 'chunk' the data that is sent
-    if (compareTransferEncodingAndUnlock(jsvObjectGetChildI(headers, "Transfer-Encoding"), "chunked")) {
+    bool isChunked = compareTransferEncodingAndUnlock(jsvObjectGetChildI(headers, "Transfer-Encoding"), "chunked");
+    if (isChunked)
       jsvObjectSetBoolChild(httpServerResponseVar, HTTP_NAME_CHUNKED, true);
+    // we can only keep the connection open if the client can tell where the response ends
+    JsVar *connection = jsvFindChildFromStringI(headers, "Connection");
+    if (connection && jsvIsStringIEqualAndUnLock(jsvSkipName(connection), "keep-alive")) {
+      JsVar *contentLength = jsvObjectGetChildI(headers, "Content-Length");
+      if (isChunked || contentLength)
+        jsvObjectSetBoolChild(httpServerResponseVar, HTTP_NAME_KEEP_ALIVE, true);
+      else {
+        JsVar *close = jsvNewFromString("close");
+        jsvSetValueOfName(connection, close);
+        jsvUnLock(close);
+      }
+      jsvUnLock(contentLength);
     }
+    jsvUnLock(connection);
+    httpAppendHeaders(sendData, headers);
   }
   jsvUnLock(headers);
   // finally add ending newline
@@ -1159,12 +1590,18 @@ void serverResponseWrite(JsVar *httpServerResponseVar, JsVar *data) {
   if (sendData && !jsvIsUndefined(data)) {
     JsVar *s = jsvAsString(data);
     if (s) {
-      if (jsvGetBoolAndUnLock(jsvObjectGetChildIfExists(httpServerResponseVar, HTTP_NAME_CHUNKED))) {
-        // If we asked to send 'chunked' data, we need to wrap it up,
-        // prefixed with the length
-        jsvAppendPrintf(sendData, "%x\r\n%v\r\n", jsvGetStringLength(s), s);
-      } else {
-        jsvAppendStringVarComplete(sendData,s);
+      bool isChunked = jsvGetBoolAndUnLock(jsvObjectGetChildIfExists(httpServerResponseVar, HTTP_NAME_CHUNKED));
+      if (!isChunked && jsvIsEmptyString(sendData) && !jsvHasStringExt(s)) {
+        // nothing waiting to send and this is a flat/native string - just send straight from it
+        jsvObjectSetChild(httpServerResponseVar, HTTP_NAME_SEND_DATA, s);
+      } else if ((sendData = socketGetSendDataForAppend(httpServerResponseVar, sendData))) {
+        if (isChunked) {
+          // If we asked to send 'chunked' data, we need to wrap it up,
+          // prefixed with the length
+          jsvAppendPrintf(sendData, "%x\r\n%v\r\n", jsvGetStringLength(s), s);
+        } else {
+          jsvAppendStringVarComplete(sendData,s);
+        }
       }
     }
     jsvUnLock(s);
@@ -23,6 +23,7 @@
 void socketInit();
 void socketKill(JsNetwork *net);
 bool socketIdle(JsNetwork *net);
+JsSysTime socketGetNextTimeout(); ///< System time at which an idle keep-alive connection will time out, or 0 if there are none
 
 // -----------------------------
 JsVar *serverNew(SocketType socketType, JsVar *callback);
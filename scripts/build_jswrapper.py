@@ -199,6 +199,65 @@ def getCDeclaration(jsondata, name):
     s.append(toCType(param[1]));
   return toCType(result[0])+" "+name+"("+",".join(s)+")";
 
+# ------------------------------------------------------------------------------------------------------
+# Perfect hashing of symbol names, so we can find a symbol with one string compare.
+# symbolHash/symbolHashSlot must match jswHashString/jswHashFind in the generated C code
+
+def symbolHash(name):
+  h = 2166136261 # FNV-1a
+  for c in name.encode('latin-1'):
+    h = ((h ^ c) * 16777619) & 0xFFFFFFFF
+  return h
+
+def symbolHashSlot(h, seed, slotCount):
+  x = (h ^ (seed * 0x9E3779B1)) & 0xFFFFFFFF
+  x = x ^ (x >> 16)
+  x = (x * 0x85EBCA6B) & 0xFFFFFFFF
+  x = x ^ (x >> 13)
+  return x % slotCount
+
+# Build a 'hash and displace' perfect hash for the list of names. Each name's hash
+# picks a bucket, and each bucket has a seed chosen so that all names in it land in
+# different empty slots. Returns the bytes of the table:
+#   bucketCount, slotCount&255, slotCount>>8, seed[bucketCount], nameIndex[slotCount] (255 = empty)
+def buildSymbolHash(names):
+  if len(names)>=255:
+    FATAL_ERROR("Too many names ("+str(len(names))+") for a symbol hash table")
+  hashes = [symbolHash(name) for name in names]
+  if len(set(hashes))!=len(hashes):
+    FATAL_ERROR("Symbol hash collision in "+str(names))
+  bucketCount = max(1, (len(names)+3)//4)
+  slotCount = max(1, len(names) + len(names)//4)
+  while True:
+    buckets = [[] for b in range(bucketCount)]
+    for i in range(len(hashes)):
+      buckets[hashes[i] % bucketCount].append(i)
+    seeds = [0] * bucketCount
+    slots = [255] * slotCount
+    ok = True
+    # place the biggest buckets first while there's still lots of space
+    for b in sorted(range(bucketCount), key=lambda b: -len(buckets[b])):
+      if not buckets[b]: continue
+      found = False
+      for seed in range(256):
+        s = [symbolHashSlot(hashes[i], seed, slotCount) for i in buckets[b]]
+        if len(set(s))==len(s) and all(slots[x]==255 for x in s):
+          found = True
+          break
+      if not found:
+        ok = False
+        break
+      seeds[b] = seed
+      for i,x in zip(buckets[b], s):
+        slots[x] = i
+    if ok:
+      return [bucketCount, slotCount&255, slotCount>>8] + seeds + slots
+    slotCount = slotCount + 1 + slotCount//8 # couldn't fit - try with more slots
+
+def codeOutSymbolHash(codeName, names):
+  table = buildSymbolHash(names)
+  codeOut("static const unsigned char "+codeName+"[] FLASH_SECT = {"+",".join([str(x) for x in table])+"};");
+
 def codeOutSymbolTable(builtin):
   codeName = builtin["name"]
   # sort by name
@@ -229,6 +288,9 @@ def codeOutSymbolTable(builtin):
   builtin["symbolTableChars"] = "\""+listChars+"\"";
   builtin["symbolTableCount"] = str(len(listSymbols));
   codeOut("static const JswSymPtr jswSymbols_"+codeName+"[] FLASH_SECT = {\n  "+",\n  ".join(listSymbols)+"\n};");
+  codeOut("#ifndef ESPR_NO_SYMBOL_HASH");
+  codeOutSymbolHash("jswSymbolHash_"+codeName, listCharItems);
+  codeOut("#endif");
 
 def codeOutBuiltins(indent, builtin):
   codeOut(indent+"jswBinarySearch(&jswSymbolTables["+builtin["indexName"]+"], parent, name);");
@@ -425,9 +487,48 @@ codeOut('');
 # (where unaligned reads broke) but despite being packed, the structure JswSymPtr is still always an multiple
 # of 2 in length so they will always be halfword aligned.
 codeOut("""
-// Binary search coded to allow for JswSyms to be in flash on the esp8266 where they require
-// word accesses
+#ifndef ESPR_NO_SYMBOL_HASH
+/// Hash a symbol name (FNV-1a) - this must match symbolHash in build_jswrapper.py
+static uint32_t jswHashString(const char *s) {
+  uint32_t h = 2166136261U;
+  while (*s) h = (h ^ (unsigned char)*(s++)) * 16777619U;
+  return h;
+}
+
+/** Use a perfect hash table created by build_jswrapper.py to find the index of the only
+ * string that name could be, or -1 if it can't be any of them. The caller must still check
+ * that the string matches. This must match symbolHashSlot in build_jswrapper.py */
+static int jswHashFind(const unsigned char *hashTable, const char *name) {
+  unsigned int bucketCount = READ_FLASH_UINT8(&hashTable[0]);
+  unsigned int slotCount = READ_FLASH_UINT8(&hashTable[1]) | (READ_FLASH_UINT8(&hashTable[2])<<8);
+  uint32_t h = jswHashString(name);
+  uint32_t x = h ^ (READ_FLASH_UINT8(&hashTable[3 + h%bucketCount]) * 0x9E3779B1U);
+  x ^= x >> 16;
+  x *= 0x85EBCA6BU;
+  x ^= x >> 13;
+  unsigned int idx = READ_FLASH_UINT8(&hashTable[3 + bucketCount + x%slotCount]);
+  return (idx==255) ? -1 : (int)idx;
+}
+#endif
+
+/// Return the value of the given symbol - either a native function, or the result of calling it if it's a property
+static JsVar *jswGetSymbolValue(const JswSymPtr *sym, JsVar *parent) {
+  unsigned short functionSpec = READ_FLASH_UINT16(&sym->functionSpec);
+  if ((functionSpec & JSWAT_EXECUTE_IMMEDIATELY_MASK) == JSWAT_EXECUTE_IMMEDIATELY)
+    return jsnCallFunction(JSWSYMPTR_FUNCTION_PTR(sym), functionSpec, parent, 0, 0);
+  return jsvNewNativeFunction(JSWSYMPTR_FUNCTION_PTR(sym), functionSpec);
+}
+
+// Search coded to allow for JswSyms to be in flash on the esp8266 where they require
+// word accesses. Uses the perfect hash if we have one, or a binary search if not
 JsVar *jswBinarySearch(const JswSymList *symbolsPtr, JsVar *parent, const char *name) {
+#ifndef ESPR_NO_SYMBOL_HASH
+  int idx = jswHashFind(symbolsPtr->symbolHash, name);
+  if (idx<0) return 0;
+  const JswSymPtr *sym = &symbolsPtr->symbols[idx];
+  if (FLASH_STRCMP(name, &symbolsPtr->symbolChars[JSWSYMPTR_OFFSET(sym)])) return 0;
+  return jswGetSymbolValue(sym, parent);
+#else
   uint8_t symbolCount = READ_FLASH_UINT8(&symbolsPtr->symbolCount);
   int searchMin = 0;
   int searchMax = symbolCount - 1;
@@ -436,10 +537,7 @@ JsVar *jswBinarySearch(const JswSymList *symbolsPtr, JsVar *parent, const char *
     const JswSymPtr *sym = &symbolsPtr->symbols[idx];
     int cmp = FLASH_STRCMP(name, &symbolsPtr->symbolChars[JSWSYMPTR_OFFSET(sym)]);
     if (cmp==0) {
-      unsigned short functionSpec = READ_FLASH_UINT16(&sym->functionSpec);
-      if ((functionSpec & JSWAT_EXECUTE_IMMEDIATELY_MASK) == JSWAT_EXECUTE_IMMEDIATELY)
-        return jsnCallFunction(JSWSYMPTR_FUNCTION_PTR(sym), functionSpec, parent, 0, 0);
-      return jsvNewNativeFunction(JSWSYMPTR_FUNCTION_PTR(sym), functionSpec);
+      return jswGetSymbolValue(sym, parent);
     } else {
       if (cmp<0) {
         // searchMin is the same
@@ -451,6 +549,7 @@ JsVar *jswBinarySearch(const JswSymList *symbolsPtr, JsVar *parent, const char *
     }
   }
   return 0;
+#endif
 }
 
 """);
@@ -518,7 +617,7 @@ codeOut('');
 codeOut('const JswSymList jswSymbolTables[] FLASH_SECT = {');
 for b in builtins:
   builtin = builtins[b]
-  codeOut("  {"+", ".join(["jswSymbols_"+builtin["name"], "jswSymbols_"+builtin["name"]+"_str", builtin["symbolTableCount"]])+"},");
+  codeOut("  {"+", ".join(["jswSymbols_"+builtin["name"], "jswSymbols_"+builtin["name"]+"_str", "JSWSYMLIST_HASH(jswSymbolHash_"+builtin["name"]+") "+builtin["symbolTableCount"]])+"},");
 codeOut('};');
 
 codeOut('');
@@ -648,23 +747,51 @@ for jsondata in jsondatas:
         builtinObjectNames.append(builtinObjectName)
 
 
+builtinObjectOffsets = []
+strLen = 0
+for name in builtinObjectNames:
+  builtinObjectOffsets.append(str(strLen))
+  strLen = strLen + len(name) + 1
+codeOut('static const char jswBuiltInObjectNames[] = "'+"\\0".join(builtinObjectNames)+'\\0";')
+codeOut('#ifndef ESPR_NO_SYMBOL_HASH')
+codeOut('static const unsigned short jswBuiltInObjectOffsets[] FLASH_SECT = {'+",".join(builtinObjectOffsets)+'};')
+codeOutSymbolHash("jswBuiltInObjectHash", builtinObjectNames)
+codeOut('#endif')
+codeOut('')
 codeOut('bool jswIsBuiltInObject(const char *name) {')
-codeOut('  const char *objNames = "'+"\\0".join(builtinObjectNames)+'\\0";')
-codeOut('  const char *s = objNames;')
+codeOut('#ifndef ESPR_NO_SYMBOL_HASH')
+codeOut('  int idx = jswHashFind(jswBuiltInObjectHash, name);')
+codeOut('  return idx>=0 && strcmp(&jswBuiltInObjectNames[READ_FLASH_UINT16(&jswBuiltInObjectOffsets[idx])], name)==0;')
+codeOut('#else')
+codeOut('  const char *s = jswBuiltInObjectNames;')
 codeOut('  while (*s) {')
-codeOut('    if (strcmp(s, name)==0) return true;') # OPT: I bet we could do this faster if not using strcmp, but it probably doesn't matter
+codeOut('    if (strcmp(s, name)==0) return true;')
 codeOut('    s+=strlen(s)+1;')
 codeOut('  }')
 codeOut('  return false;')
+codeOut('#endif')
 codeOut('}')
 
 codeOut('')
 codeOut('')
 
 
+if libraries:
+  codeOut('#ifndef ESPR_NO_SYMBOL_HASH')
+  codeOut('static const char *const jswBuiltInLibraryNames[] FLASH_SECT = {'+",".join(['"'+lib+'"' for lib in libraries])+'};')
+  codeOut('static void *const jswBuiltInLibraries[] FLASH_SECT = {'+",".join(['(void*)gen_jswrap_'+lib+'_'+lib for lib in libraries])+'};')
+  codeOutSymbolHash("jswBuiltInLibraryHash", libraries)
+  codeOut('#endif')
+  codeOut('')
 codeOut('void *jswGetBuiltInLibrary(const char *name) {')
-for lib in libraries:
-  codeOut('  if (strcmp(name, "'+lib+'")==0) return (void*)gen_jswrap_'+lib+'_'+lib+';');
+if libraries:
+  codeOut('#ifndef ESPR_NO_SYMBOL_HASH')
+  codeOut('  int idx = jswHashFind(jswBuiltInLibraryHash, name);')
+  codeOut('  if (idx>=0 && strcmp(jswBuiltInLibraryNames[idx], name)==0) return jswBuiltInLibraries[idx];')
+  codeOut('#else')
+  for lib in libraries:
+    codeOut('  if (strcmp(name, "'+lib+'")==0) return (void*)gen_jswrap_'+lib+'_'+lib+';');
+  codeOut('#endif')
 codeOut('  return 0;')
 codeOut('}')
 
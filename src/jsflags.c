@@ -41,6 +41,9 @@ JsVar *jsfGetFlags() {
    p += strlen(p)+1;
    flag<<=1;
  }
+#ifndef ESPR_NO_INCREMENTAL_GC
+ jsvObjectSetChildAndUnLock(o, "gcBudget", jsvNewFromFloat(jsvGarbageCollectGetBudget()));
+#endif
  return o;
 }
 
@@ -55,4 +58,8 @@ void jsfSetFlags(JsVar *flags) {
     p += strlen(p)+1;
     flag<<=1;
   }
+#ifndef ESPR_NO_INCREMENTAL_GC
+  JsVar *v = jsvObjectGetChildIfExists(flags, "gcBudget");
+  if (v) jsvGarbageCollectSetBudget(jsvGetFloatAndUnLock(v));
+#endif
 }
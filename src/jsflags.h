@@ -29,10 +29,13 @@ typedef enum {
 #endif
   JSF_ON_ERROR_SAVE      = 1<<5, ///< If set, save error and stack trace to an 'ERROR' file in internal Storage
   JSF_ON_ERROR_FLASH_LED = 1<<6, ///< If set, when we get an error, flash the Red LED
+#ifndef ESPR_NO_PRETOKENISE
+  JSF_LAZY_PRETOKENISE   = 1<<7, ///< When a function is first called, pretokenise its code if it wasn't already (and it's in RAM)
+#endif
 } PACKED_FLAGS JsFlags;
 
 
-#define JSFLAG_NAMES "deepSleep\0unsafeFlash\0unsyncFiles\0pretokenise\0jitDebug\0onErrorSave\0onErrorFlash\0"
+#define JSFLAG_NAMES "deepSleep\0unsafeFlash\0unsyncFiles\0pretokenise\0jitDebug\0onErrorSave\0onErrorFlash\0lazyPretokenise\0"
 // NOTE: \0 also added by compiler - two \0's are required!
 
 extern volatile JsFlags jsFlags;
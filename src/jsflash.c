@@ -48,6 +48,11 @@
   #define DECOMPRESS rle_decode
 #endif
 
+#ifdef SAVE_ON_FLASH
+#define JSF_WRITE_COALESCE 64 // files smaller than this (with header) are written with a single flash write
+#else
+#define JSF_WRITE_COALESCE 256 // files smaller than this (with header) are written with a single flash write
+#endif
 #define JSF_CACHE_NOT_FOUND 0xFFFFFFFF
 #define JSF_MAX_FILES 10000 // 10k files max - we use this for sanity checking our data
 #define JSF_FILENAME_TABLE_NAME "[FILENAME_TABLE]"
@@ -129,6 +134,179 @@ static uint32_t jsfCacheFind(JsfFileName name, JsfFileHeader *header) { return J
 static void jsfCachePut(JsfFileHeader *header, uint32_t addr) { }
 #endif
 
+#ifdef ESPR_STORAGE_INDEX
+/* Even with the cache, finding a file that's not in it means walking every header
+in Storage. With hundreds of files that's a lot of flash reads, so we keep a hash
+table in RAM of the header address of every file, keyed on a hash of its name.
+It is built with a single scan of Storage the first time a file is looked up, and
+is then kept up to date as files are created and erased, so any lookup only needs
+to read the header(s) of files whose name hash matches.
+
+To use this, add '-DESPR_STORAGE_INDEX=256' or some other power of 2 to the BOARD.py
+file. Each slot uses 6 bytes of RAM and up to 3/4 of them can be filled. If there
+are too many files to fit we just go back to scanning until Storage is compacted. */
+#if ESPR_STORAGE_INDEX & (ESPR_STORAGE_INDEX-1)
+#error ESPR_STORAGE_INDEX must be a power of 2
+#endif
+#define JSF_INDEX_MASK (ESPR_STORAGE_INDEX-1)
+#define JSF_INDEX_MAX_USED ((ESPR_STORAGE_INDEX*3)/4) // keep probe sequences short
+#define JSF_INDEX_EMPTY 0xFFFFFFFF // slot has never been used
+#define JSF_INDEX_ERASED 0xFFFFFFFE // slot was used by a file that's now erased - keep probing past it
+
+typedef enum {
+  JSFIS_UNBUILT,  ///< index must be built from Storage before it's used
+  JSFIS_VALID,    ///< index contains every file in Storage
+  JSFIS_TOO_MANY, ///< too many files for the index - don't use it until Storage is compacted/erased
+} JsfIndexState;
+
+static uint32_t jsfIndexAddr[ESPR_STORAGE_INDEX]; ///< Address of the file's *header*, or JSF_INDEX_EMPTY/JSF_INDEX_ERASED
+static uint16_t jsfIndexHash[ESPR_STORAGE_INDEX]; ///< Hash of the file's name
+static uint16_t jsfIndexUsed = 0; ///< How many slots aren't JSF_INDEX_EMPTY
+static JsfIndexState jsfIndexState = JSFIS_UNBUILT;
+
+static uint16_t jsfIndexHashName(JsfFileName name) {
+  uint32_t hash = 2166136261U; // FNV-1a
+  for (size_t i=0;i<sizeof(name.c) && name.c[i];i++)
+    hash = (hash ^ (unsigned char)name.c[i]) * 16777619U;
+  return (uint16_t)(hash ^ (hash>>16));
+}
+
+/// Addresses of files have changed (compact/erase) - rebuild the index next time it's needed
+static void jsfIndexClear() {
+  jsfIndexState = JSFIS_UNBUILT;
+}
+
+/// A file has been created with its header at 'addr'
+static void jsfIndexAdd(JsfFileName name, uint32_t addr) {
+  if (jsfIndexState!=JSFIS_VALID) return;
+  if (jsfIndexUsed >= JSF_INDEX_MAX_USED) {
+    // too full - rebuild (which removes erased entries) next time, or give up if still full
+    jsfIndexState = JSFIS_UNBUILT;
+    return;
+  }
+  uint16_t hash = jsfIndexHashName(name);
+  uint32_t i = hash & JSF_INDEX_MASK;
+  while (jsfIndexAddr[i]!=JSF_INDEX_EMPTY && jsfIndexAddr[i]!=JSF_INDEX_ERASED)
+    i = (i+1) & JSF_INDEX_MASK;
+  if (jsfIndexAddr[i]==JSF_INDEX_EMPTY) jsfIndexUsed++;
+  jsfIndexAddr[i] = addr;
+  jsfIndexHash[i] = hash;
+}
+
+/// The file with its header at 'addr' has been erased
+static void jsfIndexRemove(JsfFileName name, uint32_t addr) {
+  if (jsfIndexState!=JSFIS_VALID) return;
+  uint32_t i = jsfIndexHashName(name) & JSF_INDEX_MASK;
+  while (jsfIndexAddr[i]!=JSF_INDEX_EMPTY) {
+    if (jsfIndexAddr[i]==addr) {
+      jsfIndexAddr[i] = JSF_INDEX_ERASED;
+      return;
+    }
+    i = (i+1) & JSF_INDEX_MASK;
+  }
+}
+
+/// The file with its header at 'addr' has been moved to 'newAddr'
+static void jsfIndexMove(JsfFileName name, uint32_t addr, uint32_t newAddr) {
+  if (jsfIndexState!=JSFIS_VALID) return;
+  uint32_t i = jsfIndexHashName(name) & JSF_INDEX_MASK;
+  while (jsfIndexAddr[i]!=JSF_INDEX_EMPTY) {
+    if (jsfIndexAddr[i]==addr) {
+      jsfIndexAddr[i] = newAddr;
+      return;
+    }
+    i = (i+1) & JSF_INDEX_MASK;
+  }
+  jsfIndexState = JSFIS_UNBUILT; // not found - shouldn't happen, but rebuild to be safe
+}
+#else
+static void jsfIndexClear() {}
+static void jsfIndexAdd(JsfFileName name, uint32_t addr) {}
+static void jsfIndexRemove(JsfFileName name, uint32_t addr) {}
+static void jsfIndexMove(JsfFileName name, uint32_t addr, uint32_t newAddr) {}
+#endif
+
+#ifdef ESPR_STORAGE_BACKGROUND_COMPACT
+typedef enum {
+  JSFCS_IDLE,    ///< Nothing to do
+  JSFCS_CHECK,   ///< Storage has changed - check whether it needs compacting
+  JSFCS_RUNNING, ///< Compacting a step at a time from jsiIdle
+} JsfCompactState;
+JsfCompactState jsfCompactState = JSFCS_CHECK;
+
+/// A file was created or erased, so we may need to start compacting in the background
+static void jsfCompactChanged() {
+  if (jsfCompactState==JSFCS_IDLE)
+    jsfCompactState = JSFCS_CHECK;
+}
+#else
+static void jsfCompactChanged() {}
+#endif
+
+#ifdef ESPR_STORAGE_WEAR_LEVEL
+/* To spread wear, we count how many times each area ('block') of the first
+Storage bank has been erased. Counts are kept in RAM and written to the hidden
+JSF_WEAR_NAME file from jsiIdle. Rewriting it leaves the old copy as trash, so
+we only do that once enough pages have been erased - if we reset before then
+we just lose a few counts. */
+#define JSF_WEAR_NAME "[WEAR]"
+#define JSF_WEAR_BLOCKS 32 // Storage is split into this many areas for counting
+#ifndef ESPR_STORAGE_WEAR_SAVE_ERASES
+#define ESPR_STORAGE_WEAR_SAVE_ERASES 32 // only write counts to flash once this many pages have been erased since they were last written
+#endif
+typedef enum {
+  JSFW_UNLOADED, ///< We haven't read the counts from flash - don't count erases
+  JSFW_LOADED,   ///< jsfWearCount is the same as what's in flash
+  JSFW_CHANGED,  ///< jsfWearCount needs writing to flash
+} JsfWearState;
+JsfWearState jsfWearState = JSFW_UNLOADED;
+uint16_t jsfWearCount[JSF_WEAR_BLOCKS]; ///< Amount of pages erased in each block
+uint32_t jsfWearUnsaved = 0; ///< Amount of pages erased since jsfWearCount was last written to flash
+
+/// Called before pages from addr to addr+len are erased
+static void jsfWearCountErase(uint32_t addr, uint32_t len) {
+  if (jsfWearState==JSFW_UNLOADED) return;
+  uint32_t end = addr+len;
+  if (addr<JSF_START_ADDRESS) addr=JSF_START_ADDRESS;
+  if (end>JSF_END_ADDRESS) end=JSF_END_ADDRESS;
+  uint32_t pageAddr, pageLen;
+  while (addr<end && jshFlashGetPage(addr, &pageAddr, &pageLen)) {
+    uint32_t block = (pageAddr-JSF_START_ADDRESS) / ((JSF_END_ADDRESS-JSF_START_ADDRESS) / JSF_WEAR_BLOCKS);
+    if (block>=JSF_WEAR_BLOCKS) block = JSF_WEAR_BLOCKS-1;
+    if (jsfWearCount[block]<0xFFFF) jsfWearCount[block]++;
+    jsfWearUnsaved++;
+    addr = pageAddr+pageLen;
+  }
+  jsfWearState = JSFW_CHANGED;
+  if (jsfWearUnsaved >= ESPR_STORAGE_WEAR_SAVE_ERASES)
+    jsfCompactChanged(); // so jsfCompactStep gets called to save the counts
+}
+/// The copy of the counts in flash has gone (Storage was erased or compacted) - write them next time we're idle
+static void jsfWearLost() {
+  if (jsfWearState==JSFW_UNLOADED) return;
+  jsfWearState = JSFW_CHANGED;
+  if (jsfWearUnsaved < ESPR_STORAGE_WEAR_SAVE_ERASES)
+    jsfWearUnsaved = ESPR_STORAGE_WEAR_SAVE_ERASES;
+  jsfCompactChanged();
+}
+static void jsfWearLoad();
+#else
+static void jsfWearCountErase(uint32_t addr, uint32_t len) {}
+static void jsfWearLost() {}
+#endif
+
+/// Erase the page containing addr (Storage should always use this rather than jshFlashErasePage)
+static void jsfErasePage(uint32_t addr) {
+  jsfWearCountErase(addr, 1);
+  jshFlashErasePage(addr);
+}
+
+/// Erase the pages from addr to addr+len (Storage should always use this rather than jshFlashErasePages)
+static bool jsfErasePages(uint32_t addr, uint32_t len) {
+  jsfWearCountErase(addr, len);
+  return jshFlashErasePages(addr, len);
+}
+
 // ------------------------------------------------------------------------------------------------
 // ------------------------------------------------------------------------------------------------
 // ------------------------------------------------------------------------ Flash Storage Functionality
@@ -263,32 +441,49 @@ static bool jsfIsEqual(uint32_t addr, const unsigned char *data, uint32_t len) {
   return true;
 }
 
+/// If any JsVar points to this area of flash, point it to newAddr instead (or clear it if newAddr==0)
+static void jsfUpdateMemoryAddress(uint32_t addr, uint32_t length, uint32_t newAddr) {
+  jsvUpdateMemoryAddress(addr, length, newAddr);
+  // Strings point to the memory-mapped address, which isn't always the flash address (eg. Linux)
+  size_t mappedAddr = jshFlashGetMemMapAddress(addr);
+  if (mappedAddr && mappedAddr!=addr)
+    jsvUpdateMemoryAddress(mappedAddr, length, newAddr ? jshFlashGetMemMapAddress(newAddr) : 0);
+}
+
 /// Erase the entire contents of the memory store
 bool jsfEraseAll() {
   jsDebug(DBG_INFO,"EraseAll\n");
+#ifdef ESPR_STORAGE_WEAR_LEVEL
+  if (jsfIsStorageValid(JSFSTT_QUICK)) jsfWearLoad(); // so we don't lose count of erases
+#endif
   jsfCacheClear();
+  jsfIndexClear();
 #ifdef ESPR_STORAGE_FILENAME_TABLE
   jsfFilenameTableBank1Addr = 0;
   jsfFilenameTableBank1Size = 0;
 #endif
 #ifdef JSF_BANK2_START_ADDRESS
-  jsvUpdateMemoryAddress(JSF_BANK2_START_ADDRESS, JSF_BANK2_END_ADDRESS-JSF_BANK2_START_ADDRESS, 0); // if any JsVar points to this, clear it
-  if (!jshFlashErasePages(JSF_BANK2_START_ADDRESS, JSF_BANK2_END_ADDRESS-JSF_BANK2_START_ADDRESS)) return false;
+  jsfUpdateMemoryAddress(JSF_BANK2_START_ADDRESS, JSF_BANK2_END_ADDRESS-JSF_BANK2_START_ADDRESS, 0); // if any JsVar points to this, clear it
+  if (!jsfErasePages(JSF_BANK2_START_ADDRESS, JSF_BANK2_END_ADDRESS-JSF_BANK2_START_ADDRESS)) return false;
 #endif
-  jsvUpdateMemoryAddress(JSF_START_ADDRESS, JSF_END_ADDRESS-JSF_START_ADDRESS, 0); // if any JsVar points to this, clear it
-  return jshFlashErasePages(JSF_START_ADDRESS, JSF_END_ADDRESS-JSF_START_ADDRESS);
+  jsfUpdateMemoryAddress(JSF_START_ADDRESS, JSF_END_ADDRESS-JSF_START_ADDRESS, 0); // if any JsVar points to this, clear it
+  bool erased = jsfErasePages(JSF_START_ADDRESS, JSF_END_ADDRESS-JSF_START_ADDRESS);
+  jsfWearLost();
+  return erased;
 }
 
 /// When a file is found in memory, erase it (by setting first bytes of name to 0). addr=ptr to data, NOT header
 static void jsfEraseFileInternal(uint32_t addr, JsfFileHeader *header, bool createFilenameTable) {
   jsDebug(DBG_INFO,"EraseFile 0x%08x\n", addr);
 
-  jsvUpdateMemoryAddress(addr, jsfGetFileSize(header), 0); // if any JsVar points to this, clear it
+  jsfUpdateMemoryAddress(addr, jsfGetFileSize(header), 0); // if any JsVar points to this, clear it
 
   addr -= (uint32_t)sizeof(JsfFileHeader);
+  jsfIndexRemove(header->name, addr);
   addr += (uint32_t)((char*)&header->name.firstChars - (char*)header);
   header->name.firstChars = 0;
   jshFlashWrite(&header->name.firstChars,addr,(uint32_t)sizeof(header->name.firstChars));
+  jsfCompactChanged();
 
 #ifdef ESPR_STORAGE_FILENAME_TABLE
   if (createFilenameTable && addr>=JSF_START_ADDRESS && addr<JSF_END_ADDRESS) { // if was erasing in Bank 1
@@ -417,8 +612,10 @@ JsfStorageStats jsfGetStorageStats(uint32_t addr, bool allPages) {
     uint32_t fileSize = jsfAlignAddress(jsfGetFileSize(&header)) + (uint32_t)sizeof(JsfFileHeader);
     lastAddr = addr + fileSize;
     if (header.name.firstChars != 0) { // if not replaced
-      stats.fileBytes += fileSize;
-      stats.fileCount++;
+      if (jsfGetFileFlags(&header)!=JSFF_WEAR_COUNT) { // hidden, and always there - don't report it as a file
+        stats.fileBytes += fileSize;
+        stats.fileCount++;
+      }
     } else { // replaced
       stats.trashBytes += fileSize;
       stats.trashCount++;
@@ -466,7 +663,7 @@ static void jsfCompactWriteBuffer(uint32_t *writeAddress, uint32_t readAddress,
     uint32_t pAddr, pLen;
     if (jshFlashGetPage(*writeAddress, &pAddr, &pLen) &&  (pAddr == *writeAddress)) {
       jsDebug(DBG_INFO,"compact> erase page 0x%08x\n", *writeAddress);
-      jshFlashErasePage(*writeAddress);
+      jsfErasePage(*writeAddress);
     }
     assert(jsfIsErased(*writeAddress, s));
     //if (!jsfIsErased(*writeAddress, s)) jsiConsolePrintf("ERROR: AREA NOT ERASED 0x%08x => 0x%08x\n", *writeAddress, *writeAddress + s);
@@ -508,7 +705,7 @@ static bool jsfCompactInternal(uint32_t startAddress, char *swapBuffer, uint32_t
       // Rewrite file position for any JsVars that used this file *if* the file changed position
       uint32_t newAddress = writeAddress+swapBufferUsed;
       if (addr != newAddress)
-        jsvUpdateMemoryAddress(addr, sizeof(JsfFileHeader) + jsfGetFileSize(&header), newAddress);
+        jsfUpdateMemoryAddress(addr, (uint32_t)sizeof(JsfFileHeader) + jsfGetFileSize(&header), newAddress);
       // Copy the file into the circular buffer, one bit at a time.
       // Write the header
       memcpy_circular(swapBuffer, &swapBufferHead, swapBufferSize, (char*)&header, sizeof(JsfFileHeader));
@@ -560,7 +757,7 @@ static bool jsfCompactInternal(uint32_t startAddress, char *swapBuffer, uint32_t
     if (!addr) addr=jsfGetBankEndAddress(writeAddress);
     jsDebug(DBG_INFO,"compact> erase 0x%08x => 0x%08x\n", writeAddress, addr);
     // addr is the address of the last area in flash
-    jshFlashErasePages(writeAddress, addr-writeAddress);
+    jsfErasePages(writeAddress, addr-writeAddress);
   }
   jsiConsolePrintf("\n");
   jsDebug(DBG_INFO,"Compaction Complete\n");
@@ -638,8 +835,12 @@ bool jsfCompact(bool showMessage) {
     jsiConsolePrintf("Less than 10 percent battery remaining - cannot compact\n");
     return false;
   }
+#endif
+#ifdef ESPR_STORAGE_WEAR_LEVEL
+  jsfWearLoad();
 #endif
   jsfCacheClear();
+  jsfIndexClear();
 #ifdef ESPR_STORAGE_FILENAME_TABLE
   jsfFilenameTableBank1Addr = 0;
   jsfFilenameTableBank1Size = 0;
@@ -648,9 +849,447 @@ bool jsfCompact(bool showMessage) {
 #ifdef JSF_BANK2_START_ADDRESS
   compacted |= jsfBankCompact(JSF_BANK2_START_ADDRESS, showMessage);
 #endif
+  if (compacted) jsfWearLost(); // compaction doesn't copy the erase counts
   return compacted;
 }
 
+#ifdef ESPR_STORAGE_BACKGROUND_COMPACT
+/* Background compaction. jsfCompact slides every file down at once, which can
+take seconds. Instead, when Storage is getting full we move a few files at a
+time from jsiIdle.
+
+Each step finds the first erased file (the 'gap') and copies the live files that
+follow it down into the gap. The space they leave behind is covered by a single
+erased 'filler' header, so Storage is always valid between steps and the next
+step just carries on from there. Whole pages of erased files at the end of
+Storage are simply erased.
+
+To make a step crash-safe, the new contents of every page it rewrites are first
+written to a journal file in the free space after the last file. Only once the
+journal is complete are the pages erased and rewritten, and then the journal is
+erased. If we reset part way through, jsfCompactRecover finds the journal at boot
+and finishes the step. */
+
+#define JSF_COMPACT_JOURNAL_NAME "[COMPACT]"
+#define JSF_COMPACT_MAX_FILES 16 // most files moved in one step
+#define JSF_COMPACT_CHUNK 256 // bytes of a page we build/copy at once
+#ifndef ESPR_STORAGE_COMPACT_FREE_PERCENT
+#define ESPR_STORAGE_COMPACT_FREE_PERCENT 25 // start compacting when free space drops below this % of Storage...
+#endif
+#define JSF_COMPACT_TRASH_PERCENT 5 // ...if at least this % of Storage is erased files
+
+/// Stored at the start of the journal file, followed by the new contents of the pages
+typedef struct {
+  uint32_t addr;   ///< Address of the first page to rewrite
+  uint32_t length; ///< Length of the page data that follows
+  uint32_t crc;    ///< CRC32 of the page data - written last, so we know the journal is complete
+  uint32_t padding;
+} JsfCompactJournal;
+
+/// What one step of compaction will do
+typedef struct {
+  uint32_t gapAddr;  ///< Where the moved files go
+  uint32_t fillAddr; ///< Where the filler header goes (after the moved files)
+  uint32_t fillEnd;  ///< End of the area the filler covers, or 0 if everything after fillAddr in the pages is erased
+  uint32_t fileCount;
+  uint32_t fileAddr[JSF_COMPACT_MAX_FILES]; ///< Address of each moved file's header
+  uint32_t fileLen[JSF_COMPACT_MAX_FILES];  ///< Length of each moved file (including header, aligned)
+} JsfCompactStepInfo;
+
+static uint32_t jsfCompactCRC(uint32_t crc, const unsigned char *data, uint32_t len) {
+  while (len--) {
+    crc ^= *(data++);
+    for (int i=0;i<8;i++)
+      crc = (crc>>1) ^ (0xEDB88320 & -(crc & 1));
+  }
+  return crc;
+}
+
+/// Get the address of the start of the first page that starts at or after addr
+static uint32_t jsfCompactPageAfter(uint32_t addr) {
+  uint32_t pageAddr,pageLen;
+  if (!jshFlashGetPage(addr, &pageAddr, &pageLen)) return 0;
+  return (pageAddr==addr) ? addr : pageAddr+pageLen;
+}
+
+/// Copy the part of [dst,dst+len) that lies in [bufAddr,bufAddr+bufLen) into buf, reading from flash at src or from ptr
+static void jsfCompactOverlay(unsigned char *buf, uint32_t bufAddr, uint32_t bufLen, uint32_t dst, uint32_t len, uint32_t src, const unsigned char *ptr) {
+  uint32_t start = (dst > bufAddr) ? dst : bufAddr;
+  uint32_t end = (dst+len < bufAddr+bufLen) ? dst+len : bufAddr+bufLen;
+  if (start >= end) return;
+  if (ptr) memcpy(&buf[start-bufAddr], &ptr[start-dst], end-start);
+  else jshFlashRead(&buf[start-bufAddr], src+(start-dst), end-start);
+}
+
+/// Work out what the part of flash at [addr,addr+len) will contain after this step
+static void jsfCompactBuildChunk(JsfCompactStepInfo *step, unsigned char *buf, uint32_t addr, uint32_t len) {
+  jshFlashRead(buf, addr, len);
+  uint32_t dst = step->gapAddr;
+  for (uint32_t i=0;i<step->fileCount;i++) {
+    jsfCompactOverlay(buf, addr, len, dst, step->fileLen[i], step->fileAddr[i], NULL);
+    dst += step->fileLen[i];
+  }
+  if (step->fillEnd) { // cover what's left with an erased file
+    JsfFileHeader filler;
+    memset(&filler, 0, sizeof(filler));
+    filler.size = step->fillEnd - (step->fillAddr + (uint32_t)sizeof(JsfFileHeader));
+    jsfCompactOverlay(buf, addr, len, step->fillAddr, (uint32_t)sizeof(filler), 0, (unsigned char*)&filler);
+  } else if (step->fillAddr < addr+len) { // nothing after - leave it erased
+    uint32_t start = (step->fillAddr > addr) ? step->fillAddr : addr;
+    memset(&buf[start-addr], 0xFF, addr+len-start);
+  }
+}
+
+/// Copy the contents of a complete journal over the pages it refers to
+static void jsfCompactApplyJournal(uint32_t journalAddr, JsfCompactJournal *journal) {
+  unsigned char buf[JSF_COMPACT_CHUNK];
+  jsfErasePages(journal->addr, journal->length);
+  uint32_t dataAddr = journalAddr + (uint32_t)(sizeof(JsfFileHeader)+sizeof(JsfCompactJournal));
+  for (uint32_t o=0;o<journal->length;o+=JSF_COMPACT_CHUNK) {
+    uint32_t l = journal->length-o;
+    if (l>JSF_COMPACT_CHUNK) l=JSF_COMPACT_CHUNK;
+    jshFlashRead(buf, dataAddr+o, l);
+    jshFlashWrite(buf, journal->addr+o, l);
+    jshKickWatchDog();
+  }
+}
+
+/// Erase the journal (which is after the last file, so must be left blank)
+static void jsfCompactEraseJournal(uint32_t journalAddr, JsfFileHeader *header) {
+  // erase the name first, so it's ignored even if we reset before the pages are erased
+  uint32_t namePtr = journalAddr + (uint32_t)((char*)&header->name.firstChars - (char*)header);
+  header->name.firstChars = 0;
+  jshFlashWrite(&header->name.firstChars, namePtr, (uint32_t)sizeof(header->name.firstChars));
+  uint32_t addr = jsfCompactPageAfter(journalAddr + (uint32_t)sizeof(JsfFileHeader) + jsfGetFileSize(header));
+  if (!addr) addr = jsfGetBankEndAddress(journalAddr);
+  uint32_t pageAddr, pageLen;
+  while (addr > journalAddr && jshFlashGetPage(addr-1, &pageAddr, &pageLen)) {
+    jsfErasePage(pageAddr);
+    jshKickWatchDog();
+    addr = pageAddr;
+  }
+}
+
+/// Write the journal for this step at journalAddr, then rewrite the pages [pageAddr,pageEnd)
+static void jsfCompactRewritePages(JsfCompactStepInfo *step, uint32_t pageAddr, uint32_t pageEnd, uint32_t journalAddr) {
+  unsigned char buf[JSF_COMPACT_CHUNK];
+  JsfFileHeader header;
+  JsfCompactJournal journal;
+  journal.addr = pageAddr;
+  journal.length = pageEnd - pageAddr;
+  journal.crc = 0xFFFFFFFF;
+  journal.padding = 0xFFFFFFFF;
+  header.size = ((uint32_t)sizeof(JsfCompactJournal) + journal.length) | ((uint32_t)JSFF_COMPACT_JOURNAL<<24);
+  header.name = jsfNameFromString(JSF_COMPACT_JOURNAL_NAME);
+  jshFlashWrite(&header, journalAddr, (uint32_t)sizeof(header));
+  jshFlashWrite(&journal, journalAddr+(uint32_t)sizeof(header), 8); // addr+length - crc is written when we're done
+  uint32_t dataAddr = journalAddr + (uint32_t)(sizeof(JsfFileHeader)+sizeof(JsfCompactJournal));
+  uint32_t crc = 0xFFFFFFFF;
+  for (uint32_t o=0;o<journal.length;o+=JSF_COMPACT_CHUNK) {
+    uint32_t l = journal.length-o;
+    if (l>JSF_COMPACT_CHUNK) l=JSF_COMPACT_CHUNK;
+    jsfCompactBuildChunk(step, buf, pageAddr+o, l);
+    jshFlashWrite(buf, dataAddr+o, l);
+    crc = jsfCompactCRC(crc, buf, l);
+  }
+  journal.crc = ~crc;
+  jshFlashWrite(&journal.crc, journalAddr+(uint32_t)sizeof(header)+8, 8); // crc+padding
+  // the journal is complete - now it's safe to rewrite the pages
+  jsfCompactApplyJournal(journalAddr, &journal);
+  jsfCompactEraseJournal(journalAddr, &header);
+}
+
+/// Do one step of compaction on a bank - return true if anything was done
+static bool jsfBankCompactStep(uint32_t startAddress) {
+  JsfCompactStepInfo step;
+  memset(&step, 0, sizeof(step));
+  uint32_t pageAddr, pageLen;
+  uint32_t endAddress = jsfGetBankEndAddress(startAddress);
+  uint32_t liveEnd = startAddress; // end of the last live file
+  uint32_t usedEnd = startAddress; // end of the last file
+  uint32_t movedLen = 0, maxMovedLen = 0;
+  bool collecting = true;
+  JsfFileHeader header;
+  uint32_t addr = startAddress;
+  if (jsfGetFileHeader(addr, &header, false)) do {
+    uint32_t fileLen = (uint32_t)sizeof(JsfFileHeader) + jsfAlignAddress(jsfGetFileSize(&header));
+    usedEnd = addr + fileLen;
+    if (header.name.firstChars == 0) { // erased
+      if (!step.gapAddr) {
+        step.gapAddr = addr;
+        if (!jshFlashGetPage(addr, &pageAddr, &pageLen)) return false;
+        maxMovedLen = pageLen; // move about a page's worth of files each step
+      }
+    } else { // live file
+      liveEnd = usedEnd;
+      if (step.gapAddr && collecting) {
+        // move this file into the gap? Always move at least one file
+        if (step.fileCount<JSF_COMPACT_MAX_FILES &&
+            (!step.fileCount || movedLen+fileLen <= maxMovedLen)) {
+          step.fileAddr[step.fileCount] = addr;
+          step.fileLen[step.fileCount] = fileLen;
+          step.fileCount++;
+          movedLen += fileLen;
+          step.fillEnd = usedEnd;
+        } else
+          collecting = false;
+      }
+    }
+  } while (jsfGetNextFileHeader(&addr, &header, GNFH_GET_ALL|GNFH_READ_ONLY_FILENAME_START));
+  if (!step.gapAddr) return false; // no erased files
+  // Whole pages of erased files at the end? Just erase them (last page first, so what's left is always valid)
+  uint32_t eraseAddr = jsfCompactPageAfter(liveEnd);
+  if (eraseAddr && eraseAddr < usedEnd && !jsfIsErased(eraseAddr, usedEnd-eraseAddr)) {
+    jsDebug(DBG_INFO,"compact step> erase 0x%08x => 0x%08x\n", eraseAddr, usedEnd);
+    addr = usedEnd;
+    while (addr > eraseAddr && jshFlashGetPage(addr-1, &pageAddr, &pageLen)) {
+      jsfErasePage(pageAddr);
+      jshKickWatchDog();
+      addr = pageAddr;
+    }
+    return true;
+  }
+  step.fillAddr = step.gapAddr + movedLen;
+  uint32_t lastAddr = step.fillAddr;
+  if (step.fileCount) {
+    lastAddr += (uint32_t)sizeof(JsfFileHeader)-1; // the filler header must fit too
+  } else { // just erased files at the end of a page
+    if (jsfIsErased(step.gapAddr, jsfCompactPageAfter(step.gapAddr)-step.gapAddr)) return false;
+  }
+  // Work out which pages we'll rewrite
+  if (!jshFlashGetPage(step.gapAddr, &pageAddr, &pageLen)) return false;
+  uint32_t firstPage = pageAddr;
+  if (!jshFlashGetPage(lastAddr, &pageAddr, &pageLen)) return false;
+  uint32_t lastPageEnd = pageAddr+pageLen;
+  // ... and check there's space for the journal after the last file
+  uint32_t journalAddr = jsfCompactPageAfter(usedEnd);
+  uint32_t journalLen = (uint32_t)(sizeof(JsfFileHeader)+sizeof(JsfCompactJournal)) + (lastPageEnd-firstPage);
+  if (!journalAddr || journalAddr+journalLen > endAddress || !jsfIsErased(journalAddr, journalLen)) {
+    jsDebug(DBG_INFO,"compact step> no space for journal\n");
+    return false;
+  }
+  jsDebug(DBG_INFO,"compact step> move %d files to 0x%08x, rewrite 0x%08x => 0x%08x\n", step.fileCount, step.gapAddr, firstPage, lastPageEnd);
+  jsfCompactRewritePages(&step, firstPage, lastPageEnd, journalAddr);
+  // Point the index and any JsVars that used the files we moved to the new addresses
+  uint32_t dst = step.gapAddr;
+  for (uint32_t i=0;i<step.fileCount;i++) {
+    if (jsfGetFileHeader(dst, &header, true))
+      jsfIndexMove(header.name, step.fileAddr[i], dst);
+    jsfUpdateMemoryAddress(step.fileAddr[i], step.fileLen[i], dst);
+    dst += step.fileLen[i];
+  }
+  return true;
+}
+
+/// Returns true if Storage needs compacting in the background
+static bool jsfBankCompactNeeded(uint32_t startAddress) {
+  JsfStorageStats stats = jsfGetStorageStats(startAddress, true);
+  return stats.free < stats.total/100*ESPR_STORAGE_COMPACT_FREE_PERCENT &&
+         stats.trashBytes >= stats.total/100*JSF_COMPACT_TRASH_PERCENT;
+}
+
+/// Returns true if Storage may need compacting in the background - see jsfCompactStep
+bool jsfCompactIsPending() {
+  return jsfCompactState != JSFCS_IDLE;
+}
+
+#ifdef ESPR_STORAGE_WEAR_LEVEL
+#ifndef ESPR_STORAGE_WEAR_SPREAD
+#define ESPR_STORAGE_WEAR_SPREAD 50 // move files off a block once its pages have been erased this many times less than the most erased block
+#endif
+
+/// Read erase counts from flash (if we haven't already). Storage must be valid.
+static void jsfWearLoad() {
+  if (jsfWearState!=JSFW_UNLOADED) return;
+  memset(jsfWearCount, 0, sizeof(jsfWearCount));
+  JsfFileHeader header;
+  uint32_t addr = jsfFindFile(jsfNameFromString(JSF_WEAR_NAME), &header);
+  if (addr && jsfGetFileSize(&header)==sizeof(jsfWearCount))
+    jshFlashRead(jsfWearCount, addr, (uint32_t)sizeof(jsfWearCount));
+  jsfWearState = JSFW_LOADED;
+  jsfWearUnsaved = 0;
+}
+
+/// Write erase counts to flash if enough pages have been erased since they were last written
+static void jsfWearSave() {
+  if (jsfWearState!=JSFW_CHANGED || jsfWearUnsaved < ESPR_STORAGE_WEAR_SAVE_ERASES) return;
+  jsfWearState = JSFW_LOADED; // set first, as creating the file could cause a compaction
+  jsfWearUnsaved = 0;
+  JsfFileName name = jsfNameFromString(JSF_WEAR_NAME);
+  JsfFileHeader header;
+  uint32_t addr = jsfFindFile(name, &header);
+  if (addr) jsfEraseFileInternal(addr, &header, false);
+  addr = jsfCreateFile(name, (uint32_t)sizeof(jsfWearCount), JSFF_WEAR_COUNT, &header);
+  if (addr) jshFlashWriteAligned(jsfWearCount, addr, (uint32_t)sizeof(jsfWearCount));
+}
+
+/// How many pages are in each block that we count erases for
+static uint32_t jsfWearPagesPerBlock() {
+  uint32_t pageAddr, pageLen, pages = 0;
+  if (jshFlashGetPage(JSF_START_ADDRESS, &pageAddr, &pageLen) && pageLen)
+    pages = ((JSF_END_ADDRESS-JSF_START_ADDRESS) / JSF_WEAR_BLOCKS) / pageLen;
+  return pages ? pages : 1;
+}
+
+/// Get the average amount of times a page has been erased, in the least and most erased areas of Storage
+void jsfGetWearStats(uint32_t *minCount, uint32_t *maxCount) {
+  jsfWearLoad();
+  *minCount = 0xFFFF;
+  *maxCount = 0;
+  for (int i=0;i<JSF_WEAR_BLOCKS;i++) {
+    if (jsfWearCount[i]<*minCount) *minCount = jsfWearCount[i];
+    if (jsfWearCount[i]>*maxCount) *maxCount = jsfWearCount[i];
+  }
+  *minCount /= jsfWearPagesPerBlock();
+  *maxCount /= jsfWearPagesPerBlock();
+}
+
+/* Static wear levelling. Files that never change stay on the same pages, so
+those pages are hardly ever erased while the pages after them take all the wear.
+If the least erased block that has files in it is far enough behind the most
+erased block, move a file from it to the end of Storage. When Storage is next
+compacted, other files are slid down into the space it left. Returns true if a
+file was moved */
+static bool jsfWearLevelStep() {
+#ifdef JSF_BANK2_START_ADDRESS
+  return false; // we only count erases in the first bank, and jsfCreateFile may pick the other
+#else
+  uint32_t spread = ESPR_STORAGE_WEAR_SPREAD * jsfWearPagesPerBlock();
+  uint32_t blockSize = (JSF_END_ADDRESS-JSF_START_ADDRESS) / JSF_WEAR_BLOCKS;
+  uint16_t hottest = 0, coldest = 0xFFFF;
+  for (int i=0;i<JSF_WEAR_BLOCKS;i++) {
+    if (jsfWearCount[i]>hottest) hottest = jsfWearCount[i];
+    if (jsfWearCount[i]<coldest) coldest = jsfWearCount[i];
+  }
+  if ((uint32_t)(hottest-coldest) < spread) return false;
+  // find the first file in the least erased block that has files in it
+  uint32_t coldAddr = 0;
+  coldest = 0xFFFF;
+  JsfFileHeader header;
+  uint32_t addr = JSF_START_ADDRESS;
+  if (jsfGetFileHeader(addr, &header, false)) do {
+    if (!jsfIsRealFile(&header)) continue;
+    uint32_t block = (addr-JSF_START_ADDRESS) / blockSize;
+    if (block>=JSF_WEAR_BLOCKS) block = JSF_WEAR_BLOCKS-1;
+    if (jsfWearCount[block]<coldest) {
+      coldest = jsfWearCount[block];
+      coldAddr = addr;
+    }
+  } while (jsfGetNextFileHeader(&addr, &header, GNFH_GET_ALL|GNFH_READ_ONLY_FILENAME_START));
+  if (!coldAddr || (uint32_t)(hottest-coldest) < spread) return false;
+  jsfGetFileHeader(coldAddr, &header, true);
+  uint32_t size = jsfGetFileSize(&header);
+  // Only move it if that won't leave us needing to compact
+  JsfStorageStats stats = jsfGetStorageStats(JSF_START_ADDRESS, true);
+  if (stats.free < jsfAlignAddress(size) + (uint32_t)sizeof(JsfFileHeader) + stats.total/100*ESPR_STORAGE_COMPACT_FREE_PERCENT)
+    return false;
+  JsfFileHeader newHeader;
+  uint32_t newAddr = jsfCreateFile(header.name, size, jsfGetFileFlags(&header), &newHeader);
+  if (!newAddr) return false;
+  jsDebug(DBG_INFO,"wear level> move 0x%08x => 0x%08x\n", coldAddr, newAddr);
+  unsigned char buf[JSF_COMPACT_CHUNK];
+  uint32_t oldAddr = coldAddr + (uint32_t)sizeof(JsfFileHeader);
+  for (uint32_t o=0;o<size;o+=JSF_COMPACT_CHUNK) {
+    uint32_t l = size-o;
+    if (l>JSF_COMPACT_CHUNK) l=JSF_COMPACT_CHUNK;
+    jshFlashRead(buf, oldAddr+o, l);
+    jshFlashWriteAligned(buf, newAddr+o, l);
+  }
+  // Point any JsVars at the new copy before we erase the old one
+  jsfUpdateMemoryAddress(coldAddr, (uint32_t)sizeof(JsfFileHeader)+size, newAddr-(uint32_t)sizeof(JsfFileHeader));
+  jsfEraseFileInternal(oldAddr, &header, false);
+  return true;
+#endif
+}
+#endif
+
+/// Do one short step of compacting Storage in the background (called from jsiIdle when jsfCompactIsPending)
+void jsfCompactStep() {
+  if (jsfCompactState==JSFCS_CHECK) {
+#ifdef ESPR_STORAGE_WEAR_LEVEL
+    jsfWearLoad();
+#endif
+    bool needed = jsfBankCompactNeeded(JSF_START_ADDRESS);
+#ifdef JSF_BANK2_START_ADDRESS
+    needed |= jsfBankCompactNeeded(JSF_BANK2_START_ADDRESS);
+#endif
+#ifdef ESPR_STORAGE_WEAR_LEVEL
+    if (!needed) {
+      if (jsfWearLevelStep()) return; // moved a file - check again next time
+      jsfWearSave();
+    }
+#endif
+    jsfCompactState = needed ? JSFCS_RUNNING : JSFCS_IDLE;
+    return;
+  }
+  if (jsfCompactState!=JSFCS_RUNNING) return;
+#ifdef ESPR_STORAGE_FILENAME_TABLE
+  // Files are about to move, so the filename table would point to the wrong places
+  JsfFileHeader header;
+  uint32_t tableAddr = jsfFindFile(jsfNameFromString(JSF_FILENAME_TABLE_NAME), &header);
+  if (tableAddr) jsfEraseFileInternal(tableAddr, &header, false);
+  jsfFilenameTableBank1Addr = 0;
+  jsfFilenameTableBank1Size = 0;
+#endif
+  bool compacted = jsfBankCompactStep(JSF_START_ADDRESS);
+#ifdef JSF_BANK2_START_ADDRESS
+  if (!compacted) compacted = jsfBankCompactStep(JSF_BANK2_START_ADDRESS);
+#endif
+  jsfCacheClear(); // the index was updated as files moved
+  if (!compacted) {
+#ifdef ESPR_STORAGE_WEAR_LEVEL
+    jsfWearSave();
+#endif
+    jsfCompactState = JSFCS_IDLE;
+  }
+}
+
+static void jsfBankCompactRecover(uint32_t startAddress) {
+  JsfFileName name = jsfNameFromString(JSF_COMPACT_JOURNAL_NAME);
+  uint32_t addr = startAddress;
+  // The journal always starts on a page, and we can't rely on following file headers to find it
+  while (addr) {
+    JsfFileHeader header;
+    if (jsfGetFileHeader(addr, &header, false) &&
+        header.name.firstChars==name.firstChars &&
+        jsfGetFileFlags(&header)==JSFF_COMPACT_JOURNAL &&
+        jsfGetFileHeader(addr, &header, true) &&
+        jsfIsNameEqual(header.name, name)) {
+      JsfCompactJournal journal;
+      jshFlashRead(&journal, addr+(uint32_t)sizeof(JsfFileHeader), (uint32_t)sizeof(journal));
+      bool valid = journal.length+(uint32_t)sizeof(journal) == jsfGetFileSize(&header) &&
+                   journal.addr>=startAddress && journal.addr+journal.length<=addr;
+      if (valid) { // check the CRC - if it doesn't match we reset while writing the journal, so nothing was changed
+        unsigned char buf[JSF_COMPACT_CHUNK];
+        uint32_t dataAddr = addr + (uint32_t)(sizeof(JsfFileHeader)+sizeof(JsfCompactJournal));
+        uint32_t crc = 0xFFFFFFFF;
+        for (uint32_t o=0;o<journal.length;o+=JSF_COMPACT_CHUNK) {
+          uint32_t l = journal.length-o;
+          if (l>JSF_COMPACT_CHUNK) l=JSF_COMPACT_CHUNK;
+          jshFlashRead(buf, dataAddr+o, l);
+          crc = jsfCompactCRC(crc, buf, l);
+        }
+        valid = journal.crc == ~crc;
+      }
+      jsDebug(DBG_INFO,"compact recover> journal at 0x%08x, valid %d\n", addr, valid);
+      if (valid) jsfCompactApplyJournal(addr, &journal);
+      jsfCompactEraseJournal(addr, &header);
+    }
+    addr = jsfGetAddressOfNextPage(addr);
+  }
+}
+
+/// Finish any step of background compaction that was interrupted by a reset (called at boot before Storage is used)
+void jsfCompactRecover() {
+  jsfBankCompactRecover(JSF_START_ADDRESS);
+#ifdef JSF_BANK2_START_ADDRESS
+  jsfBankCompactRecover(JSF_BANK2_START_ADDRESS);
+#endif
+  jsfCacheClear();
+  jsfIndexClear();
+}
+#endif
+
 static bool jsvIsDriveNameExplicit(JsfFileName *name) {
   return name->c[1]==':';
 }
@@ -704,7 +1343,9 @@ void jsfGetDriveBankAddress(char drive, uint32_t *bankStartAddr, uint32_t *bankE
   *bankStartAddr=JSF_DEFAULT_START_ADDRESS;
   *bankEndAddr=JSF_DEFAULT_END_ADDRESS;
 }
-static uint32_t _jsfCreateFile(JsfFileName name, uint32_t size, JsfFileFlags flags, JsfFileHeader *returnedHeader, bool explicitOnly) {
+/** Create a new 'file'. If data!=0, dataLen bytes of it are written into the file too - for small files
+we write this in the same flash write as the header, which is a lot faster on SPI flash */
+static uint32_t _jsfCreateFile(JsfFileName name, uint32_t size, JsfFileFlags flags, JsfFileHeader *returnedHeader, bool explicitOnly, unsigned char *data, uint32_t dataLen) {
   // explicitOnly -> only put in the non-default storage while filename explicitly starts with 'C:' (default=false)
   jsDebug(DBG_INFO,"CreateFile (%d bytes)\n", size);
   bool explicitDriveName = jsvIsDriveNameExplicit(&name);
@@ -746,7 +1387,7 @@ static uint32_t _jsfCreateFile(JsfFileName name, uint32_t size, JsfFileFlags fla
         /* Drive name wasn't explicit but we're not in the default area (eg maybe file ends in .js)
         so let's try again with explicitOnly=true to force file into the default area where maybe
         there's space */
-        return _jsfCreateFile(name, size, flags, returnedHeader, true);
+        return _jsfCreateFile(name, size, flags, returnedHeader, true, data, dataLen);
       }
 #endif
       //jsiConsolePrintf("%d Free, %d Trash -> need %d\n", freeSpace, trashSpace, requiredSize);
@@ -774,21 +1415,77 @@ static uint32_t _jsfCreateFile(JsfFileName name, uint32_t size, JsfFileFlags fla
   header.size = size | (flags<<24);
   header.name = name;
   jsDebug(DBG_INFO,"CreateFile write header\n");
-  jshFlashWrite(&header,addr,(uint32_t)sizeof(JsfFileHeader));
+  if (data && sizeof(JsfFileHeader)+dataLen <= JSF_WRITE_COALESCE) {
+    unsigned char buf[JSF_WRITE_COALESCE];
+    memcpy(buf, &header, sizeof(JsfFileHeader));
+    memcpy(&buf[sizeof(JsfFileHeader)], data, dataLen);
+    jshFlashWriteAligned(buf, addr, (uint32_t)sizeof(JsfFileHeader)+dataLen);
+  } else {
+    jshFlashWrite(&header,addr,(uint32_t)sizeof(JsfFileHeader));
+    if (data) jshFlashWriteAligned(data, addr+(uint32_t)sizeof(JsfFileHeader), dataLen);
+  }
   jsDebug(DBG_INFO,"CreateFile written header\n");
   if (returnedHeader) *returnedHeader = header;
+  jsfIndexAdd(name, addr);
+  jsfCompactChanged();
   addr += (uint32_t)sizeof(JsfFileHeader); // address of actual file data
   jsfCachePut(&header, addr);
   return addr;
 }
 /** Create a new 'file' in the memory store - DOES NOT remove existing files with same name. Return the address of data start, or 0 on error */
 static uint32_t jsfCreateFile(JsfFileName name, uint32_t size, JsfFileFlags flags, JsfFileHeader *returnedHeader) {
-  return _jsfCreateFile(name, size, flags, returnedHeader, false);
+  return _jsfCreateFile(name, size, flags, returnedHeader, false, NULL, 0);
+}
+
+#ifdef ESPR_STORAGE_INDEX
+static void jsfIndexBuildBank(uint32_t addr) {
+  JsfFileHeader header;
+  if (jsfGetFileHeader(addr, &header, true)) do {
+    if (header.name.firstChars != 0) // not been replaced
+      jsfIndexAdd(header.name, addr);
+  } while (jsfIndexState==JSFIS_VALID && jsfGetNextFileHeader(&addr, &header, GNFH_GET_ALL));
+}
+
+/// Build the index if needed, and return true if it can be used
+static bool jsfIndexBuild() {
+  if (jsfIndexState==JSFIS_UNBUILT) {
+    jsDebug(DBG_INFO,"jsfIndexBuild\n");
+    memset(jsfIndexAddr, 0xFF, sizeof(jsfIndexAddr)); // JSF_INDEX_EMPTY
+    jsfIndexUsed = 0;
+    jsfIndexState = JSFIS_VALID;
+    jsfIndexBuildBank(JSF_START_ADDRESS);
+#ifdef JSF_BANK2_START_ADDRESS
+    jsfIndexBuildBank(JSF_BANK2_START_ADDRESS);
+#endif
+    if (jsfIndexState!=JSFIS_VALID) // jsfIndexAdd ran out of space
+      jsfIndexState = JSFIS_TOO_MANY;
+  }
+  return jsfIndexState==JSFIS_VALID;
 }
+#endif
 
 static uint32_t jsfBankFindFile(uint32_t bankAddress, uint32_t bankEndAddress, JsfFileName name, JsfFileHeader *returnedHeader) {
   uint32_t addr = bankAddress;
   JsfFileHeader header;
+#ifdef ESPR_STORAGE_INDEX
+  if (jsfIndexBuild()) {
+    uint16_t hash = jsfIndexHashName(name);
+    uint32_t i = hash & JSF_INDEX_MASK;
+    while (jsfIndexAddr[i]!=JSF_INDEX_EMPTY) {
+      addr = jsfIndexAddr[i];
+      if (jsfIndexHash[i]==hash && addr!=JSF_INDEX_ERASED &&
+          addr>=bankAddress && addr<bankEndAddress && // in the bank we're searching
+          jsfGetFileHeader(addr, &header, true) &&
+          jsfIsNameEqual(header.name, name)) {
+        if (returnedHeader)
+          *returnedHeader = header;
+        return addr+(uint32_t)sizeof(JsfFileHeader);
+      }
+      i = (i+1) & JSF_INDEX_MASK;
+    }
+    return 0; // the index has every file, so it's not in Storage
+  }
+#endif
 #ifdef ESPR_STORAGE_FILENAME_TABLE
   if (jsfFilenameTableBank1Addr && addr==JSF_START_ADDRESS) {
     #define FILENAME_TABLE_CHUNKS 8 // how many file headers do we read at once?
@@ -1040,10 +1737,20 @@ bool jsfIsStorageEmpty() {
   return true;
 }
 
+#ifdef ESPR_STORAGE_COMPRESSION
+static JsVar *jsfReadCompressedFile(uint32_t addr, JsfFileHeader *header, int offset, int length);
+#endif
+
 JsVar *jsfReadFile(JsfFileName name, int offset, int length) {
   JsfFileHeader header;
   uint32_t addr = jsfFindFile(name, &header);
   if (!addr) return 0;
+#ifdef ESPR_STORAGE_COMPRESSION
+  // .varimg has its own compressed format, and is only read by jsfLoadStateFromFlash
+  if ((jsfGetFileFlags(&header)&JSFF_COMPRESSED) &&
+      !jsfIsNameEqual(name, jsfNameFromString(SAVED_CODE_VARIMAGE)))
+    return jsfReadCompressedFile(addr, &header, offset, length);
+#endif
   // clip requested read lengths
   if (offset<0) offset=0;
   int fileLen = (int)jsfGetFileSize(&header);
@@ -1065,16 +1772,17 @@ JsVar* jsvAddressToVar(size_t addr, uint32_t length) {
   }
 #endif
 #ifdef LINUX
-  // linux fakes flash with a file, so we can't just return a pointer to it!
-  uint32_t alignedSize = jsfAlignAddress((uint32_t)length);
-  char *d = (char*)malloc(alignedSize);
-  jshFlashRead(d, (size_t)addr, alignedSize);
-  JsVar *v = jsvNewStringOfLength((uint32_t)length, d);
-  free(d);
-  return v;
-#else
-  return jsvNewNativeString((char*)mappedAddr, length);
+  // linux fakes flash with a file, so if it couldn't be memory-mapped we can't just return a pointer to it!
+  if (!mappedAddr) {
+    uint32_t alignedSize = jsfAlignAddress((uint32_t)length);
+    char *d = (char*)malloc(alignedSize);
+    jshFlashRead(d, (size_t)addr, alignedSize);
+    JsVar *v = jsvNewStringOfLength((uint32_t)length, d);
+    free(d);
+    return v;
+  }
 #endif
+  return jsvNewNativeString((char*)mappedAddr, length);
 }
 
 bool jsfWriteFile(JsfFileName name, JsVar *data, JsfFileFlags flags, JsVarInt offset, JsVarInt _size) {
@@ -1122,8 +1830,18 @@ bool jsfWriteFile(JsfFileName name, JsVar *data, JsfFileFlags flags, JsVarInt of
       jsDebug(DBG_INFO,"jsfWriteFile remove existing file\n");
       jsfEraseFileInternal(addr, &header, true);
     }
+    if ((uint32_t)dLen > size) {
+      jsExceptionHere(JSET_ERROR, "Too much data for file size");
+      return false;
+    }
     jsDebug(DBG_INFO,"jsfWriteFile create file\n");
-    addr = jsfCreateFile(name, (uint32_t)size, flags, &header);
+    // write the data as we create the file
+    addr = _jsfCreateFile(name, (uint32_t)size, flags, &header, false, (unsigned char*)dPtr, (uint32_t)dLen);
+    if (!addr) {
+      jsExceptionHere(JSET_ERROR, "Unable to find or create file");
+      return false;
+    }
+    return true;
   }
   if (!addr) {
     jsExceptionHere(JSET_ERROR, "Unable to find or create file");
@@ -1269,6 +1987,7 @@ typedef struct {
   uint32_t byteCount;
   unsigned char buffer[128]; // buffer for read/written data
   uint32_t bufferCnt;        // where are we in the buffer?
+  bool showProgress;         // print '.' for every 1kb written
 } jsfcbData;
 // cbdata = struct jsfcbData
 void jsfSaveToFlash_writecb(unsigned char ch, uint32_t *cbdata) {
@@ -1278,7 +1997,7 @@ void jsfSaveToFlash_writecb(unsigned char ch, uint32_t *cbdata) {
     jshFlashWrite(data->buffer, data->address, data->bufferCnt);
     data->address += data->bufferCnt;
     data->bufferCnt = 0;
-    if ((data->address&1023)==0) jsiConsolePrint(".");
+    if (data->showProgress && (data->address&1023)==0) jsiConsolePrint(".");
   }
 }
 void jsfSaveToFlash_finish(jsfcbData *data) {
@@ -1348,6 +2067,7 @@ void jsfSaveToFlash() {
   memset(&cbData, 0, sizeof(cbData));
   cbData.address = savedCodeAddr;
   cbData.endAddress = jsfAlignAddress(savedCodeAddr+compressedSize);
+  cbData.showProgress = true;
   jsiConsolePrint("Writing..");
   // write the hash
   uint32_t hash = getBuildHash();
@@ -1392,6 +2112,85 @@ void jsfLoadStateFromFlash() {
 #endif
 }
 
+#ifdef ESPR_STORAGE_COMPRESSION
+typedef struct {
+  JsvStringIterator it;
+  uint32_t skip;      // bytes to ignore before we start writing into the string
+  uint32_t remaining; // bytes left to write into the string
+} jsfDecompressData;
+
+static void jsfDecompress_writecb(unsigned char ch, uint32_t *cbdata) {
+  jsfDecompressData *data = (jsfDecompressData*)cbdata;
+  if (data->skip) {
+    data->skip--;
+  } else if (data->remaining) {
+    data->remaining--;
+    jsvStringIteratorSetCharAndNext(&data->it, (char)ch);
+  }
+}
+
+/* Decompress 'length' bytes from 'offset' in a compressed Storage file. This
+decodes straight out of flash a buffer at a time, so the only RAM used is for
+the decompressed String. */
+static JsVar *jsfReadCompressedFile(uint32_t addr, JsfFileHeader *header, int offset, int length) {
+  jsfcbData cbData;
+  memset(&cbData, 0, sizeof(cbData));
+  cbData.address = addr;
+  cbData.endAddress = addr+jsfGetFileSize(header);
+  // first 4 bytes are the uncompressed length
+  uint32_t fileLen = 0;
+  for (int i=0;i<4;i++)
+    fileLen |= (uint32_t)(jsfLoadFromFlash_readcb((uint32_t*)&cbData)&255) << (i*8);
+  // clip requested read lengths
+  if (offset<0) offset=0;
+  if (length<=0) length=(int)fileLen;
+  if (offset>(int)fileLen) offset=(int)fileLen;
+  if (offset+length>(int)fileLen) length=(int)fileLen-offset;
+  if (length<=0) return jsvNewFromEmptyString();
+  // flat strings are faster to iterate over and execute from, but fall back if we can't allocate one
+  JsVar *v = jsvNewFlatStringOfLength((unsigned int)length);
+  if (!v) v = jsvNewStringOfLength((unsigned int)length, NULL);
+  if (!v) return 0;
+  jsfDecompressData data;
+  jsvStringIteratorNew(&data.it, v, 0);
+  data.skip = (uint32_t)offset;
+  data.remaining = (uint32_t)length;
+  heatshrink_decode_cb(jsfLoadFromFlash_readcb, (uint32_t*)&cbData, jsfDecompress_writecb, (uint32_t*)&data);
+  jsvStringIteratorFree(&data.it);
+  return v;
+}
+
+bool jsfWriteCompressedFile(JsfFileName name, JsVar *data) {
+  JSV_GET_AS_CHAR_ARRAY_NO_ERROR(dPtr, dLen, data);
+  if (!dPtr) {
+    jsExceptionHere(JSET_ERROR, "Can't get pointer to data to write");
+    return false;
+  }
+  // Work out how much data this'll take, plus 4 bytes for the uncompressed length
+  uint32_t compressedSize = 4 + heatshrink_encode((unsigned char*)dPtr, dLen, NULL, NULL);
+  // If it doesn't get smaller, it's faster to read it back uncompressed
+  if (compressedSize >= dLen)
+    return jsfWriteFile(name, data, JSFF_NONE, 0, 0);
+  JsfFileHeader header;
+  uint32_t addr = jsfFindFile(name, &header);
+  if (addr) jsfEraseFileInternal(addr, &header, true);
+  addr = jsfCreateFile(name, compressedSize, JSFF_COMPRESSED, &header);
+  if (!addr) {
+    jsExceptionHere(JSET_ERROR, "Unable to find or create file");
+    return false;
+  }
+  jsfcbData cbData;
+  memset(&cbData, 0, sizeof(cbData));
+  cbData.address = addr;
+  cbData.endAddress = jsfAlignAddress(addr+compressedSize);
+  for (int i=0;i<4;i++)
+    jsfSaveToFlash_writecb((unsigned char)(dLen >> (i*8)), (uint32_t*)&cbData);
+  heatshrink_encode((unsigned char*)dPtr, dLen, jsfSaveToFlash_writecb, (uint32_t*)&cbData);
+  jsfSaveToFlash_finish(&cbData);
+  return true;
+}
+#endif
+
 void jsfSaveBootCodeToFlash(JsVar *code, bool runAfterReset) {
   jsfEraseFile(jsfNameFromString(SAVED_CODE_BOOTCODE));
   jsfEraseFile(jsfNameFromString(SAVED_CODE_BOOTCODE_RESET));
@@ -27,6 +27,16 @@
 #define ESPR_STORAGE_FILENAME_TABLE
 #endif
 
+#if defined(ESPR_STORAGE_FILENAME_TABLE) && !defined(SAVE_ON_FLASH)
+#define ESPR_STORAGE_BACKGROUND_COMPACT // when Storage is low on space, compact it a step at a time from jsiIdle
+#endif
+#ifdef ESPR_STORAGE_BACKGROUND_COMPACT
+#define ESPR_STORAGE_WEAR_LEVEL // count page erases, and move files off little-used pages from jsiIdle so they get reused
+#endif
+#if defined(USE_HEATSHRINK) && !defined(SAVE_ON_FLASH)
+#define ESPR_STORAGE_COMPRESSION // allow Storage files to be written heatshrink compressed, and decompress them when read
+#endif
+
 
 /// Simple filename used for Flash Storage. We use firstChars so we can do a quick first pass check for equality
 typedef union {
@@ -46,10 +56,12 @@ typedef struct {
 typedef enum {
   JSFF_NONE,              ///< A normal file
 #ifndef SAVE_ON_FLASH
+  JSFF_WEAR_COUNT = 8,             ///< A file containing the amount of times areas of Storage have been erased
+  JSFF_COMPACT_JOURNAL = 16,       ///< A file containing pages that background compaction is about to rewrite
   JSFF_FILENAME_TABLE = 32,        ///< A file that contains a list of JsfFileHeader structs with 'size' pointing to the file addresses at the time it was created
 #endif
   JSFF_STORAGEFILE = 64,  ///< This file is a 'storage file' created by Storage.open
-  JSFF_COMPRESSED = 128   ///< This file contains compressed data (used only for .varimg currently)
+  JSFF_COMPRESSED = 128   ///< This file contains compressed data (.varimg, or a file written with jsfWriteCompressedFile)
 } JsfFileFlags; // these are stored in the top 8 bits of JsfFileHeader.size
 
 
@@ -78,6 +90,10 @@ JsVar* jsvAddressToVar(size_t addr, uint32_t length);
 JsVar *jsfReadFile(JsfFileName name, int offset, int length);
 /// Write a file. For simple stuff just leave offset and size as 0
 bool jsfWriteFile(JsfFileName name, JsVar *data, JsfFileFlags flags, JsVarInt offset, JsVarInt _size);
+#ifdef ESPR_STORAGE_COMPRESSION
+/// Write a file heatshrink compressed (prefixed with the uncompressed length) - jsfReadFile decompresses it
+bool jsfWriteCompressedFile(JsfFileName name, JsVar *data);
+#endif
 /// Erase the given file, return true on success
 bool jsfEraseFile(JsfFileName name);
 /// Erase the entire contents of the memory store
@@ -158,4 +174,18 @@ void jsfResetStorage();
 void jsfCreateFileTable();
 #endif
 
+#ifdef ESPR_STORAGE_WEAR_LEVEL
+/// Get the average amount of times a page has been erased, in the least and most erased areas of Storage
+void jsfGetWearStats(uint32_t *minCount, uint32_t *maxCount);
+#endif
+
+#ifdef ESPR_STORAGE_BACKGROUND_COMPACT
+/// Returns true if Storage may need compacting in the background - see jsfCompactStep
+bool jsfCompactIsPending();
+/// Do one short step of compacting Storage in the background (called from jsiIdle when jsfCompactIsPending)
+void jsfCompactStep();
+/// Finish any step of background compaction that was interrupted by a reset (called at boot before Storage is used)
+void jsfCompactRecover();
+#endif
+
 #endif //JSFLASH_H_
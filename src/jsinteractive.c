@@ -121,6 +121,7 @@ Pin pinSleepIndicator = DEFAULT_SLEEP_PIN_INDICATOR;
 #endif
 JsiStatus jsiStatus = 0;
 JsSysTime jsiLastIdleTime;  ///< The last time we went around the idle loop - use this for timers
+JsSysTime jsiTimerBase; ///< Timers' 'time' fields are relative to this, so they don't need updating as time passes
 #ifndef EMBEDDED
 uint32_t jsiTimeSinceCtrlC; ///< When was Ctrl-C last pressed. We use this so we quit on desktop when we do Ctrl-C + Ctrl-C
 #endif
@@ -144,6 +145,7 @@ void jsiDebuggerLine(JsVar *line);
 
 static void jsiPacketFileEnd();
 static void jsiPacketExit();
+static void jsiEventQueueClear();
 // ----------------------------------------------------------------------------
 
 /**
@@ -492,6 +494,141 @@ void jsiSetSleep(JsiSleepType isSleep) {
 #endif
 }
 
+/* As well as being in timerArray (so they can be saved and dumped), timers
+ * are kept in a native min-heap ordered by their 'time', so jsiIdle can find
+ * the next timer to run without looking at (or allocating for) every timer.
+ * Each entry holds a lock on the timer's name in timerArray - if that name's
+ * refs drop to 0 it has been removed. The heap starts off in a static array
+ * of ESPR_TIMER_HEAP_SIZE entries, and if there are more timers than that it
+ * is moved into a flat string twice the size (kept locked so it doesn't move).
+ * Only if we can't allocate that do we set jsiTimerHeapOverflow, and then
+ * jsiIdle checks every timer (in no particular order) until it can rebuild
+ * the heap. */
+typedef struct {
+  JsSysTime time; ///< The timer's 'time' field
+  JsVarRef name;  ///< The timer's name in timerArray (locked)
+} JsiTimerHeapEntry;
+
+static JsiTimerHeapEntry jsiTimerHeapStatic[ESPR_TIMER_HEAP_SIZE];
+static JsiTimerHeapEntry *jsiTimerHeap = jsiTimerHeapStatic;
+static JsVar *jsiTimerHeapVar = 0; ///< Flat string that jsiTimerHeap is in, if it outgrew jsiTimerHeapStatic
+static unsigned int jsiTimerHeapSize = ESPR_TIMER_HEAP_SIZE; ///< How many entries jsiTimerHeap can hold
+static unsigned int jsiTimerHeapCount = 0;
+static bool jsiTimerHeapOverflow = false;
+
+static JsSysTime jsiTimerGetTime(JsVar *timerPtr) {
+  return (JsSysTime)jsvGetLongIntegerAndUnLock(jsvObjectGetChildIfExists(timerPtr, "time"));
+}
+
+static void jsiTimerHeapSwap(unsigned int a, unsigned int b) {
+  JsiTimerHeapEntry t = jsiTimerHeap[a];
+  jsiTimerHeap[a] = jsiTimerHeap[b];
+  jsiTimerHeap[b] = t;
+}
+
+static void jsiTimerHeapSiftUp(unsigned int i) {
+  while (i>0) {
+    unsigned int parent = (i-1)>>1;
+    if (jsiTimerHeap[parent].time <= jsiTimerHeap[i].time) break;
+    jsiTimerHeapSwap(i, parent);
+    i = parent;
+  }
+}
+
+static void jsiTimerHeapSiftDown(unsigned int i) {
+  while (true) {
+    unsigned int smallest = i;
+    unsigned int l = i*2+1, r = l+1;
+    if (l<jsiTimerHeapCount && jsiTimerHeap[l].time < jsiTimerHeap[smallest].time) smallest = l;
+    if (r<jsiTimerHeapCount && jsiTimerHeap[r].time < jsiTimerHeap[smallest].time) smallest = r;
+    if (smallest==i) break;
+    jsiTimerHeapSwap(i, smallest);
+    i = smallest;
+  }
+}
+
+/// Remove entry i from the heap, releasing its lock
+static void jsiTimerHeapRemoveAt(unsigned int i) {
+  jsvUnLock(_jsvGetAddressOf(jsiTimerHeap[i].name));
+  jsiTimerHeapCount--;
+  if (i<jsiTimerHeapCount) {
+    jsiTimerHeap[i] = jsiTimerHeap[jsiTimerHeapCount];
+    jsiTimerHeapSiftDown(i);
+    jsiTimerHeapSiftUp(i);
+  }
+}
+
+static void jsiTimerHeapClear() {
+  while (jsiTimerHeapCount)
+    jsvUnLock(_jsvGetAddressOf(jsiTimerHeap[--jsiTimerHeapCount].name));
+  jsiTimerHeapOverflow = false;
+}
+
+/// Clear the heap and go back to using jsiTimerHeapStatic
+static void jsiTimerHeapFree() {
+  jsiTimerHeapClear();
+  jsiTimerHeap = jsiTimerHeapStatic;
+  jsiTimerHeapSize = ESPR_TIMER_HEAP_SIZE;
+  jsvUnLock(jsiTimerHeapVar);
+  jsiTimerHeapVar = 0;
+}
+
+/// Move the heap somewhere twice the size - return false if there wasn't the memory
+static bool jsiTimerHeapGrow() {
+  unsigned int size = jsiTimerHeapSize*2;
+  JsVar *heapVar = jsvNewFlatStringOfLength(size*(unsigned int)sizeof(JsiTimerHeapEntry));
+  if (!heapVar) return false;
+  JsiTimerHeapEntry *heap = (JsiTimerHeapEntry*)jsvGetFlatStringPointer(heapVar);
+  memcpy(heap, jsiTimerHeap, jsiTimerHeapCount*sizeof(JsiTimerHeapEntry));
+  jsvUnLock(jsiTimerHeapVar);
+  jsiTimerHeapVar = heapVar; // keep it locked
+  jsiTimerHeap = heap;
+  jsiTimerHeapSize = size;
+  return true;
+}
+
+/// Add a timer (given its name in timerArray) to the heap
+static void jsiTimerHeapPush(JsVar *timerName, JsSysTime time) {
+  if (jsiTimerHeapOverflow) return; // we're checking every timer anyway
+  if (jsiTimerHeapCount >= jsiTimerHeapSize && !jsiTimerHeapGrow()) {
+    jsiTimerHeapClear();
+    jsiTimerHeapOverflow = true;
+    return;
+  }
+  jsiTimerHeap[jsiTimerHeapCount].time = time;
+  jsiTimerHeap[jsiTimerHeapCount].name = jsvGetRef(jsvLockAgain(timerName));
+  jsiTimerHeapSiftUp(jsiTimerHeapCount++);
+}
+
+/// Find the heap index of the given timer object, or -1
+static int jsiTimerHeapFind(JsVar *timerPtr) {
+  JsVarRef ref = jsvGetRef(timerPtr);
+  for (unsigned int i=0;i<jsiTimerHeapCount;i++)
+    if (jsvGetFirstChild(_jsvGetAddressOf(jsiTimerHeap[i].name)) == ref)
+      return (int)i;
+  return -1;
+}
+
+void jsiTimersRebuild() {
+  jsiTimerHeapClear();
+  if (!timerArray) return;
+  JsvObjectIterator it;
+  jsvObjectIteratorNew(&it, timerArray);
+  while (jsvObjectIteratorHasValue(&it) && !jsiTimerHeapOverflow) {
+    JsVar *timerName = jsvObjectIteratorGetKey(&it);
+    JsVar *timerPtr = jsvSkipName(timerName);
+    jsiTimerHeapPush(timerName, jsiTimerGetTime(timerPtr));
+    jsvUnLock2(timerPtr, timerName);
+    jsvObjectIteratorNext(&it);
+  }
+  jsvObjectIteratorFree(&it);
+}
+
+void jsiSetLastIdleTime(JsSysTime time) {
+  jsiTimerBase += time - jsiLastIdleTime;
+  jsiLastIdleTime = time;
+}
+
 // Used when recovering after being flashed
 // 'claim' anything we are using
 void jsiSoftInit(bool hasBeenReset) {
@@ -516,6 +653,9 @@ void jsiSoftInit(bool hasBeenReset) {
   // Make sure we set up lastIdleTime, as this could be used
   // when adding an interval from onInit (called below)
   jsiLastIdleTime = jshGetSystemTime();
+  // saved timers' times are relative to the last idle time
+  jsiTimerBase = jsiLastIdleTime;
+  jsiTimersRebuild();
 #ifndef EMBEDDED
   jsiTimeSinceCtrlC = 0xFFFFFFFF;
 #endif
@@ -796,11 +936,27 @@ void jsiSoftKill() {
   // Stop all active timer tasks
   jstReset();
   // Unref Watches/etc
+  jsiEventQueueClear();
   if (events) {
     jsvUnLock(events);
     events=0;
   }
+  jsiTimerHeapFree();
   if (timerArray) {
+    // Make timers' times relative to the last idle time again, for saving
+    JsSysTime offset = jsiLastIdleTime - jsiTimerBase;
+    if (offset) {
+      JsvObjectIterator it;
+      jsvObjectIteratorNew(&it, timerArray);
+      while (jsvObjectIteratorHasValue(&it)) {
+        JsVar *timerPtr = jsvObjectIteratorGetValue(&it);
+        jsvObjectSetChildAndUnLock(timerPtr, "time", jsvNewFromLongInteger(jsiTimerGetTime(timerPtr) - offset));
+        jsvUnLock(timerPtr);
+        jsvObjectIteratorNext(&it);
+      }
+      jsvObjectIteratorFree(&it);
+    }
+    jsiTimerBase = jsiLastIdleTime;
     jsvUnLock(timerArray);
     timerArray=0;
   }
@@ -862,6 +1018,9 @@ void jsiSemiInit(bool autoLoad, JsfFileName *loadedFilename) {
 #if !defined(EMSCRIPTEN) && !defined(SAVE_ON_FLASH)
   bool fullTest = jsiStatus & JSIS_FIRST_BOOT;
   if (fullTest) {
+#ifdef ESPR_STORAGE_BACKGROUND_COMPACT
+    jsfCompactRecover(); // finish compacting if we reset part way through
+#endif
 #ifdef BANGLEJS
     jsiConsolePrintf("Checking storage...\n");
 #endif
@@ -2058,9 +2217,86 @@ static void jsiHandleConsoleChar(char ch) {
   }
 }
 
+/* Events are queued in a native ring buffer of locked references where we
+ * can, so we don't allocate an object and args array for each one. If the
+ * ring is full, there are too many arguments or a var already has a lot of
+ * locks we fall back to the 'events' array, and keep using it until it's
+ * empty so that events still execute in the order they were queued. */
+#define JSI_EVENT_MAX_ARGS 3
+#define JSI_EVENT_MAX_LOCKS 8 ///< Don't queue in the ring if it'd take a var past this many locks
+typedef struct {
+  JsVarRef func;
+  JsVarRef thisVar;
+  JsVarRef args[JSI_EVENT_MAX_ARGS];
+  unsigned char argCount;
+} JsiQueuedEvent;
+
+static JsiQueuedEvent jsiEventQueue[ESPR_EVENT_QUEUE_SIZE];
+static unsigned int jsiEventQueueHead = 0; ///< Index of the next event to execute
+static unsigned int jsiEventQueueCount = 0;
+
+static bool jsiEventQueueCanLock(JsVar *var) {
+  return !var || jsvGetLocks(var)<JSI_EVENT_MAX_LOCKS;
+}
+
+static JsVarRef jsiEventQueueLock(JsVar *var) {
+  return var ? jsvGetRef(jsvLockAgain(var)) : 0;
+}
+
+/// Get a pointer to a var locked by the event queue (the lock now belongs to the caller)
+static JsVar *jsiEventQueueGet(JsVarRef ref) {
+  return ref ? _jsvGetAddressOf(ref) : 0;
+}
+
+/// Pop the next event from the ring buffer and execute it
+static void jsiEventQueueExecuteNext() {
+  JsiQueuedEvent *event = &jsiEventQueue[jsiEventQueueHead];
+  JsVar *func = jsiEventQueueGet(event->func);
+  JsVar *thisVar = jsiEventQueueGet(event->thisVar);
+  unsigned int argCount = event->argCount;
+  JsVar *args[JSI_EVENT_MAX_ARGS];
+  for (unsigned int i=0;i<argCount;i++)
+    args[i] = jsiEventQueueGet(event->args[i]);
+  // remove it before executing, as the callback may queue more events
+  jsiEventQueueHead = (jsiEventQueueHead+1) % ESPR_EVENT_QUEUE_SIZE;
+  jsiEventQueueCount--;
+  jsiExecuteEventCallback(thisVar, func, argCount, args);
+  jsvUnLockMany(argCount, args);
+  jsvUnLock2(func, thisVar);
+}
+
+/// Remove all events from the ring buffer without executing them
+static void jsiEventQueueClear() {
+  while (jsiEventQueueCount) {
+    JsiQueuedEvent *event = &jsiEventQueue[jsiEventQueueHead];
+    jsvUnLock2(jsiEventQueueGet(event->func), jsiEventQueueGet(event->thisVar));
+    for (unsigned int i=0;i<event->argCount;i++)
+      jsvUnLock(jsiEventQueueGet(event->args[i]));
+    jsiEventQueueHead = (jsiEventQueueHead+1) % ESPR_EVENT_QUEUE_SIZE;
+    jsiEventQueueCount--;
+  }
+  jsiEventQueueHead = 0;
+}
+
 /// Queue a function, string, or array (of funcs/strings) to be executed next time around the idle loop
 void jsiQueueEvents(JsVar *object, JsVar *callback, JsVar **args, int argCount) { // an array of functions, a string, or a single function
   assert(argCount<10);
+  if (jsiEventQueueCount<ESPR_EVENT_QUEUE_SIZE && argCount<=JSI_EVENT_MAX_ARGS &&
+      (!events || jsvArrayIsEmpty(events))) {
+    bool canLock = jsiEventQueueCanLock(callback) && jsiEventQueueCanLock(object);
+    for (int i=0;i<argCount;i++)
+      canLock = canLock && jsiEventQueueCanLock(args[i]);
+    if (canLock) {
+      JsiQueuedEvent *event = &jsiEventQueue[(jsiEventQueueHead+jsiEventQueueCount) % ESPR_EVENT_QUEUE_SIZE];
+      event->func = jsiEventQueueLock(callback);
+      event->thisVar = jsiEventQueueLock(object);
+      event->argCount = (unsigned char)argCount;
+      for (int i=0;i<argCount;i++)
+        event->args[i] = jsiEventQueueLock(args[i]);
+      jsiEventQueueCount++;
+      return;
+    }
+  }
   JsVar *event = jsvNewObject();
   if (event) { // Could be out of memory error!
     jsvUnLock(jsvAddNamedChild(event, callback, "func"));
@@ -2089,9 +2325,14 @@ void jsiQueueObjectCallbacks(JsVar *object, const char *callbackName, JsVar **ar
 }
 
 void jsiExecuteEvents() {
-  bool hasEvents = !jsvArrayIsEmpty(events);
+  bool hasEvents = jsiEventQueueCount || !jsvArrayIsEmpty(events);
   if (hasEvents) jsiSetBusy(BUSY_INTERACTIVE, true);
-  while (!jsvArrayIsEmpty(events)) {
+  while (jsiEventQueueCount || !jsvArrayIsEmpty(events)) {
+    // anything in the ring buffer was queued before anything in 'events'
+    if (jsiEventQueueCount) {
+      jsiEventQueueExecuteNext();
+      continue;
+    }
     JsVar *event = jsvSkipNameAndUnLock(jsvArrayPopFirst(events));
     // Get function to execute
     JsVar *func = jsvObjectGetChildIfExists(event, "func");
@@ -2260,6 +2501,88 @@ void jsiHandleIOEventForConsole(uint8_t *eventData, int eventLen) {
   jsiSetBusy(BUSY_INTERACTIVE, false);
 }
 
+/** Execute a timer that is due. Returns true if it should be kept (it's an
+ * interval), in which case timerTime is updated to when it should next run */
+static bool jsiExecuteTimer(JsVar *timerPtr, JsSysTime *timerTime) {
+  JsVar *timerCallback = jsvObjectGetChildIfExists(timerPtr, "cb");
+  JsVar *watchPtr = jsvObjectGetChildIfExists(timerPtr, "watch"); // for debounce - may be undefined
+  bool exec = true;
+  JsVar *data = 0;
+  if (watchPtr) {
+    bool watchState = jsvObjectGetBoolChild(watchPtr, "state");
+    bool timerState = jsvObjectGetBoolChild(timerPtr, "state");
+    jsvObjectSetBoolChild(watchPtr, "state", timerState);
+    exec = false;
+    if (watchState!=timerState) {
+      // Create the 'time' variable that will be passed to the user and stored as last time
+      JsVarInt delay = jsvObjectGetIntegerChild(watchPtr, "debounce");
+      JsVar *timePtr = jsvNewFromFloat(jshGetMillisecondsFromTime(jsiTimerBase+*timerTime-delay)/1000);
+      // If it's the right edge...
+      if (jsiShouldExecuteWatch(watchPtr, timerState)) {
+        data = jsvNewObject();
+        // if we were from a watch then we were delayed by the debounce time...
+        if (data) {
+          exec = true;
+          // if it was a watch, set the last state up
+          jsvObjectSetBoolChild(data, "state", timerState);
+          // set up the lastTime variable of data to what was in the watch
+          jsvObjectSetChildAndUnLock(data, "lastTime", jsvObjectGetChildIfExists(watchPtr, "lastTime"));
+          // set up the watches lastTime to this one
+          jsvObjectSetChild(data, "time", timePtr); // don't unlock - use this later
+          jsvObjectSetChildAndUnLock(data, "pin", jsvObjectGetChildIfExists(watchPtr, "pin"));
+        }
+      }
+      // Update lastTime regardless of which edge we're watching
+      jsvObjectSetChildAndUnLock(watchPtr, "lastTime", timePtr);
+    }
+  }
+  bool removeTimer = false;
+  if (exec) {
+    bool execResult;
+    if (data) {
+      execResult = jsiExecuteEventCallback(0, timerCallback, 1, &data);
+    } else {
+      JsVar *argsArray = jsvObjectGetChildIfExists(timerPtr, "args");
+      execResult = jsiExecuteEventCallbackArgsArray(0, timerCallback, argsArray);
+      jsvUnLock(argsArray);
+    }
+    if (!execResult) {
+      JsVar *interval = jsvObjectGetChildIfExists(timerPtr, "intr");
+      if (interval) { // if interval then it's setInterval not setTimeout
+        jsvUnLock(interval);
+        jsError("Ctrl-C while processing interval - removing it.");
+        jsErrorFlags |= JSERR_CALLBACK;
+        removeTimer = true;
+      }
+    }
+  }
+  jsvUnLock(data);
+  if (watchPtr) { // if we had a watch pointer, be sure to remove us from it
+    jsvObjectRemoveChild(watchPtr, "timeout");
+    // Deal with non-recurring watches
+    if (exec) {
+      bool watchRecurring = jsvObjectGetBoolChild(watchPtr,  "recur");
+      if (!watchRecurring) {
+        JsVar *watchNamePtr = jsvGetIndexOf(watchArray, watchPtr, true);
+        if (watchNamePtr) {
+          jsvRemoveChildAndUnLock(watchArray, watchNamePtr);
+        }
+        Pin pin = jshGetPinFromVarAndUnLock(jsvObjectGetChildIfExists(watchPtr, "pin"));
+        if (!jsiIsWatchingPin(pin))
+          jshPinWatch(pin, false, JSPW_NONE);
+      }
+    }
+    jsvUnLock(watchPtr);
+  }
+  // Load interval *after* executing code, in case it has changed
+  JsVar *interval = jsvObjectGetChildIfExists(timerPtr, "intr");
+  bool keepTimer = !removeTimer && interval;
+  if (keepTimer)
+    *timerTime = *timerTime + jsvGetLongInteger(interval);
+  jsvUnLock2(timerCallback,interval);
+  return keepTimer;
+}
+
 void jsiIdle() {
   // This is how many times we have been here and not done anything.
   // It will be zeroed if we do stuff later
@@ -2381,8 +2704,9 @@ void jsiIdle() {
             bool oldWatchState = jsvObjectGetBoolChild(watchPtr, "state");
             JsVar *timeout = jsvObjectGetChildIfExists(watchPtr, "timeout");
             if (timeout) { // if we had a timeout, update the callback time
-              JsSysTime timeoutTime = jsiLastIdleTime + (JsSysTime)jsvGetLongIntegerAndUnLock(jsvObjectGetChildIfExists(timeout, "time"));
-              jsvUnLock(jsvObjectSetChild(timeout, "time", jsvNewFromLongInteger((JsSysTime)(eventTime - jsiLastIdleTime) + debounce)));
+              JsSysTime timeoutTime = jsiTimerBase + jsiTimerGetTime(timeout);
+              jsvUnLock(jsvObjectSetChild(timeout, "time", jsvNewFromLongInteger((JsSysTime)(eventTime - jsiTimerBase) + debounce)));
+              jsiTimerUpdated(timeout);
               jsvObjectSetBoolChild(timeout, "state", pinIsHigh);
               if (ignoreEvent || ((eventTime > timeoutTime) && (pinIsHigh!=oldWatchState))) {
                 // timeout should have fired, but we didn't get around to executing it!
@@ -2398,7 +2722,7 @@ void jsiIdle() {
               timeout = jsvNewObject();
               if (timeout) {
                 jsvObjectSetChild(timeout, "watch", watchPtr); // no unlock
-                jsvObjectSetChildAndUnLock(timeout, "time", jsvNewFromLongInteger((JsSysTime)(eventTime - jsiLastIdleTime) + debounce));
+                jsvObjectSetChildAndUnLock(timeout, "time", jsvNewFromLongInteger((JsSysTime)(eventTime - jsiTimerBase) + debounce));
                 jsvObjectSetChildAndUnLock(timeout, "cb", jsvObjectGetChildIfExists(watchPtr, "cb"));
                 jsvObjectSetChildAndUnLock(timeout, "lastTime", jsvObjectGetChildIfExists(watchPtr, "lastTime"));
                 jsvObjectSetPinChild(timeout, "pin", pin);
@@ -2466,134 +2790,91 @@ void jsiIdle() {
   // Check timers
   JsSysTime minTimeUntilNext = JSSYSTIME_MAX;
   JsSysTime time = jshGetSystemTime();
-  JsSysTime timePassed = time - jsiLastIdleTime;
-  jsiLastIdleTime = time;
 #ifndef EMBEDDED
   // add time to Ctrl-C counter, checking for overflow
   uint32_t oldTimeSinceCtrlC = jsiTimeSinceCtrlC;
-  jsiTimeSinceCtrlC += (uint32_t)timePassed;
+  jsiTimeSinceCtrlC += (uint32_t)(time - jsiLastIdleTime);
   if (oldTimeSinceCtrlC > jsiTimeSinceCtrlC)
     jsiTimeSinceCtrlC = 0xFFFFFFFF;
 #endif
+  jsiLastIdleTime = time;
 
-  JsvObjectIterator it;
-  // Go through all intervals and decrement time
-  jsvObjectIteratorNew(&it, timerArray);
-  while (jsvObjectIteratorHasValue(&it)) {
-    JsVar *timerPtr = jsvObjectIteratorGetValue(&it);
-    JsSysTime timerTime = (JsSysTime)jsvGetLongIntegerAndUnLock(jsvObjectGetChildIfExists(timerPtr, "time"));
-    JsSysTime timeUntilNext = timerTime - timePassed;
-    jsvObjectSetChildAndUnLock(timerPtr, "time", jsvNewFromLongInteger(timeUntilNext));
-    jsvUnLock(timerPtr);
-    jsvObjectIteratorNext(&it);
+  // Timers' times are relative to jsiTimerBase, so we only need to look at those that are due
+  JsSysTime timeNow = jsiLastIdleTime - jsiTimerBase;
+  jsiStatus = jsiStatus & ~JSIS_TIMERS_CHANGED;
+  if (!jsiTimerHeapOverflow) {
+    /* Run timers in order from the heap. Only run as many as there were to
+     * begin with so an interval that is behind can't hog this idle pass */
+    unsigned int timersLeft = jsiTimerHeapCount;
+    while (timersLeft-- && jsiTimerHeapCount && jsiTimerHeap[0].time<=timeNow && !jsiTimerHeapOverflow) {
+      JsSysTime timerTime = jsiTimerHeap[0].time;
+      JsVar *timerName = jsvLock(jsiTimerHeap[0].name);
+      jsiTimerHeapRemoveAt(0);
+      JsVar *timerPtr = jsvSkipName(timerName);
+      // skip if it was removed or rescheduled since it was added
+      if (!jsvGetRefs(timerName) || jsiTimerGetTime(timerPtr)!=timerTime) {
+        jsvUnLock2(timerPtr, timerName);
+        continue;
+      }
+      // we're now doing work
+      jsiSetBusy(BUSY_INTERACTIVE, true);
+      wasBusy = true;
+      bool keepTimer = jsiExecuteTimer(timerPtr, &timerTime);
+      // Beware... may have already been removed!
+      if (jsvGetRefs(timerName)) {
+        if (keepTimer) {
+          jsvObjectSetChildAndUnLock(timerPtr, "time", jsvNewFromLongInteger(timerTime));
+          jsiTimerHeapPush(timerName, timerTime);
+        } else
+          jsvRemoveChild(timerArray, timerName);
+      }
+      jsvUnLock2(timerPtr, timerName);
+    }
+    if (jsiTimerHeapCount && !jsiTimerHeapOverflow) {
+      minTimeUntilNext = jsiTimerHeap[0].time - timeNow;
+      if (minTimeUntilNext<0) minTimeUntilNext = 0;
+    }
   }
-  jsvObjectIteratorFree(&it);
-  // Now go through intervals and execute if needed
-  do {
-    jsiStatus = jsiStatus & ~JSIS_TIMERS_CHANGED;
-    jsvObjectIteratorNew(&it, timerArray);
-    while (jsvObjectIteratorHasValue(&it) && !(jsiStatus & JSIS_TIMERS_CHANGED)) {
-      bool hasDeletedTimer = false;
-      JsVar *timerPtr = jsvObjectIteratorGetValue(&it);
-      JsSysTime timerTime = (JsSysTime)jsvGetLongIntegerAndUnLock(jsvObjectGetChildIfExists(timerPtr, "time"));
-      if (timerTime<=0) {
-        // we're now doing work
-        jsiSetBusy(BUSY_INTERACTIVE, true);
-        wasBusy = true;
-        JsVar *timerCallback = jsvObjectGetChildIfExists(timerPtr, "cb");
-        JsVar *watchPtr = jsvObjectGetChildIfExists(timerPtr, "watch"); // for debounce - may be undefined
-        bool exec = true;
-        JsVar *data = 0;
-        if (watchPtr) {
-          bool watchState = jsvObjectGetBoolChild(watchPtr, "state");
-          bool timerState = jsvObjectGetBoolChild(timerPtr, "state");
-          jsvObjectSetBoolChild(watchPtr, "state", timerState);
-          exec = false;
-          if (watchState!=timerState) {
-            // Create the 'time' variable that will be passed to the user and stored as last time
-            JsVarInt delay = jsvObjectGetIntegerChild(watchPtr, "debounce");
-            JsVar *timePtr = jsvNewFromFloat(jshGetMillisecondsFromTime(jsiLastIdleTime+timerTime-delay)/1000);
-            // If it's the right edge...
-            if (jsiShouldExecuteWatch(watchPtr, timerState)) {
-              data = jsvNewObject();
-              // if we were from a watch then we were delayed by the debounce time...
-              if (data) {
-                exec = true;
-                // if it was a watch, set the last state up
-                jsvObjectSetBoolChild(data, "state", timerState);
-                // set up the lastTime variable of data to what was in the watch
-                jsvObjectSetChildAndUnLock(data, "lastTime", jsvObjectGetChildIfExists(watchPtr, "lastTime"));
-                // set up the watches lastTime to this one
-                jsvObjectSetChild(data, "time", timePtr); // don't unlock - use this later
-                jsvObjectSetChildAndUnLock(data, "pin", jsvObjectGetChildIfExists(watchPtr, "pin"));
-              }
-            }
-            // Update lastTime regardless of which edge we're watching
-            jsvObjectSetChildAndUnLock(watchPtr, "lastTime", timePtr);
-          }
-        }
-        bool removeTimer = false;
-        if (exec) {
-          bool execResult;
-          if (data) {
-            execResult = jsiExecuteEventCallback(0, timerCallback, 1, &data);
+  if (jsiTimerHeapOverflow) {
+    // Too many timers for the heap - go through all of them and execute if needed
+    unsigned int timerCount;
+    JsvObjectIterator it;
+    do {
+      jsiStatus = jsiStatus & ~JSIS_TIMERS_CHANGED;
+      timerCount = 0;
+      jsvObjectIteratorNew(&it, timerArray);
+      while (jsvObjectIteratorHasValue(&it) && !(jsiStatus & JSIS_TIMERS_CHANGED)) {
+        bool hasDeletedTimer = false;
+        JsVar *timerPtr = jsvObjectIteratorGetValue(&it);
+        JsSysTime timerTime = jsiTimerGetTime(timerPtr);
+        if (timerTime<=timeNow) {
+          // we're now doing work
+          jsiSetBusy(BUSY_INTERACTIVE, true);
+          wasBusy = true;
+          if (jsiExecuteTimer(timerPtr, &timerTime)) {
+            jsvObjectSetChildAndUnLock(timerPtr, "time", jsvNewFromLongInteger(timerTime));
           } else {
-            JsVar *argsArray = jsvObjectGetChildIfExists(timerPtr, "args");
-            execResult = jsiExecuteEventCallbackArgsArray(0, timerCallback, argsArray);
-            jsvUnLock(argsArray);
-          }
-          if (!execResult) {
-            JsVar *interval = jsvObjectGetChildIfExists(timerPtr, "intr");
-            if (interval) { // if interval then it's setInterval not setTimeout
-              jsvUnLock(interval);
-              jsError("Ctrl-C while processing interval - removing it.");
-              jsErrorFlags |= JSERR_CALLBACK;
-              removeTimer = true;
-            }
-          }
-        }
-        jsvUnLock(data);
-        if (watchPtr) { // if we had a watch pointer, be sure to remove us from it
-          jsvObjectRemoveChild(watchPtr, "timeout");
-          // Deal with non-recurring watches
-          if (exec) {
-            bool watchRecurring = jsvObjectGetBoolChild(watchPtr,  "recur");
-            if (!watchRecurring) {
-              JsVar *watchNamePtr = jsvGetIndexOf(watchArray, watchPtr, true);
-              if (watchNamePtr) {
-                jsvRemoveChildAndUnLock(watchArray, watchNamePtr);
-              }
-              Pin pin = jshGetPinFromVarAndUnLock(jsvObjectGetChildIfExists(watchPtr, "pin"));
-              if (!jsiIsWatchingPin(pin))
-                jshPinWatch(pin, false, JSPW_NONE);
-            }
+            // free
+            // Beware... may have already been removed!
+            jsvObjectIteratorRemoveAndGotoNext(&it, timerArray);
+            hasDeletedTimer = true;
           }
-          jsvUnLock(watchPtr);
         }
-        // Load interval *after* executing code, in case it has changed
-        JsVar *interval = jsvObjectGetChildIfExists(timerPtr, "intr");
-        if (!removeTimer && interval) {
-          timerTime = timerTime + jsvGetLongInteger(interval);
-          jsvObjectSetChildAndUnLock(timerPtr, "time", jsvNewFromLongInteger(timerTime));
-        } else {
-          // free
-          // Beware... may have already been removed!
-          jsvObjectIteratorRemoveAndGotoNext(&it, timerArray);
-          hasDeletedTimer = true;
-          timerTime = -1;
+        if (!hasDeletedTimer) {
+          // update the time until the next timer
+          if (timerTime>=timeNow && timerTime-timeNow < minTimeUntilNext)
+            minTimeUntilNext = timerTime-timeNow;
+          timerCount++;
+          jsvObjectIteratorNext(&it);
         }
-        jsvUnLock2(timerCallback,interval);
+        jsvUnLock(timerPtr);
       }
-      // update the time until the next timer
-      if (timerTime>=0 && timerTime < minTimeUntilNext)
-        minTimeUntilNext = timerTime;
-      // update the timer's time
-      if (!hasDeletedTimer)
-        jsvObjectIteratorNext(&it);
-      jsvUnLock(timerPtr);
-    }
-    jsvObjectIteratorFree(&it);
-  } while (jsiStatus & JSIS_TIMERS_CHANGED);
+      jsvObjectIteratorFree(&it);
+    } while (jsiStatus & JSIS_TIMERS_CHANGED);
+    // If there are few enough timers now, go back to using the heap
+    if (timerCount <= jsiTimerHeapSize)
+      jsiTimersRebuild();
+  }
   /* We might have left the timers loop with stuff to do because the contents of it
    * changed. It's not a big deal because it could only have changed because a timer
    * got executed - so `wasBusy` got set and we know we're going to go around the
@@ -2604,7 +2885,7 @@ void jsiIdle() {
   if (jswIdle()) wasBusy = true;
 
   // Just in case we got any events to do and didn't clear loopsIdling before
-  if (wasBusy || !jsvArrayIsEmpty(events) )
+  if (wasBusy || jsiEventQueueCount || !jsvArrayIsEmpty(events) )
     loopsIdling = 0;
 
   if (wasBusy)
@@ -2674,6 +2955,20 @@ void jsiIdle() {
   if (jsiStatus & JSIS_WATCHDOG_AUTO)
     jshKickWatchDog();
 
+#ifndef ESPR_NO_INCREMENTAL_GC
+  /* If incremental GC is enabled, rather than doing a whole Garbage Collection
+   * when we have 10ms spare, do a short slice of it whenever we can */
+  if (jsvGarbageCollectGetBudget()) {
+    if ((jsvGarbageCollectInProgress() ||
+         (loopsIdling==1 && !jsvMoreFreeVariablesThan(JS_VARS_BEFORE_IDLE_GC))) &&
+        minTimeUntilNext > jshGetTimeFromMilliseconds(jsvGarbageCollectGetBudget())) {
+      jsiSetBusy(BUSY_INTERACTIVE, true);
+      jsvGarbageCollectSlice();
+      jsiSetBusy(BUSY_INTERACTIVE, false);
+      return; // go around the idle loop again to check for events
+    }
+  } else
+#endif
   /* if we've been around this loop, there is nothing to do, and
    * we have a spare 10ms then let's do some Garbage Collection
    * if we think we need to */
@@ -2689,6 +2984,19 @@ void jsiIdle() {
     return;
   }
 
+#ifdef ESPR_STORAGE_BACKGROUND_COMPACT
+  /* If Storage is low on space, compact it a step at a time when we have
+   * a spare 10ms, rather than all at once when it finally fills up */
+  if (loopsIdling>=1 &&
+      jsfCompactIsPending() &&
+      minTimeUntilNext > jshGetTimeFromMilliseconds(10)) {
+    jsiSetBusy(BUSY_INTERACTIVE, true);
+    jsfCompactStep();
+    jsiSetBusy(BUSY_INTERACTIVE, false);
+    return; // go around the idle loop again to check for events
+  }
+#endif
+
   // Go to sleep!
   if (loopsIdling>=1 && // once around the idle loop without having done any work already (just in case)
 #if defined(USB) && !defined(EMSCRIPTEN)
@@ -2773,7 +3081,7 @@ void jsiDumpState(vcbprintf_callback user_callback, void *user_data) {
     } else if (!jsvIsNativeFunction(data)) { // just a variable/function!
       if (jsvIsFunction(data)) {
         // function-specific output
-        cbprintf(user_callback, user_data, "function %v", child);
+        cbprintf(user_callback, user_data, "%s %v", jsfGetFunctionKeyword(data), child);
         jsfGetJSONForFunctionWithCallback(data, JSON_SHOW_DEVICES, user_callback, user_data);
         user_callback("\n", user_data);
         // print any prototypes we had
@@ -2812,7 +3120,7 @@ void jsiDumpState(vcbprintf_callback user_callback, void *user_data) {
     JsVar *timerInterval = jsvObjectGetChildIfExists(timer, "intr");
     user_callback(timerInterval ? "setInterval(" : "setTimeout(", user_data);
     jsiDumpJSON(user_callback, user_data, timerCallback, 0);
-    cbprintf(user_callback, user_data, ", %f); // %v\n", jshGetMillisecondsFromTime(timerInterval ? jsvGetLongInteger(timerInterval) : jsvGetLongIntegerAndUnLock(jsvObjectGetChildIfExists(timer, "time"))), timerNumber);
+    cbprintf(user_callback, user_data, ", %f); // %v\n", jshGetMillisecondsFromTime(timerInterval ? jsvGetLongInteger(timerInterval) : (jsiTimerGetTime(timer) + jsiTimerBase - jsiLastIdleTime)), timerNumber);
     jsvUnLock3(timerInterval, timerCallback, timerNumber);
     // next
     jsvUnLock(timer);
@@ -2856,7 +3164,31 @@ void jsiDumpState(vcbprintf_callback user_callback, void *user_data) {
 }
 
 JsVarInt jsiTimerAdd(JsVar *timerPtr) {
-  return jsvArrayAddToEnd(timerArray, timerPtr, 1) - 1;
+  JsVarInt idx = jsvArrayAddToEnd(timerArray, timerPtr, 1) - 1;
+  // the timer's name is the last item in the array
+  JsVar *timerName = jsvLockSafe(jsvGetLastChild(timerArray));
+  if (timerName && jsvGetFirstChild(timerName)==jsvGetRef(timerPtr))
+    jsiTimerHeapPush(timerName, jsiTimerGetTime(timerPtr));
+  jsvUnLock(timerName);
+  return idx;
+}
+
+void jsiTimerUpdated(JsVar *timerPtr) {
+  int i = jsiTimerHeapFind(timerPtr);
+  if (i<0) return; // not in the heap - it's being executed right now, or the heap has overflowed
+  jsiTimerHeap[i].time = jsiTimerGetTime(timerPtr);
+  jsiTimerHeapSiftDown((unsigned int)i);
+  jsiTimerHeapSiftUp((unsigned int)i);
+}
+
+void jsiTimerRemoveAndUnLock(JsVar *timerName) {
+  JsVarRef ref = jsvGetRef(timerName);
+  for (unsigned int i=0;i<jsiTimerHeapCount;i++)
+    if (jsiTimerHeap[i].name == ref) {
+      jsiTimerHeapRemoveAt(i);
+      break;
+    }
+  jsvRemoveChildAndUnLock(timerArray, timerName);
 }
 
 void jsiTimersChanged() {
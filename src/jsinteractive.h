@@ -49,6 +49,18 @@ bool jsiIsWatchingPin(Pin pin); // are there any watches for the given pin?
 /// Ctrl-C - force interrupt of execution
 void jsiCtrlC();
 
+/* How many events can be queued in the native ring buffer before we fall
+back to allocating a JS object per event */
+#ifndef ESPR_EVENT_QUEUE_SIZE
+#ifdef SAVE_ON_FLASH
+#define ESPR_EVENT_QUEUE_SIZE 4
+#elif defined(EMBEDDED)
+#define ESPR_EVENT_QUEUE_SIZE 16
+#else
+#define ESPR_EVENT_QUEUE_SIZE 64
+#endif
+#endif
+
 /// Queue a function, string, or array (of funcs/strings) to be executed next time around the idle loop
 void jsiQueueEvents(JsVar *object, JsVar *callback, JsVar **args, int argCount);
 /// Return true if the object has callbacks...
@@ -186,6 +198,9 @@ extern Pin pinBusyIndicator;
 extern Pin pinSleepIndicator;
 #endif
 extern JsSysTime jsiLastIdleTime; ///< The last time we went around the idle loop - use this for timers
+extern JsSysTime jsiTimerBase; ///< Timers' 'time' fields are relative to this
+/// Set jsiLastIdleTime, keeping the time remaining until each timer the same
+void jsiSetLastIdleTime(JsSysTime time);
 
 void jsiDumpJSON(vcbprintf_callback user_callback, void *user_data, JsVar *data, JsVar *existing);
 void jsiDumpState(vcbprintf_callback user_callback, void *user_data);
@@ -194,7 +209,24 @@ void jsiDumpState(vcbprintf_callback user_callback, void *user_data);
 extern JsVar *timerArray; // Linked List of timers to check and run
 extern JsVar *watchArray; // Linked List of input watches to check and run
 
+/* How many timers we can keep in the native min-heap used to find the next
+timer to run without allocating. With more timers than this the heap is moved
+into JsVar memory (doubling in size each time), and we only fall back to checking
+every timer if that memory can't be allocated. */
+#ifndef ESPR_TIMER_HEAP_SIZE
+#ifdef SAVE_ON_FLASH
+#define ESPR_TIMER_HEAP_SIZE 8
+#elif defined(EMBEDDED)
+#define ESPR_TIMER_HEAP_SIZE 16
+#else
+#define ESPR_TIMER_HEAP_SIZE 256
+#endif
+#endif
+
 extern JsVarInt jsiTimerAdd(JsVar *timerPtr);
+extern void jsiTimerUpdated(JsVar *timerPtr); ///< Call after changing a timer's 'time' field
+extern void jsiTimerRemoveAndUnLock(JsVar *timerName); ///< Remove a timer (given its name in timerArray)
+extern void jsiTimersRebuild(); ///< Re-read all timers in timerArray (eg. after removing lots of them)
 extern void jsiTimersChanged(); // Flag timers changed so we can skip out of the loop if needed
 // end for jswrap_interactive/io.c ------------------------------------------------
 
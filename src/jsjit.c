@@ -31,11 +31,37 @@ void jsjAssignmentExpression();
 void jsjExpression();
 void jsjStatement();
 void jsjBlockOrStatement();
+void jsjFunctionReturn(bool isReturnStatement);
+void jsjUnwindStack(int stackDepth);
+void jsjExceptionCheck(void *checkFn);
+
+/* Unboxed local vars (and JSJVT_TAGGED on the stack) hold either an int shifted left by 1 with bit 0 set,
+or a locked JsVar value (which is always at an even address, or 0 for undefined) */
+typedef size_t JsjTagged;
+#define JSJ_IS_TAGGED_INT(v) (((v)&1)!=0)
+#define JSJ_TAGGED_TO_INT(v) (((int32_t)(v))>>1)
+#define JSJ_INT_TO_TAGGED(i) ((JsjTagged)((((uint32_t)(i))<<1)|1))
+#define JSJ_INT_FITS_TAGGED(i) ((i)>=-0x40000000 && (i)<0x40000000)
+
+/* Two JsVars returned from a helper function, in r0 and r1. On ARM a uint64_t is returned in r0,r1, and on
+x86-64 a struct of two pointers is returned in rax,rdx (which jsjcCall moves to r0,r1) */
+#ifdef JSJ_X64
+typedef struct { JsVar *r0, *r1; } JsjVarPair;
+#define JSJ_VAR_PAIR(r0, r1) ((JsjVarPair){r0, r1})
+#else
+typedef uint64_t JsjVarPair;
+#define JSJ_VAR_PAIR(r0, r1) (((uint64_t)(size_t)(r0)) | (((uint64_t)(size_t)(r1))<<32))
+#endif
+
+// Flags for the var indices stored in jit->vars
+#define JSJ_VARINDEX_MASK 0xFFFF // mask to return the actual var index
+#define JSJ_VARINDEX_NO_NAME 0x10000 // flag set if we're sure there is no name
+#define JSJ_VARINDEX_LOCAL 0x20000 // flag set if the var is an unboxed local (JsjTagged)
 // ----------------------------------------------------------------------------
 // These are helper functions that get called FROM the JITed code
 
 /// Look up 'parent.a[index]'. Utility function called from JIT code
-uint64_t _jsjxObjectLookup(JsVar *index, JsVar *parent, JsVar *a) {
+JsjVarPair _jsjxObjectLookup(JsVar *index, JsVar *parent, JsVar *a) {
   JsVar *resultParent = jsvSkipNameWithParent(a,true,parent);
   jsvUnLock2(a, parent);
   JsVar *resultA = 0;
@@ -51,7 +77,7 @@ uint64_t _jsjxObjectLookup(JsVar *index, JsVar *parent, JsVar *a) {
     }
   }
   jsvUnLock(index);
-  return ((uint64_t)(size_t)resultA) | (((uint64_t)(size_t)resultParent)<<32);
+  return JSJ_VAR_PAIR(resultA, resultParent);
 }
 
 // Like jspeFunctionCall but we unlock ALL the vars supplied
@@ -168,12 +194,159 @@ NO_INLINE JsVar *_jsxConstructorEnd(JsVar *returnVal, JsVar *thisObj) {
   }
   return thisObj;
 }
+
+// Add a block-scoped variable (LET/CONST) that has the same name as another variable to 'holder', and return it
+NO_INLINE JsVar *_jsxAddBlockVar(JsVar *holder, const char *name) {
+  JsVar *a = jsvNewNameFromString(name);
+  if (a) jsvAddName(holder, a); // we don't search for existing names - there could be several vars with the same name
+  return a;
+}
+
+// Compare the value we're switching on with the value for a 'case'. Unlocks caseValue
+NO_INLINE bool _jsxSwitchCase(JsVar *switchValue, JsVar *caseValue) {
+  bool match = jsvGetBoolAndUnLock(jsvMathsOpSkipNames(switchValue, caseValue, LEX_TYPEEQUAL));
+  jsvUnLock(caseValue);
+  return match;
+}
+
+// Throw an exception (THROW statement). Unlocks value
+NO_INLINE void _jsxThrow(JsVar *value) {
+  jspSetException(value);
+  jsvUnLock(value);
+}
+
+// Return true if we had an error that 'catch' can't handle (eg. Ctrl-C)
+NO_INLINE bool _jsxHasUncatchableError() {
+  return (execInfo.execute & (EXEC_ERROR|EXEC_INTERRUPTED))!=0;
+}
+
+// Called at the start of a 'catch' block - return the exception and clear it
+NO_INLINE JsVar *_jsxCatchException() {
+  JsVar *exception = jspGetException();
+  execInfo.execute = execInfo.execute & (JsExecFlags)~EXEC_EXCEPTION;
+  return exception;
+}
+
+// Called at the start of a 'finally' block - if there was an exception, clear it and return it in an array (so we can tell `throw undefined` from no exception)
+NO_INLINE JsVar *_jsxFinallyStart() {
+  if (!(execInfo.execute & EXEC_EXCEPTION)) return 0;
+  JsVar *exception = _jsxCatchException();
+  JsVar *exceptionArray = jsvNewArray(&exception, 1);
+  jsvUnLock(exception);
+  return exceptionArray;
+}
+
+// Called for 'return' inside 'try..finally' - wrap up the value so the 'finally' block can hold it on the stack while it runs. Unlocks value
+NO_INLINE JsVar *_jsxFinallyReturn(JsVar *value) {
+  JsVar *pendingReturn = jsvNewEmptyArray();
+  if (pendingReturn) jsvSetArrayItem(pendingReturn, 1, value); // length 2, so we can tell it from _jsxFinallyStart's array
+  jsvUnLock(value);
+  return pendingReturn;
+}
+
+// Called at the end of a 'finally' block with the result of _jsxFinallyStart or _jsxFinallyReturn - throw the exception again if there was one.
+// If we were returning, return the array from _jsxFinallyReturn, otherwise 0. Unlocks exceptionArray
+NO_INLINE JsVar *_jsxFinallyEnd(JsVar *exceptionArray) {
+  if (!exceptionArray) return 0;
+  if (jsvGetArrayLength(exceptionArray)>1) return exceptionArray; // 'return' - see _jsxFinallyReturnValue
+  JsVar *exception = jsvGetArrayItem(exceptionArray, 0);
+  jspSetException(exception);
+  jsvUnLock2(exception, exceptionArray);
+  return 0;
+}
+
+// Get the value we were returning from the result of _jsxFinallyReturn. Unlocks pendingReturn
+NO_INLINE JsVar *_jsxFinallyReturnValue(JsVar *pendingReturn) {
+  JsVar *value = jsvGetArrayItem(pendingReturn, 1);
+  jsvUnLock(pendingReturn);
+  return value;
+}
+
+// Create a function from its source code (`function() {}` or `() => {}`) in the current scope. Unlocks code
+NO_INLINE JsVar *_jsxFunctionDefinition(JsVar *code) {
+  JsVar *fn = jspEvaluateExpressionVar(code);
+  jsvUnLock(code);
+  return fn;
+}
+
+/// Convert a tagged value to a JsVar
+NO_INLINE JsVar *_jsxTaggedToVar(JsjTagged v) {
+  if (JSJ_IS_TAGGED_INT(v)) return jsvNewFromInteger(JSJ_TAGGED_TO_INT(v));
+  return (JsVar*)v;
+}
+
+/// Convert a JsVar value (not a name) to a tagged value - if it's an int that fits it is unlocked and unboxed
+NO_INLINE JsjTagged _jsxVarToTagged(JsVar *v) {
+  if (jsvIsSimpleInt(v)) {
+    JsVarInt i = v->varData.integer;
+    if (JSJ_INT_FITS_TAGGED(i)) {
+      jsvUnLock(v);
+      return JSJ_INT_TO_TAGGED(i);
+    }
+  }
+  return (JsjTagged)v;
+}
+
+/// Maths on tagged values when the JIT code couldn't do it itself (not ints, or overflow). Unlocks a and b
+NO_INLINE JsjTagged _jsxTaggedMathsOp(JsjTagged a, JsjTagged b, int op) {
+  JsVar *av = _jsxTaggedToVar(a);
+  JsVar *bv = _jsxTaggedToVar(b);
+  JsVar *r = jsvMathsOp(av, bv, op);
+  jsvUnLock2(av, bv);
+  return _jsxVarToTagged(r);
+}
+
+/// Get a tagged value as a boolean (and unlock it)
+NO_INLINE bool _jsxTaggedGetBool(JsjTagged v) {
+  if (JSJ_IS_TAGGED_INT(v)) return JSJ_TAGGED_TO_INT(v)!=0;
+  return jsvGetBoolAndUnLock((JsVar*)v);
+}
+
+/// Like jsvUnLockMany, but the items may be tagged ints (from unboxed local vars)
+NO_INLINE void _jsxUnLockMany(unsigned int count, JsjTagged *vars) {
+  for (unsigned int i=0;i<count;i++)
+    if (!JSJ_IS_TAGGED_INT(vars[i]))
+      jsvUnLock((JsVar*)vars[i]);
+}
 // ----------------------------------------------------------------------------
 
+/// Does an item of this type on the stack hold a lock? Ints and JSJVT_LOCAL (a copy of an unboxed local var's value) don't
+#define JSJVT_IS_LOCKED(t) (JSJVT_NEEDS_UNLOCK(t) || (t)==JSJVT_TAGGED)
+
+/// Get the type of the item 'fromTop' items down the stack (0 = top)
+JsjValueType jsjGetType(int fromTop) {
+  int i = jit->stackDepth - (fromTop+1);
+  assert(i>=0);
+  if (i<0 || i>=JSJ_TYPE_STACK_SIZE) return JSJVT_JSVAR; // If too many types, assume JSVAR (we convert when we push)
+  return jit->typeStack[i];
+}
+
+/// Could the item 'fromTop' items down the stack be an int?
+bool jsjIsMaybeInt(int fromTop) {
+  JsjValueType t = jsjGetType(fromTop);
+  return t==JSJVT_INT || t==JSJVT_TAGGED || t==JSJVT_LOCAL;
+}
+
+/// Call 'fn' with r0 unless it's a tagged int (eg. to lock/unlock it). Clobbers r0-r3
+void jsjIfNotTaggedCall(void *fn) {
+  JsVar *oldBlock = jsjcStartBlock();
+  jsjcCall(fn);
+  JsVar *callBlock = jsjcStopBlock(oldBlock);
+  jsjcLSL(1, 0, 31); // Z set if bit 0 is clear (so it's a JsVar)
+  jsjcBranchConditionalRelative(JSJAC_NE, (int)jsvGetStringLength(callBlock), JSJC_NONE);
+  jsjcEmitBlock(callBlock);
+  jsvUnLock(callBlock);
+}
+
 /// Pop a var off the stack - we assume vars on the stack are locked
 void jsjPopAsVar(int reg) {
   JsjValueType varType = jsjcPop(reg);
-  jsjcConvertToJsVar(reg, varType);
+  if (varType==JSJVT_TAGGED || varType==JSJVT_LOCAL) {
+    if (reg) jsjcMov(0, reg);
+    jsjcCall(_jsxTaggedToVar);
+    if (reg) jsjcMov(reg, 0);
+  } else
+    jsjcConvertToJsVar(reg, varType);
 }
 
 /// Pops a var without a name. If the var on the stack was a name we skip it and unlock it
@@ -192,6 +365,10 @@ void jsjPopAsBool(int reg) {
   JsjValueType varType = jsjcGetTopType();
   if (varType == JSJVT_BOOL || varType == JSJVT_INT || varType == JSJVT_UNDEFINED) {
     jsjcPop(reg); // easy - just pass through
+  } else if (varType == JSJVT_TAGGED || varType == JSJVT_LOCAL) {
+    jsjcPop(0);
+    jsjcCall(_jsxTaggedGetBool);
+    if (reg != 0) jsjcMov(reg, 0);
   } else { // JsVar - pop off and convert
     jsjPopNoName(0);
     jsjcCall(jsvGetBoolAndUnLock); // optimisation: we should know if we have a var or a name here, so can skip jsvSkipNameAndUnLock sometimes
@@ -201,7 +378,137 @@ void jsjPopAsBool(int reg) {
 
 void jsjPopAndUnLock() {
   JsjValueType t = jsjcPop(0); // a -> r0
-  if (JSJVT_NEEDS_UNLOCK(t)) jsjcCall(jsvUnLock); // we're throwing this away now - unlock if needed
+  if (t==JSJVT_TAGGED || t==JSJVT_LOCAL) jsjIfNotTaggedCall(jsvUnLock);
+  else if (JSJVT_NEEDS_UNLOCK(t)) jsjcCall(jsvUnLock); // we're throwing this away now - unlock if needed
+}
+
+/// Pop a value off the stack into reg as a JsjTagged (ints are unboxed where possible). Clobbers r0-r3
+void jsjPopAsTagged(int reg) {
+  JsjValueType varType = jsjGetType(0);
+  if (varType==JSJVT_TAGGED || varType==JSJVT_LOCAL) {
+    jsjcPop(reg);
+    return;
+  }
+  if (varType==JSJVT_INT) {
+    jsjcPop(0);
+    // if r0+r0 overflows the int won't fit in 31 bits, so we have to box it
+    JsVar *oldBlock = jsjcStartBlock();
+    jsjcCall(jsvNewFromInteger);
+    JsVar *boxBlock = jsjcStopBlock(oldBlock);
+    oldBlock = jsjcStartBlock();
+    jsjcAdd(0, 1, 1); // r0 = (r0<<1) | 1
+    jsjcBranchRelative((int)jsvGetStringLength(boxBlock), JSJC_NONE);
+    JsVar *tagBlock = jsjcStopBlock(oldBlock);
+    jsjcAddReg(1, 0, 0);
+    jsjcBranchConditionalRelative(JSJAC_VS, (int)jsvGetStringLength(tagBlock), JSJC_NONE);
+    jsjcEmitBlock(tagBlock);
+    jsjcEmitBlock(boxBlock);
+    jsvUnLock2(tagBlock, boxBlock);
+  } else if (varType==JSJVT_JSVAR || varType==JSJVT_JSVAR_NO_NAME) {
+    jsjPopNoName(0);
+    jsjcCall(_jsxVarToTagged);
+  } else { // bool/undefined - we keep these boxed
+    jsjPopAsVar(0);
+  }
+  if (reg) jsjcMov(reg, 0);
+}
+
+/* Maths on two tagged values - a in r0, b in r1 (both are unlocked). The result is left in r0, and its type is returned.
+If both are ints we do simple ops here, otherwise (or if there's an overflow) we call _jsxTaggedMathsOp */
+JsjValueType jsjTaggedMathsOp(int op) {
+  JsjAsmCondition compareCond = JSJAC_AL;
+  if (op=='<') compareCond = JSJAC_LT;
+  else if (op=='>') compareCond = JSJAC_GT;
+  else if (op==LEX_LEQUAL) compareCond = JSJAC_LE;
+  else if (op==LEX_GEQUAL) compareCond = JSJAC_GE;
+  else if (op==LEX_EQUAL || op==LEX_TYPEEQUAL) compareCond = JSJAC_EQ;
+  else if (op==LEX_NEQUAL || op==LEX_NTYPEEQUAL) compareCond = JSJAC_NE;
+  bool isCompare = compareCond!=JSJAC_AL;
+  // Slow path - call into Espruino
+  JsVar *oldBlock = jsjcStartBlock();
+  jsjcLiteral8(2, (uint8_t)op);
+  jsjcCall(_jsxTaggedMathsOp);
+  jsjcPush(0, JSJVT_TAGGED); // on the stack so it's unlocked if valueOf/toString threw
+  jsjExceptionCheck(jspHasError);
+  jsjcPop(0);
+  if (isCompare) jsjcCall(jsvGetBoolAndUnLock); // we know it's a bool JsVar
+  JsVar *slowBlock = jsjcStopBlock(oldBlock);
+  // Fast path - both are ints (a*2+1, b*2+1)
+  oldBlock = jsjcStartBlock();
+  bool hasFastPath = true;
+  JsjAsmCondition failCond = JSJAC_AL; // if set, the result is in r2 and we use the slow path if this condition is true
+  if (isCompare) { // the ordering of tagged ints is the same as the ints
+    jsjcCompare(0, 1);
+    jsjcSetCond(0, compareCond);
+  } else if (op=='+') { // a*2 + b*2+1
+    jsjcSub(2, 0, 1);
+    jsjcAddReg(2, 2, 1);
+    failCond = JSJAC_VS;
+  } else if (op=='-') { // a*2+1 - b*2
+    jsjcSub(3, 1, 1);
+    jsjcSubReg(2, 0, 3);
+    failCond = JSJAC_VS;
+  } else if (op=='*') { // a * b*2 (+1 later), using the top 32 bits to check for overflow
+    jsjcASR(2, 0, 1);
+    jsjcSub(3, 1, 1);
+    jsjcSMULL(2, 3, 2, 3);
+    jsjcCompareASR(3, 2, 31);
+    failCond = JSJAC_NE;
+  } else if (op=='&') {
+    jsjcAND(0, 1);
+  } else if (op=='|') {
+    jsjcORR(0, 1);
+  } else if (op=='^') {
+    jsjcEOR(0, 1);
+    jsjcAdd(0, 0, 1);
+  } else
+    hasFastPath = false;
+  if (failCond != JSJAC_AL) {
+    // the result is ok - move it to r0 and jump over the slow path
+    JsVar *fastBlockStart = jsjcStopBlock(oldBlock);
+    oldBlock = jsjcStartBlock();
+    if (op=='*') jsjcAdd(0, 2, 1);
+    else jsjcMov(0, 2);
+    jsjcBranchRelative((int)jsvGetStringLength(slowBlock), JSJC_NONE);
+    JsVar *resultBlock = jsjcStopBlock(oldBlock);
+    oldBlock = jsjcStartBlock();
+    jsjcEmitBlock(fastBlockStart);
+    jsjcBranchConditionalRelative(failCond, (int)jsvGetStringLength(resultBlock), JSJC_NONE); // go to the slow path
+    jsjcEmitBlock(resultBlock);
+    jsvUnLock2(fastBlockStart, resultBlock);
+  } else if (hasFastPath)
+    jsjcBranchRelative((int)jsvGetStringLength(slowBlock), JSJC_NONE); // jump over slow path
+  JsVar *fastBlock = jsjcStopBlock(oldBlock);
+  if (hasFastPath) {
+    DEBUG_JIT("; tagged int check\n");
+    jsjcMov(2, 0);
+    jsjcAND(2, 1);
+    jsjcLSL(2, 2, 31); // Z set if either one wasn't an int
+    jsjcBranchConditionalRelative(JSJAC_EQ, (int)jsvGetStringLength(fastBlock), JSJC_NONE);
+    DEBUG_JIT("; tagged int fast path\n");
+    jsjcEmitBlock(fastBlock);
+  }
+  DEBUG_JIT("; tagged slow path\n");
+  jsjcEmitBlock(slowBlock);
+  jsvUnLock2(fastBlock, slowBlock);
+  return isCompare ? JSJVT_BOOL : JSJVT_TAGGED;
+}
+
+/// Store r0 (a tagged value - we keep its lock) in the unboxed local var at index 'slot' on the stack, and unlock the old value. Clobbers r0-r3
+void jsjStoreLocal(int slot) {
+  int offset = (jit->stackDepth - (slot+1)) * JSJ_WORD_SIZE;
+  jsjcLoadImm(1, JSJAR_SP, offset);
+  jsjcStoreImm(0, JSJAR_SP, offset);
+  jsjcMov(0, 1);
+  jsjIfNotTaggedCall(jsvUnLock);
+}
+
+/// The top of the stack is a JSJVT_LOCAL that is about to be written to - pop and unlock it, and return the index of its unboxed local var
+int jsjPopLocal() {
+  int slot = jit->localSlots[jit->stackDepth-1];
+  jsjcPop(0);
+  jsjIfNotTaggedCall(jsvUnLock);
+  return slot;
 }
 
 // Write the code to create variable 'var' in register 'reg'. Clobbers r0-r3
@@ -230,24 +537,182 @@ void jsjFunctionStart() {
 /// Code to add right at the end of the function (or when we return)
 void jsjFunctionReturn(bool isReturnStatement) {
   DEBUG_JIT("; Function return\n");
-  int oldStackDepth = jit->stackDepth;
-  if (jit->varCount) {
+  if (jit->stackDepth) {
     jsjcMov(4, 0); // save r0 (return value)
-    jsjcMov(1, JSJAR_SP);
-    jsjcLiteral32(0, jit->stackDepth);
-    for (int i=0;i<jit->stackDepth;i++) // we don't want to be trying to unlock ints!
-      assert(jit->typeStack[i]==JSJVT_JSVAR || jit->typeStack[i]==JSJVT_JSVAR_NO_NAME);
-    jsjcCall(jsvUnLockMany);
-    jsjcAddSP(4*jit->varCount); // pop off anything on the stack
+    // pop off anything on the stack - usually just variables, but we could be in a switch or finally block, or part way through an expression
+    jsjUnwindStack(0);
     jsjcMov(0, 4); // restore r0
   }
-  // actual stack depth is stackDepth but at this point varCount==stackDepth we hope
-  // and if not an assert will catch us
   jsjcPopAllAndReturn(); // pop r4...r7
-  // If it's a return, put stack depth back where it was
+  // If it's a return, leave the stack depth where it was
   // so it's correct for the rest of the code
-  if (isReturnStatement)
-    jit->stackDepth = oldStackDepth;
+  if (!isReturnStatement)
+    jit->stackDepth = 0;
+}
+
+/// Emit code to unlock and remove everything on the stack above stackDepth, for when we jump out of a block (ints on the stack are just removed).
+/// jit->stackDepth isn't changed, as code after the jump still expects the stack as it was
+void jsjUnwindStack(int stackDepth) {
+  int oldStackDepth = jit->stackDepth;
+  if (oldStackDepth<=stackDepth) return;
+  DEBUG_JIT("; unwind %d stack items\n", oldStackDepth-stackDepth);
+  while (jit->stackDepth > stackDepth) {
+    // handle runs of items that are all locked, or all not locked, together
+    bool isLocked = JSJVT_IS_LOCKED(jsjGetType(0));
+    int count = 1;
+    while (jit->stackDepth-count > stackDepth && JSJVT_IS_LOCKED(jsjGetType(count))==isLocked)
+      count++;
+    if (isLocked) {
+      jsjcMov(1, JSJAR_SP);
+      jsjcLiteral32(0, (uint32_t)count);
+      jsjcCall(_jsxUnLockMany); // skips unboxed ints
+    }
+    jsjcAddSP(JSJ_WORD_SIZE*count);
+  }
+  jit->stackDepth = oldStackDepth;
+}
+
+/// Start a loop/switch/etc that we can jump out of with break/continue/throw. Any pending label is used for it. Returns the index in jit->targets
+int jsjTargetStart(JsjTargetType type) {
+  if (jit->targetCount>=JSJ_MAX_TARGETS) {
+    jsExceptionHere(JSET_ERROR, "JIT: too many nested blocks");
+    return -1;
+  }
+  JsjTarget *target = &jit->targets[jit->targetCount];
+  target->type = type;
+  target->hasFinally = false;
+  target->stackDepth = (int16_t)jit->stackDepth;
+  target->label = jit->pendingLabel;
+  jit->pendingLabel = 0;
+  return jit->targetCount++;
+}
+
+/// End a target from jsjTargetStart (all jumps to it should have been resolved)
+void jsjTargetEnd(int target) {
+  if (target<0) return;
+  assert(target==jit->targetCount-1);
+  jsvUnLock(jit->targets[target].label);
+  jit->targetCount--;
+}
+
+/// Emit code to jump to whatever handles exceptions - the innermost catch/finally, or the end of the function
+void jsjExceptionJump() {
+  int target = jit->targetCount-1;
+  while (target>=0 && jit->targets[target].type!=JSJT_TRY) target--;
+  if (target>=0) {
+    jsjUnwindStack(jit->targets[target].stackDepth);
+    jsjcBranchFixup(JSJAC_AL, target, JSJF_EXCEPTION);
+  } else {
+    DEBUG_JIT("; exception - return undefined\n");
+    jsjcLiteral32(0, 0);
+    jsjFunctionReturn(true/*isReturnStatement*/);
+  }
+}
+
+/** Emit code to return r0 from the function. If we're inside 'try..finally', jump to the innermost 'finally' block instead
+with r0 = the result of _jsxFinallyReturn, and that returns when it's done. If isPendingReturn, r0 is already the result of _jsxFinallyReturn */
+void jsjReturn(bool isPendingReturn) {
+  int target = jit->targetCount-1;
+  while (target>=0 && !jit->targets[target].hasFinally) target--;
+  if (target<0) {
+    if (isPendingReturn) jsjcCall(_jsxFinallyReturnValue);
+    jsjFunctionReturn(true/*isReturnStatement*/);
+    return;
+  }
+  DEBUG_JIT("; return - run FINALLY first\n");
+  if (!isPendingReturn) jsjcCall(_jsxFinallyReturn);
+  jsjcMov(4, 0); // save r0 (pending return)
+  jsjUnwindStack(jit->targets[target].stackDepth);
+  jsjcMov(0, 4); // restore r0
+  jsjcBranchFixup(JSJAC_AL, target, JSJF_RETURN);
+}
+
+/// Emit code to call checkFn (which returns a bool) and if it returned true, to jump to the exception handler
+void jsjExceptionCheck(void *checkFn) {
+  if (jit->phase != JSJP_EMIT) return;
+  DEBUG_JIT("; exception check\n");
+  jsjcCall(checkFn);
+  jsjcCompareImm(0, 0);
+  JsVar *oldBlock = jsjcStartBlock();
+  jsjExceptionJump();
+  JsVar *handlerBlock = jsjcStopBlock(oldBlock);
+  jsjcBranchConditionalRelative(JSJAC_EQ, (int)jsvGetStringLength(handlerBlock), JSJC_NONE);
+  jsjcEmitBlock(handlerBlock);
+  jsvUnLock(handlerBlock);
+}
+
+/// Are we inside a 'try' block (so need to check for exceptions after each statement)?
+bool jsjIsInTry() {
+  for (int i=0;i<jit->targetCount;i++)
+    if (jit->targets[i].type==JSJT_TRY) return true;
+  return false;
+}
+
+/// Called at the start of a `{}` block for let/const scoping. Returns the value to pass to jsjScopeEnd
+int jsjScopeStart() {
+  jit->scopeDepth++;
+  return (int)jsvGetArrayLength(jit->scopeRestore);
+}
+
+/// Called at the end of a `{}` block - put back any vars in jit->vars that were replaced by let/const in the block
+void jsjScopeEnd(int scopeRestoreLength) {
+  jit->scopeDepth--;
+  while ((int)jsvGetArrayLength(jit->scopeRestore) > scopeRestoreLength) {
+    JsVar *oldIndex = jsvSkipNameAndUnLock(jsvArrayPop(jit->scopeRestore));
+    JsVar *name = jsvSkipNameAndUnLock(jsvArrayPop(jit->scopeRestore));
+    JsVar *varIndex = jsvFindChildFromVar(jit->vars, name, false);
+    if (varIndex) {
+      if (jsvIsUndefined(oldIndex)) jsvRemoveChild(jit->vars, varIndex); // it didn't exist before
+      else jsvSetValueOfName(varIndex, oldIndex);
+    }
+    jsvUnLock3(varIndex, name, oldIndex);
+  }
+}
+
+/* LET/CONST inside a block - give the var a new index on the stack (jsjScopeEnd puts the old one back).
+If a var of the same name was already used in the function, the interpreter would create the new one in
+a block scope, so we add it to an object on the stack (jit->blockVarHolder) so it doesn't overwrite the old
+one. Otherwise we add it to the function's scope like VAR, so functions defined in the block can still use it
+(or if jit->unboxLocals, LET is an unboxed local var). */
+void jsjBlockScopedVar(JsVar *varIndex, JsVar *name, LEX_TYPES creationOp) {
+  JsVar *oldIndex = jsvSkipName(varIndex);
+  // copy the name - if it was unreferenced, jsvFindChildFromVar will have turned it into the name in jit->vars
+  jsvArrayPushAndUnLock(jit->scopeRestore, jsvNewFromStringVar(name, 0, JSVAPPENDSTRINGVAR_MAXLENGTH));
+  jsvArrayPush(jit->scopeRestore, oldIndex);
+  int varIndexNumber;
+  if (jit->phase == JSJP_SCAN) {
+    JsjValueType varType = JSJVT_JSVAR;
+    if (jsvIsUndefined(oldIndex) && jit->unboxLocals && creationOp==LEX_R_LET) {
+      DEBUG_JIT("; Local Variable Decl %j\n", name);
+      jsjcLiteral32(0, 0); // undefined
+      varType = JSJVT_TAGGED;
+    } else if (jsvIsUndefined(oldIndex)) {
+      DEBUG_JIT("; Variable Decl %j\n", name);
+      jsjcLiteralString(0, name, true); // null terminated string in r0
+      jsjcCall(_jsxAddVar);
+    } else {
+      if (jit->blockVarHolder<0) {
+        DEBUG_JIT("; Block scoped var holder\n");
+        jsjcCall(jsvNewObject);
+        jsjcPush(0, JSJVT_JSVAR_NO_NAME);
+        jit->blockVarHolder = jit->varCount++;
+      }
+      DEBUG_JIT("; Block scoped Variable Decl %j\n", name);
+      jsjcLoadImm(0, JSJAR_SP, (jit->stackDepth - (jit->blockVarHolder+1)) * JSJ_WORD_SIZE); // r0 = holder
+      jsjcLiteralString(1, name, true); // null terminated string in r1
+      jsjcCall(_jsxAddBlockVar);
+    }
+    jsjcPush(0, varType); // Push the value onto the stack (which will end up being our vars list after SCAN phase)
+    varIndexNumber = jit->varCount++;
+    if (varType == JSJVT_TAGGED) varIndexNumber |= JSJ_VARINDEX_LOCAL;
+    jsvArrayPushAndUnLock(jit->letSlots, jsvNewFromInteger(varIndexNumber));
+  } else { // EMIT - use the same index we picked in the SCAN phase
+    varIndexNumber = jsvGetIntegerAndUnLock(jsvGetArrayItem(jit->letSlots, jit->letCount));
+  }
+  jit->letCount++;
+  JsVar *varIndexVal = jsvNewFromInteger(varIndexNumber);
+  jsvSetValueOfName(varIndex, varIndexVal);
+  jsvUnLock2(varIndexVal, oldIndex);
 }
 
 /* Called when we encounter an ID. This checks if it's in our 'jit->vars'
@@ -256,10 +721,10 @@ tries to find it (creationOp==LEX_ID) it in our global scope.
 hasInitialiser=true if an initial value is already on the stack.
 If the ID was something built-in, its value is returned (we pass this into FactorMember) */
 JsVar *jsjFactorIDAndUnLock(JsVar *name, LEX_TYPES creationOp) {
-  const int VARINDEX_MASK = 0xFFFF; // mask to return the actual var index
-  const int VARINDEX_NO_NAME = 0x10000; // flag set if we're sure there is no name
   // search for var in our list...
   JsVar *varIndex = jsvFindChildFromVar(jit->vars, name, true/*addIfNotFound*/);
+  if ((creationOp==LEX_R_LET || creationOp==LEX_R_CONST) && jit->scopeDepth)
+    jsjBlockScopedVar(varIndex, name, creationOp);
   JsVar *varIndexVal = jsvSkipName(varIndex);
   JsVar *builtin = NULL;
   if (creationOp==LEX_ID) {
@@ -290,6 +755,10 @@ JsVar *jsjFactorIDAndUnLock(JsVar *name, LEX_TYPES creationOp) {
         jsjcLiteralString(0, name, true); // null terminated string in r0
         jsjcCall(jspGetNamedVariable); // Find the var in the current scopes (always returns something even if it's jsvNewChild)
       }
+    } else if ((creationOp==LEX_R_VAR || creationOp==LEX_R_LET) && jit->unboxLocals) {
+      DEBUG_JIT("; Local Variable Decl %j\n", name);
+      jsjcLiteral32(0, 0); // undefined
+      varType = JSJVT_TAGGED; // an unboxed local var
     } else if (creationOp==LEX_R_VAR || creationOp==LEX_R_LET || creationOp==LEX_R_CONST) {
       DEBUG_JIT("; Variable Decl %j\n", name);
       jsjcLiteralString(0, name, true); // null terminated string in r0
@@ -300,19 +769,27 @@ JsVar *jsjFactorIDAndUnLock(JsVar *name, LEX_TYPES creationOp) {
     // Now add the index to our list
     int varIndexNumber = jit->varCount++;
     if (varType == JSJVT_JSVAR_NO_NAME)
-      varIndexNumber |= VARINDEX_NO_NAME; // if we're sure there's no name
+      varIndexNumber |= JSJ_VARINDEX_NO_NAME; // if we're sure there's no name
+    if (varType == JSJVT_TAGGED)
+      varIndexNumber |= JSJ_VARINDEX_LOCAL;
     varIndexVal = jsvNewFromInteger(varIndexNumber);
     jsvSetValueOfName(varIndex, varIndexVal);
   }
   // Now, we have the var already - just reference it
   int varIndexI = jsvGetIntegerAndUnLock(varIndexVal);
-  if (jit->phase == JSJP_EMIT) {
+  if (jit->phase == JSJP_EMIT && (varIndexI & JSJ_VARINDEX_LOCAL)) {
+    varIndexI &= JSJ_VARINDEX_MASK;
+    DEBUG_JIT("; Reference local var %j\n", name);
+    jsjcLoadImm(0, JSJAR_SP, (jit->stackDepth - (varIndexI+1)) * JSJ_WORD_SIZE);
+    jsjIfNotTaggedCall(jsvLockAgainSafe);
+    jsjcPushLocal(0, varIndexI); // so we know where to store it if it's assigned
+  } else if (jit->phase == JSJP_EMIT) {
     JsjValueType varType = JSJVT_JSVAR;
-    if (varIndexI & VARINDEX_NO_NAME) // decode varType from the flags
+    if (varIndexI & JSJ_VARINDEX_NO_NAME) // decode varType from the flags
       varType = JSJVT_JSVAR_NO_NAME;
-    varIndexI &= VARINDEX_MASK;
+    varIndexI &= JSJ_VARINDEX_MASK;
     DEBUG_JIT("; Reference var %j\n", name);
-    jsjcLoadImm(0, JSJAR_SP, (jit->stackDepth - (varIndexI+1)) * 4);
+    jsjcLoadImm(0, JSJAR_SP, (jit->stackDepth - (varIndexI+1)) * JSJ_WORD_SIZE);
     jsjcCall(jsvLockAgain);
     jsjcPush(0, varType); // Push, with the type we got from the varIndex flags
   }
@@ -321,13 +798,11 @@ JsVar *jsjFactorIDAndUnLock(JsVar *name, LEX_TYPES creationOp) {
 }
 
 void jsjFactorObject() {
-  int regObject;
   if (jit->phase == JSJP_EMIT) {
     DEBUG_JIT("; New Object\n");
-    // create the object
+    // create the object - we keep it on the stack so it's unlocked if a field's value throws
     jsjcCall(jsvNewObject);
-    regObject = jsjcClaimFreeReg();
-    jsjcMov(regObject, 0); // Store it in regObject
+    jsjcPush(0, JSJVT_JSVAR_NO_NAME);
   }
   /* JSON-style object definition */
   JSP_ASSERT_MATCH('{');
@@ -356,7 +831,7 @@ void jsjFactorObject() {
       jsjJsVar(1, varName); // r1 = index
       jsjcMov(2, regValue); // r2 = array item (copy from regValue)
       jsjcReturnFreeReg(regValue);
-      jsjcMov(0, regObject); // r0 = array
+      jsjcLoadImm(0, JSJAR_SP, 0); // r0 = object (top of stack)
       jsjcCall(_jsxObjectNewElement); // unlocks r1 and r2
     }
     jsvUnLock(varName);
@@ -364,21 +839,15 @@ void jsjFactorObject() {
     if (lex->tk != '}') JSP_MATCH(',');
   }
   JSP_ASSERT_MATCH('}');
-  if (jit->phase == JSJP_EMIT) {
-    // push the finished object on the stack
-    jsjcPush(regObject, JSJVT_JSVAR_NO_NAME);
-    jsjcReturnFreeReg(regObject);
-  }
+  // the finished object is left on the stack
 }
 
 void jsjFactorArray() {
   uint32_t idx = 0; // current array index
-  int regArray;
   if (jit->phase == JSJP_EMIT) {
-    // create the array
+    // create the array - we keep it on the stack so it's unlocked if an item throws
     jsjcCall(jsvNewEmptyArray);
-    regArray = jsjcClaimFreeReg();
-    jsjcMov(regArray, 0); // Store it in regArray
+    jsjcPush(0, JSJVT_JSVAR_NO_NAME);
   }
 
   /* JSON-style array */
@@ -389,7 +858,7 @@ void jsjFactorArray() {
       if (jit->phase == JSJP_EMIT) {
         jsjPopNoName(2); // r2 = array item
         jsjcLiteral32(1, idx); // r1 = index
-        jsjcMov(0, regArray); // r0 = array
+        jsjcLoadImm(0, JSJAR_SP, 0); // r0 = array (top of stack)
         jsjcCall(_jsxArrayNewElement); // unlocks r2
       }
     }
@@ -398,23 +867,73 @@ void jsjFactorArray() {
   }
   JSP_MATCH(']');
   if (jit->phase == JSJP_EMIT) {
-    jsjcMov(0, regArray); // r0 = array
+    jsjcLoadImm(0, JSJAR_SP, 0); // r0 = array (top of stack)
     jsjcLiteral32(1, idx); // r1 = array size
     jsjcLiteral32(2, 0); // r1 = truncate = false
     jsjcCall(jsvSetArrayLength);
-    // push the finished array on
-    jsjcPush(regArray, JSJVT_JSVAR_NO_NAME);
-    jsjcReturnFreeReg(regArray);
+    // the finished array is left on the stack
+  }
+}
+
+/// Skip over a bracketed block of tokens (including nested brackets). lex->tk should be the opening bracket
+void jsjSkipBrackets() {
+  int depth = 0;
+  do {
+    if (lex->tk=='(' || lex->tk=='[' || lex->tk=='{') depth++;
+    else if (lex->tk==')' || lex->tk==']' || lex->tk=='}') depth--;
+    jslGetNextToken();
+  } while (depth>0 && lex->tk!=LEX_EOF);
+}
+
+#ifndef ESPR_NO_ARROW_FN
+/// Look ahead to see if the brackets we're at are the arguments of an arrow function
+bool jsjIsArrowFunction() {
+  size_t bracketStart = lex->tokenStart;
+  jsjSkipBrackets();
+  bool isArrowFunction = lex->tk==LEX_ARROW_FUNCTION;
+  jslSeekTo(bracketStart);
+  return isArrowFunction;
+}
+#endif
+
+/* Function definitions (`function() {}`/`() => {}`) aren't JITed. We use the normal parser (without
+executing) to find the end of the function, then at runtime _jsxFunctionDefinition is given its source
+code and creates the function in the current scope, like the interpreter does. */
+void jsjFunctionDefinition() {
+  JsVar *jspeFactor(); // use the main parser to parse the function for us!
+  void jspSetNoExecute();
+  JslCharPos funcStart;
+  jslCharPosNew(&funcStart, lex->sourceVar, lex->tokenStart);
+  JsExecFlags oldExecute = execInfo.execute;
+  jspSetNoExecute();
+  jsvUnLock(jspeFactor());
+  execInfo.execute = oldExecute | (execInfo.execute&EXEC_ERROR_MASK); // keep any errors
+  if (JSJ_PARSING && jit->phase == JSJP_EMIT) {
+    JsVar *code = jslNewStringFromLexer(&funcStart, lex->tokenStart);
+    DEBUG_JIT("; Function definition\n");
+    jsjJsVar(0, code); // r0 = function's code
+    jsjcCall(_jsxFunctionDefinition); // unlocks code
+    jsjcPush(0, JSJVT_JSVAR_NO_NAME); // a value, not a NAME
+    jsvUnLock(code);
   }
+  jslCharPosFree(&funcStart);
 }
 
 /* If the Factor was something built-in, its value is returned (we pass this into FactorMember) */
 JsVar *jsjFactor() {
   JsVar *builtin = NULL;
   if (lex->tk==LEX_ID) {
+    size_t idStart = lex->tokenStart;
     JsVar *name = jslGetTokenValueAsVar();
     JSP_ASSERT_MATCH(LEX_ID);
-    builtin = jsjFactorIDAndUnLock(name, LEX_ID);
+#ifndef ESPR_NO_ARROW_FN
+    if (lex->tk==LEX_ARROW_FUNCTION) { // `a => ...`
+      jsvUnLock(name);
+      jslSeekTo(idStart);
+      jsjFunctionDefinition();
+    } else
+#endif
+      builtin = jsjFactorIDAndUnLock(name, LEX_ID);
   } else if (lex->tk==LEX_INT) {
     int64_t v = jsvGetLongIntegerAndUnLock(jslGetTokenValueAsVar());
     JSP_ASSERT_MATCH(LEX_INT);
@@ -436,11 +955,14 @@ JsVar *jsjFactor() {
       jsjcCall(jsvNewFromFloat);
       jsjcPush(0, JSJVT_JSVAR_NO_NAME); // a value, not a NAME
     }
+#ifndef ESPR_NO_ARROW_FN
+  } else if (lex->tk=='(' && jsjIsArrowFunction()) {
+    jsjFunctionDefinition();
+#endif
   } else if (lex->tk=='(') {
     JSP_ASSERT_MATCH('(');
     // Just parse a normal expression (which can include commas)
     jsjExpression();
-    // FIXME: Arrow functions??
     JSP_MATCH_WITH_RETURN(')', 0);
   } else if (lex->tk==LEX_R_TRUE || lex->tk==LEX_R_FALSE) {
     if (jit->phase == JSJP_EMIT) {
@@ -473,10 +995,8 @@ JsVar *jsjFactor() {
     jsjFactorObject();
   } else if (lex->tk=='[') {
     jsjFactorArray();
-  /*} else if (lex->tk==LEX_R_FUNCTION) {
-    if (!jspCheckStackPosition()) return 0;
-    JSP_ASSERT_MATCH(LEX_R_FUNCTION);
-    return jsjFunctionDefinition(true);*/
+  } else if (lex->tk==LEX_R_FUNCTION) {
+    jsjFunctionDefinition();
   } else if (lex->tk==LEX_R_THIS) {
     JSP_ASSERT_MATCH(LEX_R_THIS);
     if (jit->phase == JSJP_EMIT) {
@@ -549,7 +1069,9 @@ bool jsjFactorMember(JsVar *builtin) {
               JsnArgumentType returnType = argType&JSWAT_MASK;
               JsnArgumentType arg1Type = (argType>>JSWAT_BITS)&JSWAT_MASK;
               bool noOtherArgs = (argType&~(JSWAT_MASK | (JSWAT_MASK<<JSWAT_BITS) | JSWAT_THIS_ARG)) == 0;
-              if (isFunctionCall && jsjIsSupportedArgType(returnType) && jsjIsSupportedArgType(arg1Type) && noOtherArgs) {
+              // we can only pop JsVars and bools into registers for the argument - anything else (eg. a double) goes through the generic function call
+              bool arg1Supported = arg1Type==JSWAT_VOID || arg1Type==JSWAT_JSVAR || arg1Type==JSWAT_BOOL;
+              if (isFunctionCall && jsjIsSupportedArgType(returnType) && arg1Supported && noOtherArgs) {
                 bool hasThis = argType & JSWAT_THIS_ARG;
                 // handle supported args+return type only
                 JSP_ASSERT_MATCH('(');
@@ -564,18 +1086,19 @@ bool jsjFactorMember(JsVar *builtin) {
                 } else DEBUG_JIT_EMIT("; FUNCTION CALL NATIVE\n");
                 jsjFactorFunctionIgnoreRemainingArguments();
                 // void this.fn()
-                int argReg = hasThis ? 1 : 0;
+                // keep the argument out of r0-r3 while we deal with the parent
+                int argReg = arg1Type ? jsjcClaimFreeReg() : 0;
                 if (arg1Type) {
                   if (arg1Type == JSWAT_JSVAR) jsjPopNoName(argReg);
-                  else if (arg1Type == JSWAT_BOOL) jsjPopAsBool(argReg);
-                  else {
-                    jsExceptionHere(JSET_ERROR, "Unknown arg typoe");
-                    assert(0); // FIXME different arg types!
-                  }
+                  else jsjPopAsBool(argReg);
                 }
                 if (hasThis) {
                   jsjPopNoName(0); // parent
-                } else jsjPopAndUnLock(); // FIXME this'll clobber r0 :(
+                } else jsjPopAndUnLock();
+                if (arg1Type) {
+                  jsjcMov(hasThis ? 1 : 0, argReg);
+                  jsjcReturnFreeReg(argReg);
+                }
                 jsjcCall(fn->varData.native.ptr);
                 JsnArgumentType returnType = fn->varData.native.argTypes&JSWAT_MASK;
                 if (returnType == JSWAT_VOID) {
@@ -592,10 +1115,11 @@ bool jsjFactorMember(JsVar *builtin) {
                   assert(returnType==JSWAT_JSVAR);
                   jsjcPush(0, JSJVT_JSVAR_NO_NAME);
                 }
+                jsjExceptionCheck(jspHasError); // the native function could have thrown
               } else {
                 int regTmp = jsjcClaimFreeReg();
                 jsjPopNoName(regTmp); // parent
-                jsjcLiteral32(0, (uint32_t)fn->varData.native.ptr);
+                jsjcLiteralPtr(0, (void*)fn->varData.native.ptr);
                 jsjcLiteral32(1, (uint16_t)fn->varData.native.argTypes);
                 jsjcCall(jsvNewNativeFunction); // JsVar *jsvNewNativeFunction(void (*ptr)(void), unsigned short argTypes)
                 jsjcPush(0, JSJVT_JSVAR); // the function itself
@@ -634,13 +1158,21 @@ bool jsjFactorMember(JsVar *builtin) {
       assert(0);
     }
     if (doLookup && jit->phase == JSJP_EMIT) {
-      // r0 currently = index
-      if (parentOnStack) jsjPopAsVar(1); // r1 = parent
-      else jsjcLiteral32(1, 0);
+      // r0 currently = index - but converting the other values to JsVars could clobber r0-r3
+      int regIndex = jsjcClaimFreeReg();
+      int regParent = jsjcClaimFreeReg();
+      jsjcMov(regIndex, 0);
+      if (parentOnStack) jsjPopAsVar(regParent); // parent
+      else jsjcLiteral32(regParent, 0);
       jsjPopAsVar(2); // r2 = the variable itself
+      jsjcMov(1, regParent); // r1 = parent
+      jsjcMov(0, regIndex); // r0 = index
+      jsjcReturnFreeReg(regParent);
+      jsjcReturnFreeReg(regIndex);
       jsjcCall(_jsjxObjectLookup); // (a,parent) = _jsjxObjectLookup(index, parent, a)
       jsjcPush(0, JSJVT_JSVAR); // a
       jsjcPush(1, JSJVT_JSVAR); // parent
+      jsjExceptionCheck(jspHasError); // eg. field of undefined
       parentOnStack = true;
     }
   }
@@ -649,7 +1181,6 @@ bool jsjFactorMember(JsVar *builtin) {
 
 void jsjFactorFunctionCall() {
   bool isConstructor = false;
-  int regObject; // for constructors, this reg contains the object
   if (lex->tk==LEX_R_NEW) {
     JSP_ASSERT_MATCH(LEX_R_NEW);
     isConstructor = true;
@@ -684,12 +1215,11 @@ void jsjFactorFunctionCall() {
         // create a new 'this' - which is an object with prototype of the Function
         jsjcMov(0, regFnName);
         jsjcCall(_jsxConstructorStart); // _jsxConstructorStart(funcName) => funcParent
-        regObject = jsjcClaimFreeReg();
-        jsjcMov(regObject, 0); // regObject = funcParent
+        jsjcPush(0, JSJVT_JSVAR_NO_NAME); // funcParent again, for _jsxConstructorEnd (on the stack so it's unlocked if an argument throws)
         jsjcPush(regFnName, JSJVT_JSVAR); // funcName
         jsjcPush(0, JSJVT_JSVAR); // push funcParent
         jsjcReturnFreeReg(regFnName);
-        //  <top of stack> funcParent, funcName, <rest of stack>
+        //  <top of stack> funcParent, funcName, funcParent, <rest of stack>
       }
       parentOnStack = true;
     }
@@ -720,8 +1250,8 @@ void jsjFactorFunctionCall() {
       if (argCount>1) {
         DEBUG_JIT("; FUNCTION CALL reverse arguments\n");
         for (int i=0;i<argCount/2;i++) {
-          int a1 = i*4;
-          int a2 = (argCount-(i+1))*4;
+          int a1 = i*JSJ_WORD_SIZE;
+          int a2 = (argCount-(i+1))*JSJ_WORD_SIZE;
           jsjcLoadImm(0, 7, a1); // r0 = memory[argPtr+a1]
           jsjcLoadImm(1, 7, a2); // ...
           jsjcStoreImm(0, 7, a2);
@@ -733,24 +1263,24 @@ void jsjFactorFunctionCall() {
       DEBUG_JIT("; FUNCTION CALL jspeFunctionCall\n");
       // Get function var and parent (r7 == SP)
       if (parentOnStack) { // parent
-        jsjcLoadImm(0, 7, 4*(argCount+1)); // r0 = funcName
-        jsjcLoadImm(1, 7, 4*(argCount));
+        jsjcLoadImm(0, 7, JSJ_WORD_SIZE*(argCount+1)); // r0 = funcName
+        jsjcLoadImm(1, 7, JSJ_WORD_SIZE*(argCount));
       } else { // no parent
-        jsjcLoadImm(0, 7, 4*argCount); // r0 = funcName
+        jsjcLoadImm(0, 7, JSJ_WORD_SIZE*argCount); // r0 = funcName
         jsjcLiteral32(1, 0);
       }
       jsjcLiteral32(2, 0); // isParsing = false
       jsjcLiteral32(3, argCount); // argCount 4th arg
       jsjcCall(_jsjxFunctionCallAndUnLock); // a = _jsjxFunctionCallAndUnLock(funcName, thisArg/parent, isParsing, argCount, argPtr[on stack]);
       DEBUG_JIT("; FUNCTION CALL cleanup stack\n");
-      jsjcAddSP(4*(2+argCount+(parentOnStack?1:0))); // pop off argPtr + all the arguments + funcName + parent
+      jsjcAddSP(JSJ_WORD_SIZE*(2+argCount+(parentOnStack?1:0))); // pop off argPtr + all the arguments + funcName + parent
       parentOnStack = false;
       if (isConstructor) {
-        jsjcMov(1, regObject); // r1 = thisObj
-        jsjcReturnFreeReg(regObject);
+        jsjcPop(1); // r1 = thisObj
         jsjcCall(_jsxConstructorEnd); // _jsxConstructorEnd(returnVal, thisObj) => returnVal
       }
       jsjcPush(0, JSJVT_JSVAR_NO_NAME); // push return value from jspeFunctionCall
+      jsjExceptionCheck(jspHasError); // check now, before anything uses the return value
       DEBUG_JIT("; FUNCTION CALL end\n");
       // 'parent', 'funcName' and all args are unlocked by _jsjxFunctionCallAndUnLock
     }
@@ -768,11 +1298,20 @@ void __jsjPostfixExpression() {
   while (lex->tk==LEX_PLUSPLUS || lex->tk==LEX_MINUSMINUS) {
     int op = lex->tk; // POSFIX expression =>  i++, i--
     JSP_ASSERT_MATCH(op);
-    if (jit->phase == JSJP_EMIT) {
+    if (jit->phase == JSJP_EMIT && jsjGetType(0)==JSJVT_LOCAL) { // unboxed local var
+      int slot = jit->localSlots[jit->stackDepth-1];
+      jsjcPop(0); // old value -> r0
+      jsjIfNotTaggedCall(jsvLockAgainSafe); // one lock for the result, one for jsjTaggedMathsOp
+      jsjcPush(0, JSJVT_TAGGED); // push result (value BEFORE we inc/dec)
+      jsjcLiteral8(1, JSJ_INT_TO_TAGGED(1));
+      jsjTaggedMathsOp(op==LEX_PLUSPLUS ? '+' : '-');
+      jsjStoreLocal(slot);
+    } else if (jit->phase == JSJP_EMIT) {
       jsjPopAsVar(0); // old value -> r0
       jsjcLiteral32(1, op==LEX_PLUSPLUS ? '+' : '-'); // add the operation
       jsjcCall(_jsxPostfixIncDec); // JsVar *_jsxPostfixIncDec(JsVar *var, char op)
       jsjcPush(0, JSJVT_JSVAR_NO_NAME); // push result (value BEFORE we inc/dec)
+      jsjExceptionCheck(jspHasError);
     }
   }
 }
@@ -783,11 +1322,23 @@ void jsjPostfixExpression() {
     int op = lex->tk;
     JSP_ASSERT_MATCH(op);
     jsjPostfixExpression(); // recurse to get our var...
-    if (jit->phase == JSJP_EMIT) {
+    if (jit->phase == JSJP_EMIT && jsjGetType(0)==JSJVT_LOCAL) { // unboxed local var
+      int slot = jit->localSlots[jit->stackDepth-1];
+      jsjcPop(0); // old value -> r0
+      jsjcLiteral8(1, JSJ_INT_TO_TAGGED(1));
+      jsjTaggedMathsOp(op==LEX_PLUSPLUS ? '+' : '-');
+      jsjIfNotTaggedCall(jsvLockAgainSafe); // one lock for the result, one for the local
+      int regNew = jsjcClaimFreeReg();
+      jsjcMov(regNew, 0);
+      jsjStoreLocal(slot);
+      jsjcPush(regNew, JSJVT_TAGGED); // push result (value AFTER we inc/dec)
+      jsjcReturnFreeReg(regNew);
+    } else if (jit->phase == JSJP_EMIT) {
       jsjPopAsVar(0); // old value -> r0
       jsjcLiteral32(1, op==LEX_PLUSPLUS ? '+' : '-'); // add the operation
       jsjcCall(_jsxPrefixIncDec); // JsVar *_jsxPrefixIncDec(JsVar *var, char op)
       jsjcPush(0, JSJVT_JSVAR); // push result (value AFTER we inc/dec) - this is STILL a NAME
+      jsjExceptionCheck(jspHasError);
     }
   } else
     jsjFactorFunctionCall();
@@ -938,7 +1489,15 @@ void __jsjBinaryExpression(unsigned int lastPrecedence) {
           }
         }
         jsvUnLock2(av, bv);
-      } else */if (jit->phase == JSJP_EMIT) {  // --------------------------------------------- NORMAL
+      } else */if (jit->phase == JSJP_EMIT && op!=LEX_R_INSTANCEOF && (jsjIsMaybeInt(0) || jsjIsMaybeInt(1))) {
+        // One side is (or could be) an int - try and do the maths without allocating JsVars
+        int regTmp = jsjcClaimFreeReg();
+        jsjPopAsTagged(regTmp); // b -> rT
+        jsjPopAsTagged(0); // a -> r0
+        jsjcMov(1, regTmp); // b -> r1
+        jsjcReturnFreeReg(regTmp);
+        jsjcPush(0, jsjTaggedMathsOp(op));
+      } else if (jit->phase == JSJP_EMIT) {  // --------------------------------------------- NORMAL
         int regTmp = jsjcClaimFreeReg();
         jsjPopAsVar(regTmp); // b -> rT
         jsjPopAsVar(0); // a -> r0
@@ -947,6 +1506,7 @@ void __jsjBinaryExpression(unsigned int lastPrecedence) {
         jsjcLiteral8(2, op);
         jsjcCall(_jsxMathsOpSkipNamesAndUnLock); // unlocks arguments
         jsjcPush(0, JSJVT_JSVAR_NO_NAME); // push result - a value, not a NAME
+        jsjExceptionCheck(jspHasError); // valueOf/toString could have thrown
       }
     }
     precedence = jsjGetBinaryExpressionPrecedence(lex->tk);
@@ -1012,7 +1572,37 @@ NO_INLINE void jsjAssignmentExpression() {
     JSP_ASSERT_MATCH(op);
 
     jsjAssignmentExpression();
-    if (jit->phase == JSJP_EMIT) {
+    if (op==LEX_PLUSEQUAL) op='+';
+    else if (op==LEX_MINUSEQUAL) op='-';
+    else if (op==LEX_MULEQUAL) op='*';
+    else if (op==LEX_DIVEQUAL) op='/';
+    else if (op==LEX_MODEQUAL) op='%';
+    else if (op==LEX_ANDEQUAL) op='&';
+    else if (op==LEX_OREQUAL) op='|';
+    else if (op==LEX_XOREQUAL) op='^';
+    else if (op==LEX_RSHIFTEQUAL) op=LEX_RSHIFT;
+    else if (op==LEX_LSHIFTEQUAL) op=LEX_LSHIFT;
+    else if (op==LEX_RSHIFTUNSIGNEDEQUAL) op=LEX_RSHIFTUNSIGNED;
+    else assert(op=='=');
+    if (jit->phase == JSJP_EMIT && jsjGetType(1)==JSJVT_LOCAL) { // unboxed local var
+      int regTmp = jsjcClaimFreeReg();
+      jsjPopAsTagged(regTmp); // pop RHS to regTmp
+      int slot;
+      if (op=='=') {
+        slot = jsjPopLocal();
+        jsjcMov(0, regTmp);
+      } else {
+        slot = jit->localSlots[jit->stackDepth-1];
+        jsjcPop(0); // LHS value -> r0
+        jsjcMov(1, regTmp); // RHS -> r1
+        jsjTaggedMathsOp(op);
+      }
+      jsjIfNotTaggedCall(jsvLockAgainSafe); // one lock for the result, one for the local
+      jsjcMov(regTmp, 0);
+      jsjStoreLocal(slot);
+      jsjcPush(regTmp, JSJVT_TAGGED); // push the result back on
+      jsjcReturnFreeReg(regTmp);
+    } else if (jit->phase == JSJP_EMIT) {
       int regTmp = jsjcClaimFreeReg();
       jsjPopAsVar(regTmp); // pop RHS to regTmp
       jsjPopAsVar(0); // pop LHS to r0
@@ -1022,22 +1612,11 @@ NO_INLINE void jsjAssignmentExpression() {
         // this is like jsvReplaceWithOrAddToRoot but it unlocks the RHS for us
         jsjcCall(_jsxAssignment); // JsVar *_jsxAssignment(JsVar *dst, JsVar *src)
       } else {
-        if (op==LEX_PLUSEQUAL) op='+';
-        else if (op==LEX_MINUSEQUAL) op='-';
-        else if (op==LEX_MULEQUAL) op='*';
-        else if (op==LEX_DIVEQUAL) op='/';
-        else if (op==LEX_MODEQUAL) op='%';
-        else if (op==LEX_ANDEQUAL) op='&';
-        else if (op==LEX_OREQUAL) op='|';
-        else if (op==LEX_XOREQUAL) op='^';
-        else if (op==LEX_RSHIFTEQUAL) op=LEX_RSHIFT;
-        else if (op==LEX_LSHIFTEQUAL) op=LEX_LSHIFT;
-        else if (op==LEX_RSHIFTUNSIGNEDEQUAL) op=LEX_RSHIFTUNSIGNED;
-        else assert(0);
-        jsjcLiteral8(2, op);
+        jsjcLiteral8(2, (uint8_t)op);
         jsjcCall(_jsxMathAssignment); // JsVar *_jsxMathAssignment(JsVar *var, JsVar *rhs, char op)
       }
       jsjcPush(0, JSJVT_JSVAR); // push the result (LHS) back on
+      jsjExceptionCheck(jspHasError); // eg. assigning to a const
     }
   }
 }
@@ -1062,19 +1641,41 @@ bool jsjBlockNoBrackets() {
     if (lex->tk == LEX_R_RETURN)
       hadReturn = true;
     jsjStatement();
+    if (jsjIsInTry()) jsjExceptionCheck(jspHasError);
   }
   return hadReturn;
 }
 
 void jsjBlock() {
   JSP_MATCH('{');
+  int scope = jsjScopeStart();
   jsjBlockNoBrackets();
+  jsjScopeEnd(scope);
   JSP_MATCH('}');
 }
 
+/// Pop an initial value and then a variable (from jsjFactorIDAndUnLock) off the stack and assign the value
+void jsjVarInitialAssign(bool isConstant) {
+  if (jsjGetType(1)==JSJVT_LOCAL) { // unboxed local var - just store the value
+    int regTmp = jsjcClaimFreeReg();
+    jsjPopAsTagged(regTmp); // initial value
+    int slot = jsjPopLocal();
+    jsjcMov(0, regTmp);
+    jsjcReturnFreeReg(regTmp);
+    jsjStoreLocal(slot);
+    return;
+  }
+  // _jsxVarInitialAssign(r0:var, r1:isConstant, r2:initialValue)
+  jsjPopAsVar(4); // r2 -> initial value
+  jsjPopAsVar(0); // r0 -> variable (from jsjFactorIDAndUnLock)
+  jsjcLiteral8(1, isConstant?1:0); // r1 -> if we're a constant
+  jsjcMov(2, 4); // b -> r2 (converting r0 could have clobbered r1)
+  jsjcCall(_jsxVarInitialAssign); // set the var's initial value
+}
+
 void jsjStatementVar() {
   assert(lex->tk==LEX_R_VAR || lex->tk==LEX_R_LET || lex->tk==LEX_R_CONST);
-  // FIXME: Ignore block scoping for now
+  // LET/CONST inside a block are scoped to the block by jsjFactorIDAndUnLock
   LEX_TYPES declType = lex->tk;
   jslGetNextToken();
   bool hasComma = true; // for first time in loop
@@ -1084,21 +1685,21 @@ void jsjStatementVar() {
     JSP_ASSERT_MATCH(LEX_ID);
     bool hasInitialiser = lex->tk == '=';
     /* create the variable locally, and in our var table. If we're emitting now
-    and there's no initial value, we don't need to do anything */
-    if (hasInitialiser || jit->phase != JSJP_EMIT)
+    and there's no initial value, we don't need to do anything (unless it's
+    block scoped, when we need to point the name at the new var) */
+    if (hasInitialiser || jit->phase != JSJP_EMIT) {
+      jsvUnLock(jsjFactorIDAndUnLock(name, declType));
+    } else if (declType!=LEX_R_VAR && jit->scopeDepth) {
       jsvUnLock(jsjFactorIDAndUnLock(name, declType));
+      jsjPopAndUnLock();
+    } else
+      jsvUnLock(name);
     if (hasInitialiser) { // sort out initialiser
       DEBUG_JIT_EMIT("; Variable's initialiser\n");
       JSP_ASSERT_MATCH('=');
       jsjAssignmentExpression();
-      if (jit->phase == JSJP_EMIT) {
-        // _jsxVarInitialAssign(r0:var, r1:isConstant, r2:initialValue)
-        jsjPopAsVar(4); // r2 -> initial value
-        jsjPopAsVar(0); // r0 -> variable (from jsjFactorIDAndUnLock)
-        jsjcLiteral8(1, (declType==LEX_R_CONST)?1:0); // r1 -> if we're a constant
-        jsjcMov(2, 4); // b -> r2 (converting r0 could have clobbered r1)
-        jsjcCall(_jsxVarInitialAssign); // set the var's initial value
-      }
+      if (jit->phase == JSJP_EMIT)
+        jsjVarInitialAssign(declType==LEX_R_CONST);
     }
     hasComma = lex->tk == ',';
     if (hasComma) JSP_ASSERT_MATCH(',');
@@ -1147,8 +1748,16 @@ void jsjStatementIf() {
   jsvUnLock2(trueBlock,falseBlock);
 }
 
+/// Capture the code that checks for exceptions (or Ctrl-C) at the end of each loop iteration
+JsVar *jsjLoopExceptionCheckBlock() {
+  JsVar *oldBlock = jsjcStartBlock();
+  jsjExceptionCheck(jspHasError);
+  return jsjcStopBlock(oldBlock);
+}
+
 void jsjStatementFor() {
   JSP_ASSERT_MATCH(LEX_R_FOR);
+  int scope = jsjScopeStart(); // `for (let i=...` is scoped to the loop
   JSP_MATCH('(');
   // we could have 'for (;;)' - so don't munch up our semicolon if that's all we have
   // Parse initialiser - we always run this so march right in and create code
@@ -1160,7 +1769,8 @@ void jsjStatementFor() {
   // after the main loop
   int codePosCondition = jsjcGetByteCount();
   DEBUG_JIT_EMIT("; FOR condition\n");
-  if (lex->tk != ';') {
+  bool hasCondition = lex->tk != ';';
+  if (hasCondition) {
     jsjExpression(); // condition
     if (jit->phase == JSJP_EMIT) {
       jsjPopAsBool(0);
@@ -1181,27 +1791,36 @@ void jsjStatementFor() {
   JSP_MATCH(')'); // FIXME: clean up on exit
   // Now parse the actual code to execute
   DEBUG_JIT_EMIT("; Parsing FOR Main block\n");
+  int target = jsjTargetStart(JSJT_LOOP);
   oldBlock = jsjcStartBlock();
   jsjBlockOrStatement();
   JsVar *mainBlock = jsjcStopBlock(oldBlock);
+  JsVar *checkBlock = jsjLoopExceptionCheckBlock();
   DEBUG_JIT_EMIT("; Branch OVER main block to END\n");
   // Now figure out the jump length and jump (if condition is false)
   if (jit->phase == JSJP_EMIT) {
-    jsjcBranchConditionalRelative(JSJAC_EQ, jsvGetStringLength(iteratorBlock) + jsvGetStringLength(mainBlock) + 4, JSJC_FORCE_4BYTE);
+    if (hasCondition)
+      jsjcBranchConditionalRelative(JSJAC_EQ, jsvGetStringLength(iteratorBlock) + jsvGetStringLength(mainBlock) + jsvGetStringLength(checkBlock) + JSJ_BRANCH_LONG_LENGTH, JSJC_FORCE_LONG);
     DEBUG_JIT_EMIT("; FOR Main block\n");
     jsjcEmitBlock(mainBlock);
     DEBUG_JIT_EMIT("; FOR Iterator block\n");
+    jsjcResolveFixups(target, JSJF_CONTINUE, jsjcGetByteCount());
     jsjcEmitBlock(iteratorBlock);
+    jsjcEmitBlock(checkBlock);
     // after the iterator, jump back to condition
     DEBUG_JIT_EMIT("; FOR jump back to condition\n");
-    jsjcBranchRelative(codePosCondition - (jsjcGetByteCount()+4), JSJC_FORCE_4BYTE);
+    jsjcBranchRelative(codePosCondition - (jsjcGetByteCount()+JSJ_BRANCH_LONG_LENGTH), JSJC_FORCE_LONG);
     DEBUG_JIT_EMIT("; FOR end\n");
+    jsjcResolveFixups(target, JSJF_BREAK, jsjcGetByteCount());
   }
-  jsvUnLock2(mainBlock, iteratorBlock);
+  jsvUnLock3(mainBlock, iteratorBlock, checkBlock);
+  jsjTargetEnd(target);
+  jsjScopeEnd(scope);
 }
 
 void jsjStatementDoOrWhile(bool isWhile) {
   int codePosStart = jsjcGetByteCount();
+  int target;
   if (isWhile) { // while loop
     JSP_ASSERT_MATCH(LEX_R_WHILE);
     DEBUG_JIT_EMIT("; WHILE condition\n");
@@ -1214,23 +1833,31 @@ void jsjStatementDoOrWhile(bool isWhile) {
     }
     JSP_MATCH(')');
     DEBUG_JIT_EMIT("; Parsing WHILE main block\n");
+    target = jsjTargetStart(JSJT_LOOP);
     JsVar *oldBlock = jsjcStartBlock();
     jsjBlockOrStatement();
     JsVar *mainBlock = jsjcStopBlock(oldBlock);
+    JsVar *checkBlock = jsjLoopExceptionCheckBlock();
     if (jit->phase == JSJP_EMIT) {
       DEBUG_JIT_EMIT("; WHILE condition jump\n");
-      jsjcBranchConditionalRelative(JSJAC_EQ, jsvGetStringLength(mainBlock) + 4, JSJC_FORCE_4BYTE);
+      jsjcBranchConditionalRelative(JSJAC_EQ, jsvGetStringLength(mainBlock) + jsvGetStringLength(checkBlock) + JSJ_BRANCH_LONG_LENGTH, JSJC_FORCE_LONG);
       DEBUG_JIT_EMIT("; WHILE Main block\n");
       jsjcEmitBlock(mainBlock);
+      jsjcResolveFixups(target, JSJF_CONTINUE, jsjcGetByteCount());
+      jsjcEmitBlock(checkBlock);
       DEBUG_JIT_EMIT("; WHILE jump back to condition\n");
-      jsjcBranchRelative(codePosStart - (jsjcGetByteCount()+4), JSJC_FORCE_4BYTE);
+      jsjcBranchRelative(codePosStart - (jsjcGetByteCount()+JSJ_BRANCH_LONG_LENGTH), JSJC_FORCE_LONG);
     }
-    jsvUnLock(mainBlock);
+    jsvUnLock2(mainBlock, checkBlock);
   } else { // do..while loop
     JSP_ASSERT_MATCH(LEX_R_DO);
     DEBUG_JIT_EMIT("; DO Main block\n");
+    target = jsjTargetStart(JSJT_LOOP);
     jsjBlockOrStatement();
-    JSP_ASSERT_MATCH(LEX_R_WHILE);
+    if (jit->phase == JSJP_EMIT)
+      jsjcResolveFixups(target, JSJF_CONTINUE, jsjcGetByteCount());
+    jsjExceptionCheck(jspHasError);
+    JSP_MATCH(LEX_R_WHILE);
     DEBUG_JIT_EMIT("; DO condition\n");
     JSP_MATCH('(');
     jsjExpression();
@@ -1238,12 +1865,260 @@ void jsjStatementDoOrWhile(bool isWhile) {
     if (jit->phase == JSJP_EMIT) {
       jsjPopAsBool(0);
       jsjcCompareImm(0, 0);
-      jsjcBranchConditionalRelative(JSJAC_NE, codePosStart - (jsjcGetByteCount()+4), JSJC_FORCE_4BYTE);
+      jsjcBranchConditionalRelative(JSJAC_NE, codePosStart - (jsjcGetByteCount()+JSJ_BRANCH_COND_LONG_LENGTH), JSJC_FORCE_LONG);
     }
   }
+  if (jit->phase == JSJP_EMIT) {
+    DEBUG_JIT_EMIT("; WHILE end\n");
+    jsjcResolveFixups(target, JSJF_BREAK, jsjcGetByteCount());
+  }
+  jsjTargetEnd(target);
+}
+
+void jsjStatementSwitch() {
+  JSP_ASSERT_MATCH(LEX_R_SWITCH);
+  DEBUG_JIT_EMIT("; SWITCH value\n");
+  JSP_MATCH('(');
+  jsjExpression();
+  JSP_MATCH(')');
+  if (jit->phase == JSJP_EMIT) {
+    // The value stays on the stack while we compare it with each case
+    jsjPopNoName(0);
+    jsjcPush(0, JSJVT_JSVAR_NO_NAME);
+  }
+  int switchValueIndex = jit->stackDepth-1;
+  int target = jsjTargetStart(JSJT_SWITCH);
+  JSP_MATCH('{');
+  int scope = jsjScopeStart();
+  bool hadCase = false;
+  int codePosDefault = -1;
+  while (JSJ_PARSING && (lex->tk==LEX_R_CASE || lex->tk==LEX_R_DEFAULT)) {
+    if (lex->tk==LEX_R_CASE) {
+      JSP_ASSERT_MATCH(LEX_R_CASE);
+      DEBUG_JIT_EMIT("; capture CASE condition\n");
+      JsVar *oldBlock = jsjcStartBlock();
+      jsjAssignmentExpression();
+      if (jit->phase == JSJP_EMIT) {
+        jsjPopNoName(1); // r1 = case value
+        jsjcLoadImm(0, JSJAR_SP, (jit->stackDepth - (switchValueIndex+1)) * JSJ_WORD_SIZE); // r0 = switch value
+        jsjcCall(_jsxSwitchCase); // _jsxSwitchCase(switchValue, caseValue) unlocks caseValue
+        jsjcCompareImm(0, 0);
+        jsjcBranchFixup(JSJAC_EQ, target, JSJF_NEXT_CASE); // no match - go to the next case
+      }
+      JsVar *caseBlock = jsjcStopBlock(oldBlock);
+      JSP_MATCH_WITH_CLEANUP(':', jsvUnLock(caseBlock));
+      if (jit->phase == JSJP_EMIT) {
+        // if the last case didn't 'break', we run straight into this one's code without checking
+        if (hadCase) jsjcBranchRelative(jsvGetStringLength(caseBlock), JSJC_NONE);
+        DEBUG_JIT("; CASE condition\n");
+        jsjcResolveFixups(target, JSJF_NEXT_CASE, jsjcGetByteCount());
+        jsjcEmitBlock(caseBlock);
+      }
+      jsvUnLock(caseBlock);
+    } else {
+      JSP_ASSERT_MATCH(LEX_R_DEFAULT);
+      JSP_MATCH(':');
+      DEBUG_JIT_EMIT("; DEFAULT\n");
+      codePosDefault = jsjcGetByteCount();
+    }
+    hadCase = true;
+    while (JSJ_PARSING && lex->tk!=LEX_EOF && lex->tk!=LEX_R_CASE && lex->tk!=LEX_R_DEFAULT && lex->tk!='}')
+      jsjBlockOrStatement();
+  }
+  jsjScopeEnd(scope);
+  JSP_MATCH('}');
+  if (jit->phase == JSJP_EMIT) {
+    if (codePosDefault>=0) {
+      DEBUG_JIT("; SWITCH no match - jump to DEFAULT\n");
+      jsjcBranchRelative(JSJ_BRANCH_LONG_LENGTH, JSJC_NONE); // the last case ran - skip the jump to default
+      jsjcResolveFixups(target, JSJF_NEXT_CASE, jsjcGetByteCount());
+      jsjcBranchRelative(codePosDefault - (jsjcGetByteCount()+JSJ_BRANCH_LONG_LENGTH), JSJC_FORCE_LONG);
+    } else
+      jsjcResolveFixups(target, JSJF_NEXT_CASE, jsjcGetByteCount());
+    DEBUG_JIT("; SWITCH end\n");
+    jsjcResolveFixups(target, JSJF_BREAK, jsjcGetByteCount());
+    jsjPopAndUnLock(); // the switch value
+  }
+  jsjTargetEnd(target);
+}
+
+void jsjStatementTry() {
+  JSP_ASSERT_MATCH(LEX_R_TRY);
+  // look ahead to see if we have catch and finally
+  size_t tryStart = lex->tokenStart;
+  jsjSkipBrackets();
+  bool hasCatch = lex->tk==LEX_R_CATCH;
+  if (hasCatch) {
+    jslGetNextToken();
+    if (lex->tk=='(') jsjSkipBrackets();
+    jsjSkipBrackets();
+  }
+  bool hasFinally = lex->tk==LEX_R_FINALLY;
+  jslSeekTo(tryStart);
+  // Exceptions in 'try' go to 'catch' if there is one, or 'finally'. Exceptions in 'catch' go to 'finally'
+  int finallyTarget = -1, tryTarget = -1;
+  if (hasFinally) {
+    finallyTarget = jsjTargetStart(JSJT_TRY);
+    if (finallyTarget>=0) jit->targets[finallyTarget].hasFinally = true;
+  }
+  if (hasCatch)
+    tryTarget = jsjTargetStart(JSJT_TRY);
+  DEBUG_JIT_EMIT("; TRY block\n");
+  jsjBlock();
+  jsjTargetEnd(tryTarget);
+  if (hasCatch) {
+    JSP_ASSERT_MATCH(LEX_R_CATCH);
+    DEBUG_JIT_EMIT("; capture CATCH block\n");
+    int scope = jsjScopeStart(); // the exception var is scoped to the catch block
+    JsVar *oldBlock = jsjcStartBlock();
+    jsjExceptionCheck(_jsxHasUncatchableError); // we can't catch Ctrl-C/errors - go to the next handler
+    if (lex->tk=='(') {
+      JSP_ASSERT_MATCH('(');
+      JsVar *name = jslGetTokenValueAsVar();
+      JSP_MATCH_WITH_CLEANUP(LEX_ID, jsvUnLock(name); jsvUnLock(jsjcStopBlock(oldBlock)));
+      JSP_MATCH_WITH_CLEANUP(')', jsvUnLock(name); jsvUnLock(jsjcStopBlock(oldBlock)));
+      jsvUnLock(jsjFactorIDAndUnLock(name, LEX_R_LET));
+      if (jit->phase == JSJP_EMIT) {
+        jsjcCall(_jsxCatchException);
+        jsjcPush(0, JSJVT_JSVAR_NO_NAME);
+        jsjVarInitialAssign(false);
+      }
+    } else if (jit->phase == JSJP_EMIT) {
+      jsjcCall(_jsxCatchException);
+      jsjcCall(jsvUnLock);
+    }
+    jsjBlock();
+    JsVar *catchBlock = jsjcStopBlock(oldBlock);
+    jsjScopeEnd(scope);
+    if (jit->phase == JSJP_EMIT) {
+      DEBUG_JIT("; TRY no exception - jump over CATCH\n");
+      jsjcBranchRelative(jsvGetStringLength(catchBlock), JSJC_NONE);
+      DEBUG_JIT("; CATCH block\n");
+      jsjcResolveFixups(tryTarget, JSJF_EXCEPTION, jsjcGetByteCount());
+      jsjcEmitBlock(catchBlock);
+    }
+    jsvUnLock(catchBlock);
+  }
+  if (hasFinally || !hasCatch) {
+    jsjTargetEnd(finallyTarget);
+    JSP_MATCH(LEX_R_FINALLY);
+    if (jit->phase == JSJP_EMIT) {
+      DEBUG_JIT("; FINALLY block\n");
+      jsjcResolveFixups(finallyTarget, JSJF_EXCEPTION, jsjcGetByteCount());
+      jsjExceptionCheck(_jsxHasUncatchableError);
+      jsjcCall(_jsxFinallyStart); // clear any exception while we run 'finally'
+      jsjcResolveFixups(finallyTarget, JSJF_RETURN, jsjcGetByteCount()); // 'return' arrives here with r0 = _jsxFinallyReturn's result
+      jsjcPush(0, JSJVT_JSVAR_NO_NAME);
+    }
+    jsjBlock();
+    if (jit->phase == JSJP_EMIT) {
+      jsjcPop(0);
+      jsjcCall(_jsxFinallyEnd); // put back any exception
+      // if we were returning, carry on returning now 'finally' has run
+      jsjcCompareImm(0, 0);
+      JsVar *oldBlock = jsjcStartBlock();
+      jsjReturn(true/*isPendingReturn*/);
+      JsVar *returnBlock = jsjcStopBlock(oldBlock);
+      jsjcBranchConditionalRelative(JSJAC_EQ, (int)jsvGetStringLength(returnBlock), JSJC_NONE);
+      jsjcEmitBlock(returnBlock);
+      jsvUnLock(returnBlock);
+      jsjExceptionCheck(jspHasError);
+    }
+  }
+}
+
+/// Return true if jumping out to 'target' would skip over a 'finally' block
+bool jsjJumpSkipsFinally(int target) {
+  for (int i=target+1;i<jit->targetCount;i++)
+    if (jit->targets[i].hasFinally) {
+      jsExceptionHere(JSET_ERROR, "JIT: can't jump out of try..finally");
+      return true;
+    }
+  return false;
+}
+
+void jsjStatementBreakOrContinue(bool isBreak) {
+  JSP_ASSERT_MATCH(isBreak ? LEX_R_BREAK : LEX_R_CONTINUE);
+  JsVar *label = 0;
+  if (lex->tk==LEX_ID) {
+    label = jslGetTokenValueAsVar();
+    JSP_ASSERT_MATCH(LEX_ID);
+  }
+  // find the loop/switch/label that we're jumping out of
+  int target = jit->targetCount-1;
+  while (target>=0) {
+    JsjTarget *t = &jit->targets[target];
+    if (label ? (t->label && jsvIsBasicVarEqual(t->label, label)) :
+                (t->type==JSJT_LOOP || (isBreak && t->type==JSJT_SWITCH)))
+      break;
+    target--;
+  }
+  if (target<0 || (!isBreak && jit->targets[target].type!=JSJT_LOOP)) {
+    if (label)
+      jsExceptionHere(JSET_SYNTAXERROR, "Label %q not found", label);
+    else if (isBreak)
+      jsExceptionHere(JSET_SYNTAXERROR, "BREAK statement outside of SWITCH, FOR or WHILE loop");
+    else
+      jsExceptionHere(JSET_SYNTAXERROR, "CONTINUE statement outside of FOR or WHILE loop");
+  } else if (!jsjJumpSkipsFinally(target) && jit->phase == JSJP_EMIT) {
+    DEBUG_JIT("; %s\n", isBreak ? "BREAK" : "CONTINUE");
+    jsjUnwindStack(jit->targets[target].stackDepth);
+    jsjcBranchFixup(JSJAC_AL, target, isBreak ? JSJF_BREAK : JSJF_CONTINUE);
+  }
+  jsvUnLock(label);
+}
+
+// `label: statement` - the label has already been parsed
+void jsjStatementLabelled(JsVar *label) {
+  JSP_ASSERT_MATCH(':');
+  jsvUnLock(jit->pendingLabel);
+  jit->pendingLabel = label; // used by the next call to jsjTargetStart
+  if (lex->tk==LEX_R_FOR || lex->tk==LEX_R_WHILE || lex->tk==LEX_R_DO) {
+    jsjStatement(); // the loop uses the label itself, so 'continue label' works
+  } else {
+    int target = jsjTargetStart(JSJT_LABEL);
+    jsjBlockOrStatement();
+    if (jit->phase == JSJP_EMIT)
+      jsjcResolveFixups(target, JSJF_BREAK, jsjcGetByteCount());
+    jsjTargetEnd(target);
+  }
+}
+
+void jsjStatementThrow() {
+  JSP_ASSERT_MATCH(LEX_R_THROW);
+  jsjExpression();
+  if (jit->phase == JSJP_EMIT) {
+    DEBUG_JIT("; THROW\n");
+    jsjPopNoName(0);
+    jsjcCall(_jsxThrow); // unlocks r0
+    jsjExceptionJump();
+  }
+}
+
+// `function foo() {}` - this is handled like `var foo = function() {}`
+void jsjStatementFunctionDecl() {
+  size_t funcStart = lex->tokenStart;
+  JSP_ASSERT_MATCH(LEX_R_FUNCTION);
+  JsVar *name = jslGetTokenValueAsVar();
+  JSP_MATCH_WITH_CLEANUP(LEX_ID, jsvUnLock(name));
+  jslSeekTo(funcStart);
+  jsvUnLock(jsjFactorIDAndUnLock(name, LEX_R_VAR));
+  jsjFunctionDefinition();
+  if (jit->phase == JSJP_EMIT)
+    jsjVarInitialAssign(false);
 }
 
 void jsjStatement() {
+  if (lex->tk==LEX_ID) {
+    // check for `label:`
+    size_t idStart = lex->tokenStart;
+    JsVar *label = jslGetTokenValueAsVar();
+    JSP_ASSERT_MATCH(LEX_ID);
+    if (lex->tk==':')
+      return jsjStatementLabelled(label);
+    jsvUnLock(label);
+    jslSeekTo(idStart);
+  }
   if (lex->tk==LEX_ID ||
       lex->tk==LEX_INT ||
       lex->tk==LEX_FLOAT ||
@@ -1287,8 +2162,8 @@ void jsjStatement() {
     return jsjStatementDoOrWhile(lex->tk==LEX_R_WHILE);
   } else if (lex->tk==LEX_R_FOR) {
     return jsjStatementFor();
-  /*} else if (lex->tk==LEX_R_TRY) {
-    return jsjStatementTry();*/
+  } else if (lex->tk==LEX_R_TRY) {
+    return jsjStatementTry();
   } else if (lex->tk==LEX_R_RETURN) {
     JSP_ASSERT_MATCH(LEX_R_RETURN);
     if (lex->tk != ';' && lex->tk != '}') {
@@ -1299,16 +2174,15 @@ void jsjStatement() {
       DEBUG_JIT_EMIT("; RETURN undefined\n");
       if (jit->phase == JSJP_EMIT) jsjcLiteral32(0, 0);
     }
-    if (jit->phase == JSJP_EMIT) jsjFunctionReturn(true/*isReturnStatement*/);
-/*} else if (lex->tk==LEX_R_THROW) {
+    if (jit->phase == JSJP_EMIT) jsjReturn(false/*isPendingReturn*/);
+  } else if (lex->tk==LEX_R_THROW) {
+    return jsjStatementThrow();
   } else if (lex->tk==LEX_R_FUNCTION) {
-  } else if (lex->tk==LEX_R_CONTINUE) {
-    JSP_ASSERT_MATCH(LEX_R_CONTINUE);
-  } else if (lex->tk==LEX_R_BREAK) {
-    JSP_ASSERT_MATCH(LEX_R_BREAK);
-    if (JSP_SHOULD_EXECUTE) {
+    return jsjStatementFunctionDecl();
+  } else if (lex->tk==LEX_R_CONTINUE || lex->tk==LEX_R_BREAK) {
+    return jsjStatementBreakOrContinue(lex->tk==LEX_R_BREAK);
   } else if (lex->tk==LEX_R_SWITCH) {
-    return jsjStatementSwitch();*/
+    return jsjStatementSwitch();
   } else JSP_MATCH(LEX_EOF);
 }
 
@@ -1318,10 +2192,31 @@ void jsjBlockOrStatement() {
   } else {
     jsjStatement();
     if (lex->tk==';') JSP_ASSERT_MATCH(';');
+    if (jsjIsInTry()) jsjExceptionCheck(jspHasError);
     // FIXME pop?
   }
 }
 
+/* Look ahead through the function's code. If no functions are defined inside it (and it doesn't use eval/arguments)
+then only our code can see its local vars, so we can keep them unboxed on the stack */
+bool jsjCanUnboxLocals() {
+  size_t codeStart = lex->tokenStart;
+  bool canUnbox = true;
+  int depth = 0;
+  while (canUnbox && depth>=0 && lex->tk!=LEX_EOF) {
+    if (lex->tk=='{') depth++;
+    else if (lex->tk=='}') depth--;
+    else if (lex->tk==LEX_R_FUNCTION || lex->tk==LEX_ARROW_FUNCTION) canUnbox = false;
+    else if (lex->tk==LEX_ID) {
+      const char *id = jslGetTokenValueAsString();
+      if (!strcmp(id, "eval") || !strcmp(id, "arguments")) canUnbox = false;
+    }
+    jslGetNextToken();
+  }
+  jslSeekTo(codeStart);
+  return canUnbox;
+}
+
 JsVar *jsjParseFunction() {
   JsExecFlags oldExec = execInfo.execute;
   JsjInfo _jit;
@@ -1333,11 +2228,13 @@ JsVar *jsjParseFunction() {
   jsjFunctionStart();
   // Parse the function
   size_t codeStartPosition = lex->tokenStart; // otherwise we include 'jit' too!
+  jit->unboxLocals = jsjCanUnboxLocals();
   jit->phase = JSJP_SCAN; DEBUG_JIT("; ============ SCAN PHASE\n");
   jsjBlockNoBrackets();
   if (JSJ_PARSING) { // if no error, re-parse and create code
     jslSeekTo(codeStartPosition);
     jit->phase = JSJP_EMIT; DEBUG_JIT("; ============ EMIT PHASE\n");
+    jit->letCount = 0; // we look up block-scoped vars again in the same order
     bool hadReturnStatement = jsjBlockNoBrackets(true);
     // if this block had a return in it (eg not behind 'if'/etc), hadReturnStatement=true
     // if so, we can skip adding a return statement
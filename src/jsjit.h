@@ -19,6 +19,10 @@
 #define DEBUG_JIT_CALLS
 #endif
 
+#if defined(__x86_64__)
+#define JSJ_X64 // Create x86-64 code (jsjitc_x64.c) rather than ARM Thumb-2, so Linux builds can run JIT code
+#endif
+
 #include "jsparse.h"
 
 JsVar *jsjEvaluateVar(JsVar *str);
@@ -43,6 +43,8 @@ const char *jsjcGetTypeName(JsjValueType t) {
     case JSJVT_INT: return "int";
     case JSJVT_JSVAR: return "JsVar";
     case JSJVT_JSVAR_NO_NAME: return "JsVar-value";
+    case JSJVT_TAGGED: return "tagged";
+    case JSJVT_LOCAL: return "local";
     default: return "unknown";
   }
 }
@@ -64,14 +66,10 @@ void jsjcDebugPrintf(const char *fmt, ...) {
 
 // flush any previously stored code (for peephole optimisations)
 static void jsjcFlushCode() {
-  if (jit->hasLastCode) {
-    char *bytes = (char *)&jit->lastCode;
-    //jsvAppendStringBuf(jit->code, bytes, 2);
-    jsvStringIteratorAppend(&jit->codeIt, bytes[0]);
-    jsvStringIteratorAppend(&jit->codeIt, bytes[1]);
-    jit->lastCode = 0;
-    jit->hasLastCode = false;
-  }
+  for (int i=0;i<jit->lastCodeLen;i++)
+    jsvStringIteratorAppend(&jit->codeIt, (char)(jit->lastCode >> (i*8)));
+  jit->lastCode = 0;
+  jit->lastCodeLen = 0;
 }
 
 void jsjcStart(JsjInfo *_jit) {
@@ -79,13 +77,22 @@ void jsjcStart(JsjInfo *_jit) {
   jit->phase = JSJP_UNKNOWN;
   jit->code = jsvNewFromEmptyString();
   jsvStringIteratorNew(&jit->codeIt, jit->code, 0);
-  jit->hasLastCode = 0;
+  jit->lastCodeLen = 0;
   jit->initCode = jsvNewFromEmptyString(); // FIXME: maybe we don't need this?
   jit->blockCount = 0;
   jit->vars = jsvNewObject();
   jit->varCount = 0;
   jit->stackDepth = 0;
   jit->regsInUse = 0;
+  jit->targetCount = 0;
+  jit->pendingLabel = 0;
+  jit->fixupCount = 0;
+  jit->scopeDepth = 0;
+  jit->scopeRestore = jsvNewEmptyArray();
+  jit->letSlots = jsvNewEmptyArray();
+  jit->letCount = 0;
+  jit->blockVarHolder = -1;
+  jit->unboxLocals = false;
 }
 
 JsVar *jsjcStop() {
@@ -93,6 +100,11 @@ JsVar *jsjcStop() {
   jsvUnLock(jit->vars);
   jit->vars = 0;
   assert(jspHasError() || jit->stackDepth == 0); // stack depth may be wrong if there's an exception
+  assert(jspHasError() || (jit->targetCount==0 && jit->fixupCount==0));
+  // if there was an error we could still have labels locked
+  for (int i=0;i<jit->targetCount;i++)
+    jsvUnLock(jit->targets[i].label);
+  jsvUnLock3(jit->pendingLabel, jit->scopeRestore, jit->letSlots);
 
   assert(jit->blockCount==0);
 #ifdef JIT_OUTPUT_FILE
@@ -169,10 +181,32 @@ JsVar *jsjcStopBlock(JsVar *oldBlock) {
   return v;
 }
 
+// Emit a whole block of code
+void jsjcEmitBlock(JsVar *block) {
+  DEBUG_JIT("... code block ...\n");
+  jsjcFlushCode();
+  // Any branches waiting for a destination are now in this block of code
+  int blockPos = (int)jsvGetStringLength(jit->code);
+  for (int i=0;i<jit->fixupCount;i++) {
+    if (jit->fixups[i].block == block) {
+      jit->fixups[i].block = jit->code;
+      jit->fixups[i].offset = (uint16_t)(jit->fixups[i].offset + blockPos);
+    }
+  }
+  jsvStringIteratorAppendString(&jit->codeIt, block, 0, JSVAPPENDSTRINGVAR_MAXLENGTH);
+}
+
+int jsjcGetByteCount() {
+  return jsvGetStringLength(jit->code) + jit->lastCodeLen;
+}
+
+#ifndef JSJ_X64
+// ============================================================================ ARM Thumb-2
+
 void jsjcEmit16(uint16_t v) {
-  if (jit->hasLastCode) {
+  if (jit->lastCodeLen) {
     if (jit->lastCode==0b1011010000000001 && v==0b1011110000000001) {
-      jit->hasLastCode = false;
+      jit->lastCodeLen = 0;
       DEBUG_JIT("PEEPHOLE: PUSH r0 + POP r0 => nop\n");
       return;
     }
@@ -183,21 +217,10 @@ void jsjcEmit16(uint16_t v) {
     }
   }
   jsjcFlushCode();
-  jit->hasLastCode = true;
+  jit->lastCodeLen = 2;
   jit->lastCode = v;
 }
 
-// Emit a whole block of code
-void jsjcEmitBlock(JsVar *block) {
-  DEBUG_JIT("... code block ...\n");
-  jsjcFlushCode();
-  jsvStringIteratorAppendString(&jit->codeIt, block, 0, JSVAPPENDSTRINGVAR_MAXLENGTH);
-}
-
-int jsjcGetByteCount() {
-  return jsvGetStringLength(jit->code) + (jit->hasLastCode?2:0);
-}
-
 void jsjcLiteral8(int reg, uint8_t data) {
   assert(reg<8);
   // https://web.eecs.umich.edu/~prabal/teaching/eecs373-f11/readings/ARMv7-M_ARM.pdf page 347
@@ -239,6 +262,10 @@ void jsjcLiteral64(int reg, uint64_t data) {
   jsjcLiteral32(reg+1, (uint32_t)(data>>32));
 }
 
+void jsjcLiteralPtr(int reg, void *data) {
+  jsjcLiteral32(reg, (uint32_t)(size_t)data);
+}
+
 int jsjcLiteralString(int reg, JsVar *str, bool nullTerminate) {
   /* We store the String data here in-line, so store the PC location then jump forward over the data. */
   int len = (int)jsvGetStringLength(str);
@@ -273,6 +300,44 @@ void jsjcCompareImm(int reg, int literal) {
   jsjcEmit16((uint16_t)(0b0010100000000000 | (reg<<8) | imm8)); // unconditional branch
 }
 
+/* Encode a 4 byte branch (B.W, or B<c>.W if cond!=JSJAC_AL). 'bytes' is relative to the end of the instruction.
+Returns the first 16 bit word in the top 16 bits */
+static uint32_t jsjcEncodeBranchW(JsjAsmCondition cond, int bytes) {
+  // https://developer.arm.com/documentation/ddi0308/d/Thumb-Instructions/Alphabetical-list-of-Thumb-instructions/B
+  // must pad out by 1 word because this is a double-length instruction - we just don't subtract 2 like we do for 2 byte instr
+  if (cond==JSJAC_AL) { // B.W - encoding T4
+    int imm24 = (bytes>>1);
+    int S = (imm24>>23) & 1;
+    int I1 = (imm24>>22) & 1;
+    int I2 = (imm24>>21) & 1;
+    int J1 = !(I1^S);
+    int J2 = !(I2^S);
+    int imm10 = (imm24>>11) & 1023;
+    int imm11 = imm24 & 2047;
+    return ((uint32_t)(0b1111000000000000 | (S<<10) | imm10) << 16) |
+           (uint32_t)(0b1001000000000000 | (J1<<13) | (J2<<11) | imm11);
+  } else { // B<c>.W - encoding T3
+    int imm20 = (bytes>>1);
+    int S = (imm20>>19) & 1;
+    int J2 = (imm20>>18) & 1;
+    int J1 = (imm20>>17) & 1;
+    int imm6 = (imm20>>11) & 63;
+    int imm11 = imm20 & 2047;
+    return ((uint32_t)(0b1111000000000000 | (S<<10) | ((int)cond<<6) | imm6) << 16) |
+           (uint32_t)(0b1000000000000000 | (J1<<13) | (J2<<11) | imm11);
+  }
+}
+
+// Write a long branch (as used by jsjcBranchFixup) to buf, and return its length
+int jsjcEncodeBranchLong(JsjAsmCondition cond, int bytes, char *buf) {
+  uint32_t op = jsjcEncodeBranchW(cond, bytes);
+  buf[0] = (char)(op>>16);
+  buf[1] = (char)(op>>24);
+  buf[2] = (char)op;
+  buf[3] = (char)(op>>8);
+  return 4;
+}
+
 // Get length of jsjcBranchRelative in bytes
 int jsjcGetBranchRelativeLength(int bytes) {
   if (bytes<-2044 || bytes>=2050) // we subtract 2 later
@@ -284,7 +349,7 @@ int jsjcGetBranchRelativeLength(int bytes) {
 int jsjcBranchRelative(int bytes, JsjsEmitOptions options) {
   // https://developer.arm.com/documentation/ddi0308/d/Thumb-Instructions/Alphabetical-list-of-Thumb-instructions/B
   assert(!(bytes&1)); // only multiples of 2 bytes
-  if (jsjcGetBranchRelativeLength(bytes)==2 && !(options&JSJC_FORCE_4BYTE)) {
+  if (jsjcGetBranchRelativeLength(bytes)==2 && !(options&JSJC_FORCE_LONG)) {
     bytes -= 2; // because PC is ahead by 2
     DEBUG_JIT("B %s%d (addr 0x%04x)\n", (bytes>=0)?"+":"", (uint32_t)(bytes), jsjcGetByteCount()+bytes);
     assert(bytes>=-2048 && bytes<2048); // check it's in range...
@@ -295,16 +360,9 @@ int jsjcBranchRelative(int bytes, JsjsEmitOptions options) {
     // out of range, need double-size instruction
     // must pad out by 1 word because this is a double-length instruction - we just don't subtract 2 like we do for 2 byte instr
     DEBUG_JIT("B.W %s%d (addr 0x%04x)\n", (bytes>=0)?"+":"", (uint32_t)(bytes), jsjcGetByteCount()+bytes);
-    int imm24 = (bytes>>1);
-    int S = (imm24>>23) & 1;
-    int J2 = (imm24>>22) & 1;
-    int J1 = (imm24>>21) & 1;
-    int I1 = !(J1^S);
-    int I2 = !(J2^S);
-    int imm10 = (imm24>>11) & 1023;
-    int imm11 = imm24 & 2047;
-    jsjcEmit16((uint16_t)(0b1111000000000000 | (S<<10) | imm10)); // conditional branch
-    jsjcEmit16((uint16_t)(0b1001000000000000 | (I1<<13) | (I2<<11) | imm11)); // conditional branch
+    uint32_t op = jsjcEncodeBranchW(JSJAC_AL, bytes);
+    jsjcEmit16((uint16_t)(op>>16));
+    jsjcEmit16((uint16_t)op);
     return 4;
   }
 }
@@ -323,7 +381,7 @@ int jsjcBranchConditionalRelative(JsjAsmCondition cond, int bytes, JsjsEmitOptio
   assert(cond<14); // JSJAC_AL has a special meaning for these instructions
   assert(cond!=14 && cond!=15); // undefined/SVC
   assert(!(bytes&1)); // only multiples of 2 bytes
-  if (jsjcGetBranchConditionalRelativeLength(bytes)==2 && !(options&JSJC_FORCE_4BYTE)) { // B<c>
+  if (jsjcGetBranchConditionalRelativeLength(bytes)==2 && !(options&JSJC_FORCE_LONG)) { // B<c>
     bytes -= 2; // because PC is ahead by 2
     DEBUG_JIT("B<%s> %s%d (addr 0x%04x)\n", &JSJAC_STRINGS[cond*3], (bytes>=0)?"+":"", (uint32_t)(bytes), jsjcGetByteCount()+bytes);
     int imm8 = (bytes>>1) & 255;
@@ -332,14 +390,9 @@ int jsjcBranchConditionalRelative(JsjAsmCondition cond, int bytes, JsjsEmitOptio
   } else if (bytes>=-1048576 && bytes<(1048576-2)) { // B<c>.W
     // must pad out by 1 word because this is a double-length instruction - we just don't subtract 2 like we do for 2 byte instr
     DEBUG_JIT("B<%s>.W %s%d (addr 0x%04x)\n", &JSJAC_STRINGS[cond*3], (bytes>=0)?"+":"", (uint32_t)(bytes), jsjcGetByteCount()+bytes);
-    int imm20 = (bytes>>1);
-    int S = (imm20>>19) & 1;
-    int J2 = (imm20>>18) & 1;
-    int J1 = (imm20>>17) & 1;
-    int imm6 = (imm20>>11) & 63;
-    int imm11 = imm20 & 2047;
-    jsjcEmit16((uint16_t)(0b1111000000000000 | (S<<10) | (cond<<6) | imm6)); // conditional branch
-    jsjcEmit16((uint16_t)(0b1000000000000000 | (J1<<13) | (J2<<11) | imm11)); // conditional branch
+    uint32_t op = jsjcEncodeBranchW(cond, bytes);
+    jsjcEmit16((uint16_t)(op>>16));
+    jsjcEmit16((uint16_t)op);
     return 4;
   } else
     jsExceptionHere(JSET_ERROR, "JIT: B<> jump (%d) out of range", bytes);
@@ -400,68 +453,129 @@ void jsjcAND(int regTo, int regFrom) {
   jsjcEmit16((uint16_t)(0b0100000000000000 | (regFrom<<3) | (regTo)));
 }
 
-// Convert the var type in the given reg to a JsVar
-JsjValueType jsjcConvertToJsVar(int reg, JsjValueType varType) {
-  if (varType==JSJVT_UNDEFINED)
-    return JSJVT_JSVAR_NO_NAME;
-  if (varType==JSJVT_JSVAR || varType==JSJVT_JSVAR_NO_NAME)
-    return varType; // no conversion needed
-  if (varType==JSJVT_BOOL) {
-    if (reg) jsjcMov(0, reg);
-    jsjcCall(jsvNewFromBool); // FIXME: what about clobbering r1-r3? Do a push/pop?
-    if (reg) jsjcMov(reg, 0);
-    return JSJVT_JSVAR_NO_NAME;
-  }
-  if (varType==JSJVT_INT) {
-    if (reg) jsjcMov(0, reg);
-    jsjcCall(jsvNewFromInteger); // FIXME: what about clobbering r1-r3? Do a push/pop?
-    if (reg) jsjcMov(reg, 0);
-    return JSJVT_JSVAR_NO_NAME;
-  }
-  assert(0);
-  return JSJVT_UNDEFINED;
+// regTo = regTo | regFrom
+void jsjcORR(int regTo, int regFrom) {
+  DEBUG_JIT("ORRS r%d <- r%d\n", regTo, regFrom);
+  assert(regTo>=0 && regTo<8);
+  assert(regFrom>=0 && regFrom<8);
+  jsjcEmit16((uint16_t)(0b0100001100000000 | (regFrom<<3) | (regTo)));
 }
 
-void jsjcPush(int reg, JsjValueType type) {
-  DEBUG_JIT("PUSH {r%d}   (%s => stack depth %d)\n", reg, jsjcGetTypeName(type), jit->stackDepth+1);
-  if (jit->stackDepth>=JSJ_TYPE_STACK_SIZE) { // not enough space on type stack
-    DEBUG_JIT("!!! not enough space on type stack - converting to JsVar\n");
-    jsjcConvertToJsVar(reg, type);
-    type = JSJVT_JSVAR;
-  } else
-    jit->typeStack[jit->stackDepth] = type;
-  jit->stackDepth++;
-  assert(reg>=0 && reg<8);
-  jsjcEmit16((uint16_t)(0b1011010000000000 | (1<<reg)));
+// regTo = regTo ^ regFrom
+void jsjcEOR(int regTo, int regFrom) {
+  DEBUG_JIT("EORS r%d <- r%d\n", regTo, regFrom);
+  assert(regTo>=0 && regTo<8);
+  assert(regFrom>=0 && regFrom<8);
+  jsjcEmit16((uint16_t)(0b0100000001000000 | (regFrom<<3) | (regTo)));
 }
 
-// Get the type of the variable on the top of the stack
-JsjValueType jsjcGetTopType() {
-  assert(jit->stackDepth>0);
-  if (jit->stackDepth==0) return JSJVT_UNDEFINED; // Error!
-  if (jit->stackDepth>JSJ_TYPE_STACK_SIZE) return JSJVT_JSVAR; // If too many types, assume JSVAR (we convert when we push)
-  return jit->typeStack[jit->stackDepth-1];
+// regTo = regA + regB (setting flags)
+void jsjcAddReg(int regTo, int regA, int regB) {
+  // https://developer.arm.com/documentation/ddi0308/d/Thumb-Instructions/Alphabetical-list-of-Thumb-instructions/ADD--register-
+  DEBUG_JIT("ADDS r%d <- r%d + r%d\n", regTo, regA, regB);
+  assert(regTo>=0 && regTo<8);
+  assert(regA>=0 && regA<8);
+  assert(regB>=0 && regB<8);
+  jsjcEmit16((uint16_t)(0b0001100000000000 | (regB<<6) | (regA<<3) | (regTo)));
 }
 
-JsjValueType jsjcPop(int reg) {
-  JsjValueType varType = jsjcGetTopType();
-  jit->stackDepth--;
-  DEBUG_JIT("POP {r%d}   (%s <= stack depth %d)\n", reg, jsjcGetTypeName(varType), jit->stackDepth);
+// regTo = regA - regB (setting flags)
+void jsjcSubReg(int regTo, int regA, int regB) {
+  DEBUG_JIT("SUBS r%d <- r%d - r%d\n", regTo, regA, regB);
+  assert(regTo>=0 && regTo<8);
+  assert(regA>=0 && regA<8);
+  assert(regB>=0 && regB<8);
+  jsjcEmit16((uint16_t)(0b0001101000000000 | (regB<<6) | (regA<<3) | (regTo)));
+}
+
+// regTo = regFrom - lit (setting flags)
+void jsjcSub(int regTo, int regFrom, int lit) {
+  DEBUG_JIT("SUBS r%d <- r%d - #%d\n", regTo, regFrom, lit);
+  assert(regTo>=0 && regTo<8);
+  assert(regFrom>=0 && regFrom<8);
+  assert(lit>=0 && lit<8);
+  jsjcEmit16((uint16_t)(0b0001111000000000 | (lit<<6) | (regFrom<<3) | (regTo)));
+}
+
+// regTo = regFrom << lit (setting flags)
+void jsjcLSL(int regTo, int regFrom, int lit) {
+  DEBUG_JIT("LSLS r%d <- r%d << #%d\n", regTo, regFrom, lit);
+  assert(regTo>=0 && regTo<8);
+  assert(regFrom>=0 && regFrom<8);
+  assert(lit>=0 && lit<32);
+  jsjcEmit16((uint16_t)(0b0000000000000000 | (lit<<6) | (regFrom<<3) | (regTo)));
+}
+
+// regTo = regFrom >> lit, arithmetic (setting flags)
+void jsjcASR(int regTo, int regFrom, int lit) {
+  DEBUG_JIT("ASRS r%d <- r%d >> #%d\n", regTo, regFrom, lit);
+  assert(regTo>=0 && regTo<8);
+  assert(regFrom>=0 && regFrom<8);
+  assert(lit>0 && lit<32);
+  jsjcEmit16((uint16_t)(0b0001000000000000 | (lit<<6) | (regFrom<<3) | (regTo)));
+}
+
+// Signed multiply regA*regB into 64 bits - regHi:regLo
+void jsjcSMULL(int regLo, int regHi, int regA, int regB) {
+  // https://developer.arm.com/documentation/ddi0308/d/Thumb-Instructions/Alphabetical-list-of-Thumb-instructions/SMULL
+  DEBUG_JIT("SMULL r%d,r%d <- r%d * r%d\n", regLo, regHi, regA, regB);
+  assert(regLo>=0 && regLo<13 && regHi>=0 && regHi<13 && regLo!=regHi);
+  assert(regA>=0 && regA<13 && regB>=0 && regB<13);
+  jsjcEmit16((uint16_t)(0b1111101110000000 | regA));
+  jsjcEmit16((uint16_t)((regLo<<12) | (regHi<<8) | regB));
+}
+
+// Compare two registers. jsjcBranchConditionalRelative can then be called
+void jsjcCompare(int regA, int regB) {
+  DEBUG_JIT("CMP r%d,r%d\n", regA, regB);
+  assert(regA>=0 && regA<8);
+  assert(regB>=0 && regB<8);
+  jsjcEmit16((uint16_t)(0b0100001010000000 | (regB<<3) | (regA)));
+}
+
+// Compare regA with (regB >> lit) (arithmetic shift). jsjcBranchConditionalRelative can then be called
+void jsjcCompareASR(int regA, int regB, int lit) {
+  // https://developer.arm.com/documentation/ddi0308/d/Thumb-Instructions/Alphabetical-list-of-Thumb-instructions/CMP--register-
+  DEBUG_JIT("CMP.W r%d,r%d ASR #%d\n", regA, regB, lit);
+  assert(regA>=0 && regA<13 && regB>=0 && regB<13);
+  assert(lit>0 && lit<32);
+  jsjcEmit16((uint16_t)(0b1110101110110000 | regA));
+  jsjcEmit16((uint16_t)(((lit>>2)<<12) | (0b1111<<8) | ((lit&3)<<6) | (0b10<<4) | regB)); // type 0b10 = ASR
+}
+
+// Set reg to 1 if cond is true (eg. after jsjcCompare), or 0 if not
+void jsjcSetCond(int reg, JsjAsmCondition cond) {
+  // https://developer.arm.com/documentation/ddi0308/d/Thumb-Instructions/Alphabetical-list-of-Thumb-instructions/IT
+  DEBUG_JIT("ITE %s\n", &JSJAC_STRINGS[cond*3]);
+  assert(cond<14);
+  int mask = ((cond&1) ? 0 : 8) | 4; // 'else' is the opposite of firstcond's bottom bit, then the terminating 1
+  jsjcEmit16((uint16_t)(0b1011111100000000 | (cond<<4) | mask));
+  jsjcLiteral8(reg, 1);
+  jsjcLiteral8(reg, 0);
+}
+
+// Emit the instruction for jsjcPush
+void jsjcEmitPush(int reg) {
+  assert(reg>=0 && reg<8);
+  jsjcEmit16((uint16_t)(0b1011010000000000 | (1<<reg)));
+}
+
+// Emit the instruction for jsjcPop
+void jsjcEmitPop(int reg) {
   assert(reg>=0 && reg<8);
   jsjcEmit16((uint16_t)(0b1011110000000000 | (1<<reg)));
-  return varType;
 }
 
 void jsjcAddSP(int amt) {
   assert((amt&3)==0 && amt>0 && amt<512);
-  jit->stackDepth -= (amt>>2); // stack grows down -> negate
+  jit->stackDepth -= amt/JSJ_WORD_SIZE; // stack grows down -> negate
   DEBUG_JIT("ADD SP,SP,#%d   (stack depth now %d)\n", amt, jit->stackDepth);
   jsjcEmit16((uint16_t)(0b1011000000000000 | (amt>>2)));
 }
 
 void jsjcSubSP(int amt) {
   assert((amt&3)==0 && amt>0 && amt<512);
-  jit->stackDepth += (amt>>2); // stack growsR down -> negate
+  jit->stackDepth += amt/JSJ_WORD_SIZE; // stack growsR down -> negate
   DEBUG_JIT("SUB SP,SP,#%d   (stack depth now %d)\n", amt, jit->stackDepth);
   jsjcEmit16((uint16_t)(0b1011000010000000 | (amt>>2)));
 }
@@ -470,10 +584,10 @@ void jsjcLoadImm(int reg, int regAddr, int offset) {
   assert((offset&3)==0 && offset>=0);
   // https://developer.arm.com/documentation/ddi0308/d/Thumb-Instructions/Alphabetical-list-of-Thumb-instructions/LDR--immediate-
   if (regAddr == JSJAR_SP) {
-    assert(reg<2);
-    assert(offset<4096);
+    assert(reg<8);
+    assert(offset<1024);
     DEBUG_JIT("LDR r%d,[SP,#%d]\n", reg, offset);
-    jsjcEmit16((uint16_t)(0b1001100000000000 | (offset>>2) | (reg<<10)));
+    jsjcEmit16((uint16_t)(0b1001100000000000 | (offset>>2) | (reg<<8)));
   } else {
     assert(reg<8);
     assert(regAddr<8);
@@ -484,8 +598,15 @@ void jsjcLoadImm(int reg, int regAddr, int offset) {
 }
 
 void jsjcStoreImm(int reg, int regAddr, int offset) {
-  assert((offset&3)==0 && offset>=0 && offset<128);
+  assert((offset&3)==0 && offset>=0);
   assert(reg<8);
+  if (regAddr == JSJAR_SP) {
+    assert(offset<1024);
+    DEBUG_JIT("STR r%d,[SP,#%d]\n", reg, offset);
+    jsjcEmit16((uint16_t)(0b1001000000000000 | (offset>>2) | (reg<<8)));
+    return;
+  }
+  assert(offset<128);
   assert(regAddr<8);
   DEBUG_JIT("STR r%d,r%d,#%d\n", reg, regAddr, offset);
   jsjcEmit16((uint16_t)(0b0110000000000000 | ((offset>>2)<<6) | (regAddr<<3) | reg));
@@ -506,11 +627,116 @@ void jsjcPopAllAndReturn() {
   jsjcEmit16(0b0100011100000000 | (reg<<3));
 }*/
 
+#endif // !JSJ_X64
+
+void jsjcBranchFixup(JsjAsmCondition cond, int target, JsjFixupType kind) {
+  if (jit->fixupCount>=JSJ_MAX_FIXUPS) {
+    jsExceptionHere(JSET_ERROR, "JIT: too many jumps");
+    return;
+  }
+  JsjFixup *fixup = &jit->fixups[jit->fixupCount++];
+  jsjcFlushCode();
+  fixup->block = jit->code;
+  fixup->offset = (uint16_t)jsjcGetByteCount();
+  fixup->target = (uint8_t)target;
+  fixup->kind = kind;
+  fixup->cond = (uint8_t)cond;
+  DEBUG_JIT("B<%s>.W ??? (fixup %d)\n", &JSJAC_STRINGS[cond*3], jit->fixupCount-1);
+  // placeholder - filled in by jsjcResolveFixups
+  int len = (cond==JSJAC_AL) ? JSJ_BRANCH_LONG_LENGTH : JSJ_BRANCH_COND_LONG_LENGTH;
+  for (int i=0;i<len;i++)
+    jsvStringIteratorAppend(&jit->codeIt, 0);
+}
+
+void jsjcResolveFixups(int target, JsjFixupType kind, int codePos) {
+  jsjcFlushCode();
+  int i = 0;
+  while (i<jit->fixupCount) {
+    JsjFixup *fixup = &jit->fixups[i];
+    // fixups in blocks that haven't been emitted yet are for later code, so leave them
+    if (fixup->target==target && fixup->kind==kind && fixup->block==jit->code) {
+      DEBUG_JIT("; fixup at 0x%04x -> 0x%04x\n", fixup->offset, codePos);
+      JsjAsmCondition cond = (JsjAsmCondition)fixup->cond;
+      int len = (cond==JSJAC_AL) ? JSJ_BRANCH_LONG_LENGTH : JSJ_BRANCH_COND_LONG_LENGTH;
+      char op[8];
+      jsjcEncodeBranchLong(cond, codePos - (fixup->offset+len), op);
+      JsvStringIterator it;
+      jsvStringIteratorNew(&it, jit->code, fixup->offset);
+      for (int b=0;b<len;b++)
+        jsvStringIteratorSetCharAndNext(&it, op[b]);
+      jsvStringIteratorFree(&it);
+      // remove this fixup - swap the last one in
+      *fixup = jit->fixups[--jit->fixupCount];
+    } else
+      i++;
+  }
+}
+
+// Convert the var type in the given reg to a JsVar
+JsjValueType jsjcConvertToJsVar(int reg, JsjValueType varType) {
+  if (varType==JSJVT_UNDEFINED)
+    return JSJVT_JSVAR_NO_NAME;
+  if (varType==JSJVT_JSVAR || varType==JSJVT_JSVAR_NO_NAME)
+    return varType; // no conversion needed
+  if (varType==JSJVT_BOOL) {
+    if (reg) jsjcMov(0, reg);
+    jsjcCall(jsvNewFromBool); // FIXME: what about clobbering r1-r3? Do a push/pop?
+    if (reg) jsjcMov(reg, 0);
+    return JSJVT_JSVAR_NO_NAME;
+  }
+  if (varType==JSJVT_INT) {
+    if (reg) jsjcMov(0, reg);
+    jsjcCall(jsvNewFromInteger); // FIXME: what about clobbering r1-r3? Do a push/pop?
+    if (reg) jsjcMov(reg, 0);
+    return JSJVT_JSVAR_NO_NAME;
+  }
+  assert(0);
+  return JSJVT_UNDEFINED;
+}
+
+void jsjcPush(int reg, JsjValueType type) {
+  DEBUG_JIT("PUSH {r%d}   (%s => stack depth %d)\n", reg, jsjcGetTypeName(type), jit->stackDepth+1);
+  if (jit->stackDepth>=JSJ_TYPE_STACK_SIZE && (type==JSJVT_TAGGED || type==JSJVT_LOCAL)) {
+    // we can't convert these without calling into jsjit.c - just give up
+    jsExceptionHere(JSET_ERROR, "JIT: too many items on stack");
+  } else if (jit->stackDepth>=JSJ_TYPE_STACK_SIZE) { // not enough space on type stack
+    DEBUG_JIT("!!! not enough space on type stack - converting to JsVar\n");
+    jsjcConvertToJsVar(reg, type);
+    type = JSJVT_JSVAR;
+  } else
+    jit->typeStack[jit->stackDepth] = type;
+  jit->stackDepth++;
+  jsjcEmitPush(reg);
+}
+
+// Push a register loaded from the unboxed local var at index 'slot' on the stack (JSJVT_LOCAL)
+void jsjcPushLocal(int reg, int slot) {
+  if (jit->stackDepth<JSJ_TYPE_STACK_SIZE)
+    jit->localSlots[jit->stackDepth] = (uint8_t)slot;
+  jsjcPush(reg, JSJVT_LOCAL);
+}
+
+// Get the type of the variable on the top of the stack
+JsjValueType jsjcGetTopType() {
+  assert(jit->stackDepth>0);
+  if (jit->stackDepth==0) return JSJVT_UNDEFINED; // Error!
+  if (jit->stackDepth>JSJ_TYPE_STACK_SIZE) return JSJVT_JSVAR; // If too many types, assume JSVAR (we convert when we push)
+  return jit->typeStack[jit->stackDepth-1];
+}
+
+JsjValueType jsjcPop(int reg) {
+  JsjValueType varType = jsjcGetTopType();
+  jit->stackDepth--;
+  DEBUG_JIT("POP {r%d}   (%s <= stack depth %d)\n", reg, jsjcGetTypeName(varType), jit->stackDepth);
+  jsjcEmitPop(reg);
+  return varType;
+}
+
 /// Get the number of a register that we're free to use (or error is none free) and mark as in use
 int jsjcClaimFreeReg() {
   int reg = 4;
   while (jit->regsInUse & (1<<reg)) reg++;
-  if (reg>7) jsExceptionHere(JSET_ERROR, "JIT: too many registers needed");
+  if (reg>6) jsExceptionHere(JSET_ERROR, "JIT: too many registers needed"); // r7 is used by jsjcCall
   jit->regsInUse |= 1<<reg;
   return reg;
 }
@@ -33,13 +33,27 @@ void jsjcDebugPrintf(const char *fmt, ...);
 #endif
 
 #define JSJ_TYPE_STACK_SIZE 64 // Most amount of types stored on stack
+#define JSJ_MAX_TARGETS 8 // Most amount of nested loops/switch/try/labels
+#define JSJ_MAX_FIXUPS 32 // Most amount of break/continue/throw jumps that can be waiting for their destination
+
+#ifdef JSJ_X64
+#define JSJ_WORD_SIZE 8 // Bytes used by each item on the stack
+#define JSJ_BRANCH_LONG_LENGTH 5 // Bytes used by jsjcBranchRelative with JSJC_FORCE_LONG
+#define JSJ_BRANCH_COND_LONG_LENGTH 6 // Bytes used by jsjcBranchConditionalRelative with JSJC_FORCE_LONG
+#else
+#define JSJ_WORD_SIZE 4
+#define JSJ_BRANCH_LONG_LENGTH 4
+#define JSJ_BRANCH_COND_LONG_LENGTH 4
+#endif
 
 typedef enum {
   JSJVT_UNDEFINED,
   JSJVT_BOOL,
   JSJVT_INT,
   JSJVT_JSVAR,        ///< A JsVar
-  JSJVT_JSVAR_NO_NAME ///< A JsVar, and we know it's not a name so it doesn't need SkipName
+  JSJVT_JSVAR_NO_NAME, ///< A JsVar, and we know it's not a name so it doesn't need SkipName
+  JSJVT_TAGGED,       ///< Either an int (shifted left by 1, with bit 0 set) or a locked JsVar value - see JsjTagged
+  JSJVT_LOCAL         ///< A JSJVT_TAGGED loaded from an unboxed local var (jit->localSlots says which one)
 } PACKED_FLAGS JsjValueType;
 
 #define JSJVT_NEEDS_UNLOCK(t) (((t)==JSJVT_JSVAR) || ((t)==JSJVT_JSVAR_NO_NAME))
@@ -63,6 +77,7 @@ typedef enum {
   JSJAC_SVC // 15 - SVC control - https://developer.arm.com/documentation/ddi0308/d/Thumb-Instructions/Alphabetical-list-of-Thumb-instructions/B
 } JsjAsmCondition;
 #define JSJAC_STRING "EQ\0NE\0CS\0CC\0MI\0PL\0VS\0VC\0HI\0LI\0GE\0LT\0GT\0LE\0AL"
+extern const char *JSJAC_STRINGS;
 
 typedef enum {
   JSJAR_r0,
@@ -74,6 +89,46 @@ typedef enum {
   JSJAR_PC = 15,
 } JsjAsmReg;
 
+/// Things we can jump out of with break/continue/throw - see JsjTarget
+typedef enum {
+  JSJT_LOOP,   ///< for/while/do - break and continue
+  JSJT_SWITCH, ///< switch - break only
+  JSJT_LABEL,  ///< A labelled statement that's not a loop - only 'break label'
+  JSJT_TRY,    ///< try - exceptions jump to the catch (or finally) block
+} PACKED_FLAGS JsjTargetType;
+
+typedef struct {
+  JsjTargetType type;
+  /// If set, this is a 'try' with 'finally', so 'return' goes via the finally block, and we can't jump out of it with break/continue (finally wouldn't run)
+  bool hasFinally;
+  /// Stack depth when we entered - when we jump out we unlock and remove everything above this
+  int16_t stackDepth;
+  /// The label for this statement (or 0)
+  JsVar *label;
+} JsjTarget;
+
+/// What a branch added with jsjcBranchFixup jumps to
+typedef enum {
+  JSJF_BREAK,     ///< End of the target
+  JSJF_CONTINUE,  ///< Next iteration of a loop
+  JSJF_EXCEPTION, ///< catch/finally block of a try
+  JSJF_RETURN,    ///< finally block of a try, for a 'return' inside it (see jsjReturn)
+  JSJF_NEXT_CASE, ///< The next 'case' of a switch
+} PACKED_FLAGS JsjFixupType;
+
+/// A forward branch whose destination we don't know yet
+typedef struct {
+  /// The block of code the branch is in (updated when the block is emitted into another block)
+  JsVar *block;
+  /// Byte offset of the branch instruction in 'block'
+  uint16_t offset;
+  /// Index in jit->targets
+  uint8_t target;
+  JsjFixupType kind;
+  /// JsjAsmCondition for the branch (JSJAC_AL = unconditional)
+  uint8_t cond;
+} JsjFixup;
+
 typedef enum {
   JSJP_UNKNOWN,
   JSJP_SCAN, /// scan for variables used
@@ -84,15 +139,15 @@ typedef enum {
 typedef struct {
   /// Which compilation phase are we in?
   JsjPhase phase;
-  /// The ARM Thumb-2 code we're in the process of creating
+  /// The code we're in the process of creating (ARM Thumb-2, or x86-64 if JSJ_X64)
   JsVar *code;
   /// An iterator to increase write speed for code
   JsvStringIterator codeIt;
   /// The last 16 bits we are due to write to codeIt (for peephole optimisations)
   uint16_t lastCode;
-  // Does lastCode contain any data? (do we have stuff we need to flush with jsjcFlushCode)
-  bool hasLastCode;
-  /// The ARM Thumb-2 variable init code block (this goes right at the start of our function)
+  /// How many bytes of lastCode are waiting to be written (with jsjcFlushCode)
+  uint8_t lastCodeLen;
+  /// The variable init code block (this goes right at the start of our function)
   JsVar *initCode;
   /// How many blocks deep are we? blockCount=0 means we're writing to the 'code' var
   int blockCount;
@@ -106,6 +161,28 @@ typedef struct {
   JsjValueType typeStack[JSJ_TYPE_STACK_SIZE];
   /// A bit mask of registers that are currently in use (r4..r7) - see jsjcClaimFreeReg jsjcReturnFreeReg
   uint8_t regsInUse;
+  /// Loops/switches/etc we're currently inside (innermost last)
+  JsjTarget targets[JSJ_MAX_TARGETS];
+  int targetCount;
+  /// A label that has been parsed, that the next loop should take as its own
+  JsVar *pendingLabel;
+  /// Branches that are waiting for jsjcResolveFixups
+  JsjFixup fixups[JSJ_MAX_FIXUPS];
+  int fixupCount;
+  /// How many `{}` blocks deep are we? let/const are only block scoped if scopeDepth>0
+  int scopeDepth;
+  /// Array of [name, old var index] pairs, used to restore jit->vars when a block with let/const ends
+  JsVar *scopeRestore;
+  /// Array of the var index used for each block-scoped let/const (in the order we found them in the SCAN phase)
+  JsVar *letSlots;
+  /// How many block-scoped let/const have we found so far in this phase?
+  int letCount;
+  /// Index on the stack of the object that holds block-scoped vars that shadow other vars (or -1)
+  int blockVarHolder;
+  /// If set, nothing else can see this function's vars, so VAR/LET can be stored unboxed on the stack (see JSJVT_TAGGED)
+  bool unboxLocals;
+  /// For each JSJVT_LOCAL item on the stack, the index on the stack of the local var it came from
+  uint8_t localSlots[JSJ_TYPE_STACK_SIZE];
 } JsjInfo;
 
 // JIT state
@@ -113,7 +190,7 @@ extern JsjInfo *jit;
 
 typedef enum {
   JSJC_NONE = 0,        ///< emit normally
-  JSJC_FORCE_4BYTE = 1  ///< create 4 byte instruction even if 2 byte would have done
+  JSJC_FORCE_LONG = 1   ///< create the long form of an instruction (4 bytes on ARM) even if a short one would have done
 } JsjsEmitOptions;
 
 // Called before start of JIT output (give this a pointer to JsjInfo on the stack)
@@ -137,8 +214,10 @@ void jsjcLiteral8(int reg, uint8_t data);
 void jsjcLiteral16(int reg, bool hi16, uint16_t data);
 // Add 32 bit literal
 void jsjcLiteral32(int reg, uint32_t data);
-// Add 64 bit literal in reg,reg+1
+// Add 64 bit literal in reg,reg+1 (in reg on x86-64 - where it's also put in xmm0 in case it's a double argument)
 void jsjcLiteral64(int reg, uint64_t data);
+// Add a pointer-sized literal
+void jsjcLiteralPtr(int reg, void *data);
 // Call a function
 #ifdef DEBUG_JIT_CALLS
 void _jsjcCall(void *c, const char *name);
@@ -158,6 +237,10 @@ int jsjcBranchRelative(int bytes, JsjsEmitOptions options);
 int jsjcGetBranchConditionalRelativeLength(int bytes);
 // Jump a number of bytes forward or back, based on condition flags, return number of bytes used for op
 int jsjcBranchConditionalRelative(JsjAsmCondition cond, int bytes, JsjsEmitOptions options);
+// Add a long (conditional if cond!=JSJAC_AL) branch whose destination isn't known yet. It is filled in by jsjcResolveFixups
+void jsjcBranchFixup(JsjAsmCondition cond, int target, JsjFixupType kind);
+// Point all branches from jsjcBranchFixup for the given target/kind at codePos in the current block of code
+void jsjcResolveFixups(int target, JsjFixupType kind, int codePos);
 // Move one register to another
 void jsjcMov(int regTo, int regFrom);
 // Add a literal to a number
@@ -166,17 +249,41 @@ void jsjcAdd(int regTo, int regFrom, int lit);
 void jsjcMVN(int regTo, int regFrom);
 // regTo = regTo & regFrom
 void jsjcAND(int regTo, int regFrom);
+// regTo = regTo | regFrom
+void jsjcORR(int regTo, int regFrom);
+// regTo = regTo ^ regFrom
+void jsjcEOR(int regTo, int regFrom);
+// regTo = regA + regB (setting flags)
+void jsjcAddReg(int regTo, int regA, int regB);
+// regTo = regA - regB (setting flags)
+void jsjcSubReg(int regTo, int regA, int regB);
+// regTo = regFrom - lit (setting flags)
+void jsjcSub(int regTo, int regFrom, int lit);
+// regTo = regFrom << lit (setting flags)
+void jsjcLSL(int regTo, int regFrom, int lit);
+// regTo = regFrom >> lit, arithmetic (setting flags)
+void jsjcASR(int regTo, int regFrom, int lit);
+// Signed multiply regA*regB into 64 bits - regHi:regLo
+void jsjcSMULL(int regLo, int regHi, int regA, int regB);
+// Compare two registers. jsjcBranchConditionalRelative can then be called
+void jsjcCompare(int regA, int regB);
+// Compare regA with (regB >> lit) (arithmetic shift). jsjcBranchConditionalRelative can then be called
+void jsjcCompareASR(int regA, int regB, int lit);
+// Set reg to 1 if cond is true (eg. after jsjcCompare), or 0 if not
+void jsjcSetCond(int reg, JsjAsmCondition cond);
 // Convert the var type in the given reg to a JsVar
 JsjValueType jsjcConvertToJsVar(int reg, JsjValueType varType);
 // Push a register onto the stack
 void jsjcPush(int reg, JsjValueType type);
+// Push a register loaded from the unboxed local var at index 'slot' on the stack (JSJVT_LOCAL)
+void jsjcPushLocal(int reg, int slot);
 // Get the type of the variable on the top of the stack
 JsjValueType jsjcGetTopType();
 // Pop off the stack to a register
 JsjValueType jsjcPop(int reg);
-// Add a value to the stack pointer (only multiple of 4)
+// Add a value to the stack pointer (only multiple of JSJ_WORD_SIZE)
 void jsjcAddSP(int amt);
-// Subtract a value from the stack pointer (only multiple of 4)
+// Subtract a value from the stack pointer (only multiple of JSJ_WORD_SIZE)
 void jsjcSubSP(int amt);
 // reg = mem[regAddr + offset]
 void jsjcLoadImm(int reg, int regAddr, int offset);
@@ -186,6 +293,14 @@ void jsjcStoreImm(int reg, int regAddr, int offset);
 void jsjcPushAll();
 void jsjcPopAllAndReturn();
 
+// Used by jsjitc.c - implemented for each architecture
+// Emit the instruction for jsjcPush
+void jsjcEmitPush(int reg);
+// Emit the instruction for jsjcPop
+void jsjcEmitPop(int reg);
+// Write a long branch (as used by jsjcBranchFixup) to buf, and return its length
+int jsjcEncodeBranchLong(JsjAsmCondition cond, int bytes, char *buf);
+
 /// Get the number of a register that we're free to use (or error is none free) and mark as in use
 int jsjcClaimFreeReg();
 /// Mark a register returned by jsjcClaimFreeReg as unused
@@ -0,0 +1,512 @@
+/*
+ * This file is part of Espruino, a JavaScript interpreter for Microcontrollers
+ *
+ * Copyright (C) 2013 Gordon Williams <gw@pur3.co.uk>
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * ----------------------------------------------------------------------------
+ * Recursive descent JIT - x86-64 code emitter
+ * ----------------------------------------------------------------------------
+
+ This provides the same jsjc* functions as the ARM Thumb-2 emitter in jsjitc.c,
+ so that Linux builds can run JIT code (and we can test the JIT without hardware).
+
+ The JIT is written with ARM registers in mind, so they're mapped as follows (System V ABI):
+
+ r0..r3 => rdi, rsi, rdx, rcx  : arguments, clobbered by calls
+ r4..r7 => rbx, r12, r13, r14  : callee saved (jsjcPushAll)
+ SP     => rsp
+
+ rax and r11 are used as scratch registers (as is r8, for the 5th argument of a call)
+
+ Maths on ints is done with 32 bit instructions so flags (eg. overflow) work as on ARM.
+ Each item on the stack is 8 bytes (JSJ_WORD_SIZE).
+
+ https://www.felixcloutier.com/x86/
+ https://gitlab.com/x86-psABIs/x86-64-ABI
+
+ See README_JIT.md
+*/
+#include "jsjit.h"
+#if defined(ESPR_JIT) && defined(JSJ_X64)
+
+#include "jsjitc.h"
+
+#define X64_RAX 0
+#define X64_RCX 1
+#define X64_RDX 2
+#define X64_RBX 3
+#define X64_RSP 4
+#define X64_RBP 5
+#define X64_RSI 6
+#define X64_RDI 7
+#define X64_R8  8
+#define X64_R11 11
+#define X64_R12 12
+#define X64_R13 13
+#define X64_R14 14
+
+/// x86-64 register for each 'ARM' register we're given
+static const uint8_t jsjcX64Regs[16] = {
+  X64_RDI, X64_RSI, X64_RDX, X64_RCX, X64_RBX, X64_R12, X64_R13, X64_R14,
+  0,0,0,0,0, X64_RSP, 0, 0
+};
+static const char *jsjcX64RegNames[16] = {
+  "rax","rcx","rdx","rbx","rsp","rbp","rsi","rdi",
+  "r8","r9","r10","r11","r12","r13","r14","r15"
+};
+/// x86-64 condition codes for each JsjAsmCondition (the ARM ones)
+static const uint8_t jsjcX64Conds[14] = {
+  0x4/*E*/, 0x5/*NE*/, 0x3/*AE*/, 0x2/*B*/, 0x8/*S*/, 0x9/*NS*/, 0x0/*O*/,
+  0x1/*NO*/, 0x7/*A*/, 0x6/*BE*/, 0xD/*GE*/, 0xC/*L*/, 0xF/*G*/, 0xE/*LE*/
+};
+
+static int jsjcX64Reg(int reg) {
+  assert((reg>=0 && reg<8) || reg==JSJAR_SP);
+  return jsjcX64Regs[reg];
+}
+#define REGNAME(reg) jsjcX64RegNames[jsjcX64Reg(reg)]
+
+static int jsjcX64Cond(JsjAsmCondition cond) {
+  assert(cond<14);
+  return jsjcX64Conds[cond];
+}
+
+static void jsjcEmit8(uint8_t v) {
+  if (jit->lastCodeLen) {
+    // lastCode is only ever 'push rdi' - see jsjcEmitPush
+    if (v==0x5F) { // pop rdi
+      jit->lastCodeLen = 0;
+      DEBUG_JIT("PEEPHOLE: PUSH rdi + POP rdi => nop\n");
+      return;
+    }
+    jsvStringIteratorAppend(&jit->codeIt, (char)jit->lastCode);
+    jit->lastCodeLen = 0;
+  }
+  jsvStringIteratorAppend(&jit->codeIt, (char)v);
+}
+
+static void jsjcEmit32(uint32_t v) {
+  for (int i=0;i<4;i++)
+    jsjcEmit8((uint8_t)(v>>(i*8)));
+}
+
+/// Emit a REX prefix if one is needed. w=64 bit operation, r=ModRM.reg register, b=ModRM.rm register
+static void jsjcEmitRex(bool w, int r, int b) {
+  int rex = (w?8:0) | ((r&8)?4:0) | ((b&8)?1:0);
+  if (rex) jsjcEmit8((uint8_t)(0x40|rex));
+}
+
+/// Emit an opcode (which can be 2 bytes, eg 0x0FAF) with register-direct operands
+static void jsjcEmitRR(bool w, int opcode, int r, int rm) {
+  jsjcEmitRex(w, r, rm);
+  if (opcode>0xFF) jsjcEmit8((uint8_t)(opcode>>8));
+  jsjcEmit8((uint8_t)opcode);
+  jsjcEmit8((uint8_t)(0xC0 | ((r&7)<<3) | (rm&7)));
+}
+
+/// Emit an opcode with operands 'r' and memory at [base+disp]
+static void jsjcEmitRM(bool w, int opcode, int r, int base, int disp) {
+  jsjcEmitRex(w, r, base);
+  jsjcEmit8((uint8_t)opcode);
+  bool disp8 = disp>=-128 && disp<128;
+  jsjcEmit8((uint8_t)((disp8?0x40:0x80) | ((r&7)<<3) | (base&7))); // always use a displacement, so rbp/r13 work
+  if ((base&7)==X64_RSP) jsjcEmit8(0x24); // rsp/r12 need a SIB byte
+  if (disp8) jsjcEmit8((uint8_t)disp);
+  else jsjcEmit32((uint32_t)disp);
+}
+
+/// 32 bit mov (clears the top 32 bits)
+static void jsjcMov32(int x64To, int x64From) {
+  if (x64To!=x64From) jsjcEmitRR(false, 0x89, x64From, x64To);
+}
+
+void jsjcLiteral8(int reg, uint8_t data) {
+  jsjcLiteral32(reg, data);
+}
+
+void jsjcLiteral16(int reg, bool hi16, uint16_t data) {
+  int r = jsjcX64Reg(reg);
+  if (hi16) { // like ARM MOVT - keep the bottom 16 bits
+    DEBUG_JIT("MOVZX %s,%s16 ; OR %s,#0x%04x0000\n", REGNAME(reg), REGNAME(reg), REGNAME(reg), data);
+    jsjcEmitRR(false, 0x0FB7, r, r);
+    jsjcEmitRR(false, 0x81, 1, r);
+    jsjcEmit32(((uint32_t)data)<<16);
+  } else
+    jsjcLiteral32(reg, data);
+}
+
+void jsjcLiteral32(int reg, uint32_t data) {
+  DEBUG_JIT("MOV %s,#0x%08x\n", REGNAME(reg), data);
+  int r = jsjcX64Reg(reg);
+  jsjcEmitRex(false, 0, r);
+  jsjcEmit8((uint8_t)(0xB8 | (r&7)));
+  jsjcEmit32(data);
+}
+
+void jsjcLiteral64(int reg, uint64_t data) {
+  DEBUG_JIT("MOV %s,#0x%08x%08x ; MOVQ xmm0,%s\n", REGNAME(reg), (uint32_t)(data>>32), (uint32_t)data, REGNAME(reg));
+  int r = jsjcX64Reg(reg);
+  jsjcEmitRex(true, 0, r);
+  jsjcEmit8((uint8_t)(0xB8 | (r&7)));
+  jsjcEmit32((uint32_t)data);
+  jsjcEmit32((uint32_t)(data>>32));
+  // Doubles are passed in xmm0 (eg. for jsvNewFromFloat)
+  jsjcEmit8(0x66);
+  jsjcEmitRR(true, 0x0F6E, 0, r);
+}
+
+void jsjcLiteralPtr(int reg, void *data) {
+  if ((size_t)data <= 0xFFFFFFFF) {
+    jsjcLiteral32(reg, (uint32_t)(size_t)data);
+    return;
+  }
+  DEBUG_JIT("MOV %s,#0x%x\n", REGNAME(reg), (uint32_t)(size_t)data);
+  int r = jsjcX64Reg(reg);
+  jsjcEmitRex(true, 0, r);
+  jsjcEmit8((uint8_t)(0xB8 | (r&7)));
+  jsjcEmit32((uint32_t)(size_t)data);
+  jsjcEmit32((uint32_t)((size_t)data>>32));
+}
+
+int jsjcLiteralString(int reg, JsVar *str, bool nullTerminate) {
+  /* We store the String data here in-line, so store its address (RIP-relative) then jump forward over the data. */
+  int len = (int)jsvGetStringLength(str);
+  int realLen = len + (nullTerminate?1:0);
+  int branchLen = jsjcGetBranchRelativeLength(realLen);
+  DEBUG_JIT("LEA %s,[RIP+%d]\n", REGNAME(reg), branchLen);
+  int r = jsjcX64Reg(reg);
+  jsjcEmitRex(true, r, 0);
+  jsjcEmit8(0x8D);
+  jsjcEmit8((uint8_t)(((r&7)<<3) | 5)); // RIP-relative
+  jsjcEmit32((uint32_t)branchLen);
+  // jump over the data
+  jsjcBranchRelative(realLen, JSJC_NONE);
+  // write the data
+  DEBUG_JIT("... %d bytes data (%q) ...\n", (uint32_t)(realLen), str);
+  JsvStringIterator it;
+  jsvStringIteratorNew(&it, str, 0);
+  for (int i=0;i<realLen;i++)
+    jsjcEmit8((uint8_t)jsvStringIteratorGetCharAndNext(&it));
+  jsvStringIteratorFree(&it);
+  return len;
+}
+
+// Compare a register with a literal. jsjcBranchConditionalRelative can then be called
+void jsjcCompareImm(int reg, int literal) {
+  DEBUG_JIT("CMP %s,#%d\n", REGNAME(reg), literal);
+  assert(literal>=0 && literal<256);
+  int r = jsjcX64Reg(reg);
+  if (literal<128) {
+    jsjcEmitRR(false, 0x83, 7, r);
+    jsjcEmit8((uint8_t)literal);
+  } else {
+    jsjcEmitRR(false, 0x81, 7, r);
+    jsjcEmit32((uint32_t)literal);
+  }
+}
+
+// Write a long branch (as used by jsjcBranchFixup) to buf, and return its length
+int jsjcEncodeBranchLong(JsjAsmCondition cond, int bytes, char *buf) {
+  int n = 0;
+  if (cond==JSJAC_AL) {
+    buf[n++] = (char)0xE9; // JMP rel32
+  } else {
+    buf[n++] = 0x0F; // Jcc rel32
+    buf[n++] = (char)(0x80 | jsjcX64Cond(cond));
+  }
+  for (int i=0;i<4;i++)
+    buf[n++] = (char)(bytes>>(i*8));
+  return n;
+}
+
+static void jsjcEmitBranchLong(JsjAsmCondition cond, int bytes) {
+  char op[8];
+  int len = jsjcEncodeBranchLong(cond, bytes, op);
+  for (int i=0;i<len;i++) jsjcEmit8((uint8_t)op[i]);
+}
+
+// Get length of jsjcBranchRelative in bytes
+int jsjcGetBranchRelativeLength(int bytes) {
+  if (bytes<-128 || bytes>127)
+    return JSJ_BRANCH_LONG_LENGTH;
+  return 2;
+}
+
+// Jump a number of bytes forward or back, return number of bytes used for op
+int jsjcBranchRelative(int bytes, JsjsEmitOptions options) {
+  // offsets are relative to the end of the instruction, just like our 'bytes'
+  if (jsjcGetBranchRelativeLength(bytes)==2 && !(options&JSJC_FORCE_LONG)) {
+    DEBUG_JIT("JMP %s%d (addr 0x%04x)\n", (bytes>=0)?"+":"", (uint32_t)(bytes), jsjcGetByteCount()+2+bytes);
+    jsjcEmit8(0xEB);
+    jsjcEmit8((uint8_t)bytes);
+    return 2;
+  } else {
+    DEBUG_JIT("JMP.32 %s%d (addr 0x%04x)\n", (bytes>=0)?"+":"", (uint32_t)(bytes), jsjcGetByteCount()+JSJ_BRANCH_LONG_LENGTH+bytes);
+    jsjcEmitBranchLong(JSJAC_AL, bytes);
+    return JSJ_BRANCH_LONG_LENGTH;
+  }
+}
+
+// Get length of jsjcBranchConditionalRelative in bytes
+int jsjcGetBranchConditionalRelativeLength(int bytes) {
+  if (bytes<-128 || bytes>127)
+    return JSJ_BRANCH_COND_LONG_LENGTH;
+  return 2;
+}
+
+// Jump a number of bytes forward or back, based on condition flags, return number of bytes used for op
+int jsjcBranchConditionalRelative(JsjAsmCondition cond, int bytes, JsjsEmitOptions options) {
+  if (jsjcGetBranchConditionalRelativeLength(bytes)==2 && !(options&JSJC_FORCE_LONG)) {
+    DEBUG_JIT("J<%s> %s%d (addr 0x%04x)\n", &JSJAC_STRINGS[cond*3], (bytes>=0)?"+":"", (uint32_t)(bytes), jsjcGetByteCount()+2+bytes);
+    jsjcEmit8((uint8_t)(0x70 | jsjcX64Cond(cond)));
+    jsjcEmit8((uint8_t)bytes);
+    return 2;
+  } else {
+    DEBUG_JIT("J<%s>.32 %s%d (addr 0x%04x)\n", &JSJAC_STRINGS[cond*3], (bytes>=0)?"+":"", (uint32_t)(bytes), jsjcGetByteCount()+JSJ_BRANCH_COND_LONG_LENGTH+bytes);
+    jsjcEmitBranchLong(cond, bytes);
+    return JSJ_BRANCH_COND_LONG_LENGTH;
+  }
+}
+
+#ifdef DEBUG_JIT_CALLS
+void _jsjcCall(void *c, const char *name) {
+#else
+void jsjcCall(void *c) {
+#endif
+  DEBUG_JIT("MOV rax,#0x%x\n", (uint32_t)(size_t)c);
+  jsjcEmitRex(true, 0, X64_RAX);
+  jsjcEmit8(0xB8);
+  jsjcEmit32((uint32_t)(size_t)c);
+  jsjcEmit32((uint32_t)((size_t)c>>32));
+  /* On ARM, a 5th argument is the top item on the stack - on x86-64 it has to be in r8. Then
+  the stack needs to be 16 byte aligned for the call, so keep the old value in rbp */
+  DEBUG_JIT("MOV r8,[rsp] ; PUSH rbp ; MOV rbp,rsp ; AND rsp,#-16\n");
+  jsjcEmitRM(true, 0x8B, X64_R8, X64_RSP, 0);
+  jsjcEmit8(0x50 | X64_RBP);
+  jsjcEmitRR(true, 0x89, X64_RSP, X64_RBP);
+  jsjcEmitRR(true, 0x83, 4, X64_RSP);
+  jsjcEmit8(0xF0);
+#ifdef DEBUG_JIT_CALLS
+  DEBUG_JIT("CALL rax (%s)\n", name);
+#else
+  DEBUG_JIT("CALL rax\n");
+#endif
+  jsjcEmitRR(false, 0xFF, 2, X64_RAX);
+  // restore the stack, and put the return value (rax, or rax:rdx for 64 bit values) where the JIT expects it (r0, r1)
+  DEBUG_JIT("MOV rsp,rbp ; POP rbp ; MOV rdi,rax ; MOV rsi,rdx\n");
+  jsjcEmitRR(true, 0x89, X64_RBP, X64_RSP);
+  jsjcEmit8(0x58 | X64_RBP);
+  jsjcEmitRR(true, 0x89, X64_RAX, X64_RDI);
+  jsjcEmitRR(true, 0x89, X64_RDX, X64_RSI);
+}
+
+void jsjcMov(int regTo, int regFrom) {
+  DEBUG_JIT("MOV %s <- %s\n", REGNAME(regTo), REGNAME(regFrom));
+  int to = jsjcX64Reg(regTo), from = jsjcX64Reg(regFrom);
+  if (to!=from) jsjcEmitRR(true, 0x89, from, to);
+}
+
+void jsjcAdd(int regTo, int regFrom, int lit) {
+  DEBUG_JIT("LEA %s <- %s + #%d\n", REGNAME(regTo), REGNAME(regFrom), lit);
+  assert(lit>=0 && lit<8);
+  jsjcEmitRM(true, 0x8D, jsjcX64Reg(regTo), jsjcX64Reg(regFrom), lit);
+}
+
+// Move negated register
+void jsjcMVN(int regTo, int regFrom) {
+  DEBUG_JIT("MOV %s <- %s ; NOT %s\n", REGNAME(regTo), REGNAME(regFrom), REGNAME(regTo));
+  int to = jsjcX64Reg(regTo);
+  jsjcMov32(to, jsjcX64Reg(regFrom));
+  jsjcEmitRR(false, 0xF7, 2, to);
+}
+
+// regTo = regTo & regFrom
+void jsjcAND(int regTo, int regFrom) {
+  DEBUG_JIT("AND %s <- %s\n", REGNAME(regTo), REGNAME(regFrom));
+  jsjcEmitRR(false, 0x21, jsjcX64Reg(regFrom), jsjcX64Reg(regTo));
+}
+
+// regTo = regTo | regFrom
+void jsjcORR(int regTo, int regFrom) {
+  DEBUG_JIT("OR %s <- %s\n", REGNAME(regTo), REGNAME(regFrom));
+  jsjcEmitRR(false, 0x09, jsjcX64Reg(regFrom), jsjcX64Reg(regTo));
+}
+
+// regTo = regTo ^ regFrom
+void jsjcEOR(int regTo, int regFrom) {
+  DEBUG_JIT("XOR %s <- %s\n", REGNAME(regTo), REGNAME(regFrom));
+  jsjcEmitRR(false, 0x31, jsjcX64Reg(regFrom), jsjcX64Reg(regTo));
+}
+
+// regTo = regA + regB (setting flags)
+void jsjcAddReg(int regTo, int regA, int regB) {
+  DEBUG_JIT("ADD %s <- %s + %s\n", REGNAME(regTo), REGNAME(regA), REGNAME(regB));
+  int to = jsjcX64Reg(regTo), a = jsjcX64Reg(regA), b = jsjcX64Reg(regB);
+  if (to==b) { // addition is commutative
+    b = a;
+  } else
+    jsjcMov32(to, a);
+  jsjcEmitRR(false, 0x01, b, to);
+}
+
+// regTo = regA - regB (setting flags)
+void jsjcSubReg(int regTo, int regA, int regB) {
+  DEBUG_JIT("SUB %s <- %s - %s\n", REGNAME(regTo), REGNAME(regA), REGNAME(regB));
+  int to = jsjcX64Reg(regTo), a = jsjcX64Reg(regA), b = jsjcX64Reg(regB);
+  if (to==b && to!=a) { // we'd overwrite b - so use rax
+    jsjcMov32(X64_RAX, a);
+    jsjcEmitRR(false, 0x29, b, X64_RAX);
+    jsjcMov32(to, X64_RAX); // mov doesn't affect flags
+  } else {
+    jsjcMov32(to, a);
+    jsjcEmitRR(false, 0x29, b, to);
+  }
+}
+
+// regTo = regFrom - lit (setting flags)
+void jsjcSub(int regTo, int regFrom, int lit) {
+  DEBUG_JIT("SUB %s <- %s - #%d\n", REGNAME(regTo), REGNAME(regFrom), lit);
+  assert(lit>=0 && lit<8);
+  int to = jsjcX64Reg(regTo);
+  jsjcMov32(to, jsjcX64Reg(regFrom));
+  jsjcEmitRR(false, 0x83, 5, to);
+  jsjcEmit8((uint8_t)lit);
+}
+
+// regTo = regFrom << lit (setting flags)
+void jsjcLSL(int regTo, int regFrom, int lit) {
+  DEBUG_JIT("SHL %s <- %s << #%d\n", REGNAME(regTo), REGNAME(regFrom), lit);
+  assert(lit>0 && lit<32); // a shift of 0 doesn't set flags
+  int to = jsjcX64Reg(regTo);
+  jsjcMov32(to, jsjcX64Reg(regFrom));
+  jsjcEmitRR(false, 0xC1, 4, to);
+  jsjcEmit8((uint8_t)lit);
+}
+
+// regTo = regFrom >> lit, arithmetic (setting flags)
+void jsjcASR(int regTo, int regFrom, int lit) {
+  DEBUG_JIT("SAR %s <- %s >> #%d\n", REGNAME(regTo), REGNAME(regFrom), lit);
+  assert(lit>0 && lit<32);
+  int to = jsjcX64Reg(regTo);
+  jsjcMov32(to, jsjcX64Reg(regFrom));
+  jsjcEmitRR(false, 0xC1, 7, to);
+  jsjcEmit8((uint8_t)lit);
+}
+
+// Signed multiply regA*regB into 64 bits - regHi:regLo
+void jsjcSMULL(int regLo, int regHi, int regA, int regB) {
+  DEBUG_JIT("SMULL %s,%s <- %s * %s\n", REGNAME(regLo), REGNAME(regHi), REGNAME(regA), REGNAME(regB));
+  assert(regLo!=regHi);
+  jsjcEmitRR(true, 0x63, X64_RAX, jsjcX64Reg(regA)); // MOVSXD rax, a
+  jsjcEmitRR(true, 0x63, X64_R11, jsjcX64Reg(regB)); // MOVSXD r11, b
+  jsjcEmitRR(true, 0x0FAF, X64_RAX, X64_R11); // IMUL rax, r11
+  jsjcMov32(jsjcX64Reg(regLo), X64_RAX);
+  jsjcEmitRR(true, 0xC1, 5, X64_RAX); // SHR rax, 32
+  jsjcEmit8(32);
+  jsjcMov32(jsjcX64Reg(regHi), X64_RAX);
+}
+
+// Compare two registers. jsjcBranchConditionalRelative can then be called
+void jsjcCompare(int regA, int regB) {
+  DEBUG_JIT("CMP %s,%s\n", REGNAME(regA), REGNAME(regB));
+  jsjcEmitRR(false, 0x39, jsjcX64Reg(regB), jsjcX64Reg(regA));
+}
+
+// Compare regA with (regB >> lit) (arithmetic shift). jsjcBranchConditionalRelative can then be called
+void jsjcCompareASR(int regA, int regB, int lit) {
+  DEBUG_JIT("CMP %s,%s ASR #%d\n", REGNAME(regA), REGNAME(regB), lit);
+  assert(lit>0 && lit<32);
+  jsjcMov32(X64_RAX, jsjcX64Reg(regB));
+  jsjcEmitRR(false, 0xC1, 7, X64_RAX);
+  jsjcEmit8((uint8_t)lit);
+  jsjcEmitRR(false, 0x39, X64_RAX, jsjcX64Reg(regA));
+}
+
+// Set reg to 1 if cond is true (eg. after jsjcCompare), or 0 if not
+void jsjcSetCond(int reg, JsjAsmCondition cond) {
+  DEBUG_JIT("SET<%s> al ; MOVZX %s,al\n", &JSJAC_STRINGS[cond*3], REGNAME(reg));
+  jsjcEmitRR(false, 0x0F90 | jsjcX64Cond(cond), 0, X64_RAX);
+  jsjcEmitRR(false, 0x0FB6, jsjcX64Reg(reg), X64_RAX);
+}
+
+// Emit the instruction for jsjcPush
+void jsjcEmitPush(int reg) {
+  int r = jsjcX64Reg(reg);
+  if (r==X64_RDI) { // keep 'push rdi' back for jsjcEmit8's peephole optimisation
+    if (jit->lastCodeLen) jsvStringIteratorAppend(&jit->codeIt, (char)jit->lastCode);
+    jit->lastCode = 0x50 | X64_RDI;
+    jit->lastCodeLen = 1;
+    return;
+  }
+  jsjcEmitRex(false, 0, r);
+  jsjcEmit8((uint8_t)(0x50 | (r&7)));
+}
+
+// Emit the instruction for jsjcPop
+void jsjcEmitPop(int reg) {
+  int r = jsjcX64Reg(reg);
+  jsjcEmitRex(false, 0, r);
+  jsjcEmit8((uint8_t)(0x58 | (r&7)));
+}
+
+void jsjcAddSP(int amt) {
+  assert((amt%JSJ_WORD_SIZE)==0 && amt>0 && amt<1024);
+  jit->stackDepth -= amt/JSJ_WORD_SIZE; // stack grows down -> negate
+  DEBUG_JIT("ADD rsp,#%d   (stack depth now %d)\n", amt, jit->stackDepth);
+  if (amt<128) {
+    jsjcEmitRR(true, 0x83, 0, X64_RSP);
+    jsjcEmit8((uint8_t)amt);
+  } else {
+    jsjcEmitRR(true, 0x81, 0, X64_RSP);
+    jsjcEmit32((uint32_t)amt);
+  }
+}
+
+void jsjcSubSP(int amt) {
+  assert((amt%JSJ_WORD_SIZE)==0 && amt>0 && amt<1024);
+  jit->stackDepth += amt/JSJ_WORD_SIZE;
+  DEBUG_JIT("SUB rsp,#%d   (stack depth now %d)\n", amt, jit->stackDepth);
+  if (amt<128) {
+    jsjcEmitRR(true, 0x83, 5, X64_RSP);
+    jsjcEmit8((uint8_t)amt);
+  } else {
+    jsjcEmitRR(true, 0x81, 5, X64_RSP);
+    jsjcEmit32((uint32_t)amt);
+  }
+}
+
+void jsjcLoadImm(int reg, int regAddr, int offset) {
+  DEBUG_JIT("MOV %s,[%s+#%d]\n", REGNAME(reg), REGNAME(regAddr), offset);
+  assert(offset>=0);
+  jsjcEmitRM(true, 0x8B, jsjcX64Reg(reg), jsjcX64Reg(regAddr), offset);
+}
+
+void jsjcStoreImm(int reg, int regAddr, int offset) {
+  DEBUG_JIT("MOV [%s+#%d],%s\n", REGNAME(regAddr), offset, REGNAME(reg));
+  assert(offset>=0);
+  jsjcEmitRM(true, 0x89, jsjcX64Reg(reg), jsjcX64Reg(regAddr), offset);
+}
+
+void jsjcPushAll() {
+  DEBUG_JIT("PUSH {rbx,r12,r13,r14}\n");
+  jsjcEmit8(0x50 | X64_RBX);
+  jsjcEmit8(0x41); jsjcEmit8(0x50 | (X64_R12&7));
+  jsjcEmit8(0x41); jsjcEmit8(0x50 | (X64_R13&7));
+  jsjcEmit8(0x41); jsjcEmit8(0x50 | (X64_R14&7));
+}
+
+void jsjcPopAllAndReturn() {
+  DEBUG_JIT("MOV rax <- rdi ; POP {rbx,r12,r13,r14} ; RET\n");
+  jsjcEmitRR(true, 0x89, X64_RDI, X64_RAX); // the C caller expects the result in rax, not r0
+  jsjcEmit8(0x41); jsjcEmit8(0x58 | (X64_R14&7));
+  jsjcEmit8(0x41); jsjcEmit8(0x58 | (X64_R13&7));
+  jsjcEmit8(0x41); jsjcEmit8(0x58 | (X64_R12&7));
+  jsjcEmit8(0x58 | X64_RBX);
+  jsjcEmit8(0xC3);
+}
+
+#endif /* ESPR_JIT && JSJ_X64 */
@@ -1335,14 +1335,14 @@ static size_t _jslNewTokenisedStringFromLexer(JsvStringIterator *dstit, JsVar *d
   return length;
 }
 
-JsVar *jslNewTokenisedStringFromLexer(JslCharPos *charFrom, size_t charTo) {
+static JsVar *jslNewTokenisedStringFromVar(JsVar *sourceVar, JslCharPos *charFrom, size_t charTo) {
   // New method - tokenise functions
   // save old lex
   JsLex *oldLex = lex;
   JsLex newLex;
   lex = &newLex;
   // work out length
-  jslInit(oldLex->sourceVar);
+  jslInit(sourceVar);
   size_t length = _jslNewTokenisedStringFromLexer(NULL, NULL, charFrom, charTo);
   // Try and create a flat string first
   JsVar *var = jsvNewStringOfLength((unsigned int)length, NULL);
@@ -1359,6 +1359,18 @@ JsVar *jslNewTokenisedStringFromLexer(JslCharPos *charFrom, size_t charTo) {
   return var;
 }
 
+JsVar *jslNewTokenisedStringFromLexer(JslCharPos *charFrom, size_t charTo) {
+  return jslNewTokenisedStringFromVar(lex->sourceVar, charFrom, charTo);
+}
+
+JsVar *jslNewTokenisedStringFromString(JsVar *str) {
+  JslCharPos charFrom;
+  jslCharPosNew(&charFrom, str, 0);
+  JsVar *var = jslNewTokenisedStringFromVar(str, &charFrom, jsvGetStringLength(str));
+  jslCharPosFree(&charFrom);
+  return var;
+}
+
 #endif // ESPR_NO_PRETOKENISE
 
 JsVar *jslNewStringFromLexer(JslCharPos *charFrom, size_t charTo) {
@@ -211,6 +211,8 @@ JsVar *jslNewStringFromLexer(JslCharPos *charFrom, size_t charTo);
 #ifndef ESPR_NO_PRETOKENISE
 /// Create a new STRING from part of the lexer - keywords get tokenised
 JsVar *jslNewTokenisedStringFromLexer(JslCharPos *charFrom, size_t charTo);
+/// Create a new tokenised STRING from the whole of a string containing (untokenised) code
+JsVar *jslNewTokenisedStringFromString(JsVar *str);
 #endif
 
 /// Do we need a space between these two characters when printing a function's text?
@@ -27,6 +27,9 @@
 #ifdef ESPR_JIT
 #include "jsjit.h"
 #endif
+#ifndef ESPR_NO_ASYNC
+#include "jswrap_promise.h" // for jspromise_async
+#endif
 
 /* Info about execution when Parsing - this saves passing it on the stack
  * for each call */
@@ -43,6 +46,33 @@ JsVar *jspeFactor();
 #ifndef ESPR_NO_ARROW_FN
 JsVar *jspeArrowFunction(JsVar *funcVar, JsVar *a);
 #endif
+#ifndef ESPR_NO_ASYNC
+static JsVar *jspeCoroutineNew(JsVar *function, JspFunctionKind kind, JsVar *functionRoot, JsVar *thisVar);
+
+/// State of the async function/generator that jspCoroutineResume is running (see jspeCoroutineStatement)
+typedef struct {
+  JsVar *coroutine;
+  JsLex *lex;       ///< Lexer over the coroutine's code - statements in anything it calls aren't ours
+  const char *word; ///< "await" or "yield"
+  JsVar *value;     ///< When resuming, the value the await/yield we stopped at evaluates to (not locked by us)
+  bool isException; ///< When resuming, throw 'value' instead
+  JsVar *resume;    ///< When resuming, what's left of the path back to where we stopped
+  JsVar *path;      ///< When suspending, how to get back here: statement positions, block scopes and branches taken (innermost first)
+  JsVar *result;    ///< When suspending, the value that was awaited/yielded
+} JspCoroutine;
+static JspCoroutine *jspCoroutine;
+
+/// Are we following the path back into a coroutine's statements? (see jspeCoroutineStatement)
+static bool jspeCoroutineResuming() {
+  return jspCoroutine && jspCoroutine->resume && jspCoroutine->lex==lex && JSP_SHOULD_EXECUTE;
+}
+static JsVar *jspeCoroutineStatement();
+static JsVar *jspeCoroutineResumeNext();
+static void jspeCoroutineResumeSeek();
+static void jspeCoroutineSuspendPush(JsVar *item);
+static void jspeCoroutineSuspendPushBool(bool b);
+static void jspeCoroutineCantSuspend(const char *where);
+#endif
 // ----------------------------------------------- Utils
 #define JSP_MATCH_WITH_CLEANUP_AND_RETURN(TOKEN, CLEANUP_CODE, RETURN_VAL) { if (!jslMatch((TOKEN))) { CLEANUP_CODE; return RETURN_VAL; } }
 #define JSP_MATCH_WITH_RETURN(TOKEN, RETURN_VAL) JSP_MATCH_WITH_CLEANUP_AND_RETURN(TOKEN, , RETURN_VAL)
@@ -300,6 +330,13 @@ NO_INLINE bool jspeFunctionArguments(JsVar *funcVar) {
   return true;
 }
 
+#ifndef ESPR_NO_ASYNC
+/// Is the current token the identifier 'word'? (`async`, `await` and `yield` aren't reserved words)
+static bool jspeIsWord(const char *word) {
+  return lex->tk==LEX_ID && strcmp(jslGetTokenValueAsString(), word)==0;
+}
+#endif
+
 // Parse function, assuming we're on '{'. funcVar can be 0. returns 'true' is the function included the 'this' keyword
 NO_INLINE bool jspeFunctionDefinitionInternal(JsVar *funcVar, bool expressionOnly) {
   JslCharPos funcBegin;
@@ -391,6 +428,9 @@ NO_INLINE bool jspeFunctionDefinitionInternal(JsVar *funcVar, bool expressionOnl
   } else {
     JsExecFlags oldExec = execInfo.execute;
     execInfo.execute = EXEC_NO;
+#ifndef ESPR_NO_ASYNC
+    if (jspeIsWord("await")) JSP_ASSERT_MATCH(LEX_ID); // `async x => await foo(x)`
+#endif
     jsvUnLock(jspeAssignmentExpression());
     execInfo.execute = oldExec;
     lastTokenEnd = (int)lex->tokenStart;
@@ -414,9 +454,10 @@ NO_INLINE bool jspeFunctionDefinitionInternal(JsVar *funcVar, bool expressionOnl
 #endif
     } else {
 #ifndef ESPR_NO_PRETOKENISE
-      if (jsfGetFlag(JSF_PRETOKENISE) || forcePretokenise)
+      if (jsfGetFlag(JSF_PRETOKENISE) || forcePretokenise) {
         funcCodeVar = jslNewTokenisedStringFromLexer(&funcBegin, (size_t)lastTokenEnd);
-      else
+        if (funcCodeVar) funcCodeVar->flags |= JSV_CONSTANT; // so JSF_LAZY_PRETOKENISE knows not to tokenise again
+      } else
 #endif
         funcCodeVar = jslNewStringFromLexer(&funcBegin, (size_t)lastTokenEnd);
     }
@@ -433,8 +474,31 @@ NO_INLINE bool jspeFunctionDefinitionInternal(JsVar *funcVar, bool expressionOnl
   return hadThisKeyword;
 }
 
+#ifndef ESPR_NO_PRETOKENISE
+/* Called with JSF_LAZY_PRETOKENISE when a function whose code is still plain text
+ * in RAM is about to be executed. We replace the function's code with a pretokenised
+ * version (marked JSV_CONSTANT so we don't do it again) and return that. If we
+ * can't (eg. out of memory) the original code is returned. */
+static NO_INLINE JsVar *jspeFunctionPretokeniseCode(JsVar *function, JsVar *functionCode) {
+  JsVar *tokenisedCode = jslNewTokenisedStringFromString(functionCode);
+  if (!tokenisedCode) return functionCode;
+  tokenisedCode->flags |= JSV_CONSTANT;
+  jsvObjectSetChild(function, JSPARSE_FUNCTION_CODE_NAME, tokenisedCode);
+  jsvUnLock(functionCode);
+  return tokenisedCode;
+}
+#endif
+
+#ifndef ESPR_NO_ASYNC
+/// Mark a function as async or a generator - this must be done after adding its parameters but before its code
+static void jspeFunctionSetKind(JsVar *funcVar, JspFunctionKind kind) {
+  if (funcVar && kind!=JSP_FUNCTION_NORMAL)
+    jsvObjectSetChildAndUnLock(funcVar, JSPARSE_FUNCTION_KIND_NAME, jsvNewFromInteger(kind));
+}
+#endif
+
 // Parse function (after 'function' has occurred
-NO_INLINE JsVar *jspeFunctionDefinition(bool parseNamedFunction) {
+NO_INLINE JsVar *jspeFunctionDefinition(bool parseNamedFunction, JspFunctionKind kind) {
   // actually parse a function... We assume that the LEX_FUNCTION and name
   // have already been parsed
   JsVar *funcVar = 0;
@@ -457,6 +521,9 @@ NO_INLINE JsVar *jspeFunctionDefinition(bool parseNamedFunction) {
     // parse failed
     return 0;
   }
+#ifndef ESPR_NO_ASYNC
+  jspeFunctionSetKind(funcVar, kind);
+#endif
 
   // Parse the actual function block
   jspeFunctionDefinitionInternal(funcVar, false);
@@ -648,6 +715,9 @@ NO_INLINE JsVar *jspeFunctionCall(JsVar *function, JsVar *functionName, JsVar *t
 #ifdef ESPR_JIT
       bool functionIsJIT = false; // is functionCode actually Thumb Assembly (for JS)
 #endif
+#ifndef ESPR_NO_ASYNC
+      JspFunctionKind functionKind = JSP_FUNCTION_NORMAL;
+#endif
 
       /** NOTE: We expect that the function object will have:
        *
@@ -713,6 +783,9 @@ NO_INLINE JsVar *jspeFunctionCall(JsVar *function, JsVar *functionName, JsVar *t
           else if (jsvIsStringEqual(param, JSPARSE_FUNCTION_JIT_CODE_NAME)) { functionCode = jsvSkipName(param); functionIsJIT = true; }
 #endif
           else if (jsvIsStringEqual(param, JSPARSE_FUNCTION_NAME_NAME)) functionInternalName = jsvSkipName(param);
+#ifndef ESPR_NO_ASYNC
+          else if (jsvIsStringEqual(param, JSPARSE_FUNCTION_KIND_NAME)) functionKind = (JspFunctionKind)jsvGetIntegerAndUnLock(jsvSkipName(param));
+#endif
           else if (jsvIsStringEqual(param, JSPARSE_FUNCTION_THIS_NAME)) {
             jsvUnLock(thisVar);
             thisVar = jsvSkipName(param);
@@ -728,6 +801,16 @@ NO_INLINE JsVar *jspeFunctionCall(JsVar *function, JsVar *functionName, JsVar *t
       }
       jsvObjectIteratorFree(&it);
 
+#ifndef ESPR_NO_PRETOKENISE
+      if (jsfGetFlag(JSF_LAZY_PRETOKENISE) &&
+#ifdef ESPR_JIT
+          !functionIsJIT &&
+#endif
+          jsvIsString(functionCode) && !jsvIsConstant(functionCode) &&
+          !jsvIsNativeString(functionCode) && !jsvIsFlashString(functionCode))
+        functionCode = jspeFunctionPretokeniseCode(function, functionCode);
+#endif
+
       // setup a the function's name (if a named function)
       if (functionInternalName) {
         JsVar *name = jsvMakeIntoVariableName(jsvNewFromStringVarComplete(functionInternalName), function);
@@ -735,6 +818,13 @@ NO_INLINE JsVar *jspeFunctionCall(JsVar *function, JsVar *functionName, JsVar *t
         jsvUnLock2(name, functionInternalName);
       }
 
+#ifndef ESPR_NO_ASYNC
+      if (functionKind!=JSP_FUNCTION_NORMAL && !JSP_HAS_ERROR) {
+        // async functions and generators don't run now - we return an object that runs them
+        jsvUnLock(functionScope);
+        returnVar = jspeCoroutineNew(function, functionKind, functionRoot, thisVar);
+      } else
+#endif
       if (!JSP_HAS_ERROR) {
         // save old scopes and reset scope list
         JsVar *oldScopeVar = execInfo.scopesVar;
@@ -767,8 +857,11 @@ NO_INLINE JsVar *jspeFunctionCall(JsVar *function, JsVar *functionName, JsVar *t
            */
           if (functionIsJIT) {
             void *nativePtr = jsvGetFlatStringPointer(functionCode);
+#ifndef JSJ_X64
+            if (nativePtr) nativePtr++; // Thumb code, so set bit 0 of the address
+#endif
             if (nativePtr)
-              returnVar = jsnCallFunction(nativePtr+1/*thumb*/, JSWAT_JSVAR/*JS Variable as return type*/, thisVar, NULL, 0);
+              returnVar = jsnCallFunction(nativePtr, JSWAT_JSVAR/*JS Variable as return type*/, thisVar, NULL, 0);
           } else
 #endif
           /* we just want to execute the block, but something could
@@ -927,15 +1020,117 @@ JsVar *jspGetNamedVariable(const char *tokenName) {
   return a;
 }
 
-/// Used by jspGetNamedField / jspGetVarNamedField
-static NO_INLINE JsVar *jspGetNamedFieldInParents(JsVar *object, const char* name, bool returnName) {
-  // Now look in prototypes
-  JsVar * child = jspeiFindChildFromStringInParents(object, name);
+#ifndef ESPR_NO_MEMBER_CACHE
+/* When we look up a member of an Object and have to go to its prototypes or
+ * the built-in functions to find it (eg. `g.setPixel(...)`), we remember what
+ * we found here, indexed by the Object's `__proto__` and the member's name.
+ * Next time we can skip searching the prototype chain and the symbol tables.
+ * Entries are only valid while jsvObjectEpoch is unchanged. */
+typedef struct {
+  unsigned int epoch; ///< jsvObjectEpoch when this entry was filled in
+  JsVarRef proto; ///< The `__proto__` of the Object we were looking in
+  JsVarRef child; ///< The name we found in the prototype chain (or 0)
+  void (*builtinPtr)(void); ///< If child==0, the built-in function we found (or 0 if nothing found)
+  uint16_t builtinArgTypes;
+  char name[JSP_MEMBER_CACHE_NAME_LEN];
+} JspMemberCacheEntry;
+static JspMemberCacheEntry jspMemberCache[JSP_MEMBER_CACHE_SIZE];
+
+/// Get the cache entry that a member of an Object with the given `__proto__` would use (or 0 if it can't be cached)
+static JspMemberCacheEntry *jspMemberCacheGetEntry(JsVarRef proto, const char *name) {
+  unsigned int hash = proto;
+  const char *p = name;
+  while (*p) hash = hash*31 + (unsigned char)*(p++);
+  if (p-name >= JSP_MEMBER_CACHE_NAME_LEN) return 0;
+  return &jspMemberCache[hash & (JSP_MEMBER_CACHE_SIZE-1)];
+}
 
-  /* Check for builtins via separate function
-   * This way we save on RAM for built-ins because everything comes out of program code */
-  if (!child) {
+/// Like jspeiFindChildFromStringInParents+jswFindBuiltInFunction for an Object, but fill in the cache entry with what we found
+static JsVar *jspMemberCacheFill(JspMemberCacheEntry *entry, JsVarRef protoRef, JsVar *object, const char *name) {
+  unsigned int epoch = jsvObjectEpoch;
+  uint32_t watched = 0;
+  JsVar *child = 0;
+  JsVar *parent = jsvLockAgain(object);
+  int depth = 0;
+  while (!child) {
+    JsVar *inheritsFrom = jsvObjectGetChildIfExists(parent, JSPARSE_INHERITS_VAR);
+    // if there's no inheritsFrom, just default to 'Object.prototype'
+    if (!inheritsFrom)
+      inheritsFrom = jspFindPrototypeFor("Object");
+    if (!inheritsFrom || inheritsFrom==parent) {
+      jsvUnLock(inheritsFrom);
+      break;
+    }
+    jsvUnLock(parent);
+    parent = inheritsFrom;
+    if (!jsvIsObject(parent) || ++depth > 16) {
+      // Something unusual (eg. inheriting from an Array) - don't cache
+      jsvUnLock(parent);
+      child = jspeiFindChildFromStringInParents(object, name);
+      if (!child) child = jswFindBuiltInFunction(object, name);
+      return child;
+    }
+    watched |= 1U<<(jsvGetRef(parent)&31);
+    child = jsvFindChildFromString(parent, name);
+  }
+  jsvUnLock(parent);
+  entry->child = 0;
+  entry->builtinPtr = 0;
+  entry->builtinArgTypes = 0;
+  if (child) {
+    entry->child = jsvGetRef(child);
+  } else {
     child = jswFindBuiltInFunction(object, name);
+    if (child) {
+      /* Only cache built-in functions. Anything else is a value that was
+       * created from this object (eg. by a getter) */
+      if (!jsvIsNativeFunction(child) || jsvGetFirstChild(child) || jsvGetRefs(child)) {
+        entry->proto = 0;
+        return child;
+      }
+      entry->builtinPtr = child->varData.native.ptr;
+      entry->builtinArgTypes = child->varData.native.argTypes;
+    }
+  }
+  entry->epoch = epoch;
+  entry->proto = protoRef;
+  strcpy(entry->name, name);
+  jsvObjectEpochWatched |= watched;
+  return child;
+}
+#endif
+
+/// Used by jspGetNamedField / jspGetVarNamedField
+static NO_INLINE JsVar *jspGetNamedFieldInParents(JsVar *object, const char* name, bool returnName) {
+  JsVar *child = 0;
+#ifndef ESPR_NO_MEMBER_CACHE
+  JspMemberCacheEntry *entry = 0;
+  JsVarRef protoRef = 0;
+  if (jsvIsObject(object)) {
+    JsVar *protoName = jsvFindChildFromString(object, JSPARSE_INHERITS_VAR);
+    if (protoName && !jsvIsNameWithValue(protoName))
+      protoRef = jsvGetFirstChild(protoName);
+    jsvUnLock(protoName);
+    if (protoRef) entry = jspMemberCacheGetEntry(protoRef, name);
+  }
+  if (entry && entry->epoch==jsvObjectEpoch && entry->proto==protoRef && !strcmp(entry->name, name)) {
+    if (entry->child)
+      child = jsvLock(entry->child);
+    else if (entry->builtinPtr)
+      child = jsvNewNativeFunction(entry->builtinPtr, entry->builtinArgTypes);
+  } else if (entry) {
+    child = jspMemberCacheFill(entry, protoRef, object, name);
+  } else
+#endif
+  {
+    // Now look in prototypes
+    child = jspeiFindChildFromStringInParents(object, name);
+
+    /* Check for builtins via separate function
+     * This way we save on RAM for built-ins because everything comes out of program code */
+    if (!child) {
+      child = jswFindBuiltInFunction(object, name);
+    }
   }
 
   /* We didn't get here if we found a child in the object itself, so
@@ -1360,7 +1555,7 @@ NO_INLINE JsVar *jspeFactorObject() {
           jsvUnLock(varName);
           varName = jslGetTokenValueAsVar();
           JSP_ASSERT_MATCH(LEX_ID);
-          JsVar *method = jspeFunctionDefinition(false);
+          JsVar *method = jspeFunctionDefinition(false, JSP_FUNCTION_NORMAL);
           jsvAddGetterOrSetter(contents, varName, isGetter, method);
           jsvUnLock(method);
         }
@@ -1370,7 +1565,7 @@ NO_INLINE JsVar *jspeFactorObject() {
       if (lex->tk == '(') {
         JsVar *contentsName = jsvFindChildFromVar(contents, varName, true);
         if (contentsName) {
-          JsVar *method = jspeFunctionDefinition(false);
+          JsVar *method = jspeFunctionDefinition(false, JSP_FUNCTION_NORMAL);
           jsvUnLock2(jsvSetValueOfName(contentsName, method), method);
         }
       } else
@@ -1719,7 +1914,7 @@ NO_INLINE JsVar *jspeClassDefinition(bool parseNamedClass) {
     JsVar *obj = isStatic ? classStaticFields : classPrototype;
     if (obj) {
       if (isGetter || isSetter || isConstructor || lex->tk=='(') { // function
-        JsVar *method = jspeFunctionDefinition(false);
+        JsVar *method = jspeFunctionDefinition(false, JSP_FUNCTION_NORMAL);
         if (isConstructor) {
           jswrap_function_replaceWith(classFunction, method);
   #ifndef ESPR_NO_GET_SET
@@ -1752,10 +1947,109 @@ NO_INLINE JsVar *jspeClassDefinition(bool parseNamedClass) {
 
 #endif
 
+#ifndef ESPR_NO_ASYNC
+/// State for looking at the tokens after the current one without moving the lexer
+typedef struct {
+  JslCharPos pos;
+  JsLex lex;
+  JsLex *oldLex;
+  JsExecFlags oldExecute;
+} JspePeek;
+
+/// Start peeking - 'lex' is now a separate lexer, on the token after the current one
+static void jspePeekStart(JspePeek *peek) {
+  jslCharPosFromLex(&peek->pos);
+  peek->oldLex = jslSetLex(&peek->lex);
+  jslInit(peek->oldLex->sourceVar);
+  peek->oldExecute = execInfo.execute;
+  execInfo.execute = EXEC_NO; // we only care about the tokens, not their values
+  jslSeekToP(&peek->pos);
+}
+
+/// Stop peeking - 'lex' is back where it was when jspePeekStart was called
+static void jspePeekEnd(JspePeek *peek) {
+  execInfo.execute = peek->oldExecute;
+  jslKill();
+  jslSetLex(peek->oldLex);
+  jslCharPosFree(&peek->pos);
+}
+
+/* We're on `async` - is it the start of an async function (`async function`,
+ * `async x =>` or `async (...) =>`) or just something called 'async'? */
+static bool jspeIsAsyncFunction(bool declarationOnly) {
+  JspePeek peek;
+  jspePeekStart(&peek);
+  bool isAsync = lex->tk==LEX_R_FUNCTION;
+#ifndef ESPR_NO_ARROW_FN
+  if (!declarationOnly && lex->tk==LEX_ID) {
+    jslGetNextToken();
+    isAsync = lex->tk==LEX_ARROW_FUNCTION;
+  } else if (!declarationOnly && lex->tk=='(') {
+    int brackets = 0;
+    do {
+      if (lex->tk=='(') brackets++;
+      if (lex->tk==')') brackets--;
+      jslGetNextToken();
+    } while (brackets && lex->tk!=LEX_EOF);
+    isAsync = lex->tk==LEX_ARROW_FUNCTION;
+  }
+#endif
+  jspePeekEnd(&peek);
+  return isAsync;
+}
+
+/// Parse an async function expression or arrow function (we're on `async`, and jspeIsAsyncFunction returned true)
+static NO_INLINE JsVar *jspeAsyncFunction() {
+  JSP_ASSERT_MATCH(LEX_ID);
+  if (lex->tk==LEX_R_FUNCTION) {
+    JSP_ASSERT_MATCH(LEX_R_FUNCTION);
+    return jspeFunctionDefinition(true, JSP_FUNCTION_ASYNC);
+  }
+#ifndef ESPR_NO_ARROW_FN
+  JsVar *funcVar = 0;
+  if (JSP_SHOULD_EXECUTE) {
+    funcVar = jsvNewWithFlags(JSV_FUNCTION);
+    if (!funcVar) return 0; // out of memory
+  }
+  if (lex->tk==LEX_ID) { // `async x => ...`
+    if (funcVar) {
+      JsVar *param = jslGetTokenValueAsVar();
+      jspeAddNamedFunctionParameter(funcVar, param);
+      jsvUnLock(param);
+    }
+    JSP_ASSERT_MATCH(LEX_ID);
+  } else if (!jspeFunctionArguments(funcVar)) { // `async (a,b) => ...`
+    jsvUnLock(funcVar);
+    return 0;
+  }
+  jspeFunctionSetKind(funcVar, JSP_FUNCTION_ASYNC);
+  return jspeArrowFunction(funcVar, 0);
+#else
+  return 0;
+#endif
+}
+#endif // ESPR_NO_ASYNC
+
 NO_INLINE JsVar *jspeFactor() {
   if (lex->tk==LEX_ID) {
+#ifndef ESPR_NO_ASYNC
+    if (jspeIsWord("async") && jspeIsAsyncFunction(false)) {
+      if (!jspCheckStackPosition()) return 0;
+      return jspeAsyncFunction();
+    }
+#endif
     JsVar *a = jspGetNamedVariable(jslGetTokenValueAsString());
     JSP_ASSERT_MATCH(LEX_ID);
+#ifndef ESPR_NO_ASYNC
+    /* `await x`/`yield x` anywhere we can't suspend would otherwise just be a
+     * confusing 'unexpected token' - see jspeCoroutineStatement */
+    if ((lex->tk==LEX_ID || lex->tk==LEX_INT || lex->tk==LEX_FLOAT || lex->tk==LEX_STR ||
+         lex->tk==LEX_R_NEW || lex->tk==LEX_R_THIS) &&
+        jsvIsName(a) && (jsvIsStringEqual(a, "await") || jsvIsStringEqual(a, "yield"))) {
+      jsExceptionHere(JSET_SYNTAXERROR, "await/yield can only be used at the start of a statement in an async function/generator");
+      return a;
+    }
+#endif
 #ifndef ESPR_NO_TEMPLATE_LITERAL
     if (lex->tk==LEX_TEMPLATE_LITERAL)
       jsExceptionHere(JSET_SYNTAXERROR, "Tagged template literals not supported");
@@ -1856,7 +2150,14 @@ NO_INLINE JsVar *jspeFactor() {
   } else if (lex->tk==LEX_R_FUNCTION) {
     if (!jspCheckStackPosition()) return 0;
     JSP_ASSERT_MATCH(LEX_R_FUNCTION);
-    return jspeFunctionDefinition(true);
+    JspFunctionKind kind = JSP_FUNCTION_NORMAL;
+#ifndef ESPR_NO_ASYNC
+    if (lex->tk=='*') { // function* - a generator
+      JSP_ASSERT_MATCH('*');
+      kind = JSP_FUNCTION_GENERATOR;
+    }
+#endif
+    return jspeFunctionDefinition(true, kind);
 #ifndef ESPR_NO_CLASSES
   } else if (lex->tk==LEX_R_CLASS) {
     if (!jspCheckStackPosition()) return 0;
@@ -2255,6 +2556,13 @@ NO_INLINE JsVar * jspeBlockStart() {
   execInfo.blockCount++;
   JsVar *oldBlockScope = execInfo.blockScope;
   execInfo.blockScope = 0;
+#ifndef ESPR_NO_ASYNC
+  if (jspeCoroutineResuming()) { // put back the scope the block had when its coroutine was suspended
+    JsVar *scope = jspeCoroutineResumeNext();
+    if (jsvIsObject(scope) && jspeiAddScope(scope)) execInfo.blockScope = scope;
+    else jsvUnLock(scope);
+  }
+#endif
   return oldBlockScope;
 #else
   return 0;
@@ -2279,6 +2587,9 @@ NO_INLINE void jspeBlockEnd(JsVar *oldBlockScope) {
 NO_INLINE void jspeBlockNoBrackets() {
   JsVar *oldBlockScope = jspeBlockStart();
   if (JSP_SHOULD_EXECUTE) {
+#ifndef ESPR_NO_ASYNC
+    if (jspeCoroutineResuming()) jspeCoroutineResumeSeek();
+#endif
     while (lex->tk && lex->tk!='}') {
       JsVar *a = jspeStatement();
       jsvCheckReferenceError(a);
@@ -2290,6 +2601,9 @@ NO_INLINE void jspeBlockNoBrackets() {
         break;
       }
     }
+#if !defined(ESPR_NO_ASYNC) && !defined(ESPR_NO_LET_SCOPING)
+    if (execInfo.execute & EXEC_SUSPEND) jspeCoroutineSuspendPush(execInfo.blockScope);
+#endif
   } else {
     jspeSkipBlock();
   }
@@ -2393,11 +2707,21 @@ NO_INLINE JsVar *jspeStatementIf() {
   JsVar *var, *result = 0;
   JSP_ASSERT_MATCH(LEX_R_IF);
   JSP_MATCH('(');
+#ifndef ESPR_NO_ASYNC
+  bool resuming = jspeCoroutineResuming();
+  if (resuming) jspSetNoExecute(); // we already know which branch we took
+#endif
   var = jspeExpression();
   if (JSP_SHOULDNT_PARSE) return var;
   JSP_MATCH(')');
   cond = JSP_SHOULD_EXECUTE && jsvGetBoolAndUnLock(jsvSkipName(var));
   jsvUnLock(var);
+#ifndef ESPR_NO_ASYNC
+  if (resuming) {
+    execInfo.execute = (execInfo.execute & (JsExecFlags)~EXEC_RUN_MASK) | EXEC_YES;
+    cond = jsvGetBoolAndUnLock(jspeCoroutineResumeNext());
+  }
+#endif
 
   JSP_SAVE_EXECUTE();
   if (!cond) jspSetNoExecute();
@@ -2432,6 +2756,9 @@ NO_INLINE JsVar *jspeStatementIf() {
       result = a;
     }
   }
+#ifndef ESPR_NO_ASYNC
+  if (execInfo.execute & EXEC_SUSPEND) jspeCoroutineSuspendPushBool(cond); // which branch we were in
+#endif
   return result;
 }
 
@@ -2525,9 +2852,19 @@ NO_INLINE JsVar *jspeStatementDoOrWhile(bool isWhile) {
     JSP_ASSERT_MATCH(LEX_R_WHILE);
     jslCharPosFromLex(&whileCondStart);
     JSP_MATCH_WITH_CLEANUP_AND_RETURN('(',jslCharPosFree(&whileCondStart);,0);
+#ifndef ESPR_NO_ASYNC
+    bool resuming = jspeCoroutineResuming();
+    if (resuming) jspSetNoExecute();
+#endif
     cond = jspeExpression();
     loopCond = JSP_SHOULD_EXECUTE && jsvGetBoolAndUnLock(jsvSkipName(cond));
     jsvUnLock(cond);
+#ifndef ESPR_NO_ASYNC
+    if (resuming) { // we stopped in the body, so go straight back into it
+      execInfo.execute = (execInfo.execute & (JsExecFlags)~EXEC_RUN_MASK) | EXEC_YES;
+      loopCond = true;
+    }
+#endif
     jslCharPosFromLex(&whileBodyStart);
     JSP_MATCH_WITH_CLEANUP_AND_RETURN(')',jslCharPosFree(&whileBodyStart);jslCharPosFree(&whileCondStart);,0);
   } else { // do loop
@@ -2616,6 +2953,10 @@ NO_INLINE JsVar *jspeStatementFor() {
   bool wasInLoop = (execInfo.execute&EXEC_IN_LOOP)!=0;
   execInfo.execute |= EXEC_FOR_INIT;
   JsVar *oldBlockScope = jspeBlockStart();
+#ifndef ESPR_NO_ASYNC
+  bool resuming = jspeCoroutineResuming();
+  if (resuming) jspSetNoExecute(); // we stopped in the body, so skip the initialiser and condition
+#endif
   // initialisation
   JsVar *forStatement = 0;
   bool startsWithConst = lex->tk==LEX_R_CONST;
@@ -2659,6 +3000,31 @@ NO_INLINE JsVar *jspeStatementFor() {
     JSP_RESTORE_EXECUTE();
     // Now start executing properly
     if (JSP_SHOULD_EXECUTE) {
+#ifndef ESPR_NO_ASYNC
+      if (isForOf && jspIsCoroutine(array)) { // for (... of generator())
+        bool hasHadBreak = false, isDone = false;
+        while (JSP_SHOULD_EXECUTE && !hasHadBreak) {
+          JsVar *iteratorValue = jspCoroutineResume(array, 0, false, &isDone);
+          if (isDone || !JSP_SHOULD_EXECUTE) {
+            jsvUnLock(iteratorValue);
+            break;
+          }
+          if (startsWithConst) forStatement->flags &= ~JSV_CONSTANT;
+          jsvReplaceWithOrAddToRoot(forStatement, iteratorValue);
+          if (startsWithConst) forStatement->flags |= JSV_CONSTANT;
+          jsvUnLock(iteratorValue);
+
+          jslSeekToP(&forBodyStart);
+          execInfo.execute |= EXEC_IN_LOOP;
+          jspDebuggerLoopIfCtrlC();
+          jsvUnLock(jspeBlockOrStatement());
+          if (!wasInLoop) execInfo.execute &= (JsExecFlags)~EXEC_IN_LOOP;
+          if (execInfo.execute & EXEC_SUSPEND) jspeCoroutineCantSuspend("for..of");
+
+          hasHadBreak |= jspeCheckBreakContinue();
+        }
+      } else
+#endif
       if (jsvIsIterable(array)) {
         JsvIsInternalChecker checkerFunction = jsvGetInternalFunctionCheckerFor(array);
         JsVar *foundPrototype = 0;
@@ -2701,6 +3067,9 @@ NO_INLINE JsVar *jspeStatementFor() {
               jspDebuggerLoopIfCtrlC();
               jsvUnLock(jspeBlockOrStatement());
               if (!wasInLoop) execInfo.execute &= (JsExecFlags)~EXEC_IN_LOOP;
+#ifndef ESPR_NO_ASYNC
+              if (execInfo.execute & EXEC_SUSPEND) jspeCoroutineCantSuspend(isForOf ? "for..of" : "for..in");
+#endif
 
               hasHadBreak |= jspeCheckBreakContinue();
             }
@@ -2761,6 +3130,12 @@ NO_INLINE JsVar *jspeStatementFor() {
     jslSkipWhiteSpace();
     jslCharPosFromLex(&forBodyStart); // actual for body
     JSP_MATCH_WITH_CLEANUP_AND_RETURN(')',jslCharPosFree(&forCondStart);jslCharPosFree(&forIterStart);jslCharPosFree(&forBodyStart);jspeBlockEnd(oldBlockScope);,0);
+#ifndef ESPR_NO_ASYNC
+    if (resuming) {
+      execInfo.execute = (execInfo.execute & (JsExecFlags)~EXEC_RUN_MASK) | EXEC_YES;
+      loopCond = true;
+    }
+#endif
 
     JSP_SAVE_EXECUTE();
     if (!loopCond) jspSetNoExecute();
@@ -2818,6 +3193,9 @@ NO_INLINE JsVar *jspeStatementFor() {
     }
 #endif
   }
+#if !defined(ESPR_NO_ASYNC) && !defined(ESPR_NO_LET_SCOPING)
+  if (execInfo.execute & EXEC_SUSPEND) jspeCoroutineSuspendPush(execInfo.blockScope);
+#endif
   jspeBlockEnd(oldBlockScope);
   return 0;
 }
@@ -2826,8 +3204,23 @@ NO_INLINE JsVar *jspeStatementTry() {
   // execute the try block
   JSP_ASSERT_MATCH(LEX_R_TRY);
   bool shouldExecuteBefore = JSP_SHOULD_EXECUTE;
+#ifndef ESPR_NO_ASYNC
+  // if we were suspended in the catch block, skip the try block and put back the catch block's scope
+  bool resumeInCatch = jspeCoroutineResuming() && jsvGetBoolAndUnLock(jspeCoroutineResumeNext());
+  JsVar *catchScope = resumeInCatch ? jspeCoroutineResumeNext() : 0;
+  if (resumeInCatch) {
+    jspSetNoExecute();
+    jspeBlock();
+    execInfo.execute = (execInfo.execute & (JsExecFlags)~EXEC_RUN_MASK) | EXEC_YES;
+  } else
+#else
+  const bool resumeInCatch = false;
+#endif
   jspeBlock();
-  bool hadException = shouldExecuteBefore && ((execInfo.execute & EXEC_EXCEPTION)!=0);
+  bool hadException = shouldExecuteBefore && ((execInfo.execute & EXEC_EXCEPTION)!=0 || resumeInCatch);
+#ifndef ESPR_NO_ASYNC
+  if (execInfo.execute & EXEC_SUSPEND) jspeCoroutineSuspendPushBool(false); // not in the catch block
+#endif
 
   bool hadCatch = false;
   if (lex->tk == LEX_R_CATCH) {
@@ -2838,6 +3231,11 @@ NO_INLINE JsVar *jspeStatementTry() {
     JsVar *exception = shouldExecuteBefore ? jspGetException() : 0;
     if (lex->tk == '(') {
       JSP_MATCH('(');
+#ifndef ESPR_NO_ASYNC
+      if (resumeInCatch) {
+        scope = jsvIsObject(catchScope) ? jsvLockAgain(catchScope) : 0;
+      } else
+#endif
       if (hadException) {
         scope = jsvNewObject();
         if (scope)
@@ -2870,9 +3268,18 @@ NO_INLINE JsVar *jspeStatementTry() {
         jspeBlock();
         if (scope) jspeiRemoveScope();
       }
+#ifndef ESPR_NO_ASYNC
+      if (execInfo.execute & EXEC_SUSPEND) {
+        jspeCoroutineSuspendPush(scope);
+        jspeCoroutineSuspendPushBool(true); // in the catch block
+      }
+#endif
     }
     jsvUnLock(scope);
   }
+#ifndef ESPR_NO_ASYNC
+  jsvUnLock(catchScope);
+#endif
   if (lex->tk == LEX_R_FINALLY || (!hadCatch && ((execInfo.execute&(EXEC_ERROR|EXEC_INTERRUPTED))==0))) {
     JSP_MATCH(LEX_R_FINALLY);
     // clear the exception flag so we can execute 'finally' - but only momentarily!
@@ -2880,6 +3287,13 @@ NO_INLINE JsVar *jspeStatementTry() {
     if (shouldExecuteBefore)
       execInfo.execute = (execInfo.execute & (JsExecFlags)~(EXEC_EXCEPTION|EXEC_RETURN|EXEC_BREAK|EXEC_CONTINUE)) | EXEC_YES;
     jspeBlock();
+#ifndef ESPR_NO_ASYNC
+    // we can't get back into 'finally', as we'd need to know what should happen after it
+    if ((execInfo.execute & EXEC_SUSPEND) && !(oldExec & EXEC_SUSPEND)) {
+      jspeCoroutineCantSuspend("finally");
+      oldExec |= execInfo.execute & EXEC_ERROR_MASK;
+    }
+#endif
     // put the flag back!
     execInfo.execute = oldExec;
     if (hadException && !hadCatch) execInfo.execute = execInfo.execute | EXEC_EXCEPTION;
@@ -2922,12 +3336,29 @@ NO_INLINE JsVar *jspeStatementThrow() {
 NO_INLINE JsVar *jspeStatementFunctionDecl(bool isClass) {
   JsVar *funcName = 0;
   JsVar *funcVar;
+  JspFunctionKind kind = JSP_FUNCTION_NORMAL;
 
+#ifndef ESPR_NO_ASYNC
+  if (lex->tk==LEX_ID) { // `async function`
+    JSP_ASSERT_MATCH(LEX_ID);
+    kind = JSP_FUNCTION_ASYNC;
+  }
+#endif
 #ifndef ESPR_NO_CLASSES
   JSP_ASSERT_MATCH(isClass ? LEX_R_CLASS : LEX_R_FUNCTION);
 #else
   JSP_ASSERT_MATCH(LEX_R_FUNCTION);
 #endif
+#ifndef ESPR_NO_ASYNC
+  if (!isClass && lex->tk=='*') { // function* - a generator
+    JSP_ASSERT_MATCH('*');
+    if (kind==JSP_FUNCTION_ASYNC) {
+      jsExceptionHere(JSET_SYNTAXERROR, "Async generators not supported");
+      return 0;
+    }
+    kind = JSP_FUNCTION_GENERATOR;
+  }
+#endif
 
   bool actuallyCreateFunction = JSP_SHOULD_EXECUTE;
   if (actuallyCreateFunction) {
@@ -2938,9 +3369,9 @@ NO_INLINE JsVar *jspeStatementFunctionDecl(bool isClass) {
   }
   JSP_MATCH_WITH_CLEANUP_AND_RETURN(LEX_ID, jsvUnLock(funcName), 0);
 #ifndef ESPR_NO_CLASSES
-  funcVar = isClass ? jspeClassDefinition(false) : jspeFunctionDefinition(false);
+  funcVar = isClass ? jspeClassDefinition(false) : jspeFunctionDefinition(false, kind);
 #else
-  funcVar = jspeFunctionDefinition(false);
+  funcVar = jspeFunctionDefinition(false, kind);
 #endif
   if (actuallyCreateFunction) {
     // find a function with the same name (or make one)
@@ -2969,7 +3400,7 @@ NO_INLINE JsVar *jspeStatementFunctionDecl(bool isClass) {
   return funcName;
 }
 
-NO_INLINE JsVar *jspeStatement() {
+static NO_INLINE JsVar *jspeStatementBody() {
   if (execInfo.execute&(EXEC_RUN_INTERRUPT_JS
 #ifdef USE_DEBUGGER
     |EXEC_DEBUGGER_NEXT_LINE
@@ -2987,6 +3418,11 @@ NO_INLINE JsVar *jspeStatement() {
       jstRunInterruptingJS();
     }
   }
+#ifndef ESPR_NO_ASYNC
+  if (jspeIsWord("async") && jspeIsAsyncFunction(true)) {
+    return jspeStatementFunctionDecl(false/* async function */);
+  } else
+#endif
   if (lex->tk==LEX_ID ||
       lex->tk==LEX_INT ||
       lex->tk==LEX_FLOAT ||
@@ -3074,6 +3510,367 @@ NO_INLINE JsVar *jspeStatement() {
   return 0;
 }
 
+NO_INLINE JsVar *jspeStatement() {
+#ifndef ESPR_NO_ASYNC
+  if (jspCoroutine && jspCoroutine->lex==lex && JSP_SHOULD_EXECUTE)
+    return jspeCoroutineStatement();
+#endif
+  return jspeStatementBody();
+}
+
+#ifndef ESPR_NO_ASYNC
+// -----------------------------------------------------------------------------
+/* Calling an async function or a generator doesn't run its code. Instead we return
+ * a 'coroutine' object that holds the function and the scope that it runs in (with
+ * its arguments and local variables), and jspCoroutineResume runs the code up to the
+ * next `await`/`yield`. `await` and `yield` must be at the start of a statement (see
+ * jspeIsSuspendStatement), but that statement can be inside blocks, `if`, `while`,
+ * `do` and `for(;;)` loops, and `try`/`catch`. When we suspend we save the position
+ * after the statement, and the 'path' of statements we were in (with any `let` scopes
+ * and which branches were taken) so we can follow it back down when resuming. We can't
+ * get back into `for..in`/`for..of`, `switch` or `finally`, so suspending in those is an error. */
+#define JSP_COROUTINE_FUNCTION_NAME JS_HIDDEN_CHAR_STR"fn" // the function - removed while running
+#define JSP_COROUTINE_ROOT_NAME JS_HIDDEN_CHAR_STR"rot" // the function's scope - removed when finished
+#define JSP_COROUTINE_POS_NAME JS_HIDDEN_CHAR_STR"pos" // character in the code to carry on from
+#define JSP_COROUTINE_PATH_NAME JS_HIDDEN_CHAR_STR"pth" // how to get back to 'pos' - see jspeCoroutineStatement
+#define JSP_COROUTINE_TARGET_NAME JS_HIDDEN_CHAR_STR"tgt" // variable to set from the await/yield we stopped at
+#define JSP_COROUTINE_TARGET_TYPE_NAME JS_HIDDEN_CHAR_STR"tty" // LEX_ID (assign), LEX_R_VAR/LET/CONST (declare) or LEX_R_RETURN
+
+JspFunctionKind jspGetFunctionKind(JsVar *function) {
+  if (!jsvIsFunction(function) || jsvIsNativeFunction(function)) return JSP_FUNCTION_NORMAL;
+  return (JspFunctionKind)jsvObjectGetIntegerChild(function, JSPARSE_FUNCTION_KIND_NAME);
+}
+
+bool jspIsCoroutine(JsVar *coroutine) {
+  if (!jsvIsObject(coroutine)) return false;
+  JsVar *pos = jsvFindChildFromString(coroutine, JSP_COROUTINE_POS_NAME);
+  jsvUnLock(pos);
+  return pos!=0;
+}
+
+static JsVar *jspeCoroutineNew(JsVar *function, JspFunctionKind kind, JsVar *functionRoot, JsVar *thisVar) {
+  JsVar *coroutine = (kind==JSP_FUNCTION_GENERATOR) ? jspNewObject(0, "Generator") : jsvNewObject();
+  if (!coroutine) return 0; // out of memory
+  jsvObjectSetChild(coroutine, JSP_COROUTINE_FUNCTION_NAME, function);
+  jsvObjectSetChild(coroutine, JSP_COROUTINE_ROOT_NAME, functionRoot);
+  jsvObjectSetChildAndUnLock(coroutine, JSP_COROUTINE_POS_NAME, jsvNewFromInteger(0));
+  if (thisVar) jsvObjectSetChild(coroutine, JSPARSE_FUNCTION_THIS_NAME, thisVar);
+  if (kind!=JSP_FUNCTION_ASYNC) return coroutine;
+#if ESPR_NO_PROMISES!=1
+  // async functions run straight away, up until the first `await`
+  JsVar *promise = jspromise_async(coroutine);
+#else
+  JsVar *promise = 0;
+  jsExceptionHere(JSET_ERROR, "async functions need Promises");
+#endif
+  jsvUnLock(coroutine);
+  return promise;
+}
+
+void jspCoroutineKill(JsVar *coroutine) {
+  jsvObjectRemoveChild(coroutine, JSP_COROUTINE_FUNCTION_NAME);
+  jsvObjectRemoveChild(coroutine, JSP_COROUTINE_ROOT_NAME);
+  jsvObjectRemoveChild(coroutine, JSP_COROUTINE_PATH_NAME);
+  jsvObjectRemoveChild(coroutine, JSPARSE_FUNCTION_THIS_NAME);
+  jsvObjectRemoveChild(coroutine, JSP_COROUTINE_TARGET_NAME);
+  jsvObjectRemoveChild(coroutine, JSP_COROUTINE_TARGET_TYPE_NAME);
+}
+
+/* Is the statement we're on one that suspends the coroutine? `word x`, `a = word x`,
+ * `var a = word x` (or let/const) or `return word x` */
+static NO_INLINE bool jspeIsSuspendStatement(const char *word) {
+  int tk = lex->tk;
+  if (jspeIsWord(word)) return true;
+  if (tk!=LEX_ID && tk!=LEX_R_RETURN && tk!=LEX_R_VAR && tk!=LEX_R_LET && tk!=LEX_R_CONST)
+    return false;
+  JspePeek peek;
+  jspePeekStart(&peek);
+  bool suspends = true;
+  if (tk!=LEX_ID && tk!=LEX_R_RETURN) { // var/let/const
+    suspends = lex->tk==LEX_ID;
+    jslGetNextToken();
+  }
+  if (tk!=LEX_R_RETURN) {
+    suspends = suspends && lex->tk=='=';
+    jslGetNextToken();
+  }
+  suspends = suspends && jspeIsWord(word);
+  jspePeekEnd(&peek);
+  return suspends;
+}
+
+/* Give the await/yield we stopped at the value it evaluates to, by throwing it, returning
+ * it or setting the variable it was assigned to (see jspeIsSuspendStatement) */
+static void jspeCoroutineSetValue(JspCoroutine *co) {
+  int targetType = (int)jsvObjectGetIntegerChild(co->coroutine, JSP_COROUTINE_TARGET_TYPE_NAME);
+  if (co->isException) {
+    jspSetException(co->value);
+  } else if (targetType==LEX_R_RETURN) { // `return await x`
+    JsVar *returnVar = jspeiFindInScopes(JSPARSE_RETURN_VAR);
+    if (returnVar) jsvReplaceWith(returnVar, co->value);
+    jsvUnLock(returnVar);
+    execInfo.execute |= EXEC_RETURN;
+  } else if (targetType) {
+    char name[JSLEX_MAX_TOKEN_LENGTH+1];
+    JsVar *target = jsvObjectGetChildIfExists(co->coroutine, JSP_COROUTINE_TARGET_NAME);
+    jsvGetString(target, name, sizeof(name));
+    jsvUnLock(target);
+    JsVar *a = 0;
+    if (targetType==LEX_ID) { // `a = await x` - `a` could be in any scope
+      a = jspeiFindInScopes(name);
+      if (!a) a = jsvFindOrAddChildFromString(execInfo.root, name);
+#ifndef ESPR_NO_LET_SCOPING
+    } else if (targetType!=LEX_R_VAR && execInfo.blockCount) { // `let a = await x` in a block
+      if (!execInfo.blockScope) {
+        execInfo.blockScope = jsvNewObject();
+        jspeiAddScope(execInfo.blockScope);
+      }
+      if (execInfo.blockScope)
+        a = jsvFindOrAddChildFromString(execInfo.blockScope, name);
+    } else {
+      a = jsvFindOrAddChildFromString(execInfo.baseScope, name);
+#else
+    } else {
+      JsVar *scope = jspeiGetTopScope();
+      a = jsvFindOrAddChildFromString(scope, name);
+      jsvUnLock(scope);
+#endif
+    }
+    if (!a) return; // out of memory
+    jsvReplaceWith(a, co->value);
+    if (targetType==LEX_R_CONST) a->flags |= JSV_CONSTANT;
+    jsvUnLock(a);
+  }
+}
+
+/* Save where we've got to in the coroutine, and what to set from the value
+ * passed in when it is resumed */
+static void jspeCoroutineSuspend(JsVar *coroutine, JsVar *target, int targetType) {
+  jsvObjectSetChildAndUnLock(coroutine, JSP_COROUTINE_POS_NAME, jsvNewFromInteger((JsVarInt)lex->tokenStart));
+  jsvObjectSetChild(coroutine, JSP_COROUTINE_TARGET_NAME, target);
+  jsvObjectSetChildAndUnLock(coroutine, JSP_COROUTINE_TARGET_TYPE_NAME, jsvNewFromInteger(targetType));
+}
+
+/// Execute `await x` (or any other statement jspeIsSuspendStatement accepts), suspending the coroutine
+static NO_INLINE void jspeCoroutineSuspendStatement() {
+  JspCoroutine *co = jspCoroutine;
+  if (execInfo.execute & EXEC_IN_SWITCH) {
+    jsExceptionHere(JSET_SYNTAXERROR, "%s can't be used inside switch", co->word);
+    return;
+  }
+  JsVar *target = 0;
+  int targetType = 0;
+  if (lex->tk==LEX_R_RETURN) {
+    targetType = LEX_R_RETURN;
+    JSP_ASSERT_MATCH(LEX_R_RETURN);
+  } else if (!jspeIsWord(co->word)) {
+    targetType = lex->tk;
+    if (targetType!=LEX_ID) JSP_ASSERT_MATCH(targetType); // var/let/const
+    target = jslGetTokenValueAsVar();
+    JSP_ASSERT_MATCH(LEX_ID);
+    JSP_ASSERT_MATCH('=');
+  }
+  JSP_ASSERT_MATCH(LEX_ID); // await/yield
+  JsVar *value = 0;
+  if (lex->tk!=';' && lex->tk!='}' && lex->tk!=LEX_EOF)
+    value = jsvSkipNameAndUnLock(jspeAssignmentExpression());
+  if (lex->tk==',')
+    jsExceptionHere(JSET_SYNTAXERROR, "Only one expression is allowed after %s", co->word);
+  if (lex->tk==';') JSP_ASSERT_MATCH(';');
+  if (JSP_SHOULD_EXECUTE) {
+    co->path = jsvNewEmptyArray();
+    if (co->path) {
+      jspeCoroutineSuspend(co->coroutine, target, targetType);
+      co->result = value;
+      value = 0;
+      execInfo.execute |= EXEC_SUSPEND;
+    } else jspSetError(); // out of memory
+  }
+  jsvUnLock2(target, value);
+}
+
+/* Called instead of jspeStatement for the coroutine's own statements. If the statement
+ * suspends the coroutine it sets EXEC_SUSPEND, which stops execution like `return`
+ * does, and as each statement/block we're in finishes it adds what's needed to get
+ * back into it to 'path' (with jspeCoroutineSuspendPush). When resuming, statements,
+ * blocks, `if` and `try` take those back off in the opposite order (with
+ * jspeCoroutineResumeNext), skipping anything that ran before we stopped. */
+static NO_INLINE JsVar *jspeCoroutineStatement() {
+  JspCoroutine *co = jspCoroutine;
+  JsVarInt start = (JsVarInt)lex->tokenStart;
+  JsVar *result = 0;
+  if (co->resume) {
+    jsvUnLock(jspeCoroutineResumeNext()); // our position - we're already here
+    if (!jsvGetArrayLength(co->resume)) { // this is where we stopped
+      jsvUnLock(co->resume);
+      co->resume = 0;
+      jslSeekTo((size_t)jsvObjectGetIntegerChild(co->coroutine, JSP_COROUTINE_POS_NAME));
+      jspeCoroutineSetValue(co);
+      return 0;
+    }
+    result = jspeStatementBody();
+  } else if (jspeIsSuspendStatement(co->word)) {
+    jspeCoroutineSuspendStatement();
+  } else {
+    result = jspeStatementBody();
+  }
+  if (execInfo.execute & EXEC_SUSPEND)
+    jsvArrayPushAndUnLock(co->path, jsvNewFromInteger(start));
+  return result;
+}
+
+/// Add something we'll need to resume the statement/block we're in to the suspended coroutine's path
+static void jspeCoroutineSuspendPush(JsVar *item) {
+  jsvArrayPush(jspCoroutine->path, item);
+}
+
+static void jspeCoroutineSuspendPushBool(bool b) {
+  jsvArrayPushAndUnLock(jspCoroutine->path, jsvNewFromBool(b));
+}
+
+/// When resuming, get the next thing that was added by jspeCoroutineSuspendPush
+static JsVar *jspeCoroutineResumeNext() {
+  return jsvSkipNameAndUnLock(jsvArrayPop(jspCoroutine->resume));
+}
+
+/// When resuming, skip ahead to the statement in the current block that we stopped in
+static void jspeCoroutineResumeSeek() {
+  JsVar *start = jsvGetArrayItem(jspCoroutine->resume, jsvGetArrayLength(jspCoroutine->resume)-1);
+  if (jsvIsInt(start)) jslSeekTo((size_t)jsvGetInteger(start));
+  jsvUnLock(start);
+}
+
+/// We suspended somewhere we can't get back into
+static void jspeCoroutineCantSuspend(const char *where) {
+  execInfo.execute &= (JsExecFlags)~EXEC_SUSPEND;
+  jsExceptionHere(JSET_SYNTAXERROR, "%s can't be used inside %s", jspCoroutine->word, where);
+}
+
+JsVar *jspCoroutineResume(JsVar *coroutine, JsVar *value, bool isException, bool *isDone) {
+  *isDone = true;
+  JsVar *function = jsvObjectGetChildIfExists(coroutine, JSP_COROUTINE_FUNCTION_NAME);
+  JsVar *functionRoot = jsvObjectGetChildIfExists(coroutine, JSP_COROUTINE_ROOT_NAME);
+  if (!function || !jspCheckStackPosition()) {
+    if (functionRoot) // we don't have the function while it's running
+      jsExceptionHere(JSET_ERROR, "Generator is already running");
+    else if (isException) // already finished
+      jspSetException(value);
+    jsvUnLock2(function, functionRoot);
+    return 0;
+  }
+  jsvObjectRemoveChild(coroutine, JSP_COROUTINE_FUNCTION_NAME);
+  JsVar *thisVar = jsvObjectGetChildIfExists(coroutine, JSPARSE_FUNCTION_THIS_NAME);
+  size_t codePos = (size_t)jsvObjectGetIntegerChild(coroutine, JSP_COROUTINE_POS_NAME);
+  JsVar *functionCode = jsvObjectGetChildIfExists(function, JSPARSE_FUNCTION_CODE_NAME);
+  JsVar *functionScope = jsvObjectGetChildIfExists(function, JSPARSE_FUNCTION_SCOPE_NAME);
+  JsVar *functionName = jsvObjectGetChildIfExists(function, JSPARSE_FUNCTION_NAME_NAME);
+  JspCoroutine co;
+  co.coroutine = coroutine;
+  co.lex = 0;
+  co.word = (jspGetFunctionKind(function)==JSP_FUNCTION_ASYNC) ? "await" : "yield";
+  co.value = value;
+  co.isException = isException;
+  co.resume = jsvObjectGetChildIfExists(coroutine, JSP_COROUTINE_PATH_NAME);
+  co.path = 0;
+  co.result = 0;
+  jsvObjectRemoveChild(coroutine, JSP_COROUTINE_PATH_NAME);
+  JsVar *result = 0;
+  bool suspended = false;
+
+  // This is the same as jspeFunctionCall, except that we stop at the first await/yield
+  JsVar *oldScopeVar = execInfo.scopesVar;
+  execInfo.scopesVar = 0;
+  if (functionScope) jspeiLoadScopesFromVar(functionScope);
+  if (jspeiAddScope(functionRoot)) {
+#ifndef ESPR_NO_LET_SCOPING
+    JsVar *oldBaseScope = execInfo.baseScope;
+    uint8_t oldBlockCount = execInfo.blockCount;
+    execInfo.baseScope = functionRoot;
+    execInfo.blockCount = 0;
+#endif
+    JsVar *oldThisVar = execInfo.thisVar;
+    execInfo.thisVar = jsvRef(thisVar ? thisVar : execInfo.root);
+    if (jsvIsString(functionCode)) {
+      JsLex newLex;
+      JsLex *oldLex = jslSetLex(&newLex);
+      jslInit(functionCode);
+      newLex.functionName = functionName;
+      newLex.lastLex = oldLex;
+      JspCoroutine *oldCoroutine = jspCoroutine;
+      jspCoroutine = &co;
+      co.lex = &newLex;
+      JSP_SAVE_EXECUTE();
+      execInfo.execute = EXEC_YES | (execInfo.execute&(EXEC_CTRL_C_MASK|EXEC_ERROR_MASK));
+      JsVar *returnVarName = jsvAddNamedChild(functionRoot, 0, JSPARSE_RETURN_VAR);
+      if (jsvIsFunctionReturn(function)) { // just an expression, eg `async x => await foo(x)`
+        if (codePos) jslSeekTo(codePos);
+        jspeCoroutineSetValue(&co);
+        if (!JSP_SHOULD_EXECUTE) {
+          // we're already done
+        } else if (jspeIsWord(co.word)) {
+          JSP_ASSERT_MATCH(LEX_ID);
+          result = jsvSkipNameAndUnLock(jspeAssignmentExpression());
+          suspended = JSP_SHOULD_EXECUTE;
+          if (suspended) jspeCoroutineSuspend(coroutine, 0, LEX_R_RETURN);
+        } else if (lex->tk!=';' && lex->tk!='}') {
+          JsVar *returnValue = jsvSkipNameAndUnLock(jspeExpression());
+          jsvReplaceWith(returnVarName, returnValue);
+          jsvUnLock(returnValue);
+        }
+      } else {
+        if (co.resume) jspeCoroutineResumeSeek(); // go back into the statement we stopped in
+        else jspeCoroutineSetValue(&co); // eg. Generator.throw() before we started
+        while (JSP_SHOULD_EXECUTE && lex->tk!=LEX_EOF) {
+          JsVar *a = jspeStatement();
+          jsvCheckReferenceError(a);
+          jsvUnLock(a);
+        }
+        suspended = (execInfo.execute & EXEC_SUSPEND)!=0;
+        if (suspended) {
+          result = co.result;
+          co.result = 0;
+          jsvObjectSetChild(coroutine, JSP_COROUTINE_PATH_NAME, co.path);
+        }
+      }
+      if (!suspended) {
+        jsvUnLock(result);
+        result = jsvSkipName(returnVarName);
+      }
+      if (returnVarName) // could have failed with out of memory
+        jsvRemoveChildAndUnLock(functionRoot, returnVarName);
+      JsExecFlags hasError = execInfo.execute&EXEC_ERROR_MASK;
+      JSP_RESTORE_EXECUTE();
+      jspCoroutine = oldCoroutine;
+      jslKill();
+      jslSetLex(oldLex);
+      if (hasError)
+        execInfo.execute |= hasError; // propogate error
+    }
+    if (execInfo.thisVar) jsvUnRef(execInfo.thisVar);
+    execInfo.thisVar = oldThisVar;
+#ifndef ESPR_NO_LET_SCOPING
+    jspeiRemoveScope();
+    execInfo.baseScope = oldBaseScope;
+    execInfo.blockCount = oldBlockCount;
+#endif
+  }
+  jsvUnLock(execInfo.scopesVar);
+  execInfo.scopesVar = oldScopeVar;
+
+  if (suspended) {
+    jsvObjectSetChild(coroutine, JSP_COROUTINE_FUNCTION_NAME, function);
+    *isDone = false;
+  } else {
+    jspCoroutineKill(coroutine);
+  }
+  jsvUnLock4(co.resume, co.path, co.result, thisVar);
+  jsvUnLock4(function, functionRoot, functionCode, functionScope);
+  jsvUnLock(functionName);
+  if (lex) jsvStringIteratorUpdatePtr(&lex->it); // see jspeFunctionCall
+  return result;
+}
+#endif // ESPR_NO_ASYNC
+
 // -----------------------------------------------------------------------------
 /// Create a new built-in object that jswrapper can use to check for built-in functions
 JsVar *jspNewBuiltin(const char *instanceOf) {
@@ -81,6 +81,27 @@ JsVar *jspExecuteFunction(JsVar *func, JsVar *thisArg, int argCount, JsVar **arg
 /// Evaluate a JavaScript module and return its exports
 JsVar *jspEvaluateModule(JsVar *moduleContents);
 
+/// What sort of function a (non-native) function is - stored in JSPARSE_FUNCTION_KIND_NAME
+typedef enum {
+  JSP_FUNCTION_NORMAL,
+  JSP_FUNCTION_ASYNC,     ///< `async function` - calling it returns a Promise
+  JSP_FUNCTION_GENERATOR, ///< `function*` - calling it returns a Generator
+} JspFunctionKind;
+
+#ifndef ESPR_NO_ASYNC
+/// Return what sort of function this is (JSP_FUNCTION_NORMAL for anything that isn't a JS function)
+JspFunctionKind jspGetFunctionKind(JsVar *function);
+/// Is this the object returned from calling a generator or async function?
+bool jspIsCoroutine(JsVar *coroutine);
+/** Run an async function/generator's code (from the object returned when it was called) up to
+ * the next `await`/`yield`, and return the value that was awaited/yielded. 'value' is what the
+ * `await`/`yield` that we stopped at evaluates to (or is thrown there if isException). When the
+ * function has finished, *isDone is set and its return value is returned. */
+JsVar *jspCoroutineResume(JsVar *coroutine, JsVar *value, bool isException, bool *isDone);
+/// Finish an async function/generator without running any more of its code
+void jspCoroutineKill(JsVar *coroutine);
+#endif
+
 /** Get the owner of the current prototype. We assume that it's
  * the first item in the array, because that's what we will
  * have added when we created it. It's safe to call this on
@@ -124,11 +145,12 @@ typedef enum  {
 #else
   EXEC_DEBUGGER_MASK = 0,
 #endif
+  EXEC_SUSPEND = 65536, ///< An async function/generator reached `await`/`yield`, so skip to the end of it (see jspCoroutineResume)
 
-  EXEC_RUN_MASK = EXEC_YES|EXEC_BREAK|EXEC_CONTINUE|EXEC_RETURN|EXEC_INTERRUPTED|EXEC_EXCEPTION,
+  EXEC_RUN_MASK = EXEC_YES|EXEC_BREAK|EXEC_CONTINUE|EXEC_RETURN|EXEC_INTERRUPTED|EXEC_EXCEPTION|EXEC_SUSPEND,
   EXEC_ERROR_MASK = EXEC_INTERRUPTED|EXEC_ERROR|EXEC_EXCEPTION, ///< here, we have an error, but unless EXEC_NO_PARSE, we should continue parsing but not executing
   EXEC_NO_PARSE_MASK = EXEC_INTERRUPTED|EXEC_ERROR, ///< in these cases we should exit as fast as possible - skipping out of parsing
-  EXEC_SAVE_RESTORE_MASK = EXEC_YES|EXEC_BREAK|EXEC_CONTINUE|EXEC_RETURN|EXEC_IN_LOOP|EXEC_IN_SWITCH|EXEC_ERROR_MASK, ///< the things JSP_SAVE/RESTORE_EXECUTE should keep track of
+  EXEC_SAVE_RESTORE_MASK = EXEC_YES|EXEC_BREAK|EXEC_CONTINUE|EXEC_RETURN|EXEC_SUSPEND|EXEC_IN_LOOP|EXEC_IN_SWITCH|EXEC_ERROR_MASK, ///< the things JSP_SAVE/RESTORE_EXECUTE should keep track of
   EXEC_CTRL_C_MASK = EXEC_CTRL_C | EXEC_CTRL_C_WAIT, ///< Ctrl-C was pressed at some point
   EXEC_PERSIST = EXEC_ERROR_MASK|EXEC_CTRL_C_MASK|EXEC_RUN_INTERRUPT_JS, ///< Things we should keep track of even after executing
 } JsExecFlags;
@@ -49,6 +49,7 @@
 #endif
 #define ESPR_NO_CLASSES 1
 #define ESPR_NO_ARROW_FN 1
+#define ESPR_NO_ASYNC 1
 #define ESPR_NO_REGEX 1
 #define ESPR_NO_PRETOKENISE 1
 #define ESPR_NO_TEMPLATE_LITERAL 1
@@ -58,6 +59,11 @@
 #endif
 #define ESPR_NO_REGEX_OPTIMISE 1
 #define ESPR_NO_PASSWORD 1
+#define ESPR_NO_OBJECT_INDEX 1
+#define ESPR_NO_ARRAY_INDEX_CACHE 1
+#define ESPR_NO_INCREMENTAL_GC 1
+#define ESPR_NO_MEMBER_CACHE 1
+#define ESPR_NO_SYMBOL_HASH 1
 #endif // SAVE_ON_FLASH
 #ifdef SAVE_ON_FLASH_EXTREME
 #define ESPR_NO_BLUETOOTH_MESSAGES 1
@@ -325,6 +331,25 @@ typedef int64_t JsSysTime;
 #define JS_VARS_BEFORE_IDLE_GC 32
 #endif
 
+/* How many vars can be waiting to have their children marked during
+ * garbage collection. If this overflows, the GC has to search memory
+ * for the vars it missed, which takes longer */
+#ifndef JSV_GC_MARK_STACK_SIZE
+#ifdef SAVE_ON_FLASH
+#define JSV_GC_MARK_STACK_SIZE 32
+#else
+#define JSV_GC_MARK_STACK_SIZE 128
+#endif
+#endif
+
+/* How many entries there are in the cache of things found in prototypes/built-ins
+ * when accessing a member of an Object (see jspGetNamedField). Must be a power of 2 */
+#ifndef JSP_MEMBER_CACHE_SIZE
+#define JSP_MEMBER_CACHE_SIZE 32
+#endif
+/// Names longer than this aren't cached
+#define JSP_MEMBER_CACHE_NAME_LEN 16
+
 // javascript specific names
 #define JSPARSE_RETURN_VAR JS_HIDDEN_CHAR_STR"rtn" // variable name used for returning function results
 #define JSPARSE_PROTOTYPE_VAR "prototype"
@@ -338,6 +363,8 @@ typedef int64_t JsSysTime;
 #define JSPARSE_FUNCTION_SCOPE_NAME JS_HIDDEN_CHAR_STR"sco" // the scope of the function's definition
 #define JSPARSE_FUNCTION_THIS_NAME JS_HIDDEN_CHAR_STR"ths" // the 'this' variable - for bound functions
 #define JSPARSE_FUNCTION_NAME_NAME JS_HIDDEN_CHAR_STR"nam" // for named functions (a = function foo() { foo(); })
+#define JSPARSE_FUNCTION_KIND_NAME JS_HIDDEN_CHAR_STR"knd" // for async functions and generators (see JspFunctionKind)
+#define JSV_OBJECT_INDEX_NAME JS_HIDDEN_CHAR_STR"idx" // hash index of the keys of large Objects (see jsvar.c)
 #define JS_EVENT_PREFIX "#on"
 #define JS_TIMEZONE_VAR "tz"
 #ifndef ESPR_NO_DAYLIGHT_SAVING
@@ -65,6 +65,79 @@ typedef enum {
 volatile bool touchedFreeList = false;
 volatile JsVarRef jsVarFirstEmpty; ///< reference of first unused variable (variables are in a linked list)
 volatile MemBusyType isMemoryBusy; ///< Are we doing garbage collection or similar, so can't access memory?
+#ifndef ESPR_NO_ARRAY_INDEX_CACHE
+/* The array element last found with jsvGetArrayIndex. Accessing an array with a[i]
+ * in a loop can then start searching from here rather than from the start/end of
+ * the array. This is cleared whenever the element could be removed from the array */
+static JsVarRef jsvArrayIndexCacheArray;
+static JsVarRef jsvArrayIndexCacheChild;
+static ALWAYS_INLINE void jsvArrayIndexCacheClear() {
+  jsvArrayIndexCacheArray = 0;
+  jsvArrayIndexCacheChild = 0;
+}
+#endif
+#ifndef ESPR_NO_MEMBER_CACHE
+/* Changed whenever something happens that could alter what an Object inherits
+ * from its prototypes. jspGetNamedField caches what it found in prototypes
+ * against this, and jsvObjectEpochWatched is a bitmask (bit = ref&31) of the
+ * prototypes it has cached things from, so we only have to change the epoch
+ * if one of those (or a var with the same bit) is altered */
+unsigned int jsvObjectEpoch = 1;
+uint32_t jsvObjectEpochWatched;
+static ALWAYS_INLINE void jsvObjectEpochChanged() {
+  jsvObjectEpoch++;
+  jsvObjectEpochWatched = 0;
+}
+/// Children of an Object are being added or removed (or it's being freed)
+static ALWAYS_INLINE void jsvObjectEpochCheck(JsVar *obj) {
+  if (jsvObjectEpochWatched & (1U<<(jsvGetRef(obj)&31)))
+    jsvObjectEpochChanged();
+}
+/// The value of the given name is being set - if it's one that affects inheritance, change the epoch
+static void jsvObjectEpochCheckName(JsVar *name, bool isAdding) {
+  if (!jsvIsString(name)) return;
+  // The first 4 chars are always in the name itself, so check those before doing a proper compare
+  const char *s = name->varData.str;
+  if ((!memcmp(s, JSPARSE_PROTOTYPE_VAR, 4) && jsvIsStringEqual(name, JSPARSE_PROTOTYPE_VAR)) ||
+      (!isAdding && ((!memcmp(s, JSPARSE_INHERITS_VAR, 4) && jsvIsStringEqual(name, JSPARSE_INHERITS_VAR)) ||
+                     (!memcmp(s, JSPARSE_CONSTRUCTOR_VAR, 4) && jsvIsStringEqual(name, JSPARSE_CONSTRUCTOR_VAR)))))
+    jsvObjectEpochChanged();
+}
+#endif
+static JsVarRef jsvGCMarkStack[JSV_GC_MARK_STACK_SIZE]; ///< Marked vars whose children still need marking
+static unsigned int jsvGCMarkStackLen;
+static bool jsvGCMarkStackOverflow; ///< We couldn't push something onto jsvGCMarkStack, so have to rescan memory
+#ifndef ESPR_NO_INCREMENTAL_GC
+/// What stage of an incremental garbage collection are we in? See jsvGarbageCollectSlice
+typedef enum {
+  JSVGC_IDLE,   ///< No collection in progress
+  JSVGC_FLAG,   ///< Setting JSV_GARBAGE_COLLECT on every used var (locked vars are marked straight away)
+  JSVGC_MARK,   ///< Marking everything reachable from vars on the mark stack
+  JSVGC_RESCAN, ///< The mark stack overflowed - look through memory for marked vars that link to unmarked ones
+  JSVGC_SWEEP,  ///< Freeing all vars that still have JSV_GARBAGE_COLLECT set
+} PACKED_FLAGS JsvGCPhase;
+static JsvGCPhase jsvGCPhase;
+/// True while marking - when set, jsvSetFirstChild/etc and jsvLock must tell the GC
+static bool jsvGCBarrier;
+static JsVarRef jsvGCCursor; ///< Next var to look at for JSVGC_FLAG/RESCAN/SWEEP
+static JsVarRef jsvGCFreeFirst, jsvGCFreeLast; ///< Vars freed by JSVGC_SWEEP. Added to the free list when the sweep ends
+static unsigned int jsvGCFreed; ///< Vars freed by JSVGC_SWEEP
+static JsSysTime jsvGCBudget; ///< Maximum length of an incremental GC slice (0 = incremental GC disabled)
+static unsigned int jsvGCPauses[JSV_GC_PAUSE_BUCKETS]; ///< Histogram of GC pause lengths
+static JsSysTime jsvGCMaxPause; ///< Longest GC pause
+static unsigned int jsvGCSlices; ///< Number of incremental GC slices run
+static unsigned int jsvGCCycles; ///< Number of incremental GCs that have completed
+static void jsvGarbageCollectWriteBarrier(JsVar *var);
+static void jsvGarbageCollectLockBarrier(JsVar *var);
+static void jsvGarbageCollectFlatStringAllocated(JsVar *flatString);
+static void jsvGarbageCollectAbort();
+static void jsvGarbageCollectAddPause(JsSysTime time);
+#define JSV_GC_WRITE_BARRIER(v) if (jsvGCBarrier) jsvGarbageCollectWriteBarrier(v)
+#define JSV_GC_LOCK_BARRIER(v) if (jsvGCBarrier && ((v)->flags & JSV_GARBAGE_COLLECT)) jsvGarbageCollectLockBarrier(v)
+#else
+#define JSV_GC_WRITE_BARRIER(v)
+#define JSV_GC_LOCK_BARRIER(v)
+#endif
 
 // ----------------------------------------------------------------------------
 // ----------------------------------------------------------------------------
@@ -78,10 +151,10 @@ JsVarRefSigned jsvGetFirstChildSigned(const JsVar *v) {
 JsVarRef jsvGetLastChild(const JsVar *v) { return v->varData.ref.lastChild; }
 JsVarRef jsvGetNextSibling(const JsVar *v) { return v->varData.ref.nextSibling; }
 JsVarRef jsvGetPrevSibling(const JsVar *v) { return v->varData.ref.prevSibling; }
-void jsvSetFirstChild(JsVar *v, JsVarRef r) { v->varData.ref.firstChild = r; }
-void jsvSetLastChild(JsVar *v, JsVarRef r) { v->varData.ref.lastChild = r; }
-void jsvSetNextSibling(JsVar *v, JsVarRef r) { v->varData.ref.nextSibling = r; }
-void jsvSetPrevSibling(JsVar *v, JsVarRef r) { v->varData.ref.prevSibling = r; }
+void jsvSetFirstChild(JsVar *v, JsVarRef r) { v->varData.ref.firstChild = r; JSV_GC_WRITE_BARRIER(v); }
+void jsvSetLastChild(JsVar *v, JsVarRef r) { v->varData.ref.lastChild = r; JSV_GC_WRITE_BARRIER(v); }
+void jsvSetNextSibling(JsVar *v, JsVarRef r) { v->varData.ref.nextSibling = r; JSV_GC_WRITE_BARRIER(v); }
+void jsvSetPrevSibling(JsVar *v, JsVarRef r) { v->varData.ref.prevSibling = r; JSV_GC_WRITE_BARRIER(v); }
 
 JsVarRefCounter jsvGetRefs(JsVar *v) { return v->varData.ref.refs; }
 void jsvSetRefs(JsVar *v, JsVarRefCounter refs) { v->varData.ref.refs = refs; }
@@ -309,10 +382,22 @@ void jsvClearEmptyVarList() {
 }
 
 void jsvSoftInit() {
+#ifndef ESPR_NO_INCREMENTAL_GC
+  jsvGarbageCollectAbort();
+#endif
   jsvCreateEmptyVarList();
+#ifndef ESPR_NO_ARRAY_INDEX_CACHE
+  jsvArrayIndexCacheClear();
+#endif
+#ifndef ESPR_NO_MEMBER_CACHE
+  jsvObjectEpochChanged();
+#endif
 }
 
 void jsvSoftKill() {
+#ifndef ESPR_NO_INCREMENTAL_GC
+  jsvGarbageCollectAbort();
+#endif
   jsvClearEmptyVarList();
 }
 
@@ -349,28 +434,35 @@ void jsvReset() {
   jsvSoftInit();
 }
 
+#if defined(RESIZABLE_JSVARS) || defined(JSVAR_MALLOC)
+#if defined(ESPR_JIT) && defined(LINUX)
+/// Allocate memory for 'count' JsVars. JIT code is stored in flat strings, so the memory must be executable. Returns 0 on failure, like malloc
+static JsVar *jsvAllocVars(size_t count) {
+  void *vars = mmap(NULL, sizeof(JsVar) * count, PROT_EXEC | PROT_READ | PROT_WRITE,
+      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  return (vars==MAP_FAILED) ? 0 : (JsVar *)vars;
+}
+/// Free memory from jsvAllocVars
+static void jsvFreeVars(JsVar *vars, size_t count) {
+  if (vars) munmap(vars, sizeof(JsVar) * count);
+}
+#else
+#define jsvAllocVars(COUNT) ((JsVar *)malloc(sizeof(JsVar) * (COUNT)))
+#define jsvFreeVars(VARS, COUNT) free(VARS)
+#endif
+#endif
+
 void jsvInit(unsigned int size) {
 #ifdef RESIZABLE_JSVARS
   // ignore size here - we're always going to start off at our smallest size
   NOT_USED(size);
   jsVarsSize = JSVAR_BLOCK_SIZE;
   jsVarBlocks = malloc(sizeof(JsVar*)); // just 1
-#if defined(ESPR_JIT) && defined(LINUX)
-  jsVarBlocks[0] = (JsVar *)mmap(NULL, sizeof(JsVar) * JSVAR_BLOCK_SIZE, PROT_EXEC | PROT_READ | PROT_WRITE,
-      MAP_PRIVATE | MAP_ANONYMOUS, 0, 0);
-#else
-  jsVarBlocks[0] = malloc(sizeof(JsVar) * JSVAR_BLOCK_SIZE);
-#endif
+  jsVarBlocks[0] = jsvAllocVars(JSVAR_BLOCK_SIZE);
 #elif defined(JSVAR_MALLOC)
   jsVarsSize = JSVAR_CACHE_SIZE;
   if (size) jsVarsSize = size;
-#if defined(ESPR_JIT) && defined(LINUX)
-  if (!jsVars)
-    jsVars = (JsVar *)mmap(NULL, sizeof(JsVar) * jsVarsSize, PROT_EXEC | PROT_READ | PROT_WRITE,
-        MAP_PRIVATE | MAP_ANONYMOUS, 0, 0);
-#else
-  if(!jsVars) jsVars = (JsVar *)malloc(sizeof(JsVar) * jsVarsSize);
-#endif
+  if (!jsVars) jsVars = jsvAllocVars(jsVarsSize);
 #else
   assert(size==JSVAR_CACHE_SIZE);
 #endif
@@ -381,18 +473,13 @@ void jsvInit(unsigned int size) {
 void jsvKill() {
 #ifdef RESIZABLE_JSVARS
   unsigned int i;
-  for (i=0;i<jsVarsSize>>JSVAR_BLOCK_SHIFT;i++) {
-#if defined(ESPR_JIT) && defined(LINUX)
-    munmap(jsVarBlocks[i], sizeof(JsVar) * JSVAR_BLOCK_SIZE);
-#else
-    free(jsVarBlocks[i]);
-#endif
-  }
+  for (i=0;i<jsVarsSize>>JSVAR_BLOCK_SHIFT;i++)
+    jsvFreeVars(jsVarBlocks[i], JSVAR_BLOCK_SIZE);
   free(jsVarBlocks);
   jsVarBlocks = 0;
   jsVarsSize = 0;
 #elif defined(JSVAR_MALLOC)
-  free(jsVars);
+  jsvFreeVars(jsVars, jsVarsSize);
   jsVars = NULL;
   jsVarsSize = 0;
 #endif
@@ -433,7 +520,7 @@ unsigned int jsvGetMemoryTotal() {
   return jsVarsSize;
 }
 
-/// Try and allocate more memory - only works if RESIZABLE_JSVARS is defined
+/// Try and allocate more memory - only works if RESIZABLE_JSVARS is defined. If we can't get it all, we use as much as we got
 void jsvSetMemoryTotal(unsigned int jsNewVarCount) {
 #ifdef RESIZABLE_JSVARS
   assert(!isMemoryBusy);
@@ -443,13 +530,21 @@ void jsvSetMemoryTotal(unsigned int jsNewVarCount) {
   unsigned int oldSize = jsVarsSize;
   unsigned int oldBlockCount = jsVarsSize >> JSVAR_BLOCK_SHIFT;
   unsigned int newBlockCount = (jsNewVarCount+JSVAR_BLOCK_SIZE-1) >> JSVAR_BLOCK_SHIFT;
-  jsVarsSize = newBlockCount << JSVAR_BLOCK_SHIFT;
   // resize block table
-  jsVarBlocks = realloc(jsVarBlocks, sizeof(JsVar*)*newBlockCount);
+  JsVar **newBlocks = realloc(jsVarBlocks, sizeof(JsVar*)*newBlockCount);
+  if (newBlocks) jsVarBlocks = newBlocks;
+  else newBlockCount = oldBlockCount;
   // allocate more blocks
   unsigned int i;
-  for (i=oldBlockCount;i<newBlockCount;i++)
-    jsVarBlocks[i] = malloc(sizeof(JsVar) * JSVAR_BLOCK_SIZE);
+  for (i=oldBlockCount;i<newBlockCount;i++) {
+    jsVarBlocks[i] = jsvAllocVars(JSVAR_BLOCK_SIZE);
+    if (!jsVarBlocks[i]) break; // out of memory
+  }
+  jsVarsSize = i << JSVAR_BLOCK_SHIFT;
+  if (jsVarsSize == oldSize) { // we couldn't get any more
+    isMemoryBusy = MEM_NOT_BUSY;
+    return;
+  }
   /** and now reset all the newly allocated vars. We know jsVarFirstEmpty
    * is 0 (because jsiFreeMoreMemory returned 0) so we can just assign it.  */
   assert(!jsVarFirstEmpty);
@@ -650,10 +745,14 @@ JsVar *jsvNewWithFlags(JsVarFlags flags) {
   }
   /* We couldn't claim any more memory by Garbage collecting... */
 #ifdef RESIZABLE_JSVARS
+  unsigned int oldSize = jsVarsSize;
   jsvSetMemoryTotal(jsVarsSize*2);
-  return jsvNewWithFlags(flags);
+  if (jsVarsSize > oldSize)
+    return jsvNewWithFlags(flags);
+  // we couldn't allocate any more either
 #else
   // On a micro, we're screwed.
+#endif
 #ifndef SAVE_ON_FLASH
   if (!(jsErrorFlags & JSERR_MEMORY)) { // try and print a stack trace (if not already out of memory) - we should be able to do this without allocation
     jsErrorFlags |= JSERR_MEMORY;
@@ -664,7 +763,6 @@ JsVar *jsvNewWithFlags(JsVarFlags flags) {
   jsErrorFlags |= JSERR_MEMORY;
   jspSetInterrupted(true);
   return 0;
-#endif
 }
 
 static void jsvFreePtrInternal(JsVar *var) {
@@ -776,7 +874,15 @@ ALWAYS_INLINE void jsvFreePtr(JsVar *var) {
   /* NO ELSE HERE - because jsvIsNewChild stuff can be for Names, which
     can be ints or strings */
 
+#ifndef ESPR_NO_MEMBER_CACHE
+  if (jsvIsObject(var))
+    jsvObjectEpochCheck(var);
+#endif
   if (jsvHasChildren(var)) {
+#ifndef ESPR_NO_ARRAY_INDEX_CACHE
+    if (jsvArrayIndexCacheArray == jsvGetRef(var))
+      jsvArrayIndexCacheClear();
+#endif
     JsVarRef childref = jsvGetLastChild(var);
 #ifdef CLEAR_MEMORY_ON_FREE
     jsvSetFirstChild(var, 0);
@@ -832,6 +938,7 @@ JsVar *jsvLock(JsVarRef ref) {
   //var->locks++;
   if ((var->flags & JSV_LOCK_MASK)!=JSV_LOCK_MASK) // if we hit the max amount of locks, don't exceed it (see https://github.com/espruino/Espruino/issues/2616)
     var->flags += JSV_LOCK_ONE;
+  JSV_GC_LOCK_BARRIER(var);
   return var;
 }
 
@@ -846,6 +953,7 @@ JsVar *jsvLockAgain(JsVar *var) {
   assert(var);
   if ((var->flags & JSV_LOCK_MASK)!=JSV_LOCK_MASK) // if we hit the max amount of locks, don't exceed it (see https://github.com/espruino/Espruino/issues/2616)
     var->flags += JSV_LOCK_ONE;
+  JSV_GC_LOCK_BARRIER(var);
   return var;
 }
 
@@ -1037,6 +1145,9 @@ JsVar *jsvNewFlatStringOfLength(unsigned int byteLength) {
     jsvGarbageCollect();
   };
   if (!flatString) return 0;
+#ifndef ESPR_NO_INCREMENTAL_GC
+  jsvGarbageCollectFlatStringAllocated(flatString);
+#endif
   /* We now have the string! All that's left is to clear it */
   // clear data
   memset((char*)&flatString[1], 0, sizeof(JsVar)*(requiredBlocks-1));
@@ -1749,6 +1860,22 @@ size_t jsvGetFlatStringBlocks(const JsVar *v) {
   return ((size_t)v->varData.integer+sizeof(JsVar)-1) / sizeof(JsVar);
 }
 
+void jsvShrinkFlatString(JsVar *v, size_t length) {
+  assert(jsvIsFlatString(v));
+  assert(length <= (size_t)v->varData.integer);
+  size_t oldBlocks = jsvGetFlatStringBlocks(v);
+  v->varData.integer = (JsVarInt)length;
+  size_t newBlocks = jsvGetFlatStringBlocks(v);
+  JsVarRef ref = jsvGetRef(v);
+  // free from the end, so the free list ends up in kind of the right order
+  while (newBlocks < oldBlocks) {
+    JsVar *p = jsvGetAddressOf((JsVarRef)(ref+oldBlocks));
+    p->flags = JSV_UNUSED; // this block contained string data, so clear it before the locks are checked
+    jsvFreePtrInternal(p);
+    oldBlocks--;
+  }
+}
+
 char *jsvGetFlatStringPointer(JsVar *v) {
   assert(jsvIsFlatString(v));
   if (!jsvIsFlatString(v)) return 0;
@@ -2761,6 +2888,247 @@ int jsvCompareInteger(JsVar *va, JsVar *vb) {
     return 0;
 }
 
+/// Compare the first 4 bytes of two strings
+static ALWAYS_INLINE bool jsvFastPrefixEqual(const char *a, const char *b) {
+#ifdef ESPR_NO_UNALIGNED_READS
+  if (sizeof(JsVar)&3) // JsVars aren't 32 bit aligned, so we can't do a word compare
+    return a[0]==b[0] && a[1]==b[1] && a[2]==b[2] && a[3]==b[3];
+#endif
+  return *(const int*)a == *(const int*)b;
+}
+
+#ifndef ESPR_NO_OBJECT_INDEX
+/* Objects with a lot of keys get a hidden hash index of their (non-hidden, String)
+ * keys so that jsvFindChildFromString/jsvFindChildFromVar don't have to walk the
+ * whole list. The index is a flat string that is the value of the Object's *first*
+ * child (JSV_OBJECT_INDEX_NAME) so we can find it immediately. It contains the
+ * number of keys followed by a power of 2 sized, linear probed table of the refs
+ * of the key names. It doesn't reference the names, so jsvAddName/jsvRemoveChild
+ * keep it up to date, and jsvDefragment marks it as invalid so it gets rebuilt on
+ * the next lookup.
+ *
+ * If we couldn't allocate an index, JSV_OBJECT_INDEX_NAME is given an integer
+ * value instead so that we don't keep trying. */
+#define JSV_OBJECT_INDEX_MIN_CHILDREN 32 ///< Build an index when a lookup has to step over this many children
+#define JSV_OBJECT_INDEX_INVALID 0xFFFFFFFF ///< 'count' value that means the index must be rebuilt before use
+
+typedef struct {
+  uint32_t count; ///< Number of keys in table (or JSV_OBJECT_INDEX_INVALID)
+  JsVarRef table[]; ///< Refs of the key names (0 = empty slot)
+} JsvObjectIndex;
+
+/// Is this the name of an Object's index?
+static bool jsvIsObjectIndexName(JsVar *v) {
+  return jsvIsName(v) && jsvIsString(v) && !jsvGetLastChild(v) &&
+         jsvGetCharactersInVar(v)==4 && jsvFastPrefixEqual(v->varData.str, JSV_OBJECT_INDEX_NAME);
+}
+
+/// Get the name of an Object's index if it has one (not locked)
+static JsVar *jsvObjectIndexGetName(const JsVar *parent) {
+  JsVarRef ref = jsvGetFirstChild(parent);
+  if (!ref) return 0;
+  JsVar *name = jsvGetAddressOf(ref);
+  return jsvIsObjectIndexName(name) ? name : 0;
+}
+
+/// Get a pointer to the index data if there is one, and set 'size' to the number of slots in the table
+static JsvObjectIndex *jsvObjectIndexGetData(JsVar *indexName, unsigned int *size) {
+  if (!indexName || jsvIsNameWithValue(indexName) || !jsvGetFirstChild(indexName)) return 0;
+  JsVar *flatString = jsvGetAddressOf(jsvGetFirstChild(indexName));
+  if (!jsvIsFlatString(flatString)) return 0;
+  *size = (unsigned int)((jsvGetCharactersInVar(flatString) - sizeof(uint32_t)) / sizeof(JsVarRef));
+  return (JsvObjectIndex*)jsvGetFlatStringPointer(flatString);
+}
+
+/// FNV-1a hash of a string (up to the first 0, as with jsvIsStringEqual)
+static uint32_t jsvObjectIndexHashString(const char *str) {
+  uint32_t hash = 2166136261u;
+  while (*str)
+    hash = (hash ^ (unsigned char)*(str++)) * 16777619u;
+  return hash;
+}
+
+/// As jsvObjectIndexHashString, but for a String var. Also returns the first character
+static uint32_t jsvObjectIndexHashVar(JsVar *var, char *firstChar) {
+  uint32_t hash = 2166136261u;
+  JsvStringIterator it;
+  jsvStringIteratorNew(&it, var, 0);
+  char ch = jsvStringIteratorGetCharAndNext(&it);
+  *firstChar = ch;
+  while (ch) {
+    hash = (hash ^ (unsigned char)ch) * 16777619u;
+    ch = jsvStringIteratorGetCharAndNext(&it);
+  }
+  jsvStringIteratorFree(&it);
+  return hash;
+}
+
+static void jsvObjectIndexInsert(JsvObjectIndex *index, unsigned int size, JsVar *name, uint32_t hash) {
+  unsigned int i = hash & (size-1);
+  while (index->table[i])
+    i = (i+1) & (size-1);
+  index->table[i] = jsvGetRef(name);
+  index->count++;
+}
+
+static void jsvObjectIndexRemove(JsvObjectIndex *index, unsigned int size, JsVar *name, uint32_t hash) {
+  JsVarRef ref = jsvGetRef(name);
+  unsigned int mask = size-1;
+  unsigned int i = hash & mask;
+  while (index->table[i] != ref) {
+    if (!index->table[i]) return; // not in the index
+    i = (i+1) & mask;
+  }
+  /* Linear probing, so we can't just leave a hole - move back any entries
+   * after this one that can't be found any more */
+  unsigned int j = i;
+  while (true) {
+    j = (j+1) & mask;
+    if (!index->table[j]) break;
+    char ch;
+    unsigned int k = jsvObjectIndexHashVar(jsvGetAddressOf(index->table[j]), &ch) & mask;
+    // if k is (cyclically) in the range (i,j], this entry is still reachable
+    if ((i<j) ? (i<k && k<=j) : (i<k || k<=j)) continue;
+    index->table[i] = index->table[j];
+    i = j;
+  }
+  index->table[i] = 0;
+  index->count--;
+}
+
+/// Find a name in the index (not locked). Compares with 'nameVar' if set, or 'name' if not
+static JsVar *jsvObjectIndexFind(JsvObjectIndex *index, unsigned int size, uint32_t hash, const char *name, JsVar *nameVar) {
+  unsigned int i = hash & (size-1);
+  while (index->table[i]) {
+    JsVar *child = jsvGetAddressOf(index->table[i]);
+    if (nameVar ? jsvIsBasicVarEqual(child, nameVar) : jsvIsStringEqual(child, name))
+      return child;
+    i = (i+1) & (size-1);
+  }
+  return 0;
+}
+
+/// Build (or rebuild) the index for an Object. This allocates, so could cause a GC
+static NO_INLINE void jsvObjectIndexBuild(JsVar *parent) {
+  if (isMemoryBusy || jshIsInInterrupt()) return;
+  JsVar *indexName = jsvObjectIndexGetName(parent);
+  if (indexName && jsvIsNameWithValue(indexName)) return; // we failed to allocate before
+  unsigned int size;
+  JsvObjectIndex *oldIndex = jsvObjectIndexGetData(indexName, &size);
+  if (oldIndex && oldIndex->count!=JSV_OBJECT_INDEX_INVALID) return; // already valid (the name just isn't indexed)
+  unsigned int keys = 0;
+  JsVarRef childref = jsvGetFirstChild(parent);
+  while (childref) {
+    JsVar *child = jsvGetAddressOf(childref);
+    if (jsvIsString(child)) keys++;
+    childref = jsvGetNextSibling(child);
+  }
+  size = 16;
+  while (size < keys*2) size <<= 1;
+  JsVar *flatString = jsvNewFlatStringOfLength((unsigned int)(sizeof(uint32_t) + size*sizeof(JsVarRef)));
+  if (!indexName) {
+    indexName = jsvNewNameFromString(JSV_OBJECT_INDEX_NAME);
+    if (!indexName) {
+      jsvUnLock(flatString);
+      return;
+    }
+    // Add it right at the start of the list so we can find it quickly
+    jsvRef(indexName);
+    JsVar *first = jsvLock(jsvGetFirstChild(parent));
+    jsvSetPrevSibling(first, jsvGetRef(indexName));
+    jsvSetNextSibling(indexName, jsvGetRef(first));
+    jsvSetFirstChild(parent, jsvGetRef(indexName));
+    jsvUnLock2(first, indexName);
+  }
+  if (!flatString) {
+    // Out of memory - set an integer value so we know not to try again
+    jsvSetValueOfName(indexName, 0);
+    indexName->flags = (indexName->flags & (JsVarFlags)~JSV_VARTYPEMASK) | (JSV_NAME_STRING_INT_0 + jsvGetCharactersInVar(indexName));
+    return;
+  }
+  jsvSetValueOfName(indexName, flatString);
+  JsvObjectIndex *index = (JsvObjectIndex*)jsvGetFlatStringPointer(flatString); // flat strings are zeroed when allocated
+  childref = jsvGetFirstChild(parent);
+  while (childref) {
+    JsVar *child = jsvGetAddressOf(childref);
+    if (jsvIsString(child)) {
+      char ch;
+      uint32_t hash = jsvObjectIndexHashVar(child, &ch);
+      if (ch!=JS_HIDDEN_CHAR)
+        jsvObjectIndexInsert(index, size, child, hash);
+    }
+    childref = jsvGetNextSibling(child);
+  }
+  jsvUnLock(flatString);
+}
+
+/// Called when a name has been added to an Object
+static void jsvObjectIndexAdded(JsVar *parent, JsVar *name) {
+  unsigned int size;
+  JsvObjectIndex *index = jsvObjectIndexGetData(jsvObjectIndexGetName(parent), &size);
+  if (!index || index->count==JSV_OBJECT_INDEX_INVALID || !jsvIsString(name)) return;
+  char ch;
+  uint32_t hash = jsvObjectIndexHashVar(name, &ch);
+  if (ch==JS_HIDDEN_CHAR) return;
+  if ((index->count+1)*4 > size*3) // too full - rebuild a bigger one on the next lookup
+    index->count = JSV_OBJECT_INDEX_INVALID;
+  else
+    jsvObjectIndexInsert(index, size, name, hash);
+}
+
+/// Called when a name is about to be removed from an Object
+static void jsvObjectIndexRemoved(JsVar *parent, JsVar *name) {
+  unsigned int size;
+  JsvObjectIndex *index = jsvObjectIndexGetData(jsvObjectIndexGetName(parent), &size);
+  if (!index || index->count==JSV_OBJECT_INDEX_INVALID || !jsvIsString(name)) return;
+  char ch;
+  uint32_t hash = jsvObjectIndexHashVar(name, &ch);
+  if (ch!=JS_HIDDEN_CHAR)
+    jsvObjectIndexRemove(index, size, name, hash);
+}
+
+/** Find a child of an Object using its index. Returns true if the index
+ * could be used, in which case *result is set to the (locked) child or 0. */
+static bool jsvObjectIndexFindChild(JsVar *parent, const char *name, JsVar *nameVar, JsVar **result) {
+  JsVar *indexName = jsvObjectIndexGetName(parent);
+  if (!indexName) return false;
+  unsigned int size;
+  JsvObjectIndex *index = jsvObjectIndexGetData(indexName, &size);
+  if (!index) return false;
+  uint32_t hash;
+  if (nameVar) {
+    char ch;
+    hash = jsvObjectIndexHashVar(nameVar, &ch);
+    if (ch==JS_HIDDEN_CHAR) return false; // hidden names aren't indexed
+  } else {
+    if (name[0]==JS_HIDDEN_CHAR) return false;
+    hash = jsvObjectIndexHashString(name);
+  }
+  if (index->count==JSV_OBJECT_INDEX_INVALID) {
+    jsvObjectIndexBuild(parent);
+    index = jsvObjectIndexGetData(jsvObjectIndexGetName(parent), &size);
+    if (!index) return false;
+  }
+  JsVar *child = jsvObjectIndexFind(index, size, hash, name, nameVar);
+  *result = child ? jsvLockAgain(child) : 0;
+  return true;
+}
+
+/// Mark every Object index as invalid (because refs are about to change) so they get rebuilt when next used
+static void jsvObjectIndexInvalidateAll() {
+  for (JsVarRef i=1;i<=jsVarsSize;i++) {
+    JsVar *v = _jsvGetAddressOf(i);
+    if (jsvIsFlatString(v)) {
+      i = (JsVarRef)(i+jsvGetFlatStringBlocks(v)); // skip forward
+    } else if (jsvIsObjectIndexName(v)) {
+      unsigned int size;
+      JsvObjectIndex *index = jsvObjectIndexGetData(v, &size);
+      if (index) index->count = JSV_OBJECT_INDEX_INVALID;
+    }
+  }
+}
+#endif // ESPR_NO_OBJECT_INDEX
+
 /** Copy only a name, not what it points to. ALTHOUGH the link to what it points to is maintained unless linkChildren=false
     If keepAsName==false, this will be converted into a normal variable */
 JsVar *jsvCopyNameOnly(JsVar *src, bool linkChildren, bool keepAsName) {
@@ -2902,6 +3270,13 @@ JsVar *jsvCopy(JsVar *src, bool copyChildren) {
       vr = jsvGetFirstChild(src);
       while (vr) {
         JsVar *name = jsvLock(vr);
+#ifndef ESPR_NO_OBJECT_INDEX
+        if (jsvIsObjectIndexName(name)) { // the index refers to src's names, so don't copy it
+          vr = jsvGetNextSibling(name);
+          jsvUnLock(name);
+          continue;
+        }
+#endif
         JsVar *child = jsvCopyNameOnly(name, true/*link children*/, true/*keep as name*/); // NO DEEP COPY!
         if (child) { // could have been out of memory
           jsvAddName(dst, child);
@@ -2971,6 +3346,15 @@ void jsvAddName(JsVar *parent, JsVar *namedChild) {
     jsvSetFirstChild(parent, r);
     jsvSetLastChild(parent, r);
   }
+#ifndef ESPR_NO_OBJECT_INDEX
+  if (jsvIsObject(parent))
+    jsvObjectIndexAdded(parent, namedChild);
+#endif
+#ifndef ESPR_NO_MEMBER_CACHE
+  if (jsvIsObject(parent))
+    jsvObjectEpochCheck(parent);
+  jsvObjectEpochCheckName(namedChild, true);
+#endif
 }
 
 JsVar *jsvAddNamedChild(JsVar *parent, JsVar *value, const char *name) {
@@ -2993,6 +3377,9 @@ JsVar *jsvSetValueOfName(JsVar *name, JsVar *src) {
   /* Existing child may be null in the case of Z = 0 where
    * we create 'Z' and pass it down to '=' to have the value
    * filled in (or it may be undefined). */
+#ifndef ESPR_NO_MEMBER_CACHE
+  jsvObjectEpochCheckName(name, false);
+#endif
   if (jsvIsNameWithValue(name)) {
     if (jsvIsString(name))
       name->flags = (name->flags & (JsVarFlags)~JSV_VARTYPEMASK) | (JSV_NAME_STRING_0 + jsvGetCharactersInVar(name));
@@ -3028,15 +3415,6 @@ JsVar *jsvSetValueOfName(JsVar *name, JsVar *src) {
   return name;
 }
 
-/// Compare the first 4 bytes of two strings
-static ALWAYS_INLINE bool jsvFastPrefixEqual(const char *a, const char *b) {
-#ifdef ESPR_NO_UNALIGNED_READS
-  if (sizeof(JsVar)&3) // JsVars aren't 32 bit aligned, so we can't do a word compare
-    return a[0]==b[0] && a[1]==b[1] && a[2]==b[2] && a[3]==b[3];
-#endif
-  return *(const int*)a == *(const int*)b;
-}
-
 JsVar *jsvFindChildFromString(JsVar *parent, const char *name) {
   /* Pull out first 4 bytes, and ensure that everything
    * is 0 padded so that we can do a nice speedy check. */
@@ -3063,16 +3441,25 @@ JsVar *jsvFindChildFromString(JsVar *parent, const char *name) {
 
   assert(jsvHasChildren(parent));
   JsVarRef childref = jsvGetFirstChild(parent);
+  JsVar *found = 0;
+#ifndef ESPR_NO_OBJECT_INDEX
+  if (childref && jsvIsObject(parent) && jsvObjectIndexFindChild(parent, name, NULL, &found))
+    return found;
+  unsigned int steps = 0;
+#endif
   if (!superFastCheck) { // more than 4 chars so we MUST use stringequal
     while (childref) {
       // Don't Lock here, just use GetAddressOf - to try and speed up the finding
       JsVar *child = jsvGetAddressOf(childref);
       if (jsvFastPrefixEqual(fastCheck, child->varData.str) && // speedy check of first 4 bytes
           jsvIsStringEqual(child, name)) {
-        // found it! unlock parent but leave child locked
-        return jsvLockAgain(child);
+        found = child;
+        break;
       }
       childref = jsvGetNextSibling(child);
+#ifndef ESPR_NO_OBJECT_INDEX
+      steps++;
+#endif
     }
   } else { // 4 or less chars, so if 4 chars match, there is no StringExt + length matches, then we're good without jsvIsStringEqual
     size_t charsInName = 0;
@@ -3083,13 +3470,23 @@ JsVar *jsvFindChildFromString(JsVar *parent, const char *name) {
       if (jsvFastPrefixEqual(fastCheck, child->varData.str) &&
           !child->varData.ref.lastChild &&
           jsvGetCharactersInVar(child)==charsInName) { // no extra stringexts - so it really is that small
-        // found it! unlock parent but leave child locked
-        return jsvLockAgain(child);
+        found = child;
+        break;
       }
       childref = jsvGetNextSibling(child);
+#ifndef ESPR_NO_OBJECT_INDEX
+      steps++;
+#endif
     }
   }
-  return 0;
+  // found it! leave child locked
+  if (found) found = jsvLockAgain(found);
+#ifndef ESPR_NO_OBJECT_INDEX
+  // if we had to look through a lot of children, make an index so next time is faster
+  if (steps >= JSV_OBJECT_INDEX_MIN_CHILDREN && jsvIsObject(parent))
+    jsvObjectIndexBuild(parent);
+#endif
+  return found;
 }
 
 JsVar *jsvFindOrAddChildFromString(JsVar *parent, const char *name) {
@@ -3154,6 +3551,23 @@ JsVar *jsvAsName(JsVar *var) {
 JsVar *jsvFindChildFromVar(JsVar *parent, JsVar *childName, bool addIfNotFound) {
   JsVar *child;
   JsVarRef childref = jsvGetFirstChild(parent);
+#ifndef ESPR_NO_ARRAY_INDEX_CACHE
+  /* Array elements are sorted by index, so use jsvGetArrayIndex (which can
+   * search from either end, or the last element found) */
+  if (jsvIsArray(parent) && jsvIsInt(childName) && !jsvIsName(childName)) {
+    child = jsvGetArrayIndex(parent, childName->varData.integer);
+    if (child || !addIfNotFound) return child;
+    childref = 0; // not found - skip the search and add it
+  }
+#endif
+#ifndef ESPR_NO_OBJECT_INDEX
+  bool useIndex = childref && jsvIsObject(parent) && jsvIsString(childName);
+  unsigned int steps = 0;
+  if (useIndex && jsvObjectIndexFindChild(parent, NULL, childName, &child)) {
+    if (child || !addIfNotFound) return child;
+    childref = 0; // not found - skip the search and add it
+  }
+#endif
 
   // TODO: could split this into separate loops looking for Numeric/String
 
@@ -3165,7 +3579,15 @@ JsVar *jsvFindChildFromVar(JsVar *parent, JsVar *childName, bool addIfNotFound)
     }
     childref = jsvGetNextSibling(child);
     jsvUnLock(child);
+#ifndef ESPR_NO_OBJECT_INDEX
+    steps++;
+#endif
   }
+#ifndef ESPR_NO_OBJECT_INDEX
+  // if we had to look through a lot of children, make an index so next time is faster
+  if (useIndex && steps >= JSV_OBJECT_INDEX_MIN_CHILDREN)
+    jsvObjectIndexBuild(parent);
+#endif
 
   child = 0;
   if (addIfNotFound && childName) {
@@ -3183,6 +3605,18 @@ void jsvRemoveChild(JsVar *parent, JsVar *child) {
 #endif
   JsVarRef childref = jsvGetRef(child);
   bool wasChild = false;
+#ifndef ESPR_NO_ARRAY_INDEX_CACHE
+  if (jsvArrayIndexCacheChild == childref)
+    jsvArrayIndexCacheClear();
+#endif
+#ifndef ESPR_NO_OBJECT_INDEX
+  if (jsvIsObject(parent))
+    jsvObjectIndexRemoved(parent, child);
+#endif
+#ifndef ESPR_NO_MEMBER_CACHE
+  if (jsvIsObject(parent))
+    jsvObjectEpochCheck(parent);
+#endif
   // unlink from parent
   if (jsvGetFirstChild(parent) == childref) {
     jsvSetFirstChild(parent, jsvGetNextSibling(child));
@@ -3222,6 +3656,15 @@ void jsvRemoveChild(JsVar *parent, JsVar *child) {
   jsvSetNextSibling(child, 0);
   if (wasChild)
     jsvUnRef(child);
+#ifndef ESPR_NO_OBJECT_INDEX
+  // if only the index is left, remove that too so the Object is empty
+  if (wasChild && jsvIsObject(parent) && jsvGetFirstChild(parent) &&
+      jsvGetFirstChild(parent)==jsvGetLastChild(parent)) {
+    JsVar *indexName = jsvObjectIndexGetName(parent);
+    if (indexName)
+      jsvRemoveChildAndUnLock(parent, jsvLockAgain(indexName));
+  }
+#endif
 }
 
 void jsvRemoveChildAndUnLock(JsVar *parent, JsVar *child) {
@@ -3500,6 +3943,12 @@ size_t jsvCountJsVarsUsed(JsVar *v) {
   return c;
 }
 
+#ifndef ESPR_NO_ARRAY_INDEX_CACHE
+#define JSV_ARRAY_INDEX_FOUND(CHILD) { jsvArrayIndexCacheArray = jsvGetRef((JsVar*)arr); jsvArrayIndexCacheChild = jsvGetRef(CHILD); return CHILD; }
+#else
+#define JSV_ARRAY_INDEX_FOUND(CHILD) return CHILD;
+#endif
+
 JsVar *jsvGetArrayIndex(const JsVar *arr, JsVarInt index) {
   JsVarRef childref = jsvGetLastChild(arr);
   JsVarInt lastArrayIndex = 0;
@@ -3510,7 +3959,7 @@ JsVar *jsvGetArrayIndex(const JsVar *arr, JsVarInt index) {
       lastArrayIndex = child->varData.integer;
       // it was the last element... sorted!
       if (lastArrayIndex == index) {
-        return child;
+        JSV_ARRAY_INDEX_FOUND(child);
       }
       jsvUnLock(child);
       break;
@@ -3522,6 +3971,32 @@ JsVar *jsvGetArrayIndex(const JsVar *arr, JsVarInt index) {
   // it's not in this array - don't search the whole lot...
   if (index > lastArrayIndex)
     return 0;
+#ifndef ESPR_NO_ARRAY_INDEX_CACHE
+  /* If the element we found last time is closer to the one we want than
+   * either end of the array, search from there instead */
+  if (jsvArrayIndexCacheArray == jsvGetRef((JsVar*)arr)) {
+    JsVar *cached = jsvGetAddressOf(jsvArrayIndexCacheChild);
+    JsVarInt distance = index - cached->varData.integer;
+    bool forwards = distance>0;
+    if (!forwards) distance = -distance;
+    if (distance < index && distance < lastArrayIndex-index) {
+      JsVarRef ref = jsvArrayIndexCacheChild;
+      while (ref) {
+        JsVar *child = jsvGetAddressOf(ref);
+        if (jsvIsInt(child)) {
+          if (child->varData.integer == index) {
+            child = jsvLockAgain(child);
+            JSV_ARRAY_INDEX_FOUND(child);
+          }
+          // gone past where it should be - not found (we fall back to a full search below in case the array wasn't sorted)
+          if (forwards ? (child->varData.integer > index) : (child->varData.integer < index))
+            break;
+        }
+        ref = forwards ? jsvGetNextSibling(child) : jsvGetPrevSibling(child);
+      }
+    }
+  }
+#endif
   // otherwise is it more than halfway through?
   if (index > lastArrayIndex/2) {
     // it's in the final half of the array (probably) - search backwards
@@ -3530,7 +4005,7 @@ JsVar *jsvGetArrayIndex(const JsVar *arr, JsVarInt index) {
 
       assert(jsvIsInt(child));
       if (child->varData.integer == index) {
-        return child;
+        JSV_ARRAY_INDEX_FOUND(child);
       }
       childref = jsvGetPrevSibling(child);
       jsvUnLock(child);
@@ -3543,7 +4018,7 @@ JsVar *jsvGetArrayIndex(const JsVar *arr, JsVarInt index) {
 
       assert(jsvIsInt(child));
       if (child->varData.integer == index) {
-        return child;
+        JSV_ARRAY_INDEX_FOUND(child);
       }
       childref = jsvGetNextSibling(child);
       jsvUnLock(child);
@@ -3551,6 +4026,7 @@ JsVar *jsvGetArrayIndex(const JsVar *arr, JsVarInt index) {
   }
   return 0; // undefined
 }
+#undef JSV_ARRAY_INDEX_FOUND
 
 JsVar *jsvGetArrayItem(const JsVar *arr, JsVarInt index) {
   return jsvSkipNameAndUnLock(jsvGetArrayIndex(arr,index));
@@ -3741,6 +4217,10 @@ JsVar *jsvArrayPopFirst(JsVar *arr) {
   assert(jsvIsArray(arr));
   if (jsvGetFirstChild(arr)) {
     JsVar *child = jsvLock(jsvGetFirstChild(arr));
+#ifndef ESPR_NO_ARRAY_INDEX_CACHE
+    if (jsvArrayIndexCacheChild == jsvGetRef(child))
+      jsvArrayIndexCacheClear();
+#endif
     if (jsvGetFirstChild(arr) == jsvGetLastChild(arr))
       jsvSetLastChild(arr, 0); // if 1 item in array
     jsvSetFirstChild(arr, jsvGetNextSibling(child)); // unlink from end of array
@@ -4256,47 +4736,115 @@ void jsvTrace(JsVar *var, int indent) {
 }
 
 
-/** Recursively mark the variable. Return false if it fails due to stack. */
-static bool jsvGarbageCollectMarkUsed(JsVar *var) {
-  var->flags &= (JsVarFlags)~JSV_GARBAGE_COLLECT;
-  JsVarRef child;
-  JsVar *childVar;
+/// Push a var onto the mark stack, or note that we'll have to rescan memory if it's full
+static void jsvGarbageCollectPush(JsVarRef ref) {
+  if (jsvGCMarkStackLen < JSV_GC_MARK_STACK_SIZE)
+    jsvGCMarkStack[jsvGCMarkStackLen++] = ref;
+  else
+    jsvGCMarkStackOverflow = true;
+}
 
+/// If this var isn't marked, mark it and push it so its children get marked too
+static void jsvGarbageCollectMarkRef(JsVarRef ref) {
+  if (!ref) return;
+  JsVar *var = jsvGetAddressOf(ref);
+  if (var->flags & JSV_GARBAGE_COLLECT) {
+    var->flags &= (JsVarFlags)~JSV_GARBAGE_COLLECT;
+    jsvGarbageCollectPush(ref);
+  }
+}
+
+/// Mark everything this var links to. Returns the amount of vars looked at
+static unsigned int jsvGarbageCollectMarkChildren(JsVar *var) {
+  unsigned int count = 1;
   if (jsvHasStringExt(var)) {
     // non-recursively scan strings
-    child = jsvGetLastChild(var);
+    JsVarRef child = jsvGetLastChild(var);
     while (child) {
-      childVar = jsvGetAddressOf(child);
+      JsVar *childVar = jsvGetAddressOf(child);
       childVar->flags &= (JsVarFlags)~JSV_GARBAGE_COLLECT;
       child = jsvGetLastChild(childVar);
+      count++;
     }
   }
+  /* Rather than marking all of an object's children at once (which could
+   * overflow the stack), each child marks the next one. Push that first so
+   * we go down into the child's value before moving along the list, which
+   * keeps the stack small */
+  if (jsvIsName(var) && !jsvIsArrayBufferName(var))
+    jsvGarbageCollectMarkRef(jsvGetNextSibling(var));
   // intentionally no else
-  if (jsvHasSingleChild(var)) {
-    if (jsvGetFirstChild(var)) {
-      childVar = jsvGetAddressOf(jsvGetFirstChild(var));
-      if (childVar->flags & JSV_GARBAGE_COLLECT)
-        if (!jsvGarbageCollectMarkUsed(childVar)) return false;
-    }
-  } else if (jsvHasChildren(var)) {
-    if (jsuGetFreeStack() < 256) return false;
+  if (jsvHasSingleChild(var) || jsvHasChildren(var))
+    jsvGarbageCollectMarkRef(jsvGetFirstChild(var));
+  return count;
+}
 
-    child = jsvGetFirstChild(var);
-    while (child) {
-      childVar = jsvGetAddressOf(child);
-      if (childVar->flags & JSV_GARBAGE_COLLECT)
-        if (!jsvGarbageCollectMarkUsed(childVar)) return false;
-      child = jsvGetNextSibling(childVar);
+/// Pop a var off the mark stack and mark its children. Returns the amount of vars looked at
+static unsigned int jsvGarbageCollectMarkPop() {
+  JsVar *var = jsvGetAddressOf(jsvGCMarkStack[--jsvGCMarkStackLen]);
+  if ((var->flags&JSV_VARTYPEMASK) == JSV_UNUSED) return 1; // freed since
+  var->flags &= (JsVarFlags)~JSV_GARBAGE_COLLECT;
+  return jsvGarbageCollectMarkChildren(var);
+}
+
+/** Mark everything reachable from the vars on the mark stack, and from any
+ * locked vars if markLocked is set. We never recurse - if the mark stack
+ * overflows we search memory for marked vars that link to unmarked ones and
+ * carry on from there, so however deep the data structures are this always
+ * completes with a fixed amount of stack. */
+static void jsvGarbageCollectMarkAll(bool markLocked) {
+  while (jsvGCMarkStackLen) jsvGarbageCollectMarkPop();
+  if (!markLocked && !jsvGCMarkStackOverflow) return;
+  bool rescan = jsvGCMarkStackOverflow;
+  do {
+    jsvGCMarkStackOverflow = false;
+    for (JsVarRef i=1;i<=jsVarsSize;i++) {
+      JsVar *var = jsvGetAddressOf(i);
+      if ((var->flags&JSV_VARTYPEMASK) == JSV_UNUSED) continue;
+      if (var->flags & JSV_GARBAGE_COLLECT) {
+        if (markLocked && jsvGetLocks(var)>0)
+          jsvGarbageCollectMarkRef(i);
+      } else if (rescan && !jsvIsFlatString(var))
+        jsvGarbageCollectMarkChildren(var);
+      while (jsvGCMarkStackLen) jsvGarbageCollectMarkPop();
+      // if we have a flat string, skip that many blocks
+      if (jsvIsFlatString(var))
+        i = (JsVarRef)(i+jsvGetFlatStringBlocks(var));
     }
+    rescan = true;
+  } while (jsvGCMarkStackOverflow);
+}
+
+/** We're about to free var in a GC sweep. If it had a child that wasn't
+ * listed for GC then we need to unref it. Everything else is fine because
+ * it'll disappear anyway. We don't have to check if we should free this other
+ * variable here because we know the GC picked up it was referenced from
+ * somewhere else. */
+static void jsvGarbageCollectUnRefChild(JsVar *var) {
+  if (!jsvHasSingleChild(var)) return;
+  JsVarRef ch = jsvGetFirstChild(var);
+  if (ch) {
+    JsVar *child = jsvGetAddressOf(ch); // not locked
+    if (child->flags!=JSV_UNUSED && // not already GC'd!
+        !(child->flags&JSV_GARBAGE_COLLECT)) // not marked for GC
+      jsvUnRef(child);
   }
-
-  return true;
 }
 
 /** Run a garbage collection sweep - return nonzero if things have been freed */
 int jsvGarbageCollect() {
   if (isMemoryBusy) return 0;
+#ifndef ESPR_NO_INCREMENTAL_GC
+  jsvGarbageCollectAbort(); // we're about to do everything in one go
+  JsSysTime startTime = jshGetSystemTime();
+#endif
   isMemoryBusy = MEMBUSY_GC;
+#ifndef ESPR_NO_ARRAY_INDEX_CACHE
+  jsvArrayIndexCacheClear(); // we may free the array or element
+#endif
+#ifndef ESPR_NO_MEMBER_CACHE
+  jsvObjectEpochChanged(); // we may free a prototype
+#endif
   JsVarRef i;
   // Add GC flags to anything that is currently used
   for (i=1;i<=jsVarsSize;i++)  {
@@ -4308,22 +4856,10 @@ int jsvGarbageCollect() {
         i = (JsVarRef)(i+jsvGetFlatStringBlocks(var));
     }
   }
-  /* recursively remove anything that is referenced from a var that is locked. */
-  for (i=1;i<=jsVarsSize;i++)  {
-    JsVar *var = jsvGetAddressOf(i);
-    if ((var->flags & JSV_GARBAGE_COLLECT) && // not already GC'd
-        jsvGetLocks(var)>0) { // or it is locked
-      if (!jsvGarbageCollectMarkUsed(var)) {
-        // this could fail due to stack exhausted (eg big linked list)
-        // JSV_GARBAGE_COLLECT are left set, but not a big problem as next GC will clear them
-        isMemoryBusy = MEM_NOT_BUSY;
-        return 0;
-      }
-    }
-    // if we have a flat string, skip that many blocks
-    if (jsvIsFlatString(var))
-      i = (JsVarRef)(i+jsvGetFlatStringBlocks(var));
-  }
+  /* remove anything that is referenced from a var that is locked. */
+  jsvGCMarkStackLen = 0;
+  jsvGCMarkStackOverflow = false;
+  jsvGarbageCollectMarkAll(true);
   /* now sweep for things that we can GC!
    * Also update the free list - this means that every new variable that
    * gets allocated gets allocated towards the start of memory, which
@@ -4356,20 +4892,7 @@ int jsvGarbageCollect() {
         }
       } else {
         // otherwise just free 1 block
-        if (jsvHasSingleChild(var)) {
-          /* If this had a child that wasn't listed for GC then we need to
-           * unref it. Everything else is fine because it'll disappear anyway.
-           * We don't have to check if we should free this other variable
-           * here because we know the GC picked up it was referenced from
-           * somewhere else. */
-          JsVarRef ch = jsvGetFirstChild(var);
-          if (ch) {
-            JsVar *child = jsvGetAddressOf(ch); // not locked
-            if (child->flags!=JSV_UNUSED && // not already GC'd!
-                !(child->flags&JSV_GARBAGE_COLLECT)) // not marked for GC
-              jsvUnRef(child);
-          }
-        }
+        jsvGarbageCollectUnRefChild(var);
         /* Sanity checks here. We're making sure that any variables that are
          * linked from this one have either already been garbage collected or
          * are marked for GC */
@@ -4409,9 +4932,252 @@ int jsvGarbageCollect() {
   }
   if (lastEmpty) jsvSetNextSibling(lastEmpty, 0);
   isMemoryBusy = MEM_NOT_BUSY;
+#ifndef ESPR_NO_INCREMENTAL_GC
+  jsvGarbageCollectAddPause(jshGetSystemTime() - startTime);
+#endif
   return (int)freedCount;
 }
 
+#ifndef ESPR_NO_INCREMENTAL_GC
+/* Incremental garbage collection. This does the same job as jsvGarbageCollect
+ * but in small slices, with JavaScript able to run in between:
+ *
+ * JSVGC_FLAG   : Set JSV_GARBAGE_COLLECT on every used var. Vars that are locked
+ *                are roots, so are marked (flag cleared) and pushed on the mark stack.
+ * JSVGC_MARK   : Pop vars off the mark stack and mark their children.
+ * JSVGC_RESCAN : If the mark stack overflowed, scan memory for marked vars that
+ *                link to unmarked ones (and unmarked locked vars), then go back to JSVGC_MARK.
+ * JSVGC_SWEEP  : Free any vars still with JSV_GARBAGE_COLLECT set.
+ *
+ * New vars never have JSV_GARBAGE_COLLECT set, so are never freed by the
+ * collection in progress. While marking, two barriers keep us from missing a
+ * var that JS code has moved somewhere we've already looked:
+ *
+ * - jsvSetFirstChild/LastChild/NextSibling/PrevSibling push the var being
+ *   changed back on the mark stack if it has already been marked, so any new
+ *   links it has are followed.
+ * - jsvLock/jsvLockAgain mark an unmarked var, as anything locked is a root.
+ */
+
+static void jsvGarbageCollectWriteBarrier(JsVar *var) {
+  // Not marked yet (we'll follow its links if we find it), or in the free list
+  if ((var->flags & JSV_GARBAGE_COLLECT) || (var->flags&JSV_VARTYPEMASK)==JSV_UNUSED)
+    return;
+  JsVarRef ref = jsvGetRef(var);
+  // Not got to this var yet, so it'll be flagged when we do
+  if (jsvGCPhase==JSVGC_FLAG && ref>=jsvGCCursor) return;
+  // Often the same var gets changed a few times in a row
+  if (jsvGCMarkStackLen && jsvGCMarkStack[jsvGCMarkStackLen-1]==ref) return;
+  jsvGarbageCollectPush(ref);
+}
+
+static void jsvGarbageCollectLockBarrier(JsVar *var) {
+  jsvGarbageCollectMarkRef(jsvGetRef(var));
+}
+
+/// Stop any incremental garbage collection that is in progress
+static void jsvGarbageCollectAbort() {
+  if (jsvGCPhase==JSVGC_SWEEP && jsvGCFreeFirst) {
+    // put anything we freed back in the free list
+    jshInterruptOff();
+    jsvSetNextSibling(jsvGetAddressOf(jsvGCFreeLast), jsVarFirstEmpty);
+    jsVarFirstEmpty = jsvGCFreeFirst;
+    touchedFreeList = true;
+    jshInterruptOn();
+  }
+  /* Anything left with JSV_GARBAGE_COLLECT set isn't a problem, as the
+   * next GC sets it everywhere anyway */
+  jsvGCPhase = JSVGC_IDLE;
+  jsvGCBarrier = false;
+  jsvGCMarkStackLen = 0;
+  jsvGCMarkStackOverflow = false;
+  jsvGCFreeFirst = 0;
+  jsvGCFreeLast = 0;
+}
+
+/// A flat string was allocated - make sure we don't treat its data blocks as vars
+static void jsvGarbageCollectFlatStringAllocated(JsVar *flatString) {
+  if (jsvGCPhase==JSVGC_IDLE) return;
+  JsVarRef first = jsvGetRef(flatString);
+  JsVarRef last = (JsVarRef)(first + jsvGetFlatStringBlocks(flatString));
+  // don't start looking at it from the middle
+  if (first<jsvGCCursor && jsvGCCursor<=last)
+    jsvGCCursor = (JsVarRef)(last+1);
+  // anything on the mark stack in the data blocks has been freed since it was pushed
+  unsigned int i = 0;
+  while (i<jsvGCMarkStackLen) {
+    if (jsvGCMarkStack[i]>first && jsvGCMarkStack[i]<=last)
+      jsvGCMarkStack[i] = jsvGCMarkStack[--jsvGCMarkStackLen];
+    else
+      i++;
+  }
+}
+
+/// Add a var freed by JSVGC_SWEEP to our list
+static void jsvGarbageCollectSweepFree(JsVarRef ref) {
+  JsVar *var = jsvGetAddressOf(ref);
+  var->flags = JSV_UNUSED;
+  jsvSetNextSibling(var, 0);
+  if (jsvGCFreeLast) jsvSetNextSibling(jsvGetAddressOf(jsvGCFreeLast), ref);
+  else jsvGCFreeFirst = ref;
+  jsvGCFreeLast = ref;
+  jsvGCFreed++;
+}
+
+/// Do one step of incremental GC work - return the amount of vars looked at
+static unsigned int jsvGarbageCollectStep() {
+  JsVar *var;
+  switch (jsvGCPhase) {
+  case JSVGC_IDLE:
+    jsvGCCursor = 1;
+    jsvGCMarkStackLen = 0;
+    jsvGCMarkStackOverflow = false;
+    jsvGCPhase = JSVGC_FLAG;
+    jsvGCBarrier = true;
+    return 1;
+  case JSVGC_FLAG:
+    if (jsvGCCursor > jsVarsSize) {
+      jsvGCPhase = JSVGC_MARK;
+      return 1;
+    }
+    var = jsvGetAddressOf(jsvGCCursor);
+    if ((var->flags&JSV_VARTYPEMASK) != JSV_UNUSED) { // if it is not unused
+      if (jsvGetLocks(var)) { // locked, so used - mark it now
+        var->flags &= (JsVarFlags)~JSV_GARBAGE_COLLECT;
+        jsvGarbageCollectPush(jsvGCCursor);
+      } else
+        var->flags |= (JsVarFlags)JSV_GARBAGE_COLLECT;
+      // if we have a flat string, skip that many blocks
+      if (jsvIsFlatString(var))
+        jsvGCCursor = (JsVarRef)(jsvGCCursor+jsvGetFlatStringBlocks(var));
+    }
+    jsvGCCursor++;
+    return 1;
+  case JSVGC_MARK:
+  case JSVGC_RESCAN:
+    if (jsvGCMarkStackLen)
+      return jsvGarbageCollectMarkPop();
+    if (jsvGCPhase==JSVGC_MARK || jsvGCCursor > jsVarsSize) {
+      if (jsvGCMarkStackOverflow) { // we missed some - go and find them
+        jsvGCMarkStackOverflow = false;
+        jsvGCCursor = 1;
+        jsvGCPhase = JSVGC_RESCAN;
+      } else { // all marked - sweep
+        jsvGCBarrier = false;
+        jsvGCFreed = 0;
+        jsvGCCursor = 1;
+        jsvGCPhase = JSVGC_SWEEP;
+#ifndef ESPR_NO_ARRAY_INDEX_CACHE
+        jsvArrayIndexCacheClear(); // we may free the array or element
+#endif
+#ifndef ESPR_NO_MEMBER_CACHE
+        jsvObjectEpochChanged(); // we may free a prototype
+#endif
+      }
+      return 1;
+    }
+    var = jsvGetAddressOf(jsvGCCursor);
+    if ((var->flags&JSV_VARTYPEMASK) != JSV_UNUSED) {
+      if (var->flags & JSV_GARBAGE_COLLECT) {
+        if (jsvGetLocks(var)) jsvGarbageCollectMarkRef(jsvGCCursor);
+      } else if (!jsvIsFlatString(var))
+        jsvGarbageCollectMarkChildren(var);
+      // if we have a flat string, skip that many blocks
+      if (jsvIsFlatString(var))
+        jsvGCCursor = (JsVarRef)(jsvGCCursor+jsvGetFlatStringBlocks(var));
+    }
+    jsvGCCursor++;
+    return 1;
+  case JSVGC_SWEEP:
+    if (jsvGCCursor > jsVarsSize) {
+      // add everything we freed to the free list
+      jsvGarbageCollectAbort();
+      return 1;
+    }
+    var = jsvGetAddressOf(jsvGCCursor);
+    if (var->flags & JSV_GARBAGE_COLLECT) {
+      if (jsvIsFlatString(var)) {
+        // If we're a flat string, there are more blocks to free.
+        JsVarRef last = (JsVarRef)(jsvGCCursor+jsvGetFlatStringBlocks(var));
+        while (jsvGCCursor <= last)
+          jsvGarbageCollectSweepFree(jsvGCCursor++);
+        return 1;
+      }
+      jsvGarbageCollectUnRefChild(var);
+      jsvGarbageCollectSweepFree(jsvGCCursor);
+    } else if (jsvIsFlatString(var)) {
+      // if we have a flat string, skip forward that many blocks
+      jsvGCCursor = (JsVarRef)(jsvGCCursor+jsvGetFlatStringBlocks(var));
+    }
+    jsvGCCursor++;
+    return 1;
+  }
+  return 1;
+}
+
+int jsvGarbageCollectSlice() {
+  if (isMemoryBusy) return 0;
+  JsSysTime startTime = jshGetSystemTime();
+  JsSysTime endTime = startTime + jsvGCBudget;
+  isMemoryBusy = MEMBUSY_GC;
+  unsigned int count = 0, lastCount = 0;
+  int freed = 0;
+  do {
+    count += jsvGarbageCollectStep();
+    if (jsvGCPhase==JSVGC_IDLE) { // finished!
+      freed = (int)jsvGCFreed;
+      jsvGCCycles++;
+      break;
+    }
+    // don't check the time too often as it can be slow
+    if (count-lastCount >= 64) {
+      lastCount = count;
+      if (jshGetSystemTime() >= endTime) break;
+    }
+  } while (true);
+  isMemoryBusy = MEM_NOT_BUSY;
+  jsvGCSlices++;
+  jsvGarbageCollectAddPause(jshGetSystemTime() - startTime);
+  return freed;
+}
+
+bool jsvGarbageCollectInProgress() {
+  return jsvGCPhase != JSVGC_IDLE;
+}
+
+void jsvGarbageCollectSetBudget(JsVarFloat ms) {
+  jsvGCBudget = (ms>0) ? jshGetTimeFromMilliseconds(ms) : 0;
+  if (!jsvGCBudget) jsvGarbageCollectAbort();
+}
+
+JsVarFloat jsvGarbageCollectGetBudget() {
+  return jsvGCBudget ? jshGetMillisecondsFromTime(jsvGCBudget) : 0;
+}
+
+/// Add a GC pause to our histogram
+static void jsvGarbageCollectAddPause(JsSysTime time) {
+  JsVarFloat ms = jshGetMillisecondsFromTime(time);
+  int bucket = 0;
+  JsVarFloat limit = 0.1;
+  while (bucket<JSV_GC_PAUSE_BUCKETS-1 && ms>=limit) {
+    bucket++;
+    limit *= 10;
+  }
+  jsvGCPauses[bucket]++;
+  if (time > jsvGCMaxPause) jsvGCMaxPause = time;
+}
+
+JsVarFloat jsvGarbageCollectGetPauses(unsigned int *counts) {
+  memcpy(counts, jsvGCPauses, sizeof(jsvGCPauses));
+  return jshGetMillisecondsFromTime(jsvGCMaxPause);
+}
+
+void jsvGarbageCollectGetIncrementalCounts(unsigned int *slices, unsigned int *cycles) {
+  *slices = jsvGCSlices;
+  *cycles = jsvGCCycles;
+}
+#endif // ESPR_NO_INCREMENTAL_GC
+
 #ifndef SAVE_ON_FLASH
 static void _jsvDefragment_moveReferences(JsVarRef defragFromRef, JsVarRef defragToRef, unsigned int lastAllocated) {
   // find references!
@@ -4443,6 +5209,13 @@ void jsvDefragment() {
   // garbage collect - removes cruft, also puts free list in order
   if (isMemoryBusy) return;
   jsvGarbageCollect();
+#ifndef ESPR_NO_OBJECT_INDEX
+  // refs are about to change, so Object indexes will need rebuilding
+  jsvObjectIndexInvalidateAll();
+#endif
+#ifndef ESPR_NO_MEMBER_CACHE
+  jsvObjectEpochChanged();
+#endif
   // Set memory busy so nobody can allocate, and we can defrag with IRQ on
   isMemoryBusy = MEMBUSY_DEFRAG;
   const unsigned int minMove = 20; // don't move vars back less than this or we're just wasting CPU time
@@ -4572,13 +5345,17 @@ void jsvDumpLockedVars() {
     }
   }
   // Add global
-  jsvGarbageCollectMarkUsed(execInfo.root);
+  jsvGCMarkStackLen = 0;
+  jsvGCMarkStackOverflow = false;
+  jsvGarbageCollectMarkRef(jsvGetRef(execInfo.root));
+  jsvGarbageCollectMarkAll(false);
   // Now dump any that aren't used!
   for (i=1;i<=jsVarsSize;i++)  {
     JsVar *var = jsvGetAddressOf(i);
     if ((var->flags&JSV_VARTYPEMASK) != JSV_UNUSED) {
       if (var->flags & JSV_GARBAGE_COLLECT) {
-        jsvGarbageCollectMarkUsed(var);
+        jsvGarbageCollectMarkRef(i);
+        jsvGarbageCollectMarkAll(false);
         jsvTrace(var, 0);
       }
       // if we have a flat string, skip that many blocks
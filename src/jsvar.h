@@ -95,7 +95,7 @@ typedef enum {
 
     JSV_VARTYPEMASK = NEXT_POWER_2(_JSV_VAR_END)-1, // probably this is 63
 
-    JSV_CONSTANT    = JSV_VARTYPEMASK+1, ///< to specify if this variable is a constant or not. Used for NAMEs, but also NativeStrings in Flash and ArrayBuffers that reference those
+    JSV_CONSTANT    = JSV_VARTYPEMASK+1, ///< to specify if this variable is a constant or not. Used for NAMEs, but also NativeStrings in Flash, ArrayBuffers that reference those, and pretokenised function code
     JSV_NATIVE      = JSV_CONSTANT<<1, ///< to specify if this is a function parameter
     JSV_GARBAGE_COLLECT = JSV_NATIVE<<1, ///< When garbage collecting, this flag is true IF we should GC!
     JSV_IS_RECURSING = JSV_GARBAGE_COLLECT<<1, ///< used to stop recursive loops in jsvTrace
@@ -227,7 +227,11 @@ struct JsVarStruct {
 
   /** the flags determine the type of the variable - int/double/string/etc. */
   volatile JsVarFlags flags;
-} PACKED_FLAGS;
+} PACKED_FLAGS
+#ifdef ESPR_JIT
+__attribute__ ((aligned(2))) // JIT code uses bit 0 of a JsVar* to mark unboxed ints, so JsVars must be at even addresses
+#endif
+;
 
 /* We have a few different types:
  *
@@ -505,6 +509,7 @@ JsVar *jsvAsFlatString(JsVar *var); ///< Create a flat string from the given var
 bool jsvIsEmptyString(JsVar *v); ///< Returns true if the string is empty - faster than jsvGetStringLength(v)==0
 size_t jsvGetStringLength(const JsVar *v); ///< Get the length of this string, IF it is a string
 size_t jsvGetFlatStringBlocks(const JsVar *v); ///< return the number of blocks used by the given flat string - EXCLUDING the first data block
+void jsvShrinkFlatString(JsVar *v, size_t length); ///< Reduce the length of a flat string, freeing any blocks at the end that are no longer used
 char *jsvGetFlatStringPointer(JsVar *v); ///< Get a pointer to the data in this flat string
 JsVar *jsvGetFlatStringFromPointer(char *v); ///< Given a pointer to the first element of a flat string, return the flat string itself (DANGEROUS!)
 char *jsvGetDataPointer(JsVar *v, size_t *len); ///< If the variable points to a *flat* area of memory, return a pointer (and set length). Otherwise return 0.
@@ -691,6 +696,13 @@ JsVar *jsvCopy(JsVar *src, bool copyChildren);
 /** Copy only a name, not what it points to. ALTHOUGH the link to what it points to is maintained unless linkChildren=false.
     If keepAsName==false, this will be converted into a normal variable */
 JsVar *jsvCopyNameOnly(JsVar *src, bool linkChildren, bool keepAsName);
+#ifndef ESPR_NO_MEMBER_CACHE
+/** Changes whenever something is done that could alter what Objects inherit from their
+ * prototypes (see jspGetNamedField). To keep this from changing too often, set the bit
+ * (ref&31) in jsvObjectEpochWatched for each prototype that matters to you. */
+extern unsigned int jsvObjectEpoch;
+extern uint32_t jsvObjectEpochWatched;
+#endif
 /// Tree related stuff
 void jsvAddName(JsVar *parent, JsVar *nameChild); // Add a child, which is itself a name
 JsVar *jsvAddNamedChild(JsVar *parent, JsVar *value, const char *name); // Add a child, and create a name for it. Returns a LOCKED var. DOES NOT CHECK FOR DUPLICATES
@@ -777,6 +789,24 @@ void jsvTrace(JsVar *var, int indent);
 /** Run a garbage collection sweep - return nonzero if things have been freed */
 int jsvGarbageCollect();
 
+#ifndef ESPR_NO_INCREMENTAL_GC
+#define JSV_GC_PAUSE_BUCKETS 4 ///< GC pauses are counted as <0.1ms, <1ms, <10ms and >=10ms
+
+/** Do a bounded amount of garbage collection work (see jsvGarbageCollectSetBudget), starting
+ * a new collection if one isn't in progress - return nonzero if a collection finished and things were freed */
+int jsvGarbageCollectSlice();
+/// Is an incremental garbage collection in progress?
+bool jsvGarbageCollectInProgress();
+/// Set the maximum time in milliseconds jsvGarbageCollectSlice may take. 0 disables incremental GC
+void jsvGarbageCollectSetBudget(JsVarFloat ms);
+/// Get the maximum time in milliseconds jsvGarbageCollectSlice may take (0 = incremental GC disabled)
+JsVarFloat jsvGarbageCollectGetBudget();
+/// Get a histogram of GC pause times (JSV_GC_PAUSE_BUCKETS entries), and return the longest pause in milliseconds
+JsVarFloat jsvGarbageCollectGetPauses(unsigned int *counts);
+/// Get how many incremental GC slices have run, and how many incremental GCs have completed
+void jsvGarbageCollectGetIncrementalCounts(unsigned int *slices, unsigned int *cycles);
+#endif
+
 /** Defragement memory - this could take a while with interrupts turned off! */
 void jsvDefragment();
 
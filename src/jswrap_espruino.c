@@ -896,6 +896,7 @@ JsVar *jswrap_espruino_getErrorFlags() {
 type Flag =
   | "deepSleep"
   | "pretokenise"
+  | "lazyPretokenise"
   | "unsafeFlash"
   | "unsyncFiles";
 */
@@ -905,7 +906,7 @@ type Flag =
   "name" : "getFlags",
   "generate" : "jsfGetFlags",
   "return" : ["JsVar","An object containing flag names and their values"],
-  "typescript" : "getFlags(): { [key in Flag]: boolean }"
+  "typescript" : "getFlags(): { [key in Flag]: boolean } & { gcBudget: number }"
 }
 Get Espruino's interpreter flags that control the way it handles your JavaScript
 code.
@@ -923,6 +924,13 @@ code.
   file called `ERROR` in Storage (the file is not updated)
 * `onErrorFlash` - (2v27+) when an uncaught error occurs, flash the red LED
   for 200ms (only on devices with a physical LED)
+* `lazyPretokenise` - (2v30+) the first time a function is called, pre-minify
+  and tokenise its code (as `pretokenise` does) if it wasn't already. Only
+  functions whose code is in RAM are affected, and functions that are never
+  called use no extra memory.
+* `gcBudget` - (2v30+) a number of milliseconds (default 0). If nonzero, garbage
+  collection when idle is done a slice at a time, with each slice taking at
+  most this long, so it doesn't delay timers. See `gcpauses` in `process.memory()`
 */
 /*JSON{
   "type" : "staticmethod",
@@ -930,9 +938,9 @@ code.
   "name" : "setFlags",
   "generate" : "jsfSetFlags",
   "params" : [
-    ["flags","JsVar","An object containing flag names and boolean values. You need only specify the flags that you want to change."]
+    ["flags","JsVar","An object containing flag names and boolean values (or a number for `gcBudget`). You need only specify the flags that you want to change."]
   ],
-  "typescript" : "setFlags(flags: { [key in Flag]?: boolean }): void"
+  "typescript" : "setFlags(flags: { [key in Flag]?: boolean } & { gcBudget?: number }): void"
 }
 Set the Espruino interpreter flags that control the way it handles your
 JavaScript code.
@@ -0,0 +1,125 @@
+/*
+ * This file is part of Espruino, a JavaScript interpreter for Microcontrollers
+ *
+ * Copyright (C) 2026 Gordon Williams <gw@pur3.co.uk>
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * ----------------------------------------------------------------------------
+ * This file is designed to be parsed during the build process
+ *
+ * ES6 Generators (returned by `function*`)
+ * ----------------------------------------------------------------------------
+ */
+
+#include "jsutils.h"
+
+#ifndef ESPR_NO_ASYNC
+
+#include "jswrap_generator.h"
+#include "jsparse.h"
+
+/*JSON{
+  "type" : "class",
+  "class" : "Generator",
+  "ifndef" : "SAVE_ON_FLASH"
+}
+This is the built-in class for the objects returned when you call a generator
+function (`function*`). Each call to `next` runs the function's code up to its
+next `yield`:
+
+```
+function* count(n) {
+  for (var i=0;i<n;i++) print(i);
+  var a = yield "first";
+  yield a+1;
+  return "done";
+}
+var g = count(3);
+g.next(); // prints 0,1,2 and returns {value:"first", done:false}
+g.next(5); // {value:6, done:false}
+g.next(); // {value:"done", done:true}
+```
+
+Generators can also be iterated over with `for (... of ...)`.
+
+**Note:** To keep memory usage low, `yield` must be at the start of a statement -
+either on its own (`yield x`), or assigned to a variable (`a = yield x`,
+`var a = yield x`, or `return yield x`). That statement can be inside blocks,
+`if`, `while`, `do` and `for(;;)` loops, and `try`/`catch`, but not `for..in`,
+`for..of`, `switch` or `finally`.
+*/
+
+/// Return an object of the form `{value, done}` (unlocking value)
+static JsVar *jswrap_generator_result(JsVar *value, bool isDone) {
+  JsVar *result = jsvNewObject();
+  if (result) {
+    jsvObjectSetChild(result, "value", value);
+    jsvObjectSetChildAndUnLock(result, "done", jsvNewFromBool(isDone));
+  }
+  jsvUnLock(value);
+  return result;
+}
+
+/*JSON{
+  "type" : "method",
+  "class" : "Generator",
+  "name" : "next",
+  "ifndef" : "SAVE_ON_FLASH",
+  "generate" : "jswrap_generator_next",
+  "params" : [
+    ["value","JsVar","[optional] The value that the `yield` the generator stopped at returns"]
+  ],
+  "return" : ["JsVar","An object of the form `{value, done}`"]
+}
+Run the generator's code up to the next `yield` and return the value that was
+yielded. When the generator function returns, `done` is `true` and `value` is
+the value it returned.
+*/
+JsVar *jswrap_generator_next(JsVar *parent, JsVar *value) {
+  bool isDone;
+  JsVar *result = jspCoroutineResume(parent, value, false, &isDone);
+  return jswrap_generator_result(result, isDone);
+}
+
+/*JSON{
+  "type" : "method",
+  "class" : "Generator",
+  "name" : "return",
+  "ifndef" : "SAVE_ON_FLASH",
+  "generate" : "jswrap_generator_return",
+  "params" : [
+    ["value","JsVar","[optional] The value to return"]
+  ],
+  "return" : ["JsVar","An object of the form `{value, done:true}`"]
+}
+Finish the generator without running any more of its code
+*/
+JsVar *jswrap_generator_return(JsVar *parent, JsVar *value) {
+  jspCoroutineKill(parent);
+  return jswrap_generator_result(jsvLockAgainSafe(value), true);
+}
+
+/*JSON{
+  "type" : "method",
+  "class" : "Generator",
+  "name" : "throw",
+  "ifndef" : "SAVE_ON_FLASH",
+  "generate" : "jswrap_generator_throw",
+  "params" : [
+    ["exception","JsVar","The exception to throw"]
+  ],
+  "return" : ["JsVar","An object of the form `{value, done}`"]
+}
+Throw the given exception at the `yield` that the generator stopped at. As
+`yield` can't be inside a `try` block this always finishes the generator.
+*/
+JsVar *jswrap_generator_throw(JsVar *parent, JsVar *exception) {
+  bool isDone;
+  JsVar *result = jspCoroutineResume(parent, exception, true, &isDone);
+  return jswrap_generator_result(result, isDone);
+}
+
+#endif // ESPR_NO_ASYNC
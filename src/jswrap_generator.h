@@ -0,0 +1,27 @@
+/*
+ * This file is part of Espruino, a JavaScript interpreter for Microcontrollers
+ *
+ * Copyright (C) 2026 Gordon Williams <gw@pur3.co.uk>
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * ----------------------------------------------------------------------------
+ * ES6 Generators (returned by `function*`)
+ * ----------------------------------------------------------------------------
+ */
+#ifndef JSWRAP_GENERATOR_H_
+#define JSWRAP_GENERATOR_H_
+
+#include "jsvar.h"
+#include "jsutils.h"
+
+#ifndef ESPR_NO_ASYNC
+
+JsVar *jswrap_generator_next(JsVar *parent, JsVar *value);
+JsVar *jswrap_generator_return(JsVar *parent, JsVar *value);
+JsVar *jswrap_generator_throw(JsVar *parent, JsVar *exception);
+
+#endif // ESPR_NO_ASYNC
+#endif // JSWRAP_GENERATOR_H_
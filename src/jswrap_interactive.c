@@ -348,7 +348,7 @@ To set the timezone for all new Dates, use `E.setTimeZone(hours)`.
 void jswrap_interactive_setTime(JsVarFloat time) {
   jshInterruptOff();
   JsSysTime stime = jshGetTimeFromMilliseconds(time*1000);
-  jsiLastIdleTime = stime;
+  jsiSetLastIdleTime(stime);
   JsSysTime oldtime = jshGetSystemTime();
   // set system time
   jshSetSystemTime(stime);
@@ -491,7 +491,7 @@ JsVar *_jswrap_interface_setTimeoutOrInterval(JsVar *func, JsVarFloat interval,
   JsVar *timerPtr = jsvNewObject();
   if (!timerPtr) return 0;
   JsSysTime intervalInt = jshGetTimeFromMilliseconds(interval);
-  jsvObjectSetChildAndUnLock(timerPtr, "time", jsvNewFromLongInteger((jshGetSystemTime() - jsiLastIdleTime) + intervalInt));
+  jsvObjectSetChildAndUnLock(timerPtr, "time", jsvNewFromLongInteger((jshGetSystemTime() - jsiTimerBase) + intervalInt));
   if (!isTimeout) {
     jsvObjectSetChildAndUnLock(timerPtr, "intr", jsvNewFromLongInteger(intervalInt));
   }
@@ -566,6 +566,7 @@ void _jswrap_interface_clearTimeoutOrInterval(JsVar *idVarArr, bool isTimeout) {
       jsvUnLock2(watchPtr, timerPtr);
     }
     jsvObjectIteratorFree(&it);
+    jsiTimersRebuild();
   } else {
     JsVar *idVar = jsvGetArrayItem(idVarArr, 0);
     if (jsvIsUndefined(idVar)) {
@@ -574,7 +575,7 @@ void _jswrap_interface_clearTimeoutOrInterval(JsVar *idVarArr, bool isTimeout) {
     } else {
       JsVar *child = jsvIsBasic(idVar) ? jsvFindChildFromVar(timerArray, idVar, false) : 0;
       if (child)
-        jsvRemoveChildAndUnLock(timerArray, child);
+        jsiTimerRemoveAndUnLock(child);
       jsvUnLock(idVar);
     }
   }
@@ -614,7 +615,8 @@ void jswrap_interface_changeInterval(JsVar *idVar, JsVarFloat interval) {
     JsVar *timer = jsvSkipNameAndUnLock(timerName);
     JsSysTime intervalInt = jshGetTimeFromMilliseconds(interval);
     jsvObjectSetChildAndUnLock(timer, "intr", jsvNewFromLongInteger(intervalInt));
-    jsvObjectSetChildAndUnLock(timer, "time", jsvNewFromLongInteger((jshGetSystemTime()-jsiLastIdleTime) + intervalInt));
+    jsvObjectSetChildAndUnLock(timer, "time", jsvNewFromLongInteger((jshGetSystemTime()-jsiTimerBase) + intervalInt));
+    jsiTimerUpdated(timer);
     jsvUnLock(timer);
     // timerName already unlocked
     jsiTimersChanged(); // mark timers as changed
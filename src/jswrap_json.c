@@ -34,6 +34,22 @@ const char *JSON_LIMIT_TEXT = " ... ";
 An Object that handles conversion to and from the JSON data interchange format
  */
 
+/// Fill whitespace (11 chars) from the 'space' argument of stringify, and return any flags needed
+static JSONFlags jswrap_json_get_whitespace(JsVar *space, char *whitespace) {
+  if (jsvIsUndefined(space) || jsvIsNull(space)) {
+    // nothing
+  } else if (jsvIsNumeric(space)) {
+    int s = (int)jsvGetInteger(space);
+    if (s<0) s=0;
+    if (s>10) s=10;
+    whitespace[s] = 0;
+    while (s) whitespace[--s]=' ';
+  } else {
+    jsvGetString(space, whitespace, 10);
+  }
+  return strlen(whitespace) ? (JSON_ALL_NEWLINES|JSON_PRETTY) : JSON_NONE;
+}
+
 /*JSON{
   "type" : "staticmethod",
   "class" : "JSON",
@@ -61,23 +77,66 @@ JsVar *jswrap_json_stringify(JsVar *v, JsVar *replacer, JsVar *space) {
   JsVar *result = jsvNewFromEmptyString();
   if (result) {// could be out of memory
     char whitespace[11] = "";
-    if (jsvIsUndefined(space) || jsvIsNull(space)) {
-      // nothing
-    } else if (jsvIsNumeric(space)) {
-      int s = (int)jsvGetInteger(space);
-      if (s<0) s=0;
-      if (s>10) s=10;
-      whitespace[s] = 0;
-      while (s) whitespace[--s]=' ';
-    } else {
-      jsvGetString(space, whitespace, sizeof(whitespace)-1);
-    }
-    if (strlen(whitespace)) flags |= JSON_ALL_NEWLINES|JSON_PRETTY;
+    flags |= jswrap_json_get_whitespace(space, whitespace);
     jsfGetJSONWhitespace(v, result, flags, whitespace);
   }
   return result;
 }
 
+#ifndef SAVE_ON_FLASH
+static bool jswrap_json_write_chunk(JsVar *chunk, size_t offset, void *user_data) {
+  NOT_USED(offset);
+  JsVar **destAndWrite = (JsVar**)user_data;
+  jsvUnLock(jspExecuteFunction(destAndWrite[1], destAndWrite[0], 1, &chunk));
+  return !jspHasError();
+}
+
+/*JSON{
+  "type" : "staticmethod",
+  "class" : "JSON",
+  "name" : "write",
+  "ifndef" : "SAVE_ON_FLASH",
+  "generate" : "jswrap_json_write",
+  "params" : [
+    ["destination","JsVar","An object with a `write` method, like a `StorageFile`, `Serial` or `Socket`"],
+    ["data","JsVar","The data to be converted to JSON"],
+    ["space","JsVar","[optional] The number of spaces to use for padding, a string, or null/undefined for no whitespace "]
+  ],
+  "return" : ["bool","True on success, false on failure"]
+}
+Convert the given object to JSON (exactly as `JSON.stringify` does), but rather
+than returning a String, call `destination.write` with the JSON a few characters
+at a time. This means the whole JSON String never has to be in memory at once,
+so big objects can be saved even if there isn't enough free memory for them.
+
+```
+var f = require("Storage").open("state.json","w");
+JSON.write(f, state);
+// or
+JSON.write(Serial1, state, 2);
+```
+
+**Note:** If `destination` buffers everything written to it (like a `Socket` or
+HTTP response), the data will still end up in memory.
+ */
+bool jswrap_json_write(JsVar *destination, JsVar *data, JsVar *space) {
+  JsVar *destAndWrite[2];
+  destAndWrite[0] = destination;
+  destAndWrite[1] = jspGetNamedField(destination, "write", false);
+  if (!jsvIsFunction(destAndWrite[1])) {
+    jsExceptionHere(JSET_TYPEERROR, "Expecting an object with a write method, got %t", destination);
+    jsvUnLock(destAndWrite[1]);
+    return false;
+  }
+  JSONFlags flags = JSON_IGNORE_FUNCTIONS|JSON_NO_UNDEFINED|JSON_ARRAYBUFFER_AS_ARRAY|JSON_JSON_COMPATIBILE|JSON_ALLOW_TOJSON;
+  char whitespace[11] = "";
+  flags |= jswrap_json_get_whitespace(space, whitespace);
+  int length = jsfGetJSONChunked(data, flags, whitespace, jswrap_json_write_chunk, destAndWrite);
+  jsvUnLock(destAndWrite[1]);
+  return length>=0;
+}
+#endif
+
 
 /* Parse JSON from the current lexer. unquoted fields aren't normally allowed,
    but if flags&JSON_DROP_QUOTES we'll allow them */
@@ -168,6 +227,270 @@ JsVar *jswrap_json_parse_internal(JSONFlags flags) {
   }
 }
 
+/* Fast single-pass JSON parser. This works straight from a JsvStringIterator
+   and builds values without creating token strings or going through the
+   JS lexer. It only handles strict JSON - anything else (single quotes,
+   unquoted keys, comments, UTF8, errors) makes it give up and set
+   'fallback', so we can reparse with jswrap_json_parse_internal, which
+   handles everything and reports errors properly. */
+typedef struct {
+  JsVar *str; ///< the string we're parsing
+  JsvStringIterator it;
+  char ch; ///< current character
+  bool fallback; ///< we found something we can't handle
+} JsonParser;
+
+static ALWAYS_INLINE void jsonNextCh(JsonParser *p) {
+  jsvStringIteratorNextInline(&p->it);
+  p->ch = jsvStringIteratorGetChar(&p->it);
+}
+
+static ALWAYS_INLINE void jsonSkipWhitespace(JsonParser *p) {
+  while (p->ch==' ' || p->ch=='\n' || p->ch=='\r' || p->ch=='\t')
+    jsonNextCh(p);
+}
+
+/// Is this a character we can just copy straight into a string?
+static ALWAYS_INLINE bool jsonIsPlainStringChar(char ch) {
+#ifdef ESPR_UNICODE_SUPPORT
+  if (ch & 0x80) return false; // UTF8 - let the lexer handle it
+#endif
+  return ch && ch!='"' && ch!='\\' && ch!='\n';
+}
+
+static JsVar *jsonFail(JsonParser *p) {
+  p->fallback = true;
+  return 0;
+}
+
+/// Get the character for the escape code at the current position, or -1 if we can't handle it
+static int jsonParseEscape(JsonParser *p) {
+  switch (p->ch) {
+  case '"': case '\\': case '/': return p->ch;
+  case 'b': return '\b';
+  case 'f': return '\f';
+  case 'n': return '\n';
+  case 'r': return '\r';
+  case 't': return '\t';
+  case 'u': {
+    int code = 0;
+    for (int i=0;i<4;i++) {
+      jsonNextCh(p);
+      int h = chtod(p->ch);
+      if (h<0 || h>15) return -1;
+      code = (code<<4) | h;
+    }
+#ifdef ESPR_UNICODE_SUPPORT
+    if (code>=0x80) return -1; // needs encoding as UTF8
+#endif
+    return (unsigned char)code;
+  }
+  default: return -1;
+  }
+}
+
+/// Copy len characters from src to dst (which must already be long enough), a block of memory at a time
+static void jsonCopyChars(JsvStringIterator *dst, JsvStringIterator *src, size_t len) {
+  while (len && src->ptr && dst->ptr) {
+    size_t n = src->charsInVar - src->charIdx;
+    if (dst->charsInVar - dst->charIdx < n) n = dst->charsInVar - dst->charIdx;
+    if (len < n) n = len;
+    memcpy(&dst->ptr[dst->charIdx], &src->ptr[src->charIdx], n);
+    len -= n;
+    src->charIdx += n-1;
+    jsvStringIteratorNext(src);
+    dst->charIdx += n-1;
+    jsvStringIteratorNext(dst);
+  }
+}
+
+static JsVar *jsonParseString(JsonParser *p) {
+  jsonNextCh(p); // "
+  // Scan up to the end quote or first escape, and copy all that in one go
+  size_t start = jsvStringIteratorGetIndex(&p->it);
+  while (jsonIsPlainStringChar(p->ch)) jsonNextCh(p);
+  size_t len = jsvStringIteratorGetIndex(&p->it) - start;
+  JsVar *s;
+  if (p->ch=='"' && len<=JSV_FLAT_STRING_BREAK_EVEN && !jsvIsFlashString(p->str)) {
+    /* No escapes, so allocate the whole string and copy the data straight in.
+       Longer strings would be allocated as flat strings, which are slow to
+       allocate and can't be used as keys. */
+    s = jsvNewStringOfLength((unsigned int)len, NULL);
+    if (s) {
+      JsvStringIterator src, dst;
+      jsvStringIteratorNew(&src, p->str, start);
+      jsvStringIteratorNew(&dst, s, 0);
+      jsonCopyChars(&dst, &src, len);
+      jsvStringIteratorFree(&src);
+      jsvStringIteratorFree(&dst);
+    }
+  } else
+    s = jsvNewWritableStringFromStringVar(p->str, start, len);
+  if (!s) return jsonFail(p);
+  if (p->ch!='"') {
+    // We had escape characters, so append the rest character by character
+    JsvStringIterator dst;
+    jsvStringIteratorNew(&dst, s, 0);
+    jsvStringIteratorGotoEnd(&dst);
+    while (p->ch!='"') {
+      int ch = p->ch;
+      if (ch=='\\') {
+        jsonNextCh(p);
+        ch = jsonParseEscape(p);
+      } else if (!jsonIsPlainStringChar((char)ch))
+        ch = -1;
+      if (ch<0) {
+        jsvStringIteratorFree(&dst);
+        jsvUnLock(s);
+        return jsonFail(p);
+      }
+      jsvStringIteratorAppend(&dst, (char)ch);
+      jsonNextCh(p);
+    }
+    jsvStringIteratorFree(&dst);
+  }
+  jsonNextCh(p); // "
+  return s;
+}
+
+static JsVar *jsonParseNumber(JsonParser *p) {
+  char buf[JS_NUMBER_BUFFER_SIZE];
+  size_t len = 0;
+  bool isFloat = false;
+  long long v = 0;
+  bool negative = p->ch=='-';
+  if (negative) {
+    buf[len++] = p->ch;
+    jsonNextCh(p);
+  }
+  if (!isNumericInline(p->ch)) return jsonFail(p);
+  // no leading zeros (the lexer treats those as octal)
+  if (p->ch=='0') {
+    buf[len++] = p->ch;
+    jsonNextCh(p);
+    if (isNumericInline(p->ch)) return jsonFail(p);
+  }
+  while (isNumericInline(p->ch)) {
+    if (len>=18) return jsonFail(p); // could overflow
+    v = v*10 + (p->ch-'0');
+    buf[len++] = p->ch;
+    jsonNextCh(p);
+  }
+  if (p->ch=='.') {
+    isFloat = true;
+    buf[len++] = p->ch;
+    jsonNextCh(p);
+    if (!isNumericInline(p->ch)) return jsonFail(p);
+    while (isNumericInline(p->ch)) {
+      if (len>=sizeof(buf)-8) return jsonFail(p);
+      buf[len++] = p->ch;
+      jsonNextCh(p);
+    }
+  }
+  if (p->ch=='e' || p->ch=='E') {
+    isFloat = true;
+    buf[len++] = p->ch;
+    jsonNextCh(p);
+    if (p->ch=='+' || p->ch=='-') {
+      buf[len++] = p->ch;
+      jsonNextCh(p);
+    }
+    if (!isNumericInline(p->ch)) return jsonFail(p);
+    while (isNumericInline(p->ch)) {
+      if (len>=sizeof(buf)-1) return jsonFail(p);
+      buf[len++] = p->ch;
+      jsonNextCh(p);
+    }
+  }
+  // something like 0x12 or 12px - leave it to the lexer
+  if (isAlphaInline(p->ch)) return jsonFail(p);
+  if (!isFloat)
+    return jsvNewFromLongInteger(negative ? -v : v);
+  buf[len] = 0;
+  return jsvNewFromFloat(stringToFloat(buf));
+}
+
+/// Match the rest of 'true'/'false'/'null' (the first character has already been checked)
+static bool jsonMatchWord(JsonParser *p, const char *word) {
+  while (*(++word)) {
+    jsonNextCh(p);
+    if (p->ch != *word) return false;
+  }
+  jsonNextCh(p);
+  return !isAlphaInline(p->ch) && !isNumericInline(p->ch);
+}
+
+static JsVar *jsonParseValue(JsonParser *p) {
+  jsonSkipWhitespace(p);
+  switch (p->ch) {
+  case '"': return jsonParseString(p);
+  case 't': return jsonMatchWord(p, "true") ? jsvNewFromBool(true) : jsonFail(p);
+  case 'f': return jsonMatchWord(p, "false") ? jsvNewFromBool(false) : jsonFail(p);
+  case 'n': return jsonMatchWord(p, "null") ? jsvNewWithFlags(JSV_NULL) : jsonFail(p);
+  case '[': {
+    JsVar *arr = jsvNewEmptyArray(); if (!arr) return jsonFail(p);
+    jsonNextCh(p); // [
+    jsonSkipWhitespace(p);
+    while (p->ch!=']') {
+      JsVar *value = jsonParseValue(p);
+      if (!value) {
+        jsvUnLock(arr);
+        return 0;
+      }
+      jsvArrayPush(arr, value);
+      jsvUnLock(value);
+      jsonSkipWhitespace(p);
+      if (p->ch==',') {
+        jsonNextCh(p);
+        jsonSkipWhitespace(p);
+      } else if (p->ch!=']') {
+        jsvUnLock(arr);
+        return jsonFail(p);
+      }
+    }
+    jsonNextCh(p); // ]
+    return arr;
+  }
+  case '{': {
+    JsVar *obj = jsvNewObject(); if (!obj) return jsonFail(p);
+    jsonNextCh(p); // {
+    jsonSkipWhitespace(p);
+    while (p->ch!='}') {
+      JsVar *key = 0, *value = 0;
+      if (p->ch=='"') key = jsonParseString(p);
+      if (key) {
+        jsonSkipWhitespace(p);
+        if (p->ch==':') {
+          jsonNextCh(p);
+          value = jsonParseValue(p);
+        }
+      }
+      if (!value) {
+        jsvUnLock2(key, obj);
+        return jsonFail(p);
+      }
+      key = jsvAsArrayIndexAndUnLock(key);
+      jsvAddName(obj, jsvMakeIntoVariableName(key, value));
+      jsvUnLock2(value, key);
+      jsonSkipWhitespace(p);
+      if (p->ch==',') {
+        jsonNextCh(p);
+        jsonSkipWhitespace(p);
+      } else if (p->ch!='}') {
+        jsvUnLock(obj);
+        return jsonFail(p);
+      }
+    }
+    jsonNextCh(p); // }
+    return obj;
+  }
+  default:
+    if (p->ch=='-' || isNumericInline(p->ch))
+      return jsonParseNumber(p);
+    return jsonFail(p);
+  }
+}
+
 /*JSON{
   "type" : "staticmethod",
   "class" : "JSON",
@@ -181,8 +504,28 @@ JsVar *jswrap_json_parse_internal(JSONFlags flags) {
 Parse the given JSON string into a JavaScript object
  */
 JsVar *jswrap_json_parse_ext(JsVar *v, JSONFlags flags) {
-  JsLex lex;
   JsVar *str = jsvAsString(v);
+#ifdef ESPR_UNICODE_SUPPORT
+  if (str && !jsvIsUTF8String(str)) {
+#else
+  if (str) {
+#endif
+    // Try the fast parser first
+    JsonParser p;
+    p.str = str;
+    p.fallback = false;
+    jsvStringIteratorNew(&p.it, str, 0);
+    p.ch = jsvStringIteratorGetChar(&p.it);
+    JsVar *res = jsonParseValue(&p);
+    jsvStringIteratorFree(&p.it);
+    if (!p.fallback) {
+      jsvUnLock(str);
+      return res;
+    }
+    jsvUnLock(res);
+  }
+  // Otherwise use the lexer, which can handle everything (and give errors)
+  JsLex lex;
   JsLex *oldLex = jslSetLex(&lex);
   jslInit(str);
   jsvUnLock(str);
@@ -204,6 +547,179 @@ JsVar *jswrap_json_parse_liberal(JsVar *v, bool noExceptions) {
   return res;
 }
 
+#ifndef SAVE_ON_FLASH
+#define JSON_PARSER_CALLBACK_NAME JS_HIDDEN_CHAR_STR"cb"
+#define JSON_PARSER_BUFFER_NAME JS_HIDDEN_CHAR_STR"buf"
+#define JSON_PARSER_STATE_NAME JS_HIDDEN_CHAR_STR"st"
+// bits in the state of a JSONParser (the rest is the depth of nested objects/arrays)
+#define JSON_PARSER_IN_VALUE 1
+#define JSON_PARSER_IN_STRING 2
+#define JSON_PARSER_ESCAPED 4
+#define JSON_PARSER_DEPTH_SHIFT 3
+
+/*JSON{
+  "type" : "class",
+  "class" : "JSONParser",
+  "ifndef" : "SAVE_ON_FLASH"
+}
+A streaming JSON parser, created with `JSON.parser(callback)`. Data is written
+to it a chunk at a time, and `callback` is called with each complete JSON value
+as soon as all of it has been received.
+*/
+/*JSON{
+  "type" : "staticmethod",
+  "class" : "JSON",
+  "name" : "parser",
+  "ifndef" : "SAVE_ON_FLASH",
+  "generate" : "jswrap_json_parser",
+  "params" : [
+    ["callback","JsVar","A function that is called with each JSON value that is parsed"]
+  ],
+  "return" : ["JsVar","A `JSONParser`"]
+}
+Create a streaming JSON parser. Data can be written to it in chunks with
+`parser.write(data)` (or it can be used as the destination of `pipe`) and
+`callback` is called with each complete JSON value. Values may be split across
+chunks, and one chunk may contain several values (separated by whitespace, or
+just one after the other).
+
+```
+var parser = JSON.parser(function(v) { print(v); });
+parser.write('{"a":1}{"b":');
+parser.write('[2,3]}\n"hello"');  // prints {a:1} then {b:[2,3]} then "hello"
+// or parse a file of newline separated JSON
+require("Storage").open("log","r").pipe(JSON.parser(print));
+```
+
+Only the text of the value that is currently being received is stored, so this
+uses a lot less memory than reading all the data into a String and parsing it.
+*/
+JsVar *jswrap_json_parser(JsVar *callback) {
+  if (!jsvIsFunction(callback)) {
+    jsExceptionHere(JSET_TYPEERROR, "Expecting a callback function, got %t", callback);
+    return 0;
+  }
+  JsVar *parser = jspNewObject(0, "JSONParser");
+  if (parser) jsvObjectSetChild(parser, JSON_PARSER_CALLBACK_NAME, callback);
+  return parser;
+}
+
+/// Parse the buffered text of a complete value and call the callback with it
+static void jswrap_jsonparser_emit(JsVar *parser, JsVar *text) {
+  JsVar *value = jswrap_json_parse(text);
+  if (!jspHasError()) {
+    JsVar *callback = jsvObjectGetChildIfExists(parser, JSON_PARSER_CALLBACK_NAME);
+    jsvUnLock2(jspExecuteFunction(callback, parser, 1, &value), callback);
+  }
+  jsvUnLock(value);
+}
+
+/*JSON{
+  "type" : "method",
+  "class" : "JSONParser",
+  "name" : "write",
+  "ifndef" : "SAVE_ON_FLASH",
+  "generate" : "jswrap_jsonparser_write",
+  "params" : [
+    ["data","JsVar","A String containing the next chunk of JSON"]
+  ]
+}
+Add the next chunk of JSON text. The callback is called (before this returns)
+for each value that this chunk completes.
+*/
+void jswrap_jsonparser_write(JsVar *parser, JsVar *data) {
+  JsVar *chunk = jsvAsString(data);
+  if (!chunk) return;
+  JsVar *buffer = jsvObjectGetChildIfExists(parser, JSON_PARSER_BUFFER_NAME);
+  int state = (int)jsvObjectGetIntegerChild(parser, JSON_PARSER_STATE_NAME);
+  int depth = state >> JSON_PARSER_DEPTH_SHIFT;
+  state &= (1<<JSON_PARSER_DEPTH_SHIFT)-1;
+  size_t start = 0; // where the current value starts in this chunk
+  JsvStringIterator it;
+  jsvStringIteratorNew(&it, chunk, 0);
+  while (jsvStringIteratorHasChar(&it) && !jspHasError()) {
+    char ch = jsvStringIteratorGetChar(&it);
+    size_t idx = jsvStringIteratorGetIndex(&it);
+    jsvStringIteratorNextInline(&it);
+    size_t end = 0; // where the value ends, if 'complete'
+    bool complete = false;
+    if (!(state & JSON_PARSER_IN_VALUE)) {
+      if (isWhitespaceInline(ch)) continue;
+      state |= JSON_PARSER_IN_VALUE;
+      start = idx;
+    }
+    if (state & JSON_PARSER_IN_STRING) {
+      if (state & JSON_PARSER_ESCAPED) state &= ~JSON_PARSER_ESCAPED;
+      else if (ch=='\\') state |= JSON_PARSER_ESCAPED;
+      else if (ch=='"') {
+        state &= ~JSON_PARSER_IN_STRING;
+        if (!depth) { complete = true; end = idx+1; }
+      }
+    } else if (ch=='"') {
+      state |= JSON_PARSER_IN_STRING;
+    } else if (ch=='{' || ch=='[') {
+      depth++;
+    } else if (ch=='}' || ch==']') {
+      if (depth) depth--;
+      if (!depth) { complete = true; end = idx+1; }
+    } else if (!depth && isWhitespaceInline(ch)) {
+      complete = true; // end of a number/true/false/null
+      end = idx;
+    }
+    if (complete) {
+      if (buffer) {
+        jsvAppendStringVar(buffer, chunk, start, end-start);
+      } else {
+        buffer = jsvNewFromStringVar(chunk, start, end-start);
+      }
+      jswrap_jsonparser_emit(parser, buffer);
+      jsvUnLock(buffer);
+      buffer = 0;
+      state = 0;
+    }
+  }
+  jsvStringIteratorFree(&it);
+  if (state & JSON_PARSER_IN_VALUE) { // keep what we have of the current value
+    if (!buffer) buffer = jsvNewFromEmptyString();
+    if (buffer) jsvAppendStringVar(buffer, chunk, start, JSVAPPENDSTRINGVAR_MAXLENGTH);
+  }
+  jsvUnLock(chunk);
+  if (buffer) jsvObjectSetChild(parser, JSON_PARSER_BUFFER_NAME, buffer);
+  else jsvObjectRemoveChild(parser, JSON_PARSER_BUFFER_NAME);
+  jsvUnLock(buffer);
+  jsvObjectSetChildAndUnLock(parser, JSON_PARSER_STATE_NAME, jsvNewFromInteger(state | (depth<<JSON_PARSER_DEPTH_SHIFT)));
+}
+
+/*JSON{
+  "type" : "method",
+  "class" : "JSONParser",
+  "name" : "end",
+  "ifndef" : "SAVE_ON_FLASH",
+  "generate" : "jswrap_jsonparser_end"
+}
+Call this when there is no more data. If there is a value that hasn't been
+ended by whitespace (for instance a number at the very end of the data), the
+callback is called with it. If the data ended part way through a value, an
+exception is thrown.
+*/
+void jswrap_jsonparser_end(JsVar *parser) {
+  JsVar *buffer = jsvObjectGetChildIfExists(parser, JSON_PARSER_BUFFER_NAME);
+  jsvObjectRemoveChild(parser, JSON_PARSER_BUFFER_NAME);
+  jsvObjectRemoveChild(parser, JSON_PARSER_STATE_NAME);
+  if (buffer) jswrap_jsonparser_emit(parser, buffer);
+  jsvUnLock(buffer);
+}
+#endif // SAVE_ON_FLASH
+
+const char *jsfGetFunctionKeyword(JsVar *var) {
+#ifndef ESPR_NO_ASYNC
+  JspFunctionKind kind = jspGetFunctionKind(var);
+  if (kind==JSP_FUNCTION_ASYNC) return "async function";
+  if (kind==JSP_FUNCTION_GENERATOR) return "function*";
+#endif
+  return "function";
+}
+
 /* This is like jsfGetJSONWithCallback, but handles ONLY functions (and does not print the initial 'function' text) */
 void jsfGetJSONForFunctionWithCallback(JsVar *var, JSONFlags flags, vcbprintf_callback user_callback, void *user_data) {
   assert(jsvIsFunction(var));
@@ -493,7 +1009,7 @@ void jsfGetJSONWithCallback(JsVar *var, JsVar *varName, JSONFlags flags, const c
     if (flags & JSON_IGNORE_FUNCTIONS) {
       cbprintf(user_callback, user_data, "undefined");
     } else {
-      cbprintf(user_callback, user_data, "function ");
+      cbprintf(user_callback, user_data, "%s ", jsfGetFunctionKeyword(var));
       jsfGetJSONForFunctionWithCallback(var, nflags, user_callback, user_data);
     }
   } else if ((jsvIsString(var) && !jsvIsName(var)) || ((flags&JSON_PIN_TO_STRING)&&jsvIsPin(var))) {
@@ -530,6 +1046,47 @@ void jsfGetJSON(JsVar *var, JsVar *result, JSONFlags flags) {
   jsfGetJSONWhitespace(var, result, flags, 0);
 }
 
+typedef struct {
+  char buf[JSON_CHUNK_SIZE];
+  size_t len; ///< characters in buf
+  size_t offset; ///< characters output before those in buf
+  JsonChunkCallback callback;
+  void *user_data;
+  bool error;
+} JsonChunkWriter;
+
+static void jsfJSONChunkFlush(JsonChunkWriter *w) {
+  if (w->len && w->callback && !w->error) {
+    JsVar *chunk = jsvNewStringOfLength((unsigned int)w->len, w->buf);
+    if (!chunk || !w->callback(chunk, w->offset, w->user_data))
+      w->error = true;
+    jsvUnLock(chunk);
+  }
+  w->offset += w->len;
+  w->len = 0;
+}
+
+static void jsfJSONChunkCallback(const char *str, void *user_data) {
+  JsonChunkWriter *w = (JsonChunkWriter*)user_data;
+  while (*str) {
+    if (w->len >= JSON_CHUNK_SIZE)
+      jsfJSONChunkFlush(w);
+    w->buf[w->len++] = *(str++);
+  }
+}
+
+int jsfGetJSONChunked(JsVar *var, JSONFlags flags, const char *whitespace, JsonChunkCallback callback, void *user_data) {
+  JsonChunkWriter w;
+  w.len = 0;
+  w.offset = 0;
+  w.callback = callback;
+  w.user_data = user_data;
+  w.error = false;
+  jsfGetJSONWithCallback(var, NULL, flags, whitespace, jsfJSONChunkCallback, &w);
+  jsfJSONChunkFlush(&w);
+  return w.error ? -1 : (int)w.offset;
+}
+
 void jsfPrintJSON(JsVar *var, JSONFlags flags) {
   jsfGetJSONWithCallback(var, NULL, flags, 0, vcbprintf_callback_jsiConsolePrintString, 0);
 }
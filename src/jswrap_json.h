@@ -38,11 +38,21 @@ typedef enum {
 } JSONFlags;
 
 JsVar *jswrap_json_stringify(JsVar *v, JsVar *replacer, JsVar *space);
+#ifndef SAVE_ON_FLASH
+bool jswrap_json_write(JsVar *destination, JsVar *data, JsVar *space);
+#endif
 JsVar *jswrap_json_parse_ext(JsVar *v, JSONFlags flags);
 /// Parse whatever we can (even if not 100% JSON). If noExceptions, we don't set any exceptions on error, just return 0
 JsVar *jswrap_json_parse_liberal(JsVar *v, bool noExceptions);
 JsVar *jswrap_json_parse(JsVar *v);
+#ifndef SAVE_ON_FLASH
+JsVar *jswrap_json_parser(JsVar *callback);
+void jswrap_jsonparser_write(JsVar *parser, JsVar *data);
+void jswrap_jsonparser_end(JsVar *parser);
+#endif
 
+/// The text that goes before a function's arguments - 'function', 'async function' or 'function*'
+const char *jsfGetFunctionKeyword(JsVar *var);
 /* This is like jsfGetJSONWithCallback, but handles ONLY functions (and does not print the initial 'function' text) */
 void jsfGetJSONForFunctionWithCallback(JsVar *var, JSONFlags flags, vcbprintf_callback user_callback, void *user_data);
 /* Dump to JSON, using the given callbacks for printing data
@@ -58,6 +68,15 @@ void jsfGetJSONWhitespace(JsVar *var, JsVar *result, JSONFlags flags, const char
 /* Convenience function for using jsfGetJSONWithCallback - print to var */
 void jsfGetJSON(JsVar *var, JsVar *result, JSONFlags flags);
 
+/// How many characters of JSON jsfGetJSONChunked outputs at once
+#define JSON_CHUNK_SIZE 64
+/// Called by jsfGetJSONChunked with each chunk of JSON, and its offset in the output. Return false on error.
+typedef bool (*JsonChunkCallback)(JsVar *chunk, size_t offset, void *user_data);
+/* Convert to JSON, calling callback with each JSON_CHUNK_SIZE chunk so the whole String
+is never in memory at once. If callback=0 nothing is output, but the length is still
+worked out. Returns the length of the JSON, or -1 if callback returned false */
+int jsfGetJSONChunked(JsVar *var, JSONFlags flags, const char *whitespace, JsonChunkCallback callback, void *user_data);
+
 /* Convenience function for using jsfGetJSONWithCallback - print to console */
 void jsfPrintJSON(JsVar *var, JSONFlags flags);
 /* Convenience function for using jsfGetJSONForFunctionWithCallback - print to console */
@@ -202,6 +202,14 @@ memory usage.
   Note that this is INCLUDED in the figure for 'free'
 * `gc` : Memory freed during the GC pass
 * `gctime` : Time taken for GC pass (in milliseconds)
+* `gcpauses` : [2v30+] An array containing how many times JavaScript execution has been
+  paused for garbage collection for `<0.1ms`, `<1ms`, `<10ms` and `>=10ms` (see `gcBudget`
+  in `E.setFlags` to make GC pauses shorter)
+* `gcmaxpause` : [2v30+] The longest time JavaScript execution has been paused for
+  garbage collection (in milliseconds)
+* `gcslices` : [2v30+] How many slices of incremental garbage collection have
+  been run (see `gcBudget` in `E.setFlags`)
+* `gccycles` : [2v30+] How many incremental garbage collections have completed
 * `blocksize` : Size of a block (variable) in bytes
 * `stackEndAddress` : (on ARM) the address (that can be used with peek/poke/etc)
   of the END of the stack. The stack grows down, so unless you do a lot of
@@ -258,6 +266,19 @@ JsVar *jswrap_process_memory(JsVar *gc) {
       jsvObjectSetIntChild(obj, "gc", (JsVarInt)varsGCd);
       jsvObjectSetFloatChild(obj, "gctime", jshGetMillisecondsFromTime(time2-time1));
     }
+#ifndef ESPR_NO_INCREMENTAL_GC
+    unsigned int pauses[JSV_GC_PAUSE_BUCKETS];
+    JsVarFloat maxPause = jsvGarbageCollectGetPauses(pauses);
+    JsVar *pausesVar = jsvNewEmptyArray();
+    for (int i=0;i<JSV_GC_PAUSE_BUCKETS;i++)
+      jsvArrayPushAndUnLock(pausesVar, jsvNewFromInteger((JsVarInt)pauses[i]));
+    jsvObjectSetChildAndUnLock(obj, "gcpauses", pausesVar);
+    jsvObjectSetFloatChild(obj, "gcmaxpause", maxPause);
+    unsigned int slices, cycles;
+    jsvGarbageCollectGetIncrementalCounts(&slices, &cycles);
+    jsvObjectSetIntChild(obj, "gcslices", (JsVarInt)slices);
+    jsvObjectSetIntChild(obj, "gccycles", (JsVarInt)cycles);
+#endif
     jsvObjectSetIntChild(obj, "blocksize", sizeof(JsVar));
 #ifndef SAVE_ON_FLASH
     JsVar *rx = jsvNewObject();
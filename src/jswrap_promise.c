@@ -38,6 +38,7 @@
 #define JS_PROMISE_PROM_NAME "prom" ///< Prombox: link to promise
 #define JS_PROMISE_NEXTBOX_NAME "next" ///< Reaction: link to next PromBox
 #define JS_PROMISE_CALLBACK_NAME "cb" ///< Reaction: link to callback function
+#define JS_PROMISE_ASYNC_NAME JS_HIDDEN_CHAR_STR"prm" ///< async function's coroutine: the Promise it returned
 
 
 
@@ -278,6 +279,61 @@ static JsVar *jspromise_create_prombox(JsVar ** promise) {
   return box;
 }
 
+#ifndef ESPR_NO_ASYNC
+static void _jswrap_promise_async_resolved(JsVar *coroutine, JsVar *data);
+static void _jswrap_promise_async_rejected(JsVar *coroutine, JsVar *data);
+
+/* Run an async function until it next awaits something, and carry on when that
+ * resolves. When it finishes, resolve (or reject) the Promise it returned */
+static void _jswrap_promise_async_step(JsVar *coroutine, JsVar *data, bool isRejected) {
+  bool isDone;
+  // emulates try
+  JsExecFlags oldExecute = execInfo.execute;
+  JsVar *result = jspCoroutineResume(coroutine, data, isRejected, &isDone);
+  bool threw = (execInfo.execute & EXEC_EXCEPTION)!=0;
+  execInfo.execute = oldExecute; // if there were errors executing the function, get rid of them
+  JsVar *exception = jspGetException();
+  if (threw) {
+    jsvUnLock(result);
+    result = exception;
+    isDone = true;
+  } else
+    jsvUnLock(exception);
+  if (isDone) {
+    JsVar *promise = jsvObjectGetChildIfExists(coroutine, JS_PROMISE_ASYNC_NAME);
+    jsvObjectRemoveChild(coroutine, JS_PROMISE_ASYNC_NAME);
+    if (threw) jspromise_reject(promise, result);
+    else jspromise_resolve(promise, result);
+    jsvUnLock(promise);
+  } else {
+    // wait for what we awaited (turning it into a Promise if it wasn't one)
+    JsVar *awaited = jswrap_promise_resolve(result);
+    JsVar *onResolved = _jswrap_promise_native_with_prombox(_jswrap_promise_async_resolved, coroutine);
+    JsVar *onRejected = _jswrap_promise_native_with_prombox(_jswrap_promise_async_rejected, coroutine);
+    if (awaited && onResolved && onRejected)
+      jsvUnLock(jswrap_promise_then(awaited, onResolved, onRejected));
+    jsvUnLock3(awaited, onResolved, onRejected);
+  }
+  jsvUnLock(result);
+}
+
+static void _jswrap_promise_async_resolved(JsVar *coroutine, JsVar *data) {
+  _jswrap_promise_async_step(coroutine, data, false);
+}
+
+static void _jswrap_promise_async_rejected(JsVar *coroutine, JsVar *data) {
+  _jswrap_promise_async_step(coroutine, data, true);
+}
+
+JsVar *jspromise_async(JsVar *coroutine) {
+  JsVar *promise = jspromise_create();
+  if (!promise) return 0;
+  jsvObjectSetChild(coroutine, JS_PROMISE_ASYNC_NAME, promise);
+  _jswrap_promise_async_step(coroutine, 0, false);
+  return promise;
+}
+#endif // ESPR_NO_ASYNC
+
 /*JSON{
   "type" : "constructor",
   "class" : "Promise",
@@ -25,6 +25,10 @@ JsVar *jspromise_create();
 void jspromise_resolve(JsVar *promise, JsVar *data);
 /// Reject the given promise
 void jspromise_reject(JsVar *promise, JsVar *data);
+#ifndef ESPR_NO_ASYNC
+/// Start running an async function (from the object jspeFunctionCall made for it) and return its Promise
+JsVar *jspromise_async(JsVar *coroutine);
+#endif
 
 JsVar *jswrap_promise_constructor(JsVar *executor);
 JsVar *jswrap_promise_all(JsVar *arr);
@@ -39,6 +39,16 @@ const int STORAGEFILE_CHUNKSIZE =
   (FLASH_PAGE_SIZE*10) - sizeof(JsfFileHeader);
 #endif
 
+#define STORAGEFILE_INDEX_NAME JS_HIDDEN_CHAR_STR"idx" ///< StorageFile: flat string of StorageFileIndexEntry, one per chunk plus one for the end of the file
+#define STORAGEFILE_BUFFER_NAME JS_HIDDEN_CHAR_STR"buf" ///< StorageFile: data from 'write' that hasn't been written to flash yet
+#define STORAGEFILE_BUFFERSIZE_NAME JS_HIDDEN_CHAR_STR"bsz" ///< StorageFile: amount of data to buffer before writing to flash
+
+/// Index entry for a StorageFile chunk, so we can seek without reading the whole file each time
+typedef struct {
+  uint32_t offset; ///< Offset in the file of the start of this chunk (for the last entry, the file length)
+  uint32_t line; ///< Number of newlines before this chunk (for the last entry, the number of lines in the file)
+} StorageFileIndexEntry;
+
 /*JSON{
   "type" : "library",
   "class" : "Storage"
@@ -206,11 +216,14 @@ JsVar *jswrap_storage_readArrayBuffer(JsVar *name) {
   "params" : [
     ["name","JsVar","The filename - max 28 characters (case sensitive)"],
     ["data","JsVar","The data to write"],
-    ["offset","int","[optional] The offset within the file to write (if `0`/`undefined` a new file is created, otherwise Espruino attempts to write within an existing file if one exists)"],
+    ["offset","JsVar","[optional] The offset within the file to write (if `0`/`undefined` a new file is created, otherwise Espruino attempts to write within an existing file if one exists), or an options object `{compress:true}`"],
     ["size","int","[optional] The size of the file (if a file is to be created that is bigger than the data)"]
   ],
   "return" : ["bool","True on success, false on failure"],
-  "typescript" : "write(name: string | ArrayBuffer | ArrayBufferView | number[] | object, data: any, offset?: number, size?: number): boolean;"
+  "typescript" : [
+    "write(name: string | ArrayBuffer | ArrayBufferView | number[] | object, data: any, offset?: number, size?: number): boolean;",
+    "write(name: string, data: any, options: { compress?: boolean }): boolean;"
+  ]
 }
 Write/create a file in the flash storage area. This is nonvolatile and will not
 disappear when the device resets or power is lost.
@@ -248,10 +261,27 @@ This can be useful if you've got more data to write than you have RAM
 available - for instance the Web IDE uses this method to write large files into
 onboard storage.
 
+If `{compress:true}` is supplied instead of an offset, the file is stored
+heatshrink compressed (unless that doesn't make it any smaller). Compressed
+files are decompressed automatically by `read`, `readJSON`, `readArrayBuffer`,
+`load` and `require`, but they are read into RAM rather than being accessed
+directly from flash, and can't be written to with an offset:
+
+```
+require("Storage").write("app.js", code, {compress:true});
+```
+
 **Note:** This function should be used with normal files, and not `StorageFile`s
 created with `require("Storage").open(filename, ...)`
 */
-bool jswrap_storage_write(JsVar *name, JsVar *data, JsVarInt offset, JsVarInt _size) {
+bool jswrap_storage_write(JsVar *name, JsVar *data, JsVar *offsetOrOptions, JsVarInt _size) {
+  JsVarInt offset = 0;
+  bool compress = false;
+  if (jsvIsObject(offsetOrOptions)) {
+    compress = jsvObjectGetBoolChild(offsetOrOptions, "compress");
+    _size = 0;
+  } else
+    offset = jsvGetInteger(offsetOrOptions);
   JsVar *d;
   if (jsvIsObject(data)) {
     d = jswrap_json_stringify(data,0,0);
@@ -259,7 +289,15 @@ bool jswrap_storage_write(JsVar *name, JsVar *data, JsVarInt offset, JsVarInt _s
     _size = 0;
   } else
     d = jsvLockAgainSafe(data);
-  bool success = jsfWriteFile(jsfNameFromVar(name), d, JSFF_NONE, offset, _size);
+  bool success;
+#ifdef ESPR_STORAGE_COMPRESSION
+  if (compress)
+    success = jsfWriteCompressedFile(jsfNameFromVar(name), d);
+  else
+#else
+  NOT_USED(compress);
+#endif
+    success = jsfWriteFile(jsfNameFromVar(name), d, JSFF_NONE, offset, _size);
   jsvUnLock(d);
   return success;
 }
@@ -286,6 +324,10 @@ file, and `require("Storage").readJSON("MyFile")` to read it.
 
 This is (almost) equivalent to `require("Storage").write(name, JSON.stringify(data))` (see the notes below)
 
+The JSON is written into the file a few characters at a time, so (unlike
+using `JSON.stringify`) there doesn't have to be enough free memory to hold the
+whole JSON String.
+
 **Note:** This function should be used with normal files, and not `StorageFile`s
 created with `require("Storage").open(filename, ...)`
 
@@ -296,14 +338,53 @@ string but contained characters in the UTF8 codepoint range, when saved it won't
 It does mean that you cannot parse the file with just `JSON.parse` as it's no longer standard JSON but is JS,
 so you must use `Storage.readJSON`
 */
+typedef struct {
+  JsfFileName name;
+  int size;
+} StorageJSONWriter;
+
+/// jsfGetJSONChunked callback that checks the chunk matches what's already in the file
+static bool jswrap_storage_writeJSON_compare(JsVar *chunk, size_t offset, void *user_data) {
+  StorageJSONWriter *w = (StorageJSONWriter*)user_data;
+  JsVar *existing = jsfReadFile(w->name, (int)offset, (int)jsvGetStringLength(chunk));
+  bool equal = existing && jsvCompareString(existing, chunk, 0, 0, true)==0;
+  jsvUnLock(existing);
+  return equal;
+}
+
+/// jsfGetJSONChunked callback that writes the chunk into the file
+static bool jswrap_storage_writeJSON_write(JsVar *chunk, size_t offset, void *user_data) {
+  StorageJSONWriter *w = (StorageJSONWriter*)user_data;
+  return jsfWriteFile(w->name, chunk, JSFF_NONE, (JsVarInt)offset, w->size);
+}
+
 bool jswrap_storage_writeJSON(JsVar *name, JsVar *data) {
-  JsVar *d = jsvNewFromEmptyString();
-  if (!d) return false;
   /* Don't call jswrap_json_stringify directly because we want to ensure we don't use JSON_JSON_COMPATIBILE, so
   String escapes like `\xFC` stay as `\xFC` and not `\u00FC` to save space and help with unicode compatibility
   */
-  jsfGetJSON(data, d, (JSON_DROP_QUOTES|JSON_IGNORE_FUNCTIONS|JSON_NO_UNDEFINED|JSON_ARRAYBUFFER_AS_ARRAY|JSON_JSON_COMPATIBILE|JSON_ALLOW_TOJSON) &~JSON_ALL_UNICODE_ESCAPE);
-  bool r = jsfWriteFile(jsfNameFromVar(name), d, JSFF_NONE, 0, 0);
+  JSONFlags flags = (JSON_DROP_QUOTES|JSON_IGNORE_FUNCTIONS|JSON_NO_UNDEFINED|JSON_ARRAYBUFFER_AS_ARRAY|JSON_JSON_COMPATIBILE|JSON_ALLOW_TOJSON) &~JSON_ALL_UNICODE_ESCAPE;
+  /* Work out how long the JSON is, then create the file and write the JSON
+  into it a chunk at a time, so we never need the whole JSON String in RAM */
+  StorageJSONWriter w;
+  w.name = jsfNameFromVar(name);
+  w.size = jsfGetJSONChunked(data, flags, 0, 0, 0);
+  if (w.size<=0) return false;
+  JsfFileHeader header;
+  if (jsfFindFile(w.name, &header) &&
+      jsfGetFileFlags(&header)==JSFF_NONE &&
+      (int)jsfGetFileSize(&header)==w.size &&
+      jsfGetJSONChunked(data, flags, 0, jswrap_storage_writeJSON_compare, &w)==w.size)
+    return true; // file already contains this JSON - don't write it again
+  if (jspHasError()) return false;
+  if (jsfGetJSONChunked(data, flags, 0, jswrap_storage_writeJSON_write, &w)==w.size)
+    return true;
+  if (jspHasError()) return false;
+  /* If writing failed it could be because a toJSON function returned something
+  different the second time - so just do it all at once in RAM */
+  JsVar *d = jsvNewFromEmptyString();
+  if (!d) return false;
+  jsfGetJSON(data, d, flags);
+  bool r = jsfWriteFile(w.name, d, JSFF_NONE, 0, 0);
   jsvUnLock(d);
   return r;
 }
@@ -406,6 +487,11 @@ when it is running low on flash, or when `compact` is called.
 `compact` may fail if there isn't enough RAM free on the stack to use as swap
 space, however in this case it will not lose data.
 
+On Bangle.js and Linux builds, when Storage drops below 25% free space and has
+trash files to reclaim, it is also compacted in the background, a few files at a
+time while Espruino is idle. Each step is journaled, so it is completed on the
+next boot if power is lost part way through.
+
 **Note:** `compact` rearranges the contents of memory. If code is referencing
 that memory (e.g. functions that have their code stored in flash) then they may
 become garbled when compaction happens. To avoid this, call `eraseFiles` before
@@ -476,9 +562,14 @@ Returns:
   fileCount // How many allocated files do we have?
   trashBytes // How many bytes of trash files do we have?
   trashCount // How many trash files do we have? (can be cleared with .compact)
+  eraseCountMin // On some devices: average times a page has been erased, in the least erased area
+  eraseCountMax // On some devices: average times a page has been erased, in the most erased area
 }
 ```
 
+Where erases are counted, Espruino also slowly moves files that never change
+off the least erased parts of Storage when idle, so wear is spread out.
+
 **NOTE:** `checkInternalFlash` is only useful on DICKENS/BANGLEJS2_IFLASH devices - other devices don't use two different flash banks
  */
 JsVar *jswrap_storage_getStats(JsVar *checkInternalFlash) {
@@ -510,6 +601,12 @@ JsVar *jswrap_storage_getStats(JsVar *checkInternalFlash) {
   jsvObjectSetIntChild(o, "fileCount", (JsVarInt)stats.fileCount);
   jsvObjectSetIntChild(o, "trashBytes", (JsVarInt)stats.trashBytes);
   jsvObjectSetIntChild(o, "trashCount", (JsVarInt)stats.trashCount);
+#ifdef ESPR_STORAGE_WEAR_LEVEL
+  uint32_t eraseCountMin, eraseCountMax;
+  jsfGetWearStats(&eraseCountMin, &eraseCountMax);
+  jsvObjectSetIntChild(o, "eraseCountMin", (JsVarInt)eraseCountMin);
+  jsvObjectSetIntChild(o, "eraseCountMax", (JsVarInt)eraseCountMax);
+#endif
   return o;
 }
 
@@ -537,21 +634,24 @@ void jswrap_storage_optimise() {
   "generate" : "jswrap_storage_open",
   "params" : [
     ["name","JsVar","The filename - max **27** characters (case sensitive)"],
-    ["mode","JsVar","The open mode - must be either `'r'` for read,`'w'` for write , or `'a'` for append"]
+    ["mode","JsVar","The open mode - must be either `'r'` for read,`'w'` for write , or `'a'` for append"],
+    ["options","JsVar",["[optional] An object `{ buffer : int=0 }`","buffer : if nonzero, `write` calls are collected in RAM and only written to flash once this many bytes are pending (or `flush` is called)"]]
   ],
   "return" : ["JsVar","An object containing {read,write,erase}"],
   "return_object" : "StorageFile",
-  "typescript" : "open(name: string, mode: \"r\" | \"w\" | \"a\"): StorageFile;"
+  "typescript" : "open(name: string, mode: \"r\" | \"w\" | \"a\", options?: { buffer?: number }): StorageFile;"
 }
 Open a file in the Storage area. This can be used for appending data
 (normal read/write operations only write the entire file).
 
 Please see `StorageFile` for more information (and examples).
 
-**Note:** These files write through immediately - they do not need closing.
+**Note:** These files write through immediately - they do not need closing -
+unless the `buffer` option is used, in which case you must call `flush()` to
+be sure all data has been written to flash.
 
 */
-JsVar *jswrap_storage_open(JsVar *name, JsVar *modeVar) {
+JsVar *jswrap_storage_open(JsVar *name, JsVar *modeVar, JsVar *options) {
   char mode = 0;
   if (jsvIsStringEqual(modeVar,"r")) mode='r';
   else if (jsvIsStringEqual(modeVar,"w")) mode='w';
@@ -630,6 +730,13 @@ JsVar *jswrap_storage_open(JsVar *name, JsVar *modeVar) {
   jsvObjectSetIntChild(f,"chunk", chunk);
   jsvObjectSetIntChild(f,"offset", offset);
   jsvObjectSetIntChild(f,"mode", mode);
+  if (jsvIsObject(options) && mode!='r') {
+    int bufferSize = jsvObjectGetIntegerChild(options,"buffer");
+    // we can only write one chunk boundary at a time, so don't buffer more than a chunk
+    if (bufferSize>STORAGEFILE_CHUNKSIZE) bufferSize = STORAGEFILE_CHUNKSIZE;
+    if (bufferSize>0)
+      jsvObjectSetIntChild(f,STORAGEFILE_BUFFERSIZE_NAME, bufferSize);
+  }
 
   return f;
 }
@@ -681,11 +788,116 @@ f.readLine() // undefined
 f.erase();
 ```
 
+To read just the end of a large file (for instance the last hour of a data log)
+you can use `seek` or `seekLine`. The first time either is called, the file is
+read once to build an index of where each chunk starts and how many lines
+come before it - after that, seeks only need to read the one chunk they land in.
+
+```
+f = require("Storage").open("log","r");
+f.seekLine(-60); // go to the start of the last 60 lines
+var l;
+while ((l=f.readLine())!==undefined) print(l);
+```
+
+When appending lots of small amounts of data, `{buffer:bytes}` can be passed as
+the third argument to `require("Storage").open` so that `write` calls are
+collected in RAM and written to flash in one go. Data in the buffer will be
+lost if Espruino is reset, so call `flush()` when you need it written.
+
 **Note:** `StorageFile` uses the fact that all bits of erased flash memory are 1
 to detect the end of a file. As such you should not write character code 255
 (`"\xFF"`) to these files.
 */
 
+/// Get the StorageFile's filename, and return the index of the character that holds the chunk number
+static int jswrap_storagefile_getFileName(JsVar *f, JsfFileName *fname) {
+  *fname = jsfNameFromVarAndUnLock(jsvObjectGetChildIfExists(f,"name"));
+  int fnamei = sizeof(*fname)-1;
+  while (fnamei && fname->c[fnamei-1]==0) fnamei--;
+  return fnamei;
+}
+
+/* Scan the chunk at 'addr' up to the first 0xFF (the end of written data). If
+'stopAtLine' is nonzero, stop just after that many newlines have been found.
+Returns the amount of bytes scanned, and updates 'lines' and 'lastCh' */
+static uint32_t jswrap_storagefile_scanChunk(uint32_t addr, uint32_t fileLen, uint32_t stopAtLine, uint32_t *lines, char *lastCh) {
+  char buf[64];
+  uint32_t offset = 0;
+  uint32_t foundLines = 0;
+  bool foundEnd = false;
+  while (!foundEnd && offset<fileLen) {
+    uint32_t l = fileLen - offset;
+    if (l>sizeof(buf)) l=sizeof(buf);
+    jshFlashRead(buf, addr+offset, l);
+    for (uint32_t i=0;i<l;i++) {
+      if (buf[i]==(char)255) {
+        l = i;
+        foundEnd = true;
+        break;
+      }
+      if (buf[i]=='\n' && ++foundLines==stopAtLine) {
+        l = i+1;
+        foundEnd = true;
+        break;
+      }
+    }
+    if (l) *lastCh = buf[l-1];
+    offset += l;
+  }
+  *lines += foundLines;
+  return offset;
+}
+
+static StorageFileIndexEntry jswrap_storagefile_getIndexEntry(JsVar *idx, int n) {
+  StorageFileIndexEntry e;
+  // flat strings may not be word aligned, so copy rather than casting
+  memcpy(&e, jsvGetFlatStringPointer(idx)+(size_t)n*sizeof(e), sizeof(e));
+  return e;
+}
+
+/// Get the number of chunks in this index (there is one more entry than chunks)
+static int jswrap_storagefile_getIndexChunks(JsVar *idx) {
+  return (int)(jsvGetStringLength(idx) / sizeof(StorageFileIndexEntry)) - 1;
+}
+
+/// Return the index of chunk offsets and line counts for this StorageFile, building it if it doesn't exist
+static JsVar *jswrap_storagefile_getIndex(JsVar *f) {
+  JsVar *idx = jsvObjectGetChildIfExists(f,STORAGEFILE_INDEX_NAME);
+  if (idx) return idx;
+
+  JsfFileName fname;
+  int fnamei = jswrap_storagefile_getFileName(f, &fname);
+  JsfFileHeader header;
+  int chunks = 0;
+  while (chunks<255) {
+    fname.c[fnamei]=(char)(chunks+1);
+    if (!jsfFindFile(fname, &header)) break;
+    chunks++;
+  }
+  idx = jsvNewFlatStringOfLength((unsigned int)((size_t)(chunks+1)*sizeof(StorageFileIndexEntry)));
+  if (!idx) {
+    jsExceptionHere(JSET_ERROR, "Not enough memory to index StorageFile");
+    return 0;
+  }
+  char *ptr = jsvGetFlatStringPointer(idx);
+  StorageFileIndexEntry e = { .offset = 0, .line = 0 };
+  char lastCh = '\n';
+  for (int c=0;c<chunks;c++) {
+    memcpy(ptr+(size_t)c*sizeof(e), &e, sizeof(e));
+    fname.c[fnamei]=(char)(c+1);
+    uint32_t addr = jsfFindFile(fname, &header);
+    if (addr)
+      e.offset += jswrap_storagefile_scanChunk(addr, jsfGetFileSize(&header), 0, &e.line, &lastCh);
+  }
+  // a final line without a newline still counts as a line
+  if (e.offset && lastCh!='\n') e.line++;
+  memcpy(ptr+(size_t)chunks*sizeof(e), &e, sizeof(e));
+  DBG("Index %d chunks, %d bytes, %d lines\n", chunks, e.offset, e.line);
+  jsvObjectSetChild(f,STORAGEFILE_INDEX_NAME,idx);
+  return idx;
+}
+
 JsVar *jswrap_storagefile_read_internal(JsVar *f, int len) {
   bool isReadLine = len<0;
   char mode = (char)jsvObjectGetIntegerChild(f,"mode");
@@ -798,6 +1010,117 @@ Read a line of data from the file (up to and including `"\n"`)
 JsVar *jswrap_storagefile_readLine(JsVar *f) {
   return jswrap_storagefile_read_internal(f,-1);
 }
+
+/// Set the read position of a StorageFile
+static void jswrap_storagefile_setPosition(JsVar *f, int chunk, int offset) {
+  jsvObjectSetIntChild(f,"chunk", chunk);
+  jsvObjectSetIntChild(f,"offset", offset);
+}
+
+/*JSON{
+  "type" : "method",
+  "ifndef" : "SAVE_ON_FLASH",
+  "class" : "StorageFile",
+  "name" : "seek",
+  "generate" : "jswrap_storagefile_seek",
+  "params" : [
+    ["position","int","The offset in bytes from the start of the file (or from the end if negative)"]
+  ]
+}
+Move the position that `read`/`readLine` will next read from.
+
+The first call to `seek` or `seekLine` reads the whole file to build an index
+of it, but subsequent calls are fast.
+*/
+void jswrap_storagefile_seek(JsVar *f, int position) {
+  char mode = (char)jsvObjectGetIntegerChild(f,"mode");
+  if (mode!='r') {
+    jsExceptionHere(JSET_ERROR, "Can't seek in this mode");
+    return;
+  }
+  JsVar *idx = jswrap_storagefile_getIndex(f);
+  if (!idx) return;
+  int chunks = jswrap_storagefile_getIndexChunks(idx);
+  int length = (int)jswrap_storagefile_getIndexEntry(idx, chunks).offset;
+  if (position<0) position += length;
+  if (position<0) position = 0;
+  if (position>length) position = length;
+  if (!chunks) {
+    jsvUnLock(idx);
+    jswrap_storagefile_setPosition(f, 1, 0);
+    return;
+  }
+  // binary search for the last chunk that starts at or before 'position'
+  int lo = 0, hi = chunks-1;
+  while (lo<hi) {
+    int mid = (lo+hi+1)/2;
+    if ((int)jswrap_storagefile_getIndexEntry(idx, mid).offset <= position) lo = mid;
+    else hi = mid-1;
+  }
+  int offset = position - (int)jswrap_storagefile_getIndexEntry(idx, lo).offset;
+  jsvUnLock(idx);
+  jswrap_storagefile_setPosition(f, lo+1, offset);
+}
+
+/*JSON{
+  "type" : "method",
+  "ifndef" : "SAVE_ON_FLASH",
+  "class" : "StorageFile",
+  "name" : "seekLine",
+  "generate" : "jswrap_storagefile_seekLine",
+  "params" : [
+    ["line","int","The line number to move to, starting at 0 (or counting back from the end if negative)"]
+  ]
+}
+Move the position that `read`/`readLine` will next read from to the start of the
+given line. For example `f.seekLine(-10)` will allow the last 10 lines of the
+file to be read with `readLine`.
+
+The first call to `seek` or `seekLine` reads the whole file to build an index
+of it, but subsequent calls only need to read a single chunk.
+*/
+void jswrap_storagefile_seekLine(JsVar *f, int line) {
+  char mode = (char)jsvObjectGetIntegerChild(f,"mode");
+  if (mode!='r') {
+    jsExceptionHere(JSET_ERROR, "Can't seek in this mode");
+    return;
+  }
+  JsVar *idx = jswrap_storagefile_getIndex(f);
+  if (!idx) return;
+  int chunks = jswrap_storagefile_getIndexChunks(idx);
+  StorageFileIndexEntry end = jswrap_storagefile_getIndexEntry(idx, chunks);
+  if (line<0) line += (int)end.line;
+  if (line<=0 || !chunks) {
+    jsvUnLock(idx);
+    jswrap_storagefile_setPosition(f, 1, 0);
+    return;
+  }
+  // Line 'n' starts just after the n-th newline, so binary search for the last
+  // chunk with less than 'line' newlines before it - that newline is in this chunk
+  int lo = 0, hi = chunks-1;
+  while (lo<hi) {
+    int mid = (lo+hi+1)/2;
+    if ((int)jswrap_storagefile_getIndexEntry(idx, mid).line < line) lo = mid;
+    else hi = mid-1;
+  }
+  StorageFileIndexEntry e = jswrap_storagefile_getIndexEntry(idx, lo);
+  uint32_t lastChunkStart = jswrap_storagefile_getIndexEntry(idx, chunks-1).offset;
+  jsvUnLock(idx);
+  JsfFileName fname;
+  int fnamei = jswrap_storagefile_getFileName(f, &fname);
+  fname.c[fnamei]=(char)(lo+1);
+  JsfFileHeader header;
+  uint32_t addr = jsfFindFile(fname, &header);
+  uint32_t lines = 0;
+  char lastCh = 0;
+  uint32_t wanted = (uint32_t)line - e.line;
+  int offset = addr ? (int)jswrap_storagefile_scanChunk(addr, jsfGetFileSize(&header), wanted, &lines, &lastCh) : 0;
+  if (lines<wanted) { // past the last line - go to the end of the file
+    lo = chunks-1;
+    offset = (int)(end.offset - lastChunkStart);
+  }
+  jswrap_storagefile_setPosition(f, lo+1, offset);
+}
 /*JSON{
   "type" : "method",
   "ifndef" : "SAVE_ON_FLASH",
@@ -809,9 +1132,22 @@ JsVar *jswrap_storagefile_readLine(JsVar *f) {
 Return the length of the current file.
 
 This requires Espruino to read the file from scratch, which is not a fast
-operation.
+operation (unless `seek` or `seekLine` has already been called, in which case
+the file's index is used).
 */
 int jswrap_storagefile_getLength(JsVar *f) {
+  // Add any data that is buffered but not yet written
+  int pending = 0;
+  JsVar *buf = jsvObjectGetChildIfExists(f,STORAGEFILE_BUFFER_NAME);
+  if (buf) pending = (int)jsvGetStringLength(buf);
+  jsvUnLock(buf);
+  // If we have an index, use that
+  JsVar *idx = jsvObjectGetChildIfExists(f,STORAGEFILE_INDEX_NAME);
+  if (idx) {
+    int length = (int)jswrap_storagefile_getIndexEntry(idx, jswrap_storagefile_getIndexChunks(idx)).offset;
+    jsvUnLock(idx);
+    return length + pending;
+  }
   // Get name and position of name digit
   JsVar *n = jsvObjectGetChildIfExists(f,"name");
   JsfFileName fname = jsfNameFromVar(n);
@@ -858,7 +1194,7 @@ int jswrap_storagefile_getLength(JsVar *f) {
     }
   }
   length += offset;
-  return length;
+  return length + pending;
 }
 
 
@@ -876,8 +1212,12 @@ int jswrap_storagefile_getLength(JsVar *f) {
 }
 Append the given data to a file. You should not attempt to append `"\xFF"`
 (character code 255).
+
+If the file was opened with the `buffer` option, the data may be held in RAM
+until enough has been written (or `flush` is called).
 */
-void jswrap_storagefile_write(JsVar *f, JsVar *_data) {
+/// Write data straight to flash, ignoring any buffering
+static void jswrap_storagefile_write_flash(JsVar *f, JsVar *_data) {
   char mode = (char)jsvObjectGetIntegerChild(f,"mode");
   if (mode!='w' && mode!='a') {
     jsExceptionHere(JSET_ERROR, "Can't write in this mode");
@@ -961,6 +1301,53 @@ void jswrap_storagefile_write(JsVar *f, JsVar *_data) {
   jsvUnLock(data);
 }
 
+void jswrap_storagefile_write(JsVar *f, JsVar *_data) {
+  // any write means the index (if we had one) is out of date
+  jsvObjectRemoveChild(f,STORAGEFILE_INDEX_NAME);
+  int bufferSize = jsvObjectGetIntegerChild(f,STORAGEFILE_BUFFERSIZE_NAME);
+  if (bufferSize<=0) {
+    jswrap_storagefile_write_flash(f, _data);
+    return;
+  }
+  char mode = (char)jsvObjectGetIntegerChild(f,"mode");
+  if (mode!='w' && mode!='a') {
+    jsExceptionHere(JSET_ERROR, "Can't write in this mode");
+    return;
+  }
+  JsVar *data = jsvAsString(_data);
+  if (!data) return;
+  JsVar *buf = jsvObjectGetChildIfExists(f,STORAGEFILE_BUFFER_NAME);
+  if (!buf) {
+    buf = jsvNewFromEmptyString();
+    if (buf) jsvObjectSetChild(f,STORAGEFILE_BUFFER_NAME,buf);
+  }
+  bool isFull = false;
+  if (buf) {
+    jsvAppendStringVarComplete(buf, data);
+    isFull = jsvGetStringLength(buf) >= (size_t)bufferSize;
+  }
+  jsvUnLock2(buf, data);
+  if (isFull) jswrap_storagefile_flush(f);
+}
+
+/*JSON{
+  "type" : "method",
+  "ifndef" : "SAVE_ON_FLASH",
+  "class" : "StorageFile",
+  "name" : "flush",
+  "generate" : "jswrap_storagefile_flush"
+}
+Write any data that has been buffered (when the file was opened with the
+`buffer` option) to flash. This does nothing for unbuffered files.
+*/
+void jswrap_storagefile_flush(JsVar *f) {
+  JsVar *buf = jsvObjectGetChildIfExists(f,STORAGEFILE_BUFFER_NAME);
+  if (!buf) return;
+  jsvObjectRemoveChild(f,STORAGEFILE_BUFFER_NAME);
+  jswrap_storagefile_write_flash(f, buf);
+  jsvUnLock(buf);
+}
+
 /*JSON{
   "type" : "method",
   "ifndef" : "SAVE_ON_FLASH",
@@ -986,6 +1373,8 @@ void jswrap_storagefile_erase(JsVar *f) {
     chunk++;
   }
   // reset everything
+  jsvObjectRemoveChild(f,STORAGEFILE_INDEX_NAME);
+  jsvObjectRemoveChild(f,STORAGEFILE_BUFFER_NAME);
   jsvObjectSetIntChild(f,"chunk", 1);
   jsvObjectSetIntChild(f,"offset", 0);
   jsvObjectSetIntChild(f,"mode", 0);
@@ -22,7 +22,7 @@ void jswrap_storage_eraseAll();
 JsVar *jswrap_storage_read(JsVar *name, int offset, int length);
 JsVar *jswrap_storage_readJSON(JsVar *name, bool noExceptions);
 JsVar *jswrap_storage_readArrayBuffer(JsVar *name);
-bool jswrap_storage_write(JsVar *name, JsVar *data, JsVarInt offset, JsVarInt size);
+bool jswrap_storage_write(JsVar *name, JsVar *data, JsVar *offsetOrOptions, JsVarInt size);
 bool jswrap_storage_writeJSON(JsVar *name, JsVar *data);
 void jswrap_storage_erase(JsVar *name);
 void jswrap_storage_compact(bool showMessage);
@@ -33,11 +33,14 @@ int jswrap_storage_getFree(bool checkInternalFlash);
 JsVar *jswrap_storage_getStats(JsVar *checkInternalFlash);
 void jswrap_storage_optimise();
 
-JsVar *jswrap_storage_open(JsVar *name, JsVar *mode);
+JsVar *jswrap_storage_open(JsVar *name, JsVar *mode, JsVar *options);
 JsVar *jswrap_storagefile_read(JsVar *f, int len);
 JsVar *jswrap_storagefile_readLine(JsVar *f);
+void jswrap_storagefile_seek(JsVar *f, int position);
+void jswrap_storagefile_seekLine(JsVar *f, int line);
 int jswrap_storagefile_getLength(JsVar *f);
 void jswrap_storagefile_write(JsVar *parent, JsVar *_data);
+void jswrap_storagefile_flush(JsVar *f);
 void jswrap_storagefile_erase(JsVar *f);
 
 #endif // JSWRAP_STORAGE_H_
@@ -98,8 +98,16 @@ bool jswrap_stream_pushData(JsVar *parent, JsVar *dataString, bool force) {
         // jsWarn("String buffer overflowed maximum size (%d)", STREAM_MAX_BUFFER_SIZE);
         ok = false;
       }
-      if ((ok || force) && (bufLen < STREAM_MAX_BUFFER_SIZE))
-        jsvAppendStringVar(buf, dataString, 0, STREAM_MAX_BUFFER_SIZE-bufLen);
+      if ((ok || force) && (bufLen < STREAM_MAX_BUFFER_SIZE)) {
+        if (!jsvHasStringExt(buf)) {
+          // we can't append to flat strings (eg. data received from a socket) so copy it first
+          JsVar *newBuf = jsvNewWritableStringFromStringVar(buf, 0, JSVAPPENDSTRINGVAR_MAXLENGTH);
+          jsvUnLock(buf);
+          buf = newBuf;
+          jsvObjectSetChild(parent, STREAM_BUFFER_NAME, buf);
+        }
+        if (buf) jsvAppendStringVar(buf, dataString, 0, STREAM_MAX_BUFFER_SIZE-bufLen);
+      }
       jsvUnLock(buf);
     }
   }
@@ -112,10 +112,19 @@ typedef struct {
 typedef struct {
   const JswSymPtr *symbols;
   const char *symbolChars;
+#ifndef ESPR_NO_SYMBOL_HASH
+  const unsigned char *symbolHash; ///< Perfect hash table for finding symbols (see build_jswrapper.py)
+#endif
   unsigned char symbolCount;
 } PACKED_JSW_SYM JswSymList;
+// Macro used for adding symbolHash (if used) when defining JswSymList entries
+#ifndef ESPR_NO_SYMBOL_HASH
+#define JSWSYMLIST_HASH(hashTable) hashTable,
+#else
+#define JSWSYMLIST_HASH(hashTable)
+#endif
 
-/// Do a binary search of the symbol table list
+/// Search the symbol table list for the given name (using its perfect hash if there is one)
 JsVar *jswBinarySearch(const JswSymList *symbolsPtr, JsVar *parent, const char *name);
 
 /** If 'name' is something that belongs to an internal function, return it (it'll be created on demand).  */
@@ -22,6 +22,7 @@
  #include <sys/select.h>
  #include <termios.h>
  #include <fcntl.h>
+ #include <sys/mman.h>
 #endif//__MINGW32__
  #include <signal.h>
  #include <inttypes.h>
@@ -33,10 +34,16 @@
 #include "jsinteractive.h"
 
 #include <pthread.h>
+#ifdef USE_NET
+#include "network_linux.h"
+#endif
 
 #define FAKE_FLASH_FILENAME  "espruino.flash"
 #define FAKE_FLASH_BLOCKSIZE FLASH_PAGE_SIZE
 #define FAKE_FLASH_BLOCKS    (FLASH_TOTAL/FLASH_PAGE_SIZE)
+#ifndef __MINGW32__
+#define FAKE_FLASH_MMAP // memory-map the fake flash file rather than reading/writing it for every access
+#endif
 
 #ifndef FLASH_64BITS_ALIGNMENT
 #define FLASH_UNITARY_WRITE_SIZE 4
@@ -255,6 +262,10 @@ bool isInitialised;
 void *jshInputThread() {
   while (isInitialised) {
     bool shortSleep = false;
+#ifdef NET_LINUX_EPOLL
+    int eventsUsed = jshGetEventsUsed();
+    bool hadCtrlC = execInfo.execute & (EXEC_CTRL_C|EXEC_CTRL_C_WAIT);
+#endif
     /* Handle the delayed Ctrl-C -> interrupt behaviour (see description by EXEC_CTRL_C's definition)  */
     if (execInfo.execute & EXEC_CTRL_C_WAIT)
       execInfo.execute = (execInfo.execute & ~EXEC_CTRL_C_WAIT) | EXEC_INTERRUPTED;
@@ -309,6 +320,11 @@ void *jshInputThread() {
       }
 #endif
 
+#ifdef NET_LINUX_EPOLL
+    // jshSleep may be blocked waiting for sockets, so wake it if it has something to do
+    if (hadCtrlC || jshGetEventsUsed()!=eventsUsed)
+      net_linux_wake();
+#endif
     jshDelayMicroseconds(shortSleep ? 1000 : 50000);
   }
 }
@@ -795,6 +811,12 @@ bool jshSleep(JsSysTime timeUntilWake) {
   unsigned int usecs = (usecfloat < 0xFFFFFFFF) ? (unsigned int)usecfloat : 0xFFFFFFFF;
   if (hasWatches && usecs>1000)
     usecs=1000; // don't sleep much if we have watches - we need to keep polling them
+#ifdef NET_LINUX_EPOLL
+  /* If we have sockets, wait on them rather than sleeping. The input thread
+  wakes us if it gets any input, so we don't need to limit how long we wait */
+  if (!hasWatches && net_linux_wait((int)(usecs/1000)))
+    return true;
+#endif
   if (usecs > 50000)
     usecs = 50000; // don't want to sleep too much (user input/HTTP/etc)
   if (usecs >= 1000)
@@ -868,8 +890,30 @@ static FILE *jshFlashOpenFile(bool dontCreate) {
   }
   return f;
 }
+#ifdef FAKE_FLASH_MMAP
+static unsigned char *flashMemory = 0; ///< The fake flash file, memory-mapped (or 0 if not mapped yet)
+
+/// Memory-map the fake flash file (creating it if it doesn't exist and dontCreate=false). Returns true if mapped
+static bool jshFlashMap(bool dontCreate) {
+  if (flashMemory) return true;
+  FILE *f = jshFlashOpenFile(dontCreate);
+  if (!f) return false;
+  void *m = mmap(NULL, FAKE_FLASH_BLOCKSIZE*FAKE_FLASH_BLOCKS, PROT_READ|PROT_WRITE, MAP_SHARED, fileno(f), 0);
+  fclose(f); // the mapping stays valid after the file is closed
+  if (m==MAP_FAILED) return false;
+  flashMemory = (unsigned char*)m;
+  return true;
+}
+#endif
+
 void jshFlashErasePage(uint32_t addr) {
   //jsDebug(DBG_VERBOSE,"FlashErasePage 0x%08x\n", addr);
+#ifdef FAKE_FLASH_MMAP
+  if (!jshFlashMap(true)) return; // if no file and we're erasing, we don't have to do anything
+  uint32_t startAddr, pageSize;
+  if (jshFlashGetPage(addr, &startAddr, &pageSize))
+    memset(&flashMemory[startAddr-FLASH_START], 0xFF, pageSize);
+#else
   FILE *f = jshFlashOpenFile(true);
   if (!f) return; // if no file and we're erasing, we don't have to do anything
   uint32_t startAddr, pageSize;
@@ -882,6 +926,7 @@ void jshFlashErasePage(uint32_t addr) {
     free(buf);
   }
   fclose(f);
+#endif
 }
 void jshFlashRead(void *buf, uint32_t addr, uint32_t len) {
   //jsDebug(DBG_VERBOSE,"FlashRead 0x%08x %d\n", addr,len);
@@ -893,6 +938,14 @@ void jshFlashRead(void *buf, uint32_t addr, uint32_t len) {
   }
   addr -= FLASH_START;
 
+#ifdef FAKE_FLASH_MMAP
+  if (!jshFlashMap(true)) { // no file, so it's all 0xFF
+    memset(buf, 0xFF, len);
+    return;
+  }
+  assert(addr+len <= FLASH_TOTAL);
+  memcpy(buf, &flashMemory[addr], len);
+#else
   FILE *f = jshFlashOpenFile(true);
   if (!f) { // no file, so it's all 0xFF
     memset(buf, 0xFF, len);
@@ -902,6 +955,7 @@ void jshFlashRead(void *buf, uint32_t addr, uint32_t len) {
   size_t r = fread(buf, 1, len, f);
   assert(r==len);
   fclose(f);
+#endif
 }
 void jshFlashWrite(void *buf, uint32_t addr, uint32_t len) {
   //jsDebug(DBG_VERBOSE,"FlashWrite 0x%08x %d\n", addr,len);
@@ -922,6 +976,13 @@ void jshFlashWrite(void *buf, uint32_t addr, uint32_t len) {
   }
   addr -= FLASH_START;
 
+#ifdef FAKE_FLASH_MMAP
+  if (!jshFlashMap(false)) return;
+  assert(addr+len <= FLASH_TOTAL);
+  // like real flash, we can only clear bits
+  for (i=0;i<len;i++)
+    flashMemory[addr+i] &= ((unsigned char*)buf)[i];
+#else
   FILE *f = jshFlashOpenFile(false);
   if (!f) return;
 
@@ -940,10 +1001,16 @@ void jshFlashWrite(void *buf, uint32_t addr, uint32_t len) {
   free(wbuf);
   //fsync(f);
   fclose(f);
+#endif
 }
 
-// No - we can't memory-map the flash memory under Linux (well, we could but for testing it's handy not to)
 size_t jshFlashGetMemMapAddress(size_t ptr) {
+#ifdef FAKE_FLASH_MMAP
+  // Flash is a memory-mapped file, so we can point straight into it
+  if (ptr>=FLASH_START && ptr<FLASH_START+FLASH_TOTAL && jshFlashMap(true))
+    return (size_t)&flashMemory[ptr-FLASH_START];
+#endif
+  // No - we can't memory-map the flash memory
   return 0;
 }
 
@@ -20,6 +20,9 @@
 #ifdef ESPR_JIT
 #include "jsjit.h"
 #endif
+#ifdef USE_NET
+#include "network_linux.h"
+#endif
 #ifndef JSVAR_CACHE_SIZE
 #define JSVAR_CACHE_SIZE 0
 #endif
@@ -30,6 +33,17 @@
 bool isRunning = true;
 struct filelist test_files;
 
+/// After running a script, should we keep going around the idle loop?
+static bool shouldKeepRunning(bool isBusy) {
+  if (!isRunning) return false;
+  if (jsiHasTimers() || isBusy) return true;
+#ifdef NET_LINUX_EPOLL
+  // idle sockets don't keep us busy any more, but we still need to handle them
+  if (net_linux_hasSockets()) return true;
+#endif
+  return false;
+}
+
 void warning(const char *, ...) __attribute__((__format__(__warning__, 1, 2)));
 void fatal(int, const char *, ...)
     __attribute__((__format__(__warning__, 2, 3)));
@@ -194,7 +208,7 @@ bool run_test(const char *filename) {
 
   isRunning = true;
   bool isBusy = true;
-  while (isRunning && (jsiHasTimers() || isBusy))
+  while (shouldKeepRunning(isBusy))
     isBusy = jsiLoop();
 
   JsVar *result = jsvObjectGetChildIfExists(execInfo.root, "result");
@@ -439,7 +453,7 @@ int main(int argc, char **argv) {
         int errCode = handleErrors();
         isRunning = !errCode;
         bool isBusy = true;
-        while (isRunning && (jsiHasTimers() || isBusy))
+        while (shouldKeepRunning(isBusy))
           isBusy = jsiLoop();
         jsiKill();
         jsvKill();
@@ -526,7 +540,7 @@ int main(int argc, char **argv) {
     free(buffer);
     isRunning = !errCode;
     bool isBusy = true;
-    while (isRunning && (jsiHasTimers() || isBusy))
+    while (shouldKeepRunning(isBusy))
       isBusy = jsiLoop();
     jsiKill();
     jsvKill();
@@ -0,0 +1,34 @@
+// Test array element lookups that start from the last element found
+var a = [];
+for (var i=0;i<200;i++) a.push(i*2);
+var ok = true;
+// sequential access
+for (var i=0;i<200;i++) if (a[i]!=i*2) ok = false;
+// backwards access
+for (var i=199;i>=0;i--) if (a[i]!=i*2) ok = false;
+// strided/random access
+for (var i=0;i<200;i++) { var j = (i*37)%200; if (a[j]!=j*2) ok = false; }
+// modifying while accessing
+a[100] = "x";
+if (a[100]!="x" || a[101]!=202 || a[99]!=198) ok = false;
+a.shift(); // removes element, renumbers
+if (a[0]!=2 || a[99]!="x" || a[100]!=202) ok = false;
+a.unshift("y");
+if (a[0]!="y" || a[100]!="x" || a[101]!=202) ok = false;
+a.splice(50,10);
+if (a[50]!=120 || a[90]!="x" || a[189]!=398) ok = false;
+for (var i=0;i<10;i++) a.pop();
+if (a[179]!=378 || a[180]!==undefined) ok = false;
+// sparse arrays
+var s = [];
+s[5] = 5; s[1000] = 1000; s[500] = 500;
+if (s[500]!=500 || s[501]!==undefined || s[1000]!=1000 || s[5]!=5 || s[6]!==undefined) ok = false;
+delete s[500];
+if (s[500]!==undefined || s[1000]!=1000) ok = false;
+// after the array is freed and memory is moved around
+a = undefined;
+E.defrag();
+var b = [1,2,3,4,5,6,7,8,9,10];
+for (var i=0;i<10;i++) if (b[i]!=i+1) ok = false;
+if (b[3]!=4) ok = false;
+result = ok;
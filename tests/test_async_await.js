@@ -0,0 +1,51 @@
+// async functions and await - resumed where they stopped when what they await resolves
+var passes = [];
+
+function delay(ms, v) {
+  return new Promise(function(resolve) { setTimeout(resolve, ms, v); });
+}
+
+async function sequence(x) {
+  passes.push("start");
+  var a = await delay(10, x+1);
+  b = await a*2; // not a Promise
+  await delay(5);
+  if (b!=4) return "bad";
+  return await delay(1, b+1);
+}
+var b;
+var p = sequence(1);
+passes.push("called"); // runs until the first await
+p.then(function(v) { if (v==5) passes.push("sequence"); });
+
+var arrow = async x => await delay(1, x*3);
+arrow(4).then(function(v) { if (v==12) passes.push("arrow"); });
+var arrow2 = async (x,y) => x+y;
+arrow2(1,2).then(function(v) { if (v==3) passes.push("arrow2"); });
+
+async function thrower() {
+  await delay(1);
+  throw new Error("boom");
+}
+thrower().catch(function(e) { if (e.message=="boom") passes.push("throw"); });
+
+async function rejected() {
+  var a = await Promise.reject("nope");
+  passes.push("FAIL");
+}
+rejected().catch(function(e) { if (e=="nope") passes.push("reject"); });
+
+var obj = {
+  v : 7,
+  get : async function() {
+    await delay(1);
+    return this.v;
+  }
+};
+obj.get().then(function(v) { if (v==7) passes.push("this"); });
+
+setTimeout(function() {
+  passes.sort();
+  result = passes=="arrow,arrow2,called,reject,sequence,start,this,throw";
+  if (!result) print(passes);
+}, 100);
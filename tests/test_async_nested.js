@@ -0,0 +1,105 @@
+// await inside blocks, loops, if/else and try/catch - resumed back inside them
+var passes = [];
+
+function delay(ms, v) {
+  return new Promise(function(resolve) { setTimeout(resolve, ms, v); });
+}
+
+async function loops() {
+  var out = [];
+  for (let i=0;i<3;i++) {
+    let sq = await delay(1, i*i);
+    out.push(i+":"+sq);
+  }
+  var n = 0;
+  while (n<3) {
+    n = await delay(1, n+1);
+    if (n==2) continue;
+    out.push("w"+n);
+  }
+  do {
+    await delay(1);
+    n--;
+    if (n==1) break;
+  } while (n>0);
+  out.push("d"+n);
+  return out.join(",");
+}
+loops().then(function(v) {
+  if (v=="0:0,1:1,2:4,w1,w3,d1") passes.push("loops");
+  else print("loops", v);
+});
+
+async function branches(x) {
+  var a;
+  if (x) {
+    a = await delay(1, "yes");
+  } else if (x===0) {
+    a = await delay(1, "zero");
+  } else {
+    a = await delay(1, "no");
+  }
+  { let b = 1; { let c = await delay(1, 2); a += b+c; } }
+  return a;
+}
+Promise.all([branches(1),branches(0),branches(false)]).then(function(v) {
+  if (v=="yes3,zero3,no3") passes.push("branches");
+  else print("branches", v);
+});
+
+async function catcher() {
+  var out = [];
+  for (var i=0;i<2;i++) {
+    try {
+      out.push("try"+i);
+      await (i ? Promise.reject("bad"+i) : delay(1));
+      out.push("ok"+i);
+    } catch (e) {
+      out.push("caught "+e);
+      let v = await delay(1, e.length);
+      out.push(e+"="+v);
+    } finally {
+      out.push("finally"+i);
+    }
+  }
+  return out.join(",");
+}
+catcher().then(function(v) {
+  if (v=="try0,ok0,finally0,try1,caught bad1,bad1=4,finally1") passes.push("trycatch");
+  else print("trycatch", v);
+});
+
+async function nested() {
+  var total = 0;
+  for (var i=0;i<3;i++) {
+    for (var j=0;j<3;j++) {
+      if (i==j) {
+        var v = await delay(1, 10);
+        total += v;
+      } else total += 1;
+    }
+  }
+  return total;
+}
+nested().then(function(v) { if (v==36) passes.push("nested"); });
+
+async function uncaught() {
+  try {
+    await delay(1);
+  } finally {
+    passes.push("cleanup");
+  }
+  while (true) await Promise.reject("fail");
+}
+uncaught().catch(function(e) { if (e=="fail") passes.push("uncaught"); });
+
+async function inSwitch() {
+  switch (1) { case 1: await delay(1); }
+}
+inSwitch().catch(function(e) { if (e instanceof SyntaxError) passes.push("switch"); });
+
+setTimeout(function() {
+  passes.sort();
+  result = passes=="branches,cleanup,loops,nested,switch,trycatch,uncaught";
+  if (!result) print(passes);
+}, 200);
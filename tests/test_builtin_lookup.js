@@ -0,0 +1,24 @@
+// Test that all built-in symbols can be found (via the symbol tables' hashes), and that nothing else is
+var ok = true;
+function check(obj, names, desc) {
+  if (!names.length) { print("No names for "+desc); ok = false; }
+  names.forEach(function(n) {
+    if (obj[n]===undefined) { print(desc+"."+n+" not found"); ok = false; }
+    if (typeof obj!="string" && obj[n+"x"]!==undefined) { print(desc+"."+n+"x found"); ok = false; }
+  });
+}
+check(Math, Object.getOwnPropertyNames(Math), "Math");
+check(JSON, Object.getOwnPropertyNames(JSON), "JSON");
+check(Object, Object.getOwnPropertyNames(Object), "Object");
+check("abc", ["charAt","charCodeAt","indexOf","split","substr","substring","toUpperCase","trim","replace","length"], "String");
+check([1,2], Object.getOwnPropertyNames(Array.prototype), "Array");
+check(function(){}, Object.getOwnPropertyNames(Function.prototype), "Function");
+if (Math.sinx!==undefined || Math.si!==undefined || Math[""]!==undefined || Math.Sin!==undefined) ok = false;
+if (typeof getTime!="function" || typeof getTimex!="undefined") ok = false;
+// built-in objects get added to the global namespace when used
+String.prototype.foo = function() { return this+"!"; };
+if ("a".foo()!="a!") ok = false;
+// built-in libraries
+if (typeof require("fs").readFile!="function") ok = false;
+try { require("fsx"); ok = false; } catch (e) {}
+result = ok;
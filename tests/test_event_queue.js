@@ -0,0 +1,22 @@
+// Events queued with emit run in order, whether they go in the native
+// event ring buffer or (when that's full, or there are too many args or
+// locks) in the events array
+var o = {}, p = {}, got = [];
+o.on('x', function(a,b,c,d) { got.push(d===undefined ? a : a+"/"+d); });
+p.on('y', function(a) { got.push("y"+a); });
+
+for (var i=0;i<100;i++) {
+  if (i%7==0) o.emit('x', i, 1, 2, 3); // more args than the ring buffer holds
+  else o.emit('x', i);
+  if (i%10==0) p.emit('y', i);
+}
+
+var expected = [];
+for (var i=0;i<100;i++) {
+  expected.push(i%7==0 ? i+"/3" : i);
+  if (i%10==0) expected.push("y"+i);
+}
+
+setTimeout(function() {
+  result = got.join(",") == expected.join(",");
+}, 10);
@@ -0,0 +1,13 @@
+// Garbage collection should complete even if data is nested very deeply
+var live = {}, l = live;
+for (var i=0;i<30000;i++) { l.a = {}; l = l.a; }
+l = undefined;
+// a loop of references - only the GC can free this
+var g1 = {}, g2 = {g1:g1}; g1.g2 = g2;
+g1 = g2 = undefined;
+var freed = process.memory().gc;
+// make sure we didn't free anything we shouldn't have
+var depth = 0;
+l = live;
+while (l) { depth++; l = l.a; }
+result = freed==4 && depth==30001;
@@ -0,0 +1,43 @@
+// Test incremental garbage collection when idle (with a tiny budget, so it happens over many slices)
+E.setFlags({gcBudget:0.02});
+var flagsOk = Math.abs(E.getFlags().gcBudget-0.02) < 0.001;
+var memBefore = process.memory(false);
+
+// Some data that should not get freed
+var live = {list:null, arr:[]};
+for (var i=0;i<100;i++) {
+  live.list = {v:i, next:live.list};
+  live.arr.push("item"+i);
+}
+function makeGarbage() {
+  // a loop of references - only the GC can free this
+  var a = {}; var b = {a:a}; a.b = b;
+}
+// fill up memory with garbage so we GC when idle
+while (process.memory(false).free > 200) for (var i=0;i<20;i++) makeGarbage();
+while (process.memory(false).free > 80) makeGarbage();
+// process.memory uses memory itself, so don't call it now until we're done
+var freeBefore = process.memory(false).free;
+for (var i=0;i<8;i++) makeGarbage();
+
+var changes = 0;
+// modify data while the GC is running
+var interval = setInterval(function() {
+  live.list = {v:live.list.v+1, next:live.list};
+  live.arr.push(live.arr.shift());
+  changes++;
+}, 5);
+
+setTimeout(function() {
+  clearInterval(interval);
+  var mem = process.memory(false);
+  var ok = true, l = live.list, v = l.v;
+  while (l) { if (l.v!=v--) ok = false; l = l.next; }
+  if (v!=-1) ok = false;
+  for (var i=0;i<100;i++) if (live.arr.indexOf("item"+i)<0) ok = false;
+  result = flagsOk && ok && changes>0 &&
+           mem.free > freeBefore+100 && // garbage was freed
+           mem.gccycles > memBefore.gccycles && // ...by an incremental GC
+           mem.gcslices-memBefore.gcslices > mem.gccycles-memBefore.gccycles; // that took more than one slice
+  E.setFlags({gcBudget:0});
+}, 500);
@@ -0,0 +1,58 @@
+// Generators (function*) - yield at the start of statements in the function body
+var passes = [];
+
+function* count(n) {
+  var a = yield "first";
+  yield a+1;
+  let b = yield n;
+  const c = yield b*2;
+  return c;
+}
+var g = count(3);
+if (g.next().value=="first") passes.push("first");
+if (g.next(5).value==6) passes.push("assign");
+if (g.next().value==3) passes.push("arg");
+if (g.next(10).value==20) passes.push("let");
+var r = g.next("end");
+if (r.value=="end" && r.done) passes.push("return");
+if (g.next().done) passes.push("finished");
+
+// locals survive between calls, and closures can see them
+var gen = function*() {
+  var total = 0;
+  var add = function(x) { total += x; };
+  var x = yield;
+  add(x);
+  x = yield;
+  add(x);
+  return total;
+};
+g = gen();
+g.next(); g.next(2);
+if (g.next(3).value==5) passes.push("closure");
+
+var arr = [];
+for (var x of (function*() { yield 1; yield 2; yield 3; })()) arr.push(x);
+if (arr=="1,2,3") passes.push("forof");
+
+g = count(1);
+g.next();
+r = g.return(42);
+if (r.value==42 && r.done && g.next().done) passes.push("early");
+
+try {
+  g = count(1);
+  g.next();
+  g.throw("oops");
+} catch (e) {
+  if (e=="oops" && g.next().done) passes.push("throw");
+}
+
+try {
+  eval("(function() { var q = 1 + yield 2; })()");
+} catch (e) {
+  if (e instanceof SyntaxError) passes.push("syntax");
+}
+
+result = passes=="first,assign,arg,let,return,finished,closure,forof,early,throw,syntax";
+if (!result) print(passes);
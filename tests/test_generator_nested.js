@@ -0,0 +1,52 @@
+// yield inside loops, if/else and try/catch
+var passes = [];
+
+function* range(a, b) {
+  for (let i=a;i<b;i++) yield i;
+}
+var arr = [];
+for (var x of range(2,5)) arr.push(x);
+if (arr=="2,3,4") passes.push("for");
+
+function* fib() {
+  var a = 0, b = 1;
+  while (true) {
+    yield a;
+    let t = a+b;
+    a = b;
+    b = t;
+  }
+}
+var g = fib();
+arr = [];
+for (var i=0;i<8;i++) arr.push(g.next().value);
+if (arr=="0,1,1,2,3,5,8,13") passes.push("while");
+
+function* checked() {
+  var n = 0;
+  while (true) {
+    try {
+      var v = yield n;
+      if (v) n += v;
+    } catch (e) {
+      n = yield "caught "+e;
+    }
+  }
+}
+g = checked();
+g.next();
+if (g.next(3).value==3 &&
+    g.throw("x").value=="caught x" &&
+    g.next(10).value==10) passes.push("trycatch");
+
+function* inForIn() {
+  for (var k in {a:1}) yield k;
+}
+try {
+  inForIn().next();
+} catch (e) {
+  if (e instanceof SyntaxError) passes.push("forin");
+}
+
+result = passes=="for,while,trycatch,forin";
+if (!result) print(passes);
@@ -0,0 +1,34 @@
+// HTTP keep-alive - several requests over the same connection
+
+var result = 0;
+var http = require("http");
+
+var server = http.createServer(function (req, res) {
+  var body = "Hello "+req.url;
+  res.writeHead(200, {'Content-Length':body.length});
+  res.end(body);
+});
+server.keepAliveTimeout = 5000; // keep-alive is off by default
+server.listen(8080);
+
+var responses = [];
+var sockets = [];
+function get(n) {
+  http.get({ host: 'localhost', port: 8080, path: '/'+n, keepAlive: true }, function(res) {
+    var body = '';
+    res.on('data', function(data) { body += data; });
+    res.on('close', function() {
+      console.log("Response", res.headers.Connection, body);
+      responses.push(body);
+      // the socket should now be waiting in the pool for the next request
+      sockets.push(global["\xFF"].HttpCP[0].sckt);
+      if (n<3) get(n+1);
+      else {
+        server.close();
+        result = responses.join()=="Hello /1,Hello /2,Hello /3" &&
+                 sockets[0]==sockets[1] && sockets[1]==sockets[2];
+      }
+    });
+  });
+}
+get(1);
@@ -0,0 +1,40 @@
+// HTTP keep-alive - if the server closes a pooled connection just as it's reused, the request is sent again on a new connection
+
+var result = 0;
+var http = require("http");
+
+var server = http.createServer(function (req, res) {
+  var body = "Hello "+req.url;
+  res.writeHead(200, {'Content-Length':body.length});
+  res.end(body);
+});
+server.keepAliveTimeout = 5000;
+server.listen(8080);
+
+var responses = [];
+function get(n, callback) {
+  var req = http.get({ host: 'localhost', port: 8080, path: '/'+n, keepAlive: true }, function(res) {
+    var body = '';
+    res.on('data', function(data) { body += data; });
+    res.on('close', function() {
+      console.log("Response", body);
+      responses.push(body);
+      callback();
+    });
+  });
+  req.on('error', function(e) {
+    console.log("Error", e);
+    responses.push("error");
+    server.close(); // finish the test
+  });
+}
+
+get(1, function() {
+  var pooled = global["\xFF"].HttpCP.length;
+  get(2, function() {
+    server.close();
+    result = pooled==1 && responses.join()=="Hello /1,Hello /2";
+  });
+  // the server drops the kept-alive connection just as the client reuses it
+  global["\xFF"].HttpSC[0].clsNow = true;
+});
@@ -0,0 +1,45 @@
+// HTTP server reading a POST body slowly with read(), so received data has to wait for the buffer to empty.
+// The body is several times SOCKET_MAX_RECEIVE_DATA, so the server must stop reading the socket rather than
+// keep everything that arrives in req.dRcv
+
+var result = 0;
+var http = require("http");
+
+var sent = "";
+for (var i=0;i<3000;i++) sent += "0123456789";
+var maxPending = 0; // most received data that was waiting to be read
+
+var server = http.createServer(function (req, res) {
+  var body = '';
+  var interval = setInterval(function() {
+    var pending = req.dRcv ? req.dRcv.length : 0;
+    if (pending > maxPending) maxPending = pending;
+    body += req.read(100);
+    if (body.length >= sent.length) {
+      clearInterval(interval);
+      res.writeHead(200);
+      res.end(body==sent ? "ok" : "bad");
+    }
+  }, 1);
+});
+server.listen(8080);
+
+var options = {
+  host: 'localhost',
+  port: 8080,
+  path: '/',
+  method: 'POST',
+  headers: { 'Content-Length': sent.length }
+};
+var req = http.request(options, function(res) {
+  var body = '';
+  res.on('data', function(data) {
+    body += data;
+  });
+  res.on('close', function() {
+    console.log("Response", body, "max pending", maxPending);
+    server.close();
+    result = body=="ok" && maxPending>0 && maxPending < sent.length/4;
+  });
+});
+req.end(sent);
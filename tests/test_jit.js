@@ -0,0 +1,98 @@
+// Test JIT compiled functions (on builds without the JIT these are just run by the interpreter)
+var ok = true;
+function check(a,b,n) { if (a!==b) { print("f"+n,"expected",b,"got",a); ok = false; } }
+function f1(){"jit";return 1+2;}
+check(f1(),3,1);
+function f2(){"jit";var s=0;for(var i=0;i<100;i++){s+=i*2;}return s;}
+check(f2(),9900,2);
+function f3(a){"jit";let x=a|3;x=x^5;x++;--x;if(x<10&&x>=2)x-=1;return x*x;}
+check(f3(4),1,3);
+function f4(){"jit";var a=[1,2];var b=a[0]+1.5;var c="x"+b;return c;}
+check(f4(),"x2.5",4);
+function f5(){"jit";var i=0;while(i<5){i++;}return i;}
+check(f5(),5,5);
+function f6(){"jit";var x=1073741823;x++;x=x*4;return x;} // overflow out of tagged range
+check(f6(),4294967296,6);
+function f7(a){"jit";switch(a){case 1:return "one";case 2:return "two";default:return "other";}}
+check(f7(1),"one",7); check(f7(2),"two",7); check(f7(5),"other",7);
+function f8(){"jit";try { throw "x"; } catch(e) { return "caught "+e; }}
+check(f8(),"caught x",8);
+function f9(){"jit";var r=0;for(var i=0;i<10;i++){if(i==3)continue;if(i==6)break;r+=i;}return r;}
+check(f9(),0+1+2+4+5,9);
+function f10(){"jit";var o={a:1,b:"x"};o.c=o.a+2;return o.c;}
+check(f10(),3,10);
+function f11(){"jit";var s="";var i=0;do{s+=i;i++;}while(i<3);return s;}
+check(f11(),"012",11);
+function f12(){"jit";var a=-5;var b=3;return [a*b,a-b,a+b,a&b,a|b,a^b,a<b,a>b,a<=b,a>=b,a==b,a!=b].join(",");}
+check(f12(),"-15,-8,-2,3,-5,-8,true,false,true,false,false,true",12);
+function f13(){"jit";var x=0.5;x+=1;return x*2;}
+check(f13(),3,13);
+function f14(){"jit";var a="a";a+=1;return a;}
+check(f14(),"a1",14);
+function f15(n){"jit";var r=1;for(var i=1;i<=n;i++)r*=i;return r;}
+check(f15(5),120,15); check(f15(20),2432902008176640000,15);
+function f16(){"jit";let t=0;for(let i=0;i<4;i++){let j=i*i;t+=j;}return t;}
+check(f16(),14,16);
+function f17(){"jit";var a=[];for(var i=0;i<5;i++)a.push(i);return a.length;}
+check(f17(),5,17);
+function f18(){"jit";var c=0;var f=function(){c++;};f();f();return c;}
+check(f18(),2,18);
+function f19(){"jit";return Math.round(2.6);}
+check(f19(),3,19);
+function f20(){"jit";var x=5;var y=x++;var z=++x;return y*100+z;}
+check(f20(),507,20);
+function f21(){"jit";var x=-1073741824;x--;return x;}
+check(f21(),-1073741825,21);
+function f22(){"jit";var x=46341;return x*x;}
+check(f22(),2147488281,22);
+function f23(){"jit";var x=-3;return x*7;}
+check(f23(),-21,23);
+function f24(){"jit";var a=1,b;b=a;a=2;return a+b;}
+check(f24(),3,24);
+function f25(){"jit";var q=1;q=q==1?"y":"n";return q;}
+check(f25(),"y",25);
+var g=10;function f26(){"jit";g+=5;return g;}
+check(f26(),15,26);
+function f28(){"jit";var r="";try{r+="a";}finally{r+="b";}return r;}
+check(f28(),"ab",28);
+function f29(){"jit";return new Date(1000).getTime();}
+check(f29(),1000,29);
+function f30(){"jit";var x=1;{let x=2;}return x;}
+check(f30(),1,30);
+
+// Exceptions must stop JIT code straight away, like the interpreter - check both give the same result and side effects
+var hasJit = (function(){"jit";})["\xFFjit"]!==undefined;
+function th(){ throw "E"; }
+function inner(x){ try { if (x) throw 1; } catch(e) { return 200+x+2; } return 0; }
+function Thrower(){ throw "C"; }
+function same(code,n) {
+  var r = [];
+  [true,false].forEach(function(useJit) {
+    var fn = eval("(function(){"+(useJit?'"jit";':"")+code+"})");
+    if (useJit && hasJit && fn["\xFFjit"]===undefined) check("not JIT compiled", "JIT compiled", n);
+    g = 9;
+    var v;
+    try { v = fn(); } catch (e) { v = "threw "+e; }
+    r.push(JSON.stringify([v,g]));
+  });
+  check(r[0], r[1], n);
+}
+same('var s=5;try{s=th();}catch(e){}return s;', 31);
+same('var s=0;s+=inner(1);return s;', 32);
+same('var s=0;try{s+=inner(1);s+=th();}catch(e){s+=1;}return s;', 33);
+same('var r="";try{r+="a";return r;}finally{r+="b";g=r;}', 34);
+same('var s=1;try{var o={a:1}; s=o.b.c+th();}catch(e){s+=10;}return s;', 35);
+same('g=1; th(); g=2; return 3;', 36);
+same('var s=5; s = th(); g = s;', 37);
+same('var r="";try{try{r+="a";return r+"!";}finally{r+="b";}}finally{g=r+"c";}', 38);
+same('var r="";try{th();}catch(e){r+=e;return r;}finally{g=r+"f";}', 39);
+same('try{return 1;}finally{return 2;}', 40);
+same('try{return g;}finally{g=2;}', 41);
+same('var r=0;for(var i=0;i<5;i++){try{if(i==3)return r;r+=i;}finally{r+=10;}}return -1;', 42);
+same('var x=[1,2,3];try{x.push(th());}catch(e){}return x.length;', 43);
+same('var o;try{o=new Thrower();}catch(e){return "c"+e;}return o;', 44);
+same('var s=1;try{s=s+({valueOf:function(){throw "V";}});}catch(e){return s+e;}', 45);
+same('var s=0;for(var i=0;i<3;i++){try{s+=i*th();}catch(e){s+=100;}}return s;', 46);
+same('g=[1,th()];return 1;', 47);
+
+result = ok;
@@ -0,0 +1,37 @@
+// JSON.parse (fast path, and falling back to the lexer) and JSON.parser
+var ok = true;
+function check(a,b) {
+  if (a!==b) { ok = false; print("FAIL", a, b); }
+}
+
+var j = JSON.parse(' {"a":1, "b":-42,"c":[1,2.5,-3e2,true,false,null,{}],"d":"x\\"y\\n\\u0041\\/", "1":"one", "e":"" } ');
+check(j.a, 1);
+check(j.b, -42);
+check(JSON.stringify(j.c), '[1,2.5,-300,true,false,null,{}]');
+check(j.d, 'x"y\nA/');
+check(j[1], "one");
+check(j.e, "");
+check(JSON.parse("-0.5"), -0.5);
+check(JSON.parse("1234567890123"), 1234567890123);
+check(JSON.parse('"\\u00e9"').charCodeAt(0), 0xE9);
+check(JSON.stringify(JSON.parse('[1,2,]')), '[1,2]'); // trailing commas
+check(JSON.stringify(JSON.parse('{"a":[],}')), '{"a":[]}');
+// not strict JSON, so done by the lexer
+check(JSON.parse("0x10"), 16);
+check(JSON.stringify(JSON.parse("{'a':'b'}")), '{"a":"b"}');
+try { JSON.parse('{a:1}'); ok = false; } catch (e) { }
+try { JSON.parse('[1 2]'); ok = false; } catch (e) { }
+try { JSON.parse('tru'); ok = false; } catch (e) { }
+
+// Streaming
+var got = [];
+var p = JSON.parser(function(v) { got.push(JSON.stringify(v)); });
+p.write('{"a":1}{"b"');
+p.write(':["}",');
+p.write('"\\"]"]} 12');
+p.write('3 "x"');
+p.write('[true]\n4');
+p.end();
+check(got.join("|"), '{"a":1}|{"b":["}","\\"]"]}|123|"x"|[true]|4');
+
+result = ok;
@@ -0,0 +1,29 @@
+// JSON.write and Storage.writeJSON output JSON in chunks
+var ok = true;
+var data = {a:[1,2,3,"hello"], b:{c:true, d:null, e:"a \"quoted\" string"}, f:undefined, g:function(){}};
+for (var i=0;i<20;i++) data["k"+i] = "some longer text to make the JSON span several chunks "+i;
+
+var chunks = [];
+var dest = { write : function(d) { chunks.push(d); } };
+if (!JSON.write(dest, data)) ok = false;
+if (chunks.join("") != JSON.stringify(data)) ok = false;
+if (chunks.length < 10) ok = false;
+chunks.forEach(function(c) { if (c.length > 64) ok = false; });
+
+chunks = [];
+JSON.write(dest, [1,{x:2}], 2);
+if (chunks.join("") != JSON.stringify([1,{x:2}], null, 2)) ok = false;
+
+try { JSON.write({}, data); ok = false; } catch (e) { }
+
+var s = require("Storage");
+s.eraseAll();
+if (!s.writeJSON("jsonw.json", data)) ok = false;
+if (JSON.stringify(s.readJSON("jsonw.json")) != JSON.stringify(data)) ok = false;
+if (!s.writeJSON("jsonw.json", data)) ok = false; // unchanged, so not rewritten
+data.a.push(4);
+if (!s.writeJSON("jsonw.json", data)) ok = false;
+if (JSON.stringify(s.readJSON("jsonw.json")) != JSON.stringify(data)) ok = false;
+s.erase("jsonw.json");
+
+result = ok;
@@ -0,0 +1,56 @@
+// Test that members found in prototypes/built-ins are still correct after the prototypes change
+var ok = true;
+function check(a,b) { if (a!==b) { print("Expected",b,"got",a); ok = false; } }
+function get(o) { return o.m; }
+function getTime(d) { return d.getTime(); }
+
+function F() {}
+F.prototype.m = 1;
+var f = new F();
+for (var i=0;i<3;i++) check(get(f), 1);
+F.prototype.m = 2; // changed value
+check(get(f), 2);
+f.m = 3; // shadowed
+check(get(f), 3);
+delete f.m;
+check(get(f), 2);
+delete F.prototype.m; // removed
+check(get(f), undefined);
+Object.prototype.m = 4; // added further down the chain
+check(get(f), 4);
+F.prototype.m = 5;
+check(get(f), 5);
+delete F.prototype.m;
+delete Object.prototype.m;
+check(get(f), undefined);
+
+// prototype chain altered
+function G() {}
+G.prototype.m = 6;
+F.prototype.__proto__ = G.prototype;
+check(get(f), 6);
+Object.setPrototypeOf(f, G.prototype);
+check(get(f), 6);
+G.prototype.m = 7;
+check(get(f), 7);
+var h = Object.create({m:8});
+check(get(h), 8);
+
+// built-in methods
+var d = new Date(1000);
+for (var i=0;i<3;i++) check(getTime(d), 1000);
+Date.prototype.getTime = function() { return 42; };
+check(getTime(d), 42);
+delete Date.prototype.getTime;
+check(getTime(d), 1000);
+
+// prototype freed and memory reused
+F = undefined; f = undefined; G = undefined;
+E.defrag();
+function K() {}
+K.prototype.x = 9;
+var k = new K();
+check(get(k), undefined);
+check(k.x, 9);
+
+result = ok;
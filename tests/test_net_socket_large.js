@@ -0,0 +1,34 @@
+// Socket server and client test, sending more data than fits in one chunk
+
+var result = 0;
+var net = require("net");
+
+var data = new Uint8Array(5000);
+for (var i=0;i<data.length;i++) data[i] = 32 + (i%90);
+var sent = E.toString(data); // flat string - sent without copying
+
+var server = net.createServer(function(c) { // echo everything back
+  c.on('data', function(d) {
+    c.write(d);
+  });
+  c.on('end', function() {
+    c.end();
+  });
+});
+server.listen(4445);
+
+var client = net.connect({port: 4445}, function() {
+  var body = '';
+  client.on('data', function(d) {
+    body += d;
+    if (body.length >= sent.length) {
+      server.close();
+      client.end();
+    }
+  });
+  client.on('end', function() {
+    console.log('client disconnected', body.length);
+    result = body==sent;
+  });
+  client.write(sent);
+});
@@ -0,0 +1,50 @@
+// Objects with lots of keys get a hidden index to speed up lookups - check it stays correct
+var results = [];
+var o = {};
+var N = 300;
+for (var i=0;i<N;i++) o["key"+i] = i;
+// lookups (these build the index)
+var ok = true;
+for (var i=0;i<N;i++) if (o["key"+i]!==i) ok = false;
+results.push(ok);
+results.push(o.key123===123 && o.key299===299);
+results.push(o.nothere===undefined && !("nothere" in o));
+// the index must not be visible
+results.push(Object.keys(o).length==N);
+results.push(Object.keys(o)[0]=="key0");
+results.push(JSON.stringify(o).indexOf("idx")<0);
+var c = 0;
+for (var k in o) c++;
+results.push(c==N);
+// deleting and adding keys
+for (var i=0;i<N;i+=2) delete o["key"+i];
+ok = true;
+for (var i=0;i<N;i++) if (o["key"+i]!==((i&1)?i:undefined)) ok = false;
+results.push(ok);
+for (var i=0;i<N*2;i++) o["new"+i] = "n"+i;
+ok = true;
+for (var i=0;i<N*2;i++) if (o["new"+i]!=="n"+i) ok = false;
+results.push(ok);
+results.push(o.key1===1 && o.key2===undefined);
+// hidden keys aren't indexed, so are found by searching (without rebuilding the index each time)
+o["\xFFz"] = 42;
+ok = true;
+for (var i=0;i<50;i++) if (o["\xFFz"]!==42 || o["new"+i]!=="n"+i) ok = false;
+results.push(ok && Object.keys(o).indexOf("\xFFz")<0);
+delete o["\xFFz"];
+// copies shouldn't share the index
+var p = Object.assign({}, o);
+p.key1 = "changed";
+results.push(p.key1=="changed" && o.key1===1);
+// defrag moves variables around, so the index must be rebuilt
+E.defrag();
+ok = true;
+for (var i=0;i<N*2;i++) if (o["new"+i]!=="n"+i) ok = false;
+results.push(ok && o.key3===3);
+// remove everything - object should be empty again
+Object.keys(o).forEach(k => delete o[k]);
+results.push(Object.keys(o).length==0 && JSON.stringify(o)=="{}");
+o.a = 1;
+results.push(o.a===1);
+
+result = results.every(r=>r);
@@ -0,0 +1,27 @@
+// Functions get pretokenised the first time they're called with E.setFlags({lazyPretokenise:1})
+var results = [];
+
+function sum(n) {
+  var s = 0; // add up numbers
+  for (var i=0;i<n;i++) s += i;
+  return s + " total";
+}
+var arrow = (a,b) => a*b + 1000;
+
+E.setFlags({lazyPretokenise:1});
+results.push(E.getFlags().lazyPretokenise==true);
+var before = sum.toString();
+results.push(before.indexOf("add up numbers")>=0);
+results.push(sum(10)=="45 total");
+// the comment should now have been removed by tokenisation
+results.push(sum.toString().indexOf("add up numbers")<0);
+results.push(sum(10)=="45 total");
+results.push(arrow(2,3)==1006);
+results.push(arrow(2,3)==1006);
+// functions defined after the flag is set are also tokenised on first call
+function later(x) { return "x="+x; }
+results.push(later(5)=="x=5");
+results.push(later(6)=="x=6");
+E.setFlags({lazyPretokenise:0});
+
+result = results.every(r=>r);
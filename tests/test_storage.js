@@ -27,6 +27,15 @@ var w = {};
 w[a] = 5;
 test(Object.keys(w).join(""), "Hello");
 
+// Strings read from Storage must follow their file when it's moved by compaction
+s.write("first","12345");
+s.write("second","World");
+a = s.read("second");
+s.erase("first");
+s.compact();
+s.write("third","XXXXX"); // likely to be written where "second" was
+test(a, "World");
+
 s.eraseAll();
 
 result = tests==testsPass;
@@ -0,0 +1,30 @@
+// When Storage is low on space, it's compacted a step at a time in the background
+var s = require("Storage");
+s.eraseAll();
+function content(i) { return "D"+i+"_".repeat((i*37)%900); }
+var N = 0;
+while (s.getStats().freeBytes > 40000) {
+  s.write("f"+N, content(N));
+  N++;
+}
+// erase every other file, so there's lots to compact
+for (var i=0;i<N;i+=2) s.erase("f"+i);
+var kept = s.read("f1"); // should follow the file when it's moved
+var before = s.getStats();
+
+setTimeout(function() {
+  var after = s.getStats();
+  var ok = true;
+  for (var i=0;i<N;i++) {
+    if (s.read("f"+i) !== ((i&1) ? content(i) : undefined)) {
+      console.log("f"+i+" wrong");
+      ok = false;
+    }
+  }
+  result = ok &&
+    before.trashBytes>0 && after.trashBytes==0 &&
+    after.freeBytes > before.freeBytes + before.trashBytes/2 &&
+    kept==content(1) &&
+    s.list().length==Math.floor(N/2);
+  s.eraseAll();
+}, 1000);
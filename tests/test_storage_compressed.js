@@ -0,0 +1,44 @@
+// Test Storage files written with {compress:true}
+var tests=0,testsPass=0;
+function test(a,b) {
+  tests++;
+  if (a===b) testsPass++;
+  else console.log("Test "+tests+" failed: "+JSON.stringify(a)+" !== "+JSON.stringify(b));
+}
+
+var s = require("Storage");
+s.eraseAll();
+var code = "";
+for (var i=0;i<100;i++) code += "function f"+i+"(a) { return a+"+i+"; }\n";
+code += "exports.sum = f10(1)+f99(1);\n";
+
+var free = s.getStats().freeBytes;
+test(s.write("code.js", code, {compress:true}), true);
+var used = free - s.getStats().freeBytes;
+test(used < code.length/2, true); // it should actually be compressed
+test(s.read("code.js"), code);
+test(s.read("code.js", 9, 10), code.substr(9, 10));
+test(s.read("code.js", code.length-5), code.substr(-5));
+test(E.toString(new Uint8Array(s.readArrayBuffer("code.js"))), code);
+test(require("code.js").sum, 111);
+// overwriting with a compressed file replaces the old one
+s.write("code.js", code+"//", {compress:true});
+test(s.read("code.js"), code+"//");
+test(s.list("code.js").length, 1);
+
+// JSON
+var obj = {a:[1,2,3], b:"hello ".repeat(50)};
+s.write("data.json", JSON.stringify(obj), {compress:true});
+test(JSON.stringify(s.readJSON("data.json")), JSON.stringify(obj));
+
+// data that doesn't compress is just stored normally
+s.write("small", "Hi", {compress:true});
+test(s.read("small"), "Hi");
+
+// survives compaction
+s.write("junk", "x".repeat(500));
+s.erase("junk");
+s.compact();
+test(s.read("code.js"), code+"//");
+
+result = tests==testsPass;
@@ -0,0 +1,72 @@
+// Test StorageFile seek/seekLine and buffered writes
+var tests=0,testsPass=0;
+function test(a,b) {
+  tests++;
+  if (a===b) testsPass++;
+  else console.log("Test "+tests+" failed: "+JSON.stringify(a)+" !== "+JSON.stringify(b));
+}
+
+var s = require("Storage");
+s.eraseAll();
+// a log spanning several chunks, written a line at a time with buffering
+var f = s.open("log","w",{buffer:200});
+var N = 300, text = "";
+for (var i=0;i<N;i++) {
+  var l = "line "+i+","+(i*i)+"\n";
+  f.write(l);
+  text += l;
+}
+test(f.getLength(), text.length);
+f.flush();
+test(f.getLength(), text.length);
+test(s.read("log\x03")!==undefined, true); // multiple chunks
+
+f = s.open("log","r");
+test(f.getLength(), text.length);
+f.seekLine(0);
+test(f.readLine(), "line 0,0\n");
+f.seekLine(150);
+test(f.readLine(), "line 150,22500\n");
+test(f.readLine(), "line 151,22801\n");
+f.seekLine(-2);
+test(f.readLine(), "line 298,88804\n");
+test(f.readLine(), "line 299,89401\n");
+test(f.readLine(), undefined);
+f.seekLine(N+10); // past the end
+test(f.readLine(), undefined);
+// every line should be found where we expect
+var ok = true;
+for (var i=0;i<N;i+=7) {
+  f.seekLine(i);
+  if (f.readLine()!=="line "+i+","+(i*i)+"\n") ok=false;
+}
+test(ok, true);
+
+// byte offsets, including either side of every chunk boundary
+ok = true;
+for (var i=0;i<text.length;i+=37) {
+  f.seek(i);
+  if (f.read(50)!==text.substr(i,50)) ok=false;
+}
+test(ok, true);
+f.seek(-10);
+test(f.read(100), text.substr(-10));
+test(f.getLength(), text.length);
+
+// unterminated last line is still counted
+f = s.open("log","a");
+f.write("partial");
+f = s.open("log","r");
+f.seekLine(-1);
+test(f.readLine(), "partial");
+
+// can't seek in write mode
+try {
+  s.open("log","a").seek(0);
+  test("no exception", "exception");
+} catch (e) { test(1,1); }
+
+f.erase();
+test(s.list(/^log/).length, 0);
+
+result = tests==testsPass;
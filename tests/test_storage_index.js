@@ -0,0 +1,47 @@
+// Lots of files - check lookups stay correct as files are created, erased, replaced and compacted
+var tests=0,testsPass=0;
+function test(a,b) {
+  tests++;
+  if (a===b) testsPass++;
+  else console.log("Test "+tests+" failed: "+JSON.stringify(a)+" vs "+JSON.stringify(b));
+}
+
+var s = require("Storage");
+s.eraseAll();
+var N = 300;
+for (var i=0;i<N;i++)
+  s.write("f"+i, "data"+i);
+test(s.list().length, N);
+test(s.read("f0"), "data0");
+test(s.read("f150"), "data150");
+test(s.read("f299"), "data299");
+test(s.read("f300"), undefined);
+// erase every third file
+for (var i=0;i<N;i+=3)
+  s.erase("f"+i);
+// replace every other file with different contents
+for (var i=1;i<N;i+=2)
+  s.write("f"+i, "new"+i);
+
+function checkAll() {
+  var ok = true;
+  for (var i=0;i<N;i++) {
+    var expected = (i&1) ? "new"+i : ((i%3==0) ? undefined : "data"+i);
+    if (s.read("f"+i)!==expected) {
+      console.log("f"+i, JSON.stringify(s.read("f"+i)), "expected", JSON.stringify(expected));
+      ok = false;
+    }
+  }
+  return ok;
+}
+test(checkAll(), true);
+test(s.list().length, N - Math.ceil(N/6));
+s.compact();
+test(checkAll(), true);
+// files written after compaction are found too
+s.write("f0", "again");
+test(s.read("f0"), "again");
+s.erase("f0");
+test(s.read("f0"), undefined);
+
+result = tests==testsPass;
@@ -0,0 +1,38 @@
+// Test Storage erase counting and static wear levelling
+var s = require("Storage");
+s.eraseAll();
+s.write("static", "Hello World - this file never changes");
+var held = s.read("static"); // a string pointing into flash
+// so 'churn' starts on a new page after 'static' (compaction starts from the first page that starts with a file)
+s.write("filler", "\xFF", 0, 16384 - (32+40) - 32);
+var before = s.getStats();
+var list = s.list();
+var addr = E.getAddressOf(held, true);
+var rounds = 0;
+
+function churn() {
+  // keep rewriting the same area of Storage
+  for (var i=0;i<20;i++) {
+    s.write("churn", "\xFF", 0, 8000);
+    s.erase("churn");
+    s.compact();
+  }
+  rounds++;
+  // give the idle loop a chance to move "static" off the pages that aren't being erased
+  setTimeout(check, 20);
+}
+
+function check() {
+  var moved = s.list();
+  var newAddr = E.getAddressOf(s.read("static"), true);
+  if (newAddr==addr && rounds<100) return churn();
+  var after = s.getStats();
+  result = after.eraseCountMax >= before.eraseCountMax &&
+           after.eraseCountMax-after.eraseCountMin >= 50 &&
+           list.indexOf("[WEAR]")<0 && moved.indexOf("[WEAR]")<0 &&
+           addr!=0 && newAddr!=addr && E.getAddressOf(held, true)==newAddr &&
+           s.read("static")=="Hello World - this file never changes" &&
+           held=="Hello World - this file never changes";
+  if (!result) print(rounds, before, after, list, moved, addr, newAddr);
+}
+churn();
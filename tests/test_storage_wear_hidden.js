@@ -0,0 +1,17 @@
+// The hidden [WEAR] file of erase counts isn't reported as a file, and isn't rewritten (leaving trash) after every erase
+var s = require("Storage");
+s.eraseAll();
+
+setTimeout(function() {
+  var erased = s.getStats(); // [WEAR] may have been written after erasing everything
+  s.write("a", "Hello");
+  s.erase("a");
+  s.compact(); // erases just a page or so
+  setTimeout(function() {
+    var after = s.getStats();
+    result = erased.fileCount==0 && erased.fileBytes==0 &&
+             after.fileCount==0 && after.fileBytes==0 &&
+             after.trashCount==0 && s.list().length==0;
+    if (!result) print(erased, after, s.list());
+  }, 100);
+}, 100);
@@ -0,0 +1,41 @@
+// Timers run in order of time, and still do when there are more of them
+// than fit in the native timer heap's static array (when it grows)
+var order = [];
+var ok = true;
+
+function check(n, spacing) {
+  var last = -1;
+  // add timeouts in a random order
+  var times = [];
+  for (var i=0;i<n;i++) times.push(5+((i*7919)%n)*spacing);
+  times.forEach(function(t) {
+    // each timeout is due 't' after the time it's added, which is between 'from' and 'to'
+    var from = getTime()*1000 + t;
+    setTimeout(function() {
+      if (to < last) ok = false; // definitely due before the last one that ran
+      last = from;
+      order.push(t);
+    }, t);
+    var to = getTime()*1000 + t;
+  });
+  // one we remove again
+  var id = setTimeout(function() { ok = false; }, 1);
+  clearTimeout(id);
+}
+
+check(20, 5);
+setTimeout(function() {
+  if (order.length!=20) ok = false;
+  order = [];
+  check(400, 0.25); // more than the static heap holds on any board
+  var intrCount = 0;
+  var intr = setInterval(function() {
+    intrCount++;
+    if (intrCount==2) changeInterval(intr, 5);
+  }, 20);
+  setTimeout(function() {
+    clearInterval(intr);
+    if (order.length!=400) ok = false;
+    result = ok && intrCount>=5 && intrCount<100;
+  }, 250);
+}, 200);